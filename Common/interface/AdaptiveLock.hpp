@@ -0,0 +1,328 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Adaptive spin-then-park locks
+
+#include <atomic>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace ThreadingTools
+{
+
+/// Lock contention statistics.
+
+/// An instance of this structure may optionally be given to AdaptiveLock or
+/// AdaptiveSharedLock. All counters are updated with relaxed atomic operations.
+struct LockContentionStats
+{
+    /// Total number of times the lock was acquired.
+    std::atomic<Diligent::Uint64> NumAcquisitions{0};
+
+    /// Number of acquisitions that could not take the lock immediately.
+    std::atomic<Diligent::Uint64> NumContendedAcquisitions{0};
+
+    /// Total number of pause instructions executed while spinning.
+    std::atomic<Diligent::Uint64> NumSpins{0};
+
+    /// Number of times a thread was parked in the OS.
+    std::atomic<Diligent::Uint64> NumParks{0};
+
+    void Reset()
+    {
+        NumAcquisitions.store(0);
+        NumContendedAcquisitions.store(0);
+        NumSpins.store(0);
+        NumParks.store(0);
+    }
+};
+
+/// Adaptive mutual exclusion lock.
+
+/// The lock is acquired with a single compare-exchange when it is not contended.
+/// Otherwise the thread spins with exponentially growing series of pause instructions
+/// and, if the lock is still not available, parks in the OS (on a futex on Linux and Android,
+/// or on an address-keyed condition variable on other platforms) until the owner releases it.
+/// Unlike LockHelper, a descheduled owner does not make the waiting threads burn CPU.
+///
+/// The lock is not recursive. Its size is 4 bytes plus the optional statistics pointer.
+class AdaptiveLock
+{
+public:
+    explicit AdaptiveLock(LockContentionStats* pStats = nullptr) noexcept :
+        m_pStats{pStats}
+    {}
+
+    // clang-format off
+    AdaptiveLock           (const AdaptiveLock&) = delete;
+    AdaptiveLock& operator=(const AdaptiveLock&) = delete;
+    // clang-format on
+
+    ~AdaptiveLock()
+    {
+        VERIFY(m_State.load() == StateUnlocked, "Destroying the lock that is still locked");
+    }
+
+    bool TryLock() noexcept
+    {
+        Diligent::Uint32 Expected = StateUnlocked;
+        if (m_State.compare_exchange_strong(Expected, StateLocked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            if (m_pStats != nullptr)
+                m_pStats->NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void Lock() noexcept
+    {
+        if (!TryLock())
+            LockContended();
+    }
+
+    void Unlock() noexcept
+    {
+        const auto PrevState = m_State.exchange(StateUnlocked, std::memory_order_release);
+        VERIFY(PrevState != StateUnlocked, "Unlocking the lock that is not locked");
+        if (PrevState == StateLockedWithWaiters)
+            WakeWaiters();
+    }
+
+    bool IsLocked() const noexcept
+    {
+        return m_State.load(std::memory_order_relaxed) != StateUnlocked;
+    }
+
+private:
+    void LockContended() noexcept;
+    void WakeWaiters() noexcept;
+
+    // clang-format off
+    static constexpr Diligent::Uint32 StateUnlocked          = 0;
+    static constexpr Diligent::Uint32 StateLocked            = 1;
+    static constexpr Diligent::Uint32 StateLockedWithWaiters = 2;
+    // clang-format on
+
+    std::atomic<Diligent::Uint32> m_State{StateUnlocked};
+    LockContentionStats* const    m_pStats;
+};
+
+
+/// Adaptive reader/writer lock.
+
+/// Any number of readers may hold the lock at the same time, while a writer has exclusive access.
+/// Contended threads spin and then park in the same way as AdaptiveLock does.
+/// The lock does not give writers priority, so a continuous stream of readers may delay a writer.
+/// It is intended for lookup tables that are read much more often than they are modified.
+class AdaptiveSharedLock
+{
+public:
+    explicit AdaptiveSharedLock(LockContentionStats* pStats = nullptr) noexcept :
+        m_pStats{pStats}
+    {}
+
+    // clang-format off
+    AdaptiveSharedLock           (const AdaptiveSharedLock&) = delete;
+    AdaptiveSharedLock& operator=(const AdaptiveSharedLock&) = delete;
+    // clang-format on
+
+    ~AdaptiveSharedLock()
+    {
+        VERIFY(m_State.load() == 0, "Destroying the lock that is still locked");
+    }
+
+    bool TryLock() noexcept
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & ~WaitersBit) == 0 &&
+            m_State.compare_exchange_strong(State, State | WriterBit, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            if (m_pStats != nullptr)
+                m_pStats->NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void Lock() noexcept
+    {
+        if (!TryLock())
+            LockContended();
+    }
+
+    void Unlock() noexcept
+    {
+        const auto PrevState = m_State.exchange(0, std::memory_order_release);
+        VERIFY((PrevState & WriterBit) != 0, "Unlocking the lock that is not exclusively locked");
+        if ((PrevState & WaitersBit) != 0)
+            WakeWaiters();
+    }
+
+    bool TryLockShared() noexcept
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        while ((State & WriterBit) == 0)
+        {
+            VERIFY((State & ReadersMask) != ReadersMask, "Too many readers");
+            if (m_State.compare_exchange_weak(State, State + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                if (m_pStats != nullptr)
+                    m_pStats->NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void LockShared() noexcept
+    {
+        if (!TryLockShared())
+            LockSharedContended();
+    }
+
+    void UnlockShared() noexcept
+    {
+        const auto PrevState = m_State.fetch_sub(1, std::memory_order_release);
+        VERIFY((PrevState & ReadersMask) != 0 && (PrevState & WriterBit) == 0, "Unlocking the lock that is not locked for reading");
+        if (PrevState == (WaitersBit | 1))
+        {
+            // This was the last reader and there are parked threads. If the compare-exchange
+            // fails, another thread has acquired the lock and will wake the waiters when it
+            // releases the lock.
+            auto State = WaitersBit;
+            if (m_State.compare_exchange_strong(State, 0, std::memory_order_relaxed))
+                WakeWaiters();
+        }
+    }
+
+private:
+    void LockContended() noexcept;
+    void LockSharedContended() noexcept;
+    void WakeWaiters() noexcept;
+
+    // clang-format off
+    static constexpr Diligent::Uint32 WriterBit   = 0x80000000u;
+    static constexpr Diligent::Uint32 WaitersBit  = 0x40000000u;
+    static constexpr Diligent::Uint32 ReadersMask = 0x3FFFFFFFu;
+    // clang-format on
+
+    std::atomic<Diligent::Uint32> m_State{0};
+    LockContentionStats* const    m_pStats;
+};
+
+
+/// RAII helper that holds an exclusive lock on AdaptiveLock or AdaptiveSharedLock.
+template <typename LockType>
+class ExclusiveLockGuard
+{
+public:
+    ExclusiveLockGuard() noexcept {}
+
+    explicit ExclusiveLockGuard(LockType& Lock) noexcept :
+        m_pLock{&Lock}
+    {
+        Lock.Lock();
+    }
+
+    ExclusiveLockGuard(ExclusiveLockGuard&& Other) noexcept :
+        m_pLock{Other.m_pLock}
+    {
+        Other.m_pLock = nullptr;
+    }
+
+    // clang-format off
+    ExclusiveLockGuard           (const ExclusiveLockGuard&) = delete;
+    ExclusiveLockGuard& operator=(const ExclusiveLockGuard&) = delete;
+    ExclusiveLockGuard& operator=(ExclusiveLockGuard&&)      = delete;
+    // clang-format on
+
+    ~ExclusiveLockGuard()
+    {
+        Unlock();
+    }
+
+    void Unlock() noexcept
+    {
+        if (m_pLock != nullptr)
+        {
+            m_pLock->Unlock();
+            m_pLock = nullptr;
+        }
+    }
+
+private:
+    LockType* m_pLock = nullptr;
+};
+
+
+/// RAII helper that holds a shared lock on AdaptiveSharedLock.
+class SharedLockGuard
+{
+public:
+    SharedLockGuard() noexcept {}
+
+    explicit SharedLockGuard(AdaptiveSharedLock& Lock) noexcept :
+        m_pLock{&Lock}
+    {
+        Lock.LockShared();
+    }
+
+    SharedLockGuard(SharedLockGuard&& Other) noexcept :
+        m_pLock{Other.m_pLock}
+    {
+        Other.m_pLock = nullptr;
+    }
+
+    // clang-format off
+    SharedLockGuard           (const SharedLockGuard&) = delete;
+    SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+    SharedLockGuard& operator=(SharedLockGuard&&)      = delete;
+    // clang-format on
+
+    ~SharedLockGuard()
+    {
+        Unlock();
+    }
+
+    void Unlock() noexcept
+    {
+        if (m_pLock != nullptr)
+        {
+            m_pLock->UnlockShared();
+            m_pLock = nullptr;
+        }
+    }
+
+private:
+    AdaptiveSharedLock* m_pLock = nullptr;
+};
+
+} // namespace ThreadingTools
@@ -28,11 +28,13 @@
 #pragma once
 
 #include <float.h>
+#include <vector>
 
 #include "../../Platforms/interface/PlatformDefinitions.h"
 #include "../../Primitives/interface/FlagEnum.h"
 
 #include "BasicMath.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -425,6 +427,135 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Array of bounding boxes stored in structure-of-arrays layout.
+
+/// Every component array is padded to a multiple of BoundBoxSoA::PaddingSize
+/// elements, so that the batched culling functions can always process full
+/// groups of boxes. The contents of the padding elements are unspecified.
+class BoundBoxSoA
+{
+public:
+    static constexpr size_t PaddingSize = 16;
+
+    BoundBoxSoA() noexcept {}
+
+    BoundBoxSoA(const BoundBox* pBoxes, size_t Count)
+    {
+        Resize(Count);
+        for (size_t i = 0; i < Count; ++i)
+            Set(i, pBoxes[i]);
+    }
+
+    void Reserve(size_t Count)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            m_Min[c].reserve(AlignUp(Count, PaddingSize));
+            m_Max[c].reserve(AlignUp(Count, PaddingSize));
+        }
+    }
+
+    void Resize(size_t Count)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            m_Min[c].resize(AlignUp(Count, PaddingSize));
+            m_Max[c].resize(AlignUp(Count, PaddingSize));
+        }
+        m_Count = Count;
+    }
+
+    void Clear()
+    {
+        Resize(0);
+    }
+
+    void PushBack(const BoundBox& Box)
+    {
+        const size_t Idx = m_Count;
+        Resize(m_Count + 1);
+        Set(Idx, Box);
+    }
+
+    void Set(size_t Idx, const BoundBox& Box)
+    {
+        VERIFY_EXPR(Idx < m_Count);
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            m_Min[c][Idx] = Box.Min[c];
+            m_Max[c][Idx] = Box.Max[c];
+        }
+    }
+
+    BoundBox Get(size_t Idx) const
+    {
+        VERIFY_EXPR(Idx < m_Count);
+        return BoundBox //
+            {
+                float3{m_Min[0][Idx], m_Min[1][Idx], m_Min[2][Idx]},
+                float3{m_Max[0][Idx], m_Max[1][Idx], m_Max[2][Idx]} //
+            };
+    }
+
+    size_t GetCount() const { return m_Count; }
+
+    /// Returns the array of minimum coordinates along the given axis (0 - x, 1 - y, 2 - z).
+    const float* GetMin(Uint32 Axis) const
+    {
+        VERIFY_EXPR(Axis < 3);
+        return m_Min[Axis].data();
+    }
+
+    /// Returns the array of maximum coordinates along the given axis (0 - x, 1 - y, 2 - z).
+    const float* GetMax(Uint32 Axis) const
+    {
+        VERIFY_EXPR(Axis < 3);
+        return m_Max[Axis].data();
+    }
+
+private:
+    std::vector<float> m_Min[3];
+    std::vector<float> m_Max[3];
+    size_t             m_Count = 0;
+};
+
+class ThreadPool;
+
+/// Computes the visibility of every box in the array, see Diligent::BoxVisibility.
+
+/// \param [in]  ViewFrustum - View frustum.
+/// \param [in]  Boxes       - Bounding boxes to test.
+/// \param [out] pVisibility - Array of Boxes.GetCount() elements that receives the visibility of every box.
+/// \param [in]  PlaneFlags  - Frustum planes to test the boxes against.
+///
+/// \remarks    The results are identical to calling GetBoxVisibility(const ViewFrustum&, const BoundBox&, FRUSTUM_PLANE_FLAGS)
+///             for every box, but the boxes are processed in groups of 8 (AVX2) or 4 (SSE2, NEON).
+void GetBoxVisibility(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      BoxVisibility*      pVisibility,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+/// Writes the indices of the boxes that are not invisible to pVisibleIndices
+/// in increasing order and returns their number.
+
+/// \param [in]  ViewFrustum     - View frustum.
+/// \param [in]  Boxes           - Bounding boxes to cull.
+/// \param [out] pVisibleIndices - Array of at least Boxes.GetCount() elements that receives the indices of visible boxes.
+/// \param [in]  PlaneFlags      - Frustum planes to test the boxes against.
+/// \return                        The number of visible boxes.
+size_t CullBoundBoxes(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      Uint32*             pVisibleIndices,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+/// Multithreaded version of CullBoundBoxes() that distributes the boxes between the threads of the pool.
+/// The calling thread takes part in the work. The results are identical to the single-threaded version.
+size_t CullBoundBoxes(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      Uint32*             pVisibleIndices,
+                      ThreadPool&         Pool,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
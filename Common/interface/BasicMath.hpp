@@ -53,6 +53,7 @@
 #include <iostream>
 
 #include "HashUtils.hpp"
+#include "SIMDHelpers.hpp"
 
 #ifdef _MSC_VER
 #    pragma warning(push)
@@ -1491,6 +1492,13 @@ template <class T> struct Matrix4x4
     }
 
     Matrix4x4 Inverse() const
+    {
+        return InverseGeneric();
+    }
+
+    /// Computes the inverse using cofactors. This is the reference implementation
+    /// that is also used by the types that have no specialized Inverse().
+    Matrix4x4 InverseGeneric() const
     {
         Matrix4x4 inv;
 
@@ -1849,6 +1857,221 @@ using double3x3 = Matrix3x3<double>;
 using double2x2 = Matrix2x2<double>;
 
 
+// Specializations of float matrix operations that are vectorized on SSE2 and NEON.
+// The generic templates above are the reference implementation. Multiplications and additions are
+// performed in the same order, so the results are bitwise identical to the generic code unless the
+// compiler fuses the scalar operations. Matrix inverse uses a different algorithm and is only
+// vectorized on SSE2.
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    Matrix4x4<float> mOut;
+#if DILIGENT_SSE2_SUPPORTED
+    const __m128 r0 = _mm_loadu_ps(m2.m[0]);
+    const __m128 r1 = _mm_loadu_ps(m2.m[1]);
+    const __m128 r2 = _mm_loadu_ps(m2.m[2]);
+    const __m128 r3 = _mm_loadu_ps(m2.m[3]);
+    for (int i = 0; i < 4; i++)
+    {
+        // Start from zero like the generic implementation to get the same signed zeros
+        __m128 row = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), r0));
+        row        = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), r1));
+        row        = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), r2));
+        row        = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), r3));
+        _mm_storeu_ps(mOut.m[i], row);
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    const float32x4_t r0 = vld1q_f32(m2.m[0]);
+    const float32x4_t r1 = vld1q_f32(m2.m[1]);
+    const float32x4_t r2 = vld1q_f32(m2.m[2]);
+    const float32x4_t r3 = vld1q_f32(m2.m[3]);
+    for (int i = 0; i < 4; i++)
+    {
+        // Separate multiplies and adds (rather than fused multiply-add) follow the generic implementation
+        float32x4_t row = vaddq_f32(vdupq_n_f32(0.f), vmulq_n_f32(r0, m1.m[i][0]));
+        row             = vaddq_f32(row, vmulq_n_f32(r1, m1.m[i][1]));
+        row             = vaddq_f32(row, vmulq_n_f32(r2, m1.m[i][2]));
+        row             = vaddq_f32(row, vmulq_n_f32(r3, m1.m[i][3]));
+        vst1q_f32(mOut.m[i], row);
+    }
+#else
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                mOut.m[i][j] += m1.m[i][k] * m2.m[k][j];
+            }
+        }
+    }
+#endif
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Inverse() const
+{
+#if DILIGENT_SSE2_SUPPORTED
+    // The matrix is split into 2x2 blocks, each stored in one register as (_11, _12, _21, _22):
+    //
+    //      | A  B |
+    //      | C  D |
+    //
+    // and the inverse is computed using the adjugates of the blocks (A# denotes the adjugate of A).
+
+    // A * B
+    auto Mat2Mul = [](__m128 A, __m128 B) {
+        return _mm_add_ps(_mm_mul_ps(A, _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 3, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(1, 2, 1, 2))));
+    };
+    // A# * B
+    auto Mat2AdjMul = [](__m128 A, __m128 B) {
+        return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(0, 0, 3, 3)), B),
+                          _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(1, 0, 3, 2))));
+    };
+    // A * B#
+    auto Mat2MulAdj = [](__m128 A, __m128 B) {
+        return _mm_sub_ps(_mm_mul_ps(A, _mm_shuffle_ps(B, B, _MM_SHUFFLE(0, 3, 0, 3))),
+                          _mm_mul_ps(_mm_shuffle_ps(A, A, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(B, B, _MM_SHUFFLE(1, 2, 1, 2))));
+    };
+
+    const __m128 r0 = _mm_loadu_ps(m[0]);
+    const __m128 r1 = _mm_loadu_ps(m[1]);
+    const __m128 r2 = _mm_loadu_ps(m[2]);
+    const __m128 r3 = _mm_loadu_ps(m[3]);
+
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    // Block determinants (|A|, |B|, |C|, |D|)
+    const __m128 DetSub = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+                                     _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+    const __m128 DetA = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 DetB = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 DetC = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 DetD = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128 D_C = Mat2AdjMul(D, C);
+    const __m128 A_B = Mat2AdjMul(A, B);
+
+    // X# = |D|A - B(D#C)
+    __m128 X_ = _mm_sub_ps(_mm_mul_ps(DetD, A), Mat2Mul(B, D_C));
+    // W# = |A|D - C(A#B)
+    __m128 W_ = _mm_sub_ps(_mm_mul_ps(DetA, D), Mat2Mul(C, A_B));
+    // Y# = |B|C - D(A#B)#
+    __m128 Y_ = _mm_sub_ps(_mm_mul_ps(DetB, C), Mat2MulAdj(D, A_B));
+    // Z# = |C|B - A(D#C)#
+    __m128 Z_ = _mm_sub_ps(_mm_mul_ps(DetC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+    __m128 Tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+    Tr        = _mm_add_ps(Tr, _mm_shuffle_ps(Tr, Tr, _MM_SHUFFLE(2, 3, 0, 1)));
+    Tr        = _mm_add_ps(Tr, _mm_shuffle_ps(Tr, Tr, _MM_SHUFFLE(1, 0, 3, 2)));
+
+    const __m128 DetM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC)), Tr);
+
+    const __m128 RcpDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), DetM);
+
+    X_ = _mm_mul_ps(X_, RcpDetM);
+    Y_ = _mm_mul_ps(Y_, RcpDetM);
+    Z_ = _mm_mul_ps(Z_, RcpDetM);
+    W_ = _mm_mul_ps(W_, RcpDetM);
+
+    // Apply the adjugate and write the blocks
+    Matrix4x4<float> inv;
+    _mm_storeu_ps(inv.m[0], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(inv.m[1], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(inv.m[2], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(inv.m[3], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2)));
+    return inv;
+#else
+    return InverseGeneric();
+#endif
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(const Matrix4x4<float>& m) const
+{
+    Vector4<float> out;
+#if DILIGENT_SSE2_SUPPORTED
+    __m128 v = _mm_mul_ps(_mm_set1_ps(x), _mm_loadu_ps(m.m[0]));
+    v        = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(y), _mm_loadu_ps(m.m[1])));
+    v        = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(z), _mm_loadu_ps(m.m[2])));
+    v        = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(w), _mm_loadu_ps(m.m[3])));
+    _mm_storeu_ps(&out.x, v);
+#elif DILIGENT_NEON_SUPPORTED
+    float32x4_t v = vmulq_n_f32(vld1q_f32(m.m[0]), x);
+    v             = vaddq_f32(v, vmulq_n_f32(vld1q_f32(m.m[1]), y));
+    v             = vaddq_f32(v, vmulq_n_f32(vld1q_f32(m.m[2]), z));
+    v             = vaddq_f32(v, vmulq_n_f32(vld1q_f32(m.m[3]), w));
+    vst1q_f32(&out.x, v);
+#else
+    out[0] = x * m[0][0] + y * m[1][0] + z * m[2][0] + w * m[3][0];
+    out[1] = x * m[0][1] + y * m[1][1] + z * m[2][1] + w * m[3][1];
+    out[2] = x * m[0][2] + y * m[1][2] + z * m[2][2] + w * m[3][2];
+    out[3] = x * m[0][3] + y * m[1][3] + z * m[2][3] + w * m[3][3];
+#endif
+    return out;
+}
+
+template <>
+inline Vector4<float> operator*(const Matrix4x4<float>& m, const Vector4<float>& v)
+{
+    Vector4<float> out;
+#if DILIGENT_SSE2_SUPPORTED
+    __m128 c0 = _mm_loadu_ps(m.m[0]);
+    __m128 c1 = _mm_loadu_ps(m.m[1]);
+    __m128 c2 = _mm_loadu_ps(m.m[2]);
+    __m128 c3 = _mm_loadu_ps(m.m[3]);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+    r        = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+    r        = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+    r        = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v.w)));
+    _mm_storeu_ps(&out.x, r);
+#elif DILIGENT_NEON_SUPPORTED
+    const float32x4x4_t c = vld4q_f32(m.m[0]); // Loads the matrix transposed
+
+    float32x4_t r = vmulq_n_f32(c.val[0], v.x);
+    r             = vaddq_f32(r, vmulq_n_f32(c.val[1], v.y));
+    r             = vaddq_f32(r, vmulq_n_f32(c.val[2], v.z));
+    r             = vaddq_f32(r, vmulq_n_f32(c.val[3], v.w));
+    vst1q_f32(&out.x, r);
+#else
+    out[0] = m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w;
+    out[1] = m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w;
+    out[2] = m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w;
+    out[3] = m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w;
+#endif
+    return out;
+}
+
+/// Transforms an array of points by the matrix: pDst[i] = pSrc[i] * m (including the division by w).
+///
+/// \param [in]  pSrc  - Source points.
+/// \param [in]  Count - The number of points.
+/// \param [in]  m     - Transform matrix.
+/// \param [out] pDst  - Destination points. May be the same array as pSrc.
+///
+/// \remarks    The results are identical to transforming the points one by one.
+///             Points are processed in groups of 8 (AVX2) or 4 (SSE2).
+void TransformPoints(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst);
+
+/// Transforms an array of 4-component vectors by the matrix: pDst[i] = pSrc[i] * m.
+///
+/// \param [in]  pSrc  - Source vectors.
+/// \param [in]  Count - The number of vectors.
+/// \param [in]  m     - Transform matrix.
+/// \param [out] pDst  - Destination vectors. May be the same array as pSrc.
+void TransformPoints(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst);
+
+
 struct Quaternion
 {
     float4 q;
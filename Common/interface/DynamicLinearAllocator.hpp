@@ -30,7 +30,8 @@
 /// \file
 /// Defines Diligent::DynamicLinearAllocator class
 
-#include <vector>
+#include <new>
+#include <cstring>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -42,6 +43,11 @@ namespace Diligent
 {
 
 /// Implementation of a linear allocator on fixed memory pages
+
+/// Memory pages are kept in an intrusive singly-linked list: every page starts with
+/// a small header, so the allocator does not need any additional bookkeeping memory.
+/// Reset() rewinds all pages without releasing them, which allows the allocator to be
+/// used as a per-frame arena that does not touch the heap once it has warmed up.
 class DynamicLinearAllocator
 {
 public:
@@ -64,53 +70,102 @@ public:
         Free();
     }
 
+    /// Releases all memory pages.
     void Free()
     {
-        for (auto& block : m_Blocks)
+        auto* pBlock = m_pFirstBlock;
+        while (pBlock != nullptr)
         {
-            m_pAllocator->Free(block.Data);
+            auto* pNextBlock = pBlock->pNext;
+            m_pAllocator->Free(pBlock);
+            pBlock = pNextBlock;
         }
-        m_Blocks.clear();
 
-        m_pAllocator = nullptr;
+        m_pFirstBlock = nullptr;
+        m_pLastBlock  = nullptr;
+        m_pCurrBlock  = nullptr;
+        m_pCurrPtr    = nullptr;
+        m_pCurrEnd    = nullptr;
+        m_Capacity    = 0;
     }
 
-    void Discard()
+    /// Rewinds all memory pages without releasing them.
+    /// All previously allocated memory becomes invalid.
+    void Reset()
     {
-        for (auto& block : m_Blocks)
+        m_pCurrBlock = m_pFirstBlock;
+        if (m_pCurrBlock != nullptr)
+        {
+            m_pCurrPtr = m_pCurrBlock->GetData();
+            m_pCurrEnd = m_pCurrBlock->GetEnd();
+        }
+        else
         {
-            block.CurrPtr = block.Data;
+            m_pCurrPtr = nullptr;
+            m_pCurrEnd = nullptr;
         }
     }
 
+    /// Same as Reset().
+    void Discard()
+    {
+        Reset();
+    }
+
     NODISCARD void* Allocate(size_t size, size_t align)
     {
         if (size == 0)
             return nullptr;
 
-        for (auto& block : m_Blocks)
+        // Fast path: allocate from the current block
+        auto* Ptr = AlignUp(m_pCurrPtr, align);
+        if (m_pCurrBlock != nullptr && Ptr + size <= m_pCurrEnd)
+        {
+            m_pCurrPtr = Ptr + size;
+            return Ptr;
+        }
+
+        // Find the next block that has enough space. After Reset(), blocks
+        // past the current one are empty.
+        auto* pBlock = m_pCurrBlock != nullptr ? m_pCurrBlock->pNext : nullptr;
+        for (; pBlock != nullptr; pBlock = pBlock->pNext)
         {
-            auto* Ptr = AlignUp(block.CurrPtr, align);
-            if (Ptr + size <= block.Data + block.Size)
-            {
-                block.CurrPtr = Ptr + size;
-                return Ptr;
-            }
+            Ptr = AlignUp(pBlock->GetData(), align);
+            if (Ptr + size <= pBlock->GetEnd())
+                break;
         }
 
-        // Create a new block
-        size_t BlockSize = m_BlockSize;
-        while (BlockSize < size + align - 1)
-            BlockSize *= 2;
-        m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize);
+        if (pBlock == nullptr)
+        {
+            // Create a new block
+            size_t BlockSize = m_BlockSize;
+            while (BlockSize < sizeof(Block) + size + align - 1)
+                BlockSize *= 2;
+
+            pBlock = new (m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__)) Block{BlockSize};
+            if (m_pLastBlock != nullptr)
+                m_pLastBlock->pNext = pBlock;
+            else
+                m_pFirstBlock = pBlock;
+            m_pLastBlock = pBlock;
+            m_Capacity += BlockSize;
+
+            Ptr = AlignUp(pBlock->GetData(), align);
+            VERIFY(Ptr + size <= pBlock->GetEnd(), "Not enough space in the new block - this is a bug");
+        }
 
-        auto& block = m_Blocks.back();
-        auto* Ptr   = AlignUp(block.Data, align);
-        VERIFY(Ptr + size <= block.Data + block.Size, "Not enough space in the new block - this is a bug");
-        block.CurrPtr = Ptr + size;
+        m_pCurrBlock = pBlock;
+        m_pCurrPtr   = Ptr + size;
+        m_pCurrEnd   = pBlock->GetEnd();
         return Ptr;
     }
 
+    /// Returns the total size of all memory pages owned by the allocator.
+    size_t GetCapacity() const
+    {
+        return m_Capacity;
+    }
+
     template <typename T>
     NODISCARD T* Allocate(size_t count = 1)
     {
@@ -195,17 +250,24 @@ public:
 private:
     struct Block
     {
-        uint8_t* const Data    = nullptr;
-        size_t const   Size    = 0;
-        uint8_t*       CurrPtr = nullptr;
+        Block* pNext = nullptr;
+        size_t Size  = 0; // Total block size, including the header
+
+        explicit Block(size_t _Size) :
+            Size{_Size} {}
 
-        Block(void* _Data, size_t _Size) :
-            Data{static_cast<uint8_t*>(_Data)}, Size{_Size}, CurrPtr{Data} {}
+        uint8_t* GetData() { return reinterpret_cast<uint8_t*>(this) + sizeof(Block); }
+        uint8_t* GetEnd() { return reinterpret_cast<uint8_t*>(this) + Size; }
     };
 
-    std::vector<Block> m_Blocks;
-    const Uint32       m_BlockSize  = 4 << 10;
-    IMemoryAllocator*  m_pAllocator = nullptr;
+    Block*            m_pFirstBlock = nullptr;
+    Block*            m_pLastBlock  = nullptr;
+    Block*            m_pCurrBlock  = nullptr;
+    uint8_t*          m_pCurrPtr    = nullptr;
+    uint8_t*          m_pCurrEnd    = nullptr;
+    size_t            m_Capacity    = 0;
+    const Uint32      m_BlockSize   = 4 << 10;
+    IMemoryAllocator* m_pAllocator  = nullptr;
 };
 
 } // namespace Diligent
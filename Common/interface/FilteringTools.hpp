@@ -27,9 +27,12 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "../../Platforms/interface/PlatformDefinitions.h"
 
 #include "BasicMath.hpp"
+#include "SIMDHelpers.hpp"
 
 #include "../../Graphics/GraphicsEngine/interface/Sampler.h"
 
@@ -245,4 +248,527 @@ DstType FilterTexture2DBilinearClampUC(Uint32         Width,
     return FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, u, v);
 }
 
+
+namespace FilteringToolsInternal
+{
+
+// The SIMD kernels below perform all address computations in floating point.
+// The results are identical to GetLinearTexFilterSampleInfo() as long as
+// the absolute values of the unnormalized coordinates are less than 2^23.
+
+#if DILIGENT_SSE2_SUPPORTED
+
+inline __m128 FastFloorSSE2(__m128 x)
+{
+    const __m128 flr = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    // flr <= x ? flr : flr - 1
+    return _mm_sub_ps(flr, _mm_and_ps(_mm_cmpgt_ps(flr, x), _mm_set1_ps(1.f)));
+}
+
+inline __m128 WrapTexCoordSSE2(__m128 i, __m128 Width, __m128 InvWidth)
+{
+    // InvWidth is not exact, so the quotient may be off by one
+    __m128 r = _mm_sub_ps(i, _mm_mul_ps(FastFloorSSE2(_mm_mul_ps(i, InvWidth)), Width));
+    r        = _mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, _mm_setzero_ps()), Width));
+    r        = _mm_sub_ps(r, _mm_and_ps(_mm_cmpge_ps(r, Width), Width));
+    return r;
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+__m128 ApplyTexAddressModeSSE2(__m128 i, __m128 Width, __m128 InvWidth)
+{
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_UNKNOWN:
+            return i;
+
+        case TEXTURE_ADDRESS_WRAP:
+            return WrapTexCoordSSE2(i, Width, InvWidth);
+
+        case TEXTURE_ADDRESS_MIRROR:
+        {
+            const __m128 Width2 = _mm_add_ps(Width, Width);
+            const __m128 r      = WrapTexCoordSSE2(i, Width2, _mm_mul_ps(InvWidth, _mm_set1_ps(0.5f)));
+            // r >= Width ? (Width * 2 - 1) - r : r
+            return _mm_min_ps(r, _mm_sub_ps(_mm_sub_ps(Width2, _mm_set1_ps(1.f)), r));
+        }
+
+        case TEXTURE_ADDRESS_CLAMP:
+            return _mm_min_ps(_mm_max_ps(i, _mm_setzero_ps()), _mm_sub_ps(Width, _mm_set1_ps(1.f)));
+
+        default:
+            UNEXPECTED("Unexpected texture address mode");
+            return i;
+    }
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void ComputeLinearTexFilterSampleInfoSSE2(__m128 u, __m128 Width, __m128 InvWidth, Int32* pI0, Int32* pI1, float* pWeight)
+{
+    const __m128 x  = IsNormalizedCoord ? _mm_mul_ps(u, Width) : u;
+    const __m128 xc = _mm_sub_ps(x, _mm_set1_ps(0.5f));
+    const __m128 x0 = FastFloorSSE2(xc);
+    const __m128 x1 = _mm_add_ps(x0, _mm_set1_ps(1.f));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pI0), _mm_cvttps_epi32(ApplyTexAddressModeSSE2<AddressMode>(x0, Width, InvWidth)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pI1), _mm_cvttps_epi32(ApplyTexAddressModeSSE2<AddressMode>(x1, Width, InvWidth)));
+    _mm_storeu_ps(pWeight, _mm_sub_ps(xc, x0));
+}
+
+#endif
+
+#if DILIGENT_AVX2_SUPPORTED
+
+DILIGENT_TARGET_AVX2 inline __m256 WrapTexCoordAVX2(__m256 i, __m256 Width, __m256 InvWidth)
+{
+    __m256 r = _mm256_sub_ps(i, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(i, InvWidth)), Width));
+    r        = _mm256_add_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, _mm256_setzero_ps(), _CMP_LT_OQ), Width));
+    r        = _mm256_sub_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, Width, _CMP_GE_OQ), Width));
+    return r;
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+DILIGENT_TARGET_AVX2 __m256 ApplyTexAddressModeAVX2(__m256 i, __m256 Width, __m256 InvWidth)
+{
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_UNKNOWN:
+            return i;
+
+        case TEXTURE_ADDRESS_WRAP:
+            return WrapTexCoordAVX2(i, Width, InvWidth);
+
+        case TEXTURE_ADDRESS_MIRROR:
+        {
+            const __m256 Width2 = _mm256_add_ps(Width, Width);
+            const __m256 r      = WrapTexCoordAVX2(i, Width2, _mm256_mul_ps(InvWidth, _mm256_set1_ps(0.5f)));
+            return _mm256_min_ps(r, _mm256_sub_ps(_mm256_sub_ps(Width2, _mm256_set1_ps(1.f)), r));
+        }
+
+        case TEXTURE_ADDRESS_CLAMP:
+            return _mm256_min_ps(_mm256_max_ps(i, _mm256_setzero_ps()), _mm256_sub_ps(Width, _mm256_set1_ps(1.f)));
+
+        default:
+            UNEXPECTED("Unexpected texture address mode");
+            return i;
+    }
+}
+
+// Processes the samples in groups of 8 and returns the number of processed samples.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+DILIGENT_TARGET_AVX2 size_t ComputeLinearTexFilterSampleInfoAVX2(Uint32        Width,
+                                                                 const Uint32* pWidths,
+                                                                 const float*  pU,
+                                                                 size_t        Count,
+                                                                 Int32*        pI0,
+                                                                 Int32*        pI1,
+                                                                 float*        pWeight)
+{
+    __m256 W    = _mm256_set1_ps(static_cast<float>(Width));
+    __m256 InvW = _mm256_div_ps(_mm256_set1_ps(1.f), W);
+
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        if (pWidths != nullptr)
+        {
+            W    = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWidths + i)));
+            InvW = _mm256_div_ps(_mm256_set1_ps(1.f), W);
+        }
+
+        const __m256 u  = _mm256_loadu_ps(pU + i);
+        const __m256 x  = IsNormalizedCoord ? _mm256_mul_ps(u, W) : u;
+        const __m256 xc = _mm256_sub_ps(x, _mm256_set1_ps(0.5f));
+        const __m256 x0 = _mm256_floor_ps(xc);
+        const __m256 x1 = _mm256_add_ps(x0, _mm256_set1_ps(1.f));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pI0 + i), _mm256_cvttps_epi32(ApplyTexAddressModeAVX2<AddressMode>(x0, W, InvW)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pI1 + i), _mm256_cvttps_epi32(ApplyTexAddressModeAVX2<AddressMode>(x1, W, InvW)));
+        _mm256_storeu_ps(pWeight + i, _mm256_sub_ps(xc, x0));
+    }
+    return i;
+}
+
+#endif
+
+#if DILIGENT_NEON_SUPPORTED
+
+inline float32x4_t WrapTexCoordNEON(float32x4_t i, float32x4_t Width, float32x4_t InvWidth)
+{
+    const uint32x4_t WidthBits = vreinterpretq_u32_f32(Width);
+
+    float32x4_t r = vsubq_f32(i, vmulq_f32(vrndmq_f32(vmulq_f32(i, InvWidth)), Width));
+    r             = vaddq_f32(r, vreinterpretq_f32_u32(vandq_u32(vcltq_f32(r, vdupq_n_f32(0.f)), WidthBits)));
+    r             = vsubq_f32(r, vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(r, Width), WidthBits)));
+    return r;
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+float32x4_t ApplyTexAddressModeNEON(float32x4_t i, float32x4_t Width, float32x4_t InvWidth)
+{
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_UNKNOWN:
+            return i;
+
+        case TEXTURE_ADDRESS_WRAP:
+            return WrapTexCoordNEON(i, Width, InvWidth);
+
+        case TEXTURE_ADDRESS_MIRROR:
+        {
+            const float32x4_t Width2 = vaddq_f32(Width, Width);
+            const float32x4_t r      = WrapTexCoordNEON(i, Width2, vmulq_n_f32(InvWidth, 0.5f));
+            return vminq_f32(r, vsubq_f32(vsubq_f32(Width2, vdupq_n_f32(1.f)), r));
+        }
+
+        case TEXTURE_ADDRESS_CLAMP:
+            return vminq_f32(vmaxq_f32(i, vdupq_n_f32(0.f)), vsubq_f32(Width, vdupq_n_f32(1.f)));
+
+        default:
+            UNEXPECTED("Unexpected texture address mode");
+            return i;
+    }
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void ComputeLinearTexFilterSampleInfoNEON(float32x4_t u, float32x4_t Width, float32x4_t InvWidth, Int32* pI0, Int32* pI1, float* pWeight)
+{
+    const float32x4_t x  = IsNormalizedCoord ? vmulq_f32(u, Width) : u;
+    const float32x4_t xc = vsubq_f32(x, vdupq_n_f32(0.5f));
+    const float32x4_t x0 = vrndmq_f32(xc);
+    const float32x4_t x1 = vaddq_f32(x0, vdupq_n_f32(1.f));
+
+    vst1q_s32(pI0, vcvtq_s32_f32(ApplyTexAddressModeNEON<AddressMode>(x0, Width, InvWidth)));
+    vst1q_s32(pI1, vcvtq_s32_f32(ApplyTexAddressModeNEON<AddressMode>(x1, Width, InvWidth)));
+    vst1q_f32(pWeight, vsubq_f32(xc, x0));
+}
+
+#endif
+
+/// Computes linear texture filter sample info for Count coordinates and writes it
+/// in SoA layout. If pWidths is not null, it provides a texture width for every sample
+/// and Width is ignored.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void ComputeLinearTexFilterSampleInfo(Uint32        Width,
+                                      const Uint32* pWidths,
+                                      const float*  pU,
+                                      size_t        Count,
+                                      Int32*        pI0,
+                                      Int32*        pI1,
+                                      float*        pWeight)
+{
+    size_t i = 0;
+#if DILIGENT_AVX2_SUPPORTED
+    if (Count >= 8 && IsAVX2Supported())
+        i = ComputeLinearTexFilterSampleInfoAVX2<AddressMode, IsNormalizedCoord>(Width, pWidths, pU, Count, pI0, pI1, pWeight);
+#endif
+
+#if DILIGENT_SSE2_SUPPORTED
+    {
+        __m128 W    = _mm_set1_ps(static_cast<float>(Width));
+        __m128 InvW = _mm_div_ps(_mm_set1_ps(1.f), W);
+        for (; i + 4 <= Count; i += 4)
+        {
+            if (pWidths != nullptr)
+            {
+                W    = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWidths + i)));
+                InvW = _mm_div_ps(_mm_set1_ps(1.f), W);
+            }
+            ComputeLinearTexFilterSampleInfoSSE2<AddressMode, IsNormalizedCoord>(_mm_loadu_ps(pU + i), W, InvW, pI0 + i, pI1 + i, pWeight + i);
+        }
+    }
+#elif DILIGENT_NEON_SUPPORTED
+    {
+        float32x4_t W    = vdupq_n_f32(static_cast<float>(Width));
+        float32x4_t InvW = vdivq_f32(vdupq_n_f32(1.f), W);
+        for (; i + 4 <= Count; i += 4)
+        {
+            if (pWidths != nullptr)
+            {
+                W    = vcvtq_f32_u32(vld1q_u32(pWidths + i));
+                InvW = vdivq_f32(vdupq_n_f32(1.f), W);
+            }
+            ComputeLinearTexFilterSampleInfoNEON<AddressMode, IsNormalizedCoord>(vld1q_f32(pU + i), W, InvW, pI0 + i, pI1 + i, pWeight + i);
+        }
+    }
+#endif
+
+    for (; i < Count; ++i)
+    {
+        const auto SampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(pWidths != nullptr ? pWidths[i] : Width, pU[i]);
+
+        pI0[i]     = SampleInfo.i0;
+        pI1[i]     = SampleInfo.i1;
+        pWeight[i] = SampleInfo.w;
+    }
+}
+
+/// The number of samples processed by the batch functions at a time
+static constexpr size_t TexFilterBatchSize = 64;
+
+} // namespace FilteringToolsInternal
+
+
+/// Computes linear texture filter sample info for an array of coordinates.
+///
+/// \tparam AddressMode       - Texture addressing mode, see Diligent::TEXTURE_ADDRESS_MODE.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width       - Texture width.
+/// \param [in]  pU          - Array of Count texture sample coordinates.
+/// \param [in]  Count       - The number of coordinates.
+/// \param [out] pSampleInfo - Array of Count elements that receives the sample information.
+///
+/// \remarks    The results are identical to calling GetLinearTexFilterSampleInfo() for every coordinate,
+///             but the address computations are performed for 4 or 8 coordinates at a time using SIMD
+///             instructions and do not contain any branches.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void GetLinearTexFilterSampleInfoBatch(Uint32                     Width,
+                                       const float*               pU,
+                                       size_t                     Count,
+                                       LinearTexFilterSampleInfo* pSampleInfo)
+{
+    using namespace FilteringToolsInternal;
+
+    Int32 I0[TexFilterBatchSize];
+    Int32 I1[TexFilterBatchSize];
+    float W[TexFilterBatchSize];
+    for (size_t Start = 0; Start < Count; Start += TexFilterBatchSize)
+    {
+        const size_t BatchSize = std::min(Count - Start, TexFilterBatchSize);
+        ComputeLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, nullptr, pU + Start, BatchSize, I0, I1, W);
+        for (size_t i = 0; i < BatchSize; ++i)
+            pSampleInfo[Start + i] = LinearTexFilterSampleInfo{I0[i], I1[i], W[i]};
+    }
+}
+
+
+/// Samples 2D texture at multiple locations using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pUV          - Array of Count sample coordinates.
+/// \param [in]  Count        - The number of samples.
+/// \param [out] pDst         - Array of Count elements that receives the filtered samples.
+///
+/// \remarks    The results are identical to calling FilterTexture2DBilinear() for every sample.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinearBatch(Uint32         Width,
+                                  Uint32         Height,
+                                  const SrcType* pData,
+                                  size_t         Stride,
+                                  const float2*  pUV,
+                                  size_t         Count,
+                                  DstType*       pDst)
+{
+    using namespace FilteringToolsInternal;
+
+    float U[TexFilterBatchSize];
+    float V[TexFilterBatchSize];
+    Int32 U0[TexFilterBatchSize];
+    Int32 U1[TexFilterBatchSize];
+    Int32 V0[TexFilterBatchSize];
+    Int32 V1[TexFilterBatchSize];
+    float WU[TexFilterBatchSize];
+    float WV[TexFilterBatchSize];
+    for (size_t Start = 0; Start < Count; Start += TexFilterBatchSize)
+    {
+        const size_t BatchSize = std::min(Count - Start, TexFilterBatchSize);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            U[i] = pUV[Start + i].x;
+            V[i] = pUV[Start + i].y;
+        }
+
+        ComputeLinearTexFilterSampleInfo<AddressModeU, IsNormalizedCoord>(Width, nullptr, U, BatchSize, U0, U1, WU);
+        ComputeLinearTexFilterSampleInfo<AddressModeV, IsNormalizedCoord>(Height, nullptr, V, BatchSize, V0, V1, WV);
+
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+#ifdef DILIGENT_DEBUG
+            {
+                _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{U0[i], U1[i], WU[i]}, Width, "horizontal", U[i]);
+                _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{V0[i], V1[i], WV[i]}, Height, "vertical", V[i]);
+            }
+#endif
+            const SrcType* pRow0 = pData + V0[i] * Stride;
+            const SrcType* pRow1 = pData + V1[i] * Stride;
+
+            auto S00 = static_cast<DstType>(pRow0[U0[i]]);
+            auto S10 = static_cast<DstType>(pRow0[U1[i]]);
+            auto S01 = static_cast<DstType>(pRow1[U0[i]]);
+            auto S11 = static_cast<DstType>(pRow1[U1[i]]);
+
+            pDst[Start + i] = lerp(lerp(S00, S10, WU[i]), lerp(S01, S11, WU[i]), WV[i]);
+        }
+    }
+}
+
+
+/// Texture mip level description used by the trilinear filtering functions.
+template <typename SrcType>
+struct TexFilterMipLevelData
+{
+    /// Pointer to the mip level data.
+    const SrcType* pData = nullptr;
+
+    /// Mip level width.
+    Uint32 Width = 0;
+
+    /// Mip level height.
+    Uint32 Height = 0;
+
+    /// Data stride, in pixels.
+    size_t Stride = 0;
+};
+
+
+/// Samples 2D texture using trilinear filter.
+///
+/// \tparam SrcType      - Source pixel type.
+/// \tparam DstType      - Destination type.
+/// \tparam AddressModeU - U coordinate address mode.
+/// \tparam AddressModeV - V coordinate address mode.
+///
+/// \param [in] pMips    - Array of NumMips mip levels, see Diligent::TexFilterMipLevelData.
+/// \param [in] NumMips  - The number of mip levels.
+/// \param [in] u        - Normalized sample u coordinate.
+/// \param [in] v        - Normalized sample v coordinate.
+/// \param [in] Lod      - Level of detail. The value is clamped to [0, NumMips - 1] range.
+/// \return              - Filtered texture sample.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV>
+DstType FilterTexture2DTrilinear(const TexFilterMipLevelData<SrcType>* pMips,
+                                 Uint32                                NumMips,
+                                 float                                 u,
+                                 float                                 v,
+                                 float                                 Lod)
+{
+    VERIFY_EXPR(pMips != nullptr && NumMips > 0);
+
+    Lod = clamp(Lod, 0.f, static_cast<float>(NumMips - 1));
+
+    const auto  Mip0 = static_cast<Uint32>(Lod);
+    const auto  Mip1 = std::min(Mip0 + 1, NumMips - 1);
+    const float w    = Lod - static_cast<float>(Mip0);
+
+    const auto& Level0 = pMips[Mip0];
+    const auto& Level1 = pMips[Mip1];
+
+    auto S0 = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, true>(Level0.Width, Level0.Height, Level0.pData, Level0.Stride, u, v);
+    auto S1 = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, true>(Level1.Width, Level1.Height, Level1.pData, Level1.Stride, u, v);
+    return lerp(S0, S1, w);
+}
+
+
+/// Samples 2D texture at multiple locations using trilinear filter.
+///
+/// \tparam SrcType      - Source pixel type.
+/// \tparam DstType      - Destination type.
+/// \tparam AddressModeU - U coordinate address mode.
+/// \tparam AddressModeV - V coordinate address mode.
+///
+/// \param [in]  pMips   - Array of NumMips mip levels, see Diligent::TexFilterMipLevelData.
+/// \param [in]  NumMips - The number of mip levels.
+/// \param [in]  pUV     - Array of Count normalized sample coordinates.
+/// \param [in]  pLod    - Array of Count levels of detail.
+/// \param [in]  Count   - The number of samples.
+/// \param [out] pDst    - Array of Count elements that receives the filtered samples.
+///
+/// \remarks    The results are identical to calling FilterTexture2DTrilinear() for every sample.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV>
+void FilterTexture2DTrilinearBatch(const TexFilterMipLevelData<SrcType>* pMips,
+                                   Uint32                                NumMips,
+                                   const float2*                         pUV,
+                                   const float*                          pLod,
+                                   size_t                                Count,
+                                   DstType*                              pDst)
+{
+    VERIFY_EXPR(pMips != nullptr && NumMips > 0);
+
+    using namespace FilteringToolsInternal;
+
+    float  U[TexFilterBatchSize];
+    float  V[TexFilterBatchSize];
+    Uint32 Mip[2][TexFilterBatchSize];
+    Uint32 MipWidth[2][TexFilterBatchSize];
+    Uint32 MipHeight[2][TexFilterBatchSize];
+    float  WMip[TexFilterBatchSize];
+    Int32  U0[2][TexFilterBatchSize];
+    Int32  U1[2][TexFilterBatchSize];
+    Int32  V0[2][TexFilterBatchSize];
+    Int32  V1[2][TexFilterBatchSize];
+    float  WU[2][TexFilterBatchSize];
+    float  WV[2][TexFilterBatchSize];
+
+    const float MaxLod = static_cast<float>(NumMips - 1);
+    for (size_t Start = 0; Start < Count; Start += TexFilterBatchSize)
+    {
+        const size_t BatchSize = std::min(Count - Start, TexFilterBatchSize);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            U[i] = pUV[Start + i].x;
+            V[i] = pUV[Start + i].y;
+
+            const float Lod = clamp(pLod[Start + i], 0.f, MaxLod);
+
+            Mip[0][i]       = static_cast<Uint32>(Lod);
+            Mip[1][i]       = std::min(Mip[0][i] + 1, NumMips - 1);
+            WMip[i]         = Lod - static_cast<float>(Mip[0][i]);
+            MipWidth[0][i]  = pMips[Mip[0][i]].Width;
+            MipHeight[0][i] = pMips[Mip[0][i]].Height;
+            MipWidth[1][i]  = pMips[Mip[1][i]].Width;
+            MipHeight[1][i] = pMips[Mip[1][i]].Height;
+        }
+
+        for (size_t l = 0; l < 2; ++l)
+        {
+            ComputeLinearTexFilterSampleInfo<AddressModeU, true>(0, MipWidth[l], U, BatchSize, U0[l], U1[l], WU[l]);
+            ComputeLinearTexFilterSampleInfo<AddressModeV, true>(0, MipHeight[l], V, BatchSize, V0[l], V1[l], WV[l]);
+        }
+
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            DstType S[2];
+            for (size_t l = 0; l < 2; ++l)
+            {
+                const auto& Level = pMips[Mip[l][i]];
+#ifdef DILIGENT_DEBUG
+                {
+                    _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{U0[l][i], U1[l][i], WU[l][i]}, Level.Width, "horizontal", U[i]);
+                    _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{V0[l][i], V1[l][i], WV[l][i]}, Level.Height, "vertical", V[i]);
+                }
+#endif
+                const SrcType* pRow0 = Level.pData + V0[l][i] * Level.Stride;
+                const SrcType* pRow1 = Level.pData + V1[l][i] * Level.Stride;
+
+                auto S00 = static_cast<DstType>(pRow0[U0[l][i]]);
+                auto S10 = static_cast<DstType>(pRow0[U1[l][i]]);
+                auto S01 = static_cast<DstType>(pRow1[U0[l][i]]);
+                auto S11 = static_cast<DstType>(pRow1[U1[l][i]]);
+
+                S[l] = lerp(lerp(S00, S10, WU[l][i]), lerp(S01, S11, WU[l][i]), WV[l][i]);
+            }
+            pDst[Start + i] = lerp(S[0], S[1], WMip[i]);
+        }
+    }
+}
+
 } // namespace Diligent
@@ -0,0 +1,533 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FlatHashMap class
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Open-addressing hash map that stores its elements in a single contiguous array.
+
+/// The map uses linear probing and keeps a separate array of one-byte control values
+/// (empty, deleted, or a 7-bit fingerprint of the element hash), so that most unsuccessful
+/// probes are resolved without touching the elements themselves. The maximum load factor is 7/8.
+///
+/// Memory is allocated through AllocatorType, which makes the map compatible with
+/// STDAllocatorRawMem and the engine raw memory allocator.
+///
+/// find(), count() and erase() accept any key type that both HashType and KeyEqualType
+/// can handle, which allows e.g. HashMapStringKey maps to be searched by const Char*
+/// without constructing a temporary key (see HashMapStringKey::Hasher and HashMapStringKey::EqualTo).
+///
+/// \remarks Unlike std::unordered_map, inserting an element may relocate other elements,
+///          which invalidates all iterators, pointers and references. Erasing an element
+///          only invalidates iterators and references to that element.
+///          KeyType and ValueType must be move-constructible. Elements must not be
+///          modified through the key member.
+template <typename KeyType,
+          typename ValueType,
+          typename HashType      = std::hash<KeyType>,
+          typename KeyEqualType  = std::equal_to<KeyType>,
+          typename AllocatorType = std::allocator<std::pair<KeyType, ValueType>>>
+class FlatHashMap
+{
+public:
+    using key_type       = KeyType;
+    using mapped_type    = ValueType;
+    using value_type     = std::pair<KeyType, ValueType>;
+    using size_type      = size_t;
+    using hasher         = HashType;
+    using key_equal      = KeyEqualType;
+    using allocator_type = AllocatorType;
+
+private:
+    template <bool IsConst>
+    class IteratorBase
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = FlatHashMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+        using reference         = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+
+        IteratorBase() noexcept {}
+
+        // clang-format off
+        IteratorBase           (const IteratorBase&) noexcept = default;
+        IteratorBase& operator=(const IteratorBase&) noexcept = default;
+        // clang-format on
+
+        // Allows implicit iterator -> const_iterator conversion
+        template <bool _IsConst = IsConst, typename = typename std::enable_if<_IsConst>::type>
+        IteratorBase(const IteratorBase<false>& It) noexcept :
+            // clang-format off
+            m_pCtrl   {It.m_pCtrl   },
+            m_pCtrlEnd{It.m_pCtrlEnd},
+            m_pSlot   {It.m_pSlot   }
+        // clang-format on
+        {}
+
+        reference operator*() const { return *m_pSlot; }
+        pointer   operator->() const { return m_pSlot; }
+
+        IteratorBase& operator++()
+        {
+            VERIFY(m_pCtrl != m_pCtrlEnd, "Incrementing end iterator");
+            do
+            {
+                ++m_pCtrl;
+                ++m_pSlot;
+            } while (m_pCtrl != m_pCtrlEnd && !IsFull(*m_pCtrl));
+            return *this;
+        }
+
+        IteratorBase operator++(int)
+        {
+            IteratorBase Tmp{*this};
+            ++(*this);
+            return Tmp;
+        }
+
+        bool operator==(const IteratorBase& rhs) const { return m_pCtrl == rhs.m_pCtrl; }
+        bool operator!=(const IteratorBase& rhs) const { return m_pCtrl != rhs.m_pCtrl; }
+
+    private:
+        friend class FlatHashMap;
+        friend class IteratorBase<!IsConst>;
+
+        IteratorBase(const Uint8* pCtrl, const Uint8* pCtrlEnd, pointer pSlot) noexcept :
+            // clang-format off
+            m_pCtrl   {pCtrl   },
+            m_pCtrlEnd{pCtrlEnd},
+            m_pSlot   {pSlot   }
+        // clang-format on
+        {}
+
+        const Uint8* m_pCtrl    = nullptr;
+        const Uint8* m_pCtrlEnd = nullptr;
+        pointer      m_pSlot    = nullptr;
+    };
+
+public:
+    using iterator       = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    explicit FlatHashMap(const AllocatorType& Allocator = AllocatorType{}) :
+        FlatHashMap{0, HashType{}, KeyEqualType{}, Allocator}
+    {}
+
+    FlatHashMap(size_t               InitialCapacity,
+                const HashType&      Hash      = HashType{},
+                const KeyEqualType&  KeyEqual  = KeyEqualType{},
+                const AllocatorType& Allocator = AllocatorType{}) :
+        // clang-format off
+        m_Hash         {Hash     },
+        m_KeyEqual     {KeyEqual },
+        m_SlotAllocator{Allocator},
+        m_CtrlAllocator{Allocator}
+    // clang-format on
+    {
+        if (InitialCapacity != 0)
+            reserve(InitialCapacity);
+    }
+
+    FlatHashMap(FlatHashMap&& rhs) noexcept :
+        // clang-format off
+        m_Hash         {std::move(rhs.m_Hash)         },
+        m_KeyEqual     {std::move(rhs.m_KeyEqual)     },
+        m_SlotAllocator{std::move(rhs.m_SlotAllocator)},
+        m_CtrlAllocator{std::move(rhs.m_CtrlAllocator)},
+        m_Ctrl         {rhs.m_Ctrl      },
+        m_Slots        {rhs.m_Slots     },
+        m_Capacity     {rhs.m_Capacity  },
+        m_Size         {rhs.m_Size      },
+        m_NumDeleted   {rhs.m_NumDeleted}
+    // clang-format on
+    {
+        rhs.m_Ctrl       = nullptr;
+        rhs.m_Slots      = nullptr;
+        rhs.m_Capacity   = 0;
+        rhs.m_Size       = 0;
+        rhs.m_NumDeleted = 0;
+    }
+
+    // clang-format off
+    FlatHashMap           (const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(FlatHashMap&&)      = delete;
+    // clang-format on
+
+    ~FlatHashMap()
+    {
+        DestroyElements();
+        FreeStorage(m_Ctrl, m_Slots, m_Capacity);
+    }
+
+    iterator       begin() noexcept { return MakeIterator(FindFirstFull()); }
+    const_iterator begin() const noexcept { return MakeIterator(FindFirstFull()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator       end() noexcept { return MakeIterator(m_Capacity); }
+    const_iterator end() const noexcept { return MakeIterator(m_Capacity); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool   empty() const noexcept { return m_Size == 0; }
+    size_t size() const noexcept { return m_Size; }
+
+    /// Returns the number of slots in the table
+    size_t capacity() const noexcept { return m_Capacity; }
+
+    /// Destroys all elements, but keeps the allocated storage
+    void clear()
+    {
+        DestroyElements();
+        if (m_Ctrl != nullptr)
+            memset(m_Ctrl, CtrlEmpty, m_Capacity);
+        m_Size       = 0;
+        m_NumDeleted = 0;
+    }
+
+    /// Makes sure that the map can hold at least Count elements without reallocation
+    void reserve(size_t Count)
+    {
+        size_t NewCapacity = m_Capacity != 0 ? m_Capacity : MinCapacity;
+        while (GetMaxLoad(NewCapacity) < Count)
+            NewCapacity *= 2;
+        if (NewCapacity != m_Capacity)
+            Rehash(NewCapacity);
+    }
+
+    template <typename LookupKeyType>
+    iterator find(const LookupKeyType& Key)
+    {
+        return MakeIterator(FindIndex(Key, HashKey(Key)));
+    }
+
+    template <typename LookupKeyType>
+    const_iterator find(const LookupKeyType& Key) const
+    {
+        return MakeIterator(FindIndex(Key, HashKey(Key)));
+    }
+
+    template <typename LookupKeyType>
+    size_t count(const LookupKeyType& Key) const
+    {
+        return FindIndex(Key, HashKey(Key)) != m_Capacity ? 1 : 0;
+    }
+
+    /// Inserts a new element constructed in place from Key and Args, if
+    /// there is no element with the same key in the map.
+    template <typename... ArgsType>
+    std::pair<iterator, bool> try_emplace(const KeyType& Key, ArgsType&&... Args)
+    {
+        return TryEmplaceImpl(Key, std::forward<ArgsType>(Args)...);
+    }
+
+    template <typename... ArgsType>
+    std::pair<iterator, bool> try_emplace(KeyType&& Key, ArgsType&&... Args)
+    {
+        return TryEmplaceImpl(std::move(Key), std::forward<ArgsType>(Args)...);
+    }
+
+    /// Constructs value_type from Args and inserts it into the map, if there is
+    /// no element with the same key.
+    template <typename... ArgsType>
+    std::pair<iterator, bool> emplace(ArgsType&&... Args)
+    {
+        value_type Elem(std::forward<ArgsType>(Args)...);
+        return TryEmplaceImpl(std::move(Elem.first), std::move(Elem.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& Elem)
+    {
+        return TryEmplaceImpl(Elem.first, Elem.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& Elem)
+    {
+        return TryEmplaceImpl(std::move(Elem.first), std::move(Elem.second));
+    }
+
+    ValueType& operator[](const KeyType& Key)
+    {
+        return TryEmplaceImpl(Key).first->second;
+    }
+
+    ValueType& operator[](KeyType&& Key)
+    {
+        return TryEmplaceImpl(std::move(Key)).first->second;
+    }
+
+    /// Erases the element pointed to by the iterator and returns the iterator
+    /// that follows the removed element.
+    iterator erase(const_iterator It)
+    {
+        VERIFY(It != end(), "Erasing end iterator");
+        const size_t Idx = static_cast<size_t>(It.m_pCtrl - m_Ctrl);
+        EraseAt(Idx);
+        iterator Next = MakeIterator(Idx);
+        return ++Next;
+    }
+
+    iterator erase(iterator It)
+    {
+        return erase(const_iterator{It});
+    }
+
+    template <typename LookupKeyType>
+    size_t erase(const LookupKeyType& Key)
+    {
+        const size_t Idx = FindIndex(Key, HashKey(Key));
+        if (Idx == m_Capacity)
+            return 0;
+        EraseAt(Idx);
+        return 1;
+    }
+
+private:
+    using SlotAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<value_type>;
+    using CtrlAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<Uint8>;
+
+    // Control byte values. Full slots have the most significant bit set and
+    // keep the top 7 bits of the element hash in the remaining bits.
+    static constexpr Uint8  CtrlEmpty   = 0x00;
+    static constexpr Uint8  CtrlDeleted = 0x01;
+    static constexpr Uint8  CtrlFullBit = 0x80;
+    static constexpr size_t MinCapacity = 16;
+
+    static bool IsFull(Uint8 Ctrl) noexcept
+    {
+        return (Ctrl & CtrlFullBit) != 0;
+    }
+
+    static Uint8 GetFingerprint(size_t Hash) noexcept
+    {
+        return static_cast<Uint8>(CtrlFullBit | (Hash >> (sizeof(size_t) * 8 - 7)));
+    }
+
+    static size_t GetMaxLoad(size_t Capacity) noexcept
+    {
+        return Capacity - Capacity / 8;
+    }
+
+    template <typename LookupKeyType>
+    size_t HashKey(const LookupKeyType& Key) const
+    {
+        // Many hash functions used by the engine (e.g. std::hash for pointers and integers)
+        // do not distribute entropy over all bits, so mix the hash before using its low
+        // bits as the slot index and its high bits as the fingerprint.
+        Uint64 Hash = static_cast<Uint64>(m_Hash(Key));
+        Hash ^= Hash >> 33;
+        Hash *= 0xff51afd7ed558ccdull;
+        Hash ^= Hash >> 33;
+        Hash *= 0xc4ceb9fe1a85ec53ull;
+        Hash ^= Hash >> 33;
+        return static_cast<size_t>(sizeof(size_t) < sizeof(Uint64) ? (Hash ^ (Hash >> 32)) : Hash);
+    }
+
+    // Returns the index of the element with the given key, or m_Capacity if there is no such element
+    template <typename LookupKeyType>
+    size_t FindIndex(const LookupKeyType& Key, size_t Hash) const
+    {
+        if (m_Size == 0)
+            return m_Capacity;
+
+        const auto   Fingerprint = GetFingerprint(Hash);
+        const size_t Mask        = m_Capacity - 1;
+        // The table always contains at least one empty slot, so the loop terminates
+        for (size_t Idx = Hash & Mask;; Idx = (Idx + 1) & Mask)
+        {
+            const auto Ctrl = m_Ctrl[Idx];
+            if (Ctrl == CtrlEmpty)
+                return m_Capacity;
+            if (Ctrl == Fingerprint && m_KeyEqual(m_Slots[Idx].first, Key))
+                return Idx;
+        }
+    }
+
+    // Returns the first empty or deleted slot in the probe sequence of the hash
+    static size_t FindInsertIndex(const Uint8* pCtrl, size_t Capacity, size_t Hash) noexcept
+    {
+        const size_t Mask = Capacity - 1;
+        size_t       Idx  = Hash & Mask;
+        while (IsFull(pCtrl[Idx]))
+            Idx = (Idx + 1) & Mask;
+        return Idx;
+    }
+
+    template <typename KeyArgType, typename... ArgsType>
+    std::pair<iterator, bool> TryEmplaceImpl(KeyArgType&& Key, ArgsType&&... Args)
+    {
+        const size_t Hash = HashKey(Key);
+
+        size_t Idx = FindIndex(Key, Hash);
+        if (Idx != m_Capacity)
+            return std::make_pair(MakeIterator(Idx), false);
+
+        if (m_Size + m_NumDeleted + 1 > GetMaxLoad(m_Capacity))
+        {
+            // If at least half of the occupied slots are tombstones, rehash in place
+            const size_t NewCapacity = m_Capacity == 0 ? MinCapacity : (m_Size + 1 > GetMaxLoad(m_Capacity) / 2 ? m_Capacity * 2 : m_Capacity);
+            Rehash(NewCapacity);
+        }
+
+        Idx = FindInsertIndex(m_Ctrl, m_Capacity, Hash);
+        new (m_Slots + Idx) value_type(std::piecewise_construct,
+                                       std::forward_as_tuple(std::forward<KeyArgType>(Key)),
+                                       std::forward_as_tuple(std::forward<ArgsType>(Args)...));
+        if (m_Ctrl[Idx] == CtrlDeleted)
+            --m_NumDeleted;
+        m_Ctrl[Idx] = GetFingerprint(Hash);
+        ++m_Size;
+
+        return std::make_pair(MakeIterator(Idx), true);
+    }
+
+    void EraseAt(size_t Idx)
+    {
+        VERIFY_EXPR(Idx < m_Capacity && IsFull(m_Ctrl[Idx]));
+        m_Slots[Idx].~value_type();
+        // If the next slot is empty, no probe sequence can pass through this slot,
+        // so it can be marked as empty rather than deleted.
+        if (m_Ctrl[(Idx + 1) & (m_Capacity - 1)] == CtrlEmpty)
+        {
+            m_Ctrl[Idx] = CtrlEmpty;
+        }
+        else
+        {
+            m_Ctrl[Idx] = CtrlDeleted;
+            ++m_NumDeleted;
+        }
+        --m_Size;
+    }
+
+    void Rehash(size_t NewCapacity)
+    {
+        VERIFY((NewCapacity & (NewCapacity - 1)) == 0, "Capacity must be a power of two");
+        VERIFY_EXPR(m_Size < GetMaxLoad(NewCapacity));
+
+        auto* pNewCtrl  = m_CtrlAllocator.allocate(NewCapacity);
+        auto* pNewSlots = m_SlotAllocator.allocate(NewCapacity);
+        memset(pNewCtrl, CtrlEmpty, NewCapacity);
+
+        for (size_t i = 0; i < m_Capacity; ++i)
+        {
+            if (!IsFull(m_Ctrl[i]))
+                continue;
+
+            auto&        Elem = m_Slots[i];
+            const size_t Hash = HashKey(Elem.first);
+            const size_t Idx  = FindInsertIndex(pNewCtrl, NewCapacity, Hash);
+            new (pNewSlots + Idx) value_type(std::move(Elem));
+            pNewCtrl[Idx] = GetFingerprint(Hash);
+            Elem.~value_type();
+        }
+
+        FreeStorage(m_Ctrl, m_Slots, m_Capacity);
+        m_Ctrl       = pNewCtrl;
+        m_Slots      = pNewSlots;
+        m_Capacity   = NewCapacity;
+        m_NumDeleted = 0;
+    }
+
+    void DestroyElements()
+    {
+        for (size_t i = 0; i < m_Capacity && m_Size > 0; ++i)
+        {
+            if (IsFull(m_Ctrl[i]))
+            {
+                m_Slots[i].~value_type();
+                --m_Size;
+            }
+        }
+    }
+
+    void FreeStorage(Uint8* pCtrl, value_type* pSlots, size_t Capacity)
+    {
+        if (pCtrl != nullptr)
+            m_CtrlAllocator.deallocate(pCtrl, Capacity);
+        if (pSlots != nullptr)
+            m_SlotAllocator.deallocate(pSlots, Capacity);
+    }
+
+    size_t FindFirstFull() const noexcept
+    {
+        size_t Idx = 0;
+        while (Idx < m_Capacity && !IsFull(m_Ctrl[Idx]))
+            ++Idx;
+        return Idx;
+    }
+
+    iterator MakeIterator(size_t Idx) noexcept
+    {
+        return iterator{m_Ctrl + Idx, m_Ctrl + m_Capacity, m_Slots + Idx};
+    }
+
+    const_iterator MakeIterator(size_t Idx) const noexcept
+    {
+        return const_iterator{m_Ctrl + Idx, m_Ctrl + m_Capacity, m_Slots + Idx};
+    }
+
+    HashType          m_Hash;
+    KeyEqualType      m_KeyEqual;
+    SlotAllocatorType m_SlotAllocator;
+    CtrlAllocatorType m_CtrlAllocator;
+
+    Uint8*      m_Ctrl       = nullptr;
+    value_type* m_Slots      = nullptr;
+    size_t      m_Capacity   = 0;
+    size_t      m_Size       = 0;
+    size_t      m_NumDeleted = 0;
+};
+
+// clang-format off
+template <typename KeyType, typename ValueType, typename HashType, typename KeyEqualType, typename AllocatorType>
+constexpr Uint8  FlatHashMap<KeyType, ValueType, HashType, KeyEqualType, AllocatorType>::CtrlEmpty;
+template <typename KeyType, typename ValueType, typename HashType, typename KeyEqualType, typename AllocatorType>
+constexpr Uint8  FlatHashMap<KeyType, ValueType, HashType, KeyEqualType, AllocatorType>::CtrlDeleted;
+template <typename KeyType, typename ValueType, typename HashType, typename KeyEqualType, typename AllocatorType>
+constexpr Uint8  FlatHashMap<KeyType, ValueType, HashType, KeyEqualType, AllocatorType>::CtrlFullBit;
+template <typename KeyType, typename ValueType, typename HashType, typename KeyEqualType, typename AllocatorType>
+constexpr size_t FlatHashMap<KeyType, ValueType, HashType, KeyEqualType, AllocatorType>::MinCapacity;
+// clang-format on
+
+} // namespace Diligent
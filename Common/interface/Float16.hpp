@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Conversions between 32-bit floats and 16-, 11- and 10-bit floating-point formats
+
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Converts the unsigned part of a small float with a 5-bit exponent (bias 15) and
+/// MantissaBits-bit mantissa to a 32-bit float.
+template <Uint32 MantissaBits>
+float SmallFloatToFloat32(Uint32 Bits)
+{
+    static_assert(MantissaBits > 0 && MantissaBits < 23, "Invalid number of mantissa bits");
+
+    const Uint32 Exponent = (Bits >> MantissaBits) & 0x1Fu;
+    const Uint32 Mantissa = Bits & ((1u << MantissaBits) - 1u);
+
+    Uint32 F32Bits = 0;
+    if (Exponent == 0x1Fu)
+    {
+        // Infinity or NaN
+        F32Bits = 0x7F800000u | (Mantissa << (23 - MantissaBits));
+    }
+    else if (Exponent == 0)
+    {
+        // Zero or denormal: Mantissa * 2^(-14 - MantissaBits) is exactly representable
+        return static_cast<float>(Mantissa) * (1.f / static_cast<float>(1u << (14 + MantissaBits)));
+    }
+    else
+    {
+        F32Bits = ((Exponent + (127 - 15)) << 23) | (Mantissa << (23 - MantissaBits));
+    }
+
+    float Val;
+    memcpy(&Val, &F32Bits, sizeof(Val));
+    return Val;
+}
+
+/// Converts the magnitude of a 32-bit float to a small float with a 5-bit exponent (bias 15)
+/// and MantissaBits-bit mantissa. The sign is ignored. Values are rounded to nearest even,
+/// values that are too large become infinity, NaNs remain NaNs.
+template <Uint32 MantissaBits>
+Uint32 Float32ToSmallFloat(float Val)
+{
+    static_assert(MantissaBits > 0 && MantissaBits < 23, "Invalid number of mantissa bits");
+
+    Uint32 F32Bits;
+    memcpy(&F32Bits, &Val, sizeof(F32Bits));
+    F32Bits &= 0x7FFFFFFFu;
+
+    constexpr Uint32 InfBits = 0x1Fu << MantissaBits;
+    if (F32Bits > 0x7F800000u)
+        return InfBits | (1u << (MantissaBits - 1)); // NaN
+
+    const int Exponent = static_cast<int>(F32Bits >> 23) - 127;
+    if (Exponent >= 16)
+        return InfBits;
+
+    Uint32 Mantissa = F32Bits & 0x7FFFFFu;
+    Uint32 Shift    = 23 - MantissaBits;
+    Uint32 Result   = 0;
+    if (Exponent >= -14)
+    {
+        Result = (static_cast<Uint32>(Exponent + 15) << MantissaBits) | (Mantissa >> Shift);
+    }
+    else
+    {
+        // Denormal
+        Shift += static_cast<Uint32>(-14 - Exponent);
+        if (Shift >= 32)
+            return 0;
+        Mantissa |= 0x800000u;
+        Result = Mantissa >> Shift;
+    }
+
+    // Round to nearest even. Carry from the mantissa correctly propagates into the exponent.
+    const Uint32 Remainder = Mantissa & ((1u << Shift) - 1u);
+    const Uint32 Half      = 1u << (Shift - 1);
+    if (Remainder > Half || (Remainder == Half && (Result & 1u) != 0))
+        ++Result;
+
+    return Result;
+}
+
+/// Converts IEEE 754 half-precision float bits to a 32-bit float.
+inline float Float16ToFloat32(Uint16 Bits)
+{
+    const float Abs = SmallFloatToFloat32<10>(Bits & 0x7FFFu);
+    return (Bits & 0x8000u) != 0 ? -Abs : Abs;
+}
+
+/// Converts a 32-bit float to IEEE 754 half-precision float bits.
+inline Uint16 Float32ToFloat16(float Val)
+{
+    Uint32 F32Bits;
+    memcpy(&F32Bits, &Val, sizeof(F32Bits));
+    return static_cast<Uint16>(((F32Bits >> 16) & 0x8000u) | Float32ToSmallFloat<10>(Val));
+}
+
+/// Unpacks R11G11B10 unsigned float components.
+inline void UnpackR11G11B10Float(Uint32 Packed, float& R, float& G, float& B)
+{
+    R = SmallFloatToFloat32<6>(Packed & 0x7FFu);
+    G = SmallFloatToFloat32<6>((Packed >> 11) & 0x7FFu);
+    B = SmallFloatToFloat32<5>(Packed >> 22);
+}
+
+/// Packs three floats to R11G11B10 unsigned float format. Negative values are clamped to zero.
+inline Uint32 PackR11G11B10Float(float R, float G, float B)
+{
+    // Comparisons with NaN are false, so NaNs are preserved
+    R = R < 0 ? 0 : R;
+    G = G < 0 ? 0 : G;
+    B = B < 0 ? 0 : B;
+    return Float32ToSmallFloat<6>(R) | (Float32ToSmallFloat<6>(G) << 11) | (Float32ToSmallFloat<5>(B) << 22);
+}
+
+} // namespace Diligent
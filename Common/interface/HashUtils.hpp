@@ -30,7 +30,14 @@
 #include <functional>
 #include <memory>
 #include <cstring>
+#include <string>
+#include <type_traits>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#    include <intrin.h>
+#endif
+
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -39,11 +46,227 @@
 namespace Diligent
 {
 
-// http://www.boost.org/doc/libs/1_35_0/doc/html/hash/combine.html
+// The hash functions below are based on wyhash (https://github.com/wangyi-fudan/wyhash, public domain):
+// every step is a 64x64->128-bit multiplication whose halves are folded together, which
+// gives much better avalanche behavior than shift-add combining at a similar cost.
+
+/// Computes the full 128-bit product of A and B and returns the lower half in A and the upper half in B
+inline void HashMultiply128(Uint64& A, Uint64& B)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto R = static_cast<unsigned __int128>(A) * B;
+
+    A = static_cast<Uint64>(R);
+    B = static_cast<Uint64>(R >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    A = _umul128(A, B, &B);
+#else
+    const Uint64 ha = A >> 32, hb = B >> 32, la = static_cast<Uint32>(A), lb = static_cast<Uint32>(B);
+    const Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+
+    Uint64 c  = t < rl ? 1 : 0;
+    Uint64 lo = t + (rm1 << 32);
+    c += lo < t ? 1 : 0;
+    A = lo;
+    B = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/// Mixes two 64-bit values into one
+inline Uint64 HashMix64(Uint64 A, Uint64 B)
+{
+    HashMultiply128(A, B);
+    return A ^ B;
+}
+
+namespace HashInternal
+{
+
+// clang-format off
+constexpr Uint64 HashSecret0 = 0xa0761d6478bd642full;
+constexpr Uint64 HashSecret1 = 0xe7037ed1a0b428dbull;
+constexpr Uint64 HashSecret2 = 0x8ebc6af09c88c6e3ull;
+constexpr Uint64 HashSecret3 = 0x589965cc75374cc3ull;
+// clang-format on
+
+inline Uint64 Read64(const Uint8* p)
+{
+    Uint64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline Uint64 Read32(const Uint8* p)
+{
+    Uint32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline Uint64 Read1To3(const Uint8* p, size_t Size)
+{
+    return (Uint64{p[0]} << 16) | (Uint64{p[Size >> 1]} << 8) | Uint64{p[Size - 1]};
+}
+
+} // namespace HashInternal
+
+/// Computes a 64-bit hash of an arbitrary block of memory.
+
+/// The data is consumed in 8-, 16- and 48-byte chunks. The function may be used for
+/// arrays of scalars and for POD structures that have no padding, as the values of
+/// padding bytes are unspecified.
+inline Uint64 HashBytes(const void* pData, size_t Size, Uint64 Seed = 0)
+{
+    using namespace HashInternal;
+
+    const auto* p = static_cast<const Uint8*>(pData);
+
+    Seed ^= HashMix64(Seed ^ HashSecret0, HashSecret1);
+
+    Uint64 a = 0, b = 0;
+    if (Size <= 16)
+    {
+        if (Size >= 4)
+        {
+            const size_t Offset = (Size >> 3) << 2;
+
+            a = (Read32(p) << 32) | Read32(p + Offset);
+            b = (Read32(p + Size - 4) << 32) | Read32(p + Size - 4 - Offset);
+        }
+        else if (Size > 0)
+        {
+            a = Read1To3(p, Size);
+        }
+    }
+    else
+    {
+        size_t i = Size;
+        if (i > 48)
+        {
+            Uint64 Seed1 = Seed, Seed2 = Seed;
+            do
+            {
+                Seed  = HashMix64(Read64(p) ^ HashSecret1, Read64(p + 8) ^ Seed);
+                Seed1 = HashMix64(Read64(p + 16) ^ HashSecret2, Read64(p + 24) ^ Seed1);
+                Seed2 = HashMix64(Read64(p + 32) ^ HashSecret3, Read64(p + 40) ^ Seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            Seed ^= Seed1 ^ Seed2;
+        }
+        while (i > 16)
+        {
+            Seed = HashMix64(Read64(p) ^ HashSecret1, Read64(p + 8) ^ Seed);
+            i -= 16;
+            p += 16;
+        }
+        a = Read64(p + i - 16);
+        b = Read64(p + i - 8);
+    }
+
+    a ^= HashSecret1;
+    b ^= Seed;
+    HashMultiply128(a, b);
+    return HashMix64(a ^ HashSecret0 ^ Size, b ^ HashSecret1);
+}
+
+/// Converts a 64-bit hash to size_t
+inline size_t HashToSizeT(Uint64 Hash)
+{
+    return static_cast<size_t>(sizeof(size_t) < sizeof(Uint64) ? (Hash ^ (Hash >> 32)) : Hash);
+}
+
+namespace HashInternal
+{
+
+// Integral, enum and pointer values are hashed directly, without going through std::hash,
+// which for these types is typically an identity function.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, Uint64>::type GetHashInput(const T& Val)
+{
+    return static_cast<Uint64>(Val);
+}
+
+template <typename T>
+Uint64 GetHashInput(T* const& Val)
+{
+    return static_cast<Uint64>(reinterpret_cast<size_t>(Val));
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, Uint64>::type GetHashInput(const T& Val)
+{
+    // +0.0 and -0.0 compare equal, so they must produce the same hash
+    if (Val == T{0})
+        return 0;
+
+    Uint64 Bits = 0;
+    memcpy(&Bits, &Val, sizeof(Val) < sizeof(Bits) ? sizeof(Val) : sizeof(Bits));
+    return Bits;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value && !std::is_enum<T>::value && !std::is_floating_point<T>::value && !std::is_pointer<T>::value, Uint64>::type
+GetHashInput(const T& Val)
+{
+    return static_cast<Uint64>(std::hash<T>{}(Val));
+}
+
+} // namespace HashInternal
+
+/// Streaming hasher that accumulates a 64-bit hash of a sequence of values.
+
+/// \remarks The class is intentionally not named Hasher to avoid confusion with
+///          the Hasher functors nested in hash map key types (e.g. HashMapStringKey::Hasher).
+class StreamingHasher
+{
+public:
+    explicit StreamingHasher(Uint64 Seed = 0) noexcept :
+        m_State{Seed}
+    {}
+
+    /// Adds a value to the hash. Integral, enum, floating-point and pointer values
+    /// are hashed directly; other types are hashed through std::hash.
+    template <typename T>
+    StreamingHasher& Update(const T& Val)
+    {
+        m_State = HashMix64(m_State ^ HashInternal::HashSecret0, HashInternal::GetHashInput(Val) ^ HashInternal::HashSecret1);
+        return *this;
+    }
+
+    template <typename FirstArgType, typename... RestArgsType>
+    StreamingHasher& Update(const FirstArgType& FirstArg, const RestArgsType&... RestArgs)
+    {
+        Update(FirstArg);
+        return Update(RestArgs...);
+    }
+
+    /// Adds a block of memory to the hash, see HashBytes().
+    StreamingHasher& UpdateBytes(const void* pData, size_t Size)
+    {
+        m_State = HashBytes(pData, Size, m_State);
+        return *this;
+    }
+
+    /// Adds a null-terminated string to the hash.
+    StreamingHasher& UpdateStr(const Char* Str)
+    {
+        return UpdateBytes(Str, Str != nullptr ? strlen(Str) : 0);
+    }
+
+    Uint64 Digest() const noexcept
+    {
+        return m_State;
+    }
+
+private:
+    Uint64 m_State;
+};
+
 template <typename T>
 void HashCombine(std::size_t& Seed, const T& Val)
 {
-    Seed ^= std::hash<T>{}(Val) + 0x9e3779b9 + (Seed << 6) + (Seed >> 2);
+    Seed = HashToSizeT(HashMix64(Uint64{Seed} ^ HashInternal::HashSecret0, HashInternal::GetHashInput(Val) ^ HashInternal::HashSecret1));
 }
 
 template <typename FirstArgType, typename... RestArgsType>
@@ -66,11 +289,10 @@ struct CStringHash
 {
     size_t operator()(const CharType* str) const
     {
-        // http://www.cse.yorku.ca/~oz/hash.html
-        std::size_t Seed = 0;
-        while (size_t Ch = *(str++))
-            Seed = Seed * 65599 + Ch;
-        return Seed;
+        // Hash the whole string at once rather than one character at a time:
+        // the length is found by the (typically vectorized) library routine and
+        // the characters are then consumed in 8- and 16-byte chunks.
+        return HashToSizeT(HashBytes(str, std::char_traits<CharType>::length(str) * sizeof(CharType)));
     }
 };
 
@@ -118,6 +340,24 @@ public:
         }
     }
 
+    // Initializes the key with a string whose hash has already been computed by CStringHash
+    // (e.g. an InternedString). Unless a copy is made, the string must outlive the key.
+    HashMapStringKey(size_t _Hash, const Char* _Str, bool bMakeCopy = false) :
+        Str{_Str},
+        Ownership_Hash{_Hash & HashMask}
+    {
+        VERIFY(Str, "String pointer must not be null");
+        VERIFY_EXPR(GetHash() == (CStringHash<Char>{}.operator()(Str) & HashMask));
+        if (bMakeCopy)
+        {
+            auto  LenWithZeroTerm = strlen(Str) + 1;
+            auto* StrCopy         = new char[LenWithZeroTerm];
+            memcpy(StrCopy, Str, LenWithZeroTerm);
+            Str = StrCopy;
+            Ownership_Hash |= StrOwnershipMask;
+        }
+    }
+
     // Make this constructor explicit to avoid unintentional string copies
     explicit HashMapStringKey(const String& Str) :
         HashMapStringKey{Str.c_str(), true}
@@ -206,6 +446,27 @@ public:
         {
             return Key.GetHash();
         }
+
+        // Allows looking up strings in containers that support heterogeneous
+        // lookup (e.g. FlatHashMap) without constructing temporary keys.
+        size_t operator()(const Char* Str) const
+        {
+            return CStringHash<Char>{}.operator()(Str) & HashMask;
+        }
+    };
+
+    struct EqualTo
+    {
+        bool operator()(const HashMapStringKey& Key1, const HashMapStringKey& Key2) const
+        {
+            return Key1 == Key2;
+        }
+
+        bool operator()(const HashMapStringKey& Key, const Char* Str) const
+        {
+            VERIFY_EXPR(Str != nullptr);
+            return Key.Str != nullptr && (Key.Str == Str || strcmp(Key.Str, Str) == 0);
+        }
     };
 
 protected:
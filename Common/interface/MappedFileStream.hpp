@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Implementation of the MappedFileStream and MappedFileBlob classes
+
+#include <vector>
+
+#include "../../Primitives/interface/FileStream.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+// {A81B0529-90C7-4E19-9C36-39BBF5416647}
+static const INTERFACE_ID IID_MappedFileStream =
+    {0xa81b0529, 0x90c7, 0x4e19, {0x9c, 0x36, 0x39, 0xbb, 0xf5, 0x41, 0x66, 0x47}};
+
+/// Access pattern hint for the mapped file
+enum class EMappedFileAccessHint
+{
+    /// The file will be read sequentially, once (e.g. shader source)
+    Sequential,
+
+    /// The file will be accessed randomly (e.g. a binary archive)
+    Random
+};
+
+/// Data blob that references the contents of a memory-mapped file.
+
+/// The file is mapped as a private copy-on-write mapping: GetDataPtr() returns writable memory,
+/// but modifications are never written back to the file, and only the pages that are
+/// actually modified consume private memory. Resizing the blob copies the data
+/// into a heap buffer.
+///
+/// On platforms that do not support memory mapping, the file is read into a heap buffer.
+class MappedFileBlob : public ObjectBase<IDataBlob>
+{
+public:
+    typedef ObjectBase<IDataBlob> TBase;
+
+    MappedFileBlob(IReferenceCounters*   pRefCounters,
+                   const Char*           Path,
+                   EMappedFileAccessHint AccessHint = EMappedFileAccessHint::Sequential);
+    ~MappedFileBlob();
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
+
+    /// Sets the size of the data buffer
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the data buffer
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override;
+
+    /// Returns the pointer to the data buffer
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override;
+
+    /// Returns const pointer to the data buffer
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override;
+
+    /// Returns true if the file has been successfully opened
+    bool IsValid() const { return m_IsValid; }
+
+    /// Returns true if the data is backed by the file mapping
+    bool IsMapped() const { return m_pMappedData != nullptr; }
+
+private:
+    void Unmap();
+
+    void*  m_pMappedData = nullptr;
+    size_t m_MappedSize  = 0;
+
+    // Used when the file can't be mapped or after the blob has been resized
+    std::vector<Uint8> m_DataBuff;
+
+    bool m_IsValid = false;
+};
+
+
+/// Read-only file stream backed by a memory-mapped file.
+
+/// ReadBlob() and Read() copy the data as required by IFileStream, while
+/// ReadRemainingData() gives access to the mapped file contents without copying.
+/// Use ReadStreamData() to take advantage of this for arbitrary streams.
+class MappedFileStream : public ObjectBase<IFileStream>
+{
+public:
+    typedef ObjectBase<IFileStream> TBase;
+
+    MappedFileStream(IReferenceCounters*   pRefCounters,
+                     const Char*           Path,
+                     EMappedFileAccessHint AccessHint = EMappedFileAccessHint::Sequential);
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
+
+    /// Reads data from the stream
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override;
+
+    /// Reads data from the stream
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override;
+
+    /// Writing to the mapped file stream is not supported; the method always returns false
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override;
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override;
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override;
+
+    /// Returns the data blob that contains the rest of the stream and moves to the end of the stream.
+
+    /// If the stream is at the beginning, the blob references the mapped file without copying it.
+    RefCntAutoPtr<IDataBlob> ReadRemainingData();
+
+private:
+    RefCntAutoPtr<MappedFileBlob> m_pData;
+    size_t                        m_CurrentOffset = 0;
+};
+
+
+/// Reads the rest of the stream into a data blob.
+
+/// If the stream is a MappedFileStream, the returned blob references the mapped
+/// file contents; otherwise the data is copied into a new DataBlobImpl.
+RefCntAutoPtr<IDataBlob> ReadStreamData(IFileStream* pStream);
+
+} // namespace Diligent
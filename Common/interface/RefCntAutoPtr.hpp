@@ -408,6 +408,23 @@ public:
 
     /// Obtains a strong reference to the object
     RefCntAutoPtr<T> Lock()
+    {
+        auto spObj = LockNoRelease();
+        if (!spObj && m_pRefCounters)
+        {
+            // Owner object has been destroyed. There is no reason
+            // to keep this weak reference anymore
+            Release();
+        }
+        return spObj;
+    }
+
+    /// Obtains a strong reference to the object, but unlike Lock(), does not
+    /// release the weak reference if the object has been destroyed.
+
+    /// As the method does not modify the pointer, several threads may call
+    /// it at the same time.
+    RefCntAutoPtr<T> LockNoRelease() const
     {
         RefCntAutoPtr<T> spObj;
         if (m_pRefCounters)
@@ -424,12 +441,6 @@ public:
                 // create strong reference
                 spObj = m_pObject;
             }
-            else
-            {
-                // Owner object has been destroyed. There is no reason
-                // to keep this weak reference anymore
-                Release();
-            }
         }
         return spObj;
     }
@@ -41,6 +41,19 @@ namespace Diligent
 {
 
 // This class controls the lifetime of a refcounted object
+//
+// Reference counting is lock-free:
+//
+// - Once the strong reference counter has dropped to zero, it never grows again:
+//   GetObject() (weak-to-strong promotion) only increments the counter with
+//   compare-exchange if it is not zero. Exactly one thread therefore observes
+//   the transition to zero and destroys the object.
+//
+// - While the object is alive, it holds one implicit weak reference to the
+//   reference counters. The thread that destroys the object releases this
+//   reference after the object destructor has completed. The reference counters
+//   are deleted by the thread that drops the weak reference counter to zero,
+//   which can only happen after the object has been destroyed.
 class RefCountersImpl final : public IReferenceCounters
 {
 public:
@@ -57,13 +70,12 @@ public:
         VERIFY(m_ObjectState == ObjectState::Alive, "Attempting to decrement strong reference counter for an object that is not alive");
         VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
 
-        // Decrement strong reference counter without acquiring the lock.
         auto RefCount = Atomics::AtomicDecrement(m_lNumStrongReferences);
         VERIFY(RefCount >= 0, "Inconsistent call to ReleaseStrongRef()");
         if (RefCount == 0)
         {
             PreObjectDestroy();
-            TryDestroyObject();
+            DestroyObject();
         }
 
         return RefCount;
@@ -76,79 +88,56 @@ public:
 
     inline virtual ReferenceCounterValueType AddWeakRef() override final
     {
-        return Atomics::AtomicIncrement(m_lNumWeakReferences);
+        return Atomics::AtomicIncrement(m_lNumWeakReferences) - GetNumImplicitWeakRefs();
     }
 
     inline virtual ReferenceCounterValueType ReleaseWeakRef() override final
     {
-        // The method must be serialized!
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-        // It is essentially important to check the number of weak references
-        // while holding the lock. Otherwise reference counters object
-        // may be destroyed twice if ReleaseStrongRef() is executed by other
-        // thread.
-        auto NumWeakReferences = Atomics::AtomicDecrement(m_lNumWeakReferences);
+        // Read the state before decrementing the counter: after the decrement,
+        // the reference counters may be destroyed by another thread.
+        const auto NumImplicitWeakRefs = GetNumImplicitWeakRefs();
+        const auto NumWeakReferences   = Atomics::AtomicDecrement(m_lNumWeakReferences);
         VERIFY(NumWeakReferences >= 0, "Inconsistent call to ReleaseWeakRef()");
-
-        // There are two special case when we must not destroy the ref counters object even
-        // when NumWeakReferences == 0 && m_lNumStrongReferences == 0 :
-        //
-        //             This thread             |    Another thread - ReleaseStrongRef()
-        //                                     |
-        // 1. Lock the object                  |
-        //                                     |
-        // 2. Decrement m_lNumWeakReferences,  |   1. Decrement m_lNumStrongReferences,
-        //    m_lNumWeakReferences==0          |      RefCount == 0
-        //                                     |
-        //                                     |   2. Start waiting for the lock to destroy
-        //                                     |      the object, m_ObjectState != ObjectState::Destroyed
-        // 3. Do not destroy reference         |
-        //    counters, unlock                 |
-        //                                     |   3. Acquire the lock,
-        //                                     |      destroy the object,
-        //                                     |      read m_lNumWeakReferences==0
-        //                                     |      destroy the reference counters
-        //
-
-        // If an exception is thrown during the object construction and there is a weak pointer to the object itself,
-        // we may get to this point, but should not destroy the reference counters, because it will be destroyed by MakeNewRCObj
-        // Consider this example:
-        //
-        //   A ==sp==> B ---wp---> A
-        //
-        //   MakeNewRCObj::operator()
-        //    try
-        //    {
-        //     A.ctor()
-        //       B.ctor()
-        //        wp.ctor m_lNumWeakReferences==1
-        //        throw
-        //        wp.dtor m_lNumWeakReferences==0, destroy this
-        //    }
-        //    catch(...)
-        //    {
-        //       Destory ref counters second time
-        //    }
-        //
-        if (NumWeakReferences == 0 && /*m_lNumStrongReferences == 0 &&*/ m_ObjectState == ObjectState::Destroyed)
+        if (NumWeakReferences == 0)
         {
-            VERIFY_EXPR(m_lNumStrongReferences == 0);
-            VERIFY(m_ObjectWrapperBuffer[0] == 0 && m_ObjectWrapperBuffer[1] == 0, "Object wrapper must be null");
-            // m_ObjectState is set to ObjectState::Destroyed under the lock. If the state is not Destroyed,
-            // ReleaseStrongRef() will take care of it.
-            // Access to Object wrapper and decrementing m_lNumWeakReferences is atomic. Since we acquired the lock,
-            // no other thread can access either of them.
-            // Access to m_lNumStrongReferences is NOT PROTECTED by lock.
-
-            // There are no more references to the ref counters object and the object itself
-            // is already destroyed.
-            // We can safely unlock it and destroy.
-            // If we do not unlock it, this->m_LockFlag will expire,
-            // which will cause Lock.~LockHelper() to crash.
-            Lock.Unlock();
-            SelfDestroy();
+            // While the object is alive, it holds an implicit weak reference, so the counter may only drop
+            // to zero in two cases:
+            //
+            // 1. The object has been destroyed and the implicit reference has been released.
+            //    No other thread may access the reference counters, so we destroy them.
+            //
+            // 2. An exception is thrown during the object construction and there is a weak pointer to the object itself.
+            //    The object has never been attached, and the reference counters will be destroyed by MakeNewRCObj.
+            //    Consider this example:
+            //
+            //   A ==sp==> B ---wp---> A
+            //
+            //   MakeNewRCObj::operator()
+            //    try
+            //    {
+            //     A.ctor()
+            //       B.ctor()
+            //        wp.ctor m_lNumWeakReferences==1
+            //        throw
+            //        wp.dtor m_lNumWeakReferences==0, m_ObjectState == ObjectState::NotInitialized
+            //    }
+            //    catch(...)
+            //    {
+            //       Destroy ref counters
+            //    }
+            //
+            const auto State = m_ObjectState.load();
+            VERIFY(State != ObjectState::Alive, "The object is alive, but the weak reference counter is zero");
+            if (State == ObjectState::Destroyed)
+            {
+                VERIFY_EXPR(m_lNumStrongReferences == 0);
+                VERIFY(m_ObjectWrapperBuffer[0] == 0 && m_ObjectWrapperBuffer[1] == 0, "Object wrapper must be null");
+                SelfDestroy();
+            }
         }
-        return NumWeakReferences;
+        // The object may have been destroyed after we read the state, in which case the counter
+        // no longer includes the implicit reference. Never report a negative number of references.
+        return NumWeakReferences > NumImplicitWeakRefs ? NumWeakReferences - NumImplicitWeakRefs : 0;
     }
 
     inline virtual void GetObject(struct IObject** ppObject) override final
@@ -156,50 +145,46 @@ public:
         if (m_ObjectState != ObjectState::Alive)
             return; // Early exit
 
-        // It is essential to INCREMENT REF COUNTER while HOLDING THE LOCK to make sure that
-        // StrongRefCnt > 1 guarantees that the object is alive.
-
-        // If other thread started deleting the object in ReleaseStrongRef(), then m_lNumStrongReferences==0
-        // We must make sure only one thread is allowed to increment the counter to guarantee that if StrongRefCnt > 1,
-        // there is at least one real strong reference left. Otherwise the following scenario may occur:
+        // Increment the strong reference counter only if it is not zero. Zero means
+        // that either the object has not yet been given to any strong pointer, or
+        // another thread has released the last strong reference and is destroying
+        // the object. In both cases we must not return the reference.
         //
         //                                      m_lNumStrongReferences == 1
         //
-        //    Thread 1 - ReleaseStrongRef()    |     Thread 2 - GetObject()        |     Thread 3 - GetObject()
-        //                                     |                                   |
-        //  - Decrement m_lNumStrongReferences | -Increment m_lNumStrongReferences | -Increment m_lNumStrongReferences
-        //  - Read RefCount == 0               | -Read StrongRefCnt==1             | -Read StrongRefCnt==2
-        //    Destroy the object               |                                   | -Return reference to the soon
-        //                                     |                                   |  to expire object
+        //    Thread 1 - ReleaseStrongRef()    |     Thread 2 - GetObject()           |     Thread 3 - GetObject()
+        //                                     |                                      |
+        //  - Decrement m_lNumStrongReferences | - Read StrongRefCnt == 1             |
+        //  - Read RefCount == 0               | - Compare-exchange 1 -> 2 fails      | - Read StrongRefCnt == 0
+        //  - Destroy the object               | - Read StrongRefCnt == 0             | - Do not return the reference
+        //                                     | - Do not return the reference        |
         //
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        // If the compare-exchange succeeds, it happens before the decrement in ReleaseStrongRef(),
+        // so the other thread reads RefCount > 0 and does not destroy the object.
+        auto StrongRefCnt = m_lNumStrongReferences.load();
+        do
+        {
+            if (StrongRefCnt <= 0)
+                return;
+        } while (!m_lNumStrongReferences.compare_exchange_weak(StrongRefCnt, StrongRefCnt + 1));
 
-        auto StrongRefCnt = Atomics::AtomicIncrement(m_lNumStrongReferences);
+        // We now hold a strong reference, so the object may not be destroyed
+        VERIFY(m_ObjectState == ObjectState::Alive, "Object is expected to be alive while there are strong references");
+        VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+        auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
+        pWrapper->QueryInterface(IID_Unknown, ppObject);
 
-        // Checking if m_ObjectState == ObjectState::Alive only is not reliable:
-        //
-        //           This thread                    |          Another thread
-        //                                          |
-        //   1. Acquire the lock                    |
-        //                                          |    1. Decrement m_lNumStrongReferences
-        //   2. Increment m_lNumStrongReferences    |    2. Test RefCount==0
-        //   3. Read StrongRefCnt == 1              |    3. Start destroying the object
-        //      m_ObjectState == ObjectState::Alive |
-        //   4. DO NOT return the reference to      |    4. Wait for the lock, m_ObjectState == ObjectState::Alive
-        //      the object                          |
-        //   5. Decrement m_lNumStrongReferences    |
-        //                                          |    5. Destroy the object
-
-        if (m_ObjectState == ObjectState::Alive && StrongRefCnt > 1)
+        if (*ppObject != nullptr)
         {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // QueryInterface() must not lock the object, or a deadlock happens.
-            // The only other two methods that lock the object are ReleaseStrongRef()
-            // and ReleaseWeakRef(), which are never called by QueryInterface()
-            auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
-            pWrapper->QueryInterface(IID_Unknown, ppObject);
+            // QueryInterface() added its own reference, so releasing the temporary
+            // one may not destroy the object.
+            Atomics::AtomicDecrement(m_lNumStrongReferences);
+        }
+        else
+        {
+            // All other strong references may have been released in the meantime
+            ReleaseStrongRef();
         }
-        Atomics::AtomicDecrement(m_lNumStrongReferences);
     }
 
     inline virtual ReferenceCounterValueType GetNumStrongRefs() const override final
@@ -209,7 +194,7 @@ public:
 
     inline virtual ReferenceCounterValueType GetNumWeakRefs() const override final
     {
-        return m_lNumWeakReferences;
+        return m_lNumWeakReferences - GetNumImplicitWeakRefs();
     }
 
 private:
@@ -271,185 +256,83 @@ private:
         VERIFY(m_ObjectState == ObjectState::NotInitialized, "Object has already been attached");
         static_assert(sizeof(ObjectWrapper<ObjectType, AllocatorType>) == sizeof(m_ObjectWrapperBuffer), "Unexpected object wrapper size");
         new (m_ObjectWrapperBuffer) ObjectWrapper<ObjectType, AllocatorType>(pObject, pAllocator);
+        // The alive object holds an implicit weak reference
+        Atomics::AtomicIncrement(m_lNumWeakReferences);
         m_ObjectState = ObjectState::Alive;
     }
 
-    void TryDestroyObject()
+    // Returns the number of implicit weak references held by the object itself
+    ReferenceCounterValueType GetNumImplicitWeakRefs() const
     {
-        // Since RefCount==0, there are no more strong references and the only place
-        // where strong ref counter can be incremented is from GetObject().
+        return m_ObjectState == ObjectState::Alive ? 1 : 0;
+    }
 
-        // If several threads were allowed to get to this point, there would
-        // be serious risk that <this> had already been destroyed and m_LockFlag expired.
-        // Consider the following scenario:
+    void DestroyObject()
+    {
+        // Since the strong reference counter has dropped to zero, and GetObject() never
+        // increments zero counter, this thread is the only one that may get here.
+        //
+        //                                      m_lNumStrongReferences == 1
+        //                                      m_lNumWeakReferences == 2 (one implicit)
         //                                      |
         //             This thread              |             Another thread
         //                                      |
-        //                      m_lNumStrongReferences == 1
-        //                      m_lNumWeakReferences == 1
-        //                                      |
         // 1. Decrement m_lNumStrongReferences  |
-        //    Read RefCount==0, no lock acquired|
+        //    Read RefCount==0                  |
         //                                      |   1. Run GetObject()
-        //                                      |      - acquire the lock
-        //                                      |      - increment m_lNumStrongReferences
-        //                                      |      - release the lock
+        //                                      |      - read StrongRefCnt == 0
+        //                                      |      - do not return the reference
         //                                      |
         //                                      |   2. Run ReleaseWeakRef()
         //                                      |      - decrement m_lNumWeakReferences
+        //                                      |      - read NumWeakReferences == 1
         //                                      |
-        //                                      |   3. Run ReleaseStrongRef()
-        //                                      |      - decrement m_lNumStrongReferences
-        //                                      |      - read RefCount==0
+        // 2. Destroy the object                |
+        // 3. Release implicit weak reference   |
+        //    Read NumWeakReferences == 0       |
+        // 4. Destroy the reference counters    |
         //
-        //         Both threads will get to this point. The first one will destroy <this>
-        //         The second one will read expired m_LockFlag
-
-        //  IT IS CRUCIALLY IMPORTANT TO ASSURE THAT ONLY ONE THREAD WILL EVER
-        //  EXECUTE THIS CODE
-
-        // The sloution is to atomically increment strong ref counter in GetObject().
-        // There are two possible scenarios depending on who first increments the counter:
 
+        VERIFY(m_lNumStrongReferences == 0, "There must be no strong references to the object being destroyed");
+        VERIFY_EXPR(m_ObjectState == ObjectState::Alive);
+        VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
 
-        //                                                     Scenario I
-        //
-        //             This thread              |      Another thread - GetObject()         |   One more thread - GetObject()
-        //                                      |                                           |
-        //                       m_lNumStrongReferences == 1                                |
-        //                                      |                                           |
-        //                                      |   1. Acquire the lock                     |
-        // 1. Decrement m_lNumStrongReferences  |                                           |   1. Wait for the lock
-        // 2. Read RefCount==0                  |   2. Increment m_lNumStrongReferences     |
-        // 3. Start destroying the object       |   3. Read StrongRefCnt == 1               |
-        // 4. Wait for the lock                 |   4. DO NOT return the reference          |
-        //                                      |      to the object                        |
-        //                                      |   5. Decrement m_lNumStrongReferences     |
-        // _  _  _  _  _  _  _  _  _  _  _  _  _|   6. Release the lock _  _  _  _  _  _  _ |_  _  _  _  _  _  _  _  _  _  _  _  _  _
-        //                                      |                                           |   2. Acquire the lock
-        //                                      |                                           |   3. Increment m_lNumStrongReferences
-        //                                      |                                           |   4. Read StrongRefCnt == 1
-        //                                      |                                           |   5. DO NOT return the reference
-        //                                      |                                           |      to the object
-        //                                      |                                           |   6. Decrement m_lNumStrongReferences
-        //  _  _  _  _  _  _  _  _  _  _  _  _  | _  _  _  _  _  _  _  _  _  _  _  _  _  _  | _ 7. Release the lock _  _  _  _  _  _
-        // 5. Acquire the lock                  |                                           |
-        //   - m_lNumStrongReferences==0        |                                           |
-        // 6. DESTROY the object                |                                           |
-        //                                      |                                           |
-
-        //  GetObject() MUST BE SERIALIZED for this to work properly!
-
-
-        //                                   Scenario II
-        //
-        //             This thread              |      Another thread - GetObject()
-        //                                      |
-        //                       m_lNumStrongReferences == 1
-        //                                      |
-        //                                      |   1. Acquire the lock
-        //                                      |   2. Increment m_lNumStrongReferences
-        // 1. Decrement m_lNumStrongReferences  |
-        // 2. Read RefCount>0                   |
-        // 3. DO NOT destroy the object         |   3. Read StrongRefCnt > 1 (while m_lNumStrongReferences == 1)
-        //                                      |   4. Return the reference to the object
-        //                                      |       - Increment m_lNumStrongReferences
-        //                                      |   5. Decrement m_lNumStrongReferences
-
-#ifdef DILIGENT_DEBUG
-        {
-            Atomics::Long NumStrongRefs = m_lNumStrongReferences;
-            VERIFY(NumStrongRefs == 0 || NumStrongRefs == 1, "Num strong references (", NumStrongRefs, ") is expected to be 0 or 1");
-        }
-#endif
-
-        // Acquire the lock.
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-
-        // GetObject() first acquires the lock, and only then increments and
-        // decrements the ref counter. If it reads 1 after incremeting the counter,
-        // it does not return the reference to the object and decrements the counter.
-        // If we acquired the lock, GetObject() will not start until we are done
-        VERIFY_EXPR(m_lNumStrongReferences == 0 && m_ObjectState == ObjectState::Alive);
-
-        // Extra caution
-        if (m_lNumStrongReferences == 0 && m_ObjectState == ObjectState::Alive)
-        {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // We cannot destroy the object while reference counters are locked as this will
-            // cause a deadlock in cases like this:
-            //
-            //    A ==sp==> B ---wp---> A
-            //
-            //    RefCounters_A.Lock();
-            //    delete A{
-            //      A.~dtor(){
-            //          B.~dtor(){
-            //              wpA.ReleaseWeakRef(){
-            //                  RefCounters_A.Lock(); // Deadlock
-            //
-
-            // So we copy the object wrapper and destroy the object after unlocking the
-            // reference counters
-            size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
-            for (size_t i = 0; i < ObjectWrapperBufferSize; ++i)
-                ObjectWrapperBufferCopy[i] = m_ObjectWrapperBuffer[i];
+        // Copy the object wrapper as the buffer is cleared in debug build
+        size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
+        for (size_t i = 0; i < ObjectWrapperBufferSize; ++i)
+            ObjectWrapperBufferCopy[i] = m_ObjectWrapperBuffer[i];
 #ifdef DILIGENT_DEBUG
-            memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
+        memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
 #endif
-            auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
-
-            // In a multithreaded environment, reference counters object may
-            // be destroyed at any time while m_pObject->~dtor() is running.
-            // NOTE: m_pObject may not be the only object referencing m_pRefCounters.
-            //       All objects that are owned by m_pObject will point to the same
-            //       reference counters object.
-
-            // Note that this is the only place where m_ObjectState is
-            // modified after the ref counters object has been created
-            m_ObjectState = ObjectState::Destroyed;
-            // The object is now detached from the reference counters and it is if
-            // it was destroyed since no one can obtain access to it.
-
-
-            // It is essentially important to check the number of weak references
-            // while the object is locked. Otherwise reference counters object
-            // may be destroyed twice if ReleaseWeakRef() is executed by other thread:
-            //
-            //             This thread             |    Another thread - ReleaseWeakRef()
-            //                                     |
-            // 1. Decrement m_lNumStrongReferences,|
-            //    m_lNumStrongReferences==0,       |
-            //    acquire the lock, destroy        |
-            //    the obj, release the lock        |
-            //    m_lNumWeakReferences == 1        |
-            //                                     |   1. Aacquire the lock,
-            //                                     |      decrement m_lNumWeakReferences,
-            //                                     |      m_lNumWeakReferences == 0,
-            //                                     |      m_ObjectState == ObjectState::Destroyed
-            //                                     |
-            // 2. Read m_lNumWeakReferences == 0   |
-            // 3. Destroy the ref counters obj     |   2. Destroy the ref counters obj
-            //
-            bool bDestroyThis = m_lNumWeakReferences == 0;
-            // ReleaseWeakRef() decrements m_lNumWeakReferences, and checks it for
-            // zero only after acquiring the lock. So if m_lNumWeakReferences==0, no
-            // weak reference-related code may be running
-
-
-            // We must explicitly unlock the object now to avoid deadlocks. Also,
-            // if this is deleted, this->m_LockFlag will expire, which will cause
-            // Lock.~LockHelper() to crash
-            Lock.Unlock();
-
-            // Destroy referenced object
-            pWrapper->DestroyObject();
-
-            // Note that <this> may be destroyed here already,
-            // see comments in ~ControlledObjectType()
-            if (bDestroyThis)
-                SelfDestroy();
-        }
+        auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
+
+        // Note that this is the only place where m_ObjectState is
+        // modified after the ref counters object has been created.
+        // The object is now detached from the reference counters and it is as if
+        // it was destroyed since no one can obtain access to it.
+        m_ObjectState = ObjectState::Destroyed;
+
+        // Destroy referenced object.
+        // The reference counters remain valid while the object destructor is running
+        // because the implicit weak reference has not been released yet. This is
+        // important in cases like this:
+        //
+        //    A ==sp==> B ---wp---> A
+        //
+        //    delete A{
+        //      A.~dtor(){
+        //          B.~dtor(){
+        //              wpA.ReleaseWeakRef(); // NumWeakReferences == 1
+        //
+        // NOTE: m_pObject may not be the only object referencing the reference counters.
+        //       All objects that are owned by m_pObject will point to the same
+        //       reference counters object.
+        pWrapper->DestroyObject();
+
+        // Release the implicit weak reference. If there are no other weak references,
+        // no other thread may access the reference counters.
+        if (Atomics::AtomicDecrement(m_lNumWeakReferences) == 0)
+            SelfDestroy();
     }
 
     void SelfDestroy()
@@ -480,17 +363,16 @@ private:
     // which does have virtual destructor.
     static constexpr size_t ObjectWrapperBufferSize = sizeof(ObjectWrapper<IObjectStub, IMemoryAllocator>) / sizeof(size_t);
 
-    size_t                   m_ObjectWrapperBuffer[ObjectWrapperBufferSize];
-    Atomics::AtomicLong      m_lNumStrongReferences;
-    Atomics::AtomicLong      m_lNumWeakReferences;
-    ThreadingTools::LockFlag m_LockFlag;
+    size_t              m_ObjectWrapperBuffer[ObjectWrapperBufferSize];
+    Atomics::AtomicLong m_lNumStrongReferences;
+    Atomics::AtomicLong m_lNumWeakReferences;
     enum class ObjectState : Int32
     {
         NotInitialized,
         Alive,
         Destroyed
     };
-    volatile ObjectState m_ObjectState = ObjectState::NotInitialized;
+    std::atomic<ObjectState> m_ObjectState{ObjectState::NotInitialized};
 };
 
 
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// SIMD instruction set detection
+
+// DILIGENT_SSE2_SUPPORTED - SSE2 intrinsics are available unconditionally (all x86-64 targets)
+// DILIGENT_AVX2_SUPPORTED - AVX2 intrinsics can be used in functions marked with DILIGENT_TARGET_AVX2,
+//                           but the code must check IsAVX2Supported() before calling them.
+// DILIGENT_NEON_SUPPORTED - NEON intrinsics are available unconditionally (all AArch64 targets)
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#    define DILIGENT_SSE2_SUPPORTED 1
+#    include <emmintrin.h>
+#    if defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__)
+#        define DILIGENT_AVX2_SUPPORTED 1
+#        include <immintrin.h>
+#        if defined(_MSC_VER) && !defined(__clang__)
+#            include <intrin.h>
+#        endif
+#    endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#    define DILIGENT_NEON_SUPPORTED 1
+#    include <arm_neon.h>
+#endif
+
+#ifndef DILIGENT_SSE2_SUPPORTED
+#    define DILIGENT_SSE2_SUPPORTED 0
+#endif
+#ifndef DILIGENT_AVX2_SUPPORTED
+#    define DILIGENT_AVX2_SUPPORTED 0
+#endif
+#ifndef DILIGENT_NEON_SUPPORTED
+#    define DILIGENT_NEON_SUPPORTED 0
+#endif
+
+#if DILIGENT_AVX2_SUPPORTED && (defined(__GNUC__) || defined(__clang__))
+// GCC and clang require the target attribute to compile AVX2 intrinsics without -mavx2.
+#    define DILIGENT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#    define DILIGENT_TARGET_AVX2
+#endif
+
+namespace Diligent
+{
+
+/// Returns true if the CPU and the OS support AVX2 instructions.
+/// The result is computed once and cached.
+inline bool IsAVX2Supported()
+{
+#if DILIGENT_AVX2_SUPPORTED
+#    if defined(_MSC_VER) && !defined(__clang__)
+    static const bool Supported = []() {
+        int Info[4] = {};
+        __cpuid(Info, 0);
+        if (Info[0] < 7)
+            return false;
+
+        __cpuid(Info, 1);
+        const bool OSXSave = (Info[2] & (1 << 27)) != 0;
+        const bool AVX     = (Info[2] & (1 << 28)) != 0;
+        if (!OSXSave || !AVX)
+            return false;
+
+        // Check that the OS saves YMM registers
+        if ((_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(Info, 7, 0);
+        return (Info[1] & (1 << 5)) != 0;
+    }();
+#    else
+    static const bool Supported = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+#    endif
+    return Supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace Diligent
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ScratchAllocatorPool class
+
+#include "DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Thread-local pool of linear allocators that serve as scratch arenas for transient data.
+
+/// Every thread keeps its own list of DynamicLinearAllocator objects. Borrow() takes an allocator
+/// from the calling thread's list (or creates a new one), and the allocator is reset and
+/// returned to the list when the ScopedAllocator object goes out of scope. Nested borrows
+/// get different allocators. Since allocators keep their memory pages between uses,
+/// steady-state borrows do not perform any heap allocations.
+///
+/// \remarks Scratch allocators use DefaultRawMemoryAllocator, since they are owned by
+///          threads and may outlive any user-provided allocator.
+///
+///          A ScopedAllocator object may be moved to and destroyed in another thread. In this case
+///          the allocator is handed back to the thread that borrowed it, and the allocators
+///          of a thread are kept alive until all of them have been returned.
+class ScratchAllocatorPool
+{
+    class ThreadAllocators;
+
+public:
+    class ScopedAllocator
+    {
+    public:
+        ScopedAllocator(DynamicLinearAllocator* pAllocator, ThreadAllocators* pOwner) noexcept :
+            m_pAllocator{pAllocator},
+            m_pOwner{pOwner}
+        {}
+
+        ScopedAllocator(ScopedAllocator&& Other) noexcept :
+            m_pAllocator{Other.m_pAllocator},
+            m_pOwner{Other.m_pOwner}
+        {
+            Other.m_pAllocator = nullptr;
+            Other.m_pOwner     = nullptr;
+        }
+
+        ~ScopedAllocator()
+        {
+            if (m_pAllocator != nullptr)
+                ScratchAllocatorPool::Return(m_pAllocator, m_pOwner);
+        }
+
+        // clang-format off
+        ScopedAllocator           (const ScopedAllocator&) = delete;
+        ScopedAllocator& operator=(const ScopedAllocator&) = delete;
+        ScopedAllocator& operator=(ScopedAllocator&&)      = delete;
+        // clang-format on
+
+        DynamicLinearAllocator& operator*() const { return *m_pAllocator; }
+        DynamicLinearAllocator* operator->() const { return m_pAllocator; }
+
+    private:
+        DynamicLinearAllocator* m_pAllocator;
+        ThreadAllocators*       m_pOwner;
+    };
+
+    /// Borrows a scratch allocator from the calling thread's pool.
+    static ScopedAllocator Borrow();
+
+    /// Page size of scratch allocators
+    static constexpr Uint32 BlockSize = 16 << 10;
+
+private:
+    static void Return(DynamicLinearAllocator* pAllocator, ThreadAllocators* pOwner);
+};
+
+} // namespace Diligent
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SizeClassMemoryAllocator class
+
+#include <atomic>
+#include <memory>
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "ThreadCachingFixedBlockMemoryAllocator.hpp"
+
+namespace Diligent
+{
+
+/// General-purpose memory allocator that serves small allocations from size-class pools.
+
+/// Allocation sizes up to MaxSmallAllocationSize are rounded up to one of NumSizeClasses
+/// size classes (16-byte steps up to 128 bytes, then four classes per power of two).
+/// Every size class is backed by a ThreadCachingFixedBlockMemoryAllocator, while larger
+/// allocations are forwarded to the raw allocator. Every allocation is prefixed with a small
+/// header that identifies its size class, so the allocator can be installed as the engine
+/// raw memory allocator (see EngineCreateInfo::pRawMemAllocator).
+///
+/// The allocator maintains statistics for every size class that can be queried at run time
+/// through GetSizeClassStats().
+class SizeClassMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    /// The number of small-allocation size classes
+    static constexpr Uint32 NumSizeClasses = 32;
+
+    /// The largest allocation size that is served from size-class pools
+    static constexpr size_t MaxSmallAllocationSize = 8192;
+
+    /// Pseudo size class index that identifies allocations forwarded to the raw allocator
+    static constexpr Uint32 LargeAllocationSizeClass = NumSizeClasses;
+
+    /// Size class statistics
+    struct SizeClassStats
+    {
+        /// Size of the block in this class, or zero for large allocations
+        size_t BlockSize = 0;
+
+        /// The number of currently live allocations
+        size_t NumLiveAllocations = 0;
+
+        /// The maximum number of simultaneously live allocations
+        size_t PeakLiveAllocations = 0;
+
+        /// Total size of the currently live allocations, as requested by the caller
+        size_t LiveBytes = 0;
+
+        /// The total number of allocations made in this class
+        size_t TotalAllocations = 0;
+    };
+
+    /// \param [in] RawMemoryAllocator - Allocator that is used to allocate pages and large allocations.
+    /// \param [in] PageSize           - Approximate size of a single page of a size-class pool.
+    SizeClassMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t PageSize = 64 << 10);
+    ~SizeClassMemoryAllocator();
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns the size class index for the given allocation size,
+    /// or LargeAllocationSizeClass if the size exceeds MaxSmallAllocationSize.
+    static Uint32 GetSizeClass(size_t Size);
+
+    /// Returns the block size of the given size class.
+    static size_t GetSizeClassBlockSize(Uint32 SizeClass);
+
+    /// Returns the statistics of the given size class. Use LargeAllocationSizeClass
+    /// to query the statistics of allocations forwarded to the raw allocator.
+    SizeClassStats GetSizeClassStats(Uint32 SizeClass) const;
+
+    /// Returns free blocks cached by the size-class pools to their pages and releases empty pages.
+    void Trim();
+
+private:
+    // clang-format off
+    SizeClassMemoryAllocator             (const SizeClassMemoryAllocator&) = delete;
+    SizeClassMemoryAllocator             (SizeClassMemoryAllocator&&)      = delete;
+    SizeClassMemoryAllocator& operator = (const SizeClassMemoryAllocator&) = delete;
+    SizeClassMemoryAllocator& operator = (SizeClassMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    struct SizeClassCounters
+    {
+        std::atomic<size_t> NumLiveAllocations{0};
+        std::atomic<size_t> PeakLiveAllocations{0};
+        std::atomic<size_t> LiveBytes{0};
+        std::atomic<size_t> TotalAllocations{0};
+    };
+
+    IMemoryAllocator& m_RawMemoryAllocator;
+
+    std::unique_ptr<ThreadCachingFixedBlockMemoryAllocator> m_Pools[NumSizeClasses];
+
+    // The last element keeps counters of large allocations
+    SizeClassCounters m_Counters[NumSizeClasses + 1];
+};
+
+} // namespace Diligent
@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::InternedString and Diligent::StringInterner classes
+
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
+
+namespace Diligent
+{
+
+class DynamicLinearAllocator;
+
+/// Handle to a string stored in a StringInterner.
+
+/// Every distinct string is stored by the interner exactly once, so two handles from the
+/// same interner are equal if and only if they point to the same memory, and comparison is a
+/// single pointer compare. The hash and the length of the string are computed once when the
+/// string is interned. The pointer returned by GetStr() remains valid for the lifetime of the interner.
+class InternedString
+{
+public:
+    InternedString() noexcept {}
+
+    /// Restores the handle from the pointer previously returned by GetStr().
+
+    /// \warning   Str must be null or a pointer returned by GetStr() of a live handle:
+    ///             the hash and the length are read from the interner's memory that
+    ///             precedes the string.
+    static InternedString FromInternedStr(const Char* Str) noexcept
+    {
+        return InternedString{Str};
+    }
+
+    /// Returns the null-terminated string, or null for a default-constructed handle
+    const Char* GetStr() const noexcept
+    {
+        return m_Str;
+    }
+
+    /// Returns the string hash, which is the same as the one computed by CStringHash<Char>
+    size_t GetHash() const noexcept
+    {
+        return m_Str != nullptr ? GetHeader()->Hash : 0;
+    }
+
+    size_t GetLength() const noexcept
+    {
+        return m_Str != nullptr ? GetHeader()->Length : 0;
+    }
+
+    bool IsNull() const noexcept
+    {
+        return m_Str == nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_Str != nullptr;
+    }
+
+    bool operator==(const InternedString& rhs) const noexcept { return m_Str == rhs.m_Str; }
+    bool operator!=(const InternedString& rhs) const noexcept { return m_Str != rhs.m_Str; }
+
+    struct Hasher
+    {
+        size_t operator()(const InternedString& Str) const noexcept
+        {
+            return Str.GetHash();
+        }
+    };
+
+private:
+    friend class StringInterner;
+
+    // The header is stored immediately before the string characters
+    struct Header
+    {
+        size_t Hash;
+        size_t Length;
+    };
+
+    explicit InternedString(const Char* Str) noexcept :
+        m_Str{Str}
+    {}
+
+    const Header* GetHeader() const noexcept
+    {
+        return reinterpret_cast<const Header*>(m_Str) - 1;
+    }
+
+    const Char* m_Str = nullptr;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const InternedString& Str)
+{
+    return os << (Str ? Str.GetStr() : "<null>");
+}
+
+
+/// Thread-safe string interner.
+
+/// The table is split into NumShards shards selected by the string hash. Every shard has its own
+/// mutex, hash map and linear allocator that keeps the string data, so threads interning different
+/// strings rarely contend for the same lock.
+class StringInterner
+{
+public:
+    static constexpr Uint32 NumShards = 16;
+
+    StringInterner();
+    ~StringInterner();
+
+    // clang-format off
+    StringInterner           (const StringInterner&) = delete;
+    StringInterner           (StringInterner&&)      = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+    StringInterner& operator=(StringInterner&&)      = delete;
+    // clang-format on
+
+    /// Returns the handle of the string, adding the string to the table if necessary.
+    /// Null strings produce null handles.
+    InternedString Intern(const Char* Str);
+
+    /// Returns the handle of the string if it has been interned, or a null handle otherwise.
+    InternedString Find(const Char* Str) const;
+
+    /// Returns the total number of strings in the table
+    size_t GetNumStrings() const;
+
+private:
+    struct Shard
+    {
+        mutable std::mutex                                                      Mtx;
+        FlatHashMap<HashMapStringKey, InternedString, HashMapStringKey::Hasher> Strings;
+        std::unique_ptr<DynamicLinearAllocator>                                 Data;
+    };
+
+    static Uint32 GetShardIndex(size_t Hash)
+    {
+        // Low hash bits select the slot in the shard's hash map, so use the high bits here
+        return static_cast<Uint32>(Hash >> (sizeof(size_t) * 8 - 5)) & (NumShards - 1);
+    }
+
+    std::array<Shard, NumShards> m_Shards;
+};
+
+} // namespace Diligent
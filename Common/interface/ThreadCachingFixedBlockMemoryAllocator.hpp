@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ThreadCachingFixedBlockMemoryAllocator class
+
+#include <mutex>
+#include "../../Primitives/interface/Errors.hpp"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "LockHelper.hpp"
+
+namespace Diligent
+{
+
+/// Fixed-block memory allocator with per-thread block caches.
+
+/// Unlike FixedBlockMemoryAllocator, this allocator does not use a hash map to find the page
+/// that owns a block: every block is prefixed with a header that stores the pointer to its page.
+/// Each thread is assigned one of the NumThreadCaches cache slots that holds a magazine of
+/// free blocks, so that most allocations and deallocations only touch the thread's own slot.
+/// The slots are guarded by spin flags that are practically never contended, while the
+/// allocator mutex is only acquired when a magazine needs to be refilled or drained.
+/// Blocks are aligned by alignof(std::max_align_t), the same as memory returned by malloc.
+/// Pages that become completely empty are returned to the raw allocator, except for
+/// the NumEmptyPagesToKeep pages that are retained to avoid thrashing.
+///
+/// \remarks Blocks that sit in thread caches are considered allocated by their pages, so
+///          a page can only be released once all its blocks are drained back from the caches.
+class ThreadCachingFixedBlockMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    /// Number of thread cache slots. Threads are assigned slots in round-robin fashion.
+    static constexpr Uint32 NumThreadCaches = 16;
+
+    /// Maximum number of free blocks held by one thread cache.
+    static constexpr Uint32 MagazineCapacity = 32;
+
+    ThreadCachingFixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
+                                           size_t            BlockSize,
+                                           Uint32            NumBlocksInPage,
+                                           Uint32            NumEmptyPagesToKeep = 1);
+    ~ThreadCachingFixedBlockMemoryAllocator();
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns all blocks from the thread caches back to their pages and releases empty pages.
+    void Trim();
+
+    /// Returns the number of pages currently allocated from the raw allocator.
+    Uint32 GetPageCount();
+
+private:
+    // clang-format off
+    ThreadCachingFixedBlockMemoryAllocator             (const ThreadCachingFixedBlockMemoryAllocator&) = delete;
+    ThreadCachingFixedBlockMemoryAllocator             (ThreadCachingFixedBlockMemoryAllocator&&)      = delete;
+    ThreadCachingFixedBlockMemoryAllocator& operator = (const ThreadCachingFixedBlockMemoryAllocator&) = delete;
+    ThreadCachingFixedBlockMemoryAllocator& operator = (ThreadCachingFixedBlockMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    struct PageHeader
+    {
+        PageHeader* pPrev = nullptr;
+        PageHeader* pNext = nullptr;
+
+        // Singly-linked list of free blocks. The link is stored in the first bytes of the block payload.
+        void* pFreeList = nullptr;
+
+        // Number of blocks that are not in the page free list, including blocks held by thread caches
+        Uint32 NumUsedBlocks = 0;
+
+        // Number of blocks that have been initialized (i.e. have their page header set up)
+        Uint32 NumInitializedBlocks = 0;
+
+        bool IsFull = false;
+    };
+
+    class PageList
+    {
+    public:
+        void        PushFront(PageHeader* pPage);
+        void        Remove(PageHeader* pPage);
+        PageHeader* GetHead() const { return m_pHead; }
+        bool        IsEmpty() const { return m_pHead == nullptr; }
+
+    private:
+        PageHeader* m_pHead = nullptr;
+    };
+
+    // The allocator may be created by operator new that does not guarantee cache line alignment
+    // in C++11, so the caches are padded instead of aligned: the data of two adjacent caches are
+    // always at least one cache line apart and never share a line, which avoids false sharing.
+    static constexpr size_t CacheLineSize = 64;
+    struct ThreadCache
+    {
+        ThreadingTools::LockFlag Flag;
+
+        Uint32 NumBlocks = 0;
+        void*  Blocks[MagazineCapacity];
+
+        Uint8 Padding[CacheLineSize];
+    };
+
+    ThreadCache& GetThreadCache();
+
+    PageHeader* CreateNewPage();
+    void        ReleasePage(PageHeader* pPage);
+    PageHeader* GetBlockPage(void* pBlock) const;
+    void*       GetBlockPayload(PageHeader* pPage, Uint32 BlockIndex) const;
+
+    // Moves up to NumBlocks free blocks from the pages to the cache. Requires m_Mutex to be locked.
+    void RefillCache(ThreadCache& Cache, Uint32 NumBlocks);
+    // Returns NumBlocks blocks from the top of the cache to their pages. Requires m_Mutex to be locked.
+    void DrainCache(ThreadCache& Cache, Uint32 NumBlocks);
+    // Returns one block to its page. Requires m_Mutex to be locked.
+    void ReturnBlock(void* pBlock);
+
+    ThreadCache m_ThreadCaches[NumThreadCaches];
+
+    std::mutex m_Mutex;
+    PageList   m_AvailablePages; // Pages that have free blocks
+    PageList   m_FullPages;      // Pages that have no free blocks
+    Uint32     m_NumPages      = 0;
+    Uint32     m_NumEmptyPages = 0;
+
+    IMemoryAllocator& m_RawMemoryAllocator;
+    const size_t      m_BlockSize;
+    const size_t      m_BlockStride;
+    const size_t      m_PageHeaderSize;
+    const Uint32      m_NumBlocksInPage;
+    const Uint32      m_NumEmptyPagesToKeep;
+};
+
+} // namespace Diligent
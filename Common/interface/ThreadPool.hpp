@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ThreadPool class
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Fixed-size pool of worker threads that execute tasks in FIFO order.
+
+/// Tasks must not throw exceptions. The destructor finishes all enqueued tasks
+/// before joining the worker threads. The pool may also be destroyed by one of its
+/// own tasks (e.g. when a task releases the last reference to the object that owns
+/// the pool). In this case the calling worker thread is detached and exits once
+/// the task returns and the queue is empty.
+class ThreadPool
+{
+public:
+    using TaskType = std::function<void()>;
+
+    /// Creates the pool with NumThreads worker threads. If NumThreads is zero,
+    /// the number of hardware threads minus one is used.
+    explicit ThreadPool(Uint32 NumThreads = 0);
+    ~ThreadPool();
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&)  = delete;
+    ThreadPool           (      ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(      ThreadPool&&) = delete;
+    // clang-format on
+
+    /// Adds the task to the queue. The task is executed by one of the worker threads.
+    void Enqueue(TaskType&& Task);
+
+    /// Calls Func(i) for every i in [0, NumIterations) and waits until all calls have finished.
+
+    /// The calling thread takes part in the work, so ParallelFor may safely be called from a
+    /// worker thread of the same pool. Iterations are handed out one at a time, so every
+    /// iteration should perform a reasonable amount of work.
+    void ParallelFor(Uint32 NumIterations, const std::function<void(Uint32)>& Func);
+
+    /// Returns the number of worker threads
+    Uint32 GetNumThreads() const
+    {
+        return static_cast<Uint32>(m_Threads.size());
+    }
+
+private:
+    // Task queue shared by the pool and its worker threads. Worker threads keep
+    // the queue alive, so a detached thread may safely outlive the pool.
+    struct TaskQueue;
+
+    static void WorkerThreadFunc(std::shared_ptr<TaskQueue> pQueue);
+
+    std::shared_ptr<TaskQueue> m_pQueue;
+    std::vector<std::thread>   m_Threads;
+};
+
+} // namespace Diligent
@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TrackingMemoryAllocator class
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "../../Primitives/interface/MemoryAllocator.h"
+
+namespace Diligent
+{
+
+/// Memory allocator decorator that aggregates allocation statistics per call site.
+
+/// The allocator forwards all requests to the underlying allocator and uses the
+/// dbgFileName/dbgLineNumber arguments of IMemoryAllocator::Allocate to identify the call site.
+/// Every call site has its own record in a lock-free hash table. The counters of a record are
+/// sharded: every thread updates its own cache line, and the shards are summed up when the statistics
+/// are queried, so that threads allocating from the same call site do not contend, and no lock
+/// is taken on the allocation path. Every allocation is prefixed with a small header that
+/// references the counter shard it was accounted in, and is released to the same shard.
+///
+/// The statistics can be retrieved at any time through GetCallSiteStats(), or formatted
+/// as a human-readable report (GetReport()) or a JSON snapshot (GetJSONSnapshot()).
+class TrackingMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    /// Statistics of a single call site
+    struct CallSiteStats
+    {
+        std::string FileName;
+        Int32       LineNumber = 0;
+        std::string Description;
+
+        /// Total size of currently live allocations
+        size_t LiveBytes = 0;
+
+        /// The maximum total size of simultaneously live allocations.
+        ///
+        /// \remarks The peak is tracked per thread and the values are summed up, so this is
+        ///          the exact peak for call sites used by a single thread, and an upper bound otherwise.
+        size_t PeakLiveBytes = 0;
+
+        /// The number of currently live allocations
+        size_t NumLiveAllocations = 0;
+
+        /// The total number of allocations made by the call site
+        size_t TotalAllocations = 0;
+
+        /// Total size of all allocations made by the call site
+        size_t TotalBytes = 0;
+    };
+
+    /// Maximum number of distinct call sites that can be tracked.
+    /// Allocations from call sites that do not fit into the table are accounted in a single overflow record.
+    static constexpr Uint32 MaxCallSites = 4096;
+
+    /// The number of counter shards per call site. Threads are assigned to the shards in a round-robin manner.
+    static constexpr Uint32 NumCounterShards = 16;
+
+    explicit TrackingMemoryAllocator(IMemoryAllocator& Allocator);
+    ~TrackingMemoryAllocator();
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns the statistics of all call sites sorted by the live bytes, in descending order.
+    ///
+    /// \remarks Call sites with the same file name and line number, which may e.g. happen for
+    ///          code in header files included into multiple translation units, are merged.
+    ///          Peak values of merged call sites are summed.
+    std::vector<CallSiteStats> GetCallSiteStats() const;
+
+    /// Formats the human-readable report of the top MaxEntries call sites
+    /// (or all call sites if MaxEntries is zero), sorted by the live bytes.
+    std::string GetReport(size_t MaxEntries = 0) const;
+
+    /// Returns the snapshot of all call site statistics as a JSON string.
+    std::string GetJSONSnapshot() const;
+
+    /// Returns the total size of currently live allocations.
+    size_t GetLiveBytes() const;
+
+private:
+    // clang-format off
+    TrackingMemoryAllocator             (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator             (TrackingMemoryAllocator&&)      = delete;
+    TrackingMemoryAllocator& operator = (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator& operator = (TrackingMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    static constexpr size_t CacheLineSize = 64;
+
+    struct CounterShard;
+    struct CallSiteRecord;
+
+    CallSiteRecord* FindOrCreateCallSite(const Char* dbgDescription, const char* dbgFileName, Int32 dbgLineNumber);
+    CallSiteRecord* CreateCallSite(const Char* dbgDescription, const char* dbgFileName, Int32 dbgLineNumber);
+    void            DestroyCallSite(CallSiteRecord* pRecord);
+
+    IMemoryAllocator& m_Allocator;
+
+    // Open-addressing table of call site records keyed by the file name pointer and line number
+    std::atomic<CallSiteRecord*> m_CallSites[MaxCallSites];
+
+    // Record that accounts allocations from call sites that do not fit into the table
+    CallSiteRecord* m_pOverflowCallSite = nullptr;
+};
+
+} // namespace Diligent
@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "AdaptiveLock.hpp"
+
+#include <algorithm>
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <climits>
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#else
+#    include <mutex>
+#    include <condition_variable>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#    include <intrin.h>
+#elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#    include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#    include <immintrin.h>
+#endif
+
+namespace ThreadingTools
+{
+
+using Diligent::Uint32;
+using Diligent::Uint64;
+
+namespace
+{
+
+// Backoff doubles the number of pause instructions in every round up to
+// 1 << MaxBackoffShift. With the values below a thread executes about 1500
+// pauses (a few microseconds) before it parks.
+constexpr Uint32 NumSpinRounds   = 12;
+constexpr Uint32 MaxBackoffShift = 7;
+
+inline void CpuPause()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+    __yield();
+#elif defined(__i386__) || defined(__x86_64__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+// Executes a round of pause instructions and returns their number
+inline Uint32 Backoff(Uint32 Round)
+{
+    const Uint32 NumPauses = 1u << std::min(Round, MaxBackoffShift);
+    for (Uint32 i = 0; i < NumPauses; ++i)
+        CpuPause();
+    return NumPauses;
+}
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+
+// Blocks the thread while State is equal to Expected. May return spuriously.
+void ParkWhileEqual(std::atomic<Uint32>& State, Uint32 Expected)
+{
+    static_assert(sizeof(std::atomic<Uint32>) == sizeof(int), "Futex requires 32-bit state");
+    syscall(SYS_futex, reinterpret_cast<int*>(&State), FUTEX_WAIT_PRIVATE, static_cast<int>(Expected), nullptr, nullptr, 0);
+}
+
+void Unpark(std::atomic<Uint32>& State, bool WakeAll)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(&State), FUTEX_WAKE_PRIVATE, WakeAll ? INT_MAX : 1, nullptr, nullptr, 0);
+}
+
+#else
+
+// Parked threads wait on one of the condition variables selected by the address of the lock state.
+// Unrelated locks may share the bucket, so all threads waiting in it are woken up.
+struct ParkingBucket
+{
+    std::mutex              Mtx;
+    std::condition_variable CondVar;
+};
+
+ParkingBucket& GetParkingBucket(const void* pAddress)
+{
+    static constexpr size_t NumBuckets = 64;
+    // The buckets are never released so that locks may be used during static deinitialization
+    static ParkingBucket* const Buckets = new ParkingBucket[NumBuckets];
+
+    auto Addr = reinterpret_cast<size_t>(pAddress);
+    Addr ^= Addr >> 12;
+    return Buckets[(Addr >> 2) % NumBuckets];
+}
+
+void ParkWhileEqual(std::atomic<Uint32>& State, Uint32 Expected)
+{
+    auto& Bucket = GetParkingBucket(&State);
+
+    std::unique_lock<std::mutex> Lock{Bucket.Mtx};
+    // The waking thread modifies the state before it locks the bucket mutex,
+    // so the notification may not be missed.
+    if (State.load() == Expected)
+        Bucket.CondVar.wait(Lock);
+}
+
+void Unpark(std::atomic<Uint32>& State, bool /*WakeAll*/)
+{
+    auto& Bucket = GetParkingBucket(&State);
+    {
+        std::lock_guard<std::mutex> Lock{Bucket.Mtx};
+    }
+    Bucket.CondVar.notify_all();
+}
+
+#endif
+
+void UpdateStats(LockContentionStats* pStats, Uint64 NumSpins, Uint64 NumParks)
+{
+    if (pStats == nullptr)
+        return;
+
+    pStats->NumAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    pStats->NumContendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    pStats->NumSpins.fetch_add(NumSpins, std::memory_order_relaxed);
+    pStats->NumParks.fetch_add(NumParks, std::memory_order_relaxed);
+}
+
+} // namespace
+
+constexpr Uint32 AdaptiveLock::StateUnlocked;
+constexpr Uint32 AdaptiveLock::StateLocked;
+constexpr Uint32 AdaptiveLock::StateLockedWithWaiters;
+
+void AdaptiveLock::LockContended() noexcept
+{
+    Uint64 NumSpins = 0;
+    for (Uint32 Round = 0; Round < NumSpinRounds; ++Round)
+    {
+        NumSpins += Backoff(Round);
+
+        Uint32 Expected = StateUnlocked;
+        if (m_State.load(std::memory_order_relaxed) == StateUnlocked &&
+            m_State.compare_exchange_weak(Expected, StateLocked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            UpdateStats(m_pStats, NumSpins, 0);
+            return;
+        }
+    }
+
+    // Mark the lock as having waiters, so that the owner wakes us up when it releases
+    // the lock. If the lock was released in the meantime, we take it, but conservatively
+    // leave it in the contended state: the only cost is one extra wake call.
+    Uint64 NumParks = 0;
+    while (m_State.exchange(StateLockedWithWaiters, std::memory_order_acquire) != StateUnlocked)
+    {
+        ParkWhileEqual(m_State, StateLockedWithWaiters);
+        ++NumParks;
+    }
+
+    UpdateStats(m_pStats, NumSpins, NumParks);
+}
+
+void AdaptiveLock::WakeWaiters() noexcept
+{
+    // Waking up one thread is enough: it leaves the lock in the contended state
+    // when it takes it, so the next waiter is woken up on the next release.
+    Unpark(m_State, false);
+}
+
+
+constexpr Uint32 AdaptiveSharedLock::WriterBit;
+constexpr Uint32 AdaptiveSharedLock::WaitersBit;
+constexpr Uint32 AdaptiveSharedLock::ReadersMask;
+
+void AdaptiveSharedLock::LockContended() noexcept
+{
+    Uint64 NumSpins = 0;
+    for (Uint32 Round = 0; Round < NumSpinRounds; ++Round)
+    {
+        NumSpins += Backoff(Round);
+
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & ~WaitersBit) == 0 &&
+            m_State.compare_exchange_weak(State, State | WriterBit, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            UpdateStats(m_pStats, NumSpins, 0);
+            return;
+        }
+    }
+
+    Uint64 NumParks = 0;
+    for (;;)
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & ~WaitersBit) == 0)
+        {
+            // Preserve the waiters bit so that the other parked threads are woken up when we release the lock
+            if (m_State.compare_exchange_weak(State, State | WriterBit, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            continue;
+        }
+
+        if ((State & WaitersBit) == 0 && !m_State.compare_exchange_weak(State, State | WaitersBit, std::memory_order_relaxed))
+            continue;
+
+        ParkWhileEqual(m_State, State | WaitersBit);
+        ++NumParks;
+    }
+
+    UpdateStats(m_pStats, NumSpins, NumParks);
+}
+
+void AdaptiveSharedLock::LockSharedContended() noexcept
+{
+    Uint64 NumSpins = 0;
+    for (Uint32 Round = 0; Round < NumSpinRounds; ++Round)
+    {
+        NumSpins += Backoff(Round);
+
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & WriterBit) == 0 &&
+            m_State.compare_exchange_weak(State, State + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            UpdateStats(m_pStats, NumSpins, 0);
+            return;
+        }
+    }
+
+    Uint64 NumParks = 0;
+    for (;;)
+    {
+        auto State = m_State.load(std::memory_order_relaxed);
+        if ((State & WriterBit) == 0)
+        {
+            if (m_State.compare_exchange_weak(State, State + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            continue;
+        }
+
+        if ((State & WaitersBit) == 0 && !m_State.compare_exchange_weak(State, State | WaitersBit, std::memory_order_relaxed))
+            continue;
+
+        ParkWhileEqual(m_State, State | WaitersBit);
+        ++NumParks;
+    }
+
+    UpdateStats(m_pStats, NumSpins, NumParks);
+}
+
+void AdaptiveSharedLock::WakeWaiters() noexcept
+{
+    // Both readers and writers may be parked, so all of them are woken up
+    Unpark(m_State, true);
+}
+
+} // namespace ThreadingTools
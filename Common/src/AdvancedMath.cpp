@@ -0,0 +1,348 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstring>
+#include "AdvancedMath.hpp"
+#include "SIMDHelpers.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct CullingPlane
+{
+    // Components of the box corner that is the farthest along the plane normal
+    const float* pFar[3];
+    // Components of the box corner that is the nearest along the plane normal
+    const float* pNear[3];
+
+    float3 Normal;
+    float  Distance;
+};
+
+struct CullingPlanes
+{
+    CullingPlanes(const ViewFrustum& Frustum, const BoundBoxSoA& Boxes, FRUSTUM_PLANE_FLAGS PlaneFlags)
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1 << plane_idx)) == 0)
+                continue;
+
+            const Plane3D& SrcPlane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            // The same corner selection as in GetBoxVisibilityAgainstPlane()
+            auto& Plane = Planes[NumPlanes++];
+            for (Uint32 c = 0; c < 3; ++c)
+            {
+                Plane.pFar[c]  = SrcPlane.Normal[c] > 0 ? Boxes.GetMax(c) : Boxes.GetMin(c);
+                Plane.pNear[c] = SrcPlane.Normal[c] > 0 ? Boxes.GetMin(c) : Boxes.GetMax(c);
+            }
+            Plane.Normal   = SrcPlane.Normal;
+            Plane.Distance = SrcPlane.Distance;
+        }
+    }
+
+    CullingPlane Planes[ViewFrustum::NUM_PLANES];
+    Uint32       NumPlanes = 0;
+};
+
+// Every cull function calls Handler(Start, NumBoxes, InvisibleMask, FullyVisibleMask) for each
+// group of boxes, where bit i of the mask corresponds to the box with index Start + i.
+
+#if DILIGENT_AVX2_SUPPORTED
+template <typename HandlerType>
+DILIGENT_TARGET_AVX2 void CullBoxesAVX2(const CullingPlanes& Planes, size_t Start, size_t End, HandlerType& Handler)
+{
+    // Boxes are padded to BoundBoxSoA::PaddingSize, so we can always read full groups
+    for (size_t i = Start; i < End; i += 8)
+    {
+        __m256 Invisible    = _mm256_setzero_ps();
+        __m256 FullyVisible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const auto& Plane = Planes.Planes[p];
+
+            const __m256 nx = _mm256_set1_ps(Plane.Normal.x);
+            const __m256 ny = _mm256_set1_ps(Plane.Normal.y);
+            const __m256 nz = _mm256_set1_ps(Plane.Normal.z);
+            const __m256 d  = _mm256_set1_ps(Plane.Distance);
+
+            __m256 DMax = _mm256_mul_ps(_mm256_loadu_ps(Plane.pFar[0] + i), nx);
+            DMax        = _mm256_add_ps(DMax, _mm256_mul_ps(_mm256_loadu_ps(Plane.pFar[1] + i), ny));
+            DMax        = _mm256_add_ps(DMax, _mm256_mul_ps(_mm256_loadu_ps(Plane.pFar[2] + i), nz));
+            DMax        = _mm256_add_ps(DMax, d);
+
+            __m256 DMin = _mm256_mul_ps(_mm256_loadu_ps(Plane.pNear[0] + i), nx);
+            DMin        = _mm256_add_ps(DMin, _mm256_mul_ps(_mm256_loadu_ps(Plane.pNear[1] + i), ny));
+            DMin        = _mm256_add_ps(DMin, _mm256_mul_ps(_mm256_loadu_ps(Plane.pNear[2] + i), nz));
+            DMin        = _mm256_add_ps(DMin, d);
+
+            Invisible    = _mm256_or_ps(Invisible, _mm256_cmp_ps(DMax, _mm256_setzero_ps(), _CMP_LT_OQ));
+            FullyVisible = _mm256_and_ps(FullyVisible, _mm256_cmp_ps(DMin, _mm256_setzero_ps(), _CMP_GT_OQ));
+        }
+
+        const auto NumBoxes = static_cast<Uint32>(std::min(End - i, size_t{8}));
+        Handler(i, NumBoxes, static_cast<Uint32>(_mm256_movemask_ps(Invisible)), static_cast<Uint32>(_mm256_movemask_ps(FullyVisible)));
+    }
+}
+#endif
+
+#if DILIGENT_SSE2_SUPPORTED
+template <typename HandlerType>
+void CullBoxesSSE2(const CullingPlanes& Planes, size_t Start, size_t End, HandlerType& Handler)
+{
+    for (size_t i = Start; i < End; i += 4)
+    {
+        __m128 Invisible    = _mm_setzero_ps();
+        __m128 FullyVisible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const auto& Plane = Planes.Planes[p];
+
+            const __m128 nx = _mm_set1_ps(Plane.Normal.x);
+            const __m128 ny = _mm_set1_ps(Plane.Normal.y);
+            const __m128 nz = _mm_set1_ps(Plane.Normal.z);
+            const __m128 d  = _mm_set1_ps(Plane.Distance);
+
+            __m128 DMax = _mm_mul_ps(_mm_loadu_ps(Plane.pFar[0] + i), nx);
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(_mm_loadu_ps(Plane.pFar[1] + i), ny));
+            DMax        = _mm_add_ps(DMax, _mm_mul_ps(_mm_loadu_ps(Plane.pFar[2] + i), nz));
+            DMax        = _mm_add_ps(DMax, d);
+
+            __m128 DMin = _mm_mul_ps(_mm_loadu_ps(Plane.pNear[0] + i), nx);
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(_mm_loadu_ps(Plane.pNear[1] + i), ny));
+            DMin        = _mm_add_ps(DMin, _mm_mul_ps(_mm_loadu_ps(Plane.pNear[2] + i), nz));
+            DMin        = _mm_add_ps(DMin, d);
+
+            Invisible    = _mm_or_ps(Invisible, _mm_cmplt_ps(DMax, _mm_setzero_ps()));
+            FullyVisible = _mm_and_ps(FullyVisible, _mm_cmpgt_ps(DMin, _mm_setzero_ps()));
+        }
+
+        const auto NumBoxes = static_cast<Uint32>(std::min(End - i, size_t{4}));
+        Handler(i, NumBoxes, static_cast<Uint32>(_mm_movemask_ps(Invisible)), static_cast<Uint32>(_mm_movemask_ps(FullyVisible)));
+    }
+}
+#endif
+
+#if DILIGENT_NEON_SUPPORTED
+inline Uint32 GetMaskNEON(uint32x4_t Mask)
+{
+    static const uint32x4_t Bits = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(Mask, Bits));
+}
+
+template <typename HandlerType>
+void CullBoxesNEON(const CullingPlanes& Planes, size_t Start, size_t End, HandlerType& Handler)
+{
+    for (size_t i = Start; i < End; i += 4)
+    {
+        uint32x4_t Invisible    = vdupq_n_u32(0);
+        uint32x4_t FullyVisible = vdupq_n_u32(~0u);
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const auto& Plane = Planes.Planes[p];
+
+            const float32x4_t d = vdupq_n_f32(Plane.Distance);
+
+            // Use separate multiplies and adds rather than fused multiply-add to match the scalar results
+            float32x4_t DMax = vmulq_n_f32(vld1q_f32(Plane.pFar[0] + i), Plane.Normal.x);
+            DMax             = vaddq_f32(DMax, vmulq_n_f32(vld1q_f32(Plane.pFar[1] + i), Plane.Normal.y));
+            DMax             = vaddq_f32(DMax, vmulq_n_f32(vld1q_f32(Plane.pFar[2] + i), Plane.Normal.z));
+            DMax             = vaddq_f32(DMax, d);
+
+            float32x4_t DMin = vmulq_n_f32(vld1q_f32(Plane.pNear[0] + i), Plane.Normal.x);
+            DMin             = vaddq_f32(DMin, vmulq_n_f32(vld1q_f32(Plane.pNear[1] + i), Plane.Normal.y));
+            DMin             = vaddq_f32(DMin, vmulq_n_f32(vld1q_f32(Plane.pNear[2] + i), Plane.Normal.z));
+            DMin             = vaddq_f32(DMin, d);
+
+            Invisible    = vorrq_u32(Invisible, vcltq_f32(DMax, vdupq_n_f32(0.f)));
+            FullyVisible = vandq_u32(FullyVisible, vcgtq_f32(DMin, vdupq_n_f32(0.f)));
+        }
+
+        const auto NumBoxes = static_cast<Uint32>(std::min(End - i, size_t{4}));
+        Handler(i, NumBoxes, GetMaskNEON(Invisible), GetMaskNEON(FullyVisible));
+    }
+}
+#endif
+
+template <typename HandlerType>
+void CullBoxesScalar(const CullingPlanes& Planes, size_t Start, size_t End, HandlerType& Handler)
+{
+    for (size_t i = Start; i < End; ++i)
+    {
+        bool Invisible    = false;
+        bool FullyVisible = true;
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const auto& Plane = Planes.Planes[p];
+
+            const float DMax = Plane.pFar[0][i] * Plane.Normal.x + Plane.pFar[1][i] * Plane.Normal.y + Plane.pFar[2][i] * Plane.Normal.z + Plane.Distance;
+            const float DMin = Plane.pNear[0][i] * Plane.Normal.x + Plane.pNear[1][i] * Plane.Normal.y + Plane.pNear[2][i] * Plane.Normal.z + Plane.Distance;
+
+            Invisible    = Invisible || DMax < 0;
+            FullyVisible = FullyVisible && DMin > 0;
+        }
+        Handler(i, 1, Invisible ? 1u : 0u, FullyVisible ? 1u : 0u);
+    }
+}
+
+// Processes boxes in range [Start, End). Start must be a multiple of BoundBoxSoA::PaddingSize.
+template <typename HandlerType>
+void CullBoxes(const CullingPlanes& Planes, size_t Start, size_t End, HandlerType& Handler)
+{
+    VERIFY_EXPR(Start % BoundBoxSoA::PaddingSize == 0);
+
+#if DILIGENT_AVX2_SUPPORTED
+    if (IsAVX2Supported())
+    {
+        CullBoxesAVX2(Planes, Start, End, Handler);
+        return;
+    }
+#endif
+
+#if DILIGENT_SSE2_SUPPORTED
+    CullBoxesSSE2(Planes, Start, End, Handler);
+#elif DILIGENT_NEON_SUPPORTED
+    CullBoxesNEON(Planes, Start, End, Handler);
+#else
+    CullBoxesScalar(Planes, Start, End, Handler);
+#endif
+}
+
+struct VisibleIndexWriter
+{
+    explicit VisibleIndexWriter(Uint32* _pIndices) :
+        pIndices{_pIndices}
+    {}
+
+    void operator()(size_t Start, Uint32 NumBoxes, Uint32 InvisibleMask, Uint32 /*FullyVisibleMask*/)
+    {
+        // The index is always written, but the counter is only incremented for visible boxes.
+        // Since NumVisible never exceeds the number of processed boxes, the writes stay within
+        // the output array.
+        for (Uint32 i = 0; i < NumBoxes; ++i)
+        {
+            pIndices[NumVisible] = static_cast<Uint32>(Start + i);
+            NumVisible += ((InvisibleMask >> i) & 1u) ^ 1u;
+        }
+    }
+
+    Uint32* const pIndices;
+    size_t        NumVisible = 0;
+};
+
+size_t CullBoxRange(const CullingPlanes& Planes, size_t Start, size_t End, Uint32* pVisibleIndices)
+{
+    VisibleIndexWriter Writer{pVisibleIndices};
+    CullBoxes(Planes, Start, End, Writer);
+    return Writer.NumVisible;
+}
+
+} // namespace
+
+
+void GetBoxVisibility(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      BoxVisibility*      pVisibility,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    VERIFY_EXPR(pVisibility != nullptr || Boxes.GetCount() == 0);
+
+    const CullingPlanes Planes{ViewFrustum, Boxes, PlaneFlags};
+
+    auto Handler = [pVisibility](size_t Start, Uint32 NumBoxes, Uint32 InvisibleMask, Uint32 FullyVisibleMask) {
+        for (Uint32 i = 0; i < NumBoxes; ++i)
+        {
+            BoxVisibility Visibility = BoxVisibility::Intersecting;
+            if ((InvisibleMask >> i) & 1u)
+                Visibility = BoxVisibility::Invisible;
+            else if ((FullyVisibleMask >> i) & 1u)
+                Visibility = BoxVisibility::FullyVisible;
+            pVisibility[Start + i] = Visibility;
+        }
+    };
+    CullBoxes(Planes, 0, Boxes.GetCount(), Handler);
+}
+
+size_t CullBoundBoxes(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      Uint32*             pVisibleIndices,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    VERIFY_EXPR(pVisibleIndices != nullptr || Boxes.GetCount() == 0);
+
+    const CullingPlanes Planes{ViewFrustum, Boxes, PlaneFlags};
+    return CullBoxRange(Planes, 0, Boxes.GetCount(), pVisibleIndices);
+}
+
+size_t CullBoundBoxes(const ViewFrustum&  ViewFrustum,
+                      const BoundBoxSoA&  Boxes,
+                      Uint32*             pVisibleIndices,
+                      ThreadPool&         Pool,
+                      FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    VERIFY_EXPR(pVisibleIndices != nullptr || Boxes.GetCount() == 0);
+
+    // Culling a box takes a few nanoseconds, so small tasks are not worth distributing
+    constexpr size_t MinBoxesPerTask = 8192;
+
+    const size_t Count    = Boxes.GetCount();
+    const size_t MaxTasks = (size_t{Pool.GetNumThreads()} + 1) * 4;
+    const size_t NumTasks = std::min((Count + MinBoxesPerTask - 1) / MinBoxesPerTask, MaxTasks);
+    if (NumTasks <= 1)
+        return CullBoundBoxes(ViewFrustum, Boxes, pVisibleIndices, PlaneFlags);
+
+    const size_t BoxesPerTask = AlignUp((Count + NumTasks - 1) / NumTasks, BoundBoxSoA::PaddingSize);
+
+    const CullingPlanes Planes{ViewFrustum, Boxes, PlaneFlags};
+
+    // Every task writes visible indices to its own range of the output array
+    std::vector<size_t> NumVisible(NumTasks);
+    Pool.ParallelFor(static_cast<Uint32>(NumTasks), [&](Uint32 Task) {
+        const size_t Start = Task * BoxesPerTask;
+        const size_t End   = std::min(Start + BoxesPerTask, Count);
+        NumVisible[Task]   = Start < End ? CullBoxRange(Planes, Start, End, pVisibleIndices + Start) : 0;
+    });
+
+    size_t TotalVisible = NumVisible[0];
+    for (size_t Task = 1; Task < NumTasks; ++Task)
+    {
+        if (NumVisible[Task] > 0)
+            memmove(pVisibleIndices + TotalVisible, pVisibleIndices + Task * BoxesPerTask, NumVisible[Task] * sizeof(Uint32));
+        TotalVisible += NumVisible[Task];
+    }
+
+    return TotalVisible;
+}
+
+} // namespace Diligent
@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BasicMath.hpp"
+#include "SIMDHelpers.hpp"
+
+namespace Diligent
+{
+
+// The generic templates in BasicMath.hpp are the reference implementation. The batch transforms
+// below perform multiplications and additions in the same order, so on x86 the results are
+// bitwise identical to the generic code.
+
+#if DILIGENT_SSE2_SUPPORTED
+namespace
+{
+
+// The macro transforms 4 points loaded into registers P0, P1, P2 as
+//      P0 = (x0 y0 z0 x1),  P1 = (y1 z1 x2 y2),  P2 = (z2 x3 y3 z3)
+// and writes the result back to the same registers.
+// The same code is used for 128-bit and 256-bit (two groups of 4 points) registers.
+#    define DILIGENT_TRANSFORM_POINTS(TYPE, SUFFIX, P0, P1, P2, M)                                                                   \
+        do                                                                                                                           \
+        {                                                                                                                            \
+            const TYPE X = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_shuffle_ps(P0, P1, _MM_SHUFFLE(2, 2, 3, 0)),                       \
+                                                    _mm##SUFFIX##_shuffle_ps(P1, P2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0)); \
+            const TYPE Y = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_shuffle_ps(P0, P1, _MM_SHUFFLE(0, 0, 0, 1)),                       \
+                                                    _mm##SUFFIX##_shuffle_ps(P1, P2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)); \
+            const TYPE Z = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_shuffle_ps(P0, P1, _MM_SHUFFLE(1, 1, 2, 2)),                       \
+                                                    _mm##SUFFIX##_shuffle_ps(P2, P2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)); \
+                                                                                                                                     \
+            TYPE Out[4];                                                                                                             \
+            for (int c = 0; c < 4; ++c)                                                                                              \
+            {                                                                                                                        \
+                /* Same operation order as in Vector4<float>::operator*(const Matrix4x4<float>&) */                                  \
+                TYPE v = _mm##SUFFIX##_mul_ps(X, _mm##SUFFIX##_set1_ps(M.m[0][c]));                                                  \
+                v      = _mm##SUFFIX##_add_ps(v, _mm##SUFFIX##_mul_ps(Y, _mm##SUFFIX##_set1_ps(M.m[1][c])));                         \
+                v      = _mm##SUFFIX##_add_ps(v, _mm##SUFFIX##_mul_ps(Z, _mm##SUFFIX##_set1_ps(M.m[2][c])));                         \
+                Out[c] = _mm##SUFFIX##_add_ps(v, _mm##SUFFIX##_set1_ps(M.m[3][c]));                                                  \
+            }                                                                                                                        \
+            const TYPE OX = _mm##SUFFIX##_div_ps(Out[0], Out[3]);                                                                    \
+            const TYPE OY = _mm##SUFFIX##_div_ps(Out[1], Out[3]);                                                                    \
+            const TYPE OZ = _mm##SUFFIX##_div_ps(Out[2], Out[3]);                                                                    \
+                                                                                                                                     \
+            P0 = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_unpacklo_ps(OX, OY),                                                         \
+                                          _mm##SUFFIX##_shuffle_ps(OZ, OX, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));       \
+            P1 = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_shuffle_ps(OY, OZ, _MM_SHUFFLE(1, 1, 1, 1)),                                 \
+                                          _mm##SUFFIX##_shuffle_ps(OX, OY, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));       \
+            P2 = _mm##SUFFIX##_shuffle_ps(_mm##SUFFIX##_shuffle_ps(OZ, OX, _MM_SHUFFLE(3, 3, 2, 2)),                                 \
+                                          _mm##SUFFIX##_shuffle_ps(OY, OZ, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));       \
+        } while (false)
+
+size_t TransformPointsSSE2(const float* pSrc, size_t Count, const Matrix4x4<float>& m, float* pDst)
+{
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4, pSrc += 12, pDst += 12)
+    {
+        __m128 P0 = _mm_loadu_ps(pSrc + 0);
+        __m128 P1 = _mm_loadu_ps(pSrc + 4);
+        __m128 P2 = _mm_loadu_ps(pSrc + 8);
+        DILIGENT_TRANSFORM_POINTS(__m128, , P0, P1, P2, m);
+        _mm_storeu_ps(pDst + 0, P0);
+        _mm_storeu_ps(pDst + 4, P1);
+        _mm_storeu_ps(pDst + 8, P2);
+    }
+    return i;
+}
+
+#    if DILIGENT_AVX2_SUPPORTED
+DILIGENT_TARGET_AVX2 __m256 LoadTwoM128(const float* pLo, const float* pHi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pLo)), _mm_loadu_ps(pHi), 1);
+}
+
+DILIGENT_TARGET_AVX2 void StoreTwoM128(float* pLo, float* pHi, __m256 v)
+{
+    _mm_storeu_ps(pLo, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(pHi, _mm256_extractf128_ps(v, 1));
+}
+
+DILIGENT_TARGET_AVX2 size_t TransformPointsAVX2(const float* pSrc, size_t Count, const Matrix4x4<float>& m, float* pDst)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8, pSrc += 24, pDst += 24)
+    {
+        // Low 128 bits contain points 0-3, high 128 bits contain points 4-7
+        __m256 P0 = LoadTwoM128(pSrc + 0, pSrc + 12);
+        __m256 P1 = LoadTwoM128(pSrc + 4, pSrc + 16);
+        __m256 P2 = LoadTwoM128(pSrc + 8, pSrc + 20);
+        DILIGENT_TRANSFORM_POINTS(__m256, 256, P0, P1, P2, m);
+        StoreTwoM128(pDst + 0, pDst + 12, P0);
+        StoreTwoM128(pDst + 4, pDst + 16, P1);
+        StoreTwoM128(pDst + 8, pDst + 20, P2);
+    }
+    return i;
+}
+#    endif
+
+#    undef DILIGENT_TRANSFORM_POINTS
+
+} // namespace
+#endif
+
+void TransformPoints(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst)
+{
+    static_assert(sizeof(float3) == sizeof(float) * 3, "float3 is expected to be tightly packed");
+
+    size_t i = 0;
+#if DILIGENT_SSE2_SUPPORTED
+#    if DILIGENT_AVX2_SUPPORTED
+    if (Count >= 8 && IsAVX2Supported())
+        i = TransformPointsAVX2(&pSrc[0].x, Count, m, &pDst[0].x);
+#    endif
+    if (Count - i >= 4)
+        i += TransformPointsSSE2(&pSrc[i].x, Count - i, m, &pDst[i].x);
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+}
+
+void TransformPoints(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst)
+{
+    // float4 * float4x4 is vectorized, so there is nothing to gain from processing
+    // several vectors at a time.
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+}
+
+} // namespace Diligent
@@ -0,0 +1,267 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "pch.h"
+
+#include "MappedFileStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+
+// Android files may reside in the application package and are opened through the asset manager,
+// so memory mapping is only used on Linux.
+#if PLATFORM_LINUX
+#    define DILIGENT_USE_MMAP 1
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    define DILIGENT_USE_MMAP 0
+#endif
+
+namespace Diligent
+{
+
+MappedFileBlob::MappedFileBlob(IReferenceCounters*   pRefCounters,
+                               const Char*           Path,
+                               EMappedFileAccessHint AccessHint) :
+    TBase{pRefCounters}
+{
+    VERIFY_EXPR(Path != nullptr);
+
+#if DILIGENT_USE_MMAP
+    // Apply the same path transformations as the platform file system does
+    auto FullPath = FileSystem::GetFullPath(Path);
+    FileSystem::CorrectSlashes(FullPath, FileSystem::GetSlashSymbol());
+
+    const int fd = open(FullPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    struct stat FileStat = {};
+    if (fstat(fd, &FileStat) == 0 && S_ISREG(FileStat.st_mode))
+    {
+        m_IsValid = true;
+
+        const auto FileSize = static_cast<size_t>(FileStat.st_size);
+        // Zero-length mappings are not allowed
+        if (FileSize > 0)
+        {
+            // Private writable mapping: pages are shared with the page cache until they are modified
+            void* pData = mmap(nullptr, FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (pData != MAP_FAILED)
+            {
+                m_pMappedData = pData;
+                m_MappedSize  = FileSize;
+
+                const int Advice = AccessHint == EMappedFileAccessHint::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM;
+                madvise(m_pMappedData, m_MappedSize, Advice);
+                if (AccessHint == EMappedFileAccessHint::Sequential)
+                {
+                    // Start reading the file in the background
+                    madvise(m_pMappedData, m_MappedSize, MADV_WILLNEED);
+                }
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("Failed to map file '", FullPath, "'. The file will be read into memory.");
+                m_DataBuff.resize(FileSize);
+                size_t BytesRead = 0;
+                while (BytesRead < FileSize)
+                {
+                    const auto Res = pread(fd, m_DataBuff.data() + BytesRead, FileSize - BytesRead, static_cast<off_t>(BytesRead));
+                    if (Res <= 0)
+                        break;
+                    BytesRead += static_cast<size_t>(Res);
+                }
+                if (BytesRead != FileSize)
+                {
+                    m_DataBuff.clear();
+                    m_IsValid = false;
+                }
+            }
+        }
+    }
+
+    // The mapping remains valid after the file descriptor is closed
+    close(fd);
+#else
+    (void)AccessHint;
+
+    FileWrapper File{Path, EFileAccessMode::Read};
+    if (File)
+    {
+        m_DataBuff.resize(File->GetSize());
+        m_IsValid = m_DataBuff.empty() || File->Read(m_DataBuff.data(), m_DataBuff.size());
+        if (!m_IsValid)
+            m_DataBuff.clear();
+    }
+#endif
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+    Unmap();
+}
+
+void MappedFileBlob::Unmap()
+{
+#if DILIGENT_USE_MMAP
+    if (m_pMappedData != nullptr)
+    {
+        munmap(m_pMappedData, m_MappedSize);
+    }
+#endif
+    m_pMappedData = nullptr;
+    m_MappedSize  = 0;
+}
+
+IMPLEMENT_QUERY_INTERFACE(MappedFileBlob, IID_DataBlob, TBase)
+
+void MappedFileBlob::Resize(size_t NewSize)
+{
+    if (m_pMappedData != nullptr)
+    {
+        // The mapping can't be resized, so move the data to the heap buffer
+        std::vector<Uint8> DataBuff(NewSize);
+        memcpy(DataBuff.data(), m_pMappedData, std::min(NewSize, m_MappedSize));
+        Unmap();
+        m_DataBuff.swap(DataBuff);
+    }
+    else
+    {
+        m_DataBuff.resize(NewSize);
+    }
+}
+
+size_t MappedFileBlob::GetSize() const
+{
+    return m_pMappedData != nullptr ? m_MappedSize : m_DataBuff.size();
+}
+
+void* MappedFileBlob::GetDataPtr()
+{
+    return m_pMappedData != nullptr ? m_pMappedData : m_DataBuff.data();
+}
+
+const void* MappedFileBlob::GetConstDataPtr() const
+{
+    return m_pMappedData != nullptr ? m_pMappedData : m_DataBuff.data();
+}
+
+
+
+MappedFileStream::MappedFileStream(IReferenceCounters*   pRefCounters,
+                                   const Char*           Path,
+                                   EMappedFileAccessHint AccessHint) :
+    TBase{pRefCounters},
+    m_pData{MakeNewRCObj<MappedFileBlob>()(Path, AccessHint)}
+{
+}
+
+void MappedFileStream::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
+{
+    if (ppInterface == nullptr)
+        return;
+
+    if (IID == IID_MappedFileStream || IID == IID_FileStream)
+    {
+        *ppInterface = this;
+        (*ppInterface)->AddRef();
+    }
+    else
+    {
+        TBase::QueryInterface(IID, ppInterface);
+    }
+}
+
+bool MappedFileStream::Read(void* Data, size_t Size)
+{
+    const auto DataSize = m_pData->GetSize();
+    VERIFY_EXPR(m_CurrentOffset <= DataSize);
+    const auto BytesToRead = std::min(DataSize - m_CurrentOffset, Size);
+    if (BytesToRead > 0)
+        memcpy(Data, reinterpret_cast<const Uint8*>(m_pData->GetConstDataPtr()) + m_CurrentOffset, BytesToRead);
+    m_CurrentOffset += BytesToRead;
+    return Size == BytesToRead;
+}
+
+void MappedFileStream::ReadBlob(IDataBlob* pData)
+{
+    pData->Resize(m_pData->GetSize() - m_CurrentOffset);
+    auto res = Read(pData->GetDataPtr(), pData->GetSize());
+    VERIFY_EXPR(res);
+    (void)res;
+}
+
+bool MappedFileStream::Write(const void* Data, size_t Size)
+{
+    UNSUPPORTED("Writing to the mapped file stream is not supported");
+    return false;
+}
+
+size_t MappedFileStream::GetSize()
+{
+    return m_pData->GetSize();
+}
+
+bool MappedFileStream::IsValid()
+{
+    return m_pData->IsValid();
+}
+
+RefCntAutoPtr<IDataBlob> MappedFileStream::ReadRemainingData()
+{
+    if (m_CurrentOffset == 0)
+    {
+        m_CurrentOffset = m_pData->GetSize();
+        return RefCntAutoPtr<IDataBlob>{m_pData};
+    }
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+    ReadBlob(pData);
+    return pData;
+}
+
+
+RefCntAutoPtr<IDataBlob> ReadStreamData(IFileStream* pStream)
+{
+    VERIFY_EXPR(pStream != nullptr);
+
+    RefCntAutoPtr<MappedFileStream> pMappedStream{pStream, IID_MappedFileStream};
+    if (pMappedStream)
+        return pMappedStream->ReadRemainingData();
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+    pStream->ReadBlob(pData);
+    return pData;
+}
+
+} // namespace Diligent
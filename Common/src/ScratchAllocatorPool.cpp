@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "ScratchAllocatorPool.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 ScratchAllocatorPool::BlockSize;
+
+// Scratch allocators of one thread. The object is reference-counted: the thread holds one
+// reference, and every borrowed allocator holds another one, so that an allocator that has been
+// moved to another thread can be returned after the owning thread has exited.
+class ScratchAllocatorPool::ThreadAllocators
+{
+public:
+    static ThreadAllocators& GetForCurrentThread()
+    {
+        auto& pAllocators = GetThreadHolder().pAllocators;
+        if (pAllocators == nullptr)
+        {
+            auto* pRawMem = DefaultRawMemoryAllocator::GetAllocator().Allocate(sizeof(ThreadAllocators), "Thread scratch allocators", __FILE__, __LINE__);
+            pAllocators   = new (pRawMem) ThreadAllocators{};
+        }
+        return *pAllocators;
+    }
+
+    // Must only be called by the owning thread
+    DynamicLinearAllocator* Borrow()
+    {
+        if (m_NumBorrowed == m_Allocators.size())
+            ReclaimReturnedAllocators();
+
+        if (m_NumBorrowed == m_Allocators.size())
+        {
+            auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+            auto* pRawMem = RawAllocator.Allocate(sizeof(DynamicLinearAllocator), "Scratch allocator", __FILE__, __LINE__);
+            m_Allocators.push_back(new (pRawMem) DynamicLinearAllocator{RawAllocator, ScratchAllocatorPool::BlockSize});
+        }
+        m_RefCount.fetch_add(1, std::memory_order_relaxed);
+        return m_Allocators[m_NumBorrowed++];
+    }
+
+    // May be called by any thread
+    void Return(DynamicLinearAllocator* pAllocator)
+    {
+        pAllocator->Reset();
+
+        if (GetThreadHolder().pAllocators == this)
+        {
+            VERIFY(m_NumBorrowed > 0, "No allocators have been borrowed from this thread's pool");
+            MarkReturned(pAllocator);
+        }
+        else
+        {
+            // The allocator is returned by another thread. The owning thread will
+            // reclaim it when it runs out of available allocators.
+            std::lock_guard<std::mutex> Lock{m_ReturnedAllocatorsMtx};
+            m_ReturnedAllocators.push_back(pAllocator);
+        }
+
+        Release();
+    }
+
+private:
+    struct ThreadHolder
+    {
+        ThreadAllocators* pAllocators = nullptr;
+
+        ~ThreadHolder()
+        {
+            if (pAllocators != nullptr)
+                pAllocators->Release();
+            pAllocators = nullptr;
+        }
+    };
+
+    static ThreadHolder& GetThreadHolder()
+    {
+        static thread_local ThreadHolder Holder;
+        return Holder;
+    }
+
+    ThreadAllocators() = default;
+
+    ~ThreadAllocators()
+    {
+        VERIFY(m_NumBorrowed == m_ReturnedAllocators.size(), m_NumBorrowed - m_ReturnedAllocators.size(), " scratch allocator(s) have not been returned to the pool");
+        for (auto* pAllocator : m_Allocators)
+        {
+            pAllocator->~DynamicLinearAllocator();
+            DefaultRawMemoryAllocator::GetAllocator().Free(pAllocator);
+        }
+    }
+
+    void Release()
+    {
+        if (m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            this->~ThreadAllocators();
+            DefaultRawMemoryAllocator::GetAllocator().Free(this);
+        }
+    }
+
+    void MarkReturned(DynamicLinearAllocator* pAllocator)
+    {
+        // Allocators are usually returned in reverse order. Keep the borrowed
+        // allocators at the beginning of the list in any case.
+        for (size_t i = m_NumBorrowed; i > 0; --i)
+        {
+            if (m_Allocators[i - 1] == pAllocator)
+            {
+                std::swap(m_Allocators[i - 1], m_Allocators[m_NumBorrowed - 1]);
+                --m_NumBorrowed;
+                return;
+            }
+        }
+        UNEXPECTED("The allocator has not been borrowed from this thread's pool");
+    }
+
+    void ReclaimReturnedAllocators()
+    {
+        std::lock_guard<std::mutex> Lock{m_ReturnedAllocatorsMtx};
+        for (auto* pAllocator : m_ReturnedAllocators)
+            MarkReturned(pAllocator);
+        m_ReturnedAllocators.clear();
+    }
+
+    // Accessed by the owning thread only. Allocators in [0, m_NumBorrowed) range are borrowed.
+    std::vector<DynamicLinearAllocator*> m_Allocators;
+    size_t                               m_NumBorrowed = 0;
+
+    // Allocators that have been returned by other threads, but are still counted as borrowed
+    std::mutex                           m_ReturnedAllocatorsMtx;
+    std::vector<DynamicLinearAllocator*> m_ReturnedAllocators;
+
+    std::atomic<Uint32> m_RefCount{1};
+};
+
+ScratchAllocatorPool::ScopedAllocator ScratchAllocatorPool::Borrow()
+{
+    auto& Owner = ThreadAllocators::GetForCurrentThread();
+    return ScopedAllocator{Owner.Borrow(), &Owner};
+}
+
+void ScratchAllocatorPool::Return(DynamicLinearAllocator* pAllocator, ThreadAllocators* pOwner)
+{
+    pOwner->Return(pAllocator);
+}
+
+} // namespace Diligent
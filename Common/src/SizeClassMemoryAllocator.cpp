@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstddef>
+#include "SizeClassMemoryAllocator.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct AllocationHeader
+{
+    Uint32 SizeClass;
+    Uint32 Signature;
+    size_t Size;
+};
+
+constexpr Uint32 AllocationHeaderSignature = 0x5A1C1A55;
+
+// Keep the user memory aligned the same way as memory returned by malloc
+constexpr size_t AllocationHeaderSize = (sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+// The number of size classes with 16-byte step
+constexpr Uint32 NumLinearSizeClasses = 8;
+constexpr size_t LinearSizeClassStep  = 16;
+constexpr size_t MaxLinearClassSize   = NumLinearSizeClasses * LinearSizeClassStep;
+constexpr Uint32 MaxLinearClassLog2   = 7;
+static_assert(MaxLinearClassSize == size_t{1} << MaxLinearClassLog2, "Max linear class size must be 2^MaxLinearClassLog2");
+
+// The number of size classes per power of two
+constexpr Uint32 SizeClassesPerPow2Log2 = 2;
+constexpr Uint32 SizeClassesPerPow2     = 1 << SizeClassesPerPow2Log2;
+
+constexpr Uint32 MaxSmallAllocationLog2 = 13;
+static_assert(SizeClassMemoryAllocator::MaxSmallAllocationSize == size_t{1} << MaxSmallAllocationLog2, "Max small allocation size must be 2^MaxSmallAllocationLog2");
+static_assert(NumLinearSizeClasses + (MaxSmallAllocationLog2 - MaxLinearClassLog2) * SizeClassesPerPow2 == SizeClassMemoryAllocator::NumSizeClasses,
+              "Size class layout is inconsistent with the number of size classes");
+
+void UpdateMax(std::atomic<size_t>& MaxVal, size_t Val)
+{
+    auto CurrMax = MaxVal.load(std::memory_order_relaxed);
+    while (Val > CurrMax && !MaxVal.compare_exchange_weak(CurrMax, Val, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+constexpr Uint32 SizeClassMemoryAllocator::NumSizeClasses;
+constexpr size_t SizeClassMemoryAllocator::MaxSmallAllocationSize;
+constexpr Uint32 SizeClassMemoryAllocator::LargeAllocationSizeClass;
+
+Uint32 SizeClassMemoryAllocator::GetSizeClass(size_t Size)
+{
+    if (Size <= MaxLinearClassSize)
+        return static_cast<Uint32>((std::max(Size, size_t{1}) + LinearSizeClassStep - 1) / LinearSizeClassStep - 1);
+
+    if (Size > MaxSmallAllocationSize)
+        return LargeAllocationSizeClass;
+
+    // Size is in (2^Log2, 2^(Log2+1)] range that is split into SizeClassesPerPow2 classes
+    const auto Log2      = PlatformMisc::GetMSB(static_cast<Uint32>(Size - 1));
+    const auto SubClass  = static_cast<Uint32>((Size - 1 - (size_t{1} << Log2)) >> (Log2 - SizeClassesPerPow2Log2));
+    const auto SizeClass = NumLinearSizeClasses + (Log2 - MaxLinearClassLog2) * SizeClassesPerPow2 + SubClass;
+    VERIFY_EXPR(SizeClass < NumSizeClasses);
+    return SizeClass;
+}
+
+size_t SizeClassMemoryAllocator::GetSizeClassBlockSize(Uint32 SizeClass)
+{
+    VERIFY(SizeClass < NumSizeClasses, "Size class index (", SizeClass, ") is out of range");
+    if (SizeClass < NumLinearSizeClasses)
+        return (size_t{SizeClass} + 1) * LinearSizeClassStep;
+
+    const auto Log2     = MaxLinearClassLog2 + (SizeClass - NumLinearSizeClasses) / SizeClassesPerPow2;
+    const auto SubClass = (SizeClass - NumLinearSizeClasses) % SizeClassesPerPow2;
+    return (size_t{1} << Log2) + (size_t{SubClass} + 1) * (size_t{1} << (Log2 - SizeClassesPerPow2Log2));
+}
+
+SizeClassMemoryAllocator::SizeClassMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t PageSize) :
+    m_RawMemoryAllocator{RawMemoryAllocator}
+{
+    for (Uint32 SizeClass = 0; SizeClass < NumSizeClasses; ++SizeClass)
+    {
+        const auto BlockSize       = AllocationHeaderSize + GetSizeClassBlockSize(SizeClass);
+        const auto NumBlocksInPage = static_cast<Uint32>(std::max(PageSize / BlockSize, size_t{4}));
+        m_Pools[SizeClass].reset(new ThreadCachingFixedBlockMemoryAllocator{RawMemoryAllocator, BlockSize, NumBlocksInPage});
+    }
+    VERIFY_EXPR(GetSizeClassBlockSize(NumSizeClasses - 1) == MaxSmallAllocationSize);
+}
+
+SizeClassMemoryAllocator::~SizeClassMemoryAllocator()
+{
+#ifdef DILIGENT_DEBUG
+    for (Uint32 SizeClass = 0; SizeClass <= NumSizeClasses; ++SizeClass)
+    {
+        const auto NumLiveAllocations = m_Counters[SizeClass].NumLiveAllocations.load();
+        VERIFY(NumLiveAllocations == 0, "Memory leak detected: ", NumLiveAllocations, " allocation(s) in size class ", SizeClass, " have not been released");
+    }
+#endif
+}
+
+void* SizeClassMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    const auto SizeClass = GetSizeClass(Size);
+
+    void* pRawMem = nullptr;
+    if (SizeClass < NumSizeClasses)
+    {
+        auto& Pool = *m_Pools[SizeClass];
+        pRawMem    = Pool.Allocate(AllocationHeaderSize + GetSizeClassBlockSize(SizeClass), dbgDescription, dbgFileName, dbgLineNumber);
+    }
+    else
+    {
+        pRawMem = m_RawMemoryAllocator.Allocate(AllocationHeaderSize + Size, dbgDescription, dbgFileName, dbgLineNumber);
+    }
+
+    if (pRawMem == nullptr)
+        return nullptr;
+
+    auto* pHeader      = reinterpret_cast<AllocationHeader*>(pRawMem);
+    pHeader->SizeClass = SizeClass;
+    pHeader->Signature = AllocationHeaderSignature;
+    pHeader->Size      = Size;
+
+    auto& Counters = m_Counters[SizeClass];
+    Counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    Counters.LiveBytes.fetch_add(Size, std::memory_order_relaxed);
+    UpdateMax(Counters.PeakLiveAllocations, Counters.NumLiveAllocations.fetch_add(1, std::memory_order_relaxed) + 1);
+
+    return reinterpret_cast<Uint8*>(pRawMem) + AllocationHeaderSize;
+}
+
+void SizeClassMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    auto* pRawMem = reinterpret_cast<Uint8*>(Ptr) - AllocationHeaderSize;
+    auto* pHeader = reinterpret_cast<AllocationHeader*>(pRawMem);
+    VERIFY(pHeader->Signature == AllocationHeaderSignature, "Allocation header is corrupted or the memory was not allocated by this allocator");
+    VERIFY(pHeader->SizeClass <= NumSizeClasses, "Invalid size class");
+
+    const auto SizeClass = pHeader->SizeClass;
+
+    auto& Counters = m_Counters[SizeClass];
+    Counters.LiveBytes.fetch_sub(pHeader->Size, std::memory_order_relaxed);
+    Counters.NumLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+#ifdef DILIGENT_DEBUG
+    pHeader->Signature = 0;
+#endif
+
+    if (SizeClass < NumSizeClasses)
+        m_Pools[SizeClass]->Free(pRawMem);
+    else
+        m_RawMemoryAllocator.Free(pRawMem);
+}
+
+SizeClassMemoryAllocator::SizeClassStats SizeClassMemoryAllocator::GetSizeClassStats(Uint32 SizeClass) const
+{
+    VERIFY(SizeClass <= NumSizeClasses, "Size class index (", SizeClass, ") is out of range");
+
+    const auto& Counters = m_Counters[SizeClass];
+
+    SizeClassStats Stats;
+    Stats.BlockSize           = SizeClass < NumSizeClasses ? GetSizeClassBlockSize(SizeClass) : 0;
+    Stats.NumLiveAllocations  = Counters.NumLiveAllocations.load(std::memory_order_relaxed);
+    Stats.PeakLiveAllocations = Counters.PeakLiveAllocations.load(std::memory_order_relaxed);
+    Stats.LiveBytes           = Counters.LiveBytes.load(std::memory_order_relaxed);
+    Stats.TotalAllocations    = Counters.TotalAllocations.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+void SizeClassMemoryAllocator::Trim()
+{
+    for (auto& Pool : m_Pools)
+        Pool->Trim();
+}
+
+} // namespace Diligent
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "StringInterner.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 StringInterner::NumShards;
+
+StringInterner::StringInterner()
+{
+    for (auto& Shard : m_Shards)
+        Shard.Data.reset(new DynamicLinearAllocator{DefaultRawMemoryAllocator::GetAllocator(), 4 << 10});
+}
+
+StringInterner::~StringInterner()
+{
+}
+
+InternedString StringInterner::Intern(const Char* Str)
+{
+    if (Str == nullptr)
+        return InternedString{};
+
+    const auto Length = strlen(Str);
+    const auto Hash   = HashToSizeT(HashBytes(Str, Length));
+    VERIFY_EXPR(Hash == CStringHash<Char>{}(Str));
+
+    auto& Shard = m_Shards[GetShardIndex(Hash)];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+    auto It = Shard.Strings.find(HashMapStringKey{Hash, Str});
+    if (It != Shard.Strings.end())
+        return It->second;
+
+    auto* pHeader = static_cast<InternedString::Header*>(
+        Shard.Data->Allocate(sizeof(InternedString::Header) + Length + 1, alignof(InternedString::Header)));
+    pHeader->Hash   = Hash;
+    pHeader->Length = Length;
+
+    auto* pData = reinterpret_cast<Char*>(pHeader + 1);
+    memcpy(pData, Str, Length + 1);
+
+    const InternedString Interned{pData};
+    Shard.Strings.try_emplace(HashMapStringKey{Hash, pData}, Interned);
+    return Interned;
+}
+
+InternedString StringInterner::Find(const Char* Str) const
+{
+    if (Str == nullptr)
+        return InternedString{};
+
+    const auto  Hash  = CStringHash<Char>{}(Str);
+    const auto& Shard = m_Shards[GetShardIndex(Hash)];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+    auto It = Shard.Strings.find(HashMapStringKey{Hash, Str});
+    return It != Shard.Strings.end() ? It->second : InternedString{};
+}
+
+size_t StringInterner::GetNumStrings() const
+{
+    size_t NumStrings = 0;
+    for (const auto& Shard : m_Shards)
+    {
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+        NumStrings += Shard.Strings.size();
+    }
+    return NumStrings;
+}
+
+} // namespace Diligent
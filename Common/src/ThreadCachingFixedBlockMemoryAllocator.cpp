@@ -0,0 +1,311 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include "ThreadCachingFixedBlockMemoryAllocator.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+#ifdef DILIGENT_DEBUG
+static constexpr Uint8 AllocatedBlockMemPattern   = 0xAB;
+static constexpr Uint8 DeallocatedBlockMemPattern = 0xDE;
+#    define FillBlockWithDebugPattern(Ptr, Pattern, NumBytes) memset(Ptr, Pattern, NumBytes)
+#else
+#    define FillBlockWithDebugPattern(...)
+#endif
+
+// Blocks are aligned the same way as the memory returned by malloc, provided that
+// the raw allocator also follows this rule.
+static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+static size_t AdjustBlockSize(size_t BlockSize)
+{
+    return AlignUp(std::max(BlockSize, size_t{1}), sizeof(void*));
+}
+
+constexpr Uint32 ThreadCachingFixedBlockMemoryAllocator::NumThreadCaches;
+constexpr Uint32 ThreadCachingFixedBlockMemoryAllocator::MagazineCapacity;
+
+void ThreadCachingFixedBlockMemoryAllocator::PageList::PushFront(PageHeader* pPage)
+{
+    VERIFY_EXPR(pPage->pPrev == nullptr && pPage->pNext == nullptr);
+    pPage->pNext = m_pHead;
+    if (m_pHead != nullptr)
+        m_pHead->pPrev = pPage;
+    m_pHead = pPage;
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::PageList::Remove(PageHeader* pPage)
+{
+    if (pPage->pPrev != nullptr)
+        pPage->pPrev->pNext = pPage->pNext;
+    else
+    {
+        VERIFY(m_pHead == pPage, "The page is not in the list");
+        m_pHead = pPage->pNext;
+    }
+    if (pPage->pNext != nullptr)
+        pPage->pNext->pPrev = pPage->pPrev;
+    pPage->pPrev = nullptr;
+    pPage->pNext = nullptr;
+}
+
+ThreadCachingFixedBlockMemoryAllocator::ThreadCachingFixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
+                                                                               size_t            BlockSize,
+                                                                               Uint32            NumBlocksInPage,
+                                                                               Uint32            NumEmptyPagesToKeep) :
+    // clang-format off
+    m_RawMemoryAllocator {RawMemoryAllocator                                                                     },
+    m_BlockSize          {AdjustBlockSize(BlockSize)                                                             },
+    m_BlockStride        {AlignUp(sizeof(PageHeader*) + m_BlockSize, BlockAlignment)                             },
+    m_PageHeaderSize     {AlignUp(sizeof(PageHeader) + sizeof(PageHeader*), BlockAlignment) - sizeof(PageHeader*)},
+    m_NumBlocksInPage    {std::max(NumBlocksInPage, Uint32{1})                                                   },
+    m_NumEmptyPagesToKeep{NumEmptyPagesToKeep                                                                    }
+// clang-format on
+{
+}
+
+ThreadCachingFixedBlockMemoryAllocator::~ThreadCachingFixedBlockMemoryAllocator()
+{
+#ifdef DILIGENT_DEBUG
+    {
+        size_t NumUsedBlocks = 0;
+        for (const auto* pPage = m_AvailablePages.GetHead(); pPage != nullptr; pPage = pPage->pNext)
+            NumUsedBlocks += pPage->NumUsedBlocks;
+        for (const auto* pPage = m_FullPages.GetHead(); pPage != nullptr; pPage = pPage->pNext)
+            NumUsedBlocks += pPage->NumUsedBlocks;
+
+        size_t NumCachedBlocks = 0;
+        for (const auto& Cache : m_ThreadCaches)
+            NumCachedBlocks += Cache.NumBlocks;
+
+        VERIFY(NumUsedBlocks == NumCachedBlocks, "Memory leak detected: ", NumUsedBlocks - NumCachedBlocks, " block(s) have not been released");
+    }
+#endif
+
+    for (auto* pList : {&m_AvailablePages, &m_FullPages})
+    {
+        while (!pList->IsEmpty())
+        {
+            auto* pPage = pList->GetHead();
+            pList->Remove(pPage);
+            pPage->~PageHeader();
+            m_RawMemoryAllocator.Free(pPage);
+        }
+    }
+}
+
+ThreadCachingFixedBlockMemoryAllocator::ThreadCache& ThreadCachingFixedBlockMemoryAllocator::GetThreadCache()
+{
+    // Every thread is assigned a slot index once, the same index is used for all allocator instances.
+    static std::atomic<Uint32> NextThreadSlot{0};
+    static thread_local Uint32 ThreadSlot = NextThreadSlot.fetch_add(1);
+    return m_ThreadCaches[ThreadSlot % NumThreadCaches];
+}
+
+ThreadCachingFixedBlockMemoryAllocator::PageHeader* ThreadCachingFixedBlockMemoryAllocator::CreateNewPage()
+{
+    const auto PageSize = m_PageHeaderSize + m_BlockStride * m_NumBlocksInPage;
+
+    auto* pPageMem = m_RawMemoryAllocator.Allocate(PageSize, "ThreadCachingFixedBlockMemoryAllocator page", __FILE__, __LINE__);
+    auto* pPage    = new (pPageMem) PageHeader{};
+    m_AvailablePages.PushFront(pPage);
+    ++m_NumPages;
+    ++m_NumEmptyPages;
+    return pPage;
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::ReleasePage(PageHeader* pPage)
+{
+    VERIFY_EXPR(pPage->NumUsedBlocks == 0 && !pPage->IsFull);
+    m_AvailablePages.Remove(pPage);
+    pPage->~PageHeader();
+    m_RawMemoryAllocator.Free(pPage);
+    VERIFY_EXPR(m_NumPages > 0);
+    --m_NumPages;
+}
+
+void* ThreadCachingFixedBlockMemoryAllocator::GetBlockPayload(PageHeader* pPage, Uint32 BlockIndex) const
+{
+    VERIFY(BlockIndex < m_NumBlocksInPage, "Invalid block index");
+    auto* pBlock = reinterpret_cast<Uint8*>(pPage) + m_PageHeaderSize + BlockIndex * m_BlockStride;
+    return pBlock + sizeof(PageHeader*);
+}
+
+ThreadCachingFixedBlockMemoryAllocator::PageHeader* ThreadCachingFixedBlockMemoryAllocator::GetBlockPage(void* pBlock) const
+{
+    auto* pPage = *reinterpret_cast<PageHeader**>(reinterpret_cast<Uint8*>(pBlock) - sizeof(PageHeader*));
+#ifdef DILIGENT_DEBUG
+    {
+        const auto* pFirstBlock = reinterpret_cast<const Uint8*>(pPage) + m_PageHeaderSize + sizeof(PageHeader*);
+        const auto  Offset      = reinterpret_cast<const Uint8*>(pBlock) - pFirstBlock;
+        VERIFY(Offset >= 0 && static_cast<size_t>(Offset) % m_BlockStride == 0 && static_cast<size_t>(Offset) / m_BlockStride < m_NumBlocksInPage,
+               "Block header is corrupted or the block was not allocated by this allocator");
+    }
+#endif
+    return pPage;
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::RefillCache(ThreadCache& Cache, Uint32 NumBlocks)
+{
+    VERIFY_EXPR(Cache.NumBlocks + NumBlocks <= MagazineCapacity);
+    for (Uint32 i = 0; i < NumBlocks; ++i)
+    {
+        auto* pPage = m_AvailablePages.GetHead();
+        if (pPage == nullptr)
+            pPage = CreateNewPage();
+
+        if (pPage->NumUsedBlocks == 0)
+        {
+            VERIFY_EXPR(m_NumEmptyPages > 0);
+            --m_NumEmptyPages;
+        }
+
+        void* pBlock = nullptr;
+        if (pPage->pFreeList != nullptr)
+        {
+            pBlock           = pPage->pFreeList;
+            pPage->pFreeList = *reinterpret_cast<void**>(pBlock);
+        }
+        else
+        {
+            // Lazily initialize the next block in the page
+            VERIFY_EXPR(pPage->NumInitializedBlocks < m_NumBlocksInPage);
+            pBlock = GetBlockPayload(pPage, pPage->NumInitializedBlocks++);
+            *reinterpret_cast<PageHeader**>(reinterpret_cast<Uint8*>(pBlock) - sizeof(PageHeader*)) = pPage;
+        }
+
+        ++pPage->NumUsedBlocks;
+        if (pPage->NumUsedBlocks == m_NumBlocksInPage)
+        {
+            VERIFY_EXPR(pPage->pFreeList == nullptr);
+            m_AvailablePages.Remove(pPage);
+            m_FullPages.PushFront(pPage);
+            pPage->IsFull = true;
+        }
+
+        Cache.Blocks[Cache.NumBlocks++] = pBlock;
+    }
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::ReturnBlock(void* pBlock)
+{
+    auto* pPage = GetBlockPage(pBlock);
+    VERIFY_EXPR(pPage->NumUsedBlocks > 0);
+
+    *reinterpret_cast<void**>(pBlock) = pPage->pFreeList;
+    pPage->pFreeList                  = pBlock;
+
+    if (pPage->IsFull)
+    {
+        m_FullPages.Remove(pPage);
+        m_AvailablePages.PushFront(pPage);
+        pPage->IsFull = false;
+    }
+
+    --pPage->NumUsedBlocks;
+    if (pPage->NumUsedBlocks == 0)
+    {
+        if (m_NumEmptyPages >= m_NumEmptyPagesToKeep)
+            ReleasePage(pPage);
+        else
+            ++m_NumEmptyPages;
+    }
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::DrainCache(ThreadCache& Cache, Uint32 NumBlocks)
+{
+    VERIFY_EXPR(NumBlocks <= Cache.NumBlocks);
+    for (Uint32 i = 0; i < NumBlocks; ++i)
+        ReturnBlock(Cache.Blocks[--Cache.NumBlocks]);
+}
+
+void* ThreadCachingFixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+    VERIFY(m_BlockSize == AdjustBlockSize(Size), "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    auto& Cache = GetThreadCache();
+
+    ThreadingTools::LockHelper CacheLock(Cache.Flag);
+    if (Cache.NumBlocks == 0)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        RefillCache(Cache, MagazineCapacity / 2);
+    }
+
+    void* pBlock = Cache.Blocks[--Cache.NumBlocks];
+    FillBlockWithDebugPattern(pBlock, AllocatedBlockMemPattern, m_BlockSize);
+    return pBlock;
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    // Validate the block header in debug mode
+    (void)GetBlockPage(Ptr);
+    FillBlockWithDebugPattern(Ptr, DeallocatedBlockMemPattern, m_BlockSize);
+
+    auto& Cache = GetThreadCache();
+
+    ThreadingTools::LockHelper CacheLock(Cache.Flag);
+    if (Cache.NumBlocks == MagazineCapacity)
+    {
+        // Return half of the magazine to the pages so that the next few
+        // allocations and deallocations can be served from the cache.
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        DrainCache(Cache, MagazineCapacity / 2);
+    }
+
+    Cache.Blocks[Cache.NumBlocks++] = Ptr;
+}
+
+void ThreadCachingFixedBlockMemoryAllocator::Trim()
+{
+    for (auto& Cache : m_ThreadCaches)
+    {
+        ThreadingTools::LockHelper  CacheLock(Cache.Flag);
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        DrainCache(Cache, Cache.NumBlocks);
+    }
+}
+
+Uint32 ThreadCachingFixedBlockMemoryAllocator::GetPageCount()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    return m_NumPages;
+}
+
+} // namespace Diligent
@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "ThreadPool.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+struct ThreadPool::TaskQueue
+{
+    std::mutex              Mtx;
+    std::condition_variable CV;
+    std::deque<TaskType>    Tasks;
+    bool                    Stop = false;
+};
+
+ThreadPool::ThreadPool(Uint32 NumThreads) :
+    m_pQueue{std::make_shared<TaskQueue>()}
+{
+    if (NumThreads == 0)
+    {
+        const auto NumHWThreads = std::thread::hardware_concurrency();
+        NumThreads              = NumHWThreads > 1 ? NumHWThreads - 1 : 1;
+    }
+
+    m_Threads.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Threads.emplace_back(&ThreadPool::WorkerThreadFunc, m_pQueue);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_pQueue->Mtx};
+        m_pQueue->Stop = true;
+    }
+    m_pQueue->CV.notify_all();
+
+    bool IsWorkerThread = false;
+    for (auto& Thread : m_Threads)
+    {
+        if (Thread.get_id() == std::this_thread::get_id())
+        {
+            // A worker thread can't join itself. It will finish the remaining
+            // tasks after the current one returns.
+            Thread.detach();
+            IsWorkerThread = true;
+        }
+        else
+        {
+            Thread.join();
+        }
+    }
+
+    VERIFY_EXPR(IsWorkerThread || m_pQueue->Tasks.empty());
+    (void)IsWorkerThread;
+}
+
+void ThreadPool::Enqueue(TaskType&& Task)
+{
+    VERIFY_EXPR(Task);
+    {
+        std::lock_guard<std::mutex> Lock{m_pQueue->Mtx};
+        VERIFY(!m_pQueue->Stop, "Tasks must not be enqueued while the pool is being destroyed");
+        m_pQueue->Tasks.emplace_back(std::move(Task));
+    }
+    m_pQueue->CV.notify_one();
+}
+
+void ThreadPool::WorkerThreadFunc(std::shared_ptr<TaskQueue> pQueue)
+{
+    for (;;)
+    {
+        TaskType Task;
+        {
+            std::unique_lock<std::mutex> Lock{pQueue->Mtx};
+            pQueue->CV.wait(Lock, [&pQueue] { return pQueue->Stop || !pQueue->Tasks.empty(); });
+            // Remaining tasks are finished even when the pool is stopping
+            if (pQueue->Tasks.empty())
+                return;
+
+            Task = std::move(pQueue->Tasks.front());
+            pQueue->Tasks.pop_front();
+        }
+        Task();
+    }
+}
+
+namespace
+{
+
+// State shared by the calling thread and the helper tasks of one ParallelFor call.
+// Helper tasks may start after all iterations have been completed, so the state is
+// reference-counted and does not reference the caller's stack once the call returns.
+struct ParallelForState
+{
+    ParallelForState(Uint32 _NumIterations, const std::function<void(Uint32)>& _Func) :
+        NumIterations{_NumIterations},
+        pFunc{&_Func}
+    {}
+
+    // Executes iterations until none are left
+    void Run()
+    {
+        for (;;)
+        {
+            const auto Iteration = NextIteration.fetch_add(1);
+            if (Iteration >= NumIterations)
+                return;
+
+            (*pFunc)(Iteration);
+
+            if (NumCompleted.fetch_add(1) + 1 == NumIterations)
+            {
+                std::lock_guard<std::mutex> Lock{Mtx};
+                CV.notify_all();
+            }
+        }
+    }
+
+    const Uint32                              NumIterations;
+    const std::function<void(Uint32)>* const pFunc;
+
+    std::atomic<Uint32> NextIteration{0};
+    std::atomic<Uint32> NumCompleted{0};
+
+    std::mutex              Mtx;
+    std::condition_variable CV;
+};
+
+} // namespace
+
+void ThreadPool::ParallelFor(Uint32 NumIterations, const std::function<void(Uint32)>& Func)
+{
+    if (NumIterations == 0)
+        return;
+
+    auto pState = std::make_shared<ParallelForState>(NumIterations, Func);
+
+    const auto NumHelpers = std::min(GetNumThreads(), NumIterations - 1);
+    for (Uint32 i = 0; i < NumHelpers; ++i)
+    {
+        Enqueue([pState]() {
+            pState->Run();
+        });
+    }
+
+    pState->Run();
+
+    std::unique_lock<std::mutex> Lock{pState->Mtx};
+    pState->CV.wait(Lock, [&pState] { return pState->NumCompleted.load() == pState->NumIterations; });
+}
+
+} // namespace Diligent
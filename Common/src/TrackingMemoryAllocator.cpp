@@ -0,0 +1,381 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <map>
+#include "TrackingMemoryAllocator.hpp"
+#include "Errors.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+// Counters of the allocations made by the threads that use the same shard
+struct TrackingMemoryAllocator::CounterShard
+{
+    // Every shard occupies separate cache lines
+    alignas(CacheLineSize) std::atomic<size_t> LiveBytes{0};
+    std::atomic<size_t> PeakLiveBytes{0};
+    std::atomic<size_t> NumLiveAllocations{0};
+    std::atomic<size_t> TotalAllocations{0};
+    std::atomic<size_t> TotalBytes{0};
+};
+
+struct TrackingMemoryAllocator::CallSiteRecord
+{
+    CounterShard Shards[NumCounterShards];
+
+    // Key
+    const char* FileNamePtr = nullptr;
+    Int32       LineNumber  = 0;
+
+    // Copies of the strings that are safe to access when the report is generated
+    char* FileName    = nullptr;
+    char* Description = nullptr;
+
+    // Memory returned by the underlying allocator, which may not be aligned for the record
+    void* pRawMemory = nullptr;
+};
+
+namespace
+{
+
+struct AllocationHeader
+{
+    // Counter shard of the call site that was used by the allocating thread.
+    // The allocation is released to the same shard, so that the live counters of a shard never underflow.
+    void*  pCounters;
+    size_t Size;
+};
+
+// Keep the user memory aligned the same way as memory returned by malloc
+constexpr size_t AllocationHeaderSize = (sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+size_t GetCallSiteHash(const char* FileName, Int32 LineNumber)
+{
+    auto Hash = reinterpret_cast<size_t>(FileName) ^ (static_cast<size_t>(LineNumber) * size_t{0x9E3779B1u});
+    Hash ^= Hash >> 15;
+    Hash *= size_t{0x2C1B3C6Du};
+    Hash ^= Hash >> 12;
+    return Hash;
+}
+
+void AppendJSONString(std::stringstream& ss, const char* Str)
+{
+    ss << '"';
+    for (const char* c = Str; *c != 0; ++c)
+    {
+        switch (*c)
+        {
+            case '"': ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\n': ss << "\\n"; break;
+            case '\r': ss << "\\r"; break;
+            case '\t': ss << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    static const char HexDigits[] = "0123456789abcdef";
+                    ss << "\\u00" << HexDigits[(*c >> 4) & 0xF] << HexDigits[*c & 0xF];
+                }
+                else
+                    ss << *c;
+        }
+    }
+    ss << '"';
+}
+
+// Returns the index of the counter shard used by the calling thread. Threads get consecutive
+// indices in the order they first allocate memory, so up to NumShards threads never share a shard.
+Uint32 GetThreadCounterShard(Uint32 NumShards)
+{
+    static std::atomic<Uint32> NextThreadIndex{0};
+    thread_local const Uint32  ThreadIndex = NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return ThreadIndex % NumShards;
+}
+
+} // namespace
+
+constexpr Uint32 TrackingMemoryAllocator::MaxCallSites;
+constexpr Uint32 TrackingMemoryAllocator::NumCounterShards;
+
+TrackingMemoryAllocator::TrackingMemoryAllocator(IMemoryAllocator& Allocator) :
+    m_Allocator{Allocator}
+{
+    static_assert((MaxCallSites & (MaxCallSites - 1)) == 0, "MaxCallSites must be power of two");
+    for (auto& CallSite : m_CallSites)
+        CallSite.store(nullptr, std::memory_order_relaxed);
+    m_pOverflowCallSite = CreateCallSite("Untracked call sites", "<Overflow>", 0);
+}
+
+TrackingMemoryAllocator::~TrackingMemoryAllocator()
+{
+    for (auto& CallSite : m_CallSites)
+    {
+        if (auto* pRecord = CallSite.load(std::memory_order_acquire))
+            DestroyCallSite(pRecord);
+    }
+    DestroyCallSite(m_pOverflowCallSite);
+}
+
+TrackingMemoryAllocator::CallSiteRecord* TrackingMemoryAllocator::CreateCallSite(const Char* dbgDescription, const char* dbgFileName, Int32 dbgLineNumber)
+{
+    auto CopyString = [&](const char* Str) {
+        if (Str == nullptr)
+            Str = "<Unknown>";
+        const auto Len  = strlen(Str);
+        auto*      pStr = reinterpret_cast<char*>(m_Allocator.Allocate(Len + 1, "Call site string copy", __FILE__, __LINE__));
+        memcpy(pStr, Str, Len + 1);
+        return pStr;
+    };
+
+    auto* pRawMemory     = m_Allocator.Allocate(sizeof(CallSiteRecord) + alignof(CallSiteRecord) - 1, "Call site record", __FILE__, __LINE__);
+    auto* pRecord        = new (AlignUp(pRawMemory, alignof(CallSiteRecord))) CallSiteRecord{};
+    pRecord->pRawMemory  = pRawMemory;
+    pRecord->FileNamePtr = dbgFileName;
+    pRecord->LineNumber  = dbgLineNumber;
+    pRecord->FileName    = CopyString(dbgFileName);
+    pRecord->Description = CopyString(dbgDescription);
+    return pRecord;
+}
+
+void TrackingMemoryAllocator::DestroyCallSite(CallSiteRecord* pRecord)
+{
+    m_Allocator.Free(pRecord->FileName);
+    m_Allocator.Free(pRecord->Description);
+    auto* pRawMemory = pRecord->pRawMemory;
+    pRecord->~CallSiteRecord();
+    m_Allocator.Free(pRawMemory);
+}
+
+TrackingMemoryAllocator::CallSiteRecord* TrackingMemoryAllocator::FindOrCreateCallSite(const Char* dbgDescription, const char* dbgFileName, Int32 dbgLineNumber)
+{
+    const auto Hash = GetCallSiteHash(dbgFileName, dbgLineNumber);
+
+    CallSiteRecord* pNewRecord = nullptr;
+    for (Uint32 Probe = 0; Probe < MaxCallSites; ++Probe)
+    {
+        auto& Slot    = m_CallSites[(Hash + Probe) & (MaxCallSites - 1)];
+        auto* pRecord = Slot.load(std::memory_order_acquire);
+        if (pRecord == nullptr)
+        {
+            // The slot is empty - try to insert the new record. Records are never removed,
+            // so a call site is always found before the first empty slot in its probe sequence.
+            if (pNewRecord == nullptr)
+                pNewRecord = CreateCallSite(dbgDescription, dbgFileName, dbgLineNumber);
+
+            if (Slot.compare_exchange_strong(pRecord, pNewRecord, std::memory_order_acq_rel, std::memory_order_acquire))
+                return pNewRecord;
+
+            // Another thread has occupied the slot. pRecord now contains the record that was inserted.
+        }
+
+        if (pRecord->FileNamePtr == dbgFileName && pRecord->LineNumber == dbgLineNumber)
+        {
+            if (pNewRecord != nullptr)
+                DestroyCallSite(pNewRecord);
+            return pRecord;
+        }
+    }
+
+    if (pNewRecord != nullptr)
+        DestroyCallSite(pNewRecord);
+
+    return m_pOverflowCallSite;
+}
+
+void* TrackingMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    auto* pRawMem = m_Allocator.Allocate(AllocationHeaderSize + Size, dbgDescription, dbgFileName, dbgLineNumber);
+    if (pRawMem == nullptr)
+        return nullptr;
+
+    auto* pCallSite = FindOrCreateCallSite(dbgDescription, dbgFileName, dbgLineNumber);
+    auto& Counters  = pCallSite->Shards[GetThreadCounterShard(NumCounterShards)];
+
+    auto* pHeader      = reinterpret_cast<AllocationHeader*>(pRawMem);
+    pHeader->pCounters = &Counters;
+    pHeader->Size      = Size;
+
+    Counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    Counters.TotalBytes.fetch_add(Size, std::memory_order_relaxed);
+    Counters.NumLiveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    const auto LiveBytes = Counters.LiveBytes.fetch_add(Size, std::memory_order_relaxed) + Size;
+
+    auto PeakLiveBytes = Counters.PeakLiveBytes.load(std::memory_order_relaxed);
+    while (LiveBytes > PeakLiveBytes && !Counters.PeakLiveBytes.compare_exchange_weak(PeakLiveBytes, LiveBytes, std::memory_order_relaxed))
+    {
+    }
+
+    return reinterpret_cast<Uint8*>(pRawMem) + AllocationHeaderSize;
+}
+
+void TrackingMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    auto* pRawMem   = reinterpret_cast<Uint8*>(Ptr) - AllocationHeaderSize;
+    auto* pHeader   = reinterpret_cast<AllocationHeader*>(pRawMem);
+    auto* pCounters = reinterpret_cast<CounterShard*>(pHeader->pCounters);
+    VERIFY(pCounters != nullptr, "Allocation header is corrupted or the memory was not allocated by this allocator");
+
+    pCounters->LiveBytes.fetch_sub(pHeader->Size, std::memory_order_relaxed);
+    pCounters->NumLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+#ifdef DILIGENT_DEBUG
+    pHeader->pCounters = nullptr;
+#endif
+
+    m_Allocator.Free(pRawMem);
+}
+
+std::vector<TrackingMemoryAllocator::CallSiteStats> TrackingMemoryAllocator::GetCallSiteStats() const
+{
+    std::map<std::pair<std::string, Int32>, CallSiteStats> MergedStats;
+
+    auto AddRecord = [&MergedStats](const CallSiteRecord& Record) {
+        size_t TotalAllocations = 0;
+        for (const auto& Shard : Record.Shards)
+            TotalAllocations += Shard.TotalAllocations.load(std::memory_order_relaxed);
+        if (TotalAllocations == 0)
+            return;
+
+        auto& Stats = MergedStats[std::make_pair(std::string{Record.FileName}, Record.LineNumber)];
+        if (Stats.TotalAllocations == 0)
+        {
+            Stats.FileName    = Record.FileName;
+            Stats.LineNumber  = Record.LineNumber;
+            Stats.Description = Record.Description;
+        }
+        for (const auto& Shard : Record.Shards)
+        {
+            Stats.LiveBytes += Shard.LiveBytes.load(std::memory_order_relaxed);
+            Stats.PeakLiveBytes += Shard.PeakLiveBytes.load(std::memory_order_relaxed);
+            Stats.NumLiveAllocations += Shard.NumLiveAllocations.load(std::memory_order_relaxed);
+            Stats.TotalBytes += Shard.TotalBytes.load(std::memory_order_relaxed);
+        }
+        Stats.TotalAllocations += TotalAllocations;
+    };
+
+    for (const auto& CallSite : m_CallSites)
+    {
+        if (const auto* pRecord = CallSite.load(std::memory_order_acquire))
+            AddRecord(*pRecord);
+    }
+    AddRecord(*m_pOverflowCallSite);
+
+    std::vector<CallSiteStats> SortedStats;
+    SortedStats.reserve(MergedStats.size());
+    for (auto& it : MergedStats)
+        SortedStats.emplace_back(std::move(it.second));
+
+    std::sort(SortedStats.begin(), SortedStats.end(),
+              [](const CallSiteStats& lhs, const CallSiteStats& rhs) {
+                  if (lhs.LiveBytes != rhs.LiveBytes)
+                      return lhs.LiveBytes > rhs.LiveBytes;
+                  return lhs.PeakLiveBytes > rhs.PeakLiveBytes;
+              });
+
+    return SortedStats;
+}
+
+size_t TrackingMemoryAllocator::GetLiveBytes() const
+{
+    auto AddRecord = [](size_t LiveBytes, const CallSiteRecord& Record) {
+        for (const auto& Shard : Record.Shards)
+            LiveBytes += Shard.LiveBytes.load(std::memory_order_relaxed);
+        return LiveBytes;
+    };
+
+    size_t LiveBytes = AddRecord(0, *m_pOverflowCallSite);
+    for (const auto& CallSite : m_CallSites)
+    {
+        if (const auto* pRecord = CallSite.load(std::memory_order_acquire))
+            LiveBytes = AddRecord(LiveBytes, *pRecord);
+    }
+    return LiveBytes;
+}
+
+std::string TrackingMemoryAllocator::GetReport(size_t MaxEntries) const
+{
+    const auto Stats = GetCallSiteStats();
+
+    size_t TotalLiveBytes  = 0;
+    size_t TotalLiveAllocs = 0;
+    for (const auto& CallSite : Stats)
+    {
+        TotalLiveBytes += CallSite.LiveBytes;
+        TotalLiveAllocs += CallSite.NumLiveAllocations;
+    }
+
+    std::stringstream ss;
+    ss << "Live memory: " << TotalLiveBytes << " bytes in " << TotalLiveAllocs << " allocations from " << Stats.size() << " call sites\n";
+
+    const auto NumEntries = MaxEntries != 0 ? std::min(MaxEntries, Stats.size()) : Stats.size();
+    for (size_t i = 0; i < NumEntries; ++i)
+    {
+        const auto& CallSite = Stats[i];
+        ss << CallSite.LiveBytes << " bytes (peak " << CallSite.PeakLiveBytes << ") in "
+           << CallSite.NumLiveAllocations << " allocations (total " << CallSite.TotalAllocations << "): "
+           << CallSite.Description << " (" << CallSite.FileName << ", " << CallSite.LineNumber << ")\n";
+    }
+
+    return ss.str();
+}
+
+std::string TrackingMemoryAllocator::GetJSONSnapshot() const
+{
+    const auto Stats = GetCallSiteStats();
+
+    std::stringstream ss;
+    ss << "{\"callSites\":[";
+    for (size_t i = 0; i < Stats.size(); ++i)
+    {
+        const auto& CallSite = Stats[i];
+        if (i > 0)
+            ss << ',';
+        ss << "{\"file\":";
+        AppendJSONString(ss, CallSite.FileName.c_str());
+        ss << ",\"line\":" << CallSite.LineNumber << ",\"description\":";
+        AppendJSONString(ss, CallSite.Description.c_str());
+        ss << ",\"liveBytes\":" << CallSite.LiveBytes
+           << ",\"peakLiveBytes\":" << CallSite.PeakLiveBytes
+           << ",\"liveAllocations\":" << CallSite.NumLiveAllocations
+           << ",\"totalAllocations\":" << CallSite.TotalAllocations
+           << ",\"totalBytes\":" << CallSite.TotalBytes << '}';
+    }
+    ss << "]}";
+
+    return ss.str();
+}
+
+} // namespace Diligent
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include "../../../Primitives/interface/BasicTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -57,4 +58,36 @@ inline float FastSRGBToLinear(float x)
     return x * (x * (x * 0.305306011f + 0.682171111f) + 0.012522878f);
 }
 
+// Batch conversions between sRGB-encoded 8-bit values and linear values.
+// Every value is converted, so alpha channels of RGBA data are treated as sRGB as well.
+//
+// Decoding is table-driven and exact. Encoding clamps the input to [0, 1] and uses a
+// vectorized polynomial approximation whose error is below 0.00045 of the 8-bit step, so
+// the result almost always matches correctly rounded LinearToSRGB().
+
+/// Converts Count sRGB-encoded values to linear 32-bit floats.
+void SRGB8ToLinearFloat(const Uint8* pSRGB, float* pLinear, size_t Count);
+
+/// Converts Count sRGB-encoded values to linear half-precision floats.
+void SRGB8ToLinearHalf(const Uint8* pSRGB, Uint16* pLinear, size_t Count);
+
+/// Converts Count sRGB-encoded values to linear 16-bit normalized values.
+void SRGB8ToLinearUNorm16(const Uint8* pSRGB, Uint16* pLinear, size_t Count);
+
+/// Converts Count linear 32-bit floats to sRGB-encoded values.
+void LinearFloatToSRGB8(const float* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts Count linear half-precision floats to sRGB-encoded values.
+void LinearHalfToSRGB8(const Uint16* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts Count linear 16-bit normalized values to sRGB-encoded values.
+void LinearUNorm16ToSRGB8(const Uint16* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts Count linear 32-bit floats to sRGB-encoded values using FastLinearToSRGB().
+
+/// The result is clamped to [0, 255] and truncated, and matches the per-value computation
+/// static_cast<Uint8>(clamp(FastLinearToSRGB(x) * 255, 0, 255)). Use this function where the
+/// output must stay compatible with the fast approximation, e.g. when generating sRGB mips.
+void FastLinearFloatToSRGB8(const float* pLinear, Uint8* pSRGB, size_t Count);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
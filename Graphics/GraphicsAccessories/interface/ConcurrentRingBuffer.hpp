@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <algorithm>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+
+namespace Diligent
+{
+/// Implementation of a ring buffer that allows allocating space from multiple threads without locks.
+
+/// Positions in the buffer are tracked as monotonically increasing 64-bit values, and a physical offset
+/// is obtained by wrapping the position around the buffer size. Producers reserve space with a single
+/// atomic fetch-add on the head. If the reserved range does not fit at the end of the buffer, the space up to
+/// the end is left as padding and the allocation is moved to the beginning of the buffer.
+///
+/// The heads of completed frames are kept in a fixed-size circular array ordered by fence value,
+/// so that neither finishing nor releasing a frame takes locks or allocates memory.
+///
+/// Allocate() may be called by any number of threads concurrently. FinishCurrentFrame() and
+/// ReleaseCompletedFrames() may run concurrently with Allocate() and with each other, but each of them
+/// must only be called from one thread at a time. Like with RingBuffer, an allocation belongs to the
+/// frame that is finished after Allocate() has returned.
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    /// Maximum number of finished frames that have not been released yet.
+    /// When this number is reached, FinishCurrentFrame() merges the frame with the next one.
+    static constexpr const Uint32 MaxPendingFrames = 64;
+
+    /// \param [in] MaxSize      - Ring buffer size. Must be a multiple of MinAlignment.
+    /// \param [in] MinAlignment - Alignment of every allocation. Requests with alignment not greater
+    ///                            than MinAlignment never require padding. Must be a power of two.
+    ConcurrentRingBuffer(OffsetType MaxSize, OffsetType MinAlignment = 16) noexcept :
+        m_MaxSize{MaxSize},
+        m_MinAlignment{MinAlignment}
+    {
+        VERIFY(IsPowerOfTwo(m_MinAlignment), "Minimum alignment (", m_MinAlignment, ") must be power of 2");
+        VERIFY(m_MaxSize % m_MinAlignment == 0, "Ring buffer size (", m_MaxSize, ") must be a multiple of the minimum alignment (", m_MinAlignment, ")");
+    }
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&) = delete;
+    ConcurrentRingBuffer             (ConcurrentRingBuffer&&)      = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&) = delete;
+    ConcurrentRingBuffer& operator = (ConcurrentRingBuffer&&)      = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(IsEmpty(), "All space in the ring buffer must be released");
+    }
+
+    /// Returns the offset of the allocation or InvalidOffset if there is not enough space in the buffer.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+
+        Size = AlignUp(Size, std::max(Alignment, m_MinAlignment));
+        // All positions are m_MinAlignment-aligned, so this is the largest padding that may be required
+        const auto AlignmentReserve = Alignment > m_MinAlignment ? Alignment - m_MinAlignment : 0;
+        const auto ReserveSize      = Size + AlignmentReserve;
+        if (ReserveSize > m_MaxSize)
+            return InvalidOffset;
+
+        while (true)
+        {
+            // Check the space first so that a full buffer is not advanced needlessly.
+            // The tail only moves forward, so a stale value is conservative.
+            const auto Tail = m_Tail.load(std::memory_order_acquire);
+            if (m_Head.load(std::memory_order_relaxed) + ReserveSize > Tail + m_MaxSize)
+                return InvalidOffset;
+
+            const auto Pos = m_Head.fetch_add(ReserveSize, std::memory_order_relaxed);
+            if (Pos + ReserveSize > m_Tail.load(std::memory_order_acquire) + m_MaxSize)
+            {
+                // Another thread has taken the space between the check and the reservation. The reserved
+                // range cannot be returned as other threads may have reserved space after it, so it becomes
+                // padding that is released with the current frame.
+                return InvalidOffset;
+            }
+
+            //                        Pos % MaxSize
+            //                          |    Offset
+            //                          |    |              MaxSize
+            //                          |    |              |
+            //  [                       .....xxxxxxxxxxxxxxx]
+            //
+            const auto PhysPos = static_cast<OffsetType>(Pos % m_MaxSize);
+            const auto Offset  = AlignUp(PhysPos, Alignment);
+            VERIFY_EXPR(Offset - PhysPos <= AlignmentReserve);
+            if (Offset + Size <= m_MaxSize)
+                return Offset;
+
+            // The range crosses the end of the buffer, so the part up to the end becomes padding.
+            // If no other thread has reserved space after the range, extend it to start
+            // the allocation at the beginning of the buffer:
+            //
+            //  Offset    Head                 Pos % MaxSize    MaxSize
+            //  |         |                         |           |
+            //  [xxxxxxxxx                          ++++++++++++]
+            //
+            const auto LapEnd       = Pos - PhysPos + m_MaxSize;
+            auto       ExpectedHead = Pos + ReserveSize;
+            if (LapEnd + ReserveSize <= m_Tail.load(std::memory_order_acquire) + m_MaxSize &&
+                m_Head.compare_exchange_strong(ExpectedHead, LapEnd + ReserveSize, std::memory_order_relaxed))
+            {
+                return 0;
+            }
+
+            // Otherwise leave the whole range as padding and reserve again.
+            // The next position is in the next lap.
+        }
+    }
+
+    /// FenceValue is the fence value associated with the command list in which the head
+    /// could have been referenced last time
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+        const auto Head = m_Head.load(std::memory_order_relaxed);
+        // Ignore zero-size frames
+        if (Head == m_LastFrameHead)
+            return;
+
+        const auto WriteIdx = m_FrameWriteIdx.load(std::memory_order_relaxed);
+        const auto ReadIdx  = m_FrameReadIdx.load(std::memory_order_acquire);
+#ifdef DILIGENT_DEBUG
+        if (WriteIdx != ReadIdx)
+        {
+            const auto PrevFenceValue = m_FrameHeads[(WriteIdx - 1) % MaxPendingFrames].FenceValue;
+            VERIFY(FenceValue >= PrevFenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", PrevFenceValue, ")");
+        }
+#endif
+        if (WriteIdx - ReadIdx == MaxPendingFrames)
+        {
+            // The array is full. Leave the space in the current frame: it will be released together with
+            // the next frame that is recorded, which is conservative since that frame has a greater fence value.
+            return;
+        }
+
+        auto& FrameHead      = m_FrameHeads[WriteIdx % MaxPendingFrames];
+        FrameHead.FenceValue = FenceValue;
+        FrameHead.Head       = Head;
+        m_FrameWriteIdx.store(WriteIdx + 1, std::memory_order_release);
+        m_LastFrameHead = Head;
+    }
+
+    /// CompletedFenceValue indicates GPU progress
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        auto       ReadIdx  = m_FrameReadIdx.load(std::memory_order_relaxed);
+        const auto WriteIdx = m_FrameWriteIdx.load(std::memory_order_acquire);
+
+        // We can release all heads whose associated fence value is less than or equal to CompletedFenceValue
+        Uint64 NewTail = 0;
+        while (ReadIdx != WriteIdx && m_FrameHeads[ReadIdx % MaxPendingFrames].FenceValue <= CompletedFenceValue)
+        {
+            NewTail = m_FrameHeads[ReadIdx % MaxPendingFrames].Head;
+            ++ReadIdx;
+        }
+
+        if (ReadIdx != m_FrameReadIdx.load(std::memory_order_relaxed))
+        {
+            // The tail never moves back. A frame head may be behind the tail if the tail
+            // has been moved to the next lap while the frame was in flight.
+            if (NewTail > m_Tail.load(std::memory_order_relaxed))
+                m_Tail.store(NewTail, std::memory_order_release);
+            m_FrameReadIdx.store(ReadIdx, std::memory_order_release);
+        }
+
+        // If the buffer is empty, move the head to the start of the next lap so that the entire buffer
+        // is available again, which is what RingBuffer does by resetting the head and the tail to zero.
+        //
+        //                  t,h                                           t,h
+        //  |                |                |   ====>   |                |
+        //
+        auto       Head    = m_Tail.load(std::memory_order_relaxed);
+        const auto PhysPos = static_cast<OffsetType>(Head % m_MaxSize);
+        if (PhysPos != 0)
+        {
+            const auto LapEnd = Head - PhysPos + m_MaxSize;
+            // This fails if another thread has reserved space since the tail was read.
+            // Until the tail is updated, the buffer appears to be partially used, which is conservative.
+            if (m_Head.compare_exchange_strong(Head, LapEnd, std::memory_order_relaxed))
+                m_Tail.store(LapEnd, std::memory_order_release);
+        }
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize()      const { return m_MaxSize; }
+    OffsetType GetMinAlignment() const { return m_MinAlignment; }
+    bool       IsFull()          const { return GetUsedSize() == m_MaxSize; }
+    bool       IsEmpty()         const { return GetUsedSize() == 0; }
+    // clang-format on
+
+    /// Returns the size of the space that has not been released yet, including padding.
+    /// The value is a snapshot and may be outdated by the time it is used.
+    OffsetType GetUsedSize() const
+    {
+        const auto Tail = m_Tail.load(std::memory_order_acquire);
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        // The head may temporarily run past the end of the free space when a reservation fails
+        return static_cast<OffsetType>(std::min(Head - Tail, Uint64{m_MaxSize}));
+    }
+
+private:
+    static constexpr size_t CacheLineSize = 64;
+
+    struct FrameHeadAttribs
+    {
+        Uint64 FenceValue = 0;
+        Uint64 Head       = 0;
+    };
+
+    // The head is modified by every allocating thread, so keep it on its own cache line
+    struct PaddedHead : std::atomic<Uint64>
+    {
+        PaddedHead() noexcept :
+            std::atomic<Uint64>{0}
+        {}
+        Uint8 Padding[CacheLineSize - sizeof(std::atomic<Uint64>)];
+    };
+    PaddedHead m_Head;
+
+    std::atomic<Uint64> m_Tail{0};
+
+    const OffsetType m_MaxSize;
+    const OffsetType m_MinAlignment;
+
+    // Only accessed by FinishCurrentFrame()
+    Uint64 m_LastFrameHead = 0;
+
+    // Single-producer single-consumer queue of frame heads
+    std::atomic<Uint32> m_FrameWriteIdx{0};
+    std::atomic<Uint32> m_FrameReadIdx{0};
+    FrameHeadAttribs    m_FrameHeads[MaxPendingFrames];
+};
+} // namespace Diligent
@@ -33,6 +33,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
@@ -98,7 +99,44 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    /// Region packing policy
+    enum class PackingPolicy : Uint8
+    {
+        /// Free space is recursively split by guillotine cuts into a node hierarchy.
+        /// The best-fitting free region is found using two ordered maps.
+        Guillotine,
+
+        /// Free space is tracked as a list of maximal free rectangles that may overlap.
+        /// Every allocation is placed into the rectangle selected by MaxRectsHeuristic.
+        /// Packs considerably denser than Guillotine under churn at the cost of
+        /// linear scans of the free list.
+        MaxRects
+    };
+
+    /// Heuristic that selects the free rectangle in MaxRects mode
+    enum class MaxRectsHeuristic : Uint8
+    {
+        /// Minimize the shorter leftover side
+        BestShortSideFit,
+
+        /// Minimize the longer leftover side
+        BestLongSideFit,
+
+        /// Minimize the area of the free rectangle
+        BestAreaFit,
+
+        /// Place the region as close to the origin as possible (minimal y, then minimal x)
+        BottomLeft,
+
+        /// Maximize the length of the region perimeter that touches atlas
+        /// boundaries and other allocated regions
+        ContactPoint
+    };
+
+    DynamicAtlasManager(Uint32            Width,
+                        Uint32            Height,
+                        PackingPolicy     Policy    = PackingPolicy::Guillotine,
+                        MaxRectsHeuristic Heuristic = MaxRectsHeuristic::BestShortSideFit);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -111,12 +149,51 @@ public:
     Region Allocate(Uint32 Width, Uint32 Height);
     void   Free(Region&& R);
 
+    /// Region relocation performed by Defragment()
+    struct RegionMove
+    {
+        Region Src;
+        Region Dst;
+    };
+
+    /// Repacks all allocated regions from scratch, largest regions first.
+
+    /// \param [out] Moves - Regions whose location has changed. Regions that stay
+    ///                      in place are not included.
+    ///
+    /// \return     true if all regions have been repacked, and false otherwise.
+    ///             In the latter case the atlas is left unchanged.
+    ///
+    /// \remarks    After the method returns, Src regions are no longer valid and
+    ///             must be replaced with Dst regions by the caller, for example
+    ///             by copying texture data from Src to Dst.
+    bool Defragment(std::vector<RegionMove>& Moves);
+
     Uint32 GetFreeRegionCount() const
     {
+        if (m_Policy == PackingPolicy::MaxRects)
+            return static_cast<Uint32>(m_FreeRects.size());
+
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
 
+    Uint32 GetAllocatedRegionCount() const
+    {
+        return static_cast<Uint32>(m_AllocatedRegions.size());
+    }
+
+    /// Returns the total area of all allocated regions
+    Uint32 GetAllocatedArea() const
+    {
+        return m_AllocatedArea;
+    }
+
+    PackingPolicy GetPackingPolicy() const
+    {
+        return m_Policy;
+    }
+
 
 #define CMP(Member)                 \
     if (R0.Member < R1.Member)      \
@@ -154,11 +231,29 @@ private:
     void DbgVerifyConsistency() const;
     struct Node;
     void DbgRecursiveVerifyConsistency(const Node& N, Uint32& Area) const;
+    void DbgVerifyMaxRectsConsistency() const;
 #endif
 
+    Region AllocateGuillotine(Uint32 Width, Uint32 Height);
+    void   FreeGuillotine(const Region& R);
+
+    Region AllocateMaxRects(Uint32 Width, Uint32 Height);
+    void   FreeMaxRects(const Region& R);
+    void   AddMaxRectsFreeRect(const Region& R, std::vector<Region>* pNewRects);
+    Uint32 ComputeContactScore(const Region& R) const;
+
+    // Discards all allocations and returns the atlas to the initial state
+    void Reset();
+    void Swap(DynamicAtlasManager& Other);
+
     const Uint32 m_Width;
     const Uint32 m_Height;
 
+    const PackingPolicy     m_Policy;
+    const MaxRectsHeuristic m_Heuristic;
+
+    Uint32 m_AllocatedArea = 0;
+
     struct Node
     {
         Region R;
@@ -215,8 +310,11 @@ private:
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
-    // Allocated regions
+    // Allocated regions. In MaxRects mode, there are no nodes and all values are null.
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+
+    // Maximal free rectangles (MaxRects mode only). No rectangle is contained in another one.
+    std::vector<Region> m_FreeRects;
 };
 
 } // namespace Diligent
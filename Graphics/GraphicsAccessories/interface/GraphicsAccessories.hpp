@@ -601,6 +601,20 @@ BufferToTextureCopyInfo GetBufferToTextureCopyInfo(const TextureDesc& TexDesc,
                                                    Uint32             RowStrideAlignment);
 
 
+/// CopyTextureSubresource() flags
+enum COPY_TEXTURE_SUBRESOURCE_FLAGS : Uint32
+{
+    COPY_TEXTURE_SUBRESOURCE_FLAG_NONE = 0u,
+
+    /// The destination is uncached memory, for example write-combined memory of
+    /// a mapped upload buffer. Data is written with non-temporal stores that bypass
+    /// the cache. The flag must not be used when the destination will be read by the CPU.
+    COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED = 1u << 0u
+};
+DEFINE_FLAG_ENUM_OPERATORS(COPY_TEXTURE_SUBRESOURCE_FLAGS);
+
+class ThreadPool;
+
 /// Copies texture subresource data on the CPU.
 
 /// \param [in] SrcSubres      - Source subresource data.
@@ -610,13 +624,21 @@ BufferToTextureCopyInfo GetBufferToTextureCopyInfo(const TextureDesc& TexDesc,
 /// \param [in] pDstData       - Pointer to the destination subresource data.
 /// \param [in] DstRowStride   - Destination subresource row stride, in bytes.
 /// \param [in] DstDepthStride - Destination subresource depth stride, in bytes.
-void CopyTextureSubresource(const TextureSubResData& SrcSubres,
-                            Uint32                   NumRows,
-                            Uint32                   NumDepthSlices,
-                            Uint32                   RowSize,
-                            void*                    pDstData,
-                            Uint32                   DstRowStride,
-                            Uint32                   DstDepthStride);
+/// \param [in] Flags          - Copy flags, see Diligent::COPY_TEXTURE_SUBRESOURCE_FLAGS.
+/// \param [in] pThreadPool    - Optional thread pool. Large subresources are split
+///                              between the pool threads and the calling thread.
+///
+/// \remarks  Rows that are tightly packed in both the source and the destination
+///           are copied as a single block.
+void CopyTextureSubresource(const TextureSubResData&       SrcSubres,
+                            Uint32                         NumRows,
+                            Uint32                         NumDepthSlices,
+                            Uint32                         RowSize,
+                            void*                          pDstData,
+                            Uint32                         DstRowStride,
+                            Uint32                         DstDepthStride,
+                            COPY_TEXTURE_SUBRESOURCE_FLAGS Flags       = COPY_TEXTURE_SUBRESOURCE_FLAG_NONE,
+                            ThreadPool*                    pThreadPool = nullptr);
 
 
 inline String GetShaderResourcePrintName(const char* Name, Uint32 ArraySize, Uint32 ArrayIndex)
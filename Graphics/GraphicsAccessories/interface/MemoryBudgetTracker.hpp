@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::MemoryBudgetTracker class
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Memory usage and budget of a memory heap
+struct MemoryHeapBudgetInfo
+{
+    /// The amount of memory the process can use in the heap, in bytes
+    Uint64 Budget = 0;
+
+    /// The amount of memory currently used by the process in the heap, in bytes
+    Uint64 Usage = 0;
+
+    MemoryHeapBudgetInfo() = default;
+
+    MemoryHeapBudgetInfo(Uint64 _Budget, Uint64 _Usage) :
+        // clang-format off
+        Budget{_Budget},
+        Usage {_Usage }
+    // clang-format on
+    {}
+};
+
+/// Notification that the usage of a heap crossed one of the budget thresholds
+struct MemoryBudgetThresholdEvent
+{
+    /// Identifier of the threshold returned by MemoryBudgetTracker::AddThreshold()
+    Uint32 ThresholdId = 0;
+
+    /// Index of the heap
+    Uint32 HeapIndex = 0;
+
+    /// True if the usage exceeded the threshold, and false if it went back below it
+    bool Exceeded = false;
+
+    /// Heap usage and budget that triggered the event
+    MemoryHeapBudgetInfo Heap;
+};
+
+/// Tracks memory heap usage against a set of budget thresholds and reports threshold crossings.
+
+/// \remarks A threshold is a fraction of the heap budget. The usage of a heap exceeds the threshold
+///          when it is greater than or equal to Threshold * Budget. To avoid generating events every
+///          time the usage fluctuates around the threshold, the usage is only considered to be back
+///          below the threshold when it drops under (Threshold - Hysteresis) * Budget.
+///
+///          The class is not thread-safe.
+class MemoryBudgetTracker
+{
+public:
+    explicit MemoryBudgetTracker(float Hysteresis = 0.02f) noexcept :
+        m_Hysteresis{Hysteresis}
+    {}
+
+    /// Adds a new threshold and returns its identifier. The usage of all heaps is initially
+    /// considered to be below the new threshold, so the next call to Update() reports all heaps
+    /// that already exceed it.
+    Uint32 AddThreshold(float Threshold);
+
+    /// Removes the threshold. Returns false if there is no threshold with the given identifier.
+    bool RemoveThreshold(Uint32 ThresholdId);
+
+    size_t GetNumThresholds() const { return m_Thresholds.size(); }
+
+    /// Updates the usage of all heaps and appends threshold crossing events to the Events vector.
+
+    /// \remarks Heaps whose budget is zero are ignored. If the number of heaps changes, the state of
+    ///          the heaps that are no longer present is discarded.
+    void Update(const MemoryHeapBudgetInfo*              pHeaps,
+                Uint32                                   NumHeaps,
+                std::vector<MemoryBudgetThresholdEvent>& Events);
+
+private:
+    struct ThresholdInfo
+    {
+        Uint32 Id        = 0;
+        float  Threshold = 0;
+
+        // For every heap, indicates if its usage currently exceeds the threshold
+        std::vector<bool> ExceededHeaps;
+    };
+
+    const float m_Hysteresis;
+
+    Uint32                     m_NextThresholdId = 1;
+    std::vector<ThresholdInfo> m_Thresholds;
+};
+
+} // namespace Diligent
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of memory defragmentation planning utilities
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Describes a memory page as seen by the defragmentation planner
+struct DefragmentationPageInfo
+{
+    /// Total size of the page, in bytes
+    Uint64 Size = 0;
+
+    /// Total size of all allocations in the page, in bytes
+    Uint64 UsedSize = 0;
+
+    /// Total size of allocations in the page that can be relocated, in bytes
+    Uint64 MovableSize = 0;
+
+    /// Allocations can only be moved between pages of the same pool (e.g. the same memory type)
+    Uint32 PoolId = 0;
+
+    DefragmentationPageInfo() = default;
+
+    DefragmentationPageInfo(Uint64 _Size, Uint64 _UsedSize, Uint64 _MovableSize, Uint32 _PoolId = 0) :
+        // clang-format off
+        Size       {_Size       },
+        UsedSize   {_UsedSize   },
+        MovableSize{_MovableSize},
+        PoolId     {_PoolId     }
+    // clang-format on
+    {}
+};
+
+/// Memory fragmentation statistics
+struct MemoryFragmentationStats
+{
+    /// Total number of pages
+    Uint32 NumPages = 0;
+
+    /// Number of pages that contain no allocations
+    Uint32 NumEmptyPages = 0;
+
+    /// Number of non-empty pages whose occupancy does not exceed the sparse page threshold
+    Uint32 NumSparsePages = 0;
+
+    /// Total size of all pages, in bytes
+    Uint64 TotalSize = 0;
+
+    /// Total size of all allocations, in bytes
+    Uint64 UsedSize = 0;
+
+    /// Fraction of memory in non-empty pages that is not used by any allocation, in [0, 1] range
+    float Fragmentation = 0;
+};
+
+/// Attributes of the defragmentation plan, see Diligent::PlanMemoryDefragmentation
+struct DefragmentationPlanAttribs
+{
+    /// Pages whose occupancy (UsedSize / Size) does not exceed this value are considered sparse.
+    float SparsePageThreshold = 0.25f;
+
+    /// The maximum number of bytes that can be moved by one defragmentation pass.
+    Uint64 MaxBytesToMove = 0;
+};
+
+/// Memory defragmentation plan, see Diligent::PlanMemoryDefragmentation
+struct DefragmentationPlan
+{
+    /// Indices of the pages whose allocations should be moved to other pages, in processing order
+    std::vector<size_t> PagesToEvacuate;
+
+    /// The total number of bytes to move
+    Uint64 BytesToMove = 0;
+
+    /// Statistics expected once all planned moves are complete and evacuated pages are released
+    MemoryFragmentationStats ProjectedStats;
+};
+
+/// Computes fragmentation statistics for the given set of pages
+MemoryFragmentationStats ComputeMemoryFragmentationStats(const DefragmentationPageInfo* pPages,
+                                                         size_t                         NumPages,
+                                                         float                          SparsePageThreshold);
+
+/// Computes fragmentation statistics expected once the allocations of the given pages are moved
+/// to other pages of the same pool and the evacuated pages are released.
+
+/// \remarks The moved allocations are assumed to be placed into the fullest pages first.
+MemoryFragmentationStats ProjectMemoryFragmentationStats(const DefragmentationPageInfo* pPages,
+                                                         size_t                         NumPages,
+                                                         const std::vector<size_t>&     EvacuatedPages,
+                                                         float                          SparsePageThreshold);
+
+/// Selects the pages whose allocations should be moved to other pages of the same pool.
+
+/// \param [in] pPages   - Pointer to the array of page descriptions.
+/// \param [in] NumPages - The number of pages in the array.
+/// \param [in] Attribs  - Plan attributes, see Diligent::DefragmentationPlanAttribs.
+///
+/// \return Defragmentation plan, see Diligent::DefragmentationPlan.
+///
+/// \remarks Only sparse pages where every allocation is movable are evacuated, starting with
+///          the pages that are cheapest to evacuate. A page is only selected if the remaining pages
+///          of the same pool have enough free space to accommodate its allocations, and the total
+///          number of bytes to move does not exceed DefragmentationPlanAttribs::MaxBytesToMove.
+///          Since the planner does not know the placement of individual allocations, the actual
+///          move may still fail due to fragmentation of the destination pages.
+DefragmentationPlan PlanMemoryDefragmentation(const DefragmentationPageInfo*    pPages,
+                                              size_t                            NumPages,
+                                              const DefragmentationPlanAttribs& Attribs);
+
+} // namespace Diligent
@@ -34,10 +34,13 @@
 /// Implementation of Diligent::ResourceReleaseQueue class
 
 #include <mutex>
-#include <deque>
+#include <atomic>
+#include <new>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
-#include "../../../Common/interface/STDAllocator.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -64,15 +67,24 @@ public:
     //  |__________________________________________________|
     //
 
+    /// Creates a wrapper for the specific resource.
+
+    /// \param [in] Resource      - Resource to wrap.
+    /// \param [in] NumReferences - Number of references to the resource (i.e. the number of
+    ///                              release queues the wrapper will be copied to).
+    /// \param [in] pAllocator    - Optional allocator to allocate the stale resource object from,
+    ///                              for example SizeClassMemoryAllocator. If null, the object is
+    ///                              allocated with the new operator. The allocator must outlive the wrapper.
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
-    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
+    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences, IMemoryAllocator* pAllocator = nullptr)
     {
         VERIFY_EXPR(NumReferences >= 1);
 
         class SpecificStaleResource final : public StaleResourceBase
         {
         public:
-            SpecificStaleResource(ResourceType&& SpecificResource) :
+            SpecificStaleResource(ResourceType&& SpecificResource, IMemoryAllocator* pAllocator) :
+                StaleResourceBase{pAllocator},
                 m_SpecificResource(std::move(SpecificResource))
             {}
 
@@ -85,7 +97,7 @@ public:
 
             virtual void Release() override final
             {
-                delete this;
+                Destroy(this);
             }
 
         private:
@@ -95,7 +107,8 @@ public:
         class SpecificSharedStaleResource final : public StaleResourceBase
         {
         public:
-            SpecificSharedStaleResource(ResourceType&& SpecificResource, Atomics::Long NumReferences) :
+            SpecificSharedStaleResource(ResourceType&& SpecificResource, Atomics::Long NumReferences, IMemoryAllocator* pAllocator) :
+                StaleResourceBase{pAllocator},
                 m_SpecificResource(std::move(SpecificResource))
             {
                 m_RefCounter = NumReferences;
@@ -112,7 +125,7 @@ public:
             {
                 if (Atomics::AtomicDecrement(m_RefCounter) == 0)
                 {
-                    delete this;
+                    Destroy(this);
                 }
             }
 
@@ -123,8 +136,8 @@ public:
 
         return DynamicStaleResourceWrapper{
             NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+                static_cast<StaleResourceBase*>(Construct<SpecificStaleResource>(pAllocator, std::move(Resource), pAllocator)) :
+                static_cast<StaleResourceBase*>(Construct<SpecificSharedStaleResource>(pAllocator, std::move(Resource), NumReferences, pAllocator))};
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
@@ -158,10 +171,42 @@ private:
     class StaleResourceBase
     {
     public:
+        explicit StaleResourceBase(IMemoryAllocator* pAllocator) :
+            m_pAllocator{pAllocator}
+        {}
+
         virtual ~StaleResourceBase() = 0;
         virtual void Release()       = 0;
+
+    protected:
+        static void Destroy(StaleResourceBase* pStaleResource)
+        {
+            auto* const pAllocator = pStaleResource->m_pAllocator;
+            if (pAllocator != nullptr)
+            {
+                pStaleResource->~StaleResourceBase();
+                pAllocator->Free(pStaleResource);
+            }
+            else
+            {
+                delete pStaleResource;
+            }
+        }
+
+    private:
+        IMemoryAllocator* const m_pAllocator;
     };
 
+    template <typename StaleResourceType, typename... ArgsType>
+    static StaleResourceType* Construct(IMemoryAllocator* pAllocator, ArgsType&&... Args)
+    {
+        if (pAllocator == nullptr)
+            return new StaleResourceType{std::forward<ArgsType>(Args)...};
+
+        void* pRawMem = pAllocator->Allocate(sizeof(StaleResourceType), "Stale resource", __FILE__, __LINE__);
+        return new (pRawMem) StaleResourceType{std::forward<ArgsType>(Args)...};
+    }
+
     DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
         m_pStaleResource(pStaleResource)
     {}
@@ -178,7 +223,7 @@ template <typename ResourceType>
 class StaticStaleResourceWrapper
 {
 public:
-    static StaticStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
+    static StaticStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences, IMemoryAllocator* /*pAllocator*/ = nullptr)
     {
         VERIFY(NumReferences == 1, "Number of references must be 1 for StaticStaleResourceWrapper");
         return StaticStaleResourceWrapper{std::move(Resource)};
@@ -216,31 +261,55 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Both queues are built from linked segments of SegmentSize entries. Adding resources to the queue
+/// (SafeReleaseResource, DiscardResource, DiscardResources) is lock-free and may be done from any thread;
+/// only linking a new segment, which happens once per SegmentSize entries, takes a short lock.
+/// DiscardStaleResources() and Purge() consume the queues and are serialized by per-queue consumer
+/// mutexes; they process whole runs of entries at once and destroy the released objects
+/// in bulk. Consumed segments are recycled once no producer can access them, and the queue keeps
+/// all recycled segments, so that steady-state operation does not allocate memory.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
 {
 public:
+    /// The number of entries in one queue segment
+    static constexpr Uint32 SegmentSize = 256;
+
+    /// \param [in] Allocator         - Allocator that is used to allocate queue segments.
+    /// \param [in] pWrapperAllocator - Optional allocator that is used to allocate stale resource objects
+    ///                                 created by the queue, see DynamicStaleResourceWrapper::Create().
+    ///                                 The allocator must outlive the queue.
     // clang-format off
-    ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+    ResourceReleaseQueue(IMemoryAllocator& Allocator, IMemoryAllocator* pWrapperAllocator = nullptr) :
+        m_ReleaseQueue      {Allocator},
+        m_StaleResources    {Allocator},
+        m_pWrapperAllocator {pWrapperAllocator}
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
-        DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DEV_CHECK_ERR(m_StaleResources.GetSize() == 0, "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(m_ReleaseQueue.GetSize() == 0, "Release queue is not empty");
     }
 
+    // clang-format off
+    ResourceReleaseQueue             (const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue             (ResourceReleaseQueue&&)      = delete;
+    ResourceReleaseQueue& operator = (const ResourceReleaseQueue&) = delete;
+    ResourceReleaseQueue& operator = (ResourceReleaseQueue&&)      = delete;
+    // clang-format on
+
     /// Creates a resource wrapper for the specific resource type
     /// \param [in] Resource      - Resource to be released
     /// \param [in] NumReferences - Number of references to the resource
+    /// \param [in] pAllocator    - Optional allocator for the wrapper's internal objects
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
-    static ResourceWrapperType CreateWrapper(ResourceType&& Resource, Atomics::Long NumReferences)
+    static ResourceWrapperType CreateWrapper(ResourceType&& Resource, Atomics::Long NumReferences, IMemoryAllocator* pAllocator = nullptr)
     {
-        return ResourceWrapperType::Create(std::move(Resource), NumReferences);
+        return ResourceWrapperType::Create(std::move(Resource), NumReferences, pAllocator);
     }
 
     /// Moves a resource to the stale resources queue
@@ -249,7 +318,7 @@ public:
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
     void SafeReleaseResource(ResourceType&& Resource, Uint64 NextCommandListNumber)
     {
-        SafeReleaseResource(CreateWrapper(std::move(Resource), 1), NextCommandListNumber);
+        SafeReleaseResource(CreateWrapper(std::move(Resource), 1, m_pWrapperAllocator), NextCommandListNumber);
     }
 
     /// Moves a resource wrapper to the stale resources queue
@@ -257,8 +326,7 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        m_StaleResources.Push(NextCommandListNumber, std::move(Wrapper));
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -266,8 +334,7 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        m_StaleResources.Push(NextCommandListNumber, Wrapper);
     }
 
     /// Adds a resource directly to the release queue
@@ -276,7 +343,7 @@ public:
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
     void DiscardResource(ResourceType&& Resource, Uint64 FenceValue)
     {
-        DiscardResource(CreateWrapper(std::move(Resource), 1), FenceValue);
+        DiscardResource(CreateWrapper(std::move(Resource), 1, m_pWrapperAllocator), FenceValue);
     }
 
     /// Adds a resource wrapper directly to the release queue
@@ -284,8 +351,7 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        m_ReleaseQueue.Push(FenceValue, std::move(Wrapper));
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -293,8 +359,7 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        m_ReleaseQueue.Push(FenceValue, Wrapper);
     }
 
     /// Adds multiple resources directly to the release queue
@@ -303,11 +368,10 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
+        ResourceType Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            m_ReleaseQueue.Push(FenceValue, CreateWrapper(std::move(Resource), 1, m_pWrapperAllocator));
         }
     }
 
@@ -322,19 +386,11 @@ public:
     {
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
-        {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
-            {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
-            }
-            else
-                break;
-        }
+        m_StaleResources.PopWhile(SubmittedCmdBuffNumber,
+                                  [&](ResourceWrapperType& Wrapper) //
+                                  {
+                                      m_ReleaseQueue.Push(FenceValue, std::move(Wrapper));
+                                  });
     }
 
 
@@ -343,39 +399,349 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
-
         // Release all objects whose associated fence value is at most CompletedFenceValue
         // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
-        {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
-        }
+        // PopWhile() destroys the wrappers of the removed entries.
+        m_ReleaseQueue.PopWhile(CompletedFenceValue, [](ResourceWrapperType&) {});
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_StaleResources.GetSize();
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        return m_ReleaseQueue.GetSize();
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    // Multiple-producer single-consumer queue of (Value, Wrapper) pairs stored in a linked list of segments.
+    //
+    //   m_pHead                                          m_pTail
+    //      |                                                |
+    //   ___V______________         __________________     ___V______________
+    //  | xxxx|RRRRRRRRRRRR| -----> |RRRRRRRRRRRRRRRRR| ---> |RRRRRRR|W|      |
+    //  |_____|____________|        |_________________|      |_______|_|______|
+    //        ^                                                       ^
+    //     ReadPos                                                WritePos
+    //
+    // Producers reserve an entry by atomically incrementing WritePos of the tail segment and mark it ready
+    // once the wrapper is constructed. When the tail segment is full, the producer links a new segment and
+    // advances the tail. The consumer reads ready entries starting from ReadPos of the head segment.
+    //
+    // Segments consumed by the consumer are retired, but a producer may still hold a pointer to a retired
+    // segment that it read from m_pTail. Retired segments are recycled after a grace period:
+    // * Every producer registers itself in the counter of the current epoch parity before reading m_pTail,
+    //   and unregisters when it is done.
+    // * Once m_pTail has moved past all retired segments, the consumer starts a grace period by advancing
+    //   the epoch. Producers that started after that can only see segments that are still in the queue.
+    // * When the counters of the previous epoch parity drop to zero, all producers that could have
+    //   seen the retired segments have finished, and the segments are moved to the spare list.
+    // The consumer never waits for the producers: the grace period is checked on every PopWhile() call.
+    class SegmentedQueue
+    {
+    public:
+        explicit SegmentedQueue(IMemoryAllocator& Allocator) :
+            m_Allocator{Allocator}
+        {
+            m_pHead = CreateSegment();
+            m_pTail.store(m_pHead);
+        }
+
+        ~SegmentedQueue()
+        {
+            // Destroy remaining objects
+            PopWhile(std::numeric_limits<Uint64>::max(), [](ResourceWrapperType&) {});
+            VERIFY(!HasActiveProducers(0) && !HasActiveProducers(1), "Destroying the queue while there are active producers");
+
+            DestroySegment(m_pHead);
+            DestroySegments(m_pRetiredSegments);
+            DestroySegments(m_pGracePeriodSegments);
+            DestroySegments(m_pSpareSegments);
+        }
+
+        // clang-format off
+        SegmentedQueue             (const SegmentedQueue&) = delete;
+        SegmentedQueue             (SegmentedQueue&&)      = delete;
+        SegmentedQueue& operator = (const SegmentedQueue&) = delete;
+        SegmentedQueue& operator = (SegmentedQueue&&)      = delete;
+        // clang-format on
+
+        // Adds the wrapper to the queue. The method is lock-free and may be called from any thread,
+        // except for linking a new segment, which takes a short lock to get a spare segment.
+        template <typename WrapperArgType>
+        void Push(Uint64 Value, WrapperArgType&& Wrapper)
+        {
+            auto&        ProducerSlot = GetProducerSlot();
+            const Uint32 Parity       = m_Epoch.load() & 1u;
+            ProducerSlot.NumActive[Parity].fetch_add(1);
+
+            for (;;)
+            {
+                Segment*     pTail = m_pTail.load();
+                const Uint32 Pos   = pTail->WritePos.fetch_add(1, std::memory_order_relaxed);
+                if (Pos < SegmentSize)
+                {
+                    auto& Entry = pTail->Entries[Pos];
+                    Entry.Value = Value;
+                    new (&Entry.Storage) ResourceWrapperType{std::forward<WrapperArgType>(Wrapper)};
+                    Entry.Ready.store(true, std::memory_order_release);
+                    break;
+                }
+
+                // The segment is full - link the next one if no other producer has done this yet
+                Segment* pNext = pTail->pNext.load();
+                if (pNext == nullptr)
+                {
+                    Segment* pNewSegment = AcquireSegment();
+                    if (pTail->pNext.compare_exchange_strong(pNext, pNewSegment))
+                        pNext = pNewSegment;
+                    else
+                        RecycleSegments(pNewSegment); // pNext now contains the segment linked by another producer
+                }
+                // Advance the tail. If the CAS fails, another producer has already advanced it.
+                m_pTail.compare_exchange_strong(pTail, pNext);
+            }
+
+            ProducerSlot.NumActive[Parity].fetch_sub(1);
+        }
+
+        // Removes consecutive ready entries whose value is less than or equal to MaxValue.
+        // Handler(ResourceWrapperType& Wrapper) is called for every removed entry and may move the wrapper
+        // out; the wrapper is destroyed right after that. Calls to PopWhile are serialized by the consumer mutex.
+        template <typename HandlerType>
+        void PopWhile(Uint64 MaxValue, HandlerType&& Handler)
+        {
+            std::lock_guard<std::mutex> Lock{m_ConsumerMtx};
+            for (;;)
+            {
+                Segment* const pHead = m_pHead;
+
+                const Uint32 Start = pHead->ReadPos;
+                Uint32       End   = Start;
+                while (End < SegmentSize)
+                {
+                    const auto& Entry = pHead->Entries[End];
+                    if (!Entry.Ready.load(std::memory_order_acquire) || Entry.Value > MaxValue)
+                        break;
+                    ++End;
+                }
+
+                // Process the whole run of entries at once
+                for (Uint32 i = Start; i < End; ++i)
+                {
+                    auto& Entry    = pHead->Entries[i];
+                    auto* pWrapper = reinterpret_cast<ResourceWrapperType*>(&Entry.Storage);
+                    Handler(*pWrapper);
+                    pWrapper->~ResourceWrapperType();
+                    Entry.Ready.store(false, std::memory_order_relaxed);
+                }
+                pHead->ReadPos = End;
+
+                if (End < SegmentSize)
+                    break;
+
+                // The head segment is completely consumed
+                Segment* const pNext = pHead->pNext.load();
+                if (pNext == nullptr)
+                    break; // The head segment is also the tail segment
+
+                m_pHead            = pNext;
+                pHead->pNextInList = m_pRetiredSegments;
+                m_pRetiredSegments = pHead;
+            }
+
+            ReclaimRetiredSegments();
+        }
+
+        // Returns the number of entries in the queue, including the entries that are being added.
+        // The size is computed from the segments rather than maintained by a counter to keep
+        // Push() free from additional atomic operations.
+        size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> Lock{m_ConsumerMtx};
+
+            size_t Size = 0;
+            for (const Segment* pSegment = m_pHead; pSegment != nullptr; pSegment = pSegment->pNext.load())
+                Size += std::min(pSegment->WritePos.load(std::memory_order_relaxed), SegmentSize) - pSegment->ReadPos;
+            return Size;
+        }
+
+    private:
+        struct QueueEntry
+        {
+            Uint64 Value = 0;
+
+            typename std::aligned_storage<sizeof(ResourceWrapperType), alignof(ResourceWrapperType)>::type Storage;
+
+            std::atomic<bool> Ready{false};
+        };
+
+        struct Segment
+        {
+            std::atomic<Uint32>   WritePos{0};
+            Uint32                ReadPos = 0;
+            std::atomic<Segment*> pNext{nullptr};
+
+            // Link in the list of retired or spare segments
+            Segment* pNextInList = nullptr;
+
+            QueueEntry Entries[SegmentSize];
+        };
+
+        // Producers are tracked by per-thread slots that occupy separate cache lines,
+        // so that producers running on different threads do not contend for the counters.
+        // Every slot has one counter for each epoch parity.
+        static constexpr size_t CacheLineSize = 64;
+        struct ProducerSlotType
+        {
+            std::atomic<Uint32> NumActive[2] = {};
+            Uint8               Padding[CacheLineSize - sizeof(std::atomic<Uint32>) * 2];
+        };
+        static_assert(sizeof(ProducerSlotType) == CacheLineSize, "Counters of different slots must be a cache line apart");
+        static constexpr Uint32 NumProducerSlots = 8;
+
+        ProducerSlotType& GetProducerSlot()
+        {
+            // Every thread is assigned a slot index once, the same index is used for all queues.
+            static std::atomic<Uint32> NextThreadSlot{0};
+            static thread_local Uint32 ThreadSlot = NextThreadSlot.fetch_add(1);
+            return m_ProducerSlots[ThreadSlot % NumProducerSlots];
+        }
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+        bool HasActiveProducers(Uint32 Parity) const
+        {
+            // A producer never leaves the counter of its parity at zero while it is active, so the counters
+            // do not need to be read atomically as a whole.
+            for (const auto& Slot : m_ProducerSlots)
+            {
+                if (Slot.NumActive[Parity].load() != 0)
+                    return true;
+            }
+            return false;
+        }
+
+        Segment* CreateSegment()
+        {
+            void* pRawMem = m_Allocator.Allocate(sizeof(Segment), "Release queue segment", __FILE__, __LINE__);
+            return new (pRawMem) Segment{};
+        }
+
+        void DestroySegment(Segment* pSegment)
+        {
+            pSegment->~Segment();
+            m_Allocator.Free(pSegment);
+        }
+
+        void DestroySegments(Segment* pList)
+        {
+            while (pList != nullptr)
+            {
+                Segment* pSegment = pList;
+                pList             = pSegment->pNextInList;
+                DestroySegment(pSegment);
+            }
+        }
+
+        Segment* AcquireSegment()
+        {
+            Segment* pSegment = nullptr;
+            {
+                std::lock_guard<std::mutex> Lock{m_SpareSegmentsMtx};
+                pSegment = m_pSpareSegments;
+                if (pSegment != nullptr)
+                    m_pSpareSegments = pSegment->pNextInList;
+            }
+            if (pSegment == nullptr)
+                return CreateSegment();
+
+            pSegment->WritePos.store(0, std::memory_order_relaxed);
+            pSegment->ReadPos = 0;
+            pSegment->pNext.store(nullptr, std::memory_order_relaxed);
+            pSegment->pNextInList = nullptr;
+            return pSegment;
+        }
+
+        // Moves the list of segments that are not used by anyone to the spare list
+        void RecycleSegments(Segment* pList)
+        {
+            Segment* pLast = pList;
+            while (pLast->pNextInList != nullptr)
+                pLast = pLast->pNextInList;
+
+            std::lock_guard<std::mutex> Lock{m_SpareSegmentsMtx};
+            pLast->pNextInList = m_pSpareSegments;
+            m_pSpareSegments   = pList;
+        }
+
+        // Requires the consumer mutex to be locked
+        void ReclaimRetiredSegments()
+        {
+            if (m_pGracePeriodSegments != nullptr)
+            {
+                // Producers that may have seen the segments are still active
+                if (HasActiveProducers(m_GracePeriodParity))
+                    return;
+
+                RecycleSegments(m_pGracePeriodSegments);
+                m_pGracePeriodSegments = nullptr;
+            }
+
+            if (m_pRetiredSegments == nullptr)
+                return;
+
+            // Wait until the tail has moved past the retired segments, so that producers
+            // that start after this point can't see them.
+            const Segment* pTail = m_pTail.load();
+            for (const Segment* pSegment = m_pRetiredSegments; pSegment != nullptr; pSegment = pSegment->pNextInList)
+            {
+                if (pSegment == pTail)
+                    return;
+            }
+
+            // Start the grace period. Only producers that registered in the counters of the previous
+            // epoch parity may still use the retired segments.
+            m_pGracePeriodSegments = m_pRetiredSegments;
+            m_pRetiredSegments     = nullptr;
+            m_GracePeriodParity    = m_Epoch.fetch_add(1) & 1u;
+
+            if (!HasActiveProducers(m_GracePeriodParity))
+            {
+                RecycleSegments(m_pGracePeriodSegments);
+                m_pGracePeriodSegments = nullptr;
+            }
+        }
+
+        IMemoryAllocator& m_Allocator;
+
+        // Consumer-side state
+        mutable std::mutex m_ConsumerMtx;
+        Segment*           m_pHead                = nullptr;
+        Segment*           m_pRetiredSegments     = nullptr; // Segments that wait for a grace period to start
+        Segment*           m_pGracePeriodSegments = nullptr; // Segments that wait for the grace period to end
+        Uint32             m_GracePeriodParity    = 0;
+
+        std::atomic<Segment*> m_pTail{nullptr};
+        std::atomic<Uint32>   m_Epoch{0};
+
+        // Segments that are ready to be linked to the queue. The list is only accessed when a segment
+        // is filled up or after a grace period, so the lock is rarely contended.
+        std::mutex m_SpareSegmentsMtx;
+        Segment*   m_pSpareSegments = nullptr;
+
+        ProducerSlotType m_ProducerSlots[NumProducerSlots];
+    };
+
+    SegmentedQueue m_ReleaseQueue;
+    SegmentedQueue m_StaleResources;
+
+    IMemoryAllocator* const m_pWrapperAllocator;
 };
 
+template <typename ResourceWrapperType>
+constexpr Uint32 ResourceReleaseQueue<ResourceWrapperType>::SegmentSize;
+
 } // namespace Diligent
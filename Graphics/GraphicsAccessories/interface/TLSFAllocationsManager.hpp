@@ -0,0 +1,671 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) implementation of the variable-size allocations manager
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+// The class implements the same contract as VariableSizeAllocationsManager (Allocate(), Free(Offset, Size), Extend()),
+// but all operations take bounded constant time regardless of the number of free blocks.
+//
+// Free blocks are segregated into size classes. The first-level index selects the power-of-two range of the
+// block size, the second-level index linearly subdivides that range into SLIndexCount classes. Every class has its
+// own doubly-linked list of free blocks, and two levels of bitmaps record which lists are non-empty, so that a
+// suitable list is found with two bit scans:
+//
+//      m_FLBitmap     0 0 1 0 1 ...           FL = 2: [64, 128)    FL = 4: [256, 512)
+//                         |   |
+//      m_SLBitmaps[FL]    |   '-> 0 1 0 ...   SL = 1: [264, 272) --> Block --> Block
+//                         '-----> 1 0 0 ...   SL = 0: [64, 66)   --> Block
+//
+// Both free and allocated blocks live in a single flat pool and reference each other by index. Physically adjacent
+// blocks are linked to each other, which makes coalescing on Free() constant-time. Allocated blocks are
+// registered in an open-addressing hash table keyed by the block offset, so that Free() only needs the offset
+// and does not require any per-allocation bookkeeping from the caller.
+//
+// Unlike VariableSizeAllocationsManager, the region passed to Free() must exactly match one
+// previously returned by Allocate(); partial deallocations are not supported.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        m_Blocks(STD_ALLOCATOR_RAW_MEM(BlockInfo, Allocator, "Allocator for vector<BlockInfo>")),
+        m_AllocatedBlocks(STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")),
+        m_MaxSize(MaxSize),
+        m_FreeSize(MaxSize)
+    {
+        for (auto& FLHeads : m_FreeListHeads)
+        {
+            for (auto& Head : FLHeads)
+                Head = InvalidIndex;
+        }
+
+        m_AllocatedBlocks.resize(size_t{1} << MinTableSizeLog2, Uint32{InvalidIndex});
+        m_TableSizeLog2 = MinTableSizeLog2;
+
+        if (m_MaxSize > 0)
+        {
+            // Insert single maximum-size block
+            m_LastBlock = CreateBlock(0, m_MaxSize, InvalidIndex);
+            InsertFreeBlock(m_LastBlock);
+        }
+        ResetCurrAlignment();
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (!m_Blocks.empty())
+        {
+            VERIFY(m_NumAllocatedBlocks == 0, m_NumAllocatedBlocks, " allocation(s) have not been released");
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            VERIFY(m_FreeSize == m_MaxSize, "Free size (", m_FreeSize, ") is expected to be ", m_MaxSize);
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept :
+        m_Blocks            {std::move(rhs.m_Blocks)         },
+        m_AllocatedBlocks   {std::move(rhs.m_AllocatedBlocks)},
+        m_TableSizeLog2     {rhs.m_TableSizeLog2     },
+        m_NumAllocatedBlocks{rhs.m_NumAllocatedBlocks},
+        m_FirstUnusedBlock  {rhs.m_FirstUnusedBlock  },
+        m_LastBlock         {rhs.m_LastBlock         },
+        m_NumFreeBlocks     {rhs.m_NumFreeBlocks     },
+        m_FLBitmap          {rhs.m_FLBitmap          },
+        m_MaxSize           {rhs.m_MaxSize           },
+        m_FreeSize          {rhs.m_FreeSize          },
+        m_CurrAlignment     {rhs.m_CurrAlignment     }
+    {
+        // clang-format on
+        memcpy(m_SLBitmaps, rhs.m_SLBitmaps, sizeof(m_SLBitmaps));
+        memcpy(m_FreeListHeads, rhs.m_FreeListHeads, sizeof(m_FreeListHeads));
+
+        rhs.m_NumAllocatedBlocks = 0;
+        rhs.m_FirstUnusedBlock   = InvalidIndex;
+        rhs.m_LastBlock          = InvalidIndex;
+        rhs.m_NumFreeBlocks      = 0;
+        rhs.m_FLBitmap           = 0;
+        rhs.m_MaxSize            = 0;
+        rhs.m_FreeSize           = 0;
+        rhs.m_CurrAlignment      = 0;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager& operator = (TLSFAllocationsManager&& rhs) = default;
+    TLSFAllocationsManager             (const TLSFAllocationsManager&) = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&) = delete;
+    // clang-format on
+
+    // Offset returned by Allocate() may not be aligned, but the size of the allocation
+    // is sufficient to properly align it
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        // All free block offsets are m_CurrAlignment-aligned, so at most Alignment - m_CurrAlignment
+        // bytes may be required to align the allocation
+        const auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+
+        const auto BlockIdx = FindFreeBlock(Size + AlignmentReserve);
+        if (BlockIdx == InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        RemoveFreeBlock(BlockIdx);
+
+        //          Block.Offset
+        //        |                                  |
+        //        |<-----------Block.Size----------->|
+        //        |<---AdjustedSize--->|<--NewSize-->|
+        //        |                    |
+        //      Offset             NewOffset
+        //
+        const auto Offset = m_Blocks[BlockIdx].Offset;
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+        const auto AlignedOffset = AlignUp(Offset, Alignment);
+        const auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve && AdjustedSize <= m_Blocks[BlockIdx].Size);
+        const auto NewSize = m_Blocks[BlockIdx].Size - AdjustedSize;
+        if (NewSize > 0)
+        {
+            m_Blocks[BlockIdx].Size = AdjustedSize;
+            // Note that CreateBlock() may reallocate the pool
+            const auto RemainderIdx = CreateBlock(Offset + AdjustedSize, NewSize, BlockIdx);
+            InsertFreeBlock(RemainderIdx);
+        }
+        RegisterAllocatedBlock(BlockIdx);
+
+        m_FreeSize -= AdjustedSize;
+
+        if ((Size & (m_CurrAlignment - 1)) != 0)
+        {
+            if (IsPowerOfTwo(Size))
+            {
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = std::min(m_CurrAlignment, Alignment);
+            }
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        VERIFY_EXPR(allocation.IsValid());
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
+
+        auto BlockIdx = UnregisterAllocatedBlock(Offset);
+        if (BlockIdx == InvalidIndex)
+        {
+            UNEXPECTED("There is no allocation at offset ", Offset);
+            return;
+        }
+        VERIFY(m_Blocks[BlockIdx].Size == Size, "The size of the allocation at offset ", Offset, " is ", m_Blocks[BlockIdx].Size,
+               ", while ", Size, " is being released. Partial deallocations are not supported.");
+        m_FreeSize += m_Blocks[BlockIdx].Size;
+
+        //   PrevBlock.Offset           Offset            NextBlock.Offset
+        //     |                          |                    |
+        //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        const auto PrevIdx = m_Blocks[BlockIdx].PrevPhys;
+        if (PrevIdx != InvalidIndex && m_Blocks[PrevIdx].IsFree)
+        {
+            RemoveFreeBlock(PrevIdx);
+            MergeWithNextBlock(PrevIdx);
+            BlockIdx = PrevIdx;
+        }
+
+        const auto NextIdx = m_Blocks[BlockIdx].NextPhys;
+        if (NextIdx != InvalidIndex && m_Blocks[NextIdx].IsFree)
+        {
+            RemoveFreeBlock(NextIdx);
+            MergeWithNextBlock(BlockIdx);
+        }
+
+        InsertFreeBlock(BlockIdx);
+
+        if (IsEmpty())
+        {
+            // Reset current alignment
+            VERIFY_EXPR(GetNumFreeBlocks() == 1);
+            ResetCurrAlignment();
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        if (m_LastBlock != InvalidIndex && m_Blocks[m_LastBlock].IsFree)
+        {
+            // Extend the last block
+            RemoveFreeBlock(m_LastBlock);
+            m_Blocks[m_LastBlock].Size += ExtraSize;
+            InsertFreeBlock(m_LastBlock);
+        }
+        else
+        {
+            const auto NewBlockIdx = CreateBlock(m_MaxSize, ExtraSize, m_LastBlock);
+            InsertFreeBlock(NewBlockIdx);
+        }
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    // The number of second-level classes per power-of-two range is 2^SLIndexLog2
+    static constexpr Uint32 SLIndexLog2  = 5;
+    static constexpr Uint32 SLIndexCount = 1u << SLIndexLog2;
+    // Sizes below SLIndexCount are all mapped to the first first-level range
+    static constexpr Uint32 FLIndexCount = sizeof(OffsetType) * 8 - SLIndexLog2 + 1;
+    static_assert(FLIndexCount <= 64, "First-level bitmap is too small");
+
+    static constexpr Uint32 MinTableSizeLog2 = 4;
+
+    struct BlockInfo
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Physically adjacent blocks
+        Uint32 PrevPhys = InvalidIndex;
+        Uint32 NextPhys = InvalidIndex;
+
+        // Neighbors in the free list of the block's size class.
+        // For unused pool entries, NextFree references the next unused entry.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+
+        bool IsFree = false;
+    };
+
+    static void MapSize(OffsetType Size, Uint32& FLIndex, Uint32& SLIndex)
+    {
+        if (Size < SLIndexCount)
+        {
+            FLIndex = 0;
+            SLIndex = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+            FLIndex        = MSB - SLIndexLog2 + 1;
+            SLIndex        = static_cast<Uint32>(Size >> (MSB - SLIndexLog2)) ^ SLIndexCount;
+        }
+        VERIFY_EXPR(FLIndex < FLIndexCount && SLIndex < SLIndexCount);
+    }
+
+    Uint32 FindFreeBlock(OffsetType Size) const
+    {
+        if (Size > m_FreeSize)
+            return InvalidIndex;
+
+        // Round the size up to the next class boundary so that any block
+        // in the first non-empty class at or above it is large enough.
+        auto RoundedSize = Size;
+        if (Size >= SLIndexCount)
+            RoundedSize += (OffsetType{1} << (PlatformMisc::GetMSB(static_cast<Uint64>(Size)) - SLIndexLog2)) - 1;
+
+        Uint32 FLIndex = 0, SLIndex = 0;
+        MapSize(RoundedSize, FLIndex, SLIndex);
+
+        auto SLMap = m_SLBitmaps[FLIndex] & (~Uint32{0} << SLIndex);
+        if (SLMap == 0)
+        {
+            const auto FLMap = FLIndex + 1 < FLIndexCount ? m_FLBitmap & (~Uint64{0} << (FLIndex + 1)) : 0;
+            if (FLMap != 0)
+            {
+                FLIndex = PlatformMisc::GetLSB(FLMap);
+                SLMap   = m_SLBitmaps[FLIndex];
+                VERIFY_EXPR(SLMap != 0);
+            }
+        }
+        if (SLMap != 0)
+        {
+            SLIndex = PlatformMisc::GetLSB(SLMap);
+            VERIFY_EXPR(m_FreeListHeads[FLIndex][SLIndex] != InvalidIndex && m_Blocks[m_FreeListHeads[FLIndex][SLIndex]].Size >= Size);
+            return m_FreeListHeads[FLIndex][SLIndex];
+        }
+
+        // There are no blocks in larger classes, but the class of the size itself may still
+        // contain a block that is large enough. This only happens when the manager is nearly
+        // exhausted, and is the only path that is not constant-time.
+        MapSize(Size, FLIndex, SLIndex);
+        for (auto BlockIdx = m_FreeListHeads[FLIndex][SLIndex]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+        {
+            if (m_Blocks[BlockIdx].Size >= Size)
+                return BlockIdx;
+        }
+
+        return InvalidIndex;
+    }
+
+    void InsertFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+        VERIFY_EXPR(!Block.IsFree && Block.Size > 0);
+
+        Uint32 FLIndex = 0, SLIndex = 0;
+        MapSize(Block.Size, FLIndex, SLIndex);
+
+        auto& Head     = m_FreeListHeads[FLIndex][SLIndex];
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = Head;
+        if (Head != InvalidIndex)
+            m_Blocks[Head].PrevFree = BlockIdx;
+        Head         = BlockIdx;
+        Block.IsFree = true;
+
+        m_FLBitmap |= Uint64{1} << FLIndex;
+        m_SLBitmaps[FLIndex] |= 1u << SLIndex;
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Block.IsFree);
+
+        Uint32 FLIndex = 0, SLIndex = 0;
+        MapSize(Block.Size, FLIndex, SLIndex);
+
+        if (Block.PrevFree != InvalidIndex)
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        auto& Head = m_FreeListHeads[FLIndex][SLIndex];
+        if (Head == BlockIdx)
+        {
+            Head = Block.NextFree;
+            if (Head == InvalidIndex)
+            {
+                m_SLBitmaps[FLIndex] &= ~(1u << SLIndex);
+                if (m_SLBitmaps[FLIndex] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FLIndex);
+            }
+        }
+
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = InvalidIndex;
+        Block.IsFree   = false;
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+    }
+
+    // Creates a new block and inserts it into the physical list after PrevPhys
+    Uint32 CreateBlock(OffsetType Offset, OffsetType Size, Uint32 PrevPhys)
+    {
+        Uint32 BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+            m_Blocks[BlockIdx] = BlockInfo{};
+        }
+        else
+        {
+            VERIFY(m_Blocks.size() < InvalidIndex, "Too many blocks");
+            BlockIdx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        auto& Block    = m_Blocks[BlockIdx];
+        Block.Offset   = Offset;
+        Block.Size     = Size;
+        Block.PrevPhys = PrevPhys;
+        if (PrevPhys != InvalidIndex)
+        {
+            Block.NextPhys              = m_Blocks[PrevPhys].NextPhys;
+            m_Blocks[PrevPhys].NextPhys = BlockIdx;
+        }
+        if (Block.NextPhys != InvalidIndex)
+            m_Blocks[Block.NextPhys].PrevPhys = BlockIdx;
+        else
+            m_LastBlock = BlockIdx;
+
+        return BlockIdx;
+    }
+
+    // Absorbs the next physical block into the given one and returns the next block to the pool
+    void MergeWithNextBlock(Uint32 BlockIdx)
+    {
+        auto&      Block   = m_Blocks[BlockIdx];
+        const auto NextIdx = Block.NextPhys;
+        auto&      Next    = m_Blocks[NextIdx];
+        VERIFY_EXPR(!Block.IsFree && !Next.IsFree);
+        VERIFY_EXPR(Block.Offset + Block.Size == Next.Offset);
+
+        Block.Size += Next.Size;
+        Block.NextPhys = Next.NextPhys;
+        if (Block.NextPhys != InvalidIndex)
+            m_Blocks[Block.NextPhys].PrevPhys = BlockIdx;
+        else
+            m_LastBlock = BlockIdx;
+
+        Next               = BlockInfo{};
+        Next.NextFree      = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = NextIdx;
+    }
+
+    size_t GetTableSlot(OffsetType Offset) const
+    {
+        // Fibonacci hashing
+        return static_cast<size_t>((static_cast<Uint64>(Offset) * Uint64{0x9E3779B97F4A7C15}) >> (64 - m_TableSizeLog2));
+    }
+
+    void RegisterAllocatedBlock(Uint32 BlockIdx)
+    {
+        // Keep the load factor at or below 1/2
+        if ((m_NumAllocatedBlocks + 1) * 2 > m_AllocatedBlocks.size())
+        {
+            auto OldTable = std::move(m_AllocatedBlocks);
+            m_AllocatedBlocks.assign(OldTable.size() * 2, Uint32{InvalidIndex});
+            ++m_TableSizeLog2;
+            for (auto Idx : OldTable)
+            {
+                if (Idx != InvalidIndex)
+                    InsertIntoTable(Idx);
+            }
+        }
+
+        InsertIntoTable(BlockIdx);
+        ++m_NumAllocatedBlocks;
+    }
+
+    void InsertIntoTable(Uint32 BlockIdx)
+    {
+        const auto Mask = m_AllocatedBlocks.size() - 1;
+
+        auto Slot = GetTableSlot(m_Blocks[BlockIdx].Offset);
+        while (m_AllocatedBlocks[Slot] != InvalidIndex)
+        {
+            VERIFY(m_Blocks[m_AllocatedBlocks[Slot]].Offset != m_Blocks[BlockIdx].Offset, "Offset ", m_Blocks[BlockIdx].Offset, " is already allocated");
+            Slot = (Slot + 1) & Mask;
+        }
+        m_AllocatedBlocks[Slot] = BlockIdx;
+    }
+
+    Uint32 UnregisterAllocatedBlock(OffsetType Offset)
+    {
+        const auto Mask = m_AllocatedBlocks.size() - 1;
+
+        auto Slot = GetTableSlot(Offset);
+        while (m_AllocatedBlocks[Slot] != InvalidIndex && m_Blocks[m_AllocatedBlocks[Slot]].Offset != Offset)
+            Slot = (Slot + 1) & Mask;
+
+        const auto BlockIdx = m_AllocatedBlocks[Slot];
+        if (BlockIdx == InvalidIndex)
+            return InvalidIndex;
+
+        // Backward-shift deletion: move every subsequent entry of the probe sequence
+        // whose home slot is not in (Hole, Slot] into the hole.
+        auto Hole = Slot;
+        while (true)
+        {
+            Slot = (Slot + 1) & Mask;
+
+            const auto Idx = m_AllocatedBlocks[Slot];
+            if (Idx == InvalidIndex)
+                break;
+
+            const auto Home = GetTableSlot(m_Blocks[Idx].Offset);
+            if (((Slot > Hole) && (Home <= Hole || Home > Slot)) ||
+                ((Slot < Hole) && (Home <= Hole && Home > Slot)))
+            {
+                m_AllocatedBlocks[Hole] = Idx;
+                Hole                    = Slot;
+            }
+        }
+        m_AllocatedBlocks[Hole] = InvalidIndex;
+
+        VERIFY_EXPR(m_NumAllocatedBlocks > 0);
+        --m_NumAllocatedBlocks;
+        return BlockIdx;
+    }
+
+    void ResetCurrAlignment()
+    {
+        for (m_CurrAlignment = 1; m_CurrAlignment * 2 <= m_MaxSize; m_CurrAlignment *= 2)
+        {}
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyList()
+    {
+        VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+
+        auto FirstBlock = m_LastBlock;
+        while (FirstBlock != InvalidIndex && m_Blocks[FirstBlock].PrevPhys != InvalidIndex)
+            FirstBlock = m_Blocks[FirstBlock].PrevPhys;
+
+        OffsetType CurrOffset     = 0;
+        OffsetType TotalFreeSize  = 0;
+        size_t     NumFreeBlocks  = 0;
+        size_t     NumAllocations = 0;
+        for (auto BlockIdx = FirstBlock; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextPhys)
+        {
+            const auto& Block = m_Blocks[BlockIdx];
+            VERIFY(Block.Offset == CurrOffset, "Block offset (", Block.Offset, ") does not match the end of the previous block (", CurrOffset, ")");
+            VERIFY_EXPR(Block.Size > 0);
+            VERIFY_EXPR(Block.NextPhys == InvalidIndex || m_Blocks[Block.NextPhys].PrevPhys == BlockIdx);
+            CurrOffset += Block.Size;
+            if (Block.IsFree)
+            {
+                VERIFY((Block.Offset & (m_CurrAlignment - 1)) == 0, "Block offset (", Block.Offset, ") is not ", m_CurrAlignment, "-aligned");
+                VERIFY(Block.PrevPhys == InvalidIndex || !m_Blocks[Block.PrevPhys].IsFree, "Unmerged adjacent blocks detected");
+                TotalFreeSize += Block.Size;
+                ++NumFreeBlocks;
+            }
+            else
+            {
+                ++NumAllocations;
+            }
+        }
+        VERIFY_EXPR(CurrOffset == m_MaxSize);
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+        VERIFY_EXPR(NumFreeBlocks == m_NumFreeBlocks);
+        VERIFY_EXPR(NumAllocations == m_NumAllocatedBlocks);
+
+        size_t NumListedBlocks = 0;
+        for (Uint32 fl = 0; fl < FLIndexCount; ++fl)
+        {
+            VERIFY_EXPR(((m_FLBitmap >> fl) & 1) == (m_SLBitmaps[fl] != 0 ? 1 : 0));
+            for (Uint32 sl = 0; sl < SLIndexCount; ++sl)
+            {
+                VERIFY_EXPR(((m_SLBitmaps[fl] >> sl) & 1) == (m_FreeListHeads[fl][sl] != InvalidIndex ? 1 : 0));
+                for (auto BlockIdx = m_FreeListHeads[fl][sl]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+                    VERIFY_EXPR(Block.IsFree);
+                    Uint32 FLIndex = 0, SLIndex = 0;
+                    MapSize(Block.Size, FLIndex, SLIndex);
+                    VERIFY(FLIndex == fl && SLIndex == sl, "Block is in the wrong free list");
+                    ++NumListedBlocks;
+                }
+            }
+        }
+        VERIFY_EXPR(NumListedBlocks == m_NumFreeBlocks);
+
+        size_t NumRegisteredBlocks = 0;
+        for (auto BlockIdx : m_AllocatedBlocks)
+        {
+            if (BlockIdx != InvalidIndex)
+            {
+                VERIFY_EXPR(!m_Blocks[BlockIdx].IsFree);
+                ++NumRegisteredBlocks;
+            }
+        }
+        VERIFY_EXPR(NumRegisteredBlocks == m_NumAllocatedBlocks);
+    }
+#endif
+
+    // Pool of all blocks, both free and allocated
+    std::vector<BlockInfo, STDAllocatorRawMem<BlockInfo>> m_Blocks;
+
+    // Open-addressing hash table that maps allocation offsets to block indices
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_AllocatedBlocks;
+
+    Uint32 m_TableSizeLog2      = 0;
+    size_t m_NumAllocatedBlocks = 0;
+
+    // Head of the list of unused pool entries
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    // The block with the largest offset
+    Uint32 m_LastBlock     = InvalidIndex;
+    size_t m_NumFreeBlocks = 0;
+
+    Uint64 m_FLBitmap                                    = 0;
+    Uint32 m_SLBitmaps[FLIndexCount]                     = {};
+    Uint32 m_FreeListHeads[FLIndexCount][SLIndexCount] = {};
+
+    OffsetType m_MaxSize       = 0;
+    OffsetType m_FreeSize      = 0;
+    OffsetType m_CurrAlignment = 0;
+    // When adding new members, do not forget to update move ctor
+};
+} // namespace Diligent
@@ -364,6 +364,13 @@ public:
         return m_FreeBlocksByOffset.size();
     }
 
+    // Returns the size of the largest free block. Note that due to alignment requirements,
+    // an allocation of this size is not guaranteed to succeed.
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
+    }
+
     void Extend(size_t ExtraSize)
     {
         size_t NewBlockOffset = m_MaxSize;
@@ -28,6 +28,8 @@
 #include <array>
 #include <algorithm>
 #include "ColorConversion.h"
+#include "Float16.hpp"
+#include "SIMDHelpers.hpp"
 
 namespace Diligent
 {
@@ -62,7 +64,9 @@ public:
     {
         for (Uint32 i = 0; i < m_ToLinear.size(); ++i)
         {
-            m_ToLinear[i] = SRGBToLinear(static_cast<float>(i) / 255.f);
+            m_ToLinear[i]        = SRGBToLinear(static_cast<float>(i) / 255.f);
+            m_ToLinearHalf[i]    = Float32ToFloat16(m_ToLinear[i]);
+            m_ToLinearUNorm16[i] = static_cast<Uint16>(m_ToLinear[i] * 65535.f + 0.5f);
         }
     }
 
@@ -71,10 +75,227 @@ public:
         return m_ToLinear[x];
     }
 
+    const float* GetFloatTable() const
+    {
+        return m_ToLinear.data();
+    }
+
+    const Uint16* GetHalfTable() const
+    {
+        return m_ToLinearHalf.data();
+    }
+
+    const Uint16* GetUNorm16Table() const
+    {
+        return m_ToLinearUNorm16.data();
+    }
+
+    static const SRGBToLinearMap& Get()
+    {
+        static const SRGBToLinearMap map;
+        return map;
+    }
+
 private:
-    std::array<float, 256> m_ToLinear;
+    std::array<float, 256>  m_ToLinear;
+    std::array<Uint16, 256> m_ToLinearHalf;
+    std::array<Uint16, 256> m_ToLinearUNorm16;
 };
 
+template <typename DstType>
+void SRGB8ToLinearTableLookup(const Uint8* pSRGB, DstType* pLinear, size_t Count, const DstType* pTable)
+{
+    // Decoding is a plain table lookup. Without a fast gather instruction there is
+    // nothing to vectorize, so the loop is only unrolled.
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+    {
+        pLinear[i + 0] = pTable[pSRGB[i + 0]];
+        pLinear[i + 1] = pTable[pSRGB[i + 1]];
+        pLinear[i + 2] = pTable[pSRGB[i + 2]];
+        pLinear[i + 3] = pTable[pSRGB[i + 3]];
+    }
+    for (; i < Count; ++i)
+        pLinear[i] = pTable[pSRGB[i]];
+}
+
+// Polynomial approximation of 1.055 * x^(1/2.4) - 0.055 in terms of u = x^(1/4)
+// for x in [0.0031308, 1]. The maximum error is 0.00045 of the 8-bit step.
+// clang-format off
+constexpr float SRGBEncodeC0 = -5.964178193e-02f;
+constexpr float SRGBEncodeC1 =  1.407771746e-01f;
+constexpr float SRGBEncodeC2 =  1.360223691e+00f;
+constexpr float SRGBEncodeC3 = -8.389606980e-01f;
+constexpr float SRGBEncodeC4 =  6.387633935e-01f;
+constexpr float SRGBEncodeC5 = -3.060329293e-01f;
+constexpr float SRGBEncodeC6 =  6.487223368e-02f;
+// clang-format on
+
+inline Uint8 LinearToSRGB8(float x)
+{
+    // The comparisons are written so that NaN is mapped to zero
+    x = x > 0.f ? x : 0.f;
+    x = x < 1.f ? x : 1.f;
+
+    float SRGB;
+    if (x <= 0.0031308f)
+    {
+        SRGB = x * 12.92f;
+    }
+    else
+    {
+        const float u = std::sqrt(std::sqrt(x));
+
+        SRGB = SRGBEncodeC6;
+        SRGB = SRGB * u + SRGBEncodeC5;
+        SRGB = SRGB * u + SRGBEncodeC4;
+        SRGB = SRGB * u + SRGBEncodeC3;
+        SRGB = SRGB * u + SRGBEncodeC2;
+        SRGB = SRGB * u + SRGBEncodeC1;
+        SRGB = SRGB * u + SRGBEncodeC0;
+    }
+    return static_cast<Uint8>(SRGB * 255.f + 0.5f);
+}
+
+inline Uint8 FastLinearToSRGB8(float x)
+{
+    // Clamping on both ends is essential because fast SRGB math is imprecise
+    const float SRGB = std::min(std::max(FastLinearToSRGB(x) * 255.f, 0.f), 255.f);
+    return static_cast<Uint8>(SRGB);
+}
+
+#if DILIGENT_SSE2_SUPPORTED
+
+inline __m128 LinearToSRGB_SSE2(__m128 x)
+{
+    // _mm_max_ps returns the second operand if either one is NaN
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+    const __m128 u = _mm_sqrt_ps(_mm_sqrt_ps(x));
+
+    __m128 Curve = _mm_set1_ps(SRGBEncodeC6);
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC5));
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC4));
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC3));
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC2));
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC1));
+    Curve        = _mm_add_ps(_mm_mul_ps(Curve, u), _mm_set1_ps(SRGBEncodeC0));
+
+    const __m128 Linear   = _mm_mul_ps(x, _mm_set1_ps(12.92f));
+    const __m128 IsLinear = _mm_cmple_ps(x, _mm_set1_ps(0.0031308f));
+    const __m128 SRGB     = _mm_or_ps(_mm_and_ps(IsLinear, Linear), _mm_andnot_ps(IsLinear, Curve));
+
+    return _mm_add_ps(_mm_mul_ps(SRGB, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f));
+}
+
+void LinearFloatToSRGB8_SSE2(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128i v0 = _mm_cvttps_epi32(LinearToSRGB_SSE2(_mm_loadu_ps(pLinear + i)));
+        const __m128i v1 = _mm_cvttps_epi32(LinearToSRGB_SSE2(_mm_loadu_ps(pLinear + i + 4)));
+
+        const __m128i v16 = _mm_packs_epi32(v0, v1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pSRGB + i), _mm_packus_epi16(v16, v16));
+    }
+    for (; i < Count; ++i)
+        pSRGB[i] = LinearToSRGB8(pLinear[i]);
+}
+
+// Evaluates FastLinearToSRGB(x) * 255 clamped to [0, 255] with the same sequence of operations
+inline __m128 FastLinearToSRGB_SSE2(__m128 x)
+{
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128 Root  = _mm_sqrt_ps(_mm_and_ps(_mm_sub_ps(x, _mm_set1_ps(0.00228f)), AbsMask));
+    const __m128 Curve = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.13005f), Root), _mm_mul_ps(_mm_set1_ps(0.13448f), x)), _mm_set1_ps(0.005719f));
+
+    const __m128 Linear   = _mm_mul_ps(_mm_set1_ps(12.92f), x);
+    const __m128 IsLinear = _mm_cmplt_ps(x, _mm_set1_ps(0.0031308f));
+    const __m128 SRGB     = _mm_or_ps(_mm_and_ps(IsLinear, Linear), _mm_andnot_ps(IsLinear, Curve));
+
+    return _mm_min_ps(_mm_max_ps(_mm_mul_ps(SRGB, _mm_set1_ps(255.f)), _mm_setzero_ps()), _mm_set1_ps(255.f));
+}
+
+void FastLinearFloatToSRGB8_SSE2(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128i v0 = _mm_cvttps_epi32(FastLinearToSRGB_SSE2(_mm_loadu_ps(pLinear + i)));
+        const __m128i v1 = _mm_cvttps_epi32(FastLinearToSRGB_SSE2(_mm_loadu_ps(pLinear + i + 4)));
+
+        const __m128i v16 = _mm_packs_epi32(v0, v1);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pSRGB + i), _mm_packus_epi16(v16, v16));
+    }
+    for (; i < Count; ++i)
+        pSRGB[i] = FastLinearToSRGB8(pLinear[i]);
+}
+
+#elif DILIGENT_NEON_SUPPORTED
+
+inline uint32x4_t LinearToSRGB_NEON(float32x4_t x)
+{
+    // vmaxnmq/vminnmq return the number if the other operand is NaN
+    x = vminnmq_f32(vmaxnmq_f32(x, vdupq_n_f32(0.f)), vdupq_n_f32(1.f));
+
+    const float32x4_t u = vsqrtq_f32(vsqrtq_f32(x));
+
+    float32x4_t Curve = vdupq_n_f32(SRGBEncodeC6);
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC5));
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC4));
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC3));
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC2));
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC1));
+    Curve             = vaddq_f32(vmulq_f32(Curve, u), vdupq_n_f32(SRGBEncodeC0));
+
+    const uint32x4_t  IsLinear = vcleq_f32(x, vdupq_n_f32(0.0031308f));
+    const float32x4_t SRGB     = vbslq_f32(IsLinear, vmulq_n_f32(x, 12.92f), Curve);
+
+    return vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(SRGB, 255.f), vdupq_n_f32(0.5f)));
+}
+
+void LinearFloatToSRGB8_NEON(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        const uint16x4_t v0 = vmovn_u32(LinearToSRGB_NEON(vld1q_f32(pLinear + i)));
+        const uint16x4_t v1 = vmovn_u32(LinearToSRGB_NEON(vld1q_f32(pLinear + i + 4)));
+        vst1_u8(pSRGB + i, vmovn_u16(vcombine_u16(v0, v1)));
+    }
+    for (; i < Count; ++i)
+        pSRGB[i] = LinearToSRGB8(pLinear[i]);
+}
+
+// Evaluates FastLinearToSRGB(x) * 255 clamped to [0, 255] with the same sequence of operations
+inline uint32x4_t FastLinearToSRGB_NEON(float32x4_t x)
+{
+    const float32x4_t Root  = vsqrtq_f32(vabsq_f32(vsubq_f32(x, vdupq_n_f32(0.00228f))));
+    const float32x4_t Curve = vaddq_f32(vsubq_f32(vmulq_n_f32(Root, 1.13005f), vmulq_n_f32(x, 0.13448f)), vdupq_n_f32(0.005719f));
+
+    const uint32x4_t  IsLinear = vcltq_f32(x, vdupq_n_f32(0.0031308f));
+    const float32x4_t SRGB     = vbslq_f32(IsLinear, vmulq_n_f32(x, 12.92f), Curve);
+
+    return vcvtq_u32_f32(vminq_f32(vmaxq_f32(vmulq_n_f32(SRGB, 255.f), vdupq_n_f32(0.f)), vdupq_n_f32(255.f)));
+}
+
+void FastLinearFloatToSRGB8_NEON(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        const uint16x4_t v0 = vmovn_u32(FastLinearToSRGB_NEON(vld1q_f32(pLinear + i)));
+        const uint16x4_t v1 = vmovn_u32(FastLinearToSRGB_NEON(vld1q_f32(pLinear + i + 4)));
+        vst1_u8(pSRGB + i, vmovn_u16(vcombine_u16(v0, v1)));
+    }
+    for (; i < Count; ++i)
+        pSRGB[i] = FastLinearToSRGB8(pLinear[i]);
+}
+
+#endif
+
 } // namespace
 
 float LinearToSRGB(Uint8 x)
@@ -85,8 +306,74 @@ float LinearToSRGB(Uint8 x)
 
 float SRGBToLinear(Uint8 x)
 {
-    static const SRGBToLinearMap map;
-    return map[x];
+    return SRGBToLinearMap::Get()[x];
+}
+
+void SRGB8ToLinearFloat(const Uint8* pSRGB, float* pLinear, size_t Count)
+{
+    SRGB8ToLinearTableLookup(pSRGB, pLinear, Count, SRGBToLinearMap::Get().GetFloatTable());
+}
+
+void SRGB8ToLinearHalf(const Uint8* pSRGB, Uint16* pLinear, size_t Count)
+{
+    SRGB8ToLinearTableLookup(pSRGB, pLinear, Count, SRGBToLinearMap::Get().GetHalfTable());
+}
+
+void SRGB8ToLinearUNorm16(const Uint8* pSRGB, Uint16* pLinear, size_t Count)
+{
+    SRGB8ToLinearTableLookup(pSRGB, pLinear, Count, SRGBToLinearMap::Get().GetUNorm16Table());
+}
+
+void LinearFloatToSRGB8(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+#if DILIGENT_SSE2_SUPPORTED
+    LinearFloatToSRGB8_SSE2(pLinear, pSRGB, Count);
+#elif DILIGENT_NEON_SUPPORTED
+    LinearFloatToSRGB8_NEON(pLinear, pSRGB, Count);
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pSRGB[i] = LinearToSRGB8(pLinear[i]);
+#endif
+}
+
+void FastLinearFloatToSRGB8(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+#if DILIGENT_SSE2_SUPPORTED
+    FastLinearFloatToSRGB8_SSE2(pLinear, pSRGB, Count);
+#elif DILIGENT_NEON_SUPPORTED
+    FastLinearFloatToSRGB8_NEON(pLinear, pSRGB, Count);
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pSRGB[i] = FastLinearToSRGB8(pLinear[i]);
+#endif
+}
+
+// Half and 16-bit normalized values are converted to floats in small
+// chunks on the stack and then encoded by the vectorized float path.
+static constexpr size_t SRGBEncodeChunkSize = 256;
+
+void LinearHalfToSRGB8(const Uint16* pLinear, Uint8* pSRGB, size_t Count)
+{
+    float Chunk[SRGBEncodeChunkSize];
+    for (size_t i = 0; i < Count; i += SRGBEncodeChunkSize)
+    {
+        const auto ChunkSize = std::min(Count - i, SRGBEncodeChunkSize);
+        for (size_t j = 0; j < ChunkSize; ++j)
+            Chunk[j] = Float16ToFloat32(pLinear[i + j]);
+        LinearFloatToSRGB8(Chunk, pSRGB + i, ChunkSize);
+    }
+}
+
+void LinearUNorm16ToSRGB8(const Uint16* pLinear, Uint8* pSRGB, size_t Count)
+{
+    float Chunk[SRGBEncodeChunkSize];
+    for (size_t i = 0; i < Count; i += SRGBEncodeChunkSize)
+    {
+        const auto ChunkSize = std::min(Count - i, SRGBEncodeChunkSize);
+        for (size_t j = 0; j < ChunkSize; ++j)
+            Chunk[j] = static_cast<float>(pLinear[i + j]) * (1.f / 65535.f);
+        LinearFloatToSRGB8(Chunk, pSRGB + i, ChunkSize);
+    }
 }
 
 } // namespace Diligent
@@ -27,6 +27,7 @@
 
 #include "DynamicAtlasManager.hpp"
 
+#include <algorithm>
 #include <climits>
 
 #include "AdvancedMath.hpp"
@@ -110,18 +111,64 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
-    m_Width{Width},
-    m_Height{Height}
+DynamicAtlasManager::DynamicAtlasManager(Uint32            Width,
+                                         Uint32            Height,
+                                         PackingPolicy     Policy,
+                                         MaxRectsHeuristic Heuristic) :
+    // clang-format off
+    m_Width    {Width    },
+    m_Height   {Height   },
+    m_Policy   {Policy   },
+    m_Heuristic{Heuristic}
+// clang-format on
 {
-    m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    Reset();
+}
+
+void DynamicAtlasManager::Reset()
+{
+    m_FreeRegionsByWidth.clear();
+    m_FreeRegionsByHeight.clear();
+    m_AllocatedRegions.clear();
+    m_FreeRects.clear();
+    m_AllocatedArea = 0;
+
+    if (m_Policy == PackingPolicy::MaxRects)
+    {
+        m_Root.reset();
+        m_FreeRects.emplace_back(0, 0, m_Width, m_Height);
+    }
+    else
+    {
+        m_Root.reset(new Node);
+        m_Root->R = Region{0, 0, m_Width, m_Height};
+        RegisterNode(*m_Root);
+    }
+}
+
+void DynamicAtlasManager::Swap(DynamicAtlasManager& Other)
+{
+    VERIFY_EXPR(m_Width == Other.m_Width && m_Height == Other.m_Height && m_Policy == Other.m_Policy);
+    std::swap(m_Root, Other.m_Root);
+    std::swap(m_FreeRegionsByWidth, Other.m_FreeRegionsByWidth);
+    std::swap(m_FreeRegionsByHeight, Other.m_FreeRegionsByHeight);
+    std::swap(m_AllocatedRegions, Other.m_AllocatedRegions);
+    std::swap(m_FreeRects, Other.m_FreeRects);
+    std::swap(m_AllocatedArea, Other.m_AllocatedArea);
 }
 
 
 DynamicAtlasManager::~DynamicAtlasManager()
 {
-    if (m_Root)
+    if (m_Policy == PackingPolicy::MaxRects)
+    {
+#if DILIGENT_DEBUG
+        DbgVerifyMaxRectsConsistency();
+#endif
+        DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
+        VERIFY_EXPR(m_FreeRects.empty() || m_FreeRects.size() == 1);
+    }
+    else if (m_Root)
     {
 #if DILIGENT_DEBUG
         DbgVerifyConsistency();
@@ -182,6 +229,45 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    VERIFY_EXPR(Width > 0 && Height > 0);
+
+    auto R = m_Policy == PackingPolicy::MaxRects ?
+        AllocateMaxRects(Width, Height) :
+        AllocateGuillotine(Width, Height);
+
+    if (!R.IsEmpty())
+        m_AllocatedArea += R.width * R.height;
+
+    return R;
+}
+
+void DynamicAtlasManager::Free(Region&& R)
+{
+#if DILIGENT_DEBUG
+    DbgVerifyRegion(R);
+#endif
+
+    auto node_it = m_AllocatedRegions.find(R);
+    if (node_it == m_AllocatedRegions.end())
+    {
+        UNEXPECTED("Unable to find region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") among allocated regions. Have you ever allocated it?");
+        return;
+    }
+
+    VERIFY_EXPR(m_AllocatedArea >= R.width * R.height);
+    m_AllocatedArea -= R.width * R.height;
+
+    if (m_Policy == PackingPolicy::MaxRects)
+        FreeMaxRects(R);
+    else
+        FreeGuillotine(R);
+
+    R = InvalidRegion;
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateGuillotine(Uint32 Width, Uint32 Height)
 {
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
@@ -323,19 +409,10 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
 }
 
 
-void DynamicAtlasManager::Free(Region&& R)
+void DynamicAtlasManager::FreeGuillotine(const Region& R)
 {
-#if DILIGENT_DEBUG
-    DbgVerifyRegion(R);
-#endif
-
     auto node_it = m_AllocatedRegions.find(R);
-    if (node_it == m_AllocatedRegions.end())
-    {
-        UNEXPECTED("Unable to find region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") among allocated regions. Have you ever allocated it?");
-        return;
-    }
-
+    VERIFY_EXPR(node_it != m_AllocatedRegions.end());
     VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
     auto* N = node_it->second;
     VERIFY_EXPR(N->IsAllocated && !N->HasChildren());
@@ -359,8 +436,311 @@ void DynamicAtlasManager::Free(Region&& R)
 #if DILIGENT_DEBUG
     DbgVerifyConsistency();
 #endif
+}
 
-    R = InvalidRegion;
+
+static bool RegionsOverlap(const DynamicAtlasManager::Region& R0, const DynamicAtlasManager::Region& R1)
+{
+    // clang-format off
+    return R0.x < R1.x + R1.width  && R1.x < R0.x + R0.width &&
+           R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+    // clang-format on
+}
+
+static bool RegionContains(const DynamicAtlasManager::Region& Outer, const DynamicAtlasManager::Region& Inner)
+{
+    // clang-format off
+    return Inner.x >= Outer.x && Inner.x + Inner.width  <= Outer.x + Outer.width &&
+           Inner.y >= Outer.y && Inner.y + Inner.height <= Outer.y + Outer.height;
+    // clang-format on
+}
+
+// Returns the length of the intersection of segments [a0, a1) and [b0, b1)
+static Uint32 SegmentOverlap(Uint32 a0, Uint32 a1, Uint32 b0, Uint32 b1)
+{
+    const auto Start = std::max(a0, b0);
+    const auto End   = std::min(a1, b1);
+    return End > Start ? End - Start : 0;
+}
+
+Uint32 DynamicAtlasManager::ComputeContactScore(const Region& R) const
+{
+    Uint32 Score = 0;
+    if (R.x == 0 || R.x + R.width == m_Width)
+        Score += R.height;
+    if (R.y == 0 || R.y + R.height == m_Height)
+        Score += R.width;
+
+    for (const auto& it : m_AllocatedRegions)
+    {
+        const auto& A = it.first;
+        if (A.x + A.width == R.x || A.x == R.x + R.width)
+            Score += SegmentOverlap(A.y, A.y + A.height, R.y, R.y + R.height);
+        if (A.y + A.height == R.y || A.y == R.y + R.height)
+            Score += SegmentOverlap(A.x, A.x + A.width, R.x, R.x + R.width);
+    }
+
+    return Score;
+}
+
+void DynamicAtlasManager::AddMaxRectsFreeRect(const Region& R, std::vector<Region>* pNewRects)
+{
+    VERIFY_EXPR(!R.IsEmpty());
+
+    for (const auto& F : m_FreeRects)
+    {
+        if (RegionContains(F, R))
+            return;
+    }
+
+    // Remove all rectangles that are covered by the new one
+    m_FreeRects.erase(std::remove_if(m_FreeRects.begin(), m_FreeRects.end(),
+                                     [&R](const Region& F) //
+                                     {
+                                         return RegionContains(R, F);
+                                     }),
+                      m_FreeRects.end());
+
+    m_FreeRects.push_back(R);
+    if (pNewRects != nullptr)
+        pNewRects->push_back(R);
+}
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateMaxRects(Uint32 Width, Uint32 Height)
+{
+    // Scores are compared lexicographically, smaller is better
+    size_t BestIdx    = m_FreeRects.size();
+    Uint32 BestScore1 = UINT_MAX;
+    Uint32 BestScore2 = UINT_MAX;
+    VERIFY_EXPR(Width <= m_Width && Height <= m_Height);
+    for (size_t i = 0; i < m_FreeRects.size(); ++i)
+    {
+        const auto& F = m_FreeRects[i];
+        if (F.width < Width || F.height < Height)
+            continue;
+
+        const auto LeftoverW = F.width - Width;
+        const auto LeftoverH = F.height - Height;
+
+        Uint32 Score1 = 0;
+        Uint32 Score2 = 0;
+        switch (m_Heuristic)
+        {
+            case MaxRectsHeuristic::BestShortSideFit:
+                Score1 = std::min(LeftoverW, LeftoverH);
+                Score2 = std::max(LeftoverW, LeftoverH);
+                break;
+
+            case MaxRectsHeuristic::BestLongSideFit:
+                Score1 = std::max(LeftoverW, LeftoverH);
+                Score2 = std::min(LeftoverW, LeftoverH);
+                break;
+
+            case MaxRectsHeuristic::BestAreaFit:
+                Score1 = F.width * F.height - Width * Height;
+                Score2 = std::min(LeftoverW, LeftoverH);
+                break;
+
+            case MaxRectsHeuristic::BottomLeft:
+                Score1 = F.y + Height;
+                Score2 = F.x;
+                break;
+
+            case MaxRectsHeuristic::ContactPoint:
+                Score1 = UINT_MAX - ComputeContactScore(Region{F.x, F.y, Width, Height});
+                Score2 = F.y + Height;
+                break;
+
+            default:
+                UNEXPECTED("Unexpected heuristic");
+        }
+
+        bool IsBetter = false;
+        if (Score1 != BestScore1)
+            IsBetter = Score1 < BestScore1;
+        else if (Score2 != BestScore2)
+            IsBetter = Score2 < BestScore2;
+        else if (BestIdx < m_FreeRects.size())
+        {
+            // Break ties by the bottom-left rule to keep regions packed towards the origin
+            const auto& Best = m_FreeRects[BestIdx];
+            IsBetter         = F.y < Best.y || (F.y == Best.y && F.x < Best.x);
+        }
+
+        if (IsBetter)
+        {
+            BestIdx    = i;
+            BestScore1 = Score1;
+            BestScore2 = Score2;
+        }
+    }
+
+    if (BestIdx == m_FreeRects.size())
+        return Region{};
+
+    const Region R{m_FreeRects[BestIdx].x, m_FreeRects[BestIdx].y, Width, Height};
+
+    // Split every free rectangle that overlaps the new region into up to four
+    // maximal rectangles that surround it:
+    //   ___________________
+    //  |       Top         |
+    //  |___________________|
+    //  |     |     |       |
+    //  |Left |  R  | Right |
+    //  |_____|_____|_______|
+    //  |      Bottom       |
+    //  |___________________|
+    //
+    std::vector<Region> Pieces;
+    for (size_t i = 0; i < m_FreeRects.size();)
+    {
+        const auto F = m_FreeRects[i];
+        if (!RegionsOverlap(F, R))
+        {
+            ++i;
+            continue;
+        }
+
+        // clang-format off
+        if (R.x > F.x)
+            Pieces.emplace_back(F.x, F.y, R.x - F.x, F.height); // Left
+        if (R.x + R.width < F.x + F.width)
+            Pieces.emplace_back(R.x + R.width, F.y, F.x + F.width - (R.x + R.width), F.height); // Right
+        if (R.y > F.y)
+            Pieces.emplace_back(F.x, F.y, F.width, R.y - F.y); // Bottom
+        if (R.y + R.height < F.y + F.height)
+            Pieces.emplace_back(F.x, R.y + R.height, F.width, F.y + F.height - (R.y + R.height)); // Top
+        // clang-format on
+
+        m_FreeRects[i] = m_FreeRects.back();
+        m_FreeRects.pop_back();
+    }
+
+    for (const auto& P : Pieces)
+        AddMaxRectsFreeRect(P, nullptr);
+
+    m_AllocatedRegions.emplace(R, nullptr);
+
+#if DILIGENT_DEBUG
+    for (const auto& F : m_FreeRects)
+        VERIFY(!RegionsOverlap(F, R), "Free rectangle overlaps the allocated region");
+#endif
+
+    return R;
+}
+
+void DynamicAtlasManager::FreeMaxRects(const Region& R)
+{
+    m_AllocatedRegions.erase(R);
+    if (m_AllocatedRegions.empty())
+    {
+        m_FreeRects.clear();
+        m_FreeRects.emplace_back(0, 0, m_Width, m_Height);
+        return;
+    }
+
+    // Any two free rectangles that are adjacent or overlap along one axis produce a free
+    // rectangle that spans both of them along this axis and their common range along
+    // the other axis. Repeat this for every new rectangle until no new rectangles appear.
+    std::vector<Region> NewRects;
+    AddMaxRectsFreeRect(R, &NewRects);
+    while (!NewRects.empty())
+    {
+        const auto A = NewRects.back();
+        NewRects.pop_back();
+
+        std::vector<Region> Spans;
+        for (const auto& F : m_FreeRects)
+        {
+            if (A.x <= F.x + F.width && F.x <= A.x + A.width)
+            {
+                const auto y0 = std::max(A.y, F.y);
+                const auto y1 = std::min(A.y + A.height, F.y + F.height);
+                if (y1 > y0)
+                {
+                    const auto x0 = std::min(A.x, F.x);
+                    const auto x1 = std::max(A.x + A.width, F.x + F.width);
+                    Spans.emplace_back(x0, y0, x1 - x0, y1 - y0);
+                }
+            }
+
+            if (A.y <= F.y + F.height && F.y <= A.y + A.height)
+            {
+                const auto x0 = std::max(A.x, F.x);
+                const auto x1 = std::min(A.x + A.width, F.x + F.width);
+                if (x1 > x0)
+                {
+                    const auto y0 = std::min(A.y, F.y);
+                    const auto y1 = std::max(A.y + A.height, F.y + F.height);
+                    Spans.emplace_back(x0, y0, x1 - x0, y1 - y0);
+                }
+            }
+        }
+
+        for (const auto& S : Spans)
+            AddMaxRectsFreeRect(S, &NewRects);
+    }
+}
+
+
+bool DynamicAtlasManager::Defragment(std::vector<RegionMove>& Moves)
+{
+    Moves.clear();
+
+    std::vector<Region> Regions;
+    Regions.reserve(m_AllocatedRegions.size());
+    for (const auto& it : m_AllocatedRegions)
+        Regions.emplace_back(it.first);
+
+    // Place large regions first. Ties are broken by the current location to keep the result deterministic.
+    std::sort(Regions.begin(), Regions.end(),
+              [](const Region& R0, const Region& R1) //
+              {
+                  const auto MaxSide0 = std::max(R0.width, R0.height);
+                  const auto MaxSide1 = std::max(R1.width, R1.height);
+                  if (MaxSide0 != MaxSide1)
+                      return MaxSide0 > MaxSide1;
+                  if (R0.width * R0.height != R1.width * R1.height)
+                      return R0.width * R0.height > R1.width * R1.height;
+                  if (R0.y != R1.y)
+                      return R0.y < R1.y;
+                  return R0.x < R1.x;
+              });
+
+    DynamicAtlasManager Packed{m_Width, m_Height, m_Policy, m_Heuristic};
+
+    std::vector<RegionMove> AllMoves;
+    AllMoves.reserve(Regions.size());
+    for (const auto& Src : Regions)
+    {
+        auto Dst = Packed.Allocate(Src.width, Src.height);
+        if (Dst.IsEmpty())
+        {
+            // The new layout does not fit - keep the current one
+            Packed.Reset();
+            return false;
+        }
+        AllMoves.push_back({Src, Dst});
+    }
+
+    for (const auto& Move : AllMoves)
+    {
+        if (Move.Src != Move.Dst)
+            Moves.push_back(Move);
+    }
+
+    Swap(Packed);
+    // Packed now owns the old layout whose regions are no longer referenced
+    Packed.Reset();
+
+#if DILIGENT_DEBUG
+    if (m_Policy == PackingPolicy::MaxRects)
+        DbgVerifyMaxRectsConsistency();
+    else
+        DbgVerifyConsistency();
+#endif
+
+    return true;
 }
 
 
@@ -420,6 +800,35 @@ void DynamicAtlasManager::DbgVerifyConsistency() const
 
     VERIFY(Area == m_Width * m_Height, "Not entire atlas area has been covered");
 }
+
+void DynamicAtlasManager::DbgVerifyMaxRectsConsistency() const
+{
+    VERIFY(!m_Root, "Node hierarchy is not used in MaxRects mode");
+    VERIFY(m_FreeRegionsByWidth.empty() && m_FreeRegionsByHeight.empty(), "Free region maps are not used in MaxRects mode");
+
+    Uint32 AllocatedArea = 0;
+    for (const auto& it : m_AllocatedRegions)
+    {
+        DbgVerifyRegion(it.first);
+        VERIFY(it.second == nullptr, "Allocated regions must not reference nodes in MaxRects mode");
+        AllocatedArea += it.first.width * it.first.height;
+    }
+    VERIFY(AllocatedArea == m_AllocatedArea, "Allocated area (", AllocatedArea, ") does not match the tracked value (", m_AllocatedArea, ")");
+
+    for (size_t i = 0; i < m_FreeRects.size(); ++i)
+    {
+        const auto& F = m_FreeRects[i];
+        DbgVerifyRegion(F);
+        for (size_t j = 0; j < m_FreeRects.size(); ++j)
+        {
+            VERIFY(i == j || !RegionContains(m_FreeRects[j], F), "Free rectangle is contained in another one");
+        }
+        for (const auto& it : m_AllocatedRegions)
+        {
+            VERIFY(!RegionsOverlap(F, it.first), "Free rectangle overlaps an allocated region");
+        }
+    }
+}
 #endif // DILIGENT_DEBUG
 
 } // namespace Diligent
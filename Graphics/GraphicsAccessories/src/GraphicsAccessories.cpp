@@ -26,11 +26,14 @@
  */
 
 #include <algorithm>
+#include <cstring>
 
 #include "GraphicsAccessories.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
 #include "BasicMath.hpp"
+#include "SIMDHelpers.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -1669,30 +1672,169 @@ BufferToTextureCopyInfo GetBufferToTextureCopyInfo(const TextureDesc& TexDesc,
 }
 
 
-void CopyTextureSubresource(const TextureSubResData& SrcSubres,
-                            Uint32                   NumRows,
-                            Uint32                   NumDepthSlices,
-                            Uint32                   RowSize,
-                            void*                    pDstData,
-                            Uint32                   DstRowStride,
-                            Uint32                   DstDepthStride)
+namespace
+{
+
+// Copies memory with non-temporal stores that bypass the cache. This avoids reading
+// uncached destination memory into the cache and does not evict useful cache lines.
+void StreamingMemCopy(void* pDst, const void* pSrc, size_t Size)
+{
+#if DILIGENT_SSE2_SUPPORTED
+    auto*       pDstBytes = static_cast<Uint8*>(pDst);
+    const auto* pSrcBytes = static_cast<const Uint8*>(pSrc);
+
+    // Streaming stores require 16-byte aligned destination
+    const size_t HeadSize = std::min(Size, (16 - (reinterpret_cast<size_t>(pDstBytes) & 15)) & 15);
+    memcpy(pDstBytes, pSrcBytes, HeadSize);
+    pDstBytes += HeadSize;
+    pSrcBytes += HeadSize;
+    Size -= HeadSize;
+
+    // Write full 64-byte lines to let the write-combining buffers flush complete lines
+    for (; Size >= 64; Size -= 64, pDstBytes += 64, pSrcBytes += 64)
+    {
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcBytes) + 0);
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcBytes) + 1);
+        const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcBytes) + 2);
+        const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcBytes) + 3);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(pDstBytes) + 0, v0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(pDstBytes) + 1, v1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(pDstBytes) + 2, v2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(pDstBytes) + 3, v3);
+    }
+    for (; Size >= 16; Size -= 16, pDstBytes += 16, pSrcBytes += 16)
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(pDstBytes), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcBytes)));
+    }
+    memcpy(pDstBytes, pSrcBytes, Size);
+#else
+    memcpy(pDst, pSrc, Size);
+#endif
+}
+
+// Makes non-temporal stores of the calling thread globally visible
+void StreamingStoreFence()
+{
+#if DILIGENT_SSE2_SUPPORTED
+    _mm_sfence();
+#endif
+}
+
+// Texture subresource copy, reduced to NumSlices x NumRows rows of RowSize bytes each
+struct SubresourceCopyLayout
+{
+    const Uint8* pSrc;
+    Uint8*       pDst;
+
+    size_t RowSize;
+    size_t NumRows;
+    size_t NumSlices;
+
+    size_t SrcRowStride;
+    size_t DstRowStride;
+    size_t SrcSliceStride;
+    size_t DstSliceStride;
+
+    bool UseStreamingStores;
+
+    // Copies bytes [StartByte, EndByte) of rows [StartRow, EndRow), where rows
+    // of all slices are numbered consecutively.
+    void CopyRows(size_t StartRow, size_t EndRow, size_t StartByte, size_t EndByte) const
+    {
+        VERIFY_EXPR(StartByte <= EndByte && EndByte <= RowSize);
+        for (size_t Row = StartRow; Row < EndRow; ++Row)
+        {
+            const auto z = Row / NumRows;
+            const auto y = Row % NumRows;
+
+            const auto* pSrcRow = pSrc + z * SrcSliceStride + y * SrcRowStride + StartByte;
+            auto*       pDstRow = pDst + z * DstSliceStride + y * DstRowStride + StartByte;
+            if (UseStreamingStores)
+                StreamingMemCopy(pDstRow, pSrcRow, EndByte - StartByte);
+            else
+                memcpy(pDstRow, pSrcRow, EndByte - StartByte);
+        }
+        if (UseStreamingStores)
+            StreamingStoreFence();
+    }
+};
+
+// The minimum amount of data copied by one thread pool task
+constexpr size_t MinParallelCopyTaskSize = size_t{1} << 20;
+
+} // namespace
+
+void CopyTextureSubresource(const TextureSubResData&       SrcSubres,
+                            Uint32                         NumRows,
+                            Uint32                         NumDepthSlices,
+                            Uint32                         RowSize,
+                            void*                          pDstData,
+                            Uint32                         DstRowStride,
+                            Uint32                         DstDepthStride,
+                            COPY_TEXTURE_SUBRESOURCE_FLAGS Flags,
+                            ThreadPool*                    pThreadPool)
 {
     VERIFY_EXPR(SrcSubres.pSrcBuffer == nullptr && SrcSubres.pData != nullptr);
     VERIFY_EXPR(pDstData != nullptr);
     VERIFY(SrcSubres.Stride >= RowSize, "Source data row stride (", SrcSubres.Stride, ") is smaller than the row size (", RowSize, ")");
     VERIFY(DstRowStride >= RowSize, "Dst data row stride (", DstRowStride, ") is smaller than the row size (", RowSize, ")");
-    for (Uint32 z = 0; z < NumDepthSlices; ++z)
-    {
-        const auto* pSrcSlice = reinterpret_cast<const Uint8*>(SrcSubres.pData) + SrcSubres.DepthStride * z;
-        auto*       pDstSlice = reinterpret_cast<Uint8*>(pDstData) + DstDepthStride * z;
 
-        for (Uint32 y = 0; y < NumRows; ++y)
+    SubresourceCopyLayout Layout;
+    Layout.pSrc               = static_cast<const Uint8*>(SrcSubres.pData);
+    Layout.pDst               = static_cast<Uint8*>(pDstData);
+    Layout.RowSize            = RowSize;
+    Layout.NumRows            = NumRows;
+    Layout.NumSlices          = NumDepthSlices;
+    Layout.SrcRowStride       = SrcSubres.Stride;
+    Layout.DstRowStride       = DstRowStride;
+    Layout.SrcSliceStride     = SrcSubres.DepthStride;
+    Layout.DstSliceStride     = DstDepthStride;
+    Layout.UseStreamingStores = (Flags & COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED) != 0;
+
+    // Collapse tightly packed rows into a single block per slice, and tightly
+    // packed slices into a single block for the entire subresource
+    if (Layout.NumRows == 1 || (Layout.SrcRowStride == RowSize && Layout.DstRowStride == RowSize))
+    {
+        Layout.RowSize *= Layout.NumRows;
+        Layout.NumRows = 1;
+
+        if (Layout.NumSlices == 1 || (Layout.SrcSliceStride == Layout.RowSize && Layout.DstSliceStride == Layout.RowSize))
         {
-            memcpy(pDstSlice + DstRowStride * y,
-                   pSrcSlice + SrcSubres.Stride * y,
-                   RowSize);
+            Layout.RowSize *= Layout.NumSlices;
+            Layout.NumSlices = 1;
         }
     }
+
+    const size_t TotalRows = Layout.NumSlices * Layout.NumRows;
+    const size_t TotalSize = TotalRows * Layout.RowSize;
+
+    const size_t NumTasks = pThreadPool != nullptr ?
+        std::min(TotalSize / MinParallelCopyTaskSize, (size_t{pThreadPool->GetNumThreads()} + 1) * 2) :
+        1;
+    if (NumTasks <= 1)
+    {
+        Layout.CopyRows(0, TotalRows, 0, Layout.RowSize);
+        return;
+    }
+
+    pThreadPool->ParallelFor(
+        static_cast<Uint32>(NumTasks),
+        [&Layout, TotalRows, NumTasks](Uint32 Task) //
+        {
+            if (TotalRows >= NumTasks)
+            {
+                // Every task copies a range of rows
+                Layout.CopyRows(TotalRows * Task / NumTasks, TotalRows * (Task + 1) / NumTasks, 0, Layout.RowSize);
+            }
+            else
+            {
+                // Every task copies a range of bytes of every row. Range boundaries are
+                // aligned to 64 bytes so that tasks do not share cache lines of aligned rows.
+                const auto StartByte = AlignDown(Layout.RowSize * Task / NumTasks, size_t{64});
+                const auto EndByte   = Task + 1 < NumTasks ? AlignDown(Layout.RowSize * (Task + 1) / NumTasks, size_t{64}) : Layout.RowSize;
+                Layout.CopyRows(0, TotalRows, StartByte, EndByte);
+            }
+        });
 }
 
 } // namespace Diligent
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryBudgetTracker.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+Uint32 MemoryBudgetTracker::AddThreshold(float Threshold)
+{
+    VERIFY(Threshold > 0, "Threshold (", Threshold, ") must be positive");
+
+    ThresholdInfo NewThreshold;
+    NewThreshold.Id        = m_NextThresholdId++;
+    NewThreshold.Threshold = Threshold;
+    m_Thresholds.emplace_back(std::move(NewThreshold));
+
+    return m_Thresholds.back().Id;
+}
+
+bool MemoryBudgetTracker::RemoveThreshold(Uint32 ThresholdId)
+{
+    auto it = std::find_if(m_Thresholds.begin(), m_Thresholds.end(),
+                           [ThresholdId](const ThresholdInfo& Info) { return Info.Id == ThresholdId; });
+    if (it == m_Thresholds.end())
+        return false;
+
+    m_Thresholds.erase(it);
+    return true;
+}
+
+void MemoryBudgetTracker::Update(const MemoryHeapBudgetInfo*              pHeaps,
+                                 Uint32                                   NumHeaps,
+                                 std::vector<MemoryBudgetThresholdEvent>& Events)
+{
+    VERIFY_EXPR(pHeaps != nullptr || NumHeaps == 0);
+
+    for (auto& Threshold : m_Thresholds)
+    {
+        Threshold.ExceededHeaps.resize(NumHeaps, false);
+
+        const float RestoreThreshold = std::max(Threshold.Threshold - m_Hysteresis, 0.f);
+        for (Uint32 HeapIdx = 0; HeapIdx < NumHeaps; ++HeapIdx)
+        {
+            const auto& Heap = pHeaps[HeapIdx];
+            if (Heap.Budget == 0)
+                continue;
+
+            // Compare fractions rather than byte sizes so that the usage that is exactly
+            // at the threshold is not affected by the rounding of the threshold value.
+            const float UsageFraction = static_cast<float>(static_cast<double>(Heap.Usage) / static_cast<double>(Heap.Budget));
+
+            const bool WasExceeded = Threshold.ExceededHeaps[HeapIdx];
+            const bool IsExceeded  = UsageFraction >= (WasExceeded ? RestoreThreshold : Threshold.Threshold);
+            if (IsExceeded == WasExceeded)
+                continue;
+
+            Threshold.ExceededHeaps[HeapIdx] = IsExceeded;
+
+            MemoryBudgetThresholdEvent Event;
+            Event.ThresholdId = Threshold.Id;
+            Event.HeapIndex   = HeapIdx;
+            Event.Exceeded    = IsExceeded;
+            Event.Heap        = Heap;
+            Events.emplace_back(Event);
+        }
+    }
+}
+
+} // namespace Diligent
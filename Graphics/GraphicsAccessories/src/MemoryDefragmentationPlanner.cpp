@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryDefragmentationPlanner.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+static bool IsSparsePage(const DefragmentationPageInfo& Page, float SparsePageThreshold)
+{
+    return Page.UsedSize > 0 && static_cast<double>(Page.UsedSize) <= static_cast<double>(Page.Size) * SparsePageThreshold;
+}
+
+MemoryFragmentationStats ComputeMemoryFragmentationStats(const DefragmentationPageInfo* pPages,
+                                                         size_t                         NumPages,
+                                                         float                          SparsePageThreshold)
+{
+    MemoryFragmentationStats Stats;
+
+    Uint64 NonEmptyPagesSize = 0;
+    for (size_t i = 0; i < NumPages; ++i)
+    {
+        const auto& Page = pPages[i];
+        VERIFY(Page.UsedSize <= Page.Size, "Used size (", Page.UsedSize, ") exceeds the page size (", Page.Size, ")");
+
+        ++Stats.NumPages;
+        Stats.TotalSize += Page.Size;
+        Stats.UsedSize += Page.UsedSize;
+        if (Page.UsedSize == 0)
+        {
+            ++Stats.NumEmptyPages;
+        }
+        else
+        {
+            NonEmptyPagesSize += Page.Size;
+            if (IsSparsePage(Page, SparsePageThreshold))
+                ++Stats.NumSparsePages;
+        }
+    }
+
+    if (NonEmptyPagesSize > 0)
+        Stats.Fragmentation = static_cast<float>(static_cast<double>(NonEmptyPagesSize - Stats.UsedSize) / static_cast<double>(NonEmptyPagesSize));
+
+    return Stats;
+}
+
+MemoryFragmentationStats ProjectMemoryFragmentationStats(const DefragmentationPageInfo* pPages,
+                                                         size_t                         NumPages,
+                                                         const std::vector<size_t>&     EvacuatedPages,
+                                                         float                          SparsePageThreshold)
+{
+    std::vector<DefragmentationPageInfo> ProjectedPages;
+    ProjectedPages.reserve(NumPages - EvacuatedPages.size());
+    std::unordered_map<Uint32, Uint64> PoolBytesToPlace;
+    {
+        std::vector<bool> IsEvacuated(NumPages, false);
+        for (auto PageIdx : EvacuatedPages)
+        {
+            VERIFY_EXPR(PageIdx < NumPages);
+            IsEvacuated[PageIdx] = true;
+            PoolBytesToPlace[pPages[PageIdx].PoolId] += pPages[PageIdx].UsedSize;
+        }
+        for (size_t i = 0; i < NumPages; ++i)
+        {
+            if (!IsEvacuated[i])
+                ProjectedPages.push_back(pPages[i]);
+        }
+    }
+
+    std::sort(ProjectedPages.begin(), ProjectedPages.end(),
+              [](const DefragmentationPageInfo& lhs, const DefragmentationPageInfo& rhs) {
+                  return lhs.UsedSize > rhs.UsedSize;
+              });
+    for (auto& Page : ProjectedPages)
+    {
+        auto it = PoolBytesToPlace.find(Page.PoolId);
+        if (it == PoolBytesToPlace.end() || it->second == 0)
+            continue;
+
+        const auto Bytes = std::min(it->second, Page.Size - Page.UsedSize);
+        Page.UsedSize += Bytes;
+        Page.MovableSize += Bytes;
+        it->second -= Bytes;
+    }
+
+    return ComputeMemoryFragmentationStats(ProjectedPages.data(), ProjectedPages.size(), SparsePageThreshold);
+}
+
+DefragmentationPlan PlanMemoryDefragmentation(const DefragmentationPageInfo*    pPages,
+                                              size_t                            NumPages,
+                                              const DefragmentationPlanAttribs& Attribs)
+{
+    DefragmentationPlan Plan;
+
+    struct PoolSpaceInfo
+    {
+        // Total free space in the pages of the pool that are not evacuated
+        Uint64 FreeSize = 0;
+
+        // Total size of allocations moved out of the evacuated pages of the pool
+        Uint64 BytesToPlace = 0;
+    };
+    std::unordered_map<Uint32, PoolSpaceInfo> PoolSpace;
+    std::vector<size_t>                       Candidates;
+    for (size_t i = 0; i < NumPages; ++i)
+    {
+        const auto& Page = pPages[i];
+        VERIFY(Page.MovableSize <= Page.UsedSize, "Movable size (", Page.MovableSize, ") exceeds the used size (", Page.UsedSize, ")");
+
+        PoolSpace[Page.PoolId].FreeSize += Page.Size - Page.UsedSize;
+        // A page can only be released if all of its allocations are moved out
+        if (IsSparsePage(Page, Attribs.SparsePageThreshold) && Page.MovableSize == Page.UsedSize)
+            Candidates.push_back(i);
+    }
+
+    // Evacuate the pages that are cheapest to move first
+    std::sort(Candidates.begin(), Candidates.end(),
+              [pPages](size_t lhs, size_t rhs) {
+                  return pPages[lhs].UsedSize != pPages[rhs].UsedSize ?
+                      pPages[lhs].UsedSize < pPages[rhs].UsedSize :
+                      lhs < rhs;
+              });
+
+    for (auto PageIdx : Candidates)
+    {
+        const auto& Page = pPages[PageIdx];
+        if (Plan.BytesToMove + Page.UsedSize > Attribs.MaxBytesToMove)
+            break; // All remaining candidates are at least as large
+
+        // Neither the page being evacuated nor the pages selected earlier can be destinations,
+        // and the remaining pages must also accommodate allocations moved out of the selected pages.
+        auto&        Pool             = PoolSpace[Page.PoolId];
+        const Uint64 PageFreeSize     = Page.Size - Page.UsedSize;
+        const Uint64 DestinationSpace = Pool.FreeSize - PageFreeSize;
+        VERIFY_EXPR(Pool.FreeSize >= PageFreeSize);
+        if (DestinationSpace < Pool.BytesToPlace + Page.UsedSize)
+            continue;
+
+        Pool.FreeSize = DestinationSpace;
+        Pool.BytesToPlace += Page.UsedSize;
+        Plan.PagesToEvacuate.push_back(PageIdx);
+        Plan.BytesToMove += Page.UsedSize;
+    }
+
+    Plan.ProjectedStats = ProjectMemoryFragmentationStats(pPages, NumPages, Plan.PagesToEvacuate, Attribs.SparsePageThreshold);
+
+    return Plan;
+}
+
+} // namespace Diligent
@@ -46,6 +46,7 @@
 #include "SRBMemoryAllocator.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "HashUtils.hpp"
+#include "StringInterner.hpp"
 
 namespace Diligent
 {
@@ -176,20 +177,20 @@ public:
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByName(SHADER_TYPE ShaderType,
                                                                                 const Char* Name) override final
     {
-        if (!IsConsistentShaderType(ShaderType, m_PipelineType))
-        {
-            LOG_WARNING_MESSAGE("Unable to find static variable '", Name, "' in shader stage ", GetShaderTypeLiteralName(ShaderType),
-                                " as the stage is invalid for ", GetPipelineTypeString(m_PipelineType), " pipeline resource signature '", this->m_Desc.Name, "'.");
-            return nullptr;
-        }
+        return GetStaticVariableByNameImpl(ShaderType, Name);
+    }
 
-        const auto ShaderTypeInd = GetShaderTypePipelineIndex(ShaderType, m_PipelineType);
-        const auto VarMngrInd    = m_StaticResStageIndex[ShaderTypeInd];
-        if (VarMngrInd < 0)
+    /// Implementation of IPipelineResourceSignature::GetStaticVariableByInternedName.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByInternedName(SHADER_TYPE ShaderType,
+                                                                                        const Char* InternedName) override final
+    {
+        if (InternedName == nullptr)
             return nullptr;
 
-        VERIFY_EXPR(static_cast<Uint32>(VarMngrInd) < GetNumStaticResStages());
-        return m_StaticVarsMgrs[VarMngrInd].GetVariable(Name);
+        DEV_CHECK_ERR(this->m_pDevice->GetStringInterner().Find(InternedName).GetStr() == InternedName,
+                      "Name '", InternedName, "' has not been interned by the device that created pipeline resource signature '",
+                      this->m_Desc.Name, "'. Use IRenderDevice::InternString() of the same device.");
+        return GetStaticVariableByNameImpl(ShaderType, InternedString::FromInternedStr(InternedName));
     }
 
     /// Implementation of IPipelineResourceSignature::GetStaticVariableByIndex.
@@ -485,6 +486,25 @@ protected:
     }
 
 private:
+    template <typename NameType>
+    IShaderResourceVariable* GetStaticVariableByNameImpl(SHADER_TYPE ShaderType, const NameType& Name)
+    {
+        if (!IsConsistentShaderType(ShaderType, m_PipelineType))
+        {
+            LOG_WARNING_MESSAGE("Unable to find static variable '", Name, "' in shader stage ", GetShaderTypeLiteralName(ShaderType),
+                                " as the stage is invalid for ", GetPipelineTypeString(m_PipelineType), " pipeline resource signature '", this->m_Desc.Name, "'.");
+            return nullptr;
+        }
+
+        const auto ShaderTypeInd = GetShaderTypePipelineIndex(ShaderType, m_PipelineType);
+        const auto VarMngrInd    = m_StaticResStageIndex[ShaderTypeInd];
+        if (VarMngrInd < 0)
+            return nullptr;
+
+        VERIFY_EXPR(static_cast<Uint32>(VarMngrInd) < GetNumStaticResStages());
+        return m_StaticVarsMgrs[VarMngrInd].GetVariable(Name);
+    }
+
     static void ReserveSpaceForDescription(FixedLinearAllocator& Allocator, const PipelineResourceSignatureDesc& Desc)
     {
         Allocator.AddSpace<PipelineResourceDesc>(Desc.NumResources);
@@ -498,8 +518,6 @@ private:
             VERIFY(Res.Name[0] != '\0', "Name can't be empty. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
             VERIFY(Res.ShaderStages != SHADER_TYPE_UNKNOWN, "ShaderStages can't be SHADER_TYPE_UNKNOWN. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
             VERIFY(Res.ArraySize != 0, "ArraySize can't be 0. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
-
-            Allocator.AddSpaceForString(Res.Name);
         }
 
         for (Uint32 i = 0; i < Desc.NumImmutableSamplers; ++i)
@@ -526,7 +544,10 @@ private:
 
             DstRes = SrcRes;
             VERIFY_EXPR(SrcRes.Name != nullptr && SrcRes.Name[0] != '\0');
-            DstRes.Name = Allocator.CopyString(SrcRes.Name);
+            // Resource names are interned by the device rather than copied: the same names are
+            // shared by all signatures of the device, and shader variables can be found by
+            // interned names using pointer comparison.
+            DstRes.Name = this->m_pDevice->GetStringInterner().Intern(SrcRes.Name).GetStr();
 
             ++m_ResourceOffsets[DstRes.VarType + 1];
         }
@@ -359,6 +359,26 @@ public:
         return this->GetResourceSignature(0)->GetStaticVariableByName(ShaderType, Name);
     }
 
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByInternedName(SHADER_TYPE ShaderType,
+                                                                                        const Char* InternedName) override final
+    {
+        if (!m_UsingImplicitSignature)
+        {
+            LOG_ERROR_MESSAGE("IPipelineState::GetStaticVariableByInternedName is not allowed for pipelines that use explicit "
+                              "resource signatures. Use IPipelineResourceSignature::GetStaticVariableByInternedName instead.");
+            return nullptr;
+        }
+
+        if ((m_ActiveShaderStages & ShaderType) == 0)
+        {
+            LOG_WARNING_MESSAGE("Unable to find static variable '", (InternedName != nullptr ? InternedName : "<null>"), "' in shader stage ",
+                                GetShaderTypeLiteralName(ShaderType), " as the stage is inactive in PSO '", this->m_Desc.Name, "'.");
+            return nullptr;
+        }
+
+        return this->GetResourceSignature(0)->GetStaticVariableByInternedName(ShaderType, InternedName);
+    }
+
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByIndex(SHADER_TYPE ShaderType,
                                                                                  Uint32      Index) override final
     {
@@ -435,6 +455,12 @@ public:
         return m_Signatures[Index];
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool /*WaitForCompletion*/) override // May be overriden
+    {
+        return PIPELINE_STATE_STATUS_READY;
+    }
+
     /// Implementation of IPipelineState::IsCompatibleWith().
     virtual bool DILIGENT_CALL_TYPE IsCompatibleWith(const IPipelineState* pPSO) const override // May be overriden
     {
@@ -43,6 +43,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
+#include "StringInterner.hpp"
 
 namespace std
 {
@@ -368,8 +369,18 @@ public:
         return m_pEngineFactory.RawPtr<IEngineFactory>();
     }
 
+    /// Implementation of IRenderDevice::InternString().
+    virtual const Char* DILIGENT_CALL_TYPE InternString(const Char* Str) override final
+    {
+        return m_StringInterner.Intern(Str).GetStr();
+    }
+
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
+    /// Returns the table of strings interned by the device, which also keeps
+    /// the resource names of all pipeline resource signatures.
+    StringInterner& GetStringInterner() { return m_StringInterner; }
+
     /// Set weak reference to the immediate context
     void SetImmediateContext(IDeviceContext* pImmediateContext)
     {
@@ -606,6 +617,8 @@ protected:
 protected:
     RefCntAutoPtr<IEngineFactory> m_pEngineFactory;
 
+    StringInterner m_StringInterner;
+
     DeviceCaps       m_DeviceCaps;
     DeviceProperties m_DeviceProperties;
 
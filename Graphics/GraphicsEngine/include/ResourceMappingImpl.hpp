@@ -30,13 +30,14 @@
 /// \file
 /// Declaration of the Diligent::ResourceMappingImpl class
 
-#include <unordered_map>
-
 #include "ResourceMapping.h"
 #include "ObjectBase.hpp"
 #include "HashUtils.hpp"
 #include "STDAllocator.hpp"
+#include "FlatHashMap.hpp"
+#include "StringInterner.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -53,7 +54,7 @@ public:
     /// \param RawMemAllocator - raw memory allocator that is used by the m_HashTable member
     ResourceMappingImpl(IReferenceCounters* pRefCounters, IMemoryAllocator& RawMemAllocator) :
         TObjectBase{pRefCounters},
-        m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")}
+        m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for FlatHashMap<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")}
     {}
 
     ~ResourceMappingImpl();
@@ -83,6 +84,20 @@ public:
     /// Returns number of resources in the resource mapping.
     virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
 
+    /// Implementation of IResourceMapping::AddResourceByInternedName()
+    virtual void DILIGENT_CALL_TYPE AddResourceByInternedName(const Char*    InternedName,
+                                                              IDeviceObject* pObject,
+                                                              bool           bIsUnique,
+                                                              Uint32         ArrayIndex) override final;
+
+    /// Implementation of IResourceMapping::RemoveResourceByInternedName()
+    virtual void DILIGENT_CALL_TYPE RemoveResourceByInternedName(const Char* InternedName, Uint32 ArrayIndex) override final;
+
+    /// Implementation of IResourceMapping::GetResourceByInternedName()
+    virtual void DILIGENT_CALL_TYPE GetResourceByInternedName(const Char*     InternedName,
+                                                              IDeviceObject** ppResource,
+                                                              Uint32          ArrayIndex) override final;
+
 private:
     struct ResMappingHashKey : public HashMapStringKey
     {
@@ -95,6 +110,14 @@ private:
             Ownership_Hash = (ComputeHash(GetHash(), ArrInd) & HashMask) | (Ownership_Hash & StrOwnershipMask);
         }
 
+        // Initializes the key with an interned string without recomputing its hash
+        ResMappingHashKey(const InternedString& Str, bool bMakeCopy, Uint32 ArrInd) noexcept :
+            HashMapStringKey{Str.GetHash(), Str.GetStr(), bMakeCopy},
+            ArrayIndex{ArrInd}
+        {
+            Ownership_Hash = (ComputeHash(GetHash(), ArrInd) & HashMask) | (Ownership_Hash & StrOwnershipMask);
+        }
+
         ResMappingHashKey(ResMappingHashKey&& rhs) noexcept :
             HashMapStringKey{std::move(rhs)},
             ArrayIndex{rhs.ArrayIndex}
@@ -123,16 +146,21 @@ private:
         const Uint32 ArrayIndex;
     };
 
-    ThreadingTools::LockHelper Lock();
+    ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveSharedLock> Lock();
+    ThreadingTools::SharedLockGuard                                        LockShared();
+
+    void AddResourceImpl(ResMappingHashKey&& Key, IDeviceObject* pObject, bool bIsUnique);
+    void GetResourceImpl(const ResMappingHashKey& Key, IDeviceObject** ppResource);
 
-    ThreadingTools::LockFlag m_LockFlag;
+    // Resource mappings are mostly read, so lookups only take a shared lock
+    ThreadingTools::AdaptiveSharedLock m_Lock;
 
-    using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
-    std::unordered_map<ResMappingHashKey,
-                       RefCntAutoPtr<IDeviceObject>,
-                       ResMappingHashKey::Hasher,
-                       std::equal_to<ResMappingHashKey>,
-                       STDAllocatorRawMem<HashTableElem>>
+    using HashTableElem = std::pair<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
+    FlatHashMap<ResMappingHashKey,
+                RefCntAutoPtr<IDeviceObject>,
+                ResMappingHashKey::Hasher,
+                std::equal_to<ResMappingHashKey>,
+                STDAllocatorRawMem<HashTableElem>>
         m_HashTable;
 };
 
@@ -43,6 +43,7 @@
 #include "ShaderResourceCacheCommon.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "EngineMemory.h"
+#include "StringInterner.hpp"
 
 namespace Diligent
 {
@@ -178,21 +179,21 @@ public:
     /// Implementation of IShaderResourceBinding::GetVariableByName().
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final
     {
-        const auto PipelineType = GetPipelineType();
-        if (!IsConsistentShaderType(ShaderType, PipelineType))
-        {
-            LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable '", Name, "' in shader stage ", GetShaderTypeLiteralName(ShaderType),
-                                " as the stage is invalid for ", GetPipelineTypeString(PipelineType), " pipeline resource signature '", m_pPRS->GetDesc().Name, "'.");
-            return nullptr;
-        }
+        return GetVariableByNameImpl(ShaderType, Name);
+    }
 
-        const auto ShaderInd = GetShaderTypePipelineIndex(ShaderType, PipelineType);
-        const auto MgrInd    = m_ActiveShaderStageIndex[ShaderInd];
-        if (MgrInd < 0)
+    /// Implementation of IShaderResourceBinding::GetVariableByInternedName().
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByInternedName(SHADER_TYPE ShaderType, const char* InternedName) override final
+    {
+        if (InternedName == nullptr)
             return nullptr;
 
-        VERIFY_EXPR(static_cast<Uint32>(MgrInd) < GetNumShaders());
-        return m_pShaderVarMgrs[MgrInd].GetVariable(Name);
+        // Resource names are interned by the device that created the signature,
+        // so the variable is found by pointer comparison.
+        DEV_CHECK_ERR(m_pPRS->GetDevice()->GetStringInterner().Find(InternedName).GetStr() == InternedName,
+                      "Name '", InternedName, "' has not been interned by the device that created pipeline resource signature '",
+                      m_pPRS->GetDesc().Name, "'. Use IRenderDevice::InternString() of the same device.");
+        return GetVariableByNameImpl(ShaderType, InternedString::FromInternedStr(InternedName));
     }
 
     /// Implementation of IShaderResourceBinding::GetVariableCount().
@@ -260,6 +261,26 @@ public:
     const ShaderResourceCacheImplType& GetResourceCache() const { return m_ShaderResourceCache; }
 
 private:
+    template <typename NameType>
+    IShaderResourceVariable* GetVariableByNameImpl(SHADER_TYPE ShaderType, const NameType& Name)
+    {
+        const auto PipelineType = GetPipelineType();
+        if (!IsConsistentShaderType(ShaderType, PipelineType))
+        {
+            LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable '", Name, "' in shader stage ", GetShaderTypeLiteralName(ShaderType),
+                                " as the stage is invalid for ", GetPipelineTypeString(PipelineType), " pipeline resource signature '", m_pPRS->GetDesc().Name, "'.");
+            return nullptr;
+        }
+
+        const auto ShaderInd = GetShaderTypePipelineIndex(ShaderType, PipelineType);
+        const auto MgrInd    = m_ActiveShaderStageIndex[ShaderInd];
+        if (MgrInd < 0)
+            return nullptr;
+
+        VERIFY_EXPR(static_cast<Uint32>(MgrInd) < GetNumShaders());
+        return m_pShaderVarMgrs[MgrInd].GetVariable(Name);
+    }
+
     void Destruct()
     {
         if (m_pShaderVarMgrs != nullptr)
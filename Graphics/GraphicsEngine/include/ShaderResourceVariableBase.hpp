@@ -36,6 +36,7 @@
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
 #include "StringTools.hpp"
+#include "StringInterner.hpp"
 #include "GraphicsAccessories.hpp"
 
 namespace Diligent
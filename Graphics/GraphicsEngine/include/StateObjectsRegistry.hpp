@@ -31,8 +31,9 @@
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
 #include "DeviceObject.h"
-#include <unordered_map>
 #include "STDAllocator.hpp"
+#include "FlatHashMap.hpp"
+#include "AdaptiveLock.hpp"
 
 namespace Diligent
 {
@@ -67,7 +68,7 @@ public:
 
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
         m_NumDeletedObjects{0},
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
+        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for FlatHashMap<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
         m_RegistryName{RegistryName}
     {}
 
@@ -95,7 +96,7 @@ public:
     /// cost to it.
     void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
     {
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveSharedLock> Lock{m_Lock};
 
         // If the number of outstanding deleted objects reached the threshold value,
         // purge the registry. Since we have exclusive access now, it is safe
@@ -107,7 +108,7 @@ public:
         }
 
         // Try to construct the new element in place
-        auto Elems = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
+        auto Elems = m_DescToObjHashMap.try_emplace(ObjectDesc, pObject);
         // It is theorertically possible that the same object can be found
         // in the registry. This might happen if two threads try to create
         // the same object at the same time. They both will not find the
@@ -137,27 +138,40 @@ public:
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
         *ppObject = nullptr;
-        ThreadingTools::LockHelper Lock(m_LockFlag);
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
         {
+            // Lookups are much more frequent than additions, so they are performed
+            // under the shared lock.
+            ThreadingTools::SharedLockGuard Lock{m_Lock};
+
+            auto It = m_DescToObjHashMap.find(Desc);
+            if (It == m_DescToObjHashMap.end())
+                return;
+
             // Try to obtain strong reference to the object.
             // This is an atomic operation and we either get
             // a new strong reference or object has been destroyed
-            // and we get null.
-            auto pObject = It->second.Lock();
+            // and we get null. Other threads may access the same
+            // weak pointer, so it must not be modified.
+            auto pObject = It->second.LockNoRelease();
             if (pObject)
             {
                 *ppObject = pObject.Detach();
                 //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
+                return;
             }
-            else
-            {
-                // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
-                Atomics::AtomicDecrement(m_NumDeletedObjects);
-            }
+        }
+
+        // Expired object found: take the exclusive lock and remove it from the map.
+        // Another thread may have replaced or removed the object in the meantime,
+        // so look it up again.
+        ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveSharedLock> Lock{m_Lock};
+
+        auto It = m_DescToObjHashMap.find(Desc);
+        if (It != m_DescToObjHashMap.end() && !It->second.IsValid())
+        {
+            m_DescToObjHashMap.erase(It);
+            Atomics::AtomicDecrement(m_NumDeletedObjects);
         }
     }
 
@@ -198,15 +212,15 @@ public:
     }
 
 private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    ThreadingTools::LockFlag m_LockFlag;
+    /// Reader/writer lock that protects the m_DescToObjHashMap
+    ThreadingTools::AdaptiveSharedLock m_Lock;
 
     /// Nmber of outstanding deleted objects that have not been purged
     Atomics::AtomicLong m_NumDeletedObjects;
 
     /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    typedef std::pair<ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                          HashMapElem;
+    FlatHashMap<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
 
     /// Registry name used for debug output
     const String m_RegistryName;
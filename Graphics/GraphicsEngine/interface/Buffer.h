@@ -70,6 +70,23 @@ DILIGENT_TYPED_ENUM(BUFFER_MODE, Uint8)
     BUFFER_MODE_NUM_MODES
 };
 
+/// Miscellaneous buffer flags
+
+/// The enumeration is used by BufferDesc to describe misc buffer flags
+DILIGENT_TYPED_ENUM(MISC_BUFFER_FLAGS, Uint8)
+{
+    MISC_BUFFER_FLAG_NONE            = 0x00,
+
+    /// Allow the engine to move the buffer to a different memory location
+    /// when defragmenting device memory.
+
+    /// \note Only buffers with USAGE_DEFAULT or USAGE_IMMUTABLE usage that are not formatted
+    ///       can be relocated. Binding the buffer to a static or mutable shader variable
+    ///       disables relocation. The flag is currently only used by Vulkan backend.
+    MISC_BUFFER_FLAG_DEFRAGMENTABLE  = 0x01
+};
+DEFINE_FLAG_ENUM_OPERATORS(MISC_BUFFER_FLAGS)
+
 /// Buffer description
 struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
@@ -106,26 +123,31 @@ struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     /// Defines which command queues this buffer can be used with
     Uint64 CommandQueueMask         DEFAULT_INITIALIZER(1);
 
+    /// Miscellaneous flags, see Diligent::MISC_BUFFER_FLAGS for details.
+    MISC_BUFFER_FLAGS MiscFlags     DEFAULT_INITIALIZER(MISC_BUFFER_FLAG_NONE);
+
 #if DILIGENT_CPP_INTERFACE
     // We have to explicitly define constructors because otherwise the following initialization fails on Apple's clang:
     //      BufferDesc{1024, BIND_UNIFORM_BUFFER, USAGE_DEFAULT}
 
     BufferDesc()noexcept{}
 
-    BufferDesc(Uint32           _uiSizeInBytes, 
-               BIND_FLAGS       _BindFlags,
-               USAGE            _Usage             = BufferDesc{}.Usage,
-               CPU_ACCESS_FLAGS _CPUAccessFlags    = BufferDesc{}.CPUAccessFlags,
-               BUFFER_MODE      _Mode              = BufferDesc{}.Mode,
-               Uint32           _ElementByteStride = BufferDesc{}.ElementByteStride,
-               Uint64           _CommandQueueMask  = BufferDesc{}.CommandQueueMask) noexcept :
+    BufferDesc(Uint32            _uiSizeInBytes, 
+               BIND_FLAGS        _BindFlags,
+               USAGE             _Usage             = BufferDesc{}.Usage,
+               CPU_ACCESS_FLAGS  _CPUAccessFlags    = BufferDesc{}.CPUAccessFlags,
+               BUFFER_MODE       _Mode              = BufferDesc{}.Mode,
+               Uint32            _ElementByteStride = BufferDesc{}.ElementByteStride,
+               Uint64            _CommandQueueMask  = BufferDesc{}.CommandQueueMask,
+               MISC_BUFFER_FLAGS _MiscFlags         = BufferDesc{}.MiscFlags) noexcept :
         uiSizeInBytes       {_uiSizeInBytes    },
         BindFlags           {_BindFlags        },
         Usage               {_Usage            },
         CPUAccessFlags      {_CPUAccessFlags   },
         Mode                {_Mode             },
         ElementByteStride   {_ElementByteStride},
-        CommandQueueMask    {_CommandQueueMask }
+        CommandQueueMask    {_CommandQueueMask },
+        MiscFlags           {_MiscFlags        }
     {
     }
 
@@ -145,7 +167,8 @@ struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                CPUAccessFlags    == RHS.CPUAccessFlags    &&
                Mode              == RHS.Mode              &&
                ElementByteStride == RHS.ElementByteStride && 
-               CommandQueueMask  == RHS.CommandQueueMask;
+               CommandQueueMask  == RHS.CommandQueueMask  &&
+               MiscFlags         == RHS.MiscFlags;
     }
 #endif
 };
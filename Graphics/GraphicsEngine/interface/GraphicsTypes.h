@@ -974,12 +974,21 @@ DILIGENT_TYPED_ENUM(COMPARISON_FUNCTION, Uint8)
 /// The enumeration is used by TextureDesc to describe misc texture flags
 DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
 {
-    MISC_TEXTURE_FLAG_NONE          = 0x00,
+    MISC_TEXTURE_FLAG_NONE           = 0x00,
 
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS  = 0x01,
+
+    /// Allow the engine to move the texture to a different memory location
+    /// when defragmenting device memory.
+
+    /// \note Only single-sampled textures with USAGE_DEFAULT or USAGE_IMMUTABLE usage that
+    ///       are only bound as shader resources can be relocated. Creating any view other than
+    ///       the default shader resource view or binding the texture to a static or mutable shader
+    ///       variable disables relocation. The flag is currently only used by Vulkan backend.
+    MISC_TEXTURE_FLAG_DEFRAGMENTABLE = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -2003,7 +2012,10 @@ struct EngineCreateInfo
     DeviceFeatures Features;
 
     /// Pointer to the raw memory allocator that will be used for all memory allocation/deallocation
-    /// operations in the engine
+    /// operations in the engine.
+    ///
+    /// \remarks Diligent::SizeClassMemoryAllocator may be used to serve small allocations
+    ///          such as container nodes from size-class pools instead of the system heap.
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
 
     /// Pointer to the user-specified debug message callback function
@@ -2366,6 +2378,26 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Path to DirectX Shader Compiler, which is required to use Shader Model 6.0+
     /// features when compiling shaders from HLSL.
     const char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional initial data of the device pipeline cache, e.g. the blob previously
+    /// returned by IRenderDeviceVk::GetPipelineCacheData().
+
+    /// The engine creates a single Vulkan pipeline cache that is used by all pipeline
+    /// creation functions. If the data header does not match the physical device
+    /// (vendor, device or pipeline cache UUID), the data is ignored and the cache
+    /// starts empty. The blob is only accessed while the device is being created.
+    struct IDataBlob* pPipelineCacheData DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of worker threads that compile pipelines created with
+    /// PSO_CREATE_FLAG_ASYNCHRONOUS flag. If zero, the number of hardware threads
+    /// minus one is used. The threads are started when the first such pipeline is created.
+    Uint32 NumAsyncPipelineCompilationThreads DEFAULT_INITIALIZER(0);
+
+    /// Whether IDeviceContext::SetPipelineState() should wait for an asynchronously
+    /// compiled pipeline to become ready. If false, an attempt to bind a pipeline that
+    /// is still being compiled is rejected, and all draw and dispatch commands are skipped
+    /// until a ready pipeline is set. Use IPipelineState::GetStatus() to check if the pipeline is ready.
+    bool WaitForAsyncPipelinesOnBind DEFAULT_INITIALIZER(false);
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
 
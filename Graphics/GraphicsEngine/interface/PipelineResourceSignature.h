@@ -277,6 +277,21 @@ DILIGENT_BEGIN_INTERFACE(IPipelineResourceSignature, IDeviceObject)
     VIRTUAL IShaderResourceVariable* METHOD(GetStaticVariableByName)(THIS_
                                                                      SHADER_TYPE ShaderType,
                                                                      const Char* Name) PURE;
+
+
+    /// Returns static shader resource variable by its interned name.
+
+    /// \param [in] ShaderType   - Type of the shader to look up the variable.
+    ///                            Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] InternedName - Variable name returned by IRenderDevice::InternString()
+    ///                            of the device that created this signature.
+    ///
+    /// \remarks    Unlike GetStaticVariableByName(), the method compares the name pointers
+    ///             rather than the strings. If the name was not interned by the same device,
+    ///             the variable is not found.
+    VIRTUAL IShaderResourceVariable* METHOD(GetStaticVariableByInternedName)(THIS_
+                                                                             SHADER_TYPE ShaderType,
+                                                                             const Char* InternedName) PURE;
     
 
     /// Returns static shader resource variable by its index.
@@ -348,13 +363,14 @@ DILIGENT_END_INTERFACE
 
 #    define IPipelineResourceSignature_GetDesc(This) (const struct PipelineResourceSignatureDesc*)IDeviceObject_GetDesc(This)
 
-#    define IPipelineResourceSignature_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBinding, This, __VA_ARGS__)
-#    define IPipelineResourceSignature_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineResourceSignature, BindStaticResources,         This, __VA_ARGS__)
-#    define IPipelineResourceSignature_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByName,     This, __VA_ARGS__)
-#    define IPipelineResourceSignature_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByIndex,    This, __VA_ARGS__)
-#    define IPipelineResourceSignature_GetStaticVariableCount(This, ...)       CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableCount,      This, __VA_ARGS__)
-#    define IPipelineResourceSignature_InitializeStaticSRBResources(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, InitializeStaticSRBResources,This, __VA_ARGS__)
-#    define IPipelineResourceSignature_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineResourceSignature, IsCompatibleWith,            This, __VA_ARGS__)
+#    define IPipelineResourceSignature_CreateShaderResourceBinding(This, ...)     CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBinding,     This, __VA_ARGS__)
+#    define IPipelineResourceSignature_BindStaticResources(This, ...)             CALL_IFACE_METHOD(PipelineResourceSignature, BindStaticResources,             This, __VA_ARGS__)
+#    define IPipelineResourceSignature_GetStaticVariableByName(This, ...)         CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByName,         This, __VA_ARGS__)
+#    define IPipelineResourceSignature_GetStaticVariableByInternedName(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByInternedName, This, __VA_ARGS__)
+#    define IPipelineResourceSignature_GetStaticVariableByIndex(This, ...)        CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByIndex,        This, __VA_ARGS__)
+#    define IPipelineResourceSignature_GetStaticVariableCount(This, ...)          CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableCount,          This, __VA_ARGS__)
+#    define IPipelineResourceSignature_InitializeStaticSRBResources(This, ...)    CALL_IFACE_METHOD(PipelineResourceSignature, InitializeStaticSRBResources,    This, __VA_ARGS__)
+#    define IPipelineResourceSignature_IsCompatibleWith(This, ...)                CALL_IFACE_METHOD(PipelineResourceSignature, IsCompatibleWith,                This, __VA_ARGS__)
 
 // clang-format on
 
@@ -362,10 +362,42 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// that is not found in any of the designated shader stages.
     /// Use this flag to silence these warnings.
     PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS = 0x02,
+
+    /// Compile the pipeline asynchronously.
+
+    /// When this flag is set, the pipeline state object is returned as soon as its
+    /// resource layout is initialized, while shader module creation and the driver
+    /// compilation run on the engine worker threads. Use IPipelineState::GetStatus()
+    /// to query the compilation status. Shader resource bindings can be created
+    /// and static resources can be bound while the pipeline is compiling.
+    ///
+    /// The pipeline may be released at any time without waiting for the compilation.
+    /// The worker thread releases the shader references when it is done, and if the
+    /// application has released the pipeline in the meantime, the pipeline itself is
+    /// also destroyed by the worker thread.
+    ///
+    /// \note   Only graphics and compute pipelines in Vulkan backend are compiled asynchronously.
+    ///         Other pipelines and backends ignore the flag and create the pipeline synchronously.
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 0x04,
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint8)
+{
+    /// The pipeline is being compiled asynchronously.
+    PIPELINE_STATE_STATUS_COMPILING = 0,
+
+    /// The pipeline is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous compilation of the pipeline has failed. The pipeline
+    /// can't be used.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -568,6 +600,26 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
                                                                      SHADER_TYPE ShaderType,
                                                                      const Char* Name) PURE;
 
+
+    /// Returns static shader resource variable by its interned name. If the variable
+    /// is not found, returns nullptr.
+
+    /// \param [in] ShaderType   - The type of the shader to look up the variable.
+    ///                            Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] InternedName - Name of the variable returned by IRenderDevice::InternString()
+    ///                            of the device that created this pipeline.
+    ///
+    /// \remarks    Unlike GetStaticVariableByName(), the method compares the name pointers
+    ///             rather than the strings. If the name was not interned by the same device,
+    ///             the variable is not found.
+    ///
+    ///             This metod is only allowed for pipelines that use implicit resource signature.
+    ///             For pipelines that use explicit resource signatures, use
+    ///             IPipelineResourceSignature::GetStaticVariableByInternedName() method.
+    VIRTUAL IShaderResourceVariable* METHOD(GetStaticVariableByInternedName)(THIS_
+                                                                             SHADER_TYPE ShaderType,
+                                                                             const Char* InternedName) PURE;
+
     
     /// Returns static shader resource variable by its index.
 
@@ -671,6 +723,17 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true and the pipeline is being compiled asynchronously,
+    ///                                 the method blocks until the compilation is finished.
+    /// \return     Pipeline state status.
+    ///
+    /// \remarks    Pipelines that were not created with PSO_CREATE_FLAG_ASYNCHRONOUS flag
+    ///             are always in PIPELINE_STATE_STATUS_READY state.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -682,17 +745,19 @@ DILIGENT_END_INTERFACE
 
 #    define IPipelineState_GetDesc(This) (const struct PipelineStateDesc*)IDeviceObject_GetDesc(This)
 
-#    define IPipelineState_GetGraphicsPipelineDesc(This)           CALL_IFACE_METHOD(PipelineState, GetGraphicsPipelineDesc,      This)
-#    define IPipelineState_GetRayTracingPipelineDesc(This)         CALL_IFACE_METHOD(PipelineState, GetRayTracingPipelineDesc,    This)
-#    define IPipelineState_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineState, BindStaticResources,          This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableCount(This, ...)       CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,       This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,      This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,     This, __VA_ARGS__)
-#    define IPipelineState_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding,  This, __VA_ARGS__)
-#    define IPipelineState_InitializeStaticSRBResources(This, ...) CALL_IFACE_METHOD(PipelineState, InitializeStaticSRBResources, This, __VA_ARGS__)
-#    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
-#    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
-#    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetGraphicsPipelineDesc(This)              CALL_IFACE_METHOD(PipelineState, GetGraphicsPipelineDesc,         This)
+#    define IPipelineState_GetRayTracingPipelineDesc(This)            CALL_IFACE_METHOD(PipelineState, GetRayTracingPipelineDesc,       This)
+#    define IPipelineState_BindStaticResources(This, ...)             CALL_IFACE_METHOD(PipelineState, BindStaticResources,             This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableCount(This, ...)          CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,          This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByName(This, ...)         CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,         This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByInternedName(This, ...) CALL_IFACE_METHOD(PipelineState, GetStaticVariableByInternedName, This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByIndex(This, ...)        CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,        This, __VA_ARGS__)
+#    define IPipelineState_CreateShaderResourceBinding(This, ...)     CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding,     This, __VA_ARGS__)
+#    define IPipelineState_InitializeStaticSRBResources(This, ...)    CALL_IFACE_METHOD(PipelineState, InitializeStaticSRBResources,    This, __VA_ARGS__)
+#    define IPipelineState_IsCompatibleWith(This, ...)                CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,                This, __VA_ARGS__)
+#    define IPipelineState_GetResourceSignatureCount(This)            CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,       This)
+#    define IPipelineState_GetResourceSignature(This, ...)            CALL_IFACE_METHOD(PipelineState, GetResourceSignature,            This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                       CALL_IFACE_METHOD(PipelineState, GetStatus,                       This, __VA_ARGS__)
 
 // clang-format on
 
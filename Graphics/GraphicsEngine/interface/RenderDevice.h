@@ -339,6 +339,23 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     /// \remark This method does not increment the reference counter of the returned interface,
     ///         so the application should not call Release().
     VIRTUAL IEngineFactory* METHOD(GetEngineFactory)(THIS) CONST PURE;
+
+
+    /// Stores the string in the device string table and returns the pointer to the stored copy.
+
+    /// \param [in] Str - String to intern.
+    /// \return     Pointer to the interned string, or null if Str is null.
+    ///
+    /// \remarks    Every distinct string is stored once, so the method returns the same pointer for
+    ///             equal strings. The pointer remains valid for the lifetime of the device.
+    ///
+    ///             Resource names of all pipeline resource signatures created by the device are
+    ///             interned, so interned names can be used to find shader variables by comparing
+    ///             pointers rather than strings, see IShaderResourceBinding::GetVariableByInternedName(),
+    ///             IPipelineState::GetStaticVariableByInternedName() and
+    ///             IResourceMapping::GetResourceByInternedName().
+    VIRTUAL const Char* METHOD(InternString)(THIS_
+                                             const Char* Str) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -369,6 +386,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
+#    define IRenderDevice_InternString(This, ...)                    CALL_IFACE_METHOD(RenderDevice, InternString,                    This, __VA_ARGS__)
 // clang-format on
 
 #endif
@@ -164,6 +164,50 @@ DILIGENT_BEGIN_INTERFACE(IResourceMapping, IObject)
                                      IDeviceObject** ppResource,
                                      Uint32          ArrayIndex DEFAULT_VALUE(0)) PURE;
 
+
+    /// Adds a resource to the mapping using its interned name.
+
+    /// \param [in] InternedName - Resource name returned by IRenderDevice::InternString().
+    /// \param [in] pObject      - Pointer to the object.
+    /// \param [in] bIsUnique    - Flag indicating if a resource with the same name
+    ///                            is allowed to be found in the mapping.
+    /// \param [in] ArrayIndex   - For array resources, index in the array.
+    ///
+    /// \remarks The method is equivalent to AddResource(), but reuses the hash
+    ///          that was computed when the name was interned.
+    VIRTUAL void METHOD(AddResourceByInternedName)(THIS_
+                                                   const Char*    InternedName,
+                                                   IDeviceObject* pObject,
+                                                   bool           bIsUnique,
+                                                   Uint32         ArrayIndex DEFAULT_VALUE(0)) PURE;
+
+
+    /// Removes a resource from the mapping using its interned name.
+
+    /// \param [in] InternedName - Resource name returned by IRenderDevice::InternString().
+    /// \param [in] ArrayIndex   - For array resources, index in the array.
+    VIRTUAL void METHOD(RemoveResourceByInternedName)(THIS_
+                                                      const Char* InternedName,
+                                                      Uint32      ArrayIndex DEFAULT_VALUE(0)) PURE;
+
+
+    /// Finds a resource in the mapping using its interned name.
+
+    /// \param [in]  InternedName - Resource name returned by IRenderDevice::InternString().
+    /// \param [out] ppResource   - Address of the memory location where the pointer
+    ///                             to the object with the given name will be written.
+    ///                             If no object is found, nullptr will be written.
+    /// \param [in]  ArrayIndex   - For arrays, index of the array element.
+    ///
+    /// \remarks The method is equivalent to GetResource(), but reuses the hash
+    ///          that was computed when the name was interned.
+    ///          The method increases the reference counter of the returned object,
+    ///          so Release() must be called.
+    VIRTUAL void METHOD(GetResourceByInternedName)(THIS_
+                                                   const Char*     InternedName,
+                                                   IDeviceObject** ppResource,
+                                                   Uint32          ArrayIndex DEFAULT_VALUE(0)) PURE;
+
     /// Returns the size of the resource mapping, i.e. the number of objects.
     VIRTUAL size_t METHOD(GetSize)(THIS) PURE;
 };
@@ -175,11 +219,14 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IResourceMapping_AddResource(This, ...)          CALL_IFACE_METHOD(ResourceMapping, AddResource,          This, __VA_ARGS__)
-#    define IResourceMapping_AddResourceArray(This, ...)     CALL_IFACE_METHOD(ResourceMapping, AddResourceArray,     This, __VA_ARGS__)
-#    define IResourceMapping_RemoveResourceByName(This, ...) CALL_IFACE_METHOD(ResourceMapping, RemoveResourceByName, This, __VA_ARGS__)
-#    define IResourceMapping_GetResource(This, ...)          CALL_IFACE_METHOD(ResourceMapping, GetResource,          This, __VA_ARGS__)
-#    define IResourceMapping_GetSize(This)                   CALL_IFACE_METHOD(ResourceMapping, GetSize,              This)
+#    define IResourceMapping_AddResource(This, ...)                  CALL_IFACE_METHOD(ResourceMapping, AddResource,                  This, __VA_ARGS__)
+#    define IResourceMapping_AddResourceArray(This, ...)             CALL_IFACE_METHOD(ResourceMapping, AddResourceArray,             This, __VA_ARGS__)
+#    define IResourceMapping_RemoveResourceByName(This, ...)         CALL_IFACE_METHOD(ResourceMapping, RemoveResourceByName,         This, __VA_ARGS__)
+#    define IResourceMapping_GetResource(This, ...)                  CALL_IFACE_METHOD(ResourceMapping, GetResource,                  This, __VA_ARGS__)
+#    define IResourceMapping_AddResourceByInternedName(This, ...)    CALL_IFACE_METHOD(ResourceMapping, AddResourceByInternedName,    This, __VA_ARGS__)
+#    define IResourceMapping_RemoveResourceByInternedName(This, ...) CALL_IFACE_METHOD(ResourceMapping, RemoveResourceByInternedName, This, __VA_ARGS__)
+#    define IResourceMapping_GetResourceByInternedName(This, ...)    CALL_IFACE_METHOD(ResourceMapping, GetResourceByInternedName,    This, __VA_ARGS__)
+#    define IResourceMapping_GetSize(This)                           CALL_IFACE_METHOD(ResourceMapping, GetSize,                      This)
 
 // clang-format on
 
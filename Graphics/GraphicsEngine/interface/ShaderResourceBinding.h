@@ -95,6 +95,20 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
                                                                SHADER_TYPE ShaderType,
                                                                const char* Name) PURE;
 
+    /// Returns variable by its interned name
+
+    /// \param [in] ShaderType   - Type of the shader to look up the variable.
+    ///                            Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] InternedName - Variable name returned by IRenderDevice::InternString()
+    ///                            of the device that created this SRB.
+    ///
+    /// \remarks Unlike GetVariableByName(), the method compares the name pointers rather
+    ///          than the strings. If the name was not interned by the same device, the
+    ///          variable is not found.
+    VIRTUAL IShaderResourceVariable* METHOD(GetVariableByInternedName)(THIS_
+                                                                       SHADER_TYPE ShaderType,
+                                                                       const char* InternedName) PURE;
+
     /// Returns the total variable count for the specific shader stage.
 
     /// \param [in] ShaderType - Type of the shader.
@@ -131,12 +145,13 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IShaderResourceBinding_GetPipelineResourceSignature(This) CALL_IFACE_METHOD(ShaderResourceBinding, GetPipelineResourceSignature, This)
-#    define IShaderResourceBinding_BindResources(This, ...)           CALL_IFACE_METHOD(ShaderResourceBinding, BindResources,                This, __VA_ARGS__)
-#    define IShaderResourceBinding_GetVariableByName(This, ...)       CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByName,            This, __VA_ARGS__)
-#    define IShaderResourceBinding_GetVariableCount(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,             This, __VA_ARGS__)
-#    define IShaderResourceBinding_GetVariableByIndex(This, ...)      CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,           This, __VA_ARGS__)
-#    define IShaderResourceBinding_StaticResourcesInitialized(This)   CALL_IFACE_METHOD(ShaderResourceBinding, StaticResourcesInitialized,   This)
+#    define IShaderResourceBinding_GetPipelineResourceSignature(This)   CALL_IFACE_METHOD(ShaderResourceBinding, GetPipelineResourceSignature, This)
+#    define IShaderResourceBinding_BindResources(This, ...)             CALL_IFACE_METHOD(ShaderResourceBinding, BindResources,                This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableByName(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByName,            This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableByInternedName(This, ...) CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByInternedName,    This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableCount(This, ...)          CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,             This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableByIndex(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,           This, __VA_ARGS__)
+#    define IShaderResourceBinding_StaticResourcesInitialized(This)     CALL_IFACE_METHOD(ShaderResourceBinding, StaticResourcesInitialized,   This)
 
 // clang-format on
 
@@ -30,7 +30,8 @@
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
-#include "BasicFileStream.hpp"
+#include "MappedFileStream.hpp"
+#include "FileSystem.hpp"
 
 namespace Diligent
 {
@@ -90,27 +91,28 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
                                                           CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                           IFileStream**                           ppStream)
 {
-    bool                                     bFileCreated = false;
-    Diligent::RefCntAutoPtr<BasicFileStream> pBasicFileStream;
+    bool                                      bFileCreated = false;
+    Diligent::RefCntAutoPtr<MappedFileStream> pFileStream;
     for (const auto& SearchDir : m_SearchDirectories)
     {
         String FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
         if (!FileSystem::FileExists(FullPath.c_str()))
             continue;
-        pBasicFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
-        if (pBasicFileStream->IsValid())
+        // Shader source files are memory-mapped so that they can be consumed without copying (see ReadStreamData())
+        pFileStream = MakeNewRCObj<MappedFileStream>()(FullPath.c_str(), EMappedFileAccessHint::Sequential);
+        if (pFileStream->IsValid())
         {
             bFileCreated = true;
             break;
         }
         else
         {
-            pBasicFileStream.Release();
+            pFileStream.Release();
         }
     }
     if (bFileCreated)
     {
-        pBasicFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+        pFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
     }
     else
     {
@@ -35,9 +35,14 @@ ResourceMappingImpl::~ResourceMappingImpl()
 {
 }
 
-ThreadingTools::LockHelper ResourceMappingImpl::Lock()
+ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveSharedLock> ResourceMappingImpl::Lock()
 {
-    return ThreadingTools::LockHelper(m_LockFlag);
+    return ThreadingTools::ExclusiveLockGuard<ThreadingTools::AdaptiveSharedLock>{m_Lock};
+}
+
+ThreadingTools::SharedLockGuard ResourceMappingImpl::LockShared()
+{
+    return ThreadingTools::SharedLockGuard{m_Lock};
 }
 
 void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex, IDeviceObject* const* ppObjects, Uint32 NumElements, bool bIsUnique)
@@ -47,24 +52,36 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
 
     auto LockHelper = Lock();
     for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
-    {
-        auto* pObject = ppObjects[Elem];
+        AddResourceImpl(ResMappingHashKey{Name, true /*Make copy*/, StartIndex + Elem}, ppObjects[Elem], bIsUnique);
+}
+
+void ResourceMappingImpl::AddResourceByInternedName(const Char* InternedName, IDeviceObject* pObject, bool bIsUnique, Uint32 ArrayIndex)
+{
+    const auto Name = InternedString::FromInternedStr(InternedName);
+    if (!Name || Name.GetLength() == 0)
+        return;
+
+    auto LockHelper = Lock();
+    // The name is copied because the mapping may outlive the device that interned it
+    AddResourceImpl(ResMappingHashKey{Name, true /*Make copy*/, ArrayIndex}, pObject, bIsUnique);
+}
 
-        // Try to construct new element in place
-        auto Elems = m_HashTable.emplace(ResMappingHashKey{Name, true /*Make copy*/, StartIndex + Elem}, pObject);
-        // If there is already element with the same name, replace it
-        if (!Elems.second && Elems.first->second != pObject)
+void ResourceMappingImpl::AddResourceImpl(ResMappingHashKey&& Key, IDeviceObject* pObject, bool bIsUnique)
+{
+    // Try to construct new element in place
+    auto Elems = m_HashTable.try_emplace(std::move(Key), pObject);
+    // If there is already element with the same name, replace it
+    if (!Elems.second && Elems.first->second != pObject)
+    {
+        if (bIsUnique)
         {
-            if (bIsUnique)
-            {
-                UNEXPECTED("Resource with the same name already exists");
-                LOG_WARNING_MESSAGE(
-                    "Resource with name ", Name,
-                    " marked is unique, but already present in the hash.\n"
-                    "New resource will be used\n.");
-            }
-            Elems.first->second = pObject;
+            UNEXPECTED("Resource with the same name already exists");
+            LOG_WARNING_MESSAGE(
+                "Resource with name ", Elems.first->first.GetStr(),
+                " marked is unique, but already present in the hash.\n"
+                "New resource will be used\n.");
         }
+        Elems.first->second = pObject;
     }
 }
 
@@ -84,6 +101,16 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
     m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
 }
 
+void ResourceMappingImpl::RemoveResourceByInternedName(const Char* InternedName, Uint32 ArrayIndex)
+{
+    const auto Name = InternedString::FromInternedStr(InternedName);
+    if (!Name || Name.GetLength() == 0)
+        return;
+
+    auto LockHelper = Lock();
+    m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
+}
+
 void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResource, Uint32 ArrayIndex)
 {
     VERIFY(Name, "Name is null");
@@ -94,14 +121,34 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
     if (!ppResource)
         return;
 
+    // Name will be implicitly converted to HashMapStringKey without making a copy
+    GetResourceImpl(ResMappingHashKey{Name, false, ArrayIndex}, ppResource);
+}
+
+void ResourceMappingImpl::GetResourceByInternedName(const Char* InternedName, IDeviceObject** ppResource, Uint32 ArrayIndex)
+{
+    VERIFY(ppResource, "Null pointer provided");
+    if (!ppResource)
+        return;
+
+    const auto Name = InternedString::FromInternedStr(InternedName);
+    if (!Name || Name.GetLength() == 0)
+        return;
+
+    // The key points to the interned string and reuses its hash, so the
+    // strings are only compared when the hashes match
+    GetResourceImpl(ResMappingHashKey{Name, false, ArrayIndex}, ppResource);
+}
+
+void ResourceMappingImpl::GetResourceImpl(const ResMappingHashKey& Key, IDeviceObject** ppResource)
+{
     VERIFY(*ppResource == nullptr, "Overwriting reference to existing object may cause memory leaks");
     *ppResource = nullptr;
 
-    auto LockHelper = Lock();
+    auto LockHelper = LockShared();
 
     // Find an object with the requested name
-    // Name will be implicitly converted to HashMapStringKey without making a copy
-    auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
+    auto It = m_HashTable.find(Key);
     if (It != m_HashTable.end())
     {
         *ppResource = It->second.RawPtr();
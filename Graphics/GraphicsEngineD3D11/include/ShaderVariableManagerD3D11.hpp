@@ -181,6 +181,7 @@ public:
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
 
     IShaderResourceVariable* GetVariable(const Char* Name) const;
+    IShaderResourceVariable* GetVariable(const InternedString& Name) const;
     IShaderResourceVariable* GetVariable(Uint32 Index) const;
 
     IObject& GetOwner() { return m_Owner; }
@@ -241,7 +242,9 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceByName(const Char* Name, bool ComparePointers) const;
+
+    IShaderResourceVariable* FindVariable(const Char* Name, bool ComparePointers) const;
 
     template <typename THandleCB,
               typename THandleTexSRV,
@@ -505,13 +505,14 @@ void ShaderVariableManagerD3D11::BindResources(IResourceMapping* pResourceMappin
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByName(const Char* Name, bool ComparePointers) const
 {
     auto NumResources = GetNumResources<ResourceType>();
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         auto& Resource = GetResource<ResourceType>(res);
-        if (strcmp(Resource.GetDesc().Name, Name) == 0)
+        const auto* ResName = Resource.GetDesc().Name;
+        if (ComparePointers ? ResName == Name : strcmp(ResName, Name) == 0)
             return &Resource;
     }
 
@@ -520,25 +521,37 @@ IShaderResourceVariable* ShaderVariableManagerD3D11::GetResourceByName(const Cha
 
 IShaderResourceVariable* ShaderVariableManagerD3D11::GetVariable(const Char* Name) const
 {
-    if (auto* pCB = GetResourceByName<ConstBuffBindInfo>(Name))
+    return FindVariable(Name, false);
+}
+
+IShaderResourceVariable* ShaderVariableManagerD3D11::GetVariable(const InternedString& Name) const
+{
+    // Resource names are interned by the device that created the
+    // signature, so the variable is found by comparing the pointers
+    return FindVariable(Name.GetStr(), true);
+}
+
+IShaderResourceVariable* ShaderVariableManagerD3D11::FindVariable(const Char* Name, bool ComparePointers) const
+{
+    if (auto* pCB = GetResourceByName<ConstBuffBindInfo>(Name, ComparePointers))
         return pCB;
 
-    if (auto* pTexSRV = GetResourceByName<TexSRVBindInfo>(Name))
+    if (auto* pTexSRV = GetResourceByName<TexSRVBindInfo>(Name, ComparePointers))
         return pTexSRV;
 
-    if (auto* pTexUAV = GetResourceByName<TexUAVBindInfo>(Name))
+    if (auto* pTexUAV = GetResourceByName<TexUAVBindInfo>(Name, ComparePointers))
         return pTexUAV;
 
-    if (auto* pBuffSRV = GetResourceByName<BuffSRVBindInfo>(Name))
+    if (auto* pBuffSRV = GetResourceByName<BuffSRVBindInfo>(Name, ComparePointers))
         return pBuffSRV;
 
-    if (auto* pBuffUAV = GetResourceByName<BuffUAVBindInfo>(Name))
+    if (auto* pBuffUAV = GetResourceByName<BuffUAVBindInfo>(Name, ComparePointers))
         return pBuffUAV;
 
     if (!m_pSignature->IsUsingCombinedSamplers())
     {
         // Immutable samplers are never created in the resource layout
-        if (auto* pSampler = GetResourceByName<SamplerBindInfo>(Name))
+        if (auto* pSampler = GetResourceByName<SamplerBindInfo>(Name, ComparePointers))
             return pSampler;
     }
 
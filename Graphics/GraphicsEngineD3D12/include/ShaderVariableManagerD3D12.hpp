@@ -96,6 +96,7 @@ public:
     void Destroy(IMemoryAllocator& Allocator);
 
     ShaderVariableD3D12Impl* GetVariable(const Char* Name) const;
+    ShaderVariableD3D12Impl* GetVariable(const InternedString& Name) const;
     ShaderVariableD3D12Impl* GetVariable(Uint32 Index) const;
 
     // Binds object pObj to resource with index ResIndex and array index ArrayIndex.
@@ -157,6 +157,21 @@ ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Nam
 }
 
 
+ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const InternedString& Name) const
+{
+    // Resource names are interned by the device that created the
+    // signature, so the variable is found by comparing the pointers
+    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    {
+        auto& Var = m_pVariables[v];
+        if (Var.GetDesc().Name == Name.GetStr())
+            return &Var;
+    }
+
+    return nullptr;
+}
+
+
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(Uint32 Index) const
 {
     if (Index >= m_NumVariables)
@@ -369,7 +369,8 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
                                            MipProps.RowSize,
                                            reinterpret_cast<Uint8*>(pStagingData) + DstFootprint.Offset,
                                            DstFootprint.Footprint.RowPitch,
-                                           DstFootprint.Footprint.RowPitch * DstFootprint.Footprint.Height / FmtAttribs.BlockHeight // DstDepthStride
+                                           DstFootprint.Footprint.RowPitch * DstFootprint.Footprint.Height / FmtAttribs.BlockHeight, // DstDepthStride
+                                           COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED                                                // Upload heap memory is write-combined
                     );
                 }
             }
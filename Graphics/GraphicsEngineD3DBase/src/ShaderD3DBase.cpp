@@ -38,7 +38,7 @@
 #include "dxc/dxcapi.h"
 
 #include "D3DErrors.hpp"
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderD3DBase.hpp"
 #include "DXCompiler.hpp"
@@ -71,8 +71,7 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>{}(0));
-        pSourceStream->ReadBlob(pFileData);
+        auto pFileData = ReadStreamData(pSourceStream);
         *ppData = pFileData->GetDataPtr();
         *pBytes = static_cast<UINT>(pFileData->GetSize());
 
@@ -35,7 +35,7 @@
 #include <vector>
 #include <atomic>
 #include "VariableSizeAllocationsManager.hpp"
-#include "RingBuffer.hpp"
+#include "ConcurrentRingBuffer.hpp"
 
 namespace Diligent
 {
@@ -51,13 +51,13 @@ namespace DynamicHeap
 class MasterBlockRingBufferBasedManager
 {
 public:
-    using OffsetType                                = RingBuffer::OffsetType;
-    using MasterBlock                               = RingBuffer::OffsetType;
-    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+    using OffsetType                                = ConcurrentRingBuffer::OffsetType;
+    using MasterBlock                               = ConcurrentRingBuffer::OffsetType;
+    static constexpr const OffsetType InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
 
-    MasterBlockRingBufferBasedManager(IMemoryAllocator& Allocator,
-                                      Uint32            Size) :
-        m_RingBuffer{Size, Allocator}
+    MasterBlockRingBufferBasedManager(IMemoryAllocator& /*Allocator*/,
+                                      Uint32 Size) :
+        m_RingBuffer{Size}
     {}
 
     // clang-format off
@@ -69,13 +69,14 @@ public:
 
     void DiscardMasterBlocks(std::vector<MasterBlock>& /*Blocks*/, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        // Frames may be discarded by multiple contexts
+        std::lock_guard<std::mutex> Lock{m_FinishFrameMtx};
         m_RingBuffer.FinishCurrentFrame(FenceValue);
     }
 
     void ReleaseStaleBlocks(Uint64 LastCompletedFenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        std::lock_guard<std::mutex> Lock{m_ReleaseFramesMtx};
         m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
     }
 
@@ -85,13 +86,14 @@ public:
 protected:
     MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        // Master blocks are allocated without locking
         return m_RingBuffer.Allocate(SizeInBytes, Alignment);
     }
 
 private:
-    std::mutex m_RingBufferMtx;
-    RingBuffer m_RingBuffer;
+    std::mutex           m_FinishFrameMtx;
+    std::mutex           m_ReleaseFramesMtx;
+    ConcurrentRingBuffer m_RingBuffer;
 };
 
 
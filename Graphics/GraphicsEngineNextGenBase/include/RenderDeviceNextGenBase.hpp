@@ -106,7 +106,7 @@ public:
             return;
 
         Atomics::Long NumReferences = PlatformMisc::CountOneBits(QueueMask);
-        auto          Wrapper       = DynamicStaleResourceWrapper::Create(std::move(Object), NumReferences);
+        auto          Wrapper       = DynamicStaleResourceWrapper::Create(std::move(Object), NumReferences, &this->m_RawMemAllocator);
 
         while (QueueMask != 0)
         {
@@ -299,7 +299,7 @@ protected:
     {
         CommandQueue(RefCntAutoPtr<CommandQueueType> _CmdQueue, IMemoryAllocator& Allocator) noexcept :
             CmdQueue{std::move(_CmdQueue)},
-            ReleaseQueue{Allocator}
+            ReleaseQueue{Allocator, &Allocator}
         {
             NextCmdBufferNumber.store(0);
         }
@@ -32,6 +32,7 @@
 #include "LockHelper.hpp"
 #include "HashUtils.hpp"
 #include "GLObjectWrapper.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -57,6 +58,8 @@ public:
                                                         TextureViewGLImpl* ppRTVs[],
                                                         TextureViewGLImpl* pDSV);
 
+    // Note that the returned reference is only valid until the next call to GetFBO(),
+    // as adding new FBOs to the cache may relocate existing ones.
     const GLObjectWrappers::GLFrameBufferObj& GetFBO(Uint32             NumRenderTargets,
                                                      TextureViewGLImpl* ppRTVs[],
                                                      TextureViewGLImpl* pDSV,
@@ -92,8 +95,8 @@ private:
 
 
     friend class RenderDeviceGLImpl;
-    ThreadingTools::LockFlag                                                                 m_CacheLockFlag;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    ThreadingTools::LockFlag                                                          m_CacheLockFlag;
+    FlatHashMap<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
 
     // Multimap that sets up correspondence between unique texture id and all
     // FBOs it is used in
@@ -183,6 +183,7 @@ public:
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
 
     IShaderResourceVariable* GetVariable(const Char* Name) const;
+    IShaderResourceVariable* GetVariable(const InternedString& Name) const;
     IShaderResourceVariable* GetVariable(Uint32 Index) const;
 
     IObject& GetOwner() { return m_Owner; }
@@ -238,7 +239,9 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceByName(const Char* Name, bool ComparePointers) const;
+
+    IShaderResourceVariable* FindVariable(const Char* Name, bool ComparePointers) const;
 
     template <typename THandleUB,
               typename THandleTexture,
@@ -37,6 +37,7 @@
 #include "LockHelper.hpp"
 #include "HashUtils.hpp"
 #include "DeviceContextBase.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -64,6 +65,8 @@ public:
         VertexStreamInfo<BufferGLImpl>* const VertexStreams;
         const Uint32                          NumVertexStreams;
     };
+    // Note that the returned reference is only valid until the next call to GetVAO(),
+    // as adding new VAOs to the cache may relocate existing ones.
     const GLObjectWrappers::GLVertexArrayObj& GetVAO(const VAOAttribs&     Attribs,
                                                      class GLContextState& GLContextState);
     const GLObjectWrappers::GLVertexArrayObj& GetEmptyVAO();
@@ -120,8 +123,8 @@ private:
     // Clears stale entries from m_PSOToKey and m_BuffToKey when a VAO is removed from m_Cache
     void ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys);
 
-    ThreadingTools::LockFlag                                                               m_CacheLockFlag;
-    std::unordered_map<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
+    ThreadingTools::LockFlag                                                        m_CacheLockFlag;
+    FlatHashMap<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
 
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_PSOToKey;
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_BuffToKey;
@@ -411,14 +411,14 @@ void ShaderVariableManagerGL::BindResources(IResourceMapping* pResourceMapping,
 
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char* Name, bool ComparePointers) const
 {
     auto NumResources = GetNumResources<ResourceType>();
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         auto&       Resource = GetResource<ResourceType>(res);
         const auto& ResDesc  = Resource.GetDesc();
-        if (strcmp(ResDesc.Name, Name) == 0)
+        if (ComparePointers ? ResDesc.Name == Name : strcmp(ResDesc.Name, Name) == 0)
             return &Resource;
     }
 
@@ -428,16 +428,28 @@ IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char*
 
 IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(const Char* Name) const
 {
-    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(Name))
+    return FindVariable(Name, false);
+}
+
+IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(const InternedString& Name) const
+{
+    // Resource names are interned by the device that created the
+    // signature, so the variable is found by comparing the pointers
+    return FindVariable(Name.GetStr(), true);
+}
+
+IShaderResourceVariable* ShaderVariableManagerGL::FindVariable(const Char* Name, bool ComparePointers) const
+{
+    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(Name, ComparePointers))
         return pUB;
 
-    if (auto* pTexture = GetResourceByName<TextureBindInfo>(Name))
+    if (auto* pTexture = GetResourceByName<TextureBindInfo>(Name, ComparePointers))
         return pTexture;
 
-    if (auto* pImage = GetResourceByName<ImageBindInfo>(Name))
+    if (auto* pImage = GetResourceByName<ImageBindInfo>(Name, ComparePointers))
         return pImage;
 
-    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(Name))
+    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(Name, ComparePointers))
         return pSSBO;
 
     return nullptr;
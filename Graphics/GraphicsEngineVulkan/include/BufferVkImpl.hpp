@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::BufferVkImpl class
 
+#include <atomic>
+
 #include "EngineVkImplTraits.hpp"
 #include "BufferBase.hpp"
 #include "BufferViewVkImpl.hpp" // Required by BufferBase
@@ -116,11 +118,21 @@ public:
         return reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory()) + m_BufferMemoryAlignedOffset;
     }
 
+    // Prevents DeviceContextVkImpl::DefragmentMemory() from moving the buffer. This is required
+    // when the Vulkan handle is written to a descriptor set that is not updated on relocation.
+    void DisableRelocation();
+
 private:
     friend class DeviceContextVkImpl;
 
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
+    // Replaces the buffer and its memory with the ones the contents have been copied to by
+    // DeviceContextVkImpl::DefragmentMemory(). Old objects are safe-released.
+    void Relocate(VulkanUtilities::BufferWrapper&&          NewBuffer,
+                  VulkanUtilities::VulkanMemoryAllocation&& NewAllocation,
+                  VkDeviceSize                              NewAlignedOffset);
+
     VulkanUtilities::BufferViewWrapper CreateView(struct BufferViewDesc& ViewDesc);
 
     Uint32       m_DynamicOffsetAlignment    = 0;
@@ -146,6 +158,12 @@ private:
 
     VulkanUtilities::BufferWrapper          m_VulkanBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+
+    // Usage flags the buffer was created with; they are required to recreate the buffer when it is relocated.
+    VkBufferUsageFlags m_VkUsageFlags = 0;
+
+    // Indicates if the buffer is registered in the device as relocatable
+    std::atomic<bool> m_bIsRelocatable{false};
 };
 
 } // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::DeviceContextVkImpl class
 
 #include <unordered_map>
+#include <unordered_set>
 #include <bitset>
 
 #include "EngineVkImplTraits.hpp"
@@ -304,6 +305,9 @@ public:
     /// Implementation of IDeviceContextVk::BufferMemoryBarrier().
     virtual void DILIGENT_CALL_TYPE BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags) override final;
 
+    /// Implementation of IDeviceContextVk::DefragmentMemory().
+    virtual void DILIGENT_CALL_TYPE DefragmentMemory(const DefragmentMemoryAttribsVk& Attribs, DefragmentMemoryStatsVk* pStats) override final;
+
 
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
@@ -400,6 +404,13 @@ private:
     void Flush(Uint32               NumCommandLists,
                ICommandList* const* ppCommandLists);
 
+    using MemoryPageSet = std::unordered_set<const VulkanUtilities::VulkanMemoryPage*>;
+
+    // Copy the resource to new memory allocated outside of the ExcludedPages and record the copy commands.
+    // Return the number of bytes moved or zero if the resource could not be relocated.
+    VkDeviceSize RelocateBuffer(BufferVkImpl& BufferVk, const MemoryPageSet& ExcludedPages);
+    VkDeviceSize RelocateTexture(TextureVkImpl& TextureVk, const MemoryPageSet& ExcludedPages);
+
     __forceinline void TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                      RESOURCE_STATE                 RequiredState,
@@ -431,9 +442,13 @@ private:
         {
             auto vkCmdBuff = m_CmdPool->GetCommandBuffer();
             m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff);
+            if (m_bIsDeferred)
+                OnDeferredCmdBufferStarted();
         }
     }
 
+    void OnDeferredCmdBufferStarted();
+
     inline void DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
     inline void DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue);
 
@@ -601,6 +616,13 @@ private:
     std::unique_ptr<QueryManagerVk> m_QueryMgr;
     Int32                           m_ActiveQueriesCounter = 0;
 
+    // Whether SetPipelineState() waits for asynchronously compiled pipelines
+    bool m_WaitForAsyncPipelines = false;
+
+    // Whether the last SetPipelineState() call was rejected because the pipeline
+    // is still compiling. Draw and dispatch commands are skipped while it is set.
+    bool m_PipelineNotReady = false;
+
     std::vector<VkClearValue> m_vkClearValues;
 
     VulkanUtilities::QueryPoolWrapper m_ASQueryPool;
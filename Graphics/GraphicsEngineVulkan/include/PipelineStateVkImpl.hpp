@@ -32,6 +32,9 @@
 
 #include <array>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -64,10 +67,21 @@ public:
     virtual IRenderPassVk* DILIGENT_CALL_TYPE GetRenderPass() const override final { return GetRenderPassPtr().RawPtr<IRenderPassVk>(); }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    /// Returns VK_NULL_HANDLE while the pipeline is being compiled asynchronously.
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        return m_Status.load() == PIPELINE_STATE_STATUS_READY ? static_cast<VkPipeline>(m_Pipeline) : VK_NULL_HANDLE;
+    }
+
+    /// Implementation of IPipelineState::GetStatus() in Vulkan backend.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final;
 
     const PipelineLayoutVk& GetPipelineLayout() const { return m_PipelineLayout; }
 
+    /// Enqueues the compilation of a pipeline created with PSO_CREATE_FLAG_ASYNCHRONOUS flag.
+    /// The method must be called once the pipeline is fully constructed and referenced.
+    void StartAsyncCompilation();
+
     static RenderPassDesc GetImplicitRenderPassDesc(Uint32                                                        NumRenderTargets,
                                                     const TEXTURE_FORMAT                                          RTVFormats[],
                                                     TEXTURE_FORMAT                                                DSVFormat,
@@ -107,9 +121,15 @@ public:
 
 private:
     template <typename PSOCreateInfoType>
-    TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
-                                      std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules);
+    TShaderStages InitInternalObjects(const PSOCreateInfoType& CreateInfo);
+
+    // Creates graphics or compute pipeline immediately or, if PSO_CREATE_FLAG_ASYNCHRONOUS
+    // flag is set, prepares the data for StartAsyncCompilation().
+    void InitPipeline(TShaderStages&& ShaderStages, PSO_CREATE_FLAGS Flags);
+
+    void CreatePipeline(TShaderStages& ShaderStages);
+
+    void CompilePipelineAsync();
 
     void InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
                             TShaderStages&                 ShaderStages);
@@ -123,6 +143,23 @@ private:
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayoutVk                 m_PipelineLayout;
 
+    struct AsyncCompileData
+    {
+        TShaderStages ShaderStages;
+
+        // Strong references that keep the shaders alive until the compilation is finished
+        std::vector<RefCntAutoPtr<IShader>> Shaders;
+    };
+    // Only accessed by the constructor and then by the worker thread that compiles the pipeline.
+    // The worker releases the data once the compilation is finished, so the shaders may be
+    // destroyed by the worker thread.
+    std::unique_ptr<AsyncCompileData> m_pAsyncCompileData;
+
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    std::mutex              m_CompileMtx;
+    std::condition_variable m_CompileCV;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages
     std::vector<std::shared_ptr<const SPIRVShaderResources>> m_ShaderResources;
@@ -29,7 +29,11 @@
 
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "EngineVkImplTraits.hpp"
 
@@ -50,6 +54,8 @@
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
+#include "ThreadPool.hpp"
+#include "MemoryBudgetTracker.hpp"
 
 namespace Diligent
 {
@@ -175,6 +181,26 @@ public:
                                                                  RESOURCE_STATE             InitialState,
                                                                  ITopLevelAS**              ppTLAS) override final;
 
+    /// Implementation of IRenderDeviceVk::GetVkPipelineCache().
+    virtual VkPipelineCache DILIGENT_CALL_TYPE GetVkPipelineCache() override final { return m_PipelineCache; }
+
+    /// Implementation of IRenderDeviceVk::GetPipelineCacheData().
+    virtual void DILIGENT_CALL_TYPE GetPipelineCacheData(IDataBlob** ppData) override final;
+
+    /// Implementation of IRenderDeviceVk::GetMemoryBudget().
+    virtual void DILIGENT_CALL_TYPE GetMemoryBudget(MemoryBudgetVk* pBudget) override final;
+
+    /// Implementation of IRenderDeviceVk::RegisterMemoryBudgetCallback().
+    virtual Uint32 DILIGENT_CALL_TYPE RegisterMemoryBudgetCallback(float                  Threshold,
+                                                                   MemoryBudgetCallbackVk Callback,
+                                                                   void*                  pUserData) override final;
+
+    /// Implementation of IRenderDeviceVk::UnregisterMemoryBudgetCallback().
+    virtual void DILIGENT_CALL_TYPE UnregisterMemoryBudgetCallback(Uint32 CallbackId) override final;
+
+    /// Implementation of IRenderDeviceVk::SetMemoryBudgetOverride().
+    virtual void DILIGENT_CALL_TYPE SetMemoryBudgetOverride(const MemoryBudgetVk* pBudget) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -213,14 +239,46 @@ public:
         const auto MemoryFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
         return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags);
     }
+    VulkanUtilities::VulkanMemoryAllocation AllocateDedicatedMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkImage vkImage)
+    {
+        return m_MemoryMgr.AllocateDedicated(MemReqs, MemoryProperties, vkImage);
+    }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    // Buffers and textures that can be moved to other memory pages by DeviceContextVkImpl::DefragmentMemory().
+    void RegisterRelocatableResource(BufferVkImpl* pBuffer);
+    void RegisterRelocatableResource(TextureVkImpl* pTexture);
+    void UnregisterRelocatableResource(BufferVkImpl* pBuffer);
+    void UnregisterRelocatableResource(TextureVkImpl* pTexture);
+
+    // Calls Handler(Buffers, Textures) while holding the registry lock. A resource that is being destroyed
+    // blocks in UnregisterRelocatableResource() until the handler returns, so the handler may safely
+    // access all resources in the sets.
+    template <typename HandlerType>
+    void ProcessRelocatableResources(HandlerType&& Handler)
+    {
+        std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+        Handler(m_RelocatableBuffers, m_RelocatableTextures);
+    }
+
+    // Command buffers recorded by deferred contexts keep the Vulkan handles of the resources they reference,
+    // so resources must not be relocated until all these command buffers are submitted or discarded.
+    void AddPendingDeferredCmdBuffer();
+    void RemovePendingDeferredCmdBuffers(Uint32 NumCmdBuffers);
+
+    // Must only be called by the ProcessRelocatableResources() handler
+    Uint32 GetNumPendingDeferredCmdBuffers() const { return m_NumPendingDeferredCmdBuffers; }
+
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
+    // Returns the pool that compiles pipelines created with PSO_CREATE_FLAG_ASYNCHRONOUS flag.
+    // The worker threads are started when the pool is requested for the first time.
+    ThreadPool& GetPipelineCompilerPool();
+
     struct Properties
     {
         const Uint32 ShaderGroupHandleSize;
@@ -239,6 +297,18 @@ public:
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
 
+    void CreatePipelineCache(IDataBlob* pInitialData);
+
+    // Queries the memory budget, or returns the override if it is set. Must be called with m_MemoryBudgetMtx locked.
+    void QueryMemoryBudget(MemoryBudgetVk& Budget) const;
+
+    // Queries the memory budget and queues the callbacks whose thresholds were crossed.
+    void UpdateMemoryBudget(MemoryBudgetVk* pBudget);
+
+    // Calls the queued memory budget callbacks. Must not be called while the engine holds
+    // any locks or is in the middle of a command buffer submission.
+    void DeliverMemoryBudgetCallbacks();
+
     // Submits command buffer(s) for execution to the command queue and
     // returns the submitted command buffer(s) number and the fence value.
     // If SubmitInfo contains multiple command buffers, they all are treated
@@ -272,10 +342,49 @@ private:
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
+    // Device-wide pipeline cache that is used by all pipeline creation functions.
+    // Vulkan pipeline caches are internally synchronized.
+    VulkanUtilities::PipelineCacheWrapper m_PipelineCache;
+
     const Uint32                 m_VkVersion; // Must be defined before m_pDxCompiler
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 
     Properties m_Properties;
+
+    std::mutex                  m_PipelineCompilerPoolMtx;
+    std::unique_ptr<ThreadPool> m_pPipelineCompilerPool;
+
+    std::mutex                         m_RelocatableResourcesMtx;
+    std::unordered_set<BufferVkImpl*>  m_RelocatableBuffers;
+    std::unordered_set<TextureVkImpl*> m_RelocatableTextures;
+    Uint32                             m_NumPendingDeferredCmdBuffers = 0; // Protected by m_RelocatableResourcesMtx
+
+    struct MemoryBudgetCallbackInfo
+    {
+        MemoryBudgetCallbackVk Callback  = nullptr;
+        void*                  pUserData = nullptr;
+    };
+    struct PendingMemoryBudgetCallback
+    {
+        Uint32             CallbackId = 0;
+        Uint32             HeapIndex  = 0;
+        bool               Exceeded   = false;
+        MemoryHeapBudgetVk Heap;
+    };
+    // Callbacks are keyed by the threshold id in m_MemoryBudgetTracker.
+    // User callbacks are never called while m_MemoryBudgetMtx is locked.
+    std::mutex                                           m_MemoryBudgetMtx;
+    MemoryBudgetTracker                                  m_MemoryBudgetTracker;
+    std::unordered_map<Uint32, MemoryBudgetCallbackInfo> m_MemoryBudgetCallbacks;
+    std::unique_ptr<MemoryBudgetVk>                      m_pMemoryBudgetOverride;
+    std::vector<MemoryBudgetThresholdEvent>              m_MemoryBudgetEvents;
+    std::vector<PendingMemoryBudgetCallback>             m_PendingMemoryBudgetCallbacks;
+
+    // Held while the callbacks are called, so that UnregisterMemoryBudgetCallback() can wait for them.
+    // The mutex is recursive to let the callbacks unregister themselves and query the budget.
+    std::recursive_mutex m_MemoryBudgetDeliveryMtx;
+
+    std::atomic<Uint32> m_NumMemoryBudgetCallbacks{0};
 };
 
 } // namespace Diligent
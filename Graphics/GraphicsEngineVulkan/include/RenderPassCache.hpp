@@ -30,7 +30,6 @@
 /// \file
 /// Declaration of Diligent::RenderPassCache class
 
-#include <unordered_map>
 #include <mutex>
 
 #include "GraphicsTypes.h"
@@ -38,6 +37,7 @@
 #include "HashUtils.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -114,9 +114,10 @@ public:
         {
             if (Hash == 0)
             {
-                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat);
-                for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                    HashCombine(Hash, RTVFormats[rt]);
+                StreamingHasher Hasher;
+                Hasher.Update(NumRenderTargets, SampleCount, DSVFormat);
+                Hasher.UpdateBytes(RTVFormats, sizeof(RTVFormats[0]) * NumRenderTargets);
+                Hash = HashToSizeT(Hasher.Digest());
             }
             return Hash;
         }
@@ -140,8 +141,8 @@ private:
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
-    std::mutex                                                                                      m_Mutex;
-    std::unordered_map<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
+    std::mutex                                                                               m_Mutex;
+    FlatHashMap<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
 };
 
 } // namespace Diligent
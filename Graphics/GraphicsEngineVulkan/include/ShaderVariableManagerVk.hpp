@@ -91,6 +91,7 @@ public:
     void Destroy(IMemoryAllocator& Allocator);
 
     ShaderVariableVkImpl* GetVariable(const Char* Name) const;
+    ShaderVariableVkImpl* GetVariable(const InternedString& Name) const;
     ShaderVariableVkImpl* GetVariable(Uint32 Index) const;
 
     // Binds object pObj to resource with index ResIndex and array index ArrayIndex.
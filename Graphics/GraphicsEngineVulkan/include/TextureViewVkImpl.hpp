@@ -80,6 +80,14 @@ public:
         m_MipLevelViews = MipLevelViews;
     }
 
+    // Replaces the image view after the texture has been moved to a different memory location
+    // and returns the old view that must be released once it is no longer used by the GPU.
+    VulkanUtilities::ImageViewWrapper ReplaceImageView(VulkanUtilities::ImageViewWrapper&& NewImageView)
+    {
+        std::swap(m_ImageView, NewImageView);
+        return std::move(NewImageView);
+    }
+
 protected:
     /// Vulkan image view descriptor handle
     VulkanUtilities::ImageViewWrapper m_ImageView;
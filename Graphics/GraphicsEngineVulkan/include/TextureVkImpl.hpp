@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::TextureVkImpl class
 
+#include <atomic>
+
 #include "EngineVkImplTraits.hpp"
 #include "TextureBase.hpp"
 #include "TextureViewVkImpl.hpp"
@@ -98,7 +100,13 @@ public:
     // Buffer offset must be a multiple of 4 (18.4)
     static constexpr Uint32 StagingBufferOffsetAlignment = 4;
 
+    // Prevents DeviceContextVkImpl::DefragmentMemory() from moving the texture. This is required
+    // when the image view handle is written to a descriptor set that is not updated on relocation.
+    void DisableRelocation();
+
 protected:
+    friend class DeviceContextVkImpl;
+
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
     //void PrepareVkInitData(const TextureData &InitData, Uint32 NumSubresources, std::vector<Vk_SUBRESOURCE_DATA> &VkInitData);
 
@@ -106,11 +114,23 @@ protected:
 
     VulkanUtilities::ImageViewWrapper CreateImageView(TextureViewDesc& ViewDesc);
 
+    // Replaces the image and its memory with the ones the contents have been copied to by
+    // DeviceContextVkImpl::DefragmentMemory() and recreates the default shader resource view.
+    // Old objects are safe-released.
+    void Relocate(VulkanUtilities::ImageWrapper&&           NewImage,
+                  VulkanUtilities::VulkanMemoryAllocation&& NewAllocation);
+
     VulkanUtilities::ImageWrapper           m_VulkanImage;
     VulkanUtilities::BufferWrapper          m_StagingBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset;
     bool                                    m_bCSBasedMipGenerationSupported = false;
+
+    // Create info of the image; it is required to recreate the image when the texture is relocated.
+    VkImageCreateInfo m_VkImageCI = {};
+
+    // Indicates if the texture is registered in the device as relocatable
+    std::atomic<bool> m_bIsRelocatable{false};
 };
 
 } // namespace Diligent
@@ -30,10 +30,15 @@
 #include <mutex>
 #include <array>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <map>
+#include <memory>
 #include <atomic>
 #include <string>
 #include "MemoryAllocator.h"
 #include "VariableSizeAllocationsManager.hpp"
+#include "MemoryDefragmentationPlanner.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
@@ -99,32 +104,25 @@ public:
                      VkDeviceSize          PageSize,
                      uint32_t              MemoryTypeIndex,
                      bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags) noexcept;
+                     VkMemoryAllocateFlags AllocateFlags,
+                     size_t                ShardIndex,
+                     VkImage               DedicatedImage = VK_NULL_HANDLE);
     ~VulkanMemoryPage();
 
     // clang-format off
-    VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
-        m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
-        m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
-        m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
-    {
-        rhs.m_CPUMemory = nullptr;
-    }
-
-    VulkanMemoryPage            (const VulkanMemoryPage&) = delete;
-    VulkanMemoryPage& operator= (VulkanMemoryPage&)       = delete;
-    VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)  = delete;
-    
-    bool IsEmpty() const { return m_AllocationMgr.IsEmpty(); }
-    bool IsFull()  const { return m_AllocationMgr.IsFull();  }
+    VulkanMemoryPage            (const VulkanMemoryPage&)  = delete;
+    VulkanMemoryPage            (VulkanMemoryPage&&)       = delete;
+    VulkanMemoryPage& operator= (const VulkanMemoryPage&)  = delete;
+    VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)   = delete;
+
+    // Page state is protected by the mutex of the memory manager shard that owns the page.
+    bool IsEmpty()     const { return m_AllocationMgr.IsEmpty(); }
+    bool IsFull()      const { return m_AllocationMgr.IsFull();  }
+    bool IsDedicated() const { return m_IsDedicated;             }
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
-
     // clang-format on
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
-
     VkDeviceMemory GetVkMemory() const { return m_VkMemory; }
     void*          GetCPUMemory() const { return m_CPUMemory; }
 
@@ -132,15 +130,27 @@ private:
     using AllocationsMgrOffsetType = Diligent::VariableSizeAllocationsManager::OffsetType;
 
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
+
+    VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
 
     VulkanMemoryManager&                     m_ParentMemoryMgr;
-    std::mutex                               m_Mutex;
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+
+    // Index of the memory manager shard that owns this page
+    const size_t m_ShardIndex;
+
+    // Dedicated pages contain exactly one resource and are destroyed as soon as it is released
+    const bool m_IsDedicated;
+
+    // Position of the page in the shard's free-space index
+    std::multimap<VkDeviceSize, VulkanMemoryPage*>::iterator m_FreeSpaceIt;
+    bool                                                     m_InFreeSpaceIndex = false;
 };
 
 class VulkanMemoryManager
@@ -163,45 +173,59 @@ public:
         m_HostVisiblePageSize   {HostVisiblePageSize   },
         m_DeviceLocalReserveSize{DeviceLocalReserveSize},
         m_HostVisibleReserveSize{HostVisibleReserveSize}
-    {}
-
-
-    // We have to write this constructor because on msvc default
-    // constructor is not labeled with noexcept, which makes all
-    // std containers use copy instead of move
-    VulkanMemoryManager(VulkanMemoryManager&& rhs)noexcept : 
-        m_MgrName         {std::move(rhs.m_MgrName)},
-        m_LogicalDevice   {rhs.m_LogicalDevice     },
-        m_PhysicalDevice  {rhs.m_PhysicalDevice    },
-        m_Allocator       {rhs.m_Allocator         },
-        m_Pages           {std::move(rhs.m_Pages)  },
-    
-        m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
-        m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
-        m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
-        m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
-    
-        //m_CurrUsedSize      {rhs.m_CurrUsedSize},
-        m_PeakUsedSize      {rhs.m_PeakUsedSize     },
-        m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
     {
-        // clang-format on
-        for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
-            m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+        for (auto& Shard : m_Shards)
+            Shard.store(nullptr);
     }
+    // clang-format on
 
     ~VulkanMemoryManager();
 
+    // Pages keep a reference to the parent manager, so the manager can't be moved.
     // clang-format off
     VulkanMemoryManager            (const VulkanMemoryManager&) = delete;
+    VulkanMemoryManager            (VulkanMemoryManager&&)      = delete;
     VulkanMemoryManager& operator= (const VulkanMemoryManager&) = delete;
     VulkanMemoryManager& operator= (VulkanMemoryManager&&)      = delete;
     // clang-format on
 
     VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
-    void                   ShrinkMemory();
+
+    // Allocates a separate device memory object for the image (VK_KHR_dedicated_allocation, core in Vulkan 1.1).
+    // The memory is released back to the driver as soon as the allocation is freed.
+    VulkanMemoryAllocation AllocateDedicated(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkImage vkImage);
+
+    // Returns true if a resource of the given size should rather be placed in a dedicated allocation
+    // than sub-allocated from a shared page.
+    bool IsDedicatedAllocationPreferred(VkDeviceSize Size, bool HostVisible) const
+    {
+        return Size >= (HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize) / 2;
+    }
+
+    // Returns all non-dedicated device-local pages along with their descriptions for the defragmentation planner.
+    // DefragmentationPageInfo::PoolId identifies the shard; allocations can only be moved between pages of the same shard.
+    // DefragmentationPageInfo::MovableSize is set to zero and must be filled by the caller.
+    void GetDefragmentationPages(std::vector<VulkanMemoryPage*>&                 Pages,
+                                 std::vector<Diligent::DefragmentationPageInfo>& PageInfos);
+
+    // Allocates memory for a resource that is moved out of SrcPage. Only existing pages of the same shard
+    // that are not in the ExcludedPages set are considered. Returns an empty allocation if there is no space.
+    VulkanMemoryAllocation AllocateForRelocation(const VulkanMemoryPage&                            SrcPage,
+                                                 VkDeviceSize                                       Size,
+                                                 VkDeviceSize                                       Alignment,
+                                                 const std::unordered_set<const VulkanMemoryPage*>& ExcludedPages);
+
+    // Releases empty pages above the reserve size. The method is cheap when there is nothing to release
+    // and is intended to be called periodically (e.g. at every command buffer submission).
+    void ShrinkMemory();
+
+    // Returns the total size of device memory objects allocated by the manager from the given heap.
+    VkDeviceSize GetHeapAllocatedSize(uint32_t HeapIndex) const
+    {
+        VERIFY_EXPR(HeapIndex < VK_MAX_MEMORY_HEAPS);
+        return static_cast<VkDeviceSize>(m_HeapAllocatedSize[HeapIndex].load());
+    }
 
 protected:
     friend class VulkanMemoryPage;
@@ -216,54 +240,92 @@ protected:
 
     Diligent::IMemoryAllocator& m_Allocator;
 
-    std::mutex m_PagesMtx;
-    struct MemoryPageIndex
+    // Pages are split into independent shards by memory type index, host visibility and allocation flags,
+    // so that allocations from different memory types never contend for the same lock.
+    //
+    // On integrated GPUs, there is no difference between host-visible and GPU-only
+    // memory, so MemoryTypeIndex is the same. As GPU-only pages do not have CPU address,
+    // we need to use HostVisible flag to differentiate the two.
+    // It is likely a good idea to always keep staging pages separate to reduce fragmenation
+    // even though on integrated GPUs same pages can be used for both GPU-only and staging
+    // allocations. Staging allocations are short-living and will be released when upload is
+    // complete, while GPU-only allocations are expected to be long-living.
+    struct MemoryPageShard
     {
+        MemoryPageShard(uint32_t _MemoryTypeIndex, bool _IsHostVisible, VkMemoryAllocateFlags _AllocateFlags) :
+            // clang-format off
+            MemoryTypeIndex{_MemoryTypeIndex},
+            IsHostVisible  {_IsHostVisible  },
+            AllocateFlags  {_AllocateFlags  }
+        // clang-format on
+        {}
+
         const uint32_t              MemoryTypeIndex;
-        const VkMemoryAllocateFlags AllocateFlags;
         const bool                  IsHostVisible;
+        const VkMemoryAllocateFlags AllocateFlags;
 
-        // clang-format off
-        MemoryPageIndex(uint32_t              _MemoryTypeIndex,
-                        bool                  _IsHostVisible,
-                        VkMemoryAllocateFlags _AllocateFlags) : 
-            MemoryTypeIndex{_MemoryTypeIndex},
-            AllocateFlags  {_AllocateFlags},
-            IsHostVisible  {_IsHostVisible}
-        {}
+        std::mutex Mtx;
 
-        bool operator == (const MemoryPageIndex& rhs)const
-        {
-            return MemoryTypeIndex == rhs.MemoryTypeIndex &&
-                   AllocateFlags   == rhs.AllocateFlags   &&
-                   IsHostVisible   == rhs.IsHostVisible;
-        }
-        // clang-format on
+        // All pages owned by the shard, including the dedicated ones
+        std::unordered_map<VulkanMemoryPage*, std::unique_ptr<VulkanMemoryPage>> Pages;
+
+        // Non-dedicated pages that have free space, keyed by the size of the largest free block
+        std::multimap<VkDeviceSize, VulkanMemoryPage*> PagesByFreeSpace;
 
-        struct Hasher
-        {
-            size_t operator()(const MemoryPageIndex& PageIndex) const
-            {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible);
-            }
-        };
+        size_t NumEmptyPages = 0;
     };
-    std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
+
+    // VkMemoryAllocateFlagBits currently defines three flags
+    static constexpr size_t MaxAllocateFlagsCombinations = 8;
+    static constexpr size_t MaxShards                    = VK_MAX_MEMORY_TYPES * 2 * MaxAllocateFlagsCombinations;
+
+    static size_t GetShardIndex(uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+    {
+        return (size_t{MemoryTypeIndex} * 2 + (HostVisible ? 1 : 0)) * MaxAllocateFlagsCombinations + size_t{AllocateFlags};
+    }
+
+    MemoryPageShard& GetShard(uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
+
+    uint32_t GetMemoryTypeIndex(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps) const;
+
+    VulkanMemoryPage& CreatePage(MemoryPageShard& Shard, std::unique_ptr<VulkanMemoryPage>&& pPage);
+    void              DestroyPage(std::unique_ptr<VulkanMemoryPage>&& pPage);
+
+    // Updates the position of the page in the free-space index. Must be called with the shard lock held.
+    static void UpdateFreeSpaceIndex(MemoryPageShard& Shard, VulkanMemoryPage& Page);
+
+    // Allocates memory from the existing pages of the shard. Must be called with the shard lock held.
+    VulkanMemoryAllocation AllocateFromExistingPages(MemoryPageShard&                                   Shard,
+                                                     VkDeviceSize                                       Size,
+                                                     VkDeviceSize                                       Alignment,
+                                                     const std::unordered_set<const VulkanMemoryPage*>* pExcludedPages);
+
+    void FreeAllocation(VulkanMemoryPage& Page, VulkanMemoryAllocation&& Allocation);
+
+    // Shards are created lazily and are never destroyed until the manager is destroyed
+    std::array<std::atomic<MemoryPageShard*>, MaxShards> m_Shards;
+
+    // Serializes shard creation
+    std::mutex m_ShardsMtx;
 
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
+    // Total number of empty non-dedicated pages in all shards. Lets ShrinkMemory
+    // return immediately without locking any shard when there is nothing to release.
+    std::atomic<size_t> m_NumEmptyPages{0};
+
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
 
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic_int64_t, 2> m_CurrUsedSize      = {};
-    std::array<VkDeviceSize, 2>        m_PeakUsedSize      = {};
-    std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
-    std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
+    std::array<std::atomic_int64_t, 2> m_PeakUsedSize      = {};
+    std::array<std::atomic_int64_t, 2> m_CurrAllocatedSize = {};
+    std::array<std::atomic_int64_t, 2> m_PeakAllocatedSize = {};
 
-    // If adding new member, do not forget to update move ctor
+    std::array<std::atomic_int64_t, VK_MAX_MEMORY_HEAPS> m_HeapAllocatedSize = {};
 };
 
 } // namespace VulkanUtilities
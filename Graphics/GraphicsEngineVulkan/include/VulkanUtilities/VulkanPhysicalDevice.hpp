@@ -49,6 +49,8 @@ public:
         bool                                             Spirv14              = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
         bool                                             Spirv15              = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
         bool                                             SubgroupOps          = false; // Requires Vulkan 1.1
+        bool                                             DedicatedAllocation  = false; // Requires Vulkan 1.1
+        bool                                             MemoryBudget         = false; // Requires VK_EXT_memory_budget
         VkPhysicalDeviceBufferDeviceAddressFeaturesKHR   BufferDeviceAddress  = {};
         VkPhysicalDeviceDescriptorIndexingFeaturesEXT    DescriptorIndexing   = {};
         bool                                             HasPortabilitySubset = false;
@@ -94,6 +96,10 @@ public:
     const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_MemoryProperties; }
     VkFormatProperties                      GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
 
+    // Queries the current budget and usage of every memory heap.
+    // Requires ExtensionFeatures::MemoryBudget.
+    void GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const;
+
 private:
     VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
                          const VulkanInstance& Instance);
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "VulkanHeaders.h"
+
+namespace VulkanUtilities
+{
+
+/// Vulkan pipeline cache header (VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+struct PipelineCacheHeaderOne
+{
+    uint32_t HeaderSize                      = 0;
+    uint32_t HeaderVersion                   = 0;
+    uint32_t VendorID                        = 0;
+    uint32_t DeviceID                        = 0;
+    uint8_t  PipelineCacheUUID[VK_UUID_SIZE] = {};
+};
+
+/// Result of the pipeline cache header validation, see ValidatePipelineCacheHeader()
+enum PIPELINE_CACHE_HEADER_STATUS : uint8_t
+{
+    /// The header is valid and matches the device.
+    PIPELINE_CACHE_HEADER_STATUS_OK = 0,
+
+    /// The data is smaller than the header, or the header size is invalid.
+    PIPELINE_CACHE_HEADER_STATUS_MALFORMED,
+
+    /// The header version is not VK_PIPELINE_CACHE_HEADER_VERSION_ONE.
+    PIPELINE_CACHE_HEADER_STATUS_UNSUPPORTED_VERSION,
+
+    /// The data was created by a device with a different vendor or device ID.
+    PIPELINE_CACHE_HEADER_STATUS_DEVICE_MISMATCH,
+
+    /// The pipeline cache UUID does not match. This typically happens after a driver update.
+    PIPELINE_CACHE_HEADER_STATUS_UUID_MISMATCH
+};
+
+/// Validates Vulkan pipeline cache data against the properties of the physical device.
+
+/// \param [in]  pData       - Pipeline cache data, e.g. as returned by vkGetPipelineCacheData.
+/// \param [in]  DataSize    - Data size, in bytes.
+/// \param [in]  DeviceProps - Properties of the physical device the data is going to be used with.
+/// \param [out] pHeader     - Optional pointer to the structure that receives the header if the data
+///                            is large enough to contain it.
+///
+/// \remarks Drivers are required to reject incompatible data, but some of them crash or
+///          silently produce broken pipelines, so the data should be validated before it is used.
+PIPELINE_CACHE_HEADER_STATUS ValidatePipelineCacheHeader(const void*                       pData,
+                                                         size_t                            DataSize,
+                                                         const VkPhysicalDeviceProperties& DeviceProps,
+                                                         PipelineCacheHeaderOne*           pHeader = nullptr);
+
+} // namespace VulkanUtilities
@@ -39,6 +39,70 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextVk =
     {0x72aeb1ba, 0xc6ad, 0x42ec, {0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb}};
 
+/// Device memory fragmentation statistics.
+struct MemoryFragmentationStatsVk
+{
+    /// The number of memory pages.
+    Uint32 NumPages       DEFAULT_INITIALIZER(0);
+
+    /// The number of pages that contain no allocations.
+    Uint32 NumEmptyPages  DEFAULT_INITIALIZER(0);
+
+    /// The number of pages that are considered sparse, see DefragmentMemoryAttribsVk::SparsePageThreshold.
+    Uint32 NumSparsePages DEFAULT_INITIALIZER(0);
+
+    /// The total size of all pages, in bytes.
+    Uint64 TotalSize      DEFAULT_INITIALIZER(0);
+
+    /// The total size of all allocations, in bytes.
+    Uint64 UsedSize       DEFAULT_INITIALIZER(0);
+
+    /// The fraction of free space in non-empty pages, from 0 to 1.
+    float  Fragmentation  DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryFragmentationStatsVk MemoryFragmentationStatsVk;
+
+
+/// Device memory defragmentation attributes, see IDeviceContextVk::DefragmentMemory.
+struct DefragmentMemoryAttribsVk
+{
+    /// The maximum number of bytes that will be copied by one defragmentation pass.
+
+    /// \remarks An application typically calls IDeviceContextVk::DefragmentMemory() once
+    ///          per frame, and this value limits the amount of copy work done in every frame.
+    Uint64 MaxBytesToMove     DEFAULT_INITIALIZER(16 << 20);
+
+    /// A page is considered sparse if the size of its allocations does not exceed
+    /// this fraction of the page size.
+    float SparsePageThreshold DEFAULT_INITIALIZER(0.25f);
+};
+typedef struct DefragmentMemoryAttribsVk DefragmentMemoryAttribsVk;
+
+
+/// Device memory defragmentation statistics, see IDeviceContextVk::DefragmentMemory.
+struct DefragmentMemoryStatsVk
+{
+    /// Memory fragmentation before the defragmentation pass.
+    MemoryFragmentationStatsVk StatsBefore;
+
+    /// Expected memory fragmentation once the resources moved by the pass are released.
+    MemoryFragmentationStatsVk StatsAfter;
+
+    /// The number of bytes copied.
+    Uint64 BytesMoved         DEFAULT_INITIALIZER(0);
+
+    /// The number of relocated buffers.
+    Uint32 NumBuffersMoved    DEFAULT_INITIALIZER(0);
+
+    /// The number of relocated textures.
+    Uint32 NumTexturesMoved   DEFAULT_INITIALIZER(0);
+
+    /// The number of memory pages that were evacuated.
+    Uint32 NumPagesEvacuated  DEFAULT_INITIALIZER(0);
+};
+typedef struct DefragmentMemoryStatsVk DefragmentMemoryStatsVk;
+
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -89,6 +153,29 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
 
     /// Unlocks the command queue that was previously locked by IDeviceContextVk::LockCommandQueue().
     VIRTUAL void METHOD(UnlockCommandQueue)(THIS) PURE;
+
+    /// Runs one device memory defragmentation pass.
+
+    /// \param [in]  Attribs - Defragmentation attributes, see Diligent::DefragmentMemoryAttribsVk.
+    /// \param [out] pStats  - Optional pointer to the structure that receives defragmentation statistics.
+    ///
+    /// \remarks The method selects sparse memory pages that only contain buffers created with
+    ///          MISC_BUFFER_FLAG_DEFRAGMENTABLE flag and textures created with MISC_TEXTURE_FLAG_DEFRAGMENTABLE
+    ///          flag, records commands that copy these resources to other pages and flushes the context.
+    ///          The old memory is released once the GPU is done with the copy commands.
+    ///
+    ///          Only resources whose state is known to the engine are relocated.
+    ///          Resources that have been bound to static or mutable shader resource variables are
+    ///          never relocated as the descriptor sets of these variables keep their Vulkan handles.
+    ///          Vertex and index buffers bound to this context are rebound with the new handles.
+    ///          No resources are relocated while any deferred context is recording commands or
+    ///          there are command lists that have not been executed, since these commands
+    ///          keep the Vulkan handles of the resources they reference.
+    ///
+    ///          The method can only be called on an immediate context outside of a render pass.
+    VIRTUAL void METHOD(DefragmentMemory)(THIS_
+                                          const DefragmentMemoryAttribsVk REF Attribs,
+                                          DefragmentMemoryStatsVk*            pStats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -102,6 +189,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
 #    define IDeviceContextVk_LockCommandQueue(This)           CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,      This)
 #    define IDeviceContextVk_UnlockCommandQueue(This)         CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,    This)
+#    define IDeviceContextVk_DefragmentMemory(This, ...)      CALL_IFACE_METHOD(DeviceContextVk, DefragmentMemory,      This, __VA_ARGS__)
 
 // clang-format on
 
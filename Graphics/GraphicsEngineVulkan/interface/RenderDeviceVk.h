@@ -38,6 +38,69 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+// clang-format off
+
+/// Describes where the memory budget values come from, see Diligent::MemoryBudgetVk.
+DILIGENT_TYPED_ENUM(MEMORY_BUDGET_SOURCE_VK, Uint8)
+{
+    /// The budget and usage are reported by the driver through VK_EXT_memory_budget extension.
+    MEMORY_BUDGET_SOURCE_VK_EXTENSION = 0,
+
+    /// VK_EXT_memory_budget extension is not available. The budget is estimated from the heap size,
+    /// and the usage only includes the memory allocated by the engine.
+    MEMORY_BUDGET_SOURCE_VK_HEAP_SIZE,
+
+    /// The values were set by IRenderDeviceVk::SetMemoryBudgetOverride().
+    MEMORY_BUDGET_SOURCE_VK_OVERRIDE
+};
+
+/// Memory budget and usage of a Vulkan memory heap.
+struct MemoryHeapBudgetVk
+{
+    /// The size of the heap, in bytes.
+    Uint64            Size   DEFAULT_INITIALIZER(0);
+
+    /// The amount of memory the process can use in this heap before allocations may fail
+    /// or cause performance degradation, in bytes.
+    Uint64            Budget DEFAULT_INITIALIZER(0);
+
+    /// The amount of memory currently used by the process in this heap, in bytes.
+    Uint64            Usage  DEFAULT_INITIALIZER(0);
+
+    /// Heap flags, see VkMemoryHeapFlagBits.
+    VkMemoryHeapFlags Flags  DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryHeapBudgetVk MemoryHeapBudgetVk;
+
+
+/// Memory budget of all Vulkan memory heaps, see IRenderDeviceVk::GetMemoryBudget.
+struct MemoryBudgetVk
+{
+    /// The number of elements in the Heaps array that are valid.
+    Uint32                  HeapCount DEFAULT_INITIALIZER(0);
+
+    /// Where the values come from, see Diligent::MEMORY_BUDGET_SOURCE_VK.
+    MEMORY_BUDGET_SOURCE_VK Source    DEFAULT_INITIALIZER(MEMORY_BUDGET_SOURCE_VK_EXTENSION);
+
+    /// Budget and usage of every heap. Heap indices match VkPhysicalDeviceMemoryProperties::memoryHeaps.
+    MemoryHeapBudgetVk      Heaps[VK_MAX_MEMORY_HEAPS];
+};
+typedef struct MemoryBudgetVk MemoryBudgetVk;
+
+// clang-format on
+
+/// Memory budget callback, see IRenderDeviceVk::RegisterMemoryBudgetCallback.
+
+/// \param [in] HeapIndex  - Index of the heap whose usage crossed the threshold.
+/// \param [in] HeapBudget - Budget and usage of the heap.
+/// \param [in] Exceeded   - True if the usage has exceeded the threshold, and false
+///                          if it has dropped back below the threshold.
+/// \param [in] pUserData  - User data pointer that was given to IRenderDeviceVk::RegisterMemoryBudgetCallback.
+typedef void (*MemoryBudgetCallbackVk)(Uint32                       HeapIndex,
+                                       const MemoryHeapBudgetVk REF HeapBudget,
+                                       Bool                         Exceeded,
+                                       void*                        pUserData);
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -155,6 +218,81 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                       const TopLevelASDesc REF   Desc,
                                                       RESOURCE_STATE             InitialState,
                                                       ITopLevelAS**              ppTLAS) PURE;
+
+    /// Returns the Vulkan pipeline cache handle that is used by all pipeline state objects
+    /// created by this device
+    VIRTUAL VkPipelineCache METHOD(GetVkPipelineCache)(THIS) PURE;
+
+    /// Serializes the contents of the device pipeline cache into a data blob
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                       data blob will be stored. The function calls AddRef(), so
+    ///                       that the new object will contain one reference.
+    ///                       If the data can't be retrieved, null is written.
+    /// \note  The blob can be passed to EngineVkCreateInfo::pPipelineCacheData
+    ///        when the device is created next time to prime the cache.
+    ///        The method is thread-safe and may be called while pipelines are being created.
+    VIRTUAL void METHOD(GetPipelineCacheData)(THIS_
+                                              IDataBlob** ppData) PURE;
+
+    /// Returns the current budget and usage of every memory heap
+
+    /// \param [out] pBudget - Pointer to the structure that receives the memory budget,
+    ///                        see Diligent::MemoryBudgetVk.
+    ///
+    /// \remarks When VK_EXT_memory_budget extension is supported, the values are reported
+    ///          by the driver and account for all memory used by the process. Otherwise, the budget
+    ///          is estimated as a fraction of the heap size, and the usage only includes the memory
+    ///          allocated by the engine's memory manager.
+    ///
+    ///          The method also checks the thresholds registered with IRenderDeviceVk::RegisterMemoryBudgetCallback
+    ///          and calls the callbacks whose thresholds were crossed.
+    VIRTUAL void METHOD(GetMemoryBudget)(THIS_
+                                         MemoryBudgetVk* pBudget) PURE;
+
+    /// Registers a callback that is called when the memory usage of a heap crosses the threshold
+
+    /// \param [in] Threshold - Fraction of the heap budget, e.g. 0.9 for 90%.
+    /// \param [in] Callback  - Callback function, see Diligent::MemoryBudgetCallbackVk.
+    /// \param [in] pUserData - User data pointer that is passed to the callback.
+    ///
+    /// \return     Callback identifier that should be passed to IRenderDeviceVk::UnregisterMemoryBudgetCallback.
+    ///
+    /// \remarks    The callback is called with Exceeded == true when the usage of a heap reaches Threshold * Budget,
+    ///             and with Exceeded == false when the usage drops sufficiently below that level. If the usage of a heap
+    ///             already exceeds the threshold, the callback is called during the next budget update.
+    ///
+    ///             The budget is updated when the immediate context submits commands to the GPU
+    ///             and when IRenderDeviceVk::GetMemoryBudget or IRenderDevice::ReleaseStaleResources are called.
+    ///             Threshold crossings detected during command submission are queued, and all callbacks
+    ///             are only called by IRenderDeviceVk::GetMemoryBudget, IRenderDeviceVk::SetMemoryBudgetOverride
+    ///             and IRenderDevice::ReleaseStaleResources on the thread that calls these methods.
+    ///             The engine does not hold any internal locks while calling the callback, so the callback
+    ///             may use the device and the immediate context, and may unregister any budget callback.
+    VIRTUAL Uint32 METHOD(RegisterMemoryBudgetCallback)(THIS_
+                                                        float                  Threshold,
+                                                        MemoryBudgetCallbackVk Callback,
+                                                        void*                  pUserData) PURE;
+
+    /// Unregisters the callback previously registered by IRenderDeviceVk::RegisterMemoryBudgetCallback.
+
+    /// \remarks If the callbacks are being called by another thread, the method waits until they return.
+    ///          The callback is never called after the method returns.
+    VIRTUAL void METHOD(UnregisterMemoryBudgetCallback)(THIS_
+                                                        Uint32 CallbackId) PURE;
+
+    /// Overrides the memory budget reported by the device
+
+    /// \param [in] pBudget - Memory budget that replaces the values queried from the device,
+    ///                       or null to disable the override.
+    ///
+    /// \remarks While the override is active, IRenderDeviceVk::GetMemoryBudget returns the override values
+    ///          with MEMORY_BUDGET_SOURCE_VK_OVERRIDE source, and the budget callbacks are driven by them.
+    ///          The method immediately checks the thresholds against the new values and calls
+    ///          the callbacks whose thresholds were crossed.
+    ///          The override is intended to test how an application reacts to memory pressure.
+    VIRTUAL void METHOD(SetMemoryBudgetOverride)(THIS_
+                                                 const MemoryBudgetVk* pBudget) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -174,6 +312,12 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetVkPipelineCache(This)                  CALL_IFACE_METHOD(RenderDeviceVk, GetVkPipelineCache,             This)
+#    define IRenderDeviceVk_GetPipelineCacheData(This, ...)           CALL_IFACE_METHOD(RenderDeviceVk, GetPipelineCacheData,           This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetMemoryBudget(This, ...)                CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryBudget,                This, __VA_ARGS__)
+#    define IRenderDeviceVk_RegisterMemoryBudgetCallback(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, RegisterMemoryBudgetCallback,   This, __VA_ARGS__)
+#    define IRenderDeviceVk_UnregisterMemoryBudgetCallback(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, UnregisterMemoryBudgetCallback, This, __VA_ARGS__)
+#    define IRenderDeviceVk_SetMemoryBudgetOverride(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, SetMemoryBudgetOverride,        This, __VA_ARGS__)
 
 // clang-format on
 
@@ -376,6 +376,18 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
 
         SetState(InitialState);
+
+        m_VkUsageFlags = VkBuffCI.usage;
+
+        // Formatted buffers have Vulkan buffer views and ray tracing buffers are referenced
+        // by device addresses, so they can't be moved.
+        m_bIsRelocatable =
+            (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEFRAGMENTABLE) != 0 &&
+            (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+            m_Desc.Mode != BUFFER_MODE_FORMATTED &&
+            (m_Desc.BindFlags & BIND_RAY_TRACING) == 0;
+        if (m_bIsRelocatable)
+            pRenderDeviceVk->RegisterRelocatableResource(this);
     }
 
     VERIFY_EXPR(IsInKnownState());
@@ -406,6 +418,10 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
 BufferVkImpl::~BufferVkImpl()
 {
+    // This must be done first as the device context may be relocating the buffer right now
+    if (m_bIsRelocatable)
+        m_pDevice->UnregisterRelocatableResource(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.CommandQueueMask);
@@ -413,6 +429,31 @@ BufferVkImpl::~BufferVkImpl()
         m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
 }
 
+void BufferVkImpl::DisableRelocation()
+{
+    if (m_bIsRelocatable.load())
+    {
+        // If the device context is relocating the buffer right now, this waits until it is done
+        m_pDevice->UnregisterRelocatableResource(this);
+        m_bIsRelocatable.store(false);
+    }
+}
+
+void BufferVkImpl::Relocate(VulkanUtilities::BufferWrapper&&          NewBuffer,
+                            VulkanUtilities::VulkanMemoryAllocation&& NewAllocation,
+                            VkDeviceSize                              NewAlignedOffset)
+{
+    VERIFY_EXPR(m_bIsRelocatable);
+
+    std::swap(m_VulkanBuffer, NewBuffer);
+    std::swap(m_MemoryAllocation, NewAllocation);
+    m_BufferMemoryAlignedOffset = NewAlignedOffset;
+
+    // The old buffer is still used by the copy command
+    m_pDevice->SafeReleaseDeviceObject(std::move(NewBuffer), m_Desc.CommandQueueMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(NewAllocation), m_Desc.CommandQueueMask);
+}
+
 void BufferVkImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
 {
     VERIFY(ppView != nullptr, "Null pointer provided");
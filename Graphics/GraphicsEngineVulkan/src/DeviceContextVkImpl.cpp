@@ -42,6 +42,7 @@
 #include "VulkanTypeConversions.hpp"
 #include "CommandListVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
+#include "ScratchAllocatorPool.hpp"
 
 namespace Diligent
 {
@@ -112,6 +113,8 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
         m_QueryMgr.reset(new QueryManagerVk{pDeviceVkImpl, EngineCI.QueryPoolSizes});
     }
 
+    m_WaitForAsyncPipelines = EngineCI.WaitForAsyncPipelinesOnBind;
+
     m_GenerateMipsHelper->CreateSRB(&m_GenerateMipsSRB);
 
     BufferDesc DummyVBDesc;
@@ -153,6 +156,11 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
     {
         Flush();
     }
+    else if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE)
+    {
+        // The command buffer will never be submitted
+        m_pDevice->RemovePendingDeferredCmdBuffers(1);
+    }
 
     // For deferred contexts, m_SubmittedBuffersCmdQueueMask is reset to 0 after every call to FinishFrame().
     // In this case there are no resources to release, so there will be no issues.
@@ -224,6 +232,13 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vk
     ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool}, FenceValue);
 }
 
+void DeviceContextVkImpl::OnDeferredCmdBufferStarted()
+{
+    VERIFY_EXPR(m_bIsDeferred);
+    // Resources must not be relocated by DefragmentMemory() until the command buffer is submitted
+    m_pDevice->AddPendingDeferredCmdBuffer();
+}
+
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue)
 {
     VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Disposing command buffer with unifinished render pass");
@@ -240,10 +255,28 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
     auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
+    {
+        m_PipelineNotReady = false;
         return;
+    }
 
     const auto& PSODesc = pPipelineStateVk->GetDesc();
 
+    // Pipelines created with PSO_CREATE_FLAG_ASYNCHRONOUS flag may still be compiling. The bind is
+    // rejected, and draw and dispatch commands are skipped until a ready pipeline is set, so that
+    // they never run with the previously bound pipeline. Compilation failures are reported by
+    // the worker thread.
+    if (pPipelineStateVk->GetStatus(m_WaitForAsyncPipelines) != PIPELINE_STATE_STATUS_READY)
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        LOG_WARNING_MESSAGE_ONCE("Pipeline state '", PSODesc.Name, "' is not ready and can't be bound. "
+                                 "Draw and dispatch commands will be skipped until a ready pipeline is set.");
+#endif
+        m_PipelineNotReady = true;
+        return;
+    }
+    m_PipelineNotReady = false;
+
     bool CommitStates  = false;
     bool CommitScissor = false;
     if (!m_pPipelineState)
@@ -751,6 +784,9 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawArguments(Attribs);
 
     PrepareForDraw(Attribs.Flags);
@@ -761,6 +797,9 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawIndexedArguments(Attribs);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -771,6 +810,9 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -785,6 +827,9 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -799,6 +844,9 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawMeshArguments(Attribs);
 
     PrepareForDraw(Attribs.Flags);
@@ -809,6 +857,9 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawMeshIndirectArguments(Attribs, pAttribsBuffer);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -823,6 +874,9 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
 void DeviceContextVkImpl::DrawMeshIndirectCount(const DrawMeshIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDrawMeshIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -878,6 +932,9 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDispatchArguments(Attribs);
 
     PrepareForDispatchCompute();
@@ -887,6 +944,9 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
+    if (m_PipelineNotReady)
+        return;
+
     DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer);
 
     PrepareForDispatchCompute();
@@ -1190,11 +1250,12 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
                   "Flushing device context inside an active render pass.");
 
-    // TODO: replace with small_vector
-    std::vector<VkCommandBuffer>               vkCmdBuffs;
-    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs;
-    vkCmdBuffs.reserve(NumCommandLists + 1);
-    DeferredCtxs.reserve(NumCommandLists + 1);
+    // Use thread-local scratch memory to avoid heap allocations
+    auto ScratchAllocator = ScratchAllocatorPool::Borrow();
+
+    auto*  vkCmdBuffs    = ScratchAllocator->Allocate<VkCommandBuffer>(NumCommandLists + 1);
+    Uint32 NumVkCmdBuffs = 0;
+    auto*  DeferredCtxs  = ScratchAllocator->ConstructArray<RefCntAutoPtr<IDeviceContext>>(NumCommandLists);
 
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
@@ -1214,7 +1275,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
             m_CommandBuffer.FlushBarriers();
             m_CommandBuffer.EndCommandBuffer();
 
-            vkCmdBuffs.push_back(vkCmdBuff);
+            vkCmdBuffs[NumVkCmdBuffs++] = vkCmdBuff;
         }
     }
 
@@ -1223,11 +1284,10 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     {
         auto* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
         DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
-        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
-        vkCmdBuffs.emplace_back(pCmdListVk->Close(pDeferredCtx));
-        VERIFY(vkCmdBuffs.back() != VK_NULL_HANDLE, "Trying to execute empty command buffer");
-        VERIFY_EXPR(pDeferredCtx);
-        DeferredCtxs.emplace_back(std::move(pDeferredCtx));
+        vkCmdBuffs[NumVkCmdBuffs] = pCmdListVk->Close(DeferredCtxs[i]);
+        VERIFY(vkCmdBuffs[NumVkCmdBuffs] != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(DeferredCtxs[i]);
+        ++NumVkCmdBuffs;
     }
 
     VERIFY_EXPR(m_VkWaitSemaphores.size() == m_WaitSemaphores.size());
@@ -1238,8 +1298,8 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     SubmitInfo.pNext = nullptr;
 
-    SubmitInfo.commandBufferCount = static_cast<uint32_t>(vkCmdBuffs.size());
-    SubmitInfo.pCommandBuffers    = vkCmdBuffs.data();
+    SubmitInfo.commandBufferCount = NumVkCmdBuffs;
+    SubmitInfo.pCommandBuffers    = vkCmdBuffs;
     SubmitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_WaitSemaphores.size());
     VERIFY_EXPR(m_WaitSemaphores.size() == m_WaitDstStageMasks.size());
     SubmitInfo.pWaitSemaphores      = SubmitInfo.waitSemaphoreCount != 0 ? m_VkWaitSemaphores.data() : nullptr;
@@ -1274,13 +1334,17 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         // It is OK to dispose command buffer from another thread. We are not going to
         // record any commands and only need to add the buffer to the queue
         pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, std::move(vkCmdBuffs[buff_idx]), SubmittedFenceValue);
+        DeferredCtxs[i].~RefCntAutoPtr<IDeviceContext>();
     }
-    VERIFY_EXPR(buff_idx == vkCmdBuffs.size());
+    VERIFY_EXPR(buff_idx == NumVkCmdBuffs);
+    if (NumCommandLists > 0)
+        m_pDevice->RemovePendingDeferredCmdBuffers(NumCommandLists);
 
     m_State    = {};
     m_BindInfo = {};
     m_CommandBuffer.Reset();
     m_pPipelineState    = nullptr;
+    m_PipelineNotReady  = false;
     m_pActiveRenderPass = nullptr;
     m_pBoundFramebuffer = nullptr;
 }
@@ -1311,10 +1375,11 @@ void DeviceContextVkImpl::InvalidateState()
         LOG_WARNING_MESSAGE("Invalidating context that has outstanding commands in it. Call Flush() to submit commands for execution");
 
     TDeviceContextBase::InvalidateState();
-    m_State         = {};
-    m_BindInfo      = {};
-    m_vkRenderPass  = VK_NULL_HANDLE;
-    m_vkFramebuffer = VK_NULL_HANDLE;
+    m_State            = {};
+    m_BindInfo         = {};
+    m_vkRenderPass     = VK_NULL_HANDLE;
+    m_vkFramebuffer    = VK_NULL_HANDLE;
+    m_PipelineNotReady = false;
 
     VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
     m_CommandBuffer.Reset();
@@ -2941,14 +3006,19 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
 
-    VkAccelerationStructureBuildGeometryInfoKHR           vkASBuildInfo = {};
-    std::vector<VkAccelerationStructureBuildRangeInfoKHR> vkRanges;
-    std::vector<VkAccelerationStructureGeometryKHR>       vkGeometries;
+    // Use thread-local scratch memory to avoid heap allocations
+    auto ScratchAllocator = ScratchAllocatorPool::Borrow();
+
+    VkAccelerationStructureBuildGeometryInfoKHR vkASBuildInfo = {};
+    VkAccelerationStructureBuildRangeInfoKHR*   vkRanges      = nullptr;
+    VkAccelerationStructureGeometryKHR*         vkGeometries  = nullptr;
+    Uint32                                      GeometryCount = 0;
 
     if (Attribs.pTriangleData != nullptr)
     {
-        vkGeometries.resize(Attribs.TriangleDataCount);
-        vkRanges.resize(Attribs.TriangleDataCount);
+        GeometryCount = Attribs.TriangleDataCount;
+        vkGeometries  = ScratchAllocator->ConstructArray<VkAccelerationStructureGeometryKHR>(GeometryCount);
+        vkRanges      = ScratchAllocator->ConstructArray<VkAccelerationStructureBuildRangeInfoKHR>(GeometryCount);
         pBLASVk->SetActualGeometryCount(Attribs.TriangleDataCount);
 
         for (Uint32 i = 0; i < Attribs.TriangleDataCount; ++i)
@@ -3021,8 +3091,9 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     }
     else if (Attribs.pBoxData != nullptr)
     {
-        vkGeometries.resize(Attribs.BoxDataCount);
-        vkRanges.resize(Attribs.BoxDataCount);
+        GeometryCount = Attribs.BoxDataCount;
+        vkGeometries  = ScratchAllocator->ConstructArray<VkAccelerationStructureGeometryKHR>(GeometryCount);
+        vkRanges      = ScratchAllocator->ConstructArray<VkAccelerationStructureBuildRangeInfoKHR>(GeometryCount);
         pBLASVk->SetActualGeometryCount(Attribs.BoxDataCount);
 
         for (Uint32 i = 0; i < Attribs.BoxDataCount; ++i)
@@ -3063,7 +3134,7 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
         }
     }
 
-    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
+    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges;
 
     vkASBuildInfo.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     vkASBuildInfo.type                      = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;                 // type must be compatible with create info
@@ -3071,8 +3142,8 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     vkASBuildInfo.mode                      = Attribs.Update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
     vkASBuildInfo.srcAccelerationStructure  = Attribs.Update ? pBLASVk->GetVkBLAS() : VK_NULL_HANDLE;
     vkASBuildInfo.dstAccelerationStructure  = pBLASVk->GetVkBLAS();
-    vkASBuildInfo.geometryCount             = static_cast<uint32_t>(vkGeometries.size());
-    vkASBuildInfo.pGeometries               = vkGeometries.data();
+    vkASBuildInfo.geometryCount             = GeometryCount;
+    vkASBuildInfo.pGeometries               = vkGeometries;
     vkASBuildInfo.ppGeometries              = nullptr;
     vkASBuildInfo.scratchData.deviceAddress = pScratchVk->GetVkDeviceAddress() + Attribs.ScratchBufferOffset;
 
@@ -3376,4 +3447,296 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
     }
 }
 
+void DeviceContextVkImpl::DefragmentMemory(const DefragmentMemoryAttribsVk& Attribs, DefragmentMemoryStatsVk* pStats)
+{
+    if (pStats != nullptr)
+        *pStats = DefragmentMemoryStatsVk{};
+
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Memory defragmentation can only be performed by an immediate context");
+        return;
+    }
+    DEV_CHECK_ERR(!HasActiveRenderPass(), "Memory defragmentation can't be performed inside an active render pass");
+
+    auto& MemoryMgr = m_pDevice->GetGlobalMemoryManager();
+
+    DefragmentationPlanAttribs PlanAttribs;
+    PlanAttribs.SparsePageThreshold = Attribs.SparsePageThreshold;
+    PlanAttribs.MaxBytesToMove      = Attribs.MaxBytesToMove;
+
+    MemoryFragmentationStats StatsBefore;
+    MemoryFragmentationStats StatsAfter;
+    std::vector<size_t>      EvacuatedPages;
+    Uint64                   BytesMoved       = 0;
+    Uint32                   NumBuffersMoved  = 0;
+    Uint32                   NumTexturesMoved = 0;
+
+    // Resources can't be destroyed while the handler is running, so all relocation work must be done inside it
+    m_pDevice->ProcessRelocatableResources(
+        [&](const std::unordered_set<BufferVkImpl*>& Buffers, const std::unordered_set<TextureVkImpl*>& Textures) {
+            // Deferred contexts can't start new command buffers while the handler is running. Commands
+            // they have already recorded use the current Vulkan handles, which must stay valid until
+            // the commands are submitted.
+            if (m_pDevice->GetNumPendingDeferredCmdBuffers() != 0)
+            {
+                LOG_WARNING_MESSAGE_ONCE("Memory defragmentation is skipped while deferred contexts are recording commands or "
+                                         "there are command lists that have not been executed");
+                return;
+            }
+
+            std::vector<VulkanUtilities::VulkanMemoryPage*> Pages;
+            std::vector<DefragmentationPageInfo>            PageInfos;
+            MemoryMgr.GetDefragmentationPages(Pages, PageInfos);
+
+            std::unordered_map<const VulkanUtilities::VulkanMemoryPage*, size_t> PageIndices;
+            for (size_t i = 0; i < Pages.size(); ++i)
+                PageIndices.emplace(Pages[i], i);
+
+            struct PageResources
+            {
+                std::vector<BufferVkImpl*>  Buffers;
+                std::vector<TextureVkImpl*> Textures;
+            };
+            std::vector<PageResources> ResourcesByPage(Pages.size());
+
+            // Only resources in a known state can be moved as we need to transition them for copying
+            auto FindMovableResourcePage = [&](RESOURCE_STATE State, const VulkanUtilities::VulkanMemoryAllocation& Allocation) -> PageResources* {
+                if (State == RESOURCE_STATE_UNKNOWN || State == RESOURCE_STATE_UNDEFINED)
+                    return nullptr;
+
+                auto it = PageIndices.find(Allocation.Page);
+                if (it == PageIndices.end())
+                    return nullptr;
+
+                PageInfos[it->second].MovableSize += Allocation.Size;
+                return &ResourcesByPage[it->second];
+            };
+            for (auto* pBuffer : Buffers)
+            {
+                if (auto* pPageResources = FindMovableResourcePage(pBuffer->GetState(), pBuffer->m_MemoryAllocation))
+                    pPageResources->Buffers.push_back(pBuffer);
+            }
+            for (auto* pTexture : Textures)
+            {
+                if (auto* pPageResources = FindMovableResourcePage(pTexture->GetState(), pTexture->m_MemoryAllocation))
+                    pPageResources->Textures.push_back(pTexture);
+            }
+
+            StatsBefore = ComputeMemoryFragmentationStats(PageInfos.data(), PageInfos.size(), PlanAttribs.SparsePageThreshold);
+            StatsAfter  = StatsBefore;
+
+            const auto Plan = PlanMemoryDefragmentation(PageInfos.data(), PageInfos.size(), PlanAttribs);
+            if (Plan.PagesToEvacuate.empty())
+                return;
+
+            MemoryPageSet ExcludedPages;
+            for (auto PageIdx : Plan.PagesToEvacuate)
+                ExcludedPages.insert(Pages[PageIdx]);
+
+            for (auto PageIdx : Plan.PagesToEvacuate)
+            {
+                const auto& PageRes   = ResourcesByPage[PageIdx];
+                bool        Evacuated = true;
+                for (auto* pBuffer : PageRes.Buffers)
+                {
+                    if (auto Size = RelocateBuffer(*pBuffer, ExcludedPages))
+                    {
+                        BytesMoved += Size;
+                        ++NumBuffersMoved;
+                    }
+                    else
+                        Evacuated = false;
+                }
+                for (auto* pTexture : PageRes.Textures)
+                {
+                    if (auto Size = RelocateTexture(*pTexture, ExcludedPages))
+                    {
+                        BytesMoved += Size;
+                        ++NumTexturesMoved;
+                    }
+                    else
+                        Evacuated = false;
+                }
+                if (Evacuated)
+                    EvacuatedPages.push_back(PageIdx);
+            }
+
+            // Allocations moved out of pages that could not be fully evacuated are not accounted for
+            StatsAfter = ProjectMemoryFragmentationStats(PageInfos.data(), PageInfos.size(), EvacuatedPages, PlanAttribs.SparsePageThreshold);
+        });
+
+    if (NumBuffersMoved > 0 || NumTexturesMoved > 0)
+    {
+        // Vertex and index buffers must be rebound with the new handles
+        m_State.CommittedVBsUpToDate = false;
+        m_State.CommittedIBUpToDate  = false;
+
+        // Submit the copy commands so that the old memory is released as soon as possible.
+        // Evacuated pages are returned to the driver by ShrinkMemory() once they become empty.
+        Flush();
+    }
+
+    if (BytesMoved > 0)
+    {
+        LOG_INFO_MESSAGE("Memory defragmentation moved ", NumBuffersMoved, " buffer(s) and ", NumTexturesMoved, " texture(s) (",
+                         FormatMemorySize(BytesMoved, 2), "); ", EvacuatedPages.size(), " page(s) evacuated. Fragmentation: ",
+                         StatsBefore.Fragmentation, " -> ", StatsAfter.Fragmentation);
+    }
+
+    if (pStats != nullptr)
+    {
+        auto ConvertStats = [](const MemoryFragmentationStats& Src, MemoryFragmentationStatsVk& Dst) {
+            Dst.NumPages       = Src.NumPages;
+            Dst.NumEmptyPages  = Src.NumEmptyPages;
+            Dst.NumSparsePages = Src.NumSparsePages;
+            Dst.TotalSize      = Src.TotalSize;
+            Dst.UsedSize       = Src.UsedSize;
+            Dst.Fragmentation  = Src.Fragmentation;
+        };
+        ConvertStats(StatsBefore, pStats->StatsBefore);
+        ConvertStats(StatsAfter, pStats->StatsAfter);
+        pStats->BytesMoved        = BytesMoved;
+        pStats->NumBuffersMoved   = NumBuffersMoved;
+        pStats->NumTexturesMoved  = NumTexturesMoved;
+        pStats->NumPagesEvacuated = static_cast<Uint32>(EvacuatedPages.size());
+    }
+}
+
+VkDeviceSize DeviceContextVkImpl::RelocateBuffer(BufferVkImpl& BufferVk, const MemoryPageSet& ExcludedPages)
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    const auto& BuffDesc      = BufferVk.GetDesc();
+
+    try
+    {
+        VkBufferCreateInfo VkBuffCI    = {};
+        VkBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        VkBuffCI.pNext                 = nullptr;
+        VkBuffCI.flags                 = 0;
+        VkBuffCI.size                  = BuffDesc.uiSizeInBytes;
+        VkBuffCI.usage                 = BufferVk.m_VkUsageFlags;
+        VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+        VkBuffCI.queueFamilyIndexCount = 0;
+        VkBuffCI.pQueueFamilyIndices   = nullptr;
+
+        auto NewBuffer = LogicalDevice.CreateBuffer(VkBuffCI, BuffDesc.Name);
+        auto MemReqs   = LogicalDevice.GetBufferMemoryRequirements(NewBuffer);
+
+        // The buffer is created with the same parameters, so memory requirements are the same and the
+        // allocation may come from any page of the same memory type.
+        auto NewAllocation = m_pDevice->GetGlobalMemoryManager().AllocateForRelocation(*BufferVk.m_MemoryAllocation.Page, MemReqs.size, MemReqs.alignment, ExcludedPages);
+        if (NewAllocation.Page == nullptr)
+            return 0;
+
+        const auto AlignedOffset = AlignUp(VkDeviceSize{NewAllocation.UnalignedOffset}, MemReqs.alignment);
+        auto       err           = LogicalDevice.BindBufferMemory(NewBuffer, NewAllocation.Page->GetVkMemory(), AlignedOffset);
+        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+
+        EnsureVkCmdBuffer();
+        const auto OriginalState = BufferVk.GetState();
+        TransitionBufferState(BufferVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, true);
+
+        // The new buffer has never been used, so no barrier is required before the copy
+        VkBufferCopy CopyRegion;
+        CopyRegion.srcOffset = 0;
+        CopyRegion.dstOffset = 0;
+        CopyRegion.size      = BuffDesc.uiSizeInBytes;
+        m_CommandBuffer.CopyBuffer(BufferVk.GetVkBuffer(), NewBuffer, 1, &CopyRegion);
+        ++m_State.NumCommands;
+
+        const auto MovedSize = NewAllocation.Size;
+        BufferVk.Relocate(std::move(NewBuffer), std::move(NewAllocation), AlignedOffset);
+
+        // Make the copy visible to the operations the buffer was used for
+        BufferVk.SetState(RESOURCE_STATE_COPY_DEST);
+        TransitionBufferState(BufferVk, RESOURCE_STATE_COPY_DEST, OriginalState, true);
+
+        return MovedSize;
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR_MESSAGE("Failed to relocate buffer '", BuffDesc.Name, "'");
+        return 0;
+    }
+}
+
+VkDeviceSize DeviceContextVkImpl::RelocateTexture(TextureVkImpl& TextureVk, const MemoryPageSet& ExcludedPages)
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    const auto& TexDesc       = TextureVk.GetDesc();
+    const auto& ImageCI       = TextureVk.m_VkImageCI;
+
+    try
+    {
+        auto NewImage = LogicalDevice.CreateImage(ImageCI, TexDesc.Name);
+        auto MemReqs  = LogicalDevice.GetImageMemoryRequirements(NewImage);
+
+        auto NewAllocation = m_pDevice->GetGlobalMemoryManager().AllocateForRelocation(*TextureVk.m_MemoryAllocation.Page, MemReqs.size, MemReqs.alignment, ExcludedPages);
+        if (NewAllocation.Page == nullptr)
+            return 0;
+
+        const auto AlignedOffset = AlignUp(VkDeviceSize{NewAllocation.UnalignedOffset}, MemReqs.alignment);
+        auto       err           = LogicalDevice.BindImageMemory(NewImage, NewAllocation.Page->GetVkMemory(), AlignedOffset);
+        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
+
+        VkImageAspectFlags AspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        {
+            const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
+                AspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                AspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        EnsureVkCmdBuffer();
+        const auto OriginalState = TextureVk.GetState();
+        TransitionTextureState(TextureVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, true);
+
+        VkImageSubresourceRange SubresRange;
+        SubresRange.aspectMask     = AspectMask;
+        SubresRange.baseMipLevel   = 0;
+        SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+        SubresRange.baseArrayLayer = 0;
+        SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        // The contents of the new image are discarded
+        m_CommandBuffer.TransitionImageLayout(NewImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
+
+        std::vector<VkImageCopy> CopyRegions(ImageCI.mipLevels);
+        for (Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+        {
+            const auto MipInfo = GetMipLevelProperties(TexDesc, mip);
+
+            auto& Region = CopyRegions[mip];
+
+            Region.srcSubresource.aspectMask     = AspectMask;
+            Region.srcSubresource.mipLevel       = mip;
+            Region.srcSubresource.baseArrayLayer = 0;
+            Region.srcSubresource.layerCount     = ImageCI.arrayLayers;
+            Region.srcOffset                     = VkOffset3D{0, 0, 0};
+            Region.dstSubresource                = Region.srcSubresource;
+            Region.dstOffset                     = VkOffset3D{0, 0, 0};
+            // For block-compressed formats, the extent must either be a multiple of the block size
+            // or reach the edge of the subresource (18.3)
+            Region.extent = VkExtent3D{MipInfo.LogicalWidth, MipInfo.LogicalHeight, MipInfo.Depth};
+        }
+        m_CommandBuffer.CopyImage(TextureVk.GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, NewImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  static_cast<uint32_t>(CopyRegions.size()), CopyRegions.data());
+        ++m_State.NumCommands;
+
+        const auto MovedSize = NewAllocation.Size;
+        TextureVk.Relocate(std::move(NewImage), std::move(NewAllocation));
+
+        TextureVk.SetState(RESOURCE_STATE_COPY_DEST);
+        TransitionTextureState(TextureVk, RESOURCE_STATE_COPY_DEST, OriginalState, true);
+
+        return MovedSize;
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR_MESSAGE("Failed to relocate texture '", TexDesc.Name, "'");
+        return 0;
+    }
+}
+
 } // namespace Diligent
@@ -521,6 +521,16 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 EnabledExtFeats.SubgroupOps = true;
             }
 
+            // Dedicated allocations are used for large images when available.
+            EnabledExtFeats.DedicatedAllocation = DeviceExtFeatures.DedicatedAllocation;
+
+            // Memory budget extension lets the device report the heap budget and usage, see IRenderDeviceVk::GetMemoryBudget().
+            if (DeviceExtFeatures.MemoryBudget)
+            {
+                EnabledExtFeats.MemoryBudget = true;
+                DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+
             // make sure that last pNext is null
             *NextExt = nullptr;
         }
@@ -58,9 +58,10 @@ size_t FramebufferCache::FramebufferCacheKey::GetHash() const
 {
     if (Hash == 0)
     {
-        Hash = ComputeHash(Pass, NumRenderTargets, DSV, CommandQueueMask);
-        for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-            HashCombine(Hash, RTVs[rt]);
+        StreamingHasher Hasher;
+        Hasher.Update(Pass, NumRenderTargets, DSV, CommandQueueMask);
+        Hasher.UpdateBytes(RTVs, sizeof(RTVs[0]) * NumRenderTargets);
+        Hash = HashToSizeT(Hasher.Digest());
     }
     return Hash;
 }
@@ -170,24 +170,18 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
     PipelineCI.stage  = Stages[0];
     PipelineCI.layout = Layout.GetVkPipelineLayout();
 
-    Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), PSODesc.Name);
 }
 
 
-void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
-                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
-                            const PipelineLayoutVk&                       Layout,
-                            const PipelineStateDesc&                      PSODesc,
-                            const GraphicsPipelineDesc&                   GraphicsPipeline,
-                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                            RefCntAutoPtr<IRenderPass>&                   pRenderPass)
+void InitImplicitRenderPass(RenderDeviceVkImpl*         pDeviceVk,
+                            const GraphicsPipelineDesc& GraphicsPipeline,
+                            RefCntAutoPtr<IRenderPass>& pRenderPass)
 {
-    const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
-    const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
-    auto&       RPCache        = pDeviceVk->GetImplicitRenderPassCache();
-
     if (pRenderPass == nullptr)
     {
+        auto& RPCache = pDeviceVk->GetImplicitRenderPassCache();
+
         RenderPassCache::RenderPassCacheKey Key{
             GraphicsPipeline.NumRenderTargets,
             GraphicsPipeline.SmplDesc.Count,
@@ -195,6 +189,21 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
             GraphicsPipeline.DSVFormat};
         pRenderPass = RPCache.GetRenderPass(Key);
     }
+}
+
+
+void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
+                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                            const PipelineLayoutVk&                       Layout,
+                            const PipelineStateDesc&                      PSODesc,
+                            const GraphicsPipelineDesc&                   GraphicsPipeline,
+                            VulkanUtilities::PipelineWrapper&             Pipeline,
+                            const RefCntAutoPtr<IRenderPass>&             pRenderPass)
+{
+    const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
+    const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
+
+    VERIFY(pRenderPass != nullptr, "Render pass must be initialized by InitImplicitRenderPass()");
 
     VkGraphicsPipelineCreateInfo PipelineCI = {};
 
@@ -354,7 +363,7 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), PSODesc.Name);
 }
 
 
@@ -388,7 +397,7 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
     PipelineCI.basePipelineHandle           = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex            = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), PSODesc.Name);
 }
 
 
@@ -965,10 +974,7 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
 }
 
 template <typename PSOCreateInfoType>
-PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
-    const PSOCreateInfoType&                           CreateInfo,
-    std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules)
+PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo)
 {
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages);
@@ -979,16 +985,109 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
 
     MemPool.Reserve();
 
-    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
-
     InitializePipelineDesc(CreateInfo, MemPool);
 
     InitPipelineLayout(CreateInfo, ShaderStages);
 
+    return ShaderStages;
+}
+
+void PipelineStateVkImpl::CreatePipeline(TShaderStages& ShaderStages)
+{
+    auto* const pDeviceVk = GetDevice();
+
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+
     // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+    InitPipelineShaderStages(pDeviceVk->GetLogicalDevice(), ShaderStages, ShaderModules, vkShaderStages);
 
-    return ShaderStages;
+    if (m_Desc.IsAnyGraphicsPipeline())
+    {
+        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr());
+    }
+    else
+    {
+        VERIFY_EXPR(m_Desc.IsComputePipeline());
+        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline);
+    }
+}
+
+void PipelineStateVkImpl::InitPipeline(TShaderStages&& ShaderStages, PSO_CREATE_FLAGS Flags)
+{
+    if ((Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) == 0)
+    {
+        CreatePipeline(ShaderStages);
+        return;
+    }
+
+    // Shader module creation (which also strips reflection from SPIR-V) and the driver compilation
+    // run on the device worker threads. Everything the context or SRBs may access, i.e. the
+    // pipeline layout, resource signatures and render pass, has been initialized by now.
+    m_pAsyncCompileData.reset(new AsyncCompileData{});
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto* pShader : Stage.Shaders)
+            m_pAsyncCompileData->Shaders.emplace_back(const_cast<ShaderVkImpl*>(pShader));
+    }
+    m_pAsyncCompileData->ShaderStages = std::move(ShaderStages);
+
+    m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+}
+
+void PipelineStateVkImpl::StartAsyncCompilation()
+{
+    if (!m_pAsyncCompileData)
+        return;
+
+    // The task only keeps a weak reference to the pipeline, so that a pipeline released
+    // before its compilation has started is destroyed right away and the task is skipped.
+    // While the compilation is running, the task holds a strong reference instead.
+    RefCntWeakPtr<PipelineStateVkImpl> wpPipeline{this};
+    GetDevice()->GetPipelineCompilerPool().Enqueue(
+        [wpPipeline]() mutable //
+        {
+            if (auto pPipeline = wpPipeline.Lock())
+                pPipeline->CompilePipelineAsync();
+        });
+}
+
+void PipelineStateVkImpl::CompilePipelineAsync()
+{
+    VERIFY_EXPR(m_pAsyncCompileData);
+
+    auto Status = PIPELINE_STATE_STATUS_FAILED;
+    try
+    {
+        CreatePipeline(m_pAsyncCompileData->ShaderStages);
+        Status = PIPELINE_STATE_STATUS_READY;
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to asynchronously compile pipeline state '", m_Desc.Name, "'.");
+    }
+
+    // Shader modules have been created, so neither the SPIR-V nor the shaders are needed anymore.
+    // Note that this may release the last references to the shaders.
+    m_pAsyncCompileData.reset();
+
+    {
+        std::lock_guard<std::mutex> Lock{m_CompileMtx};
+        m_Status.store(Status);
+    }
+    m_CompileCV.notify_all();
+}
+
+PIPELINE_STATE_STATUS PipelineStateVkImpl::GetStatus(bool WaitForCompletion)
+{
+    auto Status = m_Status.load();
+    if (Status == PIPELINE_STATE_STATUS_COMPILING && WaitForCompletion)
+    {
+        std::unique_lock<std::mutex> Lock{m_CompileMtx};
+        m_CompileCV.wait(Lock, [this] { return m_Status.load() != PIPELINE_STATE_STATUS_COMPILING; });
+        Status = m_Status.load();
+    }
+    return Status;
 }
 
 PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const GraphicsPipelineStateCreateInfo& CreateInfo) :
@@ -996,12 +1095,11 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        auto ShaderStages = InitInternalObjects(CreateInfo);
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        InitImplicitRenderPass(pDeviceVk, GetGraphicsPipelineDesc(), GetRenderPassPtr());
 
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr());
+        InitPipeline(std::move(ShaderStages), CreateInfo.Flags);
     }
     catch (...)
     {
@@ -1015,12 +1113,9 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        auto ShaderStages = InitInternalObjects(CreateInfo);
 
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline);
+        InitPipeline(std::move(ShaderStages), CreateInfo.Flags);
     }
     catch (...)
     {
@@ -1036,10 +1131,13 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
     {
         const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
 
+        // Ray tracing pipelines are always created synchronously as shader group handles
+        // must be available as soon as the pipeline is returned to the application.
+        auto ShaderStages = InitInternalObjects(CreateInfo);
+
         std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
         std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+        InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
 
         const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
 
@@ -1061,6 +1159,8 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 
 PipelineStateVkImpl::~PipelineStateVkImpl()
 {
+    // The compilation task holds a strong reference while it is running, so if the
+    // pipeline is still compiling, the task has not started and will be skipped.
     Destruct();
 }
 
@@ -46,7 +46,9 @@
 #include "PipelineResourceSignatureVkImpl.hpp"
 
 #include "VulkanTypeConversions.hpp"
+#include "VulkanUtilities/VulkanPipelineCacheHeader.hpp"
 #include "EngineMemory.h"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -160,6 +162,10 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 {
     static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
 
+    CreatePipelineCache(EngineCI.pPipelineCacheData);
+    // The blob is only used to initialize the cache and is not kept alive by the device
+    m_EngineAttribs.pPipelineCacheData = nullptr;
+
     m_DeviceCaps.DevType      = RENDER_DEVICE_TYPE_VULKAN;
     m_DeviceCaps.MajorVersion = 1;
     m_DeviceCaps.MinorVersion = 0;
@@ -272,6 +278,14 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
 {
+    // Memory budget callbacks must not be called while the device is being destroyed
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+        m_MemoryBudgetCallbacks.clear();
+        m_PendingMemoryBudgetCallbacks.clear();
+        m_NumMemoryBudgetCallbacks.store(0);
+    }
+
     // Explicitly destroy dynamic heap. This will move resources owned by
     // the heap into release queues
     m_DynamicMemoryManager.Destroy();
@@ -292,6 +306,9 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // Immediately destroys all command pools
     m_TransientCmdPoolMgr.DestroyPools();
 
+    // All pipelines have been released, so the cache can be destroyed now
+    m_PipelineCache.Release();
+
     // We must destroy command queues explicitly prior to releasing Vulkan device
     DestroyCommandQueues();
 
@@ -304,6 +321,320 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 }
 
 
+void RenderDeviceVkImpl::CreatePipelineCache(IDataBlob* pInitialData)
+{
+    const void* pCacheData    = nullptr;
+    size_t      CacheDataSize = 0;
+    if (pInitialData != nullptr && pInitialData->GetSize() > 0)
+    {
+        const auto& DeviceProps = m_PhysicalDevice->GetProperties();
+
+        VulkanUtilities::PipelineCacheHeaderOne Header;
+        switch (VulkanUtilities::ValidatePipelineCacheHeader(pInitialData->GetConstDataPtr(), pInitialData->GetSize(), DeviceProps, &Header))
+        {
+            case VulkanUtilities::PIPELINE_CACHE_HEADER_STATUS_OK:
+                pCacheData    = pInitialData->GetConstDataPtr();
+                CacheDataSize = pInitialData->GetSize();
+                break;
+
+            case VulkanUtilities::PIPELINE_CACHE_HEADER_STATUS_MALFORMED:
+                LOG_WARNING_MESSAGE("Pipeline cache data is ignored: the data is too small or the header is malformed.");
+                break;
+
+            case VulkanUtilities::PIPELINE_CACHE_HEADER_STATUS_UNSUPPORTED_VERSION:
+                LOG_WARNING_MESSAGE("Pipeline cache data is ignored: unsupported header version (", Header.HeaderVersion, ").");
+                break;
+
+            case VulkanUtilities::PIPELINE_CACHE_HEADER_STATUS_DEVICE_MISMATCH:
+                LOG_WARNING_MESSAGE("Pipeline cache data is ignored: the data was created by a different device (vendor 0x", std::hex, Header.VendorID,
+                                    ", device 0x", Header.DeviceID, ") than the current one (vendor 0x", DeviceProps.vendorID, ", device 0x", DeviceProps.deviceID, ").");
+                break;
+
+            case VulkanUtilities::PIPELINE_CACHE_HEADER_STATUS_UUID_MISMATCH:
+                LOG_WARNING_MESSAGE("Pipeline cache data is ignored: pipeline cache UUID does not match the device. "
+                                    "This typically happens after a driver update.");
+                break;
+
+            default:
+                UNEXPECTED("Unexpected pipeline cache header status");
+        }
+    }
+
+    VkPipelineCacheCreateInfo PipelineCacheCI{};
+    PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext           = nullptr;
+    PipelineCacheCI.flags           = 0;
+    PipelineCacheCI.initialDataSize = CacheDataSize;
+    PipelineCacheCI.pInitialData    = pCacheData;
+
+    if (CacheDataSize != 0)
+    {
+        try
+        {
+            m_PipelineCache = m_LogicalVkDevice->CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+            return;
+        }
+        catch (...)
+        {
+            LOG_WARNING_MESSAGE("Failed to create pipeline cache from the initial data. Creating an empty cache.");
+            PipelineCacheCI.initialDataSize = 0;
+            PipelineCacheCI.pInitialData    = nullptr;
+        }
+    }
+    m_PipelineCache = m_LogicalVkDevice->CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+}
+
+void RenderDeviceVkImpl::GetPipelineCacheData(IDataBlob** ppData)
+{
+    DEV_CHECK_ERR(ppData != nullptr, "ppData must not be null");
+    DEV_CHECK_ERR(*ppData == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+    *ppData = nullptr;
+
+    // The cache may grow between the two calls if other threads create pipelines,
+    // in which case the driver writes as much as fits and returns VK_INCOMPLETE.
+    size_t DataSize = 0;
+    auto   err      = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, nullptr);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to query the pipeline cache data size: ", VulkanUtilities::VkResultToString(err));
+        return;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>()(DataSize)};
+    if (DataSize > 0)
+    {
+        err = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, pDataBlob->GetDataPtr());
+        if (err != VK_SUCCESS && err != VK_INCOMPLETE)
+        {
+            LOG_ERROR_MESSAGE("Failed to retrieve the pipeline cache data: ", VulkanUtilities::VkResultToString(err));
+            return;
+        }
+        pDataBlob->Resize(DataSize);
+    }
+
+    *ppData = pDataBlob.Detach();
+}
+
+ThreadPool& RenderDeviceVkImpl::GetPipelineCompilerPool()
+{
+    std::lock_guard<std::mutex> Lock{m_PipelineCompilerPoolMtx};
+    if (!m_pPipelineCompilerPool)
+        m_pPipelineCompilerPool.reset(new ThreadPool{m_EngineAttribs.NumAsyncPipelineCompilationThreads});
+    return *m_pPipelineCompilerPool;
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.insert(pBuffer);
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.insert(pTexture);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.erase(pBuffer);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.erase(pTexture);
+}
+
+void RenderDeviceVkImpl::AddPendingDeferredCmdBuffer()
+{
+    // If the device context is relocating resources right now, this waits until it is done
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    ++m_NumPendingDeferredCmdBuffers;
+}
+
+void RenderDeviceVkImpl::RemovePendingDeferredCmdBuffers(Uint32 NumCmdBuffers)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    VERIFY(m_NumPendingDeferredCmdBuffers >= NumCmdBuffers, "The number of pending deferred command buffers is inconsistent");
+    m_NumPendingDeferredCmdBuffers -= NumCmdBuffers;
+}
+
+void RenderDeviceVkImpl::QueryMemoryBudget(MemoryBudgetVk& Budget) const
+{
+    if (m_pMemoryBudgetOverride)
+    {
+        Budget        = *m_pMemoryBudgetOverride;
+        Budget.Source = MEMORY_BUDGET_SOURCE_VK_OVERRIDE;
+        return;
+    }
+
+    const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
+
+    Budget.HeapCount = MemoryProps.memoryHeapCount;
+    for (Uint32 HeapIdx = 0; HeapIdx < MemoryProps.memoryHeapCount; ++HeapIdx)
+    {
+        auto& Heap = Budget.Heaps[HeapIdx];
+        Heap.Size  = MemoryProps.memoryHeaps[HeapIdx].size;
+        Heap.Flags = MemoryProps.memoryHeaps[HeapIdx].flags;
+    }
+
+    if (m_LogicalVkDevice->GetEnabledExtFeatures().MemoryBudget)
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT vkBudget;
+        m_PhysicalDevice->GetMemoryBudget(vkBudget);
+        for (Uint32 HeapIdx = 0; HeapIdx < MemoryProps.memoryHeapCount; ++HeapIdx)
+        {
+            auto& Heap  = Budget.Heaps[HeapIdx];
+            Heap.Budget = vkBudget.heapBudget[HeapIdx];
+            Heap.Usage  = vkBudget.heapUsage[HeapIdx];
+        }
+        Budget.Source = MEMORY_BUDGET_SOURCE_VK_EXTENSION;
+    }
+    else
+    {
+        // Other processes and the driver itself also use the heap, so like other
+        // allocators we only let the application use 80% of it.
+        for (Uint32 HeapIdx = 0; HeapIdx < MemoryProps.memoryHeapCount; ++HeapIdx)
+        {
+            auto& Heap  = Budget.Heaps[HeapIdx];
+            Heap.Budget = Heap.Size / 10 * 8;
+            Heap.Usage  = m_MemoryMgr.GetHeapAllocatedSize(HeapIdx);
+        }
+        Budget.Source = MEMORY_BUDGET_SOURCE_VK_HEAP_SIZE;
+    }
+}
+
+void RenderDeviceVkImpl::UpdateMemoryBudget(MemoryBudgetVk* pBudget)
+{
+    std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+
+    MemoryBudgetVk Budget;
+    QueryMemoryBudget(Budget);
+
+    if (m_MemoryBudgetTracker.GetNumThresholds() > 0)
+    {
+        std::array<MemoryHeapBudgetInfo, VK_MAX_MEMORY_HEAPS> Heaps;
+        for (Uint32 HeapIdx = 0; HeapIdx < Budget.HeapCount; ++HeapIdx)
+            Heaps[HeapIdx] = MemoryHeapBudgetInfo{Budget.Heaps[HeapIdx].Budget, Budget.Heaps[HeapIdx].Usage};
+
+        m_MemoryBudgetEvents.clear();
+        m_MemoryBudgetTracker.Update(Heaps.data(), Budget.HeapCount, m_MemoryBudgetEvents);
+        for (const auto& Event : m_MemoryBudgetEvents)
+        {
+            const auto& Heap = Budget.Heaps[Event.HeapIndex];
+            LOG_INFO_MESSAGE("Memory heap ", Event.HeapIndex, " usage (", FormatMemorySize(Heap.Usage, 2), ") ",
+                             (Event.Exceeded ? "exceeded" : "dropped below"), " the budget threshold. Budget: ", FormatMemorySize(Heap.Budget, 2));
+
+            PendingMemoryBudgetCallback Pending;
+            Pending.CallbackId = Event.ThresholdId;
+            Pending.HeapIndex  = Event.HeapIndex;
+            Pending.Exceeded   = Event.Exceeded;
+            Pending.Heap       = Heap;
+            m_PendingMemoryBudgetCallbacks.emplace_back(Pending);
+        }
+    }
+
+    if (pBudget != nullptr)
+        *pBudget = Budget;
+}
+
+void RenderDeviceVkImpl::DeliverMemoryBudgetCallbacks()
+{
+    std::lock_guard<std::recursive_mutex> DeliveryLock{m_MemoryBudgetDeliveryMtx};
+
+    std::vector<PendingMemoryBudgetCallback> PendingCallbacks;
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+        PendingCallbacks.swap(m_PendingMemoryBudgetCallbacks);
+    }
+
+    for (const auto& Pending : PendingCallbacks)
+    {
+        // A callback may have been unregistered by one of the previous callbacks
+        MemoryBudgetCallbackInfo CallbackInfo;
+        {
+            std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+
+            auto it = m_MemoryBudgetCallbacks.find(Pending.CallbackId);
+            if (it == m_MemoryBudgetCallbacks.end())
+                continue;
+            CallbackInfo = it->second;
+        }
+        CallbackInfo.Callback(Pending.HeapIndex, Pending.Heap, Pending.Exceeded, CallbackInfo.pUserData);
+    }
+}
+
+void RenderDeviceVkImpl::GetMemoryBudget(MemoryBudgetVk* pBudget)
+{
+    DEV_CHECK_ERR(pBudget != nullptr, "pBudget must not be null");
+    UpdateMemoryBudget(pBudget);
+    DeliverMemoryBudgetCallbacks();
+}
+
+Uint32 RenderDeviceVkImpl::RegisterMemoryBudgetCallback(float                  Threshold,
+                                                        MemoryBudgetCallbackVk Callback,
+                                                        void*                  pUserData)
+{
+    if (Callback == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Memory budget callback must not be null");
+        return 0;
+    }
+    if (!(Threshold > 0))
+    {
+        LOG_ERROR_MESSAGE("Memory budget threshold (", Threshold, ") must be positive");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+
+    const auto CallbackId = m_MemoryBudgetTracker.AddThreshold(Threshold);
+
+    m_MemoryBudgetCallbacks.emplace(CallbackId, MemoryBudgetCallbackInfo{Callback, pUserData});
+    m_NumMemoryBudgetCallbacks.fetch_add(1);
+
+    return CallbackId;
+}
+
+void RenderDeviceVkImpl::UnregisterMemoryBudgetCallback(Uint32 CallbackId)
+{
+    // Wait until other threads finish calling the callbacks
+    std::lock_guard<std::recursive_mutex> DeliveryLock{m_MemoryBudgetDeliveryMtx};
+    std::lock_guard<std::mutex>           Lock{m_MemoryBudgetMtx};
+
+    if (!m_MemoryBudgetTracker.RemoveThreshold(CallbackId))
+    {
+        LOG_ERROR_MESSAGE("Memory budget callback with id ", CallbackId, " is not registered");
+        return;
+    }
+
+    m_MemoryBudgetCallbacks.erase(CallbackId);
+    m_NumMemoryBudgetCallbacks.fetch_sub(1);
+}
+
+void RenderDeviceVkImpl::SetMemoryBudgetOverride(const MemoryBudgetVk* pBudget)
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_MemoryBudgetMtx};
+        if (pBudget != nullptr)
+        {
+            DEV_CHECK_ERR(pBudget->HeapCount <= VK_MAX_MEMORY_HEAPS, "The number of heaps (", pBudget->HeapCount,
+                          ") exceeds VK_MAX_MEMORY_HEAPS (", VK_MAX_MEMORY_HEAPS, ")");
+            m_pMemoryBudgetOverride.reset(new MemoryBudgetVk{*pBudget});
+            m_pMemoryBudgetOverride->HeapCount = std::min(m_pMemoryBudgetOverride->HeapCount, Uint32{VK_MAX_MEMORY_HEAPS});
+        }
+        else
+        {
+            m_pMemoryBudgetOverride.reset();
+        }
+    }
+
+    UpdateMemoryBudget(nullptr);
+    DeliverMemoryBudgetCallbacks();
+}
+
 void RenderDeviceVkImpl::AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName)
 {
     CmdPool = m_TransientCmdPoolMgr.AllocateCommandPool(DebugPoolName);
@@ -487,6 +818,11 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueue(QueueIndex);
 
+    // The callbacks must not be called in the middle of the context flush, so threshold
+    // crossings are only queued here and delivered by ReleaseStaleResources() or GetMemoryBudget().
+    if (m_NumMemoryBudgetCallbacks.load() > 0)
+        UpdateMemoryBudget(nullptr);
+
     return SubmittedFenceValue;
 }
 
@@ -510,6 +846,12 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
+
+    if (m_NumMemoryBudgetCallbacks.load() > 0)
+    {
+        UpdateMemoryBudget(nullptr);
+        DeliverMemoryBudgetCallbacks();
+    }
 }
 
 
@@ -628,11 +970,17 @@ void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 void RenderDeviceVkImpl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
+    // Asynchronous compilation may only start once the pipeline is referenced by the application
+    if (*ppPipelineState != nullptr)
+        ValidatedCast<PipelineStateVkImpl>(*ppPipelineState)->StartAsyncCompilation();
 }
 
 void RenderDeviceVkImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
+    // Asynchronous compilation may only start once the pipeline is referenced by the application
+    if (*ppPipelineState != nullptr)
+        ValidatedCast<PipelineStateVkImpl>(*ppPipelineState)->StartAsyncCompilation();
 }
 
 void RenderDeviceVkImpl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
@@ -174,6 +174,38 @@ ShaderResourceCacheVk::~ShaderResourceCacheVk()
     }
 }
 
+// Static and mutable descriptor sets are written once and are not updated when a resource is moved
+// to a different memory location by DeviceContextVkImpl::DefragmentMemory(), so the resource is pinned.
+static void DisableResourceRelocation(DescriptorType Type, const RefCntAutoPtr<IDeviceObject>& pObject)
+{
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 15, "Please update the switch below to handle the new descriptor type");
+    switch (Type)
+    {
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            pObject.RawPtr<BufferVkImpl>()->DisableRelocation();
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            pObject.RawPtr<BufferViewVkImpl>()->GetBuffer<BufferVkImpl>()->DisableRelocation();
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+        case DescriptorType::InputAttachment:
+            pObject.RawPtr<TextureViewVkImpl>()->GetTexture<TextureVkImpl>()->DisableRelocation();
+            break;
+
+        default:
+            // Formatted buffers, samplers and acceleration structures are never relocated
+            break;
+    }
+}
+
 const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
                                                                           Uint32                                      SetIndex,
                                                                           Uint32                                      Offset,
@@ -232,6 +264,9 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(const
     {
         VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
 
+        // This must be done before the Vulkan handle is read
+        DisableResourceRelocation(Res.Type, Res.pObject);
+
         VkWriteDescriptorSet WriteDescrSet;
         WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         WriteDescrSet.pNext           = nullptr;
@@ -140,6 +140,21 @@ ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const Char* Name) con
 }
 
 
+ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const InternedString& Name) const
+{
+    // Resource names are interned by the device that created the
+    // signature, so the variable is found by comparing the pointers
+    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    {
+        auto& Var = m_pVariables[v];
+        if (Var.GetDesc().Name == Name.GetStr())
+            return &Var;
+    }
+
+    return nullptr;
+}
+
+
 ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(Uint32 Index) const
 {
     if (Index >= m_NumVariables)
@@ -188,7 +188,14 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+        // Large render targets and textures are placed into dedicated allocations when supported: this lets the
+        // driver apply resource-specific optimizations and avoids fragmenting shared memory pages.
+        const bool CanUseDedicatedMemory = m_Desc.Usage != USAGE_STAGING && LogicalDevice.GetEnabledExtFeatures().DedicatedAllocation;
+
+        VkMemoryDedicatedRequirements DedicatedReqs = {};
+        VkMemoryRequirements          MemReqs       = CanUseDedicatedMemory ?
+            LogicalDevice.GetImageMemoryRequirements2(m_VulkanImage, DedicatedReqs) :
+            LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
 
         VkMemoryPropertyFlags ImageMemoryFlags = 0;
         if (m_Desc.Usage == USAGE_STAGING)
@@ -196,8 +203,15 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         else
             ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
+        const bool UseDedicatedMemory = CanUseDedicatedMemory &&
+            (DedicatedReqs.requiresDedicatedAllocation != VK_FALSE ||
+             DedicatedReqs.prefersDedicatedAllocation != VK_FALSE ||
+             pRenderDeviceVk->GetGlobalMemoryManager().IsDedicatedAllocationPreferred(MemReqs.size, false));
+
         VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
+        m_MemoryAllocation = UseDedicatedMemory ?
+            pRenderDeviceVk->AllocateDedicatedMemory(MemReqs, ImageMemoryFlags, m_VulkanImage) :
+            pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
         auto AlignedOffset = AlignUp(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
         VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
         auto Memory = m_MemoryAllocation.Page->GetVkMemory();
@@ -406,6 +420,21 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             Uint32 QueueIndex = 0;
             pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
         }
+
+        // Only read-only textures can be moved as there is no way to update render target, depth-stencil
+        // and UAV handles cached by framebuffers and descriptor sets. Dedicated allocations are never moved.
+        m_bIsRelocatable =
+            (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_DEFRAGMENTABLE) != 0 &&
+            (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+            m_Desc.BindFlags == BIND_SHADER_RESOURCE &&
+            (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS) == 0 &&
+            m_Desc.SampleCount == 1 &&
+            !UseDedicatedMemory;
+        if (m_bIsRelocatable)
+        {
+            m_VkImageCI = ImageCI;
+            pRenderDeviceVk->RegisterRelocatableResource(this);
+        }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
     {
@@ -474,6 +503,11 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         {
             uint8_t* const pStagingData = GetStagingDataCPUAddress();
 
+            // Upload staging memory that is not host-cached is typically write-combined
+            const auto CopyFlags = (MemProperties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) == 0 ?
+                COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED :
+                COPY_TEXTURE_SUBRESOURCE_FLAG_NONE;
+
             Uint32 subres = 0;
             for (Uint32 layer = 0; layer < m_Desc.ArraySize; ++layer)
             {
@@ -490,9 +524,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                                            MipProps.Depth,
                                            MipProps.RowSize,
                                            pStagingData + DstSubresOffset,
-                                           MipProps.RowSize,       // DstRowStride
-                                           MipProps.DepthSliceSize // DstDepthStride
-                    );
+                                           MipProps.RowSize,        // DstRowStride
+                                           MipProps.DepthSliceSize, // DstDepthStride
+                                           CopyFlags);
                 }
             }
         }
@@ -525,6 +559,11 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
     *ppView = nullptr;
 
+    // Only the default view is updated when the texture is moved, so the texture
+    // can't be relocated once any other view is created.
+    if (!bIsDefaultView)
+        DisableRelocation();
+
     try
     {
         auto& TexViewAllocator = m_pDevice->GetTexViewObjAllocator();
@@ -597,6 +636,10 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
 TextureVkImpl::~TextureVkImpl()
 {
+    // This must be done first as the device context may be relocating the texture right now
+    if (m_bIsRelocatable)
+        m_pDevice->UnregisterRelocatableResource(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     // Wrappers for external texture will not be destroyed as they are created with null device pointer
     if (m_VulkanImage)
@@ -606,6 +649,37 @@ TextureVkImpl::~TextureVkImpl()
     m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
 }
 
+void TextureVkImpl::DisableRelocation()
+{
+    if (m_bIsRelocatable.load())
+    {
+        // If the device context is relocating the texture right now, this waits until it is done
+        m_pDevice->UnregisterRelocatableResource(this);
+        m_bIsRelocatable.store(false);
+    }
+}
+
+void TextureVkImpl::Relocate(VulkanUtilities::ImageWrapper&&           NewImage,
+                             VulkanUtilities::VulkanMemoryAllocation&& NewAllocation)
+{
+    VERIFY_EXPR(m_bIsRelocatable);
+
+    std::swap(m_VulkanImage, NewImage);
+    std::swap(m_MemoryAllocation, NewAllocation);
+
+    // The old image is still used by the copy commands
+    m_pDevice->SafeReleaseDeviceObject(std::move(NewImage), m_Desc.CommandQueueMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(NewAllocation), m_Desc.CommandQueueMask);
+
+    VERIFY(!m_pDefaultRTV && !m_pDefaultDSV && !m_pDefaultUAV, "Only shader resource view is expected");
+    if (m_pDefaultSRV)
+    {
+        auto ViewDesc = m_pDefaultSRV->GetDesc();
+        auto OldView  = m_pDefaultSRV->ReplaceImageView(CreateImageView(ViewDesc));
+        m_pDevice->SafeReleaseDeviceObject(std::move(OldView), m_Desc.CommandQueueMask);
+    }
+}
+
 VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc& ViewDesc)
 {
     // clang-format off
@@ -419,6 +419,11 @@ void SetAccelStructName(VkDevice device, VkAccelerationStructureKHR accelStruct,
     SetObjectName(device, (uint64_t)accelStruct, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, name);
 }
 
+void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetObjectName(device, (uint64_t)pipelineCache, VK_OBJECT_TYPE_PIPELINE_CACHE, name);
+}
+
 
 template <>
 void SetVulkanObjectName<VkCommandPool, VulkanHandleTypeId::CommandPool>(VkDevice device, VkCommandPool cmdPool, const char* name)
@@ -552,6 +557,12 @@ void SetVulkanObjectName<VkAccelerationStructureKHR, VulkanHandleTypeId::Acceler
     SetAccelStructName(device, accelStruct, name);
 }
 
+template <>
+void SetVulkanObjectName<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetPipelineCacheName(device, pipelineCache, name);
+}
+
 
 const char* VkResultToString(VkResult errorCode)
 {
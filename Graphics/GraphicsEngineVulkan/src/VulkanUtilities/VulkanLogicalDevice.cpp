@@ -305,6 +305,12 @@ AccelStructWrapper VulkanLogicalDevice::CreateAccelStruct(const VkAccelerationSt
 #endif
 }
 
+PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo& CI, const char* DebugName) const
+{
+    VERIFY_EXPR(CI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, CI, DebugName, "pipeline cache");
+}
+
 VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName) const
 {
     VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -456,6 +462,12 @@ void VulkanLogicalDevice::ReleaseVulkanObject(AccelStructWrapper&& AccelStruct)
 #endif
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const
+{
+    vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+    PipelineCache.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -484,6 +496,25 @@ VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkI
     return MemReqs;
 }
 
+VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements2(VkImage vkImage, VkMemoryDedicatedRequirements& DedicatedReqs) const
+{
+    VERIFY(m_EnabledExtFeatures.DedicatedAllocation, "Dedicated allocation is not enabled");
+
+    VkImageMemoryRequirementsInfo2 ReqsInfo = {};
+    ReqsInfo.sType                          = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    ReqsInfo.image                          = vkImage;
+
+    DedicatedReqs       = {};
+    DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 MemReqs2 = {};
+    MemReqs2.sType                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    MemReqs2.pNext                 = &DedicatedReqs;
+
+    vkGetImageMemoryRequirements2(m_VkDevice, &ReqsInfo, &MemReqs2);
+    return MemReqs2.memoryRequirements;
+}
+
 VkResult VulkanLogicalDevice::BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const
 {
     return vkBindBufferMemory(m_VkDevice, buffer, memory, memoryOffset);
@@ -583,6 +614,11 @@ VkResult VulkanLogicalDevice::ResetDescriptorPool(VkDescriptorPool           vkD
     return err;
 }
 
+VkResult VulkanLogicalDevice::GetPipelineCacheData(VkPipelineCache pipelineCache, size_t* pDataSize, void* pData) const
+{
+    return vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+}
+
 VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const
 {
 #if DILIGENT_USE_VOLK
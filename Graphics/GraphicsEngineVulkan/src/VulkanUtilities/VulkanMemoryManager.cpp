@@ -27,11 +27,25 @@
 
 #include "pch.h"
 #include <sstream>
+#include <vector>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
 {
 
+namespace
+{
+
+void UpdatePeakValue(std::atomic_int64_t& PeakValue, int64_t CurrValue)
+{
+    auto Peak = PeakValue.load();
+    while (CurrValue > Peak && !PeakValue.compare_exchange_weak(Peak, CurrValue))
+    {
+    }
+}
+
+} // namespace
+
 VulkanMemoryAllocation::~VulkanMemoryAllocation()
 {
     if (Page != nullptr)
@@ -44,34 +58,54 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
                                    VkDeviceSize          PageSize,
                                    uint32_t              MemoryTypeIndex,
                                    bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) noexcept :
+                                   VkMemoryAllocateFlags AllocateFlags,
+                                   size_t                ShardIndex,
+                                   VkImage               DedicatedImage) :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_ShardIndex     {ShardIndex},
+    m_IsDedicated    {DedicatedImage != VK_NULL_HANDLE}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
-    VkMemoryAllocateInfo      MemAlloc    = {};
-    VkMemoryAllocateFlagsInfo MemFlagInfo = {};
+    VkMemoryAllocateInfo          MemAlloc      = {};
+    VkMemoryAllocateFlagsInfo     MemFlagInfo   = {};
+    VkMemoryDedicatedAllocateInfo DedicatedInfo = {};
 
-    MemAlloc.pNext           = nullptr;
     MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize  = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
+    const void** NextExt = &MemAlloc.pNext;
     if (AllocateFlags)
     {
-        MemAlloc.pNext    = &MemFlagInfo;
         MemFlagInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
-        MemFlagInfo.pNext = nullptr;
         MemFlagInfo.flags = AllocateFlags;
+
+        *NextExt = &MemFlagInfo;
+        NextExt  = &MemFlagInfo.pNext;
     }
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
-    m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
+    if (m_IsDedicated)
+    {
+        DedicatedInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        DedicatedInfo.image  = DedicatedImage;
+        DedicatedInfo.buffer = VK_NULL_HANDLE;
+
+        *NextExt = &DedicatedInfo;
+        NextExt  = &DedicatedInfo.pNext;
+    }
+
+    // make sure that last pNext is null
+    *NextExt = nullptr;
+
+    auto MemoryName = Diligent::FormatString(m_IsDedicated ? "Dedicated device memory. Size: " : "Device memory page. Size: ",
+                                             Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    m_VkMemory = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
     {
@@ -98,7 +132,6 @@ VulkanMemoryPage::~VulkanMemoryPage()
 
 VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSize alignment)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY(size <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "Allocation size (", size, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
@@ -118,15 +151,10 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
 
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
-    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
-    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
-    Allocation = VulkanMemoryAllocation{};
+    m_ParentMemoryMgr.FreeAllocation(*this, std::move(Allocation));
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags)
+uint32_t VulkanMemoryManager::GetMemoryTypeIndex(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps) const
 {
     // memoryTypeBits is a bitmask and contains one bit set for every supported memory type for the resource.
     // Bit i is set if and only if the memory type i in the VkPhysicalDeviceMemoryProperties structure for the
@@ -154,88 +182,347 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
         LOG_ERROR_AND_THROW("Failed to find suitable device memory type for a buffer");
     }
 
-    bool HostVisible = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
-    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
+    return MemoryTypeIndex;
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryManager::MemoryPageShard& VulkanMemoryManager::GetShard(uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
 {
-    VulkanMemoryAllocation Allocation;
+    VERIFY(MemoryTypeIndex < VK_MAX_MEMORY_TYPES, "Memory type index (", MemoryTypeIndex, ") is out of range");
+    VERIFY(AllocateFlags < MaxAllocateFlagsCombinations, "Unexpected memory allocate flags (", AllocateFlags, ")");
 
-    // On integrated GPUs, there is no difference between host-visible and GPU-only
-    // memory, so MemoryTypeIndex is the same. As GPU-only pages do not have CPU address,
-    // we need to use HostVisible flag to differentiate the two.
-    // It is likely a good idea to always keep staging pages separate to reduce fragmenation
-    // even though on integrated GPUs same pages can be used for both GPU-only and staging
-    // allocations. Staging allocations are short-living and will be released when upload is
-    // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    const auto ShardIdx = GetShardIndex(MemoryTypeIndex, HostVisible, AllocateFlags);
+    auto*      pShard   = m_Shards[ShardIdx].load(std::memory_order_acquire);
+    if (pShard == nullptr)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
+        std::lock_guard<std::mutex> Lock{m_ShardsMtx};
+
+        pShard = m_Shards[ShardIdx].load(std::memory_order_acquire);
+        if (pShard == nullptr)
+        {
+            pShard = new MemoryPageShard{MemoryTypeIndex, HostVisible, AllocateFlags};
+            m_Shards[ShardIdx].store(pShard, std::memory_order_release);
+        }
+    }
+    return *pShard;
+}
+
+void VulkanMemoryManager::UpdateFreeSpaceIndex(MemoryPageShard& Shard, VulkanMemoryPage& Page)
+{
+    VERIFY_EXPR(!Page.IsDedicated());
+
+    if (Page.m_InFreeSpaceIndex)
+    {
+        Shard.PagesByFreeSpace.erase(Page.m_FreeSpaceIt);
+        Page.m_InFreeSpaceIndex = false;
+    }
+
+    const VkDeviceSize MaxFreeBlockSize = Page.m_AllocationMgr.GetMaxFreeBlockSize();
+    if (MaxFreeBlockSize > 0)
+    {
+        Page.m_FreeSpaceIt      = Shard.PagesByFreeSpace.emplace(MaxFreeBlockSize, &Page);
+        Page.m_InFreeSpaceIndex = true;
+    }
+}
+
+VulkanMemoryPage& VulkanMemoryManager::CreatePage(MemoryPageShard& Shard, std::unique_ptr<VulkanMemoryPage>&& pPage)
+{
+    auto& Page = *pPage;
+    Shard.Pages.emplace(&Page, std::move(pPage));
+
+    const auto    PageSize          = Page.GetPageSize();
+    const size_t  stat_ind          = Shard.IsHostVisible ? 1 : 0;
+    const int64_t CurrAllocatedSize = m_CurrAllocatedSize[stat_ind].fetch_add(static_cast<int64_t>(PageSize)) + static_cast<int64_t>(PageSize);
+    UpdatePeakValue(m_PeakAllocatedSize[stat_ind], CurrAllocatedSize);
+
+    const auto HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[Shard.MemoryTypeIndex].heapIndex;
+    m_HeapAllocatedSize[HeapIndex].fetch_add(static_cast<int64_t>(PageSize));
+
+    if (!Page.IsDedicated())
+    {
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (Shard.IsHostVisible ? "host-visible" : "device-local"),
+                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", Shard.MemoryTypeIndex,
+                         "). Current allocated size: ", Diligent::FormatMemorySize(static_cast<VkDeviceSize>(CurrAllocatedSize), 2));
+    }
+    OnNewPageCreated(Page);
+
+    return Page;
+}
+
+void VulkanMemoryManager::DestroyPage(std::unique_ptr<VulkanMemoryPage>&& pPage)
+{
+    const auto    PageSize          = pPage->GetPageSize();
+    const bool    IsHostVisible     = pPage->GetCPUMemory() != nullptr;
+    const size_t  stat_ind          = IsHostVisible ? 1 : 0;
+    const int64_t CurrAllocatedSize = m_CurrAllocatedSize[stat_ind].fetch_sub(static_cast<int64_t>(PageSize)) - static_cast<int64_t>(PageSize);
+
+    const auto* pShard    = m_Shards[pPage->m_ShardIndex].load();
+    const auto  HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[pShard->MemoryTypeIndex].heapIndex;
+    m_HeapAllocatedSize[HeapIndex].fetch_sub(static_cast<int64_t>(PageSize));
+
+    if (!pPage->IsDedicated())
+    {
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
+                         " page (", Diligent::FormatMemorySize(PageSize, 2),
+                         "). Current allocated size: ",
+                         Diligent::FormatMemorySize(static_cast<VkDeviceSize>(CurrAllocatedSize), 2));
+    }
+    OnPageDestroy(*pPage);
+    pPage.reset();
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateFromExistingPages(MemoryPageShard&                                   Shard,
+                                                                     VkDeviceSize                                       Size,
+                                                                     VkDeviceSize                                       Alignment,
+                                                                     const std::unordered_set<const VulkanMemoryPage*>* pExcludedPages)
+{
+    // Only pages whose largest free block can hold the allocation are considered, starting with the
+    // tightest fit. Alignment may still make the allocation fail, in which case we try the next page.
+    for (auto page_it = Shard.PagesByFreeSpace.lower_bound(Size); page_it != Shard.PagesByFreeSpace.end(); ++page_it)
+    {
+        auto& Page = *page_it->second;
+        if (pExcludedPages != nullptr && pExcludedPages->find(&Page) != pExcludedPages->end())
+            continue;
+
+        const bool WasEmpty   = Page.IsEmpty();
+        auto       Allocation = Page.Allocate(Size, Alignment);
         if (Allocation.Page != nullptr)
-            break;
+        {
+            if (WasEmpty)
+            {
+                VERIFY_EXPR(Shard.NumEmptyPages > 0);
+                --Shard.NumEmptyPages;
+                m_NumEmptyPages.fetch_sub(1);
+            }
+            // This invalidates page_it
+            UpdateFreeSpaceIndex(Shard, Page);
+            return Allocation;
+        }
     }
 
-    size_t stat_ind = HostVisible ? 1 : 0;
+    return VulkanMemoryAllocation{};
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags)
+{
+    auto MemoryTypeIndex = GetMemoryTypeIndex(MemReqs, MemoryProps);
+    bool HostVisible     = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+{
+    auto& Shard = GetShard(MemoryTypeIndex, HostVisible, AllocateFlags);
+
+    std::unique_lock<std::mutex> Lock{Shard.Mtx};
+
+    auto Allocation = AllocateFromExistingPages(Shard, Size, Alignment, nullptr);
     if (Allocation.Page == nullptr)
     {
         auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
         while (PageSize < Size)
             PageSize *= 2;
 
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+        // Allocating device memory may take a while, so do not block other threads that
+        // allocate from the same shard.
+        Lock.unlock();
+        std::unique_ptr<VulkanMemoryPage> pNewPage{
+            new VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags, GetShardIndex(MemoryTypeIndex, HostVisible, AllocateFlags)} //
+        };
+        Lock.lock();
 
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
+        auto& Page = CreatePage(Shard, std::move(pNewPage));
+        Allocation = Page.Allocate(Size, Alignment);
         DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        UpdateFreeSpaceIndex(Shard, Page);
     }
+    Lock.unlock();
 
     if (Allocation.Page != nullptr)
     {
         VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    size_t stat_ind = HostVisible ? 1 : 0;
+    UpdatePeakValue(m_PeakUsedSize[stat_ind], m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size));
 
     return Allocation;
 }
 
+VulkanMemoryAllocation VulkanMemoryManager::AllocateDedicated(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkImage vkImage)
+{
+    VERIFY_EXPR(vkImage != VK_NULL_HANDLE);
+
+    const auto MemoryTypeIndex = GetMemoryTypeIndex(MemReqs, MemoryProps);
+    const bool HostVisible     = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+
+    auto& Shard = GetShard(MemoryTypeIndex, HostVisible, 0);
+
+    // Allocation size of a dedicated allocation must exactly match the size of the resource (11.6)
+    std::unique_ptr<VulkanMemoryPage> pNewPage{
+        new VulkanMemoryPage{*this, MemReqs.size, MemoryTypeIndex, HostVisible, 0, GetShardIndex(MemoryTypeIndex, HostVisible, 0), vkImage} //
+    };
+
+    VulkanMemoryAllocation Allocation;
+    {
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+        auto& Page = CreatePage(Shard, std::move(pNewPage));
+        // The allocation always starts at offset 0, so no alignment is necessary
+        Allocation = Page.Allocate(MemReqs.size, 1);
+        VERIFY_EXPR(Allocation.Page != nullptr && Allocation.UnalignedOffset == 0 && Page.IsFull());
+    }
+
+    size_t stat_ind = HostVisible ? 1 : 0;
+    UpdatePeakValue(m_PeakUsedSize[stat_ind], m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size));
+
+    return Allocation;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateForRelocation(const VulkanMemoryPage&                            SrcPage,
+                                                                 VkDeviceSize                                       Size,
+                                                                 VkDeviceSize                                       Alignment,
+                                                                 const std::unordered_set<const VulkanMemoryPage*>& ExcludedPages)
+{
+    VERIFY(!SrcPage.IsDedicated(), "Dedicated allocations can't be relocated");
+
+    auto* pShard = m_Shards[SrcPage.m_ShardIndex].load(std::memory_order_acquire);
+    VERIFY_EXPR(pShard != nullptr);
+
+    VulkanMemoryAllocation Allocation;
+    {
+        std::lock_guard<std::mutex> Lock{pShard->Mtx};
+        Allocation = AllocateFromExistingPages(*pShard, Size, Alignment, &ExcludedPages);
+    }
+
+    if (Allocation.Page != nullptr)
+    {
+        size_t stat_ind = pShard->IsHostVisible ? 1 : 0;
+        UpdatePeakValue(m_PeakUsedSize[stat_ind], m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size));
+    }
+
+    return Allocation;
+}
+
+void VulkanMemoryManager::GetDefragmentationPages(std::vector<VulkanMemoryPage*>&                 Pages,
+                                                  std::vector<Diligent::DefragmentationPageInfo>& PageInfos)
+{
+    Pages.clear();
+    PageInfos.clear();
+    for (size_t ShardIdx = 0; ShardIdx < m_Shards.size(); ++ShardIdx)
+    {
+        auto* pShard = m_Shards[ShardIdx].load(std::memory_order_acquire);
+        // Host-visible pages are used for short-living staging allocations and are not defragmented
+        if (pShard == nullptr || pShard->IsHostVisible)
+            continue;
+
+        std::lock_guard<std::mutex> Lock{pShard->Mtx};
+        for (const auto& it : pShard->Pages)
+        {
+            auto& Page = *it.second;
+            if (Page.IsDedicated())
+                continue;
+
+            Pages.push_back(&Page);
+            PageInfos.emplace_back(Page.GetPageSize(), Page.GetUsedSize(), 0, static_cast<Diligent::Uint32>(ShardIdx));
+        }
+    }
+}
+
+void VulkanMemoryManager::FreeAllocation(VulkanMemoryPage& Page, VulkanMemoryAllocation&& Allocation)
+{
+    OnFreeAllocation(Allocation.Size, Page.GetCPUMemory() != nullptr);
+
+    auto* pShard = m_Shards[Page.m_ShardIndex].load(std::memory_order_acquire);
+    VERIFY_EXPR(pShard != nullptr);
+
+    std::unique_ptr<VulkanMemoryPage> pDedicatedPage;
+    {
+        std::lock_guard<std::mutex> Lock{pShard->Mtx};
+
+        VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<VulkanMemoryPage::AllocationsMgrOffsetType>::max());
+        VERIFY_EXPR(Allocation.Size <= std::numeric_limits<VulkanMemoryPage::AllocationsMgrOffsetType>::max());
+        Page.m_AllocationMgr.Free(static_cast<VulkanMemoryPage::AllocationsMgrOffsetType>(Allocation.UnalignedOffset),
+                                  static_cast<VulkanMemoryPage::AllocationsMgrOffsetType>(Allocation.Size));
+
+        if (Page.IsDedicated())
+        {
+            // Dedicated memory is released right away
+            auto page_it = pShard->Pages.find(&Page);
+            VERIFY_EXPR(page_it != pShard->Pages.end());
+            pDedicatedPage = std::move(page_it->second);
+            pShard->Pages.erase(page_it);
+        }
+        else
+        {
+            UpdateFreeSpaceIndex(*pShard, Page);
+            if (Page.IsEmpty())
+            {
+                // Empty pages are released by ShrinkMemory()
+                ++pShard->NumEmptyPages;
+                m_NumEmptyPages.fetch_add(1);
+            }
+        }
+    }
+    Allocation = VulkanMemoryAllocation{};
+
+    if (pDedicatedPage)
+        DestroyPage(std::move(pDedicatedPage));
+}
+
 void VulkanMemoryManager::ShrinkMemory()
 {
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+    // Fast path that does not require any locks
+    if (m_NumEmptyPages.load() == 0)
+        return;
+
+    // clang-format off
+    const std::array<int64_t, 2> ReserveSize =
+    {
+        static_cast<int64_t>(m_DeviceLocalReserveSize),
+        static_cast<int64_t>(m_HostVisibleReserveSize)
+    };
+    // clang-format on
+    std::array<int64_t, 2> AllocatedSize = {m_CurrAllocatedSize[0].load(), m_CurrAllocatedSize[1].load()};
+    if (AllocatedSize[0] <= ReserveSize[0] && AllocatedSize[1] <= ReserveSize[1])
         return;
 
-    auto it = m_Pages.begin();
-    while (it != m_Pages.end())
+    std::vector<std::unique_ptr<VulkanMemoryPage>> PagesToDestroy;
+    for (auto& ShardPtr : m_Shards)
     {
-        auto curr_it = it;
-        ++it;
-        auto& Page          = curr_it->second;
-        bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto* pShard = ShardPtr.load(std::memory_order_acquire);
+        if (pShard == nullptr)
+            continue;
+
+        const size_t stat_ind = pShard->IsHostVisible ? 1 : 0;
+
+        std::lock_guard<std::mutex> Lock{pShard->Mtx};
+        for (auto page_it = pShard->Pages.begin(); page_it != pShard->Pages.end() && pShard->NumEmptyPages > 0 && AllocatedSize[stat_ind] > ReserveSize[stat_ind];)
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
-                             " page (", Diligent::FormatMemorySize(PageSize, 2),
-                             "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+            auto& Page = *page_it->second;
+            if (!Page.IsDedicated() && Page.IsEmpty())
+            {
+                if (Page.m_InFreeSpaceIndex)
+                {
+                    pShard->PagesByFreeSpace.erase(Page.m_FreeSpaceIt);
+                    Page.m_InFreeSpaceIndex = false;
+                }
+                --pShard->NumEmptyPages;
+                m_NumEmptyPages.fetch_sub(1);
+                AllocatedSize[stat_ind] -= static_cast<int64_t>(Page.GetPageSize());
+
+                // Release device memory outside of the lock
+                PagesToDestroy.emplace_back(std::move(page_it->second));
+                page_it = pShard->Pages.erase(page_it);
+            }
+            else
+            {
+                ++page_it;
+            }
         }
     }
+
+    for (auto& pPage : PagesToDestroy)
+        DestroyPage(std::move(pPage));
 }
 
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
@@ -245,20 +532,31 @@ void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
 
 VulkanMemoryManager::~VulkanMemoryManager()
 {
-    auto PeakDeviceLocalPages  = m_PeakAllocatedSize[0] / m_DeviceLocalPageSize;
-    auto PeakHostVisisblePages = m_PeakAllocatedSize[1] / m_HostVisiblePageSize;
+    const VkDeviceSize PeakUsedSize[]      = {static_cast<VkDeviceSize>(m_PeakUsedSize[0].load()), static_cast<VkDeviceSize>(m_PeakUsedSize[1].load())};
+    const VkDeviceSize PeakAllocatedSize[] = {static_cast<VkDeviceSize>(m_PeakAllocatedSize[0].load()), static_cast<VkDeviceSize>(m_PeakAllocatedSize[1].load())};
+
+    auto PeakDeviceLocalPages  = PeakAllocatedSize[0] / m_DeviceLocalPageSize;
+    auto PeakHostVisisblePages = PeakAllocatedSize[1] / m_HostVisiblePageSize;
     LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "' stats:\n"
                                                          "                       Peak used/allocated device-local memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[0], 2, m_PeakAllocatedSize[0]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[0], 2, m_PeakAllocatedSize[0]),
+                     Diligent::FormatMemorySize(PeakUsedSize[0], 2, PeakAllocatedSize[0]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[0], 2, PeakAllocatedSize[0]),
                      " (", PeakDeviceLocalPages, (PeakDeviceLocalPages == 1 ? " page)" : " pages)"),
                      "\n                       Peak used/allocated host-visible memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
+                     Diligent::FormatMemorySize(PeakUsedSize[1], 2, PeakAllocatedSize[1]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[1], 2, PeakAllocatedSize[1]),
                      " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"));
 
-    for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
-        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    for (auto& ShardPtr : m_Shards)
+    {
+        auto* pShard = ShardPtr.load();
+        if (pShard == nullptr)
+            continue;
+
+        for (const auto& it : pShard->Pages)
+            VERIFY(it.second->IsEmpty(), "The page contains outstanding allocations");
+        delete pShard;
+    }
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
@@ -217,6 +217,15 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
             m_ExtProperties.Subgroup.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
         }
 
+        // Dedicated allocations are part of Vulkan 1.1 core.
+        if (VkVersion >= VK_API_VERSION_1_1)
+            m_ExtFeatures.DedicatedAllocation = true;
+
+        // Memory budget is queried with vkGetPhysicalDeviceMemoryProperties2KHR that is
+        // provided by VK_KHR_get_physical_device_properties2 extension.
+        if (IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+            m_ExtFeatures.MemoryBudget = true;
+
         // make sure that last pNext is null
         *NextFeat = nullptr;
         *NextProp = nullptr;
@@ -367,4 +376,21 @@ VkFormatProperties VulkanPhysicalDevice::GetPhysicalDeviceFormatProperties(VkFor
     return formatProperties;
 }
 
+void VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const
+{
+    Budget       = {};
+    Budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+#if DILIGENT_USE_VOLK
+    VERIFY(m_ExtFeatures.MemoryBudget, "VK_EXT_memory_budget extension is not supported by the device");
+
+    auto MemProps2  = VkPhysicalDeviceMemoryProperties2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2};
+    MemProps2.pNext = &Budget;
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemProps2);
+    Budget.pNext = nullptr;
+#else
+    UNSUPPORTED("vkGetPhysicalDeviceMemoryProperties2KHR is only available through Volk");
+#endif
+}
+
 } // namespace VulkanUtilities
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "VulkanUtilities/VulkanPipelineCacheHeader.hpp"
+
+namespace VulkanUtilities
+{
+
+PIPELINE_CACHE_HEADER_STATUS ValidatePipelineCacheHeader(const void*                       pData,
+                                                         size_t                            DataSize,
+                                                         const VkPhysicalDeviceProperties& DeviceProps,
+                                                         PipelineCacheHeaderOne*           pHeader)
+{
+    // Header layout (VK_PIPELINE_CACHE_HEADER_VERSION_ONE):
+    //    uint32_t headerSize
+    //    uint32_t headerVersion
+    //    uint32_t vendorID
+    //    uint32_t deviceID
+    //    uint8_t  pipelineCacheUUID[VK_UUID_SIZE]
+    constexpr size_t HeaderSize = sizeof(uint32_t) * 4 + VK_UUID_SIZE;
+    static_assert(sizeof(PipelineCacheHeaderOne) == HeaderSize, "Unexpected sizeof(PipelineCacheHeaderOne)");
+
+    if (pData == nullptr || DataSize < HeaderSize)
+        return PIPELINE_CACHE_HEADER_STATUS_MALFORMED;
+
+    PipelineCacheHeaderOne Header;
+    memcpy(&Header, pData, HeaderSize);
+    if (pHeader != nullptr)
+        *pHeader = Header;
+
+    if (Header.HeaderSize < HeaderSize || Header.HeaderSize > DataSize)
+        return PIPELINE_CACHE_HEADER_STATUS_MALFORMED;
+
+    if (Header.HeaderVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+        return PIPELINE_CACHE_HEADER_STATUS_UNSUPPORTED_VERSION;
+
+    if (Header.VendorID != DeviceProps.vendorID || Header.DeviceID != DeviceProps.deviceID)
+        return PIPELINE_CACHE_HEADER_STATUS_DEVICE_MISMATCH;
+
+    if (memcmp(Header.PipelineCacheUUID, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        return PIPELINE_CACHE_HEADER_STATUS_UUID_MISMATCH;
+
+    return PIPELINE_CACHE_HEADER_STATUS_OK;
+}
+
+} // namespace VulkanUtilities
@@ -124,8 +124,67 @@ struct IDynamicTextureAtlas : public IObject
     virtual const TextureDesc& GetAtlasDesc() const = 0;
 
     /// Returns internal texture array version. The version is incremented every time
-    /// the array is expanded.
+    /// the array is expanded or the atlas is defragmented.
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Repacks suballocations in every slice to reduce fragmentation.
+
+    /// \param[in]  pDevice  - Pointer to the render device that will be used to
+    ///                        create a new internal texture array.
+    /// \param[in]  pContext - Pointer to the device context that will be used to
+    ///                        copy the contents of the moved suballocations.
+    ///
+    /// \return     The number of suballocations that have been moved.
+    ///
+    /// \remarks    Suballocations are repacked on the CPU and their contents is moved to a new
+    ///             texture array with GPU copy commands. If any suballocation has been moved,
+    ///             the version is incremented, and all values previously returned by
+    ///             GetOrigin() and GetUVScaleBias() as well as the texture returned by
+    ///             GetTexture() must be requeried.
+    ///
+    ///             All mip levels are moved with their suballocations. If the texture granularity
+    ///             is too small to move the coarsest mip level (i.e. the granularity is less
+    ///             than 2^(MipLevels-1)), the atlas is not defragmented and the method returns 0.
+    ///
+    ///             Allocations and releases of suballocations are blocked while the method runs.
+    ///             The method must not run concurrently with GetTexture(), and the application
+    ///             must not access the values and the texture mentioned above until it returns.
+    virtual Uint32 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext) = 0;
+};
+
+
+/// Dynamic texture atlas region packing policy.
+DILIGENT_TYPED_ENUM(DYNAMIC_TEXTURE_ATLAS_PACKING, Uint8)
+{
+    /// Free space is split into a guillotine partition. Fast, but fragments quickly
+    /// when regions of different sizes are allocated and released.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_GUILLOTINE = 0,
+
+    /// Free space is tracked as a set of maximal free rectangles.
+    /// Packs denser than guillotine, but allocation cost grows with the number of
+    /// free rectangles.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_MAX_RECTS
+};
+
+
+/// Free rectangle selection heuristic used by DYNAMIC_TEXTURE_ATLAS_PACKING_MAX_RECTS.
+DILIGENT_TYPED_ENUM(DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC, Uint8)
+{
+    /// Minimize the shorter leftover side.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BEST_SHORT_SIDE_FIT = 0,
+
+    /// Minimize the longer leftover side.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BEST_LONG_SIDE_FIT,
+
+    /// Minimize the area of the free rectangle.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BEST_AREA_FIT,
+
+    /// Place regions as close to the origin as possible.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BOTTOM_LEFT,
+
+    /// Maximize the region perimeter that touches other regions and atlas borders.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_CONTACT_POINT
 };
 
 
@@ -158,6 +217,13 @@ struct DynamicTextureAtlasCreateInfo
     Uint32 MaxSliceCount = 2048;
 
 
+    /// Region packing policy, see Diligent::DYNAMIC_TEXTURE_ATLAS_PACKING.
+    DYNAMIC_TEXTURE_ATLAS_PACKING Packing = DYNAMIC_TEXTURE_ATLAS_PACKING_GUILLOTINE;
+
+    /// Free rectangle selection heuristic when Packing is DYNAMIC_TEXTURE_ATLAS_PACKING_MAX_RECTS.
+    DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC MaxRectsHeuristic = DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BEST_SHORT_SIDE_FIT;
+
+
     /// Allocation granularity for ITextureAtlasSuballocation objects.
 
     /// Texture atlas uses FixedBlockMemoryAllocator to allocate instances
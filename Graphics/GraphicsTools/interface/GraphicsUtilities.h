@@ -34,6 +34,8 @@
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 
+#include "../../../Primitives/interface/DefineGlobalFuncHelperMacros.h"
+
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 void DILIGENT_GLOBAL_FUNCTION(CreateUniformBuffer)(IRenderDevice*                  pDevice,
@@ -61,4 +63,70 @@ void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(Uint32         FineLevelWidth,
                                                void*          pCoarseLevelData,
                                                Uint32         CoarseDataStrideInBytes);
 
+
+/// Mip level downsampling filter
+DILIGENT_TYPED_ENUM(MIP_FILTER_TYPE, Uint8)
+{
+    /// 2x2 box filter, the same filter that is used by ComputeMipLevel().
+    MIP_FILTER_TYPE_BOX = 0,
+
+    /// Kaiser-windowed sinc filter (radius 3, alpha 4).
+    MIP_FILTER_TYPE_KAISER,
+
+    /// Lanczos filter with three lobes.
+    MIP_FILTER_TYPE_LANCZOS
+};
+
+
+/// ComputeMipChain() attributes
+struct ComputeMipChainAttribs
+{
+    /// The width of the top mip level
+    Uint32          Width         DEFAULT_INITIALIZER(0);
+
+    /// The height of the top mip level
+    Uint32          Height        DEFAULT_INITIALIZER(0);
+
+    /// Texture format
+    TEXTURE_FORMAT  Format        DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// Top mip level data
+    const void*     pData         DEFAULT_INITIALIZER(nullptr);
+
+    /// Top mip level row stride, in bytes
+    Uint32          Stride        DEFAULT_INITIALIZER(0);
+
+    /// The number of coarse mip levels to compute, excluding the top level.
+    /// ppMipData and pMipStrides must contain NumMipLevels elements.
+    Uint32          NumMipLevels  DEFAULT_INITIALIZER(0);
+
+    /// Pointers to the coarse mip level data, starting with mip level 1
+    void* const*    ppMipData     DEFAULT_INITIALIZER(nullptr);
+
+    /// Coarse mip level row strides, in bytes, starting with mip level 1
+    const Uint32*   pMipStrides   DEFAULT_INITIALIZER(nullptr);
+
+    /// Downsampling filter, see Diligent::MIP_FILTER_TYPE.
+    MIP_FILTER_TYPE Filter        DEFAULT_INITIALIZER(MIP_FILTER_TYPE_BOX);
+
+    /// The maximum number of threads to use. Rows of every level are split between
+    /// the calling thread and the worker threads of a thread pool that is shared by
+    /// all calls. Zero or one means the calling thread only.
+    Uint32          NumThreads    DEFAULT_INITIALIZER(1);
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
+
+/// Computes the entire chain of coarse mip levels.
+
+/// \param [in] Attribs - Mip chain attributes, see Diligent::ComputeMipChainAttribs.
+///
+/// \remarks   With the box filter, every level is computed from the previous one exactly
+///            as ComputeMipLevel() does. Kaiser and Lanczos filters are evaluated in 32-bit
+///            floating point, and every level is computed from the unquantized previous level.
+///            Filtered mip chains are supported for UNORM8, sRGB8, UNORM16, FLOAT16, FLOAT32 and
+///            R11G11B10 formats. Other formats fall back to the box filter.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
+
+#include "../../../Primitives/interface/UndefGlobalFuncHelperMacros.h"
@@ -30,6 +30,8 @@
 #include <mutex>
 #include <algorithm>
 #include <atomic>
+#include <unordered_map>
+#include <vector>
 
 #include "DynamicAtlasManager.hpp"
 #include "ObjectBase.hpp"
@@ -107,6 +109,15 @@ public:
         return m_pUserData.RawPtr<IObject>();
     }
 
+    // Called by the parent atlas when the suballocation is moved during defragmentation.
+    // The caller must hold the lock of the slice manager that owns the suballocation.
+    void SetSubregion(const DynamicAtlasManager::Region& Subregion)
+    {
+        VERIFY_EXPR(!Subregion.IsEmpty());
+        VERIFY_EXPR(Subregion.width == m_Subregion.width && Subregion.height == m_Subregion.height);
+        m_Subregion = Subregion;
+    }
+
 private:
     RefCntAutoPtr<DynamicTextureAtlasImpl> m_pParentAtlas;
 
@@ -134,6 +145,8 @@ public:
         m_Granularity     {CreateInfo.TextureGranularity},
         m_ExtraSliceCount {CreateInfo.ExtraSliceCount},
         m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
+        m_Packing         {static_cast<DynamicAtlasManager::PackingPolicy>(CreateInfo.Packing)},
+        m_Heuristic       {static_cast<DynamicAtlasManager::MaxRectsHeuristic>(CreateInfo.MaxRectsHeuristic)},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -166,11 +179,17 @@ public:
         if ((m_Desc.Height % m_Granularity) != 0)
             LOG_ERROR_AND_THROW("Texture height (", m_Desc.Height, ") is not a multiple of granularity (", m_Granularity, ")");
 
+        if (CreateInfo.Packing > DYNAMIC_TEXTURE_ATLAS_PACKING_MAX_RECTS)
+            LOG_ERROR_AND_THROW("Invalid packing policy (", Uint32{CreateInfo.Packing}, ")");
+
+        if (CreateInfo.MaxRectsHeuristic > DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_CONTACT_POINT)
+            LOG_ERROR_AND_THROW("Invalid MaxRects heuristic (", Uint32{CreateInfo.MaxRectsHeuristic}, ")");
+
         m_Desc.Name = m_Name.c_str();
 
         for (Uint32 slice = 0; slice < m_Desc.ArraySize; ++slice)
         {
-            m_Slices.emplace_back(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
+            m_Slices.emplace_back(CreateSliceManager());
         }
 
         if (pDevice == nullptr)
@@ -194,6 +213,13 @@ public:
             std::lock_guard<std::mutex> Lock{m_SlicesMtx};
             ArraySize = static_cast<Uint32>(m_Slices.size());
         }
+        ResizeTexture(pDevice, pContext, ArraySize);
+
+        return m_pTexture;
+    }
+
+    void ResizeTexture(IRenderDevice* pDevice, IDeviceContext* pContext, Uint32 ArraySize)
+    {
         if (m_Desc.ArraySize != ArraySize)
         {
             DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr,
@@ -235,8 +261,6 @@ public:
 
             m_pTexture = std::move(pNewTexture);
         }
-
-        return m_pTexture;
     }
 
     virtual void Allocate(Uint32                       Width,
@@ -255,7 +279,23 @@ public:
             return;
         }
 
-        DynamicAtlasManager::Region Subregion;
+        const uint2 Size{Width, Height};
+
+        // The suballocation object is created and registered while the slice is locked,
+        // so that defragmentation never observes a region that has no owner.
+        auto CreateSuballocation = [&](const DynamicAtlasManager::Region& Subregion, Uint32 Slice) {
+            // clang-format off
+            return NEW_RC_OBJ(m_SuballocationsAllocator, "TextureAtlasSuballocationImpl instance", TextureAtlasSuballocationImpl)
+                (
+                    this,
+                    DynamicAtlasManager::Region{Subregion},
+                    Slice,
+                    Size
+                );
+            // clang-format on
+        };
+
+        TextureAtlasSuballocationImpl* pSuballocation = nullptr;
 
         Uint32 Slice = 0;
         while (Slice < m_MaxSliceCount)
@@ -271,49 +311,40 @@ public:
 
                     for (Uint32 ExtraSlice = 0; ExtraSlice < ExtraSliceCount && Slice + ExtraSlice < m_MaxSliceCount; ++ExtraSlice)
                     {
-                        m_Slices.emplace_back(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
+                        m_Slices.emplace_back(CreateSliceManager());
                     }
                 }
                 pSliceMgr = m_Slices[Slice].get();
             }
 
-            Subregion = pSliceMgr->Allocate((Width + m_Granularity - 1) / m_Granularity,
-                                            (Height + m_Granularity - 1) / m_Granularity);
-            if (!Subregion.IsEmpty())
+            pSuballocation = pSliceMgr->Allocate((Width + m_Granularity - 1) / m_Granularity,
+                                                 (Height + m_Granularity - 1) / m_Granularity,
+                                                 [&](const DynamicAtlasManager::Region& Subregion) {
+                                                     return CreateSuballocation(Subregion, Slice);
+                                                 });
+            if (pSuballocation != nullptr)
                 break;
             else
                 ++Slice;
         }
 
-        if (Subregion.IsEmpty())
+        if (pSuballocation == nullptr)
         {
             LOG_ERROR_MESSAGE("Failed to suballocate texture subregion ", Width, " x ", Height, " from texture atlas");
             return;
         }
 
-        // clang-format off
-        TextureAtlasSuballocationImpl* pSuballocation{
-            NEW_RC_OBJ(m_SuballocationsAllocator, "TextureAtlasSuballocationImpl instance", TextureAtlasSuballocationImpl)
-            (
-                this, 
-                std::move(Subregion),
-                Slice,
-                uint2{Width, Height}
-            )
-        };
-        // clang-format on
-
         pSuballocation->QueryInterface(IID_TextureAtlasSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
     }
 
-    virtual void Free(Uint32 Slice, DynamicAtlasManager::Region&& Subregion)
+    void Free(Uint32 Slice, TextureAtlasSuballocationImpl* pSuballocation)
     {
         SliceManager* pSliceMgr = nullptr;
         {
             std::lock_guard<std::mutex> Lock{m_SlicesMtx};
             pSliceMgr = m_Slices[Slice].get();
         }
-        pSliceMgr->Free(std::move(Subregion));
+        pSliceMgr->Free(pSuballocation);
     }
 
     virtual const TextureDesc& GetAtlasDesc() const override final
@@ -326,6 +357,114 @@ public:
         return m_Version.load();
     }
 
+    virtual Uint32 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext) override final
+    {
+        // Regions are moved in units of granularity. If a mip level is coarser than one
+        // granularity cell, the moved regions can't be copied to it.
+        const auto MipLevels = m_Desc.MipLevels != 0 ? m_Desc.MipLevels : ComputeMipLevelsCount(m_Desc.Width, m_Desc.Height);
+        if ((m_Granularity >> (MipLevels - 1)) == 0)
+        {
+            LOG_WARNING_MESSAGE("Dynamic texture atlas '", m_Desc.Name, "' can't be defragmented: the granularity (", m_Granularity,
+                                ") is too small to move all ", MipLevels, " mip levels of the suballocations");
+            return 0;
+        }
+
+        // Hold all locks for the entire pass so that no region can be allocated or
+        // released while the suballocations are being moved to the new texture.
+        std::lock_guard<std::mutex> SlicesLock{m_SlicesMtx};
+
+        // Make sure that the texture has all slices before the contents is moved
+        ResizeTexture(pDevice, pContext, static_cast<Uint32>(m_Slices.size()));
+
+        std::vector<std::unique_lock<std::mutex>> SliceLocks;
+        SliceLocks.reserve(m_Slices.size());
+        for (auto& pSliceMgr : m_Slices)
+            SliceLocks.emplace_back(pSliceMgr->Lock());
+
+        struct SliceMove
+        {
+            Uint32                          Slice;
+            DynamicAtlasManager::RegionMove Move;
+        };
+        std::vector<SliceMove> AllMoves;
+
+        std::vector<DynamicAtlasManager::RegionMove> Moves;
+        for (Uint32 Slice = 0; Slice < m_Slices.size(); ++Slice)
+        {
+            m_Slices[Slice]->Defragment(Moves);
+            for (const auto& Move : Moves)
+                AllMoves.push_back({Slice, Move});
+        }
+
+        if (AllMoves.empty())
+            return 0;
+
+        if (m_pTexture)
+        {
+            DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr,
+                          "Texture atlas is being defragmented, but pDevice or pContext is null");
+
+            const auto& TexDesc = m_pTexture->GetDesc();
+
+            RefCntAutoPtr<ITexture> pNewTexture;
+            pDevice->CreateTexture(m_Desc, nullptr, &pNewTexture);
+            VERIFY_EXPR(pNewTexture);
+
+            CopyTextureAttribs CopyAttribs;
+            CopyAttribs.pSrcTexture              = m_pTexture;
+            CopyAttribs.pDstTexture              = pNewTexture;
+            CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+            // Copy everything first to preserve regions that stay in place
+            for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+            {
+                for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+                {
+                    CopyAttribs.SrcSlice    = slice;
+                    CopyAttribs.DstSlice    = slice;
+                    CopyAttribs.SrcMipLevel = mip;
+                    CopyAttribs.DstMipLevel = mip;
+                    pContext->CopyTexture(CopyAttribs);
+                }
+            }
+
+            for (const auto& SliceMove : AllMoves)
+            {
+                const auto& Src = SliceMove.Move.Src;
+                const auto& Dst = SliceMove.Move.Dst;
+                for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+                {
+                    const auto MipGranularity = m_Granularity >> mip;
+
+                    Box SrcBox;
+                    SrcBox.MinX = Src.x * MipGranularity;
+                    SrcBox.MaxX = (Src.x + Src.width) * MipGranularity;
+                    SrcBox.MinY = Src.y * MipGranularity;
+                    SrcBox.MaxY = (Src.y + Src.height) * MipGranularity;
+
+                    CopyAttribs.pSrcBox     = &SrcBox;
+                    CopyAttribs.SrcSlice    = SliceMove.Slice;
+                    CopyAttribs.DstSlice    = SliceMove.Slice;
+                    CopyAttribs.SrcMipLevel = mip;
+                    CopyAttribs.DstMipLevel = mip;
+                    CopyAttribs.DstX        = Dst.x * MipGranularity;
+                    CopyAttribs.DstY        = Dst.y * MipGranularity;
+                    pContext->CopyTexture(CopyAttribs);
+                }
+            }
+
+            m_pTexture = std::move(pNewTexture);
+        }
+
+        m_Version.fetch_add(1);
+
+        LOG_INFO_MESSAGE("Dynamic texture atlas: defragmented texture array '", m_Desc.Name, "'. ",
+                         AllMoves.size(), " suballocations moved. Version: ", GetVersion());
+
+        return static_cast<Uint32>(AllMoves.size());
+    }
+
     Uint32 GetGranularity() const
     {
         return m_Granularity;
@@ -339,6 +478,9 @@ private:
     const Uint32 m_ExtraSliceCount;
     const Uint32 m_MaxSliceCount;
 
+    const DynamicAtlasManager::PackingPolicy     m_Packing;
+    const DynamicAtlasManager::MaxRectsHeuristic m_Heuristic;
+
     RefCntAutoPtr<ITexture> m_pTexture;
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
@@ -348,25 +490,91 @@ private:
 
     struct SliceManager
     {
-        SliceManager(Uint32 Width, Uint32 Height) :
-            Mgr{Width, Height}
+        SliceManager(Uint32                                 Width,
+                     Uint32                                 Height,
+                     DynamicAtlasManager::PackingPolicy     Packing,
+                     DynamicAtlasManager::MaxRectsHeuristic Heuristic) :
+            Mgr{Width, Height, Packing, Heuristic}
         {}
 
-        DynamicAtlasManager::Region Allocate(Uint32 Width, Uint32 Height)
+        // Allocates the region and calls CreateSuballocation(Region) to create its owner while the slice is locked.
+        // Returns null if there is not enough space in the slice.
+        template <typename CreateSuballocationType>
+        TextureAtlasSuballocationImpl* Allocate(Uint32 Width, Uint32 Height, CreateSuballocationType&& CreateSuballocation)
         {
             std::lock_guard<std::mutex> Lock{Mtx};
-            return Mgr.Allocate(Width, Height);
+
+            auto Region = Mgr.Allocate(Width, Height);
+            if (Region.IsEmpty())
+                return nullptr;
+
+            auto* pSuballocation = CreateSuballocation(Region);
+            Suballocations.emplace(pSuballocation, std::move(Region));
+            return pSuballocation;
         }
-        void Free(DynamicAtlasManager::Region&& Region)
+
+        // The region is looked up under the lock as defragmentation may be moving it
+        void Free(TextureAtlasSuballocationImpl* pSuballocation)
         {
             std::lock_guard<std::mutex> Lock{Mtx};
-            Mgr.Free(std::move(Region));
+
+            auto it = Suballocations.find(pSuballocation);
+            if (it == Suballocations.end())
+            {
+                UNEXPECTED("Suballocation is not found in the slice");
+                return;
+            }
+            Mgr.Free(std::move(it->second));
+            Suballocations.erase(it);
+        }
+
+        std::unique_lock<std::mutex> Lock()
+        {
+            return std::unique_lock<std::mutex>{Mtx};
+        }
+
+        // The caller must hold the lock returned by Lock()
+        void Defragment(std::vector<DynamicAtlasManager::RegionMove>& Moves)
+        {
+            if (!Mgr.Defragment(Moves))
+                return;
+
+            // Destination of one move may be the source of another one, so all
+            // sources must be resolved before any suballocation is updated.
+            std::unordered_map<DynamicAtlasManager::Region, TextureAtlasSuballocationImpl*, DynamicAtlasManager::Region::Hasher> RegionOwners;
+            RegionOwners.reserve(Suballocations.size());
+            for (const auto& it : Suballocations)
+                RegionOwners.emplace(it.second, it.first);
+
+            for (const auto& Move : Moves)
+            {
+                auto owner_it = RegionOwners.find(Move.Src);
+                if (owner_it == RegionOwners.end())
+                {
+                    UNEXPECTED("Moved region has no owner");
+                    continue;
+                }
+                auto* pSuballocation = owner_it->second;
+
+                Suballocations[pSuballocation] = Move.Dst;
+                pSuballocation->SetSubregion(Move.Dst);
+            }
         }
 
     private:
         std::mutex          Mtx;
         DynamicAtlasManager Mgr;
+
+        // Regions of all live suballocations. A suballocation that is being destroyed
+        // stays in the map until Free() is called, so defragmentation may still move it.
+        std::unordered_map<TextureAtlasSuballocationImpl*, DynamicAtlasManager::Region> Suballocations;
     };
+
+    SliceManager* CreateSliceManager() const
+    {
+        return new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity, m_Packing, m_Heuristic};
+    }
+
     std::mutex                                 m_SlicesMtx;
     std::vector<std::unique_ptr<SliceManager>> m_Slices;
 };
@@ -374,7 +582,7 @@ private:
 
 TextureAtlasSuballocationImpl::~TextureAtlasSuballocationImpl()
 {
-    m_pParentAtlas->Free(m_Slice, std::move(m_Subregion));
+    m_pParentAtlas->Free(m_Slice, this);
 }
 
 uint2 TextureAtlasSuballocationImpl::GetOrigin() const
@@ -26,12 +26,19 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
+#include "Float16.hpp"
+#include "ThreadPool.hpp"
+#include "SIMDHelpers.hpp"
 
 #define PI_F 3.1415926f
 
@@ -63,6 +70,17 @@ void CreateUniformBuffer(IRenderDevice*   pDevice,
     pDevice->CreateBuffer(CBDesc, pInitialData != nullptr ? &InitialData : nullptr, ppBuffer);
 }
 
+float GetCheckerBoardPatternValue(Uint32 x, Uint32 y, Uint32 Width, Uint32 Height, Uint32 HorzCells, Uint32 VertCells)
+{
+    float horzWave = sin((static_cast<float>(x) + 0.5f) / static_cast<float>(Width) * PI_F * static_cast<float>(HorzCells));
+    float vertWave = sin((static_cast<float>(y) + 0.5f) / static_cast<float>(Height) * PI_F * static_cast<float>(VertCells));
+    float val      = horzWave * vertWave;
+    val            = std::max(std::min(val * 20.f, +1.f), -1.f);
+    val            = val * 0.5f + 1.f;
+    val            = val * 0.5f + 0.25f;
+    return val;
+}
+
 template <class TConverter>
 void GenerateCheckerBoardPatternInternal(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt, Uint32 HorzCells, Uint32 VertCells, Uint8* pData, Uint32 StrideInBytes, TConverter Converter)
 {
@@ -71,18 +89,37 @@ void GenerateCheckerBoardPatternInternal(Uint32 Width, Uint32 Height, TEXTURE_FO
     {
         for (Uint32 x = 0; x < Width; ++x)
         {
-            float horzWave   = sin((static_cast<float>(x) + 0.5f) / static_cast<float>(Width) * PI_F * static_cast<float>(HorzCells));
-            float vertWave   = sin((static_cast<float>(y) + 0.5f) / static_cast<float>(Height) * PI_F * static_cast<float>(VertCells));
-            float val        = horzWave * vertWave;
-            val              = std::max(std::min(val * 20.f, +1.f), -1.f);
-            val              = val * 0.5f + 1.f;
-            val              = val * 0.5f + 0.25f;
+            float  val       = GetCheckerBoardPatternValue(x, y, Width, Height, HorzCells, VertCells);
             Uint8* pDstTexel = pData + x * Uint32{FmtAttribs.NumComponents} * Uint32{FmtAttribs.ComponentSize} + y * StrideInBytes;
             Converter(pDstTexel, Uint32{FmtAttribs.NumComponents}, val);
         }
     }
 }
 
+void GenerateSRGBCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt, Uint32 HorzCells, Uint32 VertCells, Uint8* pData, Uint32 StrideInBytes)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
+    VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
+
+    // Every row is generated in linear space and converted to sRGB at once
+    std::vector<float> LinearRow(Width);
+    std::vector<Uint8> SRGBRow(Width);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            LinearRow[x] = GetCheckerBoardPatternValue(x, y, Width, Height, HorzCells, VertCells);
+
+        LinearFloatToSRGB8(LinearRow.data(), SRGBRow.data(), Width);
+
+        Uint8* pDstRow = pData + y * StrideInBytes;
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            for (Uint32 c = 0; c < FmtAttribs.NumComponents; ++c)
+                pDstRow[x * FmtAttribs.NumComponents + c] = SRGBRow[x];
+        }
+    }
+}
+
 void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt, Uint32 HorzCells, Uint32 VertCells, Uint8* pData, Uint32 StrideInBytes)
 {
     const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
@@ -102,15 +139,7 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
             break;
 
         case COMPONENT_TYPE_UNORM_SRGB:
-            GenerateCheckerBoardPatternInternal(
-                Width, Height, Fmt, HorzCells, VertCells, pData, StrideInBytes,
-                [](Uint8* pDstTexel, Uint32 NumComponents, float fVal) //
-                {
-                    Uint8 uVal = static_cast<Uint8>(FastLinearToSRGB(fVal) * 255.f);
-                    for (Uint32 c = 0; c < NumComponents; ++c)
-                        pDstTexel[c] = uVal;
-                } //
-            );
+            GenerateSRGBCheckerBoardPattern(Width, Height, Fmt, HorzCells, VertCells, pData, StrideInBytes);
             break;
 
         case COMPONENT_TYPE_FLOAT:
@@ -132,29 +161,6 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
 
 
 
-template <typename ChannelType>
-ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3)
-{
-    static_assert(std::numeric_limits<ChannelType>::is_integer && !std::numeric_limits<ChannelType>::is_signed, "Unsigned integers are expected");
-
-    static constexpr float MaxVal    = static_cast<float>(std::numeric_limits<ChannelType>::max());
-    static constexpr float MaxValInv = 1.f / MaxVal;
-
-    float fc0 = static_cast<float>(c0) * MaxValInv;
-    float fc1 = static_cast<float>(c1) * MaxValInv;
-    float fc2 = static_cast<float>(c2) * MaxValInv;
-    float fc3 = static_cast<float>(c3) * MaxValInv;
-
-    float fLinearAverage = (FastSRGBToLinear(fc0) + FastSRGBToLinear(fc1) + FastSRGBToLinear(fc2) + FastSRGBToLinear(fc3)) * 0.25f;
-    float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * MaxVal;
-
-    // Clamping on both ends is essential because fast SRGB math is imprecise
-    fSRGBAverage = std::max(fSRGBAverage, 0.f);
-    fSRGBAverage = std::min(fSRGBAverage, MaxVal);
-
-    return static_cast<ChannelType>(fSRGBAverage);
-}
-
 template <typename ChannelType>
 ChannelType LinearAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3);
 
@@ -200,6 +206,25 @@ float LinearAverage<float>(float c0, float c1, float c2, float c3)
     return (c0 + c1 + c2 + c3) * 0.25f;
 }
 
+// Averages four half-precision floats
+Uint16 Float16Average(Uint16 c0, Uint16 c1, Uint16 c2, Uint16 c3)
+{
+    return Float32ToFloat16((Float16ToFloat32(c0) + Float16ToFloat32(c1) + Float16ToFloat32(c2) + Float16ToFloat32(c3)) * 0.25f);
+}
+
+// Averages four packed R11G11B10 floats
+Uint32 R11G11B10Average(Uint32 c0, Uint32 c1, Uint32 c2, Uint32 c3)
+{
+    float R[4], G[4], B[4];
+    UnpackR11G11B10Float(c0, R[0], G[0], B[0]);
+    UnpackR11G11B10Float(c1, R[1], G[1], B[1]);
+    UnpackR11G11B10Float(c2, R[2], G[2], B[2]);
+    UnpackR11G11B10Float(c3, R[3], G[3], B[3]);
+    return PackR11G11B10Float((R[0] + R[1] + R[2] + R[3]) * 0.25f,
+                              (G[0] + G[1] + G[2] + G[3]) * 0.25f,
+                              (B[0] + B[1] + B[2] + B[3]) * 0.25f);
+}
+
 struct ComputeCoarseMipHelper
 {
     const Uint32 FineMipWidth;
@@ -213,6 +238,10 @@ struct ComputeCoarseMipHelper
 
     const Uint32 NumChannels;
 
+    // Range of coarse mip rows to compute
+    const Uint32 StartRow;
+    const Uint32 EndRow;
+
     template <typename ChannelType,
               typename AverageFuncType>
     void Run(AverageFuncType ComputeAverage) const
@@ -220,12 +249,14 @@ struct ComputeCoarseMipHelper
         VERIFY_EXPR(FineMipWidth > 0 && FineMipHeight > 0);
         VERIFY(FineMipHeight == 1 || FineMipStride >= FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
 
-        const auto CoarseMipWidth  = std::max(FineMipWidth / Uint32{2}, Uint32{1});
+        const auto CoarseMipWidth = std::max(FineMipWidth / Uint32{2}, Uint32{1});
+#ifdef DILIGENT_DEBUG
         const auto CoarseMipHeight = std::max(FineMipHeight / Uint32{2}, Uint32{1});
-
         VERIFY(CoarseMipHeight == 1 || CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * NumChannels, "Coarse mip level stride is too small");
+        VERIFY_EXPR(StartRow <= EndRow && EndRow <= CoarseMipHeight);
+#endif
 
-        for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+        for (Uint32 row = StartRow; row < EndRow; ++row)
         {
             auto src_row0 = row * 2;
             auto src_row1 = std::min(row * 2 + 1, FineMipHeight - 1);
@@ -254,16 +285,290 @@ struct ComputeCoarseMipHelper
     }
 };
 
-void ComputeMipLevel(Uint32         FineLevelWidth,
-                     Uint32         FineLevelHeight,
-                     TEXTURE_FORMAT Fmt,
-                     const void*    pFineLevelData,
-                     Uint32         FineDataStrideInBytes,
-                     void*          pCoarseLevelData,
-                     Uint32         CoarseDataStrideInBytes)
+
+// Box filter row kernels for four-channel formats. A kernel computes one coarse row
+// from two fine rows and produces exactly the same results as ComputeCoarseMipHelper.
+using BoxFilterRowKernelType = void (*)(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth);
+
+// Computes coarse texels [StartCol, CoarseWidth) with the reference scalar code
+template <typename ChannelType, typename AverageFuncType>
+void BoxFilterRowTail(const ChannelType* pSrcRow0, const ChannelType* pSrcRow1, ChannelType* pDstRow, Uint32 FineWidth, Uint32 StartCol, AverageFuncType ComputeAverage)
+{
+    const auto CoarseWidth = std::max(FineWidth / 2, Uint32{1});
+    for (Uint32 col = StartCol; col < CoarseWidth; ++col)
+    {
+        const auto src_col0 = col * 2;
+        const auto src_col1 = std::min(col * 2 + 1, FineWidth - 1);
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            pDstRow[col * 4 + c] = ComputeAverage(pSrcRow0[src_col0 * 4 + c], pSrcRow0[src_col1 * 4 + c],
+                                                  pSrcRow1[src_col0 * 4 + c], pSrcRow1[src_col1 * 4 + c]);
+        }
+    }
+}
+
+#if DILIGENT_SSE2_SUPPORTED
+
+void BoxFilterRowRGBA8_SSE2(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const auto    CoarseWidth = FineWidth / 2;
+    const __m128i Zero        = _mm_setzero_si128();
+
+    Uint32 col = 0;
+    // Two coarse texels per iteration
+    for (; col + 2 <= CoarseWidth; col += 2)
+    {
+        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + col * 8));
+        const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + col * 8));
+
+        // Texels 0,1 and 2,3 as 16-bit values, both rows added together
+        const __m128i Sum01 = _mm_add_epi16(_mm_unpacklo_epi8(r0, Zero), _mm_unpacklo_epi8(r1, Zero));
+        const __m128i Sum23 = _mm_add_epi16(_mm_unpackhi_epi8(r0, Zero), _mm_unpackhi_epi8(r1, Zero));
+
+        // Texels 0,2 + texels 1,3
+        __m128i Sum = _mm_add_epi16(_mm_unpacklo_epi64(Sum01, Sum23), _mm_unpackhi_epi64(Sum01, Sum23));
+        Sum         = _mm_srli_epi16(Sum, 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + col * 4), _mm_packus_epi16(Sum, Sum));
+    }
+
+    BoxFilterRowTail(pRow0, pRow1, pDst, FineWidth, col, LinearAverage<Uint8>);
+}
+
+#    if DILIGENT_AVX2_SUPPORTED
+DILIGENT_TARGET_AVX2 void BoxFilterRowRGBA8_AVX2(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const auto    CoarseWidth = FineWidth / 2;
+    const __m256i Zero        = _mm256_setzero_si256();
+
+    Uint32 col = 0;
+    // Four coarse texels per iteration. AVX2 unpack instructions work within 128-bit lanes,
+    // so the lanes are processed exactly as in the SSE2 version and then merged.
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRow0 + col * 8));
+        const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRow1 + col * 8));
+
+        const __m256i Sum01 = _mm256_add_epi16(_mm256_unpacklo_epi8(r0, Zero), _mm256_unpacklo_epi8(r1, Zero));
+        const __m256i Sum23 = _mm256_add_epi16(_mm256_unpackhi_epi8(r0, Zero), _mm256_unpackhi_epi8(r1, Zero));
+
+        __m256i Sum = _mm256_add_epi16(_mm256_unpacklo_epi64(Sum01, Sum23), _mm256_unpackhi_epi64(Sum01, Sum23));
+        Sum         = _mm256_srli_epi16(Sum, 2);
+
+        // Each lane now contains its two coarse texels twice; gather qwords 0 and 2
+        const __m256i Packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(Sum, Sum), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), _mm256_castsi256_si128(Packed));
+    }
+
+    // The SSE2 kernel always produces at least one coarse texel, so it must
+    // not be called when the row is already complete.
+    if (col < std::max(CoarseWidth, Uint32{1}))
+        BoxFilterRowRGBA8_SSE2(pRow0 + col * 8, pRow1 + col * 8, pDst + col * 4, FineWidth - col * 2);
+}
+#    endif
+
+void BoxFilterRowRGBA32F_SSE2(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth)
+{
+    const auto* pRow0 = static_cast<const float*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const float*>(pSrcRow1);
+    auto*       pDst  = static_cast<float*>(pDstRow);
+
+    const auto CoarseWidth = FineWidth / 2;
+
+    Uint32 col = 0;
+    for (; col < CoarseWidth; ++col)
+    {
+        // Same summation order as LinearAverage<float>
+        __m128 Sum = _mm_add_ps(_mm_loadu_ps(pRow0 + col * 8), _mm_loadu_ps(pRow0 + col * 8 + 4));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pRow1 + col * 8));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pRow1 + col * 8 + 4));
+        _mm_storeu_ps(pDst + col * 4, _mm_mul_ps(Sum, _mm_set1_ps(0.25f)));
+    }
+
+    BoxFilterRowTail(pRow0, pRow1, pDst, FineWidth, col, LinearAverage<float>);
+}
+
+#elif DILIGENT_NEON_SUPPORTED
+
+void BoxFilterRowRGBA8_NEON(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const auto CoarseWidth = FineWidth / 2;
+
+    Uint32 col = 0;
+    for (; col + 2 <= CoarseWidth; col += 2)
+    {
+        const uint8x16_t r0 = vld1q_u8(pRow0 + col * 8);
+        const uint8x16_t r1 = vld1q_u8(pRow1 + col * 8);
+
+        // Texels 0,1 and 2,3 as 16-bit values, both rows added together
+        const uint16x8_t Sum01 = vaddl_u8(vget_low_u8(r0), vget_low_u8(r1));
+        const uint16x8_t Sum23 = vaddl_u8(vget_high_u8(r0), vget_high_u8(r1));
+
+        const uint16x8_t Sum = vcombine_u16(vadd_u16(vget_low_u16(Sum01), vget_high_u16(Sum01)),
+                                            vadd_u16(vget_low_u16(Sum23), vget_high_u16(Sum23)));
+        vst1_u8(pDst + col * 4, vmovn_u16(vshrq_n_u16(Sum, 2)));
+    }
+
+    BoxFilterRowTail(pRow0, pRow1, pDst, FineWidth, col, LinearAverage<Uint8>);
+}
+
+void BoxFilterRowRGBA32F_NEON(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 FineWidth)
+{
+    const auto* pRow0 = static_cast<const float*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const float*>(pSrcRow1);
+    auto*       pDst  = static_cast<float*>(pDstRow);
+
+    const auto CoarseWidth = FineWidth / 2;
+
+    Uint32 col = 0;
+    for (; col < CoarseWidth; ++col)
+    {
+        float32x4_t Sum = vaddq_f32(vld1q_f32(pRow0 + col * 8), vld1q_f32(pRow0 + col * 8 + 4));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pRow1 + col * 8));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pRow1 + col * 8 + 4));
+        vst1q_f32(pDst + col * 4, vmulq_n_f32(Sum, 0.25f));
+    }
+
+    BoxFilterRowTail(pRow0, pRow1, pDst, FineWidth, col, LinearAverage<float>);
+}
+
+#endif
+
+// Returns the vectorized box filter row kernel for the format, or null if there is none
+BoxFilterRowKernelType GetBoxFilterRowKernel(const TextureFormatAttribs& FmtAttribs)
+{
+    if (FmtAttribs.NumComponents != 4)
+        return nullptr;
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UINT:
+            if (FmtAttribs.ComponentSize != 1)
+                return nullptr;
+#if DILIGENT_SSE2_SUPPORTED
+#    if DILIGENT_AVX2_SUPPORTED
+            if (IsAVX2Supported())
+                return BoxFilterRowRGBA8_AVX2;
+#    endif
+            return BoxFilterRowRGBA8_SSE2;
+#elif DILIGENT_NEON_SUPPORTED
+            return BoxFilterRowRGBA8_NEON;
+#else
+            return nullptr;
+#endif
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize != 4)
+                return nullptr;
+#if DILIGENT_SSE2_SUPPORTED
+            return BoxFilterRowRGBA32F_SSE2;
+#elif DILIGENT_NEON_SUPPORTED
+            return BoxFilterRowRGBA32F_NEON;
+#else
+            return nullptr;
+#endif
+
+        default:
+            return nullptr;
+    }
+}
+
+// Computes rows [StartRow, EndRow) of an 8-bit sRGB coarse mip level.
+// Texels are averaged in linear space with the fast sRGB approximations, and every
+// coarse row is encoded with the batch encoder that truncates the result the same
+// way as the per-texel implementation.
+void ComputeSRGBMipLevelRows(Uint32      FineLevelWidth,
+                             Uint32      FineLevelHeight,
+                             Uint32      NumChannels,
+                             const void* pFineLevelData,
+                             Uint32      FineDataStrideInBytes,
+                             void*       pCoarseLevelData,
+                             Uint32      CoarseDataStrideInBytes,
+                             Uint32      StartRow,
+                             Uint32      EndRow)
+{
+    VERIFY_EXPR(FineLevelWidth > 0 && FineLevelHeight > 0);
+
+    static const auto SRGBToLinearTable = []() {
+        std::array<float, 256> Table{};
+        for (Uint32 i = 0; i < Table.size(); ++i)
+            Table[i] = FastSRGBToLinear(static_cast<float>(i) / 255.f);
+        return Table;
+    }();
+
+    const auto   CoarseLevelWidth = std::max(FineLevelWidth / 2, Uint32{1});
+    const size_t CoarseRowSize    = size_t{CoarseLevelWidth} * NumChannels;
+
+    std::vector<float> LinearCoarseRow(CoarseRowSize);
+    for (Uint32 row = StartRow; row < EndRow; ++row)
+    {
+        const auto* pSrcRow0 = static_cast<const Uint8*>(pFineLevelData) + size_t{row * 2} * FineDataStrideInBytes;
+        const auto* pSrcRow1 = static_cast<const Uint8*>(pFineLevelData) + size_t{std::min(row * 2 + 1, FineLevelHeight - 1)} * FineDataStrideInBytes;
+        for (Uint32 col = 0; col < CoarseLevelWidth; ++col)
+        {
+            const auto src_col0 = col * 2;
+            const auto src_col1 = std::min(col * 2 + 1, FineLevelWidth - 1);
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                LinearCoarseRow[col * NumChannels + c] =
+                    (SRGBToLinearTable[pSrcRow0[src_col0 * NumChannels + c]] + SRGBToLinearTable[pSrcRow0[src_col1 * NumChannels + c]] +
+                     SRGBToLinearTable[pSrcRow1[src_col0 * NumChannels + c]] + SRGBToLinearTable[pSrcRow1[src_col1 * NumChannels + c]]) *
+                    0.25f;
+            }
+        }
+
+        FastLinearFloatToSRGB8(LinearCoarseRow.data(), static_cast<Uint8*>(pCoarseLevelData) + size_t{row} * CoarseDataStrideInBytes, CoarseRowSize);
+    }
+}
+
+// Computes rows [StartRow, EndRow) of the coarse mip level with the 2x2 box filter
+void ComputeMipLevelRows(Uint32         FineLevelWidth,
+                         Uint32         FineLevelHeight,
+                         TEXTURE_FORMAT Fmt,
+                         const void*    pFineLevelData,
+                         Uint32         FineDataStrideInBytes,
+                         void*          pCoarseLevelData,
+                         Uint32         CoarseDataStrideInBytes,
+                         Uint32         StartRow,
+                         Uint32         EndRow)
 {
     const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
 
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB)
+    {
+        VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
+        ComputeSRGBMipLevelRows(FineLevelWidth, FineLevelHeight, FmtAttribs.NumComponents, pFineLevelData, FineDataStrideInBytes,
+                                pCoarseLevelData, CoarseDataStrideInBytes, StartRow, EndRow);
+        return;
+    }
+
+    if (auto RowKernel = GetBoxFilterRowKernel(FmtAttribs))
+    {
+        VERIFY_EXPR(FineLevelWidth > 0 && FineLevelHeight > 0);
+        for (Uint32 row = StartRow; row < EndRow; ++row)
+        {
+            const auto src_row0 = row * 2;
+            const auto src_row1 = std::min(row * 2 + 1, FineLevelHeight - 1);
+            RowKernel(static_cast<const Uint8*>(pFineLevelData) + src_row0 * FineDataStrideInBytes,
+                      static_cast<const Uint8*>(pFineLevelData) + src_row1 * FineDataStrideInBytes,
+                      static_cast<Uint8*>(pCoarseLevelData) + row * CoarseDataStrideInBytes,
+                      FineLevelWidth);
+        }
+        return;
+    }
+
     ComputeCoarseMipHelper ComputeMipHelper //
         {
             FineLevelWidth,
@@ -272,16 +577,13 @@ void ComputeMipLevel(Uint32         FineLevelWidth,
             FineDataStrideInBytes,
             pCoarseLevelData,
             CoarseDataStrideInBytes,
-            FmtAttribs.NumComponents //
+            FmtAttribs.NumComponents,
+            StartRow,
+            EndRow //
         };
 
     switch (FmtAttribs.ComponentType)
     {
-        case COMPONENT_TYPE_UNORM_SRGB:
-            VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            ComputeMipHelper.Run<Uint8>(SRGBAverage<Uint8>);
-            break;
-
         case COMPONENT_TYPE_UNORM:
         case COMPONENT_TYPE_UINT:
             switch (FmtAttribs.ComponentSize)
@@ -325,8 +627,26 @@ void ComputeMipLevel(Uint32         FineLevelWidth,
             break;
 
         case COMPONENT_TYPE_FLOAT:
-            VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipHelper.Run<Float32>(LinearAverage<Float32>);
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 2:
+                    ComputeMipHelper.Run<Uint16>(Float16Average);
+                    break;
+
+                case 4:
+                    ComputeMipHelper.Run<Float32>(LinearAverage<Float32>);
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for FLOAT texture format");
+            }
+            break;
+
+        case COMPONENT_TYPE_COMPOUND:
+            if (Fmt == TEX_FORMAT_R11G11B10_FLOAT)
+                ComputeMipHelper.Run<Uint32>(R11G11B10Average);
+            else
+                UNSUPPORTED("Unsupported compound format ", FmtAttribs.Name);
             break;
 
         default:
@@ -334,6 +654,373 @@ void ComputeMipLevel(Uint32         FineLevelWidth,
     }
 }
 
+void ComputeMipLevel(Uint32         FineLevelWidth,
+                     Uint32         FineLevelHeight,
+                     TEXTURE_FORMAT Fmt,
+                     const void*    pFineLevelData,
+                     Uint32         FineDataStrideInBytes,
+                     void*          pCoarseLevelData,
+                     Uint32         CoarseDataStrideInBytes)
+{
+    ComputeMipLevelRows(FineLevelWidth, FineLevelHeight, Fmt, pFineLevelData, FineDataStrideInBytes,
+                        pCoarseLevelData, CoarseDataStrideInBytes,
+                        0, std::max(FineLevelHeight / 2, Uint32{1}));
+}
+
+
+// Worker threads are created once and shared by all mip chain computations
+ThreadPool& GetMipGenerationThreadPool()
+{
+    static ThreadPool Pool;
+    return Pool;
+}
+
+// Splits [0, NumRows) into ranges and processes them on up to NumThreads threads,
+// including the calling thread.
+template <typename FuncType>
+void ParallelForRows(Uint32 NumThreads, Uint32 NumRows, Uint32 MinRowsPerThread, const FuncType& Func)
+{
+    NumThreads = std::min(NumThreads, std::max(NumRows / std::max(MinRowsPerThread, Uint32{1}), Uint32{1}));
+    if (NumThreads <= 1)
+    {
+        Func(Uint32{0}, NumRows);
+        return;
+    }
+
+    const auto RowsPerThread = (NumRows + NumThreads - 1) / NumThreads;
+    GetMipGenerationThreadPool().ParallelFor(NumThreads,
+                                             [&](Uint32 Task) //
+                                             {
+                                                 const auto StartRow = Task * RowsPerThread;
+                                                 const auto EndRow   = std::min(StartRow + RowsPerThread, NumRows);
+                                                 if (StartRow < EndRow)
+                                                     Func(StartRow, EndRow);
+                                             });
+}
+
+// Target number of texels processed by one thread
+static constexpr Uint32 MinTexelsPerThread = 16384;
+
+
+// Resampling filter weights for one dimension
+struct FilterWeights
+{
+    Uint32 NumTaps = 0;
+
+    // First source texel of every destination texel. May be out of range; source
+    // coordinates are clamped when the filter is applied.
+    std::vector<int> FirstTap;
+
+    // NumTaps weights for every destination texel
+    std::vector<float> Weights;
+
+    FilterWeights(MIP_FILTER_TYPE Filter, Uint32 SrcSize, Uint32 DstSize)
+    {
+        static constexpr double FilterRadius = 3;
+        static constexpr double KaiserAlpha  = 4;
+        static constexpr double Pi           = 3.14159265358979323846;
+
+        auto Sinc = [](double x) {
+            return std::abs(x) < 1e-6 ? 1.0 : std::sin(Pi * x) / (Pi * x);
+        };
+        // Zero-order modified Bessel function of the first kind
+        auto BesselI0 = [](double x) {
+            double Sum  = 1;
+            double Term = 1;
+            for (int k = 1; k < 32; ++k)
+            {
+                Term *= (x / (2 * k)) * (x / (2 * k));
+                Sum += Term;
+            }
+            return Sum;
+        };
+        auto Kernel = [&](double x) {
+            if (std::abs(x) >= FilterRadius)
+                return 0.0;
+            if (Filter == MIP_FILTER_TYPE_LANCZOS)
+                return Sinc(x) * Sinc(x / FilterRadius);
+
+            const double r = x / FilterRadius;
+            return Sinc(x) * BesselI0(KaiserAlpha * std::sqrt(1 - r * r)) / BesselI0(KaiserAlpha);
+        };
+
+        const double Scale  = static_cast<double>(SrcSize) / static_cast<double>(DstSize);
+        const double Radius = FilterRadius * Scale;
+
+        NumTaps = static_cast<Uint32>(std::ceil(2 * Radius)) + 1;
+        FirstTap.resize(DstSize);
+        Weights.resize(size_t{DstSize} * NumTaps);
+        for (Uint32 i = 0; i < DstSize; ++i)
+        {
+            const double Center = (i + 0.5) * Scale;
+            FirstTap[i]         = static_cast<int>(std::floor(Center - Radius));
+
+            auto*  pWeights = &Weights[size_t{i} * NumTaps];
+            double Sum      = 0;
+            for (Uint32 t = 0; t < NumTaps; ++t)
+            {
+                const double w = Kernel((FirstTap[i] + static_cast<int>(t) + 0.5 - Center) / Scale);
+                pWeights[t]    = static_cast<float>(w);
+                Sum += w;
+            }
+            VERIFY_EXPR(Sum > 0);
+            for (Uint32 t = 0; t < NumTaps; ++t)
+                pWeights[t] = static_cast<float>(pWeights[t] / Sum);
+        }
+    }
+};
+
+// Number of floats per texel used by the filtered mip chain
+Uint32 GetNumFilteredChannels(TEXTURE_FORMAT Fmt, const TextureFormatAttribs& FmtAttribs)
+{
+    if (Fmt == TEX_FORMAT_R11G11B10_FLOAT)
+        return 3;
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            return (FmtAttribs.ComponentSize == 1 || FmtAttribs.ComponentSize == 2) ? FmtAttribs.NumComponents : 0;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            return FmtAttribs.ComponentSize == 1 ? FmtAttribs.NumComponents : 0;
+
+        case COMPONENT_TYPE_FLOAT:
+            return (FmtAttribs.ComponentSize == 2 || FmtAttribs.ComponentSize == 4) ? FmtAttribs.NumComponents : 0;
+
+        default:
+            return 0;
+    }
+}
+
+template <typename T>
+T QuantizeUNorm(float Val)
+{
+    constexpr float MaxVal = static_cast<float>(std::numeric_limits<T>::max());
+
+    Val = std::min(std::max(Val, 0.f), 1.f);
+    return static_cast<T>(Val * MaxVal + 0.5f);
+}
+
+void DecodeRow(TEXTURE_FORMAT Fmt, const TextureFormatAttribs& FmtAttribs, const void* pSrc, Uint32 NumValues, float* pDst)
+{
+    if (Fmt == TEX_FORMAT_R11G11B10_FLOAT)
+    {
+        const auto* pPacked = static_cast<const Uint32*>(pSrc);
+        for (Uint32 i = 0; i < NumValues / 3; ++i)
+            UnpackR11G11B10Float(pPacked[i], pDst[i * 3 + 0], pDst[i * 3 + 1], pDst[i * 3 + 2]);
+        return;
+    }
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (FmtAttribs.ComponentSize == 1)
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    pDst[i] = static_cast<float>(static_cast<const Uint8*>(pSrc)[i]) * (1.f / 255.f);
+            }
+            else
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    pDst[i] = static_cast<float>(static_cast<const Uint16*>(pSrc)[i]) * (1.f / 65535.f);
+            }
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            SRGB8ToLinearFloat(static_cast<const Uint8*>(pSrc), pDst, NumValues);
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize == 2)
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    pDst[i] = Float16ToFloat32(static_cast<const Uint16*>(pSrc)[i]);
+            }
+            else
+            {
+                memcpy(pDst, pSrc, NumValues * sizeof(float));
+            }
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+}
+
+void EncodeRow(TEXTURE_FORMAT Fmt, const TextureFormatAttribs& FmtAttribs, const float* pSrc, Uint32 NumValues, void* pDst)
+{
+    if (Fmt == TEX_FORMAT_R11G11B10_FLOAT)
+    {
+        auto* pPacked = static_cast<Uint32*>(pDst);
+        for (Uint32 i = 0; i < NumValues / 3; ++i)
+            pPacked[i] = PackR11G11B10Float(pSrc[i * 3 + 0], pSrc[i * 3 + 1], pSrc[i * 3 + 2]);
+        return;
+    }
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+            if (FmtAttribs.ComponentSize == 1)
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    static_cast<Uint8*>(pDst)[i] = QuantizeUNorm<Uint8>(pSrc[i]);
+            }
+            else
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    static_cast<Uint16*>(pDst)[i] = QuantizeUNorm<Uint16>(pSrc[i]);
+            }
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            LinearFloatToSRGB8(pSrc, static_cast<Uint8*>(pDst), NumValues);
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.ComponentSize == 2)
+            {
+                for (Uint32 i = 0; i < NumValues; ++i)
+                    static_cast<Uint16*>(pDst)[i] = Float32ToFloat16(pSrc[i]);
+            }
+            else
+            {
+                memcpy(pDst, pSrc, NumValues * sizeof(float));
+            }
+            break;
+
+        default:
+            UNEXPECTED("Unexpected component type");
+    }
+}
+
+void ComputeFilteredMipChain(const ComputeMipChainAttribs& Attribs, Uint32 NumChannels)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+    const auto  NumThreads = std::max(Attribs.NumThreads, Uint32{1});
+
+    // Every level is computed from the unquantized previous level
+    Uint32             FineWidth  = Attribs.Width;
+    Uint32             FineHeight = Attribs.Height;
+    std::vector<float> FineLevel(size_t{FineWidth} * FineHeight * NumChannels);
+    ParallelForRows(NumThreads, FineHeight, MinTexelsPerThread / FineWidth,
+                    [&](Uint32 StartRow, Uint32 EndRow) //
+                    {
+                        for (Uint32 row = StartRow; row < EndRow; ++row)
+                        {
+                            DecodeRow(Attribs.Format, FmtAttribs, static_cast<const Uint8*>(Attribs.pData) + size_t{row} * Attribs.Stride,
+                                      FineWidth * NumChannels, &FineLevel[size_t{row} * FineWidth * NumChannels]);
+                        }
+                    });
+
+    std::vector<float> HorzFiltered;
+    std::vector<float> CoarseLevel;
+    for (Uint32 mip = 0; mip < Attribs.NumMipLevels; ++mip)
+    {
+        const auto CoarseWidth  = std::max(FineWidth / 2, Uint32{1});
+        const auto CoarseHeight = std::max(FineHeight / 2, Uint32{1});
+
+        const FilterWeights HorzWeights{Attribs.Filter, FineWidth, CoarseWidth};
+        const FilterWeights VertWeights{Attribs.Filter, FineHeight, CoarseHeight};
+
+        // Horizontal pass: FineWidth x FineHeight -> CoarseWidth x FineHeight
+        HorzFiltered.resize(size_t{CoarseWidth} * FineHeight * NumChannels);
+        ParallelForRows(NumThreads, FineHeight, MinTexelsPerThread / CoarseWidth,
+                        [&](Uint32 StartRow, Uint32 EndRow) //
+                        {
+                            for (Uint32 row = StartRow; row < EndRow; ++row)
+                            {
+                                const auto* pSrcRow = &FineLevel[size_t{row} * FineWidth * NumChannels];
+                                auto*       pDstRow = &HorzFiltered[size_t{row} * CoarseWidth * NumChannels];
+                                for (Uint32 col = 0; col < CoarseWidth; ++col)
+                                {
+                                    const auto* pWeights = &HorzWeights.Weights[size_t{col} * HorzWeights.NumTaps];
+                                    auto*       pDst     = pDstRow + col * NumChannels;
+                                    for (Uint32 c = 0; c < NumChannels; ++c)
+                                        pDst[c] = 0;
+                                    for (Uint32 t = 0; t < HorzWeights.NumTaps; ++t)
+                                    {
+                                        const auto  src_col = std::min(std::max(HorzWeights.FirstTap[col] + static_cast<int>(t), 0), static_cast<int>(FineWidth) - 1);
+                                        const auto* pSrc    = pSrcRow + src_col * NumChannels;
+                                        for (Uint32 c = 0; c < NumChannels; ++c)
+                                            pDst[c] += pWeights[t] * pSrc[c];
+                                    }
+                                }
+                            }
+                        });
+
+        // Vertical pass: CoarseWidth x FineHeight -> CoarseWidth x CoarseHeight
+        CoarseLevel.resize(size_t{CoarseWidth} * CoarseHeight * NumChannels);
+        ParallelForRows(NumThreads, CoarseHeight, MinTexelsPerThread / CoarseWidth,
+                        [&](Uint32 StartRow, Uint32 EndRow) //
+                        {
+                            const auto RowSize = CoarseWidth * NumChannels;
+                            for (Uint32 row = StartRow; row < EndRow; ++row)
+                            {
+                                const auto* pWeights = &VertWeights.Weights[size_t{row} * VertWeights.NumTaps];
+                                auto*       pDstRow  = &CoarseLevel[size_t{row} * RowSize];
+                                std::fill(pDstRow, pDstRow + RowSize, 0.f);
+                                for (Uint32 t = 0; t < VertWeights.NumTaps; ++t)
+                                {
+                                    const auto  src_row = std::min(std::max(VertWeights.FirstTap[row] + static_cast<int>(t), 0), static_cast<int>(FineHeight) - 1);
+                                    const auto* pSrcRow = &HorzFiltered[static_cast<size_t>(src_row) * RowSize];
+                                    const auto  w       = pWeights[t];
+                                    for (Uint32 i = 0; i < RowSize; ++i)
+                                        pDstRow[i] += w * pSrcRow[i];
+                                }
+
+                                EncodeRow(Attribs.Format, FmtAttribs, pDstRow, RowSize,
+                                          static_cast<Uint8*>(Attribs.ppMipData[mip]) + size_t{row} * Attribs.pMipStrides[mip]);
+                            }
+                        });
+
+        std::swap(FineLevel, CoarseLevel);
+        FineWidth  = CoarseWidth;
+        FineHeight = CoarseHeight;
+    }
+}
+
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Width > 0 && Attribs.Height > 0, "Top mip level size must not be zero");
+    DEV_CHECK_ERR(Attribs.pData != nullptr, "Top mip level data must not be null");
+    DEV_CHECK_ERR(Attribs.NumMipLevels == 0 || (Attribs.ppMipData != nullptr && Attribs.pMipStrides != nullptr),
+                  "ppMipData and pMipStrides must not be null when NumMipLevels is not zero");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+    if (Attribs.Filter != MIP_FILTER_TYPE_BOX)
+    {
+        if (const auto NumChannels = GetNumFilteredChannels(Attribs.Format, FmtAttribs))
+        {
+            ComputeFilteredMipChain(Attribs, NumChannels);
+            return;
+        }
+        LOG_WARNING_MESSAGE("Filtered mip generation is not supported for ", FmtAttribs.Name, " format. Falling back to box filter.");
+    }
+
+    const void* pFineData   = Attribs.pData;
+    Uint32      FineStride  = Attribs.Stride;
+    Uint32      FineWidth   = Attribs.Width;
+    Uint32      FineHeight  = Attribs.Height;
+    const auto  NumThreads  = std::max(Attribs.NumThreads, Uint32{1});
+    for (Uint32 mip = 0; mip < Attribs.NumMipLevels; ++mip)
+    {
+        const auto CoarseWidth  = std::max(FineWidth / 2, Uint32{1});
+        const auto CoarseHeight = std::max(FineHeight / 2, Uint32{1});
+
+        ParallelForRows(NumThreads, CoarseHeight, MinTexelsPerThread / CoarseWidth,
+                        [&](Uint32 StartRow, Uint32 EndRow) //
+                        {
+                            ComputeMipLevelRows(FineWidth, FineHeight, Attribs.Format, pFineData, FineStride,
+                                                Attribs.ppMipData[mip], Attribs.pMipStrides[mip], StartRow, EndRow);
+                        });
+
+        pFineData  = Attribs.ppMipData[mip];
+        FineStride = Attribs.pMipStrides[mip];
+        FineWidth  = CoarseWidth;
+        FineHeight = CoarseHeight;
+    }
+}
+
 } // namespace Diligent
 
 
@@ -373,4 +1060,9 @@ extern "C"
         ComputeMipLevel(FineLevelWidth, FineLevelHeight, Fmt, pFineLevelData,
                         FineDataStrideInBytes, pCoarseLevelData, CoarseDataStrideInBytes);
     }
+
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs* pAttribs)
+    {
+        Diligent::ComputeMipChain(*pAttribs);
+    }
 }
@@ -359,7 +359,7 @@
 
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "GraphicsAccessories.hpp"
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "StringDataBlobImpl.hpp"
 #include "StringTools.hpp"
 #include "EngineMemory.h"
@@ -1061,8 +1061,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
             if (!pIncludeDataStream)
                 LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
-            RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
-            pIncludeDataStream->ReadBlob(pIncludeData);
+            auto pIncludeData = ReadStreamData(pIncludeDataStream);
 
             // Get include text
             auto   IncludeText = reinterpret_cast<const Char*>(pIncludeData->GetDataPtr());
@@ -4809,8 +4808,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         if (pSourceStream == nullptr)
             LOG_ERROR_AND_THROW("Failed to open shader source file ", InputFileName);
 
-        pFileData = MakeNewRCObj<DataBlobImpl>()(0);
-        pSourceStream->ReadBlob(pFileData);
+        pFileData  = ReadStreamData(pSourceStream);
         HLSLSource = reinterpret_cast<char*>(pFileData->GetDataPtr());
         NumSymbols = pFileData->GetSize();
     }
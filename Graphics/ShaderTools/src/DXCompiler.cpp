@@ -40,7 +40,7 @@
 #    error DXC is not supported on this platform
 #endif
 
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 
@@ -236,8 +236,7 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData{MakeNewRCObj<DataBlobImpl>()(0)};
-        pSourceStream->ReadBlob(pFileData);
+        auto pFileData = ReadStreamData(pSourceStream);
 
         CComPtr<IDxcBlobEncoding> sourceBlob;
 
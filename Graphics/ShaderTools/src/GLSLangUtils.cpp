@@ -40,6 +40,7 @@
 #include "GLSLangUtils.hpp"
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 
@@ -411,8 +412,7 @@ public:
             return nullptr;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
-        pSourceStream->ReadBlob(pFileData);
+        auto  pFileData = ReadStreamData(pSourceStream);
         auto* pNewInclude =
             new IncludeResult{
                 headerName,
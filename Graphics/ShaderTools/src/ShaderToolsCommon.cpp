@@ -27,7 +27,7 @@
 
 #include "ShaderToolsCommon.hpp"
 #include "DebugUtilities.hpp"
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 
 namespace Diligent
 {
@@ -123,8 +123,8 @@ const char* ReadShaderSourceFile(const char*                      SourceCode,
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                pFileData = MakeNewRCObj<DataBlobImpl>{}(0);
-                pSourceStream->ReadBlob(pFileData);
+                // Mapped file streams created by the default stream factory return the file data without copying
+                pFileData     = ReadStreamData(pSourceStream);
                 SourceCode    = reinterpret_cast<char*>(pFileData->GetDataPtr());
                 SourceCodeLen = pFileData->GetSize();
             }
@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main(uint VertexId : SV_VertexID) : SV_Position
+{
+    float4 Pos[3];
+    Pos[0] = float4(-1.0, -1.0, 0.0, 1.0);
+    Pos[1] = float4(-1.0, +3.0, 0.0, 1.0);
+    Pos[2] = float4(+3.0, -1.0, 0.0, 1.0);
+    return Pos[VertexId];
+}
+)";
+
+static const char* PSSource = R"(
+cbuffer Constants
+{
+    float4 g_Color;
+};
+
+float4 main() : SV_Target
+{
+    return g_Color;
+}
+)";
+
+static const char* CSSource = R"(
+RWTexture2D<float/* format=r32f */> g_RWTex;
+
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex[int2(0,0)] = 0.0;
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(SHADER_TYPE ShaderType, const char* Source)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = ShaderType;
+    ShaderCI.Desc.Name                  = "Async pipeline test shader";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+RefCntAutoPtr<IPipelineState> CreateGraphicsPSO(IShader* pVS, IShader* pPS, PSO_CREATE_FLAGS Flags)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "Async pipeline test - graphics PSO";
+
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = pEnv->GetSwapChain()->GetDesc().ColorBufferFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pVS   = pVS;
+    PSOCreateInfo.pPS   = pPS;
+    PSOCreateInfo.Flags = Flags;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+TEST(AsyncPipelineTest, GraphicsPipeline)
+{
+    auto* const pEnv       = TestingEnvironment::GetInstance();
+    auto* const pDevice    = pEnv->GetDevice();
+    auto* const pContext   = pEnv->GetDeviceContext();
+    auto* const pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, PSSource);
+    ASSERT_TRUE(pVS && pPS);
+
+    auto pPSO = CreateGraphicsPSO(pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS);
+    ASSERT_TRUE(pPSO);
+
+    // Shader references must be kept by the pipeline while it is being compiled
+    pVS.Release();
+    pPS.Release();
+
+    const auto Status = pPSO->GetStatus();
+    EXPECT_TRUE(Status == PIPELINE_STATE_STATUS_COMPILING || Status == PIPELINE_STATE_STATUS_READY);
+
+    // Resource bindings can be created and initialized while the pipeline is compiling
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_TRUE(pSRB);
+
+    const float Color[] = {0, 1, 0, 1};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Async pipeline test - constants";
+    BuffDesc.uiSizeInBytes = sizeof(Color);
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+    BufferData InitData{Color, sizeof(Color)};
+
+    RefCntAutoPtr<IBuffer> pConstants;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pConstants);
+    ASSERT_TRUE(pConstants);
+
+    auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "Constants");
+    ASSERT_NE(pVar, nullptr);
+    pVar->Set(pConstants);
+
+    EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+    // Once the compilation is finished, the status must not change
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(AsyncPipelineTest, ComputePipeline)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pCS = CreateTestShader(SHADER_TYPE_COMPUTE, CSSource);
+    ASSERT_TRUE(pCS);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Async pipeline test - compute PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+    PSOCreateInfo.Flags                = PSO_CREATE_FLAG_ASYNCHRONOUS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_TRUE(pPSO);
+
+    EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+}
+
+TEST(AsyncPipelineTest, SynchronousPipelineIsReady)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, PSSource);
+    ASSERT_TRUE(pVS && pPS);
+
+    auto pPSO = CreateGraphicsPSO(pVS, pPS, PSO_CREATE_FLAG_NONE);
+    ASSERT_TRUE(pPSO);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+}
+
+TEST(AsyncPipelineTest, ReleaseWhileCompiling)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, VSSource);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, PSSource);
+    ASSERT_TRUE(pVS && pPS);
+
+    // Pipelines released before or during the compilation must neither block
+    // the releasing thread nor be accessed by the worker threads afterwards.
+    for (Uint32 i = 0; i < 32; ++i)
+    {
+        auto pPSO = CreateGraphicsPSO(pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS);
+        ASSERT_TRUE(pPSO);
+    }
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        PSOs.emplace_back(CreateGraphicsPSO(pVS, pPS, PSO_CREATE_FLAG_ASYNCHRONOUS));
+        ASSERT_TRUE(PSOs.back());
+    }
+    for (auto& pPSO : PSOs)
+        EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+}
+
+} // namespace
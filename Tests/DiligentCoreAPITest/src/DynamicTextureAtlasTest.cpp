@@ -188,4 +188,105 @@ TEST(DynamicTextureAtlas, Allocate)
     }
 }
 
+TEST(DynamicTextureAtlas, Defragment)
+{
+    auto* const pEnv     = TestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.TextureGranularity = 16;
+    CI.Desc.Format        = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name          = "Dynamic Texture Atlas Defragment Test";
+    CI.Desc.Type          = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags     = BIND_SHADER_RESOURCE;
+    CI.Desc.Width         = 256;
+    CI.Desc.Height        = 256;
+    CI.Desc.MipLevels     = 4;
+    CI.Desc.ArraySize     = 1;
+    CI.MaxSliceCount      = 1;
+
+    for (auto Packing : {DYNAMIC_TEXTURE_ATLAS_PACKING_GUILLOTINE, DYNAMIC_TEXTURE_ATLAS_PACKING_MAX_RECTS})
+    {
+        CI.Packing           = Packing;
+        CI.MaxRectsHeuristic = DYNAMIC_TEXTURE_ATLAS_MAX_RECTS_HEURISTIC_BOTTOM_LEFT;
+
+        RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+        CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+        ASSERT_TRUE(pAtlas);
+
+        std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Suballocs(256);
+        for (auto& Suballoc : Suballocs)
+        {
+            pAtlas->Allocate(16, 16, &Suballoc);
+            ASSERT_TRUE(Suballoc);
+        }
+
+        // Release every other suballocation
+        for (size_t i = 0; i < Suballocs.size(); i += 2)
+            Suballocs[i].Release();
+
+        const auto Version = pAtlas->GetVersion();
+        EXPECT_GT(pAtlas->Defragment(pDevice, pContext), 0u);
+        EXPECT_GT(pAtlas->GetVersion(), Version);
+        EXPECT_NE(pAtlas->GetTexture(pDevice, pContext), nullptr);
+
+        for (size_t i = 1; i < Suballocs.size(); i += 2)
+        {
+            const auto Origin = Suballocs[i]->GetOrigin();
+            EXPECT_LE(Origin.x + 16, CI.Desc.Width);
+            EXPECT_LE(Origin.y + 16, CI.Desc.Height);
+        }
+
+        RefCntAutoPtr<ITextureAtlasSuballocation> pLarge;
+        pAtlas->Allocate(128, 128, &pLarge);
+        EXPECT_TRUE(pLarge);
+    }
+}
+
+// Atlases whose coarsest mip level is smaller than one granularity cell must not be defragmented
+TEST(DynamicTextureAtlas, DefragmentFineGranularity)
+{
+    auto* const pEnv     = TestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.TextureGranularity = 4;
+    CI.Desc.Format        = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name          = "Dynamic Texture Atlas Defragment Fine Granularity Test";
+    CI.Desc.Type          = RESOURCE_DIM_TEX_2D;
+    CI.Desc.BindFlags     = BIND_SHADER_RESOURCE;
+    CI.Desc.Width         = 64;
+    CI.Desc.Height        = 64;
+    CI.Desc.MipLevels     = 4;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> Suballocs(16);
+    for (auto& Suballoc : Suballocs)
+    {
+        pAtlas->Allocate(16, 16, &Suballoc);
+        ASSERT_TRUE(Suballoc);
+    }
+    for (size_t i = 0; i < Suballocs.size(); i += 2)
+        Suballocs[i].Release();
+
+    std::vector<uint2> Origins;
+    for (size_t i = 1; i < Suballocs.size(); i += 2)
+        Origins.push_back(Suballocs[i]->GetOrigin());
+
+    const auto Version = pAtlas->GetVersion();
+    EXPECT_EQ(pAtlas->Defragment(pDevice, pContext), 0u);
+    EXPECT_EQ(pAtlas->GetVersion(), Version);
+    for (size_t i = 1; i < Suballocs.size(); i += 2)
+        EXPECT_EQ(Suballocs[i]->GetOrigin(), Origins[i / 2]);
+}
+
 } // namespace
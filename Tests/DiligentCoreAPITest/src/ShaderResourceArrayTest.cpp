@@ -221,6 +221,12 @@ TEST(ShaderResourceLayout, ResourceArray)
     RefCntAutoPtr<IResourceMapping> pResMapping;
     pDevice->CreateResourceMapping(ResMappingDesc, &pResMapping);
 
+    {
+        RefCntAutoPtr<IDeviceObject> pMappedSRV;
+        pResMapping->GetResourceByInternedName(pDevice->InternString("g_tex2DTest"), &pMappedSRV, 1);
+        EXPECT_EQ(pMappedSRV.RawPtr(), static_cast<IDeviceObject*>(pTextures[1]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)));
+    }
+
     //pVS->BindResources(m_pResourceMapping, 0);
     IDeviceObject* ppSRVs[] = {pTextures[3]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)};
     pPSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
@@ -504,6 +504,8 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pTestPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            auto pVar3 = pTestPSO->GetStaticVariableByInternedName(SHADER_TYPE_VERTEX, pDevice->InternString(ResDesc.Name));
+            EXPECT_EQ(pVar, pVar3);
         }
     }
 
@@ -690,6 +692,7 @@ TEST(ShaderResourceLayout, VariableAccess)
             tex2D_Mut->GetResourceDesc(ResDesc);
             EXPECT_EQ(ResDesc.ArraySize, 1u);
             EXPECT_EQ(tex2D_Mut, pSRB->GetVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name));
+            EXPECT_EQ(tex2D_Mut, pSRB->GetVariableByInternedName(SHADER_TYPE_VERTEX, pDevice->InternString(ResDesc.Name)));
             tex2D_Mut->Set(pSRVs[0]);
             EXPECT_TRUE(tex2D_Mut->IsBound(0));
         }
@@ -723,6 +726,7 @@ TEST(ShaderResourceLayout, VariableAccess)
             tex2D_Dyn->GetResourceDesc(ResDesc);
             EXPECT_EQ(ResDesc.ArraySize, 1u);
             EXPECT_EQ(tex2D_Dyn, pSRB->GetVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name));
+            EXPECT_EQ(tex2D_Dyn, pSRB->GetVariableByInternedName(SHADER_TYPE_VERTEX, pDevice->InternString(ResDesc.Name)));
             //tex2D_Dyn->Set(pSRVs[0]);
             EXPECT_EQ(TestShaderResourceVariableCInterface(tex2D_Dyn, pSRVs[0]), 0);
         }
@@ -0,0 +1,385 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#define VK_NO_PROTOTYPES
+#include "vulkan/vulkan.h"
+
+#include "DeviceContextVk.h"
+#include "BufferVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+// These tests only use the public API and run on any Vulkan implementation,
+// including software rasterizers such as lavapipe.
+
+namespace
+{
+
+static constexpr Uint32 NumTestBuffers   = 32;
+static constexpr Uint32 TestBufferSize   = 1 << 20;
+static constexpr Uint32 SurvivorInterval = 8;
+
+static const char* CSSource = R"(
+StructuredBuffer<uint4>   g_MutableData;
+StructuredBuffer<uint4>   g_DynamicData;
+RWStructuredBuffer<uint4> g_Output;
+
+[numthreads(1,1,1)]
+void main()
+{
+    g_Output[0] = g_MutableData[0];
+    g_Output[1] = g_DynamicData[0];
+}
+)";
+
+bool IsVulkanDevice()
+{
+    return TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType == RENDER_DEVICE_TYPE_VULKAN;
+}
+
+VkBuffer GetVkBuffer(IBuffer* pBuffer)
+{
+    return RefCntAutoPtr<IBufferVk>{pBuffer, IID_BufferVk}->GetVkBuffer();
+}
+
+// Creates a number of defragmentable buffers and releases most of them to leave sparse memory pages.
+// Every buffer is filled with its index plus one.
+std::vector<RefCntAutoPtr<IBuffer>> CreateSparseBuffers()
+{
+    auto* const pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Defragmentation test buffer";
+    BuffDesc.uiSizeInBytes     = TestBufferSize;
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride = sizeof(Uint32) * 4;
+    BuffDesc.MiscFlags         = MISC_BUFFER_FLAG_DEFRAGMENTABLE;
+
+    std::vector<Uint32> Data(TestBufferSize / sizeof(Uint32));
+
+    std::vector<RefCntAutoPtr<IBuffer>> Survivors;
+    std::vector<RefCntAutoPtr<IBuffer>> Buffers(NumTestBuffers);
+    for (Uint32 i = 0; i < NumTestBuffers; ++i)
+    {
+        std::fill(Data.begin(), Data.end(), i + 1);
+        BufferData InitData{Data.data(), TestBufferSize};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &Buffers[i]);
+        if (!Buffers[i])
+            return {};
+        if (i % SurvivorInterval == 0)
+            Survivors.push_back(Buffers[i]);
+    }
+
+    return Survivors;
+}
+
+std::vector<Uint32> ReadBufferData(IBuffer* pBuffer)
+{
+    auto* const pEnv     = TestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Defragmentation test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = pBuffer->GetDesc().uiSizeInBytes;
+    BuffDesc.BindFlags      = BIND_NONE;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    if (!pStagingBuffer)
+        return {};
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    std::vector<Uint32> Data(BuffDesc.uiSizeInBytes / sizeof(Uint32));
+
+    void* pBufferData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pBufferData);
+    if (pBufferData != nullptr)
+        memcpy(Data.data(), pBufferData, BuffDesc.uiSizeInBytes);
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    return Data;
+}
+
+void VerifyBufferData(IBuffer* pBuffer, Uint32 RefValue)
+{
+    const auto Data = ReadBufferData(pBuffer);
+    ASSERT_EQ(Data.size(), TestBufferSize / sizeof(Uint32));
+    for (size_t i = 0; i < Data.size(); ++i)
+    {
+        if (Data[i] != RefValue)
+        {
+            ADD_FAILURE() << "Buffer data at offset " << i * sizeof(Uint32) << " is " << Data[i] << " while " << RefValue << " is expected";
+            break;
+        }
+    }
+}
+
+DefragmentMemoryStatsVk DefragmentMemory()
+{
+    RefCntAutoPtr<IDeviceContextVk> pContextVk{TestingEnvironment::GetInstance()->GetDeviceContext(), IID_DeviceContextVk};
+
+    DefragmentMemoryAttribsVk Attribs;
+    Attribs.MaxBytesToMove      = Uint64{NumTestBuffers} * TestBufferSize;
+    Attribs.SparsePageThreshold = 0.5f;
+
+    DefragmentMemoryStatsVk Stats;
+    pContextVk->DefragmentMemory(Attribs, &Stats);
+
+    EXPECT_LE(Stats.BytesMoved, Attribs.MaxBytesToMove);
+    EXPECT_LE(Stats.StatsAfter.UsedSize, Stats.StatsBefore.UsedSize);
+    EXPECT_LE(Stats.NumPagesEvacuated, Stats.StatsBefore.NumSparsePages);
+
+    return Stats;
+}
+
+TEST(DefragmentMemoryVkTest, RelocateUnboundBuffers)
+{
+    if (!IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Memory defragmentation is only supported in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto Buffers = CreateSparseBuffers();
+    ASSERT_FALSE(Buffers.empty());
+
+    std::vector<VkBuffer> OldHandles;
+    for (auto& pBuffer : Buffers)
+        OldHandles.push_back(GetVkBuffer(pBuffer));
+
+    const auto Stats = DefragmentMemory();
+
+    Uint32 NumRelocated = 0;
+    for (size_t i = 0; i < Buffers.size(); ++i)
+    {
+        if (GetVkBuffer(Buffers[i]) != OldHandles[i])
+            ++NumRelocated;
+    }
+    EXPECT_EQ(NumRelocated, Stats.NumBuffersMoved);
+    EXPECT_GE(Stats.BytesMoved, Uint64{NumRelocated} * TestBufferSize);
+
+    // The contents must be preserved whether or not the buffers have been moved
+    for (size_t i = 0; i < Buffers.size(); ++i)
+        VerifyBufferData(Buffers[i], static_cast<Uint32>(i * SurvivorInterval + 1));
+}
+
+TEST(DefragmentMemoryVkTest, BoundBuffers)
+{
+    auto* const pEnv     = TestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+    if (!IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Memory defragmentation is only supported in Vulkan";
+    }
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "Defragmentation test CS";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = CSSource;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    const ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "g_DynamicData", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //
+        };
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Defragmentation test PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables           = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    BufferDesc OutputDesc;
+    OutputDesc.Name              = "Defragmentation test output buffer";
+    OutputDesc.uiSizeInBytes     = sizeof(Uint32) * 4 * 2;
+    OutputDesc.Usage             = USAGE_DEFAULT;
+    OutputDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    OutputDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    OutputDesc.ElementByteStride = sizeof(Uint32) * 4;
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    pDevice->CreateBuffer(OutputDesc, nullptr, &pOutput);
+    ASSERT_NE(pOutput, nullptr);
+
+    auto Buffers = CreateSparseBuffers();
+    ASSERT_GE(Buffers.size(), 2u);
+
+    IBuffer* const pMutableBuffer = Buffers[0];
+    IBuffer* const pDynamicBuffer = Buffers[1];
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MutableData")->Set(pMutableBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DynamicData")->Set(pDynamicBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    auto Dispatch = [&]() {
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+    Dispatch();
+
+    const auto vkMutableBuffer = GetVkBuffer(pMutableBuffer);
+
+    DefragmentMemory();
+
+    // The mutable descriptor set keeps the buffer handle, so the buffer must not be moved
+    EXPECT_EQ(GetVkBuffer(pMutableBuffer), vkMutableBuffer);
+
+    // Dynamic descriptors are written when resources are committed, so the buffer
+    // bound through the dynamic variable must be read from its new location
+    Dispatch();
+
+    const auto Output = ReadBufferData(pOutput);
+    ASSERT_EQ(Output.size(), size_t{8});
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(Output[i], 1u) << "Mutable buffer data is incorrect";
+        EXPECT_EQ(Output[4 + i], SurvivorInterval + 1) << "Dynamic buffer data is incorrect";
+    }
+}
+
+
+TEST(DefragmentMemoryVkTest, PendingDeferredCommandList)
+{
+    auto* const pEnv     = TestingEnvironment::GetInstance();
+    auto* const pDevice  = pEnv->GetDevice();
+    auto* const pContext = pEnv->GetDeviceContext();
+    if (!IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Memory defragmentation is only supported in Vulkan";
+    }
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto Buffers = CreateSparseBuffers();
+    ASSERT_FALSE(Buffers.empty());
+
+    BufferDesc DstDesc;
+    DstDesc.Name              = "Defragmentation test destination buffer";
+    DstDesc.uiSizeInBytes     = TestBufferSize;
+    DstDesc.Usage             = USAGE_DEFAULT;
+    DstDesc.BindFlags         = BIND_SHADER_RESOURCE;
+    DstDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    DstDesc.ElementByteStride = sizeof(Uint32) * 4;
+
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    pDevice->CreateBuffer(DstDesc, nullptr, &pDstBuffer);
+    ASSERT_NE(pDstBuffer, nullptr);
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {Buffers[0], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, true},
+            {pDstBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, true} //
+        };
+    pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    // The command list keeps the handle of the source buffer
+    auto* pDeferredCtx = pEnv->GetDeviceContext(1);
+    pDeferredCtx->CopyBuffer(Buffers[0], 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                             pDstBuffer, 0, TestBufferSize, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    RefCntAutoPtr<ICommandList> pCmdList;
+    pDeferredCtx->FinishCommandList(&pCmdList);
+    ASSERT_NE(pCmdList, nullptr);
+
+    std::vector<VkBuffer> OldHandles;
+    for (auto& pBuffer : Buffers)
+        OldHandles.push_back(GetVkBuffer(pBuffer));
+
+    // No resources must be moved while the command list has not been executed
+    auto Stats = DefragmentMemory();
+    EXPECT_EQ(Stats.NumBuffersMoved, 0u);
+    for (size_t i = 0; i < Buffers.size(); ++i)
+        EXPECT_EQ(GetVkBuffer(Buffers[i]), OldHandles[i]);
+
+    ICommandList* pCmdLists[] = {pCmdList};
+    pContext->ExecuteCommandLists(1, pCmdLists);
+    pCmdList.Release();
+    pDeferredCtx->FinishFrame();
+
+    VerifyBufferData(pDstBuffer, 1);
+
+    // Once the command list is executed, the buffers can be moved again
+    Stats = DefragmentMemory();
+
+    Uint32 NumRelocated = 0;
+    for (size_t i = 0; i < Buffers.size(); ++i)
+    {
+        if (GetVkBuffer(Buffers[i]) != OldHandles[i])
+            ++NumRelocated;
+    }
+    EXPECT_EQ(NumRelocated, Stats.NumBuffersMoved);
+
+    for (size_t i = 0; i < Buffers.size(); ++i)
+        VerifyBufferData(Buffers[i], static_cast<Uint32>(i * SurvivorInterval + 1));
+}
+
+} // namespace
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <cstring>
+
+#include "VulkanUtilities/VulkanPipelineCacheHeader.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace VulkanUtilities;
+
+namespace
+{
+
+TEST(VulkanUtilities, ValidatePipelineCacheHeader)
+{
+    constexpr uint8_t UUID[VK_UUID_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+    VkPhysicalDeviceProperties DeviceProps = {};
+    DeviceProps.vendorID                   = 0x10DE;
+    DeviceProps.deviceID                   = 0x2204;
+    memcpy(DeviceProps.pipelineCacheUUID, UUID, sizeof(UUID));
+
+    PipelineCacheHeaderOne RefHeader;
+    RefHeader.HeaderSize    = sizeof(PipelineCacheHeaderOne);
+    RefHeader.HeaderVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    RefHeader.VendorID      = DeviceProps.vendorID;
+    RefHeader.DeviceID      = DeviceProps.deviceID;
+    memcpy(RefHeader.PipelineCacheUUID, UUID, sizeof(UUID));
+
+    // Header followed by some payload
+    auto MakeData = [&](const PipelineCacheHeaderOne& Header) {
+        std::vector<uint8_t> Data(sizeof(Header) + 64, 0xCD);
+        memcpy(Data.data(), &Header, sizeof(Header));
+        return Data;
+    };
+
+    auto Validate = [&](const std::vector<uint8_t>& Data, size_t Size) {
+        return ValidatePipelineCacheHeader(Data.data(), Size, DeviceProps);
+    };
+
+    {
+        const auto Data = MakeData(RefHeader);
+        EXPECT_EQ(Validate(Data, Data.size()), PIPELINE_CACHE_HEADER_STATUS_OK);
+        // Header without payload
+        EXPECT_EQ(Validate(Data, sizeof(RefHeader)), PIPELINE_CACHE_HEADER_STATUS_OK);
+
+        PipelineCacheHeaderOne Header;
+        EXPECT_EQ(ValidatePipelineCacheHeader(Data.data(), Data.size(), DeviceProps, &Header), PIPELINE_CACHE_HEADER_STATUS_OK);
+        EXPECT_EQ(memcmp(&Header, &RefHeader, sizeof(Header)), 0);
+
+        // Truncated data
+        EXPECT_EQ(Validate(Data, sizeof(RefHeader) - 1), PIPELINE_CACHE_HEADER_STATUS_MALFORMED);
+        EXPECT_EQ(Validate(Data, 0), PIPELINE_CACHE_HEADER_STATUS_MALFORMED);
+        EXPECT_EQ(ValidatePipelineCacheHeader(nullptr, 0, DeviceProps), PIPELINE_CACHE_HEADER_STATUS_MALFORMED);
+    }
+
+    {
+        auto Header = RefHeader;
+
+        Header.HeaderSize = sizeof(Header) - 1;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_MALFORMED);
+
+        // Header size exceeds the data size
+        Header.HeaderSize = sizeof(Header) + 65;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_MALFORMED);
+
+        // Larger header sizes are allowed by the specification
+        Header.HeaderSize = sizeof(Header) + 16;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_OK);
+    }
+
+    {
+        auto Header          = RefHeader;
+        Header.HeaderVersion = 2;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_UNSUPPORTED_VERSION);
+    }
+
+    {
+        auto Header     = RefHeader;
+        Header.VendorID = 0x1002;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_DEVICE_MISMATCH);
+
+        Header          = RefHeader;
+        Header.DeviceID = DeviceProps.deviceID + 1;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_DEVICE_MISMATCH);
+    }
+
+    {
+        auto Header = RefHeader;
+        Header.PipelineCacheUUID[15] ^= 0xFF;
+        EXPECT_EQ(Validate(MakeData(Header), sizeof(Header) + 64), PIPELINE_CACHE_HEADER_STATUS_UUID_MISMATCH);
+    }
+}
+
+} // namespace
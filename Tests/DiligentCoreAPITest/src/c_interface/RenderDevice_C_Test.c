@@ -39,6 +39,8 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     TextureFormatInfo         TexFmtInfo;
     TextureFormatInfoExt      TexFmtInfoExt;
     IEngineFactory*           pFactory = NULL;
+    const char*               InternedStr1 = NULL;
+    const char*               InternedStr2 = NULL;
 
     int num_errors = TestObjectCInterface((struct IObject*)pRenderDevice);
 
@@ -76,6 +78,11 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     if (pFactory == NULL)
         ++num_errors;
 
+    InternedStr1 = IRenderDevice_InternString(pRenderDevice, "Interned string");
+    InternedStr2 = IRenderDevice_InternString(pRenderDevice, "Interned string");
+    if (InternedStr1 == NULL || InternedStr1 != InternedStr2)
+        ++num_errors;
+
     return num_errors;
 }
 
@@ -70,5 +70,8 @@ void TestResourceMappingC_API(struct IResourceMapping* pResourceMapping)
     IResourceMapping_AddResourceArray(pResourceMapping, "Resource Array Name", 0, &pObject, ArraySize, true);
     IResourceMapping_RemoveResourceByName(pResourceMapping, "Resource Name", ArrayIndex);
     IResourceMapping_GetResource(pResourceMapping, "Resource Name", &pObject, ArrayIndex);
+    IResourceMapping_AddResourceByInternedName(pResourceMapping, "Interned Name", pObject, true, ArrayIndex);
+    IResourceMapping_RemoveResourceByInternedName(pResourceMapping, "Interned Name", ArrayIndex);
+    IResourceMapping_GetResourceByInternedName(pResourceMapping, "Interned Name", &pObject, ArrayIndex);
     Size = IResourceMapping_GetSize(pResourceMapping);
 }
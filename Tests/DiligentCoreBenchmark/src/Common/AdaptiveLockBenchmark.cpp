@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "AdaptiveLock.hpp"
+#include "LockHelper.hpp"
+#include "Timer.hpp"
+#include "../../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace ThreadingTools;
+
+namespace
+{
+
+struct SpinLockAdapter
+{
+    void Lock() { LockHelper::UnsafeLock(Flag); }
+    void Unlock() { LockHelper::UnsafeUnlock(Flag); }
+
+    LockFlag Flag;
+};
+
+struct AdaptiveLockAdapter
+{
+    explicit AdaptiveLockAdapter(LockContentionStats* pStats = nullptr) :
+        Lck{pStats}
+    {}
+    void Lock() { Lck.Lock(); }
+    void Unlock() { Lck.Unlock(); }
+
+    AdaptiveLock Lck;
+};
+
+// Returns the time it takes all threads to run the given number of critical sections
+template <typename LockAdapterType>
+double MeasureExclusiveLock(LockAdapterType& Lck, Uint32 NumThreads, Uint32 NumIterations, Uint32 WorkSize)
+{
+    Uint64 Counter = 0;
+
+    Timer T;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            volatile Uint32 Work = 0;
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                Lck.Lock();
+                ++Counter;
+                for (Uint32 w = 0; w < WorkSize; ++w)
+                    Work = Work + w;
+                Lck.Unlock();
+
+                for (Uint32 w = 0; w < WorkSize; ++w)
+                    Work = Work + w;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Time = T.GetElapsedTime();
+    EXPECT_EQ(Counter, Uint64{NumThreads} * NumIterations);
+
+    return Time;
+}
+
+// Compares the adaptive lock with the spinlock implemented by LockHelper
+// when the number of threads is much greater than the number of cores.
+TEST(Common_AdaptiveLock, Benchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 2000;
+#else
+    constexpr Uint32 NumIterations = 20000;
+#endif
+
+    for (Uint32 Oversubscription : {1u, 4u})
+    {
+        const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 2u) * Oversubscription;
+
+        SpinLockAdapter SpinLock;
+        const auto      SpinTime = MeasureExclusiveLock(SpinLock, NumThreads, NumIterations, 64);
+
+        LockContentionStats Stats;
+        AdaptiveLockAdapter AdaptiveLck{&Stats};
+        const auto          AdaptiveTime = MeasureExclusiveLock(AdaptiveLck, NumThreads, NumIterations, 64);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads x ", NumIterations, " iterations. LockHelper: ", SpinTime * 1000.0,
+                         " ms; AdaptiveLock: ", AdaptiveTime * 1000.0, " ms (",
+                         Stats.NumContendedAcquisitions.load(), " contended acquisitions, ",
+                         Stats.NumSpins.load(), " spins, ", Stats.NumParks.load(), " parks)");
+    }
+}
+
+} // namespace
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+#include "Errors.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+ViewFrustum GetTestViewFrustum()
+{
+    const auto View = float4x4::RotationY(0.3f) * float4x4::RotationX(-0.2f) * float4x4::Translation(5, -3, 40);
+    const auto Proj = float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 100.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(View * Proj, Frustum, false);
+    return Frustum;
+}
+
+std::vector<BoundBox> GetRandomBoxes(size_t Count)
+{
+    FastRandFloat rnd{0, -80.f, 80.f};
+    FastRandFloat rnd_size{1, 0.f, 15.f};
+
+    std::vector<BoundBox> Boxes(Count);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{rnd(), rnd(), rnd()};
+        Box.Max = Box.Min + float3{rnd_size(), rnd_size(), rnd_size()};
+    }
+    return Boxes;
+}
+
+TEST(Common_AdvancedMath, CullBoundBoxesBenchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumBoxes = 20000;
+#else
+    constexpr size_t NumBoxes = 200000;
+#endif
+    constexpr int NumIterations = 10;
+
+    const auto        Frustum = GetTestViewFrustum();
+    const auto        Boxes   = GetRandomBoxes(NumBoxes);
+    const BoundBoxSoA BoxesSoA{Boxes.data(), Boxes.size()};
+
+    std::vector<Uint32> RefVisibleIndices;
+    RefVisibleIndices.reserve(NumBoxes);
+    std::vector<Uint32> VisibleIndices(NumBoxes);
+
+    Timer T;
+    for (int iter = 0; iter < NumIterations; ++iter)
+    {
+        RefVisibleIndices.clear();
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            if (GetBoxVisibility(Frustum, Boxes[i]) != BoxVisibility::Invisible)
+                RefVisibleIndices.push_back(static_cast<Uint32>(i));
+        }
+    }
+    const auto ScalarTime = T.GetElapsedTime() / NumIterations;
+
+    size_t NumVisible = 0;
+    T.Restart();
+    for (int iter = 0; iter < NumIterations; ++iter)
+        NumVisible = CullBoundBoxes(Frustum, BoxesSoA, VisibleIndices.data());
+    const auto BatchTime = T.GetElapsedTime() / NumIterations;
+    EXPECT_EQ(NumVisible, RefVisibleIndices.size());
+
+    ThreadPool Pool;
+
+    T.Restart();
+    for (int iter = 0; iter < NumIterations; ++iter)
+        NumVisible = CullBoundBoxes(Frustum, BoxesSoA, VisibleIndices.data(), Pool);
+    const auto ParallelTime = T.GetElapsedTime() / NumIterations;
+    EXPECT_EQ(NumVisible, RefVisibleIndices.size());
+
+    LOG_INFO_MESSAGE("Culling ", NumBoxes, " boxes (", NumVisible, " visible): scalar ", ScalarTime * 1000.0,
+                     " ms; batch ", BatchTime * 1000.0, " ms; batch with ", Pool.GetNumThreads(), " worker threads ", ParallelTime * 1000.0, " ms");
+}
+
+} // namespace
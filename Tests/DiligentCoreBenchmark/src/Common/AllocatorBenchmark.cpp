@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FixedBlockMemoryAllocator.hpp"
+#include "ThreadCachingFixedBlockMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename AllocatorType>
+double RunFixedBlockAllocatorBenchmark(AllocatorType& Allocator, size_t AllocSize, Uint32 NumThreads, Uint32 NumIterations)
+{
+    // Every thread keeps a working set of live allocations and releases them in a pseudo-random order
+    constexpr size_t WorkingSetSize = 64;
+
+    std::vector<std::thread> Threads(NumThreads);
+
+    Timer T;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread(
+            [&Allocator, AllocSize, NumIterations, t]() //
+            {
+                std::array<void*, WorkingSetSize> WorkingSet = {};
+
+                Uint32 Rand = t * 7919u + 1u;
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    Rand      = Rand * 1664525u + 1013904223u;
+                    auto& Ptr = WorkingSet[(Rand >> 16) % WorkingSetSize];
+                    if (Ptr != nullptr)
+                        Allocator.Free(Ptr);
+                    Ptr = Allocator.Allocate(AllocSize, "Fixed block allocator benchmark", __FILE__, __LINE__);
+                    memset(Ptr, static_cast<int>(t), AllocSize);
+                }
+
+                for (auto* Ptr : WorkingSet)
+                {
+                    if (Ptr != nullptr)
+                        Allocator.Free(Ptr);
+                }
+            });
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    return T.GetElapsedTime();
+}
+
+TEST(Common_FixedBlockMemoryAllocator, MultithreadedPerformance)
+{
+    constexpr size_t AllocSize             = 48;
+    constexpr Uint32 NumAllocationsPerPage = 256;
+    constexpr Uint32 NumIterations         = 500000;
+
+    const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        double MutexTime = 0;
+        {
+            FixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage);
+            MutexTime = RunFixedBlockAllocatorBenchmark(Allocator, AllocSize, NumThreads, NumIterations);
+        }
+
+        double CachingTime = 0;
+        {
+            ThreadCachingFixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage);
+            CachingTime = RunFixedBlockAllocatorBenchmark(Allocator, AllocSize, NumThreads, NumIterations);
+        }
+
+        LOG_INFO_MESSAGE(NumThreads, " thread(s) x ", NumIterations, " iterations: FixedBlockMemoryAllocator: ", MutexTime * 1000.0,
+                         " ms, ThreadCachingFixedBlockMemoryAllocator: ", CachingTime * 1000.0, " ms");
+    }
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "FilteringTools.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+#include "Errors.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+void RunFilterTexture2DBilinearBenchmark(const char* ModeName)
+{
+    constexpr Uint32 Width  = 1024;
+    constexpr Uint32 Height = 1024;
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumSamples = 1 << 16;
+#else
+    constexpr size_t NumSamples = 1 << 22;
+#endif
+
+    std::vector<float> Data(size_t{Width} * Height);
+    FastRandFloat      rnd{0, 0.f, 1.f};
+    for (auto& f : Data)
+        f = rnd();
+
+    std::vector<float2> UV(NumSamples);
+    for (auto& uv : UV)
+        uv = float2{rnd(), rnd()} * 1.5f - float2{0.25f, 0.25f};
+
+    std::vector<float> RefSamples(NumSamples);
+    std::vector<float> Samples(NumSamples);
+
+    Timer T;
+    for (size_t i = 0; i < NumSamples; ++i)
+        RefSamples[i] = FilterTexture2DBilinear<float, float, AddressMode, AddressMode, true>(Width, Height, Data.data(), Width, UV[i].x, UV[i].y);
+    const auto ScalarTime = T.GetElapsedTime();
+
+    T.Restart();
+    FilterTexture2DBilinearBatch<float, float, AddressMode, AddressMode, true>(Width, Height, Data.data(), Width, UV.data(), NumSamples, Samples.data());
+    const auto BatchTime = T.GetElapsedTime();
+
+    EXPECT_EQ(Samples, RefSamples);
+
+    LOG_INFO_MESSAGE(NumSamples, " bilinear samples (", ModeName, "): scalar ", ScalarTime * 1000.0, " ms; batch ", BatchTime * 1000.0, " ms");
+}
+
+TEST(Common_FilteringTools, BilinearBatchBenchmark)
+{
+    RunFilterTexture2DBilinearBenchmark<TEXTURE_ADDRESS_CLAMP>("clamp");
+    RunFilterTexture2DBilinearBenchmark<TEXTURE_ADDRESS_WRAP>("wrap");
+    RunFilterTexture2DBilinearBenchmark<TEXTURE_ADDRESS_MIRROR>("mirror");
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename MapType, typename KeyType>
+void MeasureMapPerformance(const char* MapName, const std::vector<KeyType>& Keys, Uint32 NumLookupPasses)
+{
+    Timer T;
+
+    MapType Map;
+    for (size_t i = 0; i < Keys.size(); ++i)
+        Map.emplace(Keys[i], i);
+    const auto InsertTime = T.GetElapsedTime();
+
+    T.Restart();
+    size_t Sum = 0;
+    for (Uint32 pass = 0; pass < NumLookupPasses; ++pass)
+    {
+        for (const auto& Key : Keys)
+            Sum += Map.find(Key)->second;
+    }
+    const auto LookupTime = T.GetElapsedTime();
+    EXPECT_EQ(Sum, NumLookupPasses * Keys.size() * (Keys.size() - 1) / 2);
+
+    LOG_INFO_MESSAGE(MapName, ": ", Keys.size(), " insertions: ", InsertTime * 1000.0, " ms; ",
+                     NumLookupPasses * Keys.size(), " lookups: ", LookupTime * 1000.0, " ms");
+}
+
+TEST(Common_FlatHashMap, Performance)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumKeys         = 1 << 12;
+    constexpr Uint32 NumLookupPasses = 4;
+#else
+    constexpr size_t NumKeys         = 1 << 16;
+    constexpr Uint32 NumLookupPasses = 16;
+#endif
+
+    {
+        std::vector<Uint64> Keys(NumKeys);
+        for (size_t i = 0; i < NumKeys; ++i)
+            Keys[i] = static_cast<Uint64>(i) * 0x9E3779B97F4A7C15ull;
+
+        MeasureMapPerformance<std::unordered_map<Uint64, size_t>>("std::unordered_map<Uint64>", Keys, NumLookupPasses);
+        MeasureMapPerformance<FlatHashMap<Uint64, size_t>>("FlatHashMap<Uint64>        ", Keys, NumLookupPasses);
+    }
+
+    {
+        std::vector<std::string> Keys(NumKeys);
+        for (size_t i = 0; i < NumKeys; ++i)
+            Keys[i] = "Resource name " + std::to_string(i);
+
+        MeasureMapPerformance<std::unordered_map<std::string, size_t>>("std::unordered_map<std::string>", Keys, NumLookupPasses);
+        MeasureMapPerformance<FlatHashMap<std::string, size_t>>("FlatHashMap<std::string>        ", Keys, NumLookupPasses);
+    }
+}
+
+} // namespace
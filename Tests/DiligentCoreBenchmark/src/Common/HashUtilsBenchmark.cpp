@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "HashUtils.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_HashUtils, Throughput)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumIterations = 16;
+#else
+    constexpr size_t NumIterations = 256;
+#endif
+
+    std::vector<Uint8> Data(1 << 16);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 131 + 7);
+
+    Timer  T;
+    Uint64 Hash = 0;
+    for (size_t i = 0; i < NumIterations; ++i)
+        Hash ^= HashBytes(Data.data(), Data.size(), i);
+    const auto BytesTime = T.GetElapsedTime();
+    EXPECT_NE(Hash, Uint64{0});
+
+    std::vector<std::string> Strings;
+    for (Uint32 i = 0; i < 1024; ++i)
+        Strings.emplace_back("g_ShaderResourceName" + std::to_string(i));
+
+    T.Restart();
+    size_t StrHash = 0;
+    for (size_t i = 0; i < NumIterations; ++i)
+    {
+        for (const auto& Str : Strings)
+            StrHash ^= CStringHash<Char>{}(Str.c_str());
+    }
+    const auto StringsTime = T.GetElapsedTime();
+    (void)StrHash;
+
+    const double MBytes = static_cast<double>(Data.size() * NumIterations) / (1024.0 * 1024.0);
+    LOG_INFO_MESSAGE("HashBytes: ", MBytes / std::max(BytesTime, 1e-9), " MB/s; CStringHash: ",
+                     static_cast<double>(Strings.size() * NumIterations) / std::max(StringsTime, 1e-9) * 1e-6, " M strings/s");
+}
+
+} // namespace
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+#include "Errors.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Scalar implementations that follow the operation order of the generic templates
+
+float4x4 RefMatrixMul(const float4x4& m1, const float4x4& m2)
+{
+    float4x4 mOut;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 4; k++)
+                mOut.m[i][j] += m1.m[i][k] * m2.m[k][j];
+        }
+    }
+    return mOut;
+}
+
+float3 RefTransformPoint(const float3& p, const float4x4& m)
+{
+    float4 p4;
+    for (int j = 0; j < 4; ++j)
+        p4[j] = p.x * m[0][j] + p.y * m[1][j] + p.z * m[2][j] + m[3][j];
+    return float3{p4.x / p4.w, p4.y / p4.w, p4.z / p4.w};
+}
+
+float4x4 GetRandomMatrix(FastRandFloat& rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 16; ++i)
+        m.Data()[i] = rnd();
+    return m;
+}
+
+TEST(Common_BasicMath, SIMDMathBenchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumMatrices = 1 << 12;
+    constexpr size_t NumPoints   = 1 << 16;
+#else
+    constexpr size_t NumMatrices = 1 << 18;
+    constexpr size_t NumPoints   = 1 << 22;
+#endif
+
+    FastRandFloat         rnd{0, -1.f, 1.f};
+    std::vector<float4x4> Matrices(NumMatrices);
+    for (auto& m : Matrices)
+    {
+        m = GetRandomMatrix(rnd);
+        for (int i = 0; i < 4; ++i)
+            m[i][i] += 4.f;
+    }
+    std::vector<float4x4> Results(NumMatrices);
+
+    Timer T;
+    for (size_t i = 0; i + 1 < NumMatrices; ++i)
+        Results[i] = RefMatrixMul(Matrices[i], Matrices[i + 1]);
+    const auto RefMulTime = T.GetElapsedTime();
+
+    T.Restart();
+    for (size_t i = 0; i + 1 < NumMatrices; ++i)
+        Results[i] = Matrices[i] * Matrices[i + 1];
+    const auto MulTime = T.GetElapsedTime();
+
+    T.Restart();
+    for (size_t i = 0; i < NumMatrices; ++i)
+        Results[i] = Matrices[i].InverseGeneric();
+    const auto RefInvTime = T.GetElapsedTime();
+
+    T.Restart();
+    for (size_t i = 0; i < NumMatrices; ++i)
+        Results[i] = Matrices[i].Inverse();
+    const auto InvTime = T.GetElapsedTime();
+
+    std::vector<float3> Points(NumPoints);
+    for (auto& p : Points)
+        p = float3{rnd(), rnd(), rnd()};
+    std::vector<float3> TransformedPoints(NumPoints);
+
+    const auto& m = Matrices[0];
+
+    T.Restart();
+    for (size_t i = 0; i < NumPoints; ++i)
+        TransformedPoints[i] = RefTransformPoint(Points[i], m);
+    const auto RefTransformTime = T.GetElapsedTime();
+
+    T.Restart();
+    TransformPoints(Points.data(), NumPoints, m, TransformedPoints.data());
+    const auto TransformTime = T.GetElapsedTime();
+
+    LOG_INFO_MESSAGE("float4x4 multiply (", NumMatrices, "): scalar ", RefMulTime * 1000.0, " ms; SIMD ", MulTime * 1000.0, " ms\n",
+                     "float4x4 inverse (", NumMatrices, "): generic ", RefInvTime * 1000.0, " ms; SIMD ", InvTime * 1000.0, " ms\n",
+                     "TransformPoints (", NumPoints, "): scalar ", RefTransformTime * 1000.0, " ms; SIMD ", TransformTime * 1000.0, " ms");
+}
+
+} // namespace
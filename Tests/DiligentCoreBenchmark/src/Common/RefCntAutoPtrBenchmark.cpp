@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "RefCntAutoPtr.hpp"
+#include "RefCountedObjectImpl.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TrackedObject : public RefCountedObject<IObject>
+{
+public:
+    TrackedObject(IReferenceCounters* pRefCounters, std::atomic_int& NumDestroyed) :
+        RefCountedObject<IObject>{pRefCounters},
+        m_NumDestroyed{NumDestroyed}
+    {}
+
+    ~TrackedObject()
+    {
+        ++m_NumDestroyed;
+    }
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        *ppInterface = nullptr;
+        if (IID == IID_Unknown)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+    }
+
+private:
+    std::atomic_int& m_NumDestroyed;
+};
+
+// Waits until all threads have arrived
+void SpinBarrier(std::atomic_int& Counter, int NumThreads)
+{
+    ++Counter;
+    while (Counter.load() < NumThreads)
+        std::this_thread::yield();
+}
+
+// Measures the throughput of weak-to-strong promotion of a single object shared by all threads
+TEST(Common_RefCntWeakPtr, PromotionThroughput)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr int NumIterations = 20000;
+#else
+    constexpr int NumIterations = 200000;
+#endif
+
+    std::atomic_int              NumDestroyed{0};
+    RefCntAutoPtr<TrackedObject> pObj{MakeNewRCObj<TrackedObject>{}(NumDestroyed)};
+    RefCntWeakPtr<TrackedObject> pWeak{pObj};
+
+    for (int NumThreads = 1; NumThreads <= 32; NumThreads *= 2)
+    {
+        std::atomic_int NumArrived{0};
+        std::atomic_int NumFailures{0};
+
+        Timer T;
+
+        std::vector<std::thread> Threads;
+        for (int t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&]() {
+                RefCntWeakPtr<TrackedObject> pThreadWeak{pWeak};
+                SpinBarrier(NumArrived, NumThreads);
+                for (int i = 0; i < NumIterations; ++i)
+                {
+                    if (!pThreadWeak.Lock())
+                        ++NumFailures;
+                }
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        const auto Time = T.GetElapsedTime();
+        EXPECT_EQ(NumFailures, 0);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads: ", NumThreads * NumIterations, " promotions in ", Time * 1000.0, " ms (",
+                         static_cast<double>(NumThreads) * NumIterations / Time / 1e6, " M/s)");
+    }
+
+    pObj.Release();
+    EXPECT_EQ(NumDestroyed, 1);
+}
+
+} // namespace
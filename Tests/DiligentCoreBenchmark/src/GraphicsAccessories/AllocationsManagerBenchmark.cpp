@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Align.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct AllocationRequest
+{
+    size_t Size;
+    size_t Alignment;
+};
+
+// Approximates the mix of requests seen by a GPU memory sub-allocator: many small constant
+// buffers, fewer vertex and index buffers, and occasional texture-sized blocks.
+class BufferSizeDistribution
+{
+public:
+    explicit BufferSizeDistribution(bool MixedAlignments) :
+        m_MixedAlignments{MixedAlignments}
+    {}
+
+    AllocationRequest operator()(std::mt19937& Rng) const
+    {
+        using UniformDist = std::uniform_int_distribution<size_t>;
+
+        AllocationRequest Request{};
+
+        const auto Category = UniformDist{0, 99}(Rng);
+        if (Category < 70)
+        {
+            // Constant buffers: 256 B - 4 KB
+            Request.Size      = 256 * UniformDist{1, 16}(Rng);
+            Request.Alignment = 256;
+        }
+        else if (Category < 95)
+        {
+            // Vertex and index buffers: 4 KB - 1 MB, roughly log-uniform
+            Request.Size      = UniformDist{size_t{4} << 10, size_t{1} << UniformDist{13, 20}(Rng)}(Rng);
+            Request.Alignment = m_MixedAlignments ? size_t{4} << (2 * UniformDist{0, 3}(Rng)) : 256;
+        }
+        else
+        {
+            // Textures: 1 MB - 8 MB
+            Request.Size      = (size_t{64} << 10) * UniformDist{16, 128}(Rng);
+            Request.Alignment = m_MixedAlignments ? size_t{64} << 10 : 256;
+        }
+
+        if (!m_MixedAlignments)
+            Request.Size = AlignUp(Request.Size, size_t{256});
+
+        return Request;
+    }
+
+private:
+    const bool m_MixedAlignments;
+};
+
+// Runs a steady-state workload at high utilization and reports the throughput and the fragmentation:
+// the share of requests that could not be served although the total free size was sufficient.
+template <typename AllocationsManagerType>
+void RunAllocatorBenchmark(const char* Name)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumOperations = 5000;
+#else
+    constexpr size_t NumOperations = 1000000;
+#endif
+    constexpr size_t MaxSize = size_t{256} << 20;
+
+    AllocationsManagerType ListMgr{MaxSize, Allocator};
+
+    std::mt19937                 Rng{3};
+    const BufferSizeDistribution SizeDist{true};
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocations;
+
+    size_t NumAllocations = 0;
+    size_t NumFailures    = 0;
+
+    Timer T;
+    for (size_t op = 0; op < NumOperations; ++op)
+    {
+        // Keep the utilization around 90%
+        if (Allocations.empty() || ListMgr.GetUsedSize() < MaxSize / 10 * 9)
+        {
+            const auto Request = SizeDist(Rng);
+
+            auto Alloc = ListMgr.Allocate(Request.Size, Request.Alignment);
+            ++NumAllocations;
+            if (Alloc.IsValid())
+            {
+                Allocations.push_back(Alloc);
+                continue;
+            }
+            else if (ListMgr.GetFreeSize() >= Request.Size + Request.Alignment)
+            {
+                ++NumFailures;
+            }
+
+            if (Allocations.empty())
+                continue;
+        }
+
+        std::swap(Allocations[std::uniform_int_distribution<size_t>{0, Allocations.size() - 1}(Rng)], Allocations.back());
+        ListMgr.Free(std::move(Allocations.back()));
+        Allocations.pop_back();
+    }
+    const auto ElapsedTime = T.GetElapsedTime();
+
+    LOG_INFO_MESSAGE(Name, ": ", NumOperations, " operations in ", ElapsedTime * 1000.0, " ms; ",
+                     NumFailures, " of ", NumAllocations, " allocations failed due to fragmentation; ",
+                     ListMgr.GetNumFreeBlocks(), " free blocks at the end");
+
+    for (auto& Alloc : Allocations)
+        ListMgr.Free(std::move(Alloc));
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Benchmark)
+{
+    RunAllocatorBenchmark<VariableSizeAllocationsManager>("VariableSizeAllocationsManager");
+    RunAllocatorBenchmark<TLSFAllocationsManager>("TLSFAllocationsManager");
+}
+
+} // namespace
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+#include "Errors.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint8 LinearToSRGB8Ref(float x)
+{
+    x = std::min(std::max(x, 0.f), 1.f);
+    return static_cast<Uint8>(LinearToSRGB(x) * 255.f + 0.5f);
+}
+
+TEST(GraphicsAccessories_ColorConversion, Benchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t Width  = 512;
+    constexpr size_t Height = 256;
+#else
+    constexpr size_t Width  = 3840;
+    constexpr size_t Height = 2160;
+#endif
+    constexpr size_t NumValues = Width * Height * 4;
+
+    std::vector<Uint8> SRGB(NumValues);
+    FastRandInt        rnd(0, 0, 255);
+    for (auto& c : SRGB)
+        c = static_cast<Uint8>(rnd());
+
+    std::vector<float> Linear(NumValues);
+    std::vector<Uint8> RoundTrip(NumValues);
+
+    Timer T;
+    for (size_t i = 0; i < NumValues; ++i)
+        Linear[i] = SRGBToLinear(static_cast<float>(SRGB[i]) / 255.f);
+    for (size_t i = 0; i < NumValues; ++i)
+        RoundTrip[i] = LinearToSRGB8Ref(Linear[i]);
+    const auto ScalarTime = T.GetElapsedTime();
+
+    T.Restart();
+    SRGB8ToLinearFloat(SRGB.data(), Linear.data(), NumValues);
+    const auto DecodeTime = T.GetElapsedTime();
+    T.Restart();
+    LinearFloatToSRGB8(Linear.data(), RoundTrip.data(), NumValues);
+    const auto EncodeTime = T.GetElapsedTime();
+
+    EXPECT_EQ(RoundTrip, SRGB);
+
+    LOG_INFO_MESSAGE(Width, "x", Height, " RGBA8 sRGB round trip: scalar ", ScalarTime * 1000.0, " ms; batch ",
+                     (DecodeTime + EncodeTime) * 1000.0, " ms (decode ", DecodeTime * 1000.0, " ms, encode ", EncodeTime * 1000.0, " ms)");
+}
+
+} // namespace
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentRingBuffer.hpp"
+#include "RingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares lock-free allocation with the mutex-protected RingBuffer
+TEST(GraphicsAccessories_ConcurrentRingBuffer, Benchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 5000;
+#else
+    constexpr Uint32 NumIterations = 50000;
+#endif
+    constexpr size_t AllocationSize = 256;
+
+    auto RunThreads = [](Uint32 NumThreads, const std::function<void()>& Allocate) {
+        Timer T;
+
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&]() {
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                    Allocate();
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        return T.GetElapsedTime();
+    };
+
+    for (Uint32 NumThreads : {1u, 4u, 16u})
+    {
+        const size_t BufferSize = AllocationSize * NumIterations * NumThreads;
+
+        std::atomic<Uint32> NumFailures{0};
+
+        double MutexTime = 0;
+        {
+            std::mutex Mtx;
+            RingBuffer RB{BufferSize, DefaultRawMemoryAllocator::GetAllocator()};
+            MutexTime = RunThreads(NumThreads, [&]() {
+                std::lock_guard<std::mutex> Lock{Mtx};
+                if (RB.Allocate(AllocationSize, 16) == RingBuffer::InvalidOffset)
+                    NumFailures.fetch_add(1);
+            });
+            RB.FinishCurrentFrame(1);
+            RB.ReleaseCompletedFrames(1);
+        }
+
+        double LockFreeTime = 0;
+        {
+            ConcurrentRingBuffer RB{BufferSize, 16};
+            LockFreeTime = RunThreads(NumThreads, [&]() {
+                if (RB.Allocate(AllocationSize, 16) == ConcurrentRingBuffer::InvalidOffset)
+                    NumFailures.fetch_add(1);
+            });
+            RB.FinishCurrentFrame(1);
+            RB.ReleaseCompletedFrames(1);
+        }
+        EXPECT_EQ(NumFailures.load(), 0u);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads x ", NumIterations, " allocations. RingBuffer with mutex: ", MutexTime * 1000.0,
+                         " ms; ConcurrentRingBuffer: ", LockFreeTime * 1000.0, " ms");
+    }
+}
+
+} // namespace
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "DynamicAtlasManager.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Region            = DynamicAtlasManager::Region;
+using PackingPolicy     = DynamicAtlasManager::PackingPolicy;
+using MaxRectsHeuristic = DynamicAtlasManager::MaxRectsHeuristic;
+
+struct AtlasTraceEvent
+{
+    Uint32 Width;
+    Uint32 Height;
+};
+
+// Generates a deterministic allocation trace. Glyph-like traces consist of small
+// regions with similar heights, lightmap-like traces use power-of-two squares and
+// rectangles of widely varying sizes.
+std::vector<AtlasTraceEvent> GenerateAtlasTrace(bool IsGlyphTrace, size_t NumEvents)
+{
+    std::mt19937                 Rng{IsGlyphTrace ? 7u : 11u};
+    std::vector<AtlasTraceEvent> Trace(NumEvents);
+    for (auto& Event : Trace)
+    {
+        if (IsGlyphTrace)
+        {
+            const auto FontSize = std::uniform_int_distribution<Uint32>{0, 2}(Rng) * 8 + 12;
+            Event.Width         = std::uniform_int_distribution<Uint32>{FontSize / 3, FontSize}(Rng);
+            Event.Height        = FontSize + std::uniform_int_distribution<Uint32>{0, FontSize / 4}(Rng);
+        }
+        else
+        {
+            Event.Width  = 8u << std::uniform_int_distribution<Uint32>{0, 4}(Rng);
+            Event.Height = Event.Width >> std::uniform_int_distribution<Uint32>{0, 1}(Rng);
+        }
+    }
+    return Trace;
+}
+
+void ReplayAtlasTrace(const char* TraceName, const std::vector<AtlasTraceEvent>& Trace, Uint32 AtlasSize, PackingPolicy Policy, MaxRectsHeuristic Heuristic, const char* ConfigName)
+{
+    DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Policy, Heuristic};
+
+    std::mt19937        Rng{3};
+    std::vector<Region> Regions;
+
+    size_t   NumFailures     = 0;
+    size_t   NumOperations   = 0;
+    Uint32   PeakArea        = 0;
+    double   OccupancyAtFail = 0;
+    const auto AtlasArea     = AtlasSize * AtlasSize;
+
+    Timer T;
+    for (const auto& Event : Trace)
+    {
+        auto R = Mgr.Allocate(Event.Width, Event.Height);
+        ++NumOperations;
+        if (!R.IsEmpty())
+        {
+            Regions.push_back(R);
+            PeakArea = std::max(PeakArea, Mgr.GetAllocatedArea());
+            continue;
+        }
+
+        // Accumulate the occupancy at which allocations start failing, and release
+        // a random quarter of live regions to emulate eviction.
+        ++NumFailures;
+        OccupancyAtFail += static_cast<double>(Mgr.GetAllocatedArea()) / AtlasArea;
+        for (size_t i = 0, NumToFree = Regions.size() / 4; i < NumToFree; ++i)
+        {
+            std::swap(Regions[std::uniform_int_distribution<size_t>{0, Regions.size() - 1}(Rng)], Regions.back());
+            Mgr.Free(std::move(Regions.back()));
+            Regions.pop_back();
+            ++NumOperations;
+        }
+    }
+    const auto ElapsedTime = T.GetElapsedTime();
+
+    LOG_INFO_MESSAGE(TraceName, " trace, ", ConfigName, ": ", NumOperations, " operations in ", ElapsedTime * 1000.0, " ms; ",
+                     "peak occupancy ", static_cast<double>(PeakArea) / AtlasArea * 100.0, "%; ",
+                     "average occupancy at allocation failure ", NumFailures > 0 ? OccupancyAtFail / NumFailures * 100.0 : 100.0, "% (",
+                     NumFailures, " failures); ", Mgr.GetFreeRegionCount(), " free regions at the end");
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Benchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumEvents = 2000;
+    constexpr Uint32 AtlasSize = 256;
+#else
+    constexpr size_t NumEvents = 50000;
+    constexpr Uint32 AtlasSize = 1024;
+#endif
+
+    for (auto IsGlyphTrace : {true, false})
+    {
+        const auto  Trace     = GenerateAtlasTrace(IsGlyphTrace, NumEvents);
+        const auto* TraceName = IsGlyphTrace ? "Glyph" : "Lightmap";
+
+        ReplayAtlasTrace(TraceName, Trace, AtlasSize, PackingPolicy::Guillotine, MaxRectsHeuristic::BestShortSideFit, "Guillotine");
+        ReplayAtlasTrace(TraceName, Trace, AtlasSize, PackingPolicy::MaxRects, MaxRectsHeuristic::BestShortSideFit, "MaxRects/BestShortSideFit");
+        ReplayAtlasTrace(TraceName, Trace, AtlasSize, PackingPolicy::MaxRects, MaxRectsHeuristic::BestAreaFit, "MaxRects/BestAreaFit");
+        ReplayAtlasTrace(TraceName, Trace, AtlasSize, PackingPolicy::MaxRects, MaxRectsHeuristic::BottomLeft, "MaxRects/BottomLeft");
+        ReplayAtlasTrace(TraceName, Trace, AtlasSize, PackingPolicy::MaxRects, MaxRectsHeuristic::ContactPoint, "MaxRects/ContactPoint");
+    }
+}
+
+} // namespace
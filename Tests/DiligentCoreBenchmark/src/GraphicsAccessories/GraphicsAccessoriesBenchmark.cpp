@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_GraphicsAccessories, CopyTextureSubresourceBenchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 Width  = 2048;
+    constexpr Uint32 Height = 2048;
+#else
+    constexpr Uint32 Width  = 8192;
+    constexpr Uint32 Height = 8192;
+#endif
+    constexpr Uint32 RowSize = Width * 4;
+    // Destination rows are padded as in D3D12 and Vulkan staging buffers
+    constexpr Uint32 DstRowStride = RowSize + 256;
+
+    std::vector<Uint8> SrcData(size_t{RowSize} * Height, 1);
+    std::vector<Uint8> DstData(size_t{DstRowStride} * Height);
+
+    TextureSubResData SubresData{SrcData.data(), RowSize, RowSize * Height};
+
+    ThreadPool Pool;
+
+    auto Measure = [&](COPY_TEXTURE_SUBRESOURCE_FLAGS Flags, ThreadPool* pPool) {
+        // Warm up
+        CopyTextureSubresource(SubresData, Height, 1, RowSize, DstData.data(), DstRowStride, DstRowStride * Height, Flags, pPool);
+
+        constexpr Uint32 NumIterations = 4;
+
+        Timer T;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            CopyTextureSubresource(SubresData, Height, 1, RowSize, DstData.data(), DstRowStride, DstRowStride * Height, Flags, pPool);
+        return T.GetElapsedTime() / NumIterations * 1000.0;
+    };
+
+    const auto SerialTime            = Measure(COPY_TEXTURE_SUBRESOURCE_FLAG_NONE, nullptr);
+    const auto StreamingTime         = Measure(COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED, nullptr);
+    const auto ParallelStreamingTime = Measure(COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED, &Pool);
+
+    LOG_INFO_MESSAGE("CopyTextureSubresource ", Width, "x", Height, " RGBA8: memcpy ", SerialTime, " ms; streaming ", StreamingTime,
+                     " ms; streaming with ", Pool.GetNumThreads(), " worker thread(s) ", ParallelStreamingTime, " ms");
+}
+
+} // namespace
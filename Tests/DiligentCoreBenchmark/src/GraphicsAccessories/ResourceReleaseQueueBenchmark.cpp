@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ResourceReleaseQueue.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Resource that counts its destructions
+class TrackedResource
+{
+public:
+    explicit TrackedResource(std::atomic<Uint32>& NumDestroyed) :
+        m_pNumDestroyed{&NumDestroyed}
+    {}
+
+    TrackedResource(TrackedResource&& rhs) noexcept :
+        m_pNumDestroyed{rhs.m_pNumDestroyed}
+    {
+        rhs.m_pNumDestroyed = nullptr;
+    }
+
+    // clang-format off
+    TrackedResource             (const TrackedResource&) = delete;
+    TrackedResource& operator = (const TrackedResource&) = delete;
+    TrackedResource& operator = (TrackedResource&&)      = delete;
+    // clang-format on
+
+    ~TrackedResource()
+    {
+        if (m_pNumDestroyed != nullptr)
+            m_pNumDestroyed->fetch_add(1);
+    }
+
+private:
+    std::atomic<Uint32>* m_pNumDestroyed = nullptr;
+};
+
+// Compares the release queue with a mutex-protected deque
+TEST(GraphicsAccessories_ResourceReleaseQueue, Benchmark)
+{
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 5000;
+#else
+    constexpr Uint32 NumIterations = 50000;
+#endif
+    // The number of resources released between two purges
+    constexpr Uint32 FrameSize = 1024;
+
+    struct MutexReleaseQueue
+    {
+        void SafeReleaseResource(DynamicStaleResourceWrapper&& Wrapper, Uint64 FenceValue)
+        {
+            std::lock_guard<std::mutex> Lock{Mtx};
+            Queue.emplace_back(FenceValue, std::move(Wrapper));
+        }
+
+        void Purge(Uint64 CompletedFenceValue)
+        {
+            std::lock_guard<std::mutex> Lock{Mtx};
+            while (!Queue.empty() && Queue.front().first <= CompletedFenceValue)
+                Queue.pop_front();
+        }
+
+        std::mutex                                                 Mtx;
+        std::deque<std::pair<Uint64, DynamicStaleResourceWrapper>> Queue;
+    };
+
+    // Runs NumThreads threads that release resources, while the main thread purges the queue
+    auto Run = [](Uint32 NumThreads, const std::function<void(Uint32, Uint64)>& Release, const std::function<void(Uint64)>& Purge) {
+        Timer T;
+
+        std::atomic<Uint64> Fence{1};
+        std::atomic<Uint32> NumFinishedThreads{0};
+
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&, t]() {
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    Release(i, Fence.load());
+                    if (t == 0 && (i % FrameSize) == FrameSize - 1)
+                        Fence.fetch_add(1);
+                }
+                NumFinishedThreads.fetch_add(1);
+            });
+        }
+        while (NumFinishedThreads.load() < NumThreads)
+        {
+            Purge(Fence.load() - 1);
+            std::this_thread::yield();
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+        Purge(~Uint64{0});
+
+        return T.GetElapsedTime();
+    };
+
+    for (Uint32 NumThreads : {1u, 4u, 16u})
+    {
+        std::atomic<Uint32> NumDestroyed{0};
+
+        double MutexTime = 0;
+        {
+            MutexReleaseQueue Queue;
+            MutexTime = Run(
+                NumThreads,
+                [&](Uint32, Uint64 FenceValue) {
+                    Queue.SafeReleaseResource(DynamicStaleResourceWrapper::Create(TrackedResource{NumDestroyed}, 1), FenceValue);
+                },
+                [&](Uint64 CompletedFenceValue) {
+                    Queue.Purge(CompletedFenceValue);
+                });
+        }
+
+        double LockFreeTime = 0;
+        {
+            auto&                                             Allocator = DefaultRawMemoryAllocator::GetAllocator();
+            ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{Allocator, &Allocator};
+            LockFreeTime = Run(
+                NumThreads,
+                [&](Uint32, Uint64 FenceValue) {
+                    Queue.DiscardResource(TrackedResource{NumDestroyed}, FenceValue);
+                },
+                [&](Uint64 CompletedFenceValue) {
+                    Queue.Purge(CompletedFenceValue);
+                });
+        }
+        EXPECT_EQ(NumDestroyed.load(), NumThreads * NumIterations * 2);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads x ", NumIterations, " releases. Mutex-protected deque: ", MutexTime * 1000.0,
+                         " ms; ResourceReleaseQueue: ", LockFreeTime * 1000.0, " ms");
+    }
+}
+
+} // namespace
@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "AdaptiveLock.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace ThreadingTools;
+
+namespace
+{
+
+// Adapters that give all locks the same interface
+struct AdaptiveLockAdapter
+{
+    explicit AdaptiveLockAdapter(LockContentionStats* pStats = nullptr) :
+        Lck{pStats}
+    {}
+    void Lock() { Lck.Lock(); }
+    void Unlock() { Lck.Unlock(); }
+
+    AdaptiveLock Lck;
+};
+
+struct AdaptiveSharedLockAdapter
+{
+    explicit AdaptiveSharedLockAdapter(LockContentionStats* pStats = nullptr) :
+        Lck{pStats}
+    {}
+    void Lock() { Lck.Lock(); }
+    void Unlock() { Lck.Unlock(); }
+
+    AdaptiveSharedLock Lck;
+};
+
+Uint32 GetNumThreads(Uint32 Oversubscription)
+{
+    return std::max(std::thread::hardware_concurrency(), 2u) * Oversubscription;
+}
+
+// Every thread increments two counters inside the critical section.
+// The counters must always be equal if the lock provides mutual exclusion.
+template <typename LockAdapterType>
+void RunExclusiveStress(LockAdapterType& Lck, Uint32 NumThreads, Uint32 NumIterations, Uint32 WorkSize)
+{
+    Uint64 Counter0 = 0;
+    Uint64 Counter1 = 0;
+    bool   Mismatch = false;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            volatile Uint32 Work = 0;
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                Lck.Lock();
+                ++Counter0;
+                for (Uint32 w = 0; w < WorkSize; ++w)
+                    Work = Work + w;
+                if (Counter0 != Counter1 + 1)
+                    Mismatch = true;
+                ++Counter1;
+                Lck.Unlock();
+
+                for (Uint32 w = 0; w < WorkSize; ++w)
+                    Work = Work + w;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_FALSE(Mismatch);
+    EXPECT_EQ(Counter0, Uint64{NumThreads} * NumIterations);
+    EXPECT_EQ(Counter1, Uint64{NumThreads} * NumIterations);
+}
+
+TEST(Common_AdaptiveLock, LockUnlock)
+{
+    LockContentionStats Stats;
+    AdaptiveLock        Lck{&Stats};
+
+    EXPECT_FALSE(Lck.IsLocked());
+    Lck.Lock();
+    EXPECT_TRUE(Lck.IsLocked());
+    EXPECT_FALSE(Lck.TryLock());
+    Lck.Unlock();
+    EXPECT_FALSE(Lck.IsLocked());
+
+    EXPECT_TRUE(Lck.TryLock());
+    Lck.Unlock();
+
+    {
+        ExclusiveLockGuard<AdaptiveLock> Guard{Lck};
+        EXPECT_TRUE(Lck.IsLocked());
+
+        ExclusiveLockGuard<AdaptiveLock> Guard2{std::move(Guard)};
+        EXPECT_TRUE(Lck.IsLocked());
+    }
+    EXPECT_FALSE(Lck.IsLocked());
+
+    EXPECT_EQ(Stats.NumAcquisitions, Uint64{3});
+    EXPECT_EQ(Stats.NumContendedAcquisitions, Uint64{0});
+    EXPECT_EQ(Stats.NumParks, Uint64{0});
+}
+
+TEST(Common_AdaptiveLock, Park)
+{
+    LockContentionStats Stats;
+    AdaptiveLock        Lck{&Stats};
+
+    Lck.Lock();
+    std::thread Waiter{[&]() {
+        Lck.Lock();
+        Lck.Unlock();
+    }};
+    // Hold the lock long enough for the waiter to stop spinning and park
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    Lck.Unlock();
+    Waiter.join();
+
+    EXPECT_FALSE(Lck.IsLocked());
+    EXPECT_EQ(Stats.NumAcquisitions, Uint64{2});
+    EXPECT_EQ(Stats.NumContendedAcquisitions, Uint64{1});
+    EXPECT_GT(Stats.NumSpins, Uint64{0});
+    EXPECT_GE(Stats.NumParks, Uint64{1});
+}
+
+TEST(Common_AdaptiveLock, Stress)
+{
+    LockContentionStats Stats;
+    AdaptiveLockAdapter Lck{&Stats};
+
+    const auto NumThreads = GetNumThreads(4);
+    RunExclusiveStress(Lck, NumThreads, 2000, 16);
+    EXPECT_EQ(Stats.NumAcquisitions, Uint64{NumThreads} * 2000);
+    EXPECT_LE(Stats.NumContendedAcquisitions, Stats.NumAcquisitions);
+}
+
+TEST(Common_AdaptiveSharedLock, LockUnlock)
+{
+    AdaptiveSharedLock Lck;
+
+    Lck.LockShared();
+    EXPECT_TRUE(Lck.TryLockShared());
+    EXPECT_FALSE(Lck.TryLock());
+    Lck.UnlockShared();
+    EXPECT_FALSE(Lck.TryLock());
+    Lck.UnlockShared();
+
+    EXPECT_TRUE(Lck.TryLock());
+    EXPECT_FALSE(Lck.TryLockShared());
+    EXPECT_FALSE(Lck.TryLock());
+    Lck.Unlock();
+
+    {
+        SharedLockGuard Guard0{Lck};
+        SharedLockGuard Guard1{Lck};
+        EXPECT_FALSE(Lck.TryLock());
+    }
+    {
+        ExclusiveLockGuard<AdaptiveSharedLock> Guard{Lck};
+        EXPECT_FALSE(Lck.TryLockShared());
+    }
+    EXPECT_TRUE(Lck.TryLock());
+    Lck.Unlock();
+}
+
+TEST(Common_AdaptiveSharedLock, ParkReadersAndWriters)
+{
+    LockContentionStats Stats;
+    AdaptiveSharedLock  Lck{&Stats};
+
+    Lck.Lock();
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        Threads.emplace_back([&Lck, t]() {
+            if (t % 2 == 0)
+            {
+                SharedLockGuard Guard{Lck};
+            }
+            else
+            {
+                ExclusiveLockGuard<AdaptiveSharedLock> Guard{Lck};
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    Lck.Unlock();
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_TRUE(Lck.TryLock());
+    Lck.Unlock();
+    EXPECT_EQ(Stats.NumAcquisitions, Uint64{6});
+    EXPECT_GE(Stats.NumParks, Uint64{4});
+}
+
+TEST(Common_AdaptiveSharedLock, Stress)
+{
+    AdaptiveSharedLock Lck;
+
+    const auto NumThreads    = GetNumThreads(2);
+    const int  NumIterations = 5000;
+
+    // Writers keep the two values equal; readers must never observe them different
+    Uint64 Value0 = 0;
+    Uint64 Value1 = 0;
+
+    std::atomic<int> NumMismatches{0};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        const bool IsWriter = (t % 4) == 0;
+        Threads.emplace_back([&, IsWriter]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                if (IsWriter)
+                {
+                    ExclusiveLockGuard<AdaptiveSharedLock> Guard{Lck};
+                    ++Value0;
+                    ++Value1;
+                }
+                else
+                {
+                    SharedLockGuard Guard{Lck};
+                    if (Value0 != Value1)
+                        ++NumMismatches;
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumMismatches, 0);
+    EXPECT_EQ(Value0, Uint64{(NumThreads + 3) / 4} * NumIterations);
+    EXPECT_EQ(Value1, Value0);
+
+    AdaptiveSharedLockAdapter ExclusiveOnly;
+    RunExclusiveStress(ExclusiveOnly, GetNumThreads(4), 2000, 16);
+}
+
+} // namespace
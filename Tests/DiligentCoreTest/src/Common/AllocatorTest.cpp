@@ -26,11 +26,19 @@
  */
 
 #include <array>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
+#include "ThreadCachingFixedBlockMemoryAllocator.hpp"
+#include "SizeClassMemoryAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "ScratchAllocatorPool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +132,363 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_ThreadCachingFixedBlockMemoryAllocator, AllocDealloc)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+
+    ThreadCachingFixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage);
+
+    std::vector<void*> Allocations;
+    for (Uint32 i = 0; i < NumAllocationsPerPage * 5; ++i)
+    {
+        auto* Ptr = TestAllocator.Allocate(AllocSize, "Thread-caching fixed block allocator test", __FILE__, __LINE__);
+        ASSERT_NE(Ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(Ptr) % sizeof(void*), size_t{0});
+        memset(Ptr, static_cast<int>(i), AllocSize);
+        Allocations.push_back(Ptr);
+    }
+
+    // All allocations must be unique and must not overlap
+    {
+        auto SortedAllocations = Allocations;
+        std::sort(SortedAllocations.begin(), SortedAllocations.end());
+        for (size_t i = 1; i < SortedAllocations.size(); ++i)
+            EXPECT_GE(reinterpret_cast<Uint8*>(SortedAllocations[i]) - reinterpret_cast<Uint8*>(SortedAllocations[i - 1]), ptrdiff_t{AllocSize});
+    }
+
+    for (size_t i = 0; i < Allocations.size(); ++i)
+    {
+        const auto* Bytes = reinterpret_cast<const Uint8*>(Allocations[i]);
+        for (Uint32 b = 0; b < AllocSize; ++b)
+            EXPECT_EQ(Bytes[b], static_cast<Uint8>(i));
+    }
+
+    for (size_t s = 0; s < 3; ++s)
+        for (size_t i = s; i < Allocations.size(); i += 3)
+            TestAllocator.Free(Allocations[i]);
+
+    // Most recently released block is returned first
+    {
+        auto* Ptr0 = TestAllocator.Allocate(AllocSize, "Thread-caching fixed block allocator test", __FILE__, __LINE__);
+        TestAllocator.Free(Ptr0);
+        auto* Ptr1 = TestAllocator.Allocate(AllocSize, "Thread-caching fixed block allocator test", __FILE__, __LINE__);
+        EXPECT_EQ(Ptr0, Ptr1);
+        TestAllocator.Free(Ptr1);
+    }
+}
+
+TEST(Common_ThreadCachingFixedBlockMemoryAllocator, ReleaseEmptyPages)
+{
+    constexpr Uint32 AllocSize             = 24;
+    constexpr Uint32 NumAllocationsPerPage = 8;
+    constexpr Uint32 NumEmptyPagesToKeep   = 1;
+
+    ThreadCachingFixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, NumEmptyPagesToKeep);
+
+    std::vector<void*> Allocations(NumAllocationsPerPage * 16);
+    for (auto& Ptr : Allocations)
+        Ptr = TestAllocator.Allocate(AllocSize, "Thread-caching fixed block allocator test", __FILE__, __LINE__);
+    EXPECT_GE(TestAllocator.GetPageCount(), Uint32{16});
+
+    for (auto* Ptr : Allocations)
+        TestAllocator.Free(Ptr);
+
+    // Free blocks may still be held by the thread cache
+    TestAllocator.Trim();
+    EXPECT_EQ(TestAllocator.GetPageCount(), NumEmptyPagesToKeep);
+
+    // Allocate again to make sure the allocator is fully functional
+    for (auto& Ptr : Allocations)
+        Ptr = TestAllocator.Allocate(AllocSize, "Thread-caching fixed block allocator test", __FILE__, __LINE__);
+    for (auto* Ptr : Allocations)
+        TestAllocator.Free(Ptr);
+}
+
+TEST(Common_ThreadCachingFixedBlockMemoryAllocator, SmallObject)
+{
+    ThreadCachingFixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), 4, 1);
+
+    void* pRawMem0 = TestAllocator.Allocate(4, "Small object allocation test", __FILE__, __LINE__);
+    void* pRawMem1 = TestAllocator.Allocate(4, "Small object allocation test", __FILE__, __LINE__);
+    EXPECT_NE(pRawMem0, pRawMem1);
+    TestAllocator.Free(pRawMem0);
+    TestAllocator.Free(pRawMem1);
+}
+
+TEST(Common_ThreadCachingFixedBlockMemoryAllocator, Multithreaded)
+{
+    // Every thread keeps a working set of live allocations and releases them in a pseudo-random
+    // order. Blocks are filled with the thread id to detect allocations handed out twice.
+    constexpr size_t AllocSize             = 48;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+    constexpr Uint32 NumIterations         = 10000;
+    constexpr size_t WorkingSetSize        = 64;
+    constexpr Uint32 NumThreads            = 4;
+
+    ThreadCachingFixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage);
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread(
+            [&Allocator, t]() //
+            {
+                std::array<Uint8*, WorkingSetSize> WorkingSet = {};
+
+                Uint32 Rand = t * 7919u + 1u;
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    Rand      = Rand * 1664525u + 1013904223u;
+                    auto& Ptr = WorkingSet[(Rand >> 16) % WorkingSetSize];
+                    if (Ptr != nullptr)
+                    {
+                        EXPECT_EQ(Ptr[0], static_cast<Uint8>(t));
+                        EXPECT_EQ(Ptr[AllocSize - 1], static_cast<Uint8>(t));
+                        Allocator.Free(Ptr);
+                    }
+                    Ptr = reinterpret_cast<Uint8*>(Allocator.Allocate(AllocSize, "Multithreaded fixed block allocator test", __FILE__, __LINE__));
+                    memset(Ptr, static_cast<int>(t), AllocSize);
+                }
+
+                for (auto* Ptr : WorkingSet)
+                {
+                    if (Ptr != nullptr)
+                        Allocator.Free(Ptr);
+                }
+            });
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
+TEST(Common_SizeClassMemoryAllocator, SizeClasses)
+{
+    EXPECT_EQ(SizeClassMemoryAllocator::GetSizeClass(1), Uint32{0});
+    EXPECT_EQ(SizeClassMemoryAllocator::GetSizeClass(SizeClassMemoryAllocator::MaxSmallAllocationSize), SizeClassMemoryAllocator::NumSizeClasses - 1);
+    EXPECT_EQ(SizeClassMemoryAllocator::GetSizeClass(SizeClassMemoryAllocator::MaxSmallAllocationSize + 1), SizeClassMemoryAllocator::LargeAllocationSizeClass);
+
+    for (size_t Size = 1; Size <= SizeClassMemoryAllocator::MaxSmallAllocationSize; ++Size)
+    {
+        const auto SizeClass = SizeClassMemoryAllocator::GetSizeClass(Size);
+        ASSERT_LT(SizeClass, SizeClassMemoryAllocator::NumSizeClasses);
+        // The size must fit into its class, but must not fit into the previous one
+        EXPECT_GE(SizeClassMemoryAllocator::GetSizeClassBlockSize(SizeClass), Size);
+        if (SizeClass > 0)
+        {
+            EXPECT_LT(SizeClassMemoryAllocator::GetSizeClassBlockSize(SizeClass - 1), Size);
+        }
+    }
+}
+
+TEST(Common_SizeClassMemoryAllocator, AllocDealloc)
+{
+    SizeClassMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const size_t Sizes[] = {1, 8, 16, 17, 100, 128, 129, 500, 1000, 4096, 5000, 8192, 8193, 65536};
+
+    std::vector<std::pair<void*, size_t>> Allocations;
+    for (int i = 0; i < 10; ++i)
+    {
+        for (auto Size : Sizes)
+        {
+            auto* Ptr = Allocator.Allocate(Size, "Size class allocator test", __FILE__, __LINE__);
+            ASSERT_NE(Ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<size_t>(Ptr) % alignof(std::max_align_t), size_t{0});
+            memset(Ptr, i, Size);
+            Allocations.emplace_back(Ptr, Size);
+        }
+    }
+
+    {
+        const auto SizeClass = SizeClassMemoryAllocator::GetSizeClass(100);
+
+        auto Stats = Allocator.GetSizeClassStats(SizeClass);
+        EXPECT_EQ(Stats.BlockSize, size_t{112});
+        EXPECT_EQ(Stats.NumLiveAllocations, size_t{10});
+        EXPECT_EQ(Stats.PeakLiveAllocations, size_t{10});
+        EXPECT_EQ(Stats.LiveBytes, size_t{100 * 10});
+        EXPECT_EQ(Stats.TotalAllocations, size_t{10});
+
+        auto LargeStats = Allocator.GetSizeClassStats(SizeClassMemoryAllocator::LargeAllocationSizeClass);
+        EXPECT_EQ(LargeStats.NumLiveAllocations, size_t{20});
+        EXPECT_EQ(LargeStats.LiveBytes, size_t{(8193 + 65536) * 10});
+    }
+
+    for (size_t i = 0; i < Allocations.size(); ++i)
+    {
+        const auto* Bytes = reinterpret_cast<const Uint8*>(Allocations[i].first);
+        EXPECT_EQ(Bytes[0], static_cast<Uint8>(i / _countof(Sizes)));
+        EXPECT_EQ(Bytes[Allocations[i].second - 1], static_cast<Uint8>(i / _countof(Sizes)));
+        Allocator.Free(Allocations[i].first);
+    }
+
+    for (Uint32 SizeClass = 0; SizeClass <= SizeClassMemoryAllocator::NumSizeClasses; ++SizeClass)
+    {
+        auto Stats = Allocator.GetSizeClassStats(SizeClass);
+        EXPECT_EQ(Stats.NumLiveAllocations, size_t{0});
+        EXPECT_EQ(Stats.LiveBytes, size_t{0});
+    }
+    EXPECT_EQ(Allocator.GetSizeClassStats(SizeClassMemoryAllocator::GetSizeClass(100)).PeakLiveAllocations, size_t{10});
+
+    Allocator.Trim();
+}
+
+TEST(Common_TrackingMemoryAllocator, CallSiteStats)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    // clang-format off
+    const int Line0 = __LINE__; auto* pMem0 = Allocator.Allocate(100, "Call site 0", __FILE__, __LINE__);
+    const int Line1 = __LINE__; auto* pMem1 = Allocator.Allocate(200, "Call site 1", __FILE__, __LINE__);
+    // clang-format on
+    std::vector<void*> Mem2;
+    for (int i = 0; i < 10; ++i)
+        Mem2.push_back(Allocator.Allocate(50, "Call site \"2\"", "Dir\\File.cpp", 42));
+
+    EXPECT_EQ(reinterpret_cast<size_t>(pMem0) % alignof(std::max_align_t), size_t{0});
+    EXPECT_EQ(Allocator.GetLiveBytes(), size_t{100 + 200 + 50 * 10});
+
+    {
+        auto Stats = Allocator.GetCallSiteStats();
+        ASSERT_EQ(Stats.size(), size_t{3});
+
+        // Sorted by live bytes
+        EXPECT_EQ(Stats[0].FileName, "Dir\\File.cpp");
+        EXPECT_EQ(Stats[0].LineNumber, 42);
+        EXPECT_EQ(Stats[0].LiveBytes, size_t{500});
+        EXPECT_EQ(Stats[0].NumLiveAllocations, size_t{10});
+
+        EXPECT_EQ(Stats[1].LineNumber, Line1);
+        EXPECT_EQ(Stats[1].Description, "Call site 1");
+        EXPECT_EQ(Stats[1].LiveBytes, size_t{200});
+
+        EXPECT_EQ(Stats[2].LineNumber, Line0);
+        EXPECT_EQ(Stats[2].LiveBytes, size_t{100});
+    }
+
+    for (size_t i = 0; i < Mem2.size(); i += 2)
+        Allocator.Free(Mem2[i]);
+    Allocator.Free(pMem1);
+
+    {
+        auto Stats = Allocator.GetCallSiteStats();
+        ASSERT_EQ(Stats.size(), size_t{3});
+        EXPECT_EQ(Stats[0].LineNumber, 42);
+        EXPECT_EQ(Stats[0].LiveBytes, size_t{250});
+        EXPECT_EQ(Stats[0].PeakLiveBytes, size_t{500});
+        EXPECT_EQ(Stats[0].TotalAllocations, size_t{10});
+        EXPECT_EQ(Stats[1].LineNumber, Line0);
+        EXPECT_EQ(Stats[2].LineNumber, Line1);
+        EXPECT_EQ(Stats[2].LiveBytes, size_t{0});
+        EXPECT_EQ(Stats[2].PeakLiveBytes, size_t{200});
+    }
+
+    const auto Report = Allocator.GetReport(2);
+    EXPECT_NE(Report.find("Call site 0"), std::string::npos);
+    EXPECT_EQ(Report.find("Call site 1"), std::string::npos);
+
+    const auto JSON = Allocator.GetJSONSnapshot();
+    EXPECT_NE(JSON.find("\"file\":\"Dir\\\\File.cpp\""), std::string::npos) << JSON;
+    EXPECT_NE(JSON.find("\"description\":\"Call site \\\"2\\\"\""), std::string::npos) << JSON;
+    EXPECT_NE(JSON.find("\"liveBytes\":250"), std::string::npos) << JSON;
+
+    Allocator.Free(pMem0);
+    for (size_t i = 1; i < Mem2.size(); i += 2)
+        Allocator.Free(Mem2[i]);
+    EXPECT_EQ(Allocator.GetLiveBytes(), size_t{0});
+}
+
+TEST(Common_TrackingMemoryAllocator, Multithreaded)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr Uint32 NumThreads    = 4;
+    constexpr Uint32 NumIterations = 10000;
+    constexpr Int32  NumCallSites  = 16;
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (auto& Thread : Threads)
+    {
+        Thread = std::thread(
+            [&Allocator]() //
+            {
+                void* Allocations[NumCallSites] = {};
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    const auto CallSite = static_cast<Int32>(i % NumCallSites);
+                    Allocator.Free(Allocations[CallSite]);
+                    Allocations[CallSite] = Allocator.Allocate(16 + CallSite, "Multithreaded tracking test", __FILE__, CallSite);
+                }
+                for (auto* Ptr : Allocations)
+                    Allocator.Free(Ptr);
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    auto Stats = Allocator.GetCallSiteStats();
+    EXPECT_EQ(Stats.size(), size_t{NumCallSites});
+    for (const auto& CallSite : Stats)
+    {
+        EXPECT_EQ(CallSite.LiveBytes, size_t{0});
+        EXPECT_EQ(CallSite.NumLiveAllocations, size_t{0});
+        EXPECT_EQ(CallSite.TotalAllocations, size_t{NumThreads * NumIterations / NumCallSites});
+    }
+}
+
+TEST(Common_TrackingMemoryAllocator, CrossThreadFree)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr Uint32 NumThreads     = 4;
+    constexpr Uint32 NumAllocations = 1000;
+
+    // Every thread allocates its own batch, and the memory is released by another thread
+    std::vector<std::vector<void*>> Allocations(NumThreads);
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread(
+                [&Allocator, &Allocations, t]() //
+                {
+                    for (Uint32 i = 0; i < NumAllocations; ++i)
+                        Allocations[t].push_back(Allocator.Allocate(8, "Cross-thread free test", __FILE__, __LINE__));
+                });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+    EXPECT_EQ(Allocator.GetLiveBytes(), size_t{NumThreads * NumAllocations * 8});
+
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread(
+                [&Allocator, &Allocations, t]() //
+                {
+                    for (auto* Ptr : Allocations[(t + 1) % NumThreads])
+                        Allocator.Free(Ptr);
+                });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+    EXPECT_EQ(Allocator.GetLiveBytes(), size_t{0});
+
+    auto Stats = Allocator.GetCallSiteStats();
+    ASSERT_EQ(Stats.size(), size_t{1});
+    EXPECT_EQ(Stats[0].LiveBytes, size_t{0});
+    EXPECT_EQ(Stats[0].NumLiveAllocations, size_t{0});
+    EXPECT_EQ(Stats[0].TotalAllocations, size_t{NumThreads * NumAllocations});
+    EXPECT_EQ(Stats[0].TotalBytes, size_t{NumThreads * NumAllocations * 8});
+    // All allocations were live at the same time
+    EXPECT_EQ(Stats[0].PeakLiveBytes, size_t{NumThreads * NumAllocations * 8});
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -229,4 +594,115 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_DynamicLinearAllocator, Reset)
+{
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 256};
+
+    std::vector<void*> Allocations;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        auto* Ptr = Allocator.Allocate(40 + i, 8);
+        ASSERT_NE(Ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(Ptr) % 8, size_t{0});
+        memset(Ptr, static_cast<int>(i), 40 + i);
+        Allocations.push_back(Ptr);
+    }
+    // Large allocation that does not fit into the default block size
+    auto* pLarge = Allocator.Allocate(1000, 16);
+    EXPECT_EQ(reinterpret_cast<size_t>(pLarge) % 16, size_t{0});
+    memset(pLarge, 0xFF, 1000);
+
+    for (size_t i = 0; i < Allocations.size(); ++i)
+        EXPECT_EQ(*reinterpret_cast<const Uint8*>(Allocations[i]), static_cast<Uint8>(i));
+
+    const auto Capacity = Allocator.GetCapacity();
+    EXPECT_GE(Capacity, size_t{1000});
+
+    for (int Frame = 0; Frame < 3; ++Frame)
+    {
+        Allocator.Reset();
+        // The same sequence of allocations must reuse the same memory
+        for (size_t i = 0; i < Allocations.size(); ++i)
+            EXPECT_EQ(Allocator.Allocate(40 + i, 8), Allocations[i]);
+        EXPECT_EQ(Allocator.Allocate(1000, 16), pLarge);
+        EXPECT_EQ(Allocator.GetCapacity(), Capacity);
+    }
+
+    Allocator.Free();
+    EXPECT_EQ(Allocator.GetCapacity(), size_t{0});
+    EXPECT_NE(Allocator.Allocate(10, 4), nullptr);
+}
+
+TEST(Common_ScratchAllocatorPool, Borrow)
+{
+    void*  pMem0     = nullptr;
+    size_t Capacity0 = 0;
+    {
+        auto Allocator0 = ScratchAllocatorPool::Borrow();
+        pMem0           = Allocator0->Allocate(100, 16);
+        Capacity0       = Allocator0->GetCapacity();
+
+        {
+            // Nested borrow must get a different allocator
+            auto  Allocator1 = ScratchAllocatorPool::Borrow();
+            void* pMem1      = Allocator1->Allocate(100, 16);
+            EXPECT_NE(&*Allocator0, &*Allocator1);
+            EXPECT_NE(pMem0, pMem1);
+        }
+    }
+
+    {
+        // The allocator is reset and reused
+        auto Allocator0 = ScratchAllocatorPool::Borrow();
+        EXPECT_EQ(Allocator0->GetCapacity(), Capacity0);
+        EXPECT_EQ(Allocator0->Allocate(100, 16), pMem0);
+    }
+
+    std::thread Thread{
+        [pMem0]() {
+            // Other threads use their own allocators
+            auto Allocator = ScratchAllocatorPool::Borrow();
+            EXPECT_NE(Allocator->Allocate(100, 16), pMem0);
+        }};
+    Thread.join();
+}
+
+TEST(Common_ScratchAllocatorPool, CrossThreadReturn)
+{
+    {
+        // The allocator is returned by another thread while the owning thread is alive
+        auto Allocator = ScratchAllocatorPool::Borrow();
+
+        DynamicLinearAllocator* pAllocator = &*Allocator;
+        std::thread             Thread{
+            [&Allocator]() {
+                // Take the ownership so that the allocator is returned by this thread
+                auto ThreadAllocator = std::move(Allocator);
+                EXPECT_NE(ThreadAllocator->Allocate(100, 16), nullptr);
+            }};
+        Thread.join();
+
+        // The owning thread gets the allocator back once it runs out of other allocators
+        std::vector<ScratchAllocatorPool::ScopedAllocator> Allocators;
+        for (size_t i = 0; i < 16 && (Allocators.empty() || &*Allocators.back() != pAllocator); ++i)
+            Allocators.emplace_back(ScratchAllocatorPool::Borrow());
+        EXPECT_EQ(&*Allocators.back(), pAllocator);
+    }
+
+    {
+        // The owning thread exits before the allocator is returned
+        std::vector<ScratchAllocatorPool::ScopedAllocator> Allocators;
+        std::thread                                        Thread{
+            [&Allocators]() {
+                Allocators.emplace_back(ScratchAllocatorPool::Borrow());
+                Allocators.emplace_back(ScratchAllocatorPool::Borrow());
+                EXPECT_NE(Allocators.back()->Allocate(100, 16), nullptr);
+            }};
+        Thread.join();
+
+        EXPECT_NE(Allocators[0]->Allocate(100, 16), nullptr);
+        Allocators.clear();
+    }
+}
+
 } // namespace
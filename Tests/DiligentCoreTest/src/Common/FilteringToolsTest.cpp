@@ -27,8 +27,14 @@
 
 #include "FilteringTools.hpp"
 
+#include <cmath>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "FastRand.hpp"
+#include "Errors.hpp"
+
 using namespace Diligent;
 
 namespace Diligent
@@ -292,4 +298,166 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestGetLinearTexFilterSampleInfoBatch(Uint32 Width, float MinU, float MaxU)
+{
+    FastRandFloat rnd{0, MinU, MaxU};
+    for (size_t Count : {0, 1, 3, 4, 7, 8, 13, 64, 100, 257})
+    {
+        std::vector<float> U(Count);
+        for (auto& u : U)
+        {
+            u = rnd();
+            if (!IsNormalizedCoord)
+            {
+                // Include coordinates that fall exactly on texel centers and edges
+                u = std::round(u * 4.f) * 0.25f;
+            }
+        }
+
+        std::vector<LinearTexFilterSampleInfo> SampleInfo(Count);
+        GetLinearTexFilterSampleInfoBatch<AddressMode, IsNormalizedCoord>(Width, U.data(), Count, SampleInfo.data());
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const auto RefSampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, U[i]);
+            EXPECT_EQ(SampleInfo[i], RefSampleInfo) << "u=" << U[i] << " width=" << Width;
+        }
+    }
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+void TestGetLinearTexFilterSampleInfoBatch(Uint32 Width)
+{
+    const float fWidth = static_cast<float>(Width);
+    TestGetLinearTexFilterSampleInfoBatch<AddressMode, false>(Width, -fWidth * 3.f, fWidth * 3.f);
+    TestGetLinearTexFilterSampleInfoBatch<AddressMode, true>(Width, -3.f, 3.f);
+}
+
+TEST(Common_FilteringTools, GetLinearTexFilterSampleInfoBatch)
+{
+    for (Uint32 Width : {1u, 2u, 3u, 4u, 7u, 128u, 1000u, 4096u})
+    {
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_CLAMP>(Width);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_WRAP>(Width);
+        TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_MIRROR>(Width);
+    }
+
+    const float fWidth = 128.f;
+    TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_UNKNOWN, false>(128, 0.5f, fWidth - 0.5f);
+    TestGetLinearTexFilterSampleInfoBatch<TEXTURE_ADDRESS_UNKNOWN, true>(128, 0.5f / fWidth, 1.f - 0.5f / fWidth);
+}
+
+
+template <TEXTURE_ADDRESS_MODE AddressModeU, TEXTURE_ADDRESS_MODE AddressModeV>
+void TestFilterTexture2DBilinearBatch(Uint32 Width, Uint32 Height)
+{
+    std::vector<float> Data(size_t{Width} * Height);
+    FastRandFloat      rnd{0, 0.f, 1.f};
+    for (auto& f : Data)
+        f = rnd();
+
+    constexpr size_t    Count = 1001;
+    std::vector<float2> UV(Count);
+    for (auto& uv : UV)
+        uv = float2{rnd(), rnd()} * 4.f - float2{2.f, 2.f};
+
+    std::vector<float> Samples(Count);
+    FilterTexture2DBilinearBatch<float, float, AddressModeU, AddressModeV, true>(Width, Height, Data.data(), Width, UV.data(), Count, Samples.data());
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto Ref = FilterTexture2DBilinear<float, float, AddressModeU, AddressModeV, true>(Width, Height, Data.data(), Width, UV[i].x, UV[i].y);
+        EXPECT_EQ(Samples[i], Ref) << "u=" << UV[i].x << " v=" << UV[i].y;
+    }
+
+    for (auto& uv : UV)
+        uv *= float2{static_cast<float>(Width), static_cast<float>(Height)};
+
+    FilterTexture2DBilinearBatch<float, float, AddressModeU, AddressModeV, false>(Width, Height, Data.data(), Width, UV.data(), Count, Samples.data());
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto Ref = FilterTexture2DBilinear<float, float, AddressModeU, AddressModeV, false>(Width, Height, Data.data(), Width, UV[i].x, UV[i].y);
+        EXPECT_EQ(Samples[i], Ref) << "u=" << UV[i].x << " v=" << UV[i].y;
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearBatch)
+{
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(17, 33);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP>(17, 33);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_MIRROR>(17, 33);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_CLAMP>(64, 1);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_WRAP>(1, 64);
+}
+
+
+// Creates a 2D mip chain where every texel of mip level L has value L
+void CreateConstantMipChain(Uint32 Width, Uint32 Height, std::vector<std::vector<float>>& Data, std::vector<TexFilterMipLevelData<float>>& Mips)
+{
+    for (Uint32 Mip = 0; Width > 0 || Height > 0; ++Mip)
+    {
+        const Uint32 MipWidth  = std::max(Width, 1u);
+        const Uint32 MipHeight = std::max(Height, 1u);
+        Data.emplace_back(size_t{MipWidth} * MipHeight, static_cast<float>(Mip));
+
+        TexFilterMipLevelData<float> Level;
+        Level.pData  = Data.back().data();
+        Level.Width  = MipWidth;
+        Level.Height = MipHeight;
+        Level.Stride = MipWidth;
+        Mips.push_back(Level);
+
+        Width /= 2;
+        Height /= 2;
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DTrilinear)
+{
+    std::vector<std::vector<float>>           Data;
+    std::vector<TexFilterMipLevelData<float>> Mips;
+    CreateConstantMipChain(16, 8, Data, Mips);
+    ASSERT_EQ(Mips.size(), size_t{5});
+
+    const auto NumMips = static_cast<Uint32>(Mips.size());
+    for (float Lod : {-1.f, 0.f, 0.25f, 1.f, 1.5f, 3.75f, 4.f, 10.f})
+    {
+        const auto Val = FilterTexture2DTrilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_CLAMP>(Mips.data(), NumMips, 0.3f, -0.7f, Lod);
+        EXPECT_EQ(Val, clamp(Lod, 0.f, 4.f)) << "Lod=" << Lod;
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DTrilinearBatch)
+{
+    std::vector<std::vector<float>>           Data;
+    std::vector<TexFilterMipLevelData<float>> Mips;
+    CreateConstantMipChain(37, 19, Data, Mips);
+
+    FastRandFloat rnd{0, 0.f, 1.f};
+    for (auto& Level : Data)
+    {
+        for (auto& f : Level)
+            f = rnd();
+    }
+
+    constexpr size_t    Count = 555;
+    std::vector<float2> UV(Count);
+    std::vector<float>  Lod(Count);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        UV[i]  = float2{rnd(), rnd()} * 3.f - float2{1.f, 1.f};
+        Lod[i] = rnd() * 8.f - 1.f;
+    }
+
+    const auto NumMips = static_cast<Uint32>(Mips.size());
+
+    std::vector<float> Samples(Count);
+    FilterTexture2DTrilinearBatch<float, float, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_WRAP>(Mips.data(), NumMips, UV.data(), Lod.data(), Count, Samples.data());
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto Ref = FilterTexture2DTrilinear<float, float, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_WRAP>(Mips.data(), NumMips, UV[i].x, UV[i].y, Lod[i]);
+        EXPECT_EQ(Samples[i], Ref) << "u=" << UV[i].x << " v=" << UV[i].y << " lod=" << Lod[i];
+    }
+}
+
 } // namespace
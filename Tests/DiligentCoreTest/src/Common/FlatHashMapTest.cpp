@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+#include "HashUtils.hpp"
+#include "STDAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_FlatHashMap, InsertFindErase)
+{
+    FlatHashMap<int, int> Map;
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.find(0), Map.end());
+    EXPECT_EQ(Map.erase(0), size_t{0});
+
+    constexpr int NumElements = 1000;
+    for (int i = 0; i < NumElements; ++i)
+    {
+        auto Res = Map.emplace(i, i * 10);
+        EXPECT_TRUE(Res.second);
+        EXPECT_EQ(Res.first->first, i);
+        EXPECT_EQ(Res.first->second, i * 10);
+    }
+    EXPECT_EQ(Map.size(), size_t{NumElements});
+    EXPECT_GE(Map.capacity(), Map.size());
+
+    auto Res = Map.insert(std::make_pair(5, 0));
+    EXPECT_FALSE(Res.second);
+    EXPECT_EQ(Res.first->second, 50);
+
+    for (int i = 0; i < NumElements; ++i)
+    {
+        auto It = Map.find(i);
+        ASSERT_NE(It, Map.end());
+        EXPECT_EQ(It->second, i * 10);
+    }
+    EXPECT_EQ(Map.count(NumElements), size_t{0});
+
+    size_t NumVisited = 0;
+    for (const auto& Elem : Map)
+    {
+        EXPECT_EQ(Elem.second, Elem.first * 10);
+        ++NumVisited;
+    }
+    EXPECT_EQ(NumVisited, Map.size());
+
+    for (int i = 0; i < NumElements; i += 2)
+        EXPECT_EQ(Map.erase(i), size_t{1});
+    EXPECT_EQ(Map.size(), size_t{NumElements / 2});
+    for (int i = 0; i < NumElements; ++i)
+        EXPECT_EQ(Map.count(i), (i % 2) != 0 ? size_t{1} : size_t{0});
+
+    Map[1] = -1;
+    EXPECT_EQ(Map.find(1)->second, -1);
+    EXPECT_EQ(Map[NumElements], 0);
+    EXPECT_EQ(Map.size(), size_t{NumElements / 2 + 1});
+
+    const auto Capacity = Map.capacity();
+    Map.clear();
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.capacity(), Capacity);
+}
+
+TEST(Common_FlatHashMap, EraseWhileIterating)
+{
+    FlatHashMap<int, int> Map;
+    for (int i = 0; i < 100; ++i)
+        Map[i] = i;
+
+    for (auto It = Map.begin(); It != Map.end();)
+    {
+        if (It->first % 3 == 0)
+            It = Map.erase(It);
+        else
+            ++It;
+    }
+
+    EXPECT_EQ(Map.size(), size_t{66});
+    for (const auto& Elem : Map)
+        EXPECT_NE(Elem.first % 3, 0);
+}
+
+TEST(Common_FlatHashMap, RandomOperations)
+{
+    FlatHashMap<int, int>        Map;
+    std::unordered_map<int, int> RefMap;
+
+    FastRandInt Rnd{0, 0, 4095};
+    for (int i = 0; i < 100000; ++i)
+    {
+        const auto Key = Rnd();
+        switch (Rnd() % 3)
+        {
+            case 0:
+                EXPECT_EQ(Map.emplace(Key, i).second, RefMap.emplace(Key, i).second);
+                break;
+
+            case 1:
+                EXPECT_EQ(Map.erase(Key), RefMap.erase(Key));
+                break;
+
+            case 2:
+            {
+                auto It    = Map.find(Key);
+                auto RefIt = RefMap.find(Key);
+                ASSERT_EQ(It == Map.end(), RefIt == RefMap.end());
+                if (RefIt != RefMap.end())
+                {
+                    EXPECT_EQ(It->second, RefIt->second);
+                }
+                break;
+            }
+        }
+    }
+
+    ASSERT_EQ(Map.size(), RefMap.size());
+    for (const auto& Elem : RefMap)
+    {
+        auto It = Map.find(Elem.first);
+        ASSERT_NE(It, Map.end());
+        EXPECT_EQ(It->second, Elem.second);
+    }
+}
+
+TEST(Common_FlatHashMap, StringKeys)
+{
+    FlatHashMap<HashMapStringKey, int, HashMapStringKey::Hasher, HashMapStringKey::EqualTo> Map;
+
+    std::vector<std::string> Strings;
+    for (int i = 0; i < 256; ++i)
+        Strings.emplace_back("String " + std::to_string(i));
+
+    for (size_t i = 0; i < Strings.size(); ++i)
+        EXPECT_TRUE(Map.emplace(HashMapStringKey{Strings[i]}, static_cast<int>(i)).second);
+
+    // Keys own copies of the strings, so the lookups below use different pointers
+    for (size_t i = 0; i < Strings.size(); ++i)
+    {
+        const std::string Str = Strings[i];
+
+        auto It = Map.find(Str.c_str());
+        ASSERT_NE(It, Map.end());
+        EXPECT_EQ(It->second, static_cast<int>(i));
+        EXPECT_STREQ(It->first.GetStr(), Str.c_str());
+        EXPECT_NE(It->first.GetStr(), Str.c_str());
+    }
+    EXPECT_EQ(Map.find("Missing string"), Map.end());
+
+    EXPECT_EQ(Map.erase("String 10"), size_t{1});
+    EXPECT_EQ(Map.count("String 10"), size_t{0});
+    EXPECT_EQ(Map.size(), Strings.size() - 1);
+}
+
+TEST(Common_FlatHashMap, RawMemoryAllocator)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+    {
+        using ElemType = std::pair<Uint64, std::string>;
+        FlatHashMap<Uint64, std::string, std::hash<Uint64>, std::equal_to<Uint64>, STDAllocatorRawMem<ElemType>> Map{
+            STD_ALLOCATOR_RAW_MEM(ElemType, Allocator, "Allocator for FlatHashMap<Uint64, std::string>")};
+
+        for (Uint64 i = 0; i < 100; ++i)
+            Map.emplace(i, std::to_string(i));
+        EXPECT_GT(Allocator.GetLiveBytes(), size_t{0});
+
+        for (Uint64 i = 0; i < 100; ++i)
+            EXPECT_EQ(Map[i], std::to_string(i));
+    }
+    EXPECT_EQ(Allocator.GetLiveBytes(), size_t{0});
+}
+
+} // namespace
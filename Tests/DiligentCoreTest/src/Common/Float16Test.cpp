@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "Float16.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_Float16, RoundTrip)
+{
+    // Every finite half value must survive the conversion to float and back
+    for (Uint32 h = 0; h <= 0xFFFF; ++h)
+    {
+        const auto f = Float16ToFloat32(static_cast<Uint16>(h));
+        if (std::isnan(f))
+        {
+            EXPECT_TRUE(std::isnan(Float16ToFloat32(Float32ToFloat16(f))));
+            continue;
+        }
+        EXPECT_EQ(Float32ToFloat16(f), h) << std::hex << h;
+    }
+}
+
+TEST(Common_Float16, Conversion)
+{
+    EXPECT_EQ(Float32ToFloat16(0.f), Uint16{0});
+    EXPECT_EQ(Float32ToFloat16(-0.f), Uint16{0x8000});
+    EXPECT_EQ(Float32ToFloat16(1.f), Uint16{0x3C00});
+    EXPECT_EQ(Float32ToFloat16(-2.f), Uint16{0xC000});
+    EXPECT_EQ(Float32ToFloat16(65504.f), Uint16{0x7BFF});
+    EXPECT_EQ(Float32ToFloat16(1e6f), Uint16{0x7C00});
+    EXPECT_EQ(Float32ToFloat16(std::numeric_limits<float>::infinity()), Uint16{0x7C00});
+    // Smallest denormal
+    EXPECT_EQ(Float32ToFloat16(5.9604645e-8f), Uint16{0x0001});
+    // 1 + 2^-11 is halfway between 1 and the next half value and rounds to even
+    EXPECT_EQ(Float32ToFloat16(1.f + 1.f / 2048.f), Uint16{0x3C00});
+    EXPECT_EQ(Float32ToFloat16(1.f + 3.f / 2048.f), Uint16{0x3C02});
+
+    EXPECT_EQ(Float16ToFloat32(0x3555), 0.333251953125f);
+    EXPECT_EQ(Float16ToFloat32(0x0001), 5.9604645e-8f);
+}
+
+TEST(Common_Float16, R11G11B10)
+{
+    float R = 0, G = 0, B = 0;
+    UnpackR11G11B10Float(PackR11G11B10Float(1.f, 0.5f, 2.f), R, G, B);
+    EXPECT_EQ(R, 1.f);
+    EXPECT_EQ(G, 0.5f);
+    EXPECT_EQ(B, 2.f);
+
+    // Negative values are not representable and are clamped to zero
+    UnpackR11G11B10Float(PackR11G11B10Float(-1.f, 65024.f, 1e10f), R, G, B);
+    EXPECT_EQ(R, 0.f);
+    EXPECT_EQ(G, 65024.f);
+    EXPECT_TRUE(std::isinf(B));
+
+    // Every 11-bit value must survive the round trip
+    for (Uint32 v = 0; v < (1u << 11); ++v)
+    {
+        UnpackR11G11B10Float(v, R, G, B);
+        if (std::isnan(R))
+            continue;
+        EXPECT_EQ(PackR11G11B10Float(R, 0, 0), v);
+    }
+}
+
+} // namespace
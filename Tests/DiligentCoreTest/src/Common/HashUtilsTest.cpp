@@ -26,8 +26,13 @@
  */
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <algorithm>
 
 #include "HashUtils.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -116,4 +121,127 @@ TEST(Common_HashUtils, HashMapStringKey)
     }
 }
 
+TEST(Common_HashUtils, HashBytes)
+{
+    std::vector<Uint8> Data(256);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 37 + 11);
+
+    // Every length must produce a distinct hash, and the hash must be deterministic
+    std::unordered_set<Uint64> Hashes;
+    for (size_t Size = 0; Size <= Data.size(); ++Size)
+    {
+        const auto Hash = HashBytes(Data.data(), Size);
+        EXPECT_EQ(Hash, HashBytes(Data.data(), Size));
+        EXPECT_TRUE(Hashes.insert(Hash).second) << "Size: " << Size;
+        if (Size > 0)
+        {
+            EXPECT_NE(Hash, HashBytes(Data.data(), Size, 1)) << "Size: " << Size;
+        }
+    }
+
+    // Changing any byte must change the hash
+    const auto RefHash = HashBytes(Data.data(), Data.size());
+    for (size_t i = 0; i < Data.size(); ++i)
+    {
+        Data[i] ^= 1;
+        EXPECT_NE(HashBytes(Data.data(), Data.size()), RefHash) << "Byte: " << i;
+        Data[i] ^= 1;
+    }
+}
+
+TEST(Common_HashUtils, StreamingHasher)
+{
+    StreamingHasher Hasher1;
+    Hasher1.Update(1, 2.5f, Uint64{3}).UpdateStr("Test");
+
+    StreamingHasher Hasher2;
+    Hasher2.Update(1).Update(2.5f).Update(Uint64{3}).UpdateBytes("Test", 4);
+    EXPECT_EQ(Hasher1.Digest(), Hasher2.Digest());
+
+    EXPECT_NE(StreamingHasher{}.Update(1, 2).Digest(), StreamingHasher{}.Update(2, 1).Digest());
+    EXPECT_EQ(StreamingHasher{}.Update(0.f).Digest(), StreamingHasher{}.Update(-0.f).Digest());
+    EXPECT_EQ(ComputeHash(0.0), ComputeHash(-0.0));
+
+    EXPECT_EQ(CStringHash<Char>{}("Test String"), CStringHash<Char>{}(std::string{"Test String"}.c_str()));
+    EXPECT_NE(CStringHash<Char>{}("Test String 1"), CStringHash<Char>{}("Test String 2"));
+}
+
+// Returns the maximum number of keys that fall into one of 2^Bits buckets selected by the lower hash bits
+size_t GetMaxBucketLoad(const std::vector<size_t>& Hashes, Uint32 Bits)
+{
+    std::vector<size_t> Buckets(size_t{1} << Bits);
+    for (auto Hash : Hashes)
+        ++Buckets[Hash & (Buckets.size() - 1)];
+    return *std::max_element(Buckets.begin(), Buckets.end());
+}
+
+TEST(Common_HashUtils, CollisionQuality)
+{
+    constexpr Uint32 NumKeys    = 1 << 16;
+    constexpr Uint32 BucketBits = 10;
+    // Expected bucket load is 64; with a uniform distribution the maximum load
+    // exceeds twice the expectation with negligible probability.
+    constexpr size_t MaxBucketLoad = 2 * (NumKeys >> BucketBits);
+
+    {
+        // Small integer pairs, typical for descriptor fields
+        std::vector<size_t> Hashes;
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            Hashes.push_back(ComputeHash(i & 0xFF, i >> 8));
+
+        EXPECT_EQ(std::unordered_set<size_t>(Hashes.begin(), Hashes.end()).size(), Hashes.size());
+        EXPECT_LE(GetMaxBucketLoad(Hashes, BucketBits), MaxBucketLoad);
+    }
+
+    {
+        // Pointer-like values with zero low bits
+        std::vector<size_t> Hashes;
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            Hashes.push_back(ComputeHash(reinterpret_cast<void*>(size_t{i} << 8)));
+
+        EXPECT_EQ(std::unordered_set<size_t>(Hashes.begin(), Hashes.end()).size(), Hashes.size());
+        EXPECT_LE(GetMaxBucketLoad(Hashes, BucketBits), MaxBucketLoad);
+    }
+
+    {
+        // Strings that only differ in a few characters
+        std::vector<size_t> Hashes;
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            Hashes.push_back(CStringHash<Char>{}(("g_Texture" + std::to_string(i)).c_str()));
+
+        EXPECT_EQ(std::unordered_set<size_t>(Hashes.begin(), Hashes.end()).size(), Hashes.size());
+        EXPECT_LE(GetMaxBucketLoad(Hashes, BucketBits), MaxBucketLoad);
+    }
+
+    {
+        // Flipping any input bit should flip about half of the output bits
+        FastRand Rnd{0};
+
+        constexpr Uint32 NumSamples   = 256;
+        size_t           NumFlipped   = 0;
+        size_t           NumBitsTotal = 0;
+        for (Uint32 s = 0; s < NumSamples; ++s)
+        {
+            Uint64 Val = 0;
+            for (int i = 0; i < 4; ++i)
+                Val = (Val << 16) | Rnd();
+
+            const auto RefHash = HashBytes(&Val, sizeof(Val));
+            for (Uint32 bit = 0; bit < 64; ++bit)
+            {
+                const auto FlippedVal = Val ^ (Uint64{1} << bit);
+
+                auto Diff = HashBytes(&FlippedVal, sizeof(FlippedVal)) ^ RefHash;
+                for (; Diff != 0; Diff &= Diff - 1)
+                    ++NumFlipped;
+                NumBitsTotal += 64;
+            }
+        }
+        const auto FlipRatio = static_cast<double>(NumFlipped) / static_cast<double>(NumBitsTotal);
+        EXPECT_GT(FlipRatio, 0.45);
+        EXPECT_LT(FlipRatio, 0.55);
+    }
+}
+
 } // namespace
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <cstring>
+#include <string>
+
+#include "MappedFileStream.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TempFile
+{
+public:
+    TempFile(const char* Name, const std::string& Content) :
+        m_Name{Name}
+    {
+        FileWrapper File{Name, EFileAccessMode::Overwrite};
+        CFile*      pFile = File;
+        EXPECT_NE(pFile, nullptr);
+        if (pFile != nullptr && !Content.empty())
+            pFile->Write(Content.data(), Content.size());
+    }
+
+    ~TempFile()
+    {
+        FileSystem::DeleteFile(m_Name.c_str());
+    }
+
+    const char* GetName() const { return m_Name.c_str(); }
+
+private:
+    const std::string m_Name;
+};
+
+std::string GetTestContent()
+{
+    std::string Content;
+    for (int i = 0; i < 4096; ++i)
+        Content += "float4 Value" + std::to_string(i) + ";\n";
+    return Content;
+}
+
+TEST(Common_MappedFileStream, Read)
+{
+    const auto Content = GetTestContent();
+    TempFile   File{"MappedFileStreamTest.txt", Content};
+
+    RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(File.GetName())};
+    ASSERT_TRUE(pStream->IsValid());
+    EXPECT_EQ(pStream->GetSize(), Content.size());
+
+    char Header[16] = {};
+    EXPECT_TRUE(pStream->Read(Header, sizeof(Header)));
+    EXPECT_EQ(memcmp(Header, Content.data(), sizeof(Header)), 0);
+
+    RefCntAutoPtr<IDataBlob> pRest{MakeNewRCObj<DataBlobImpl>()(0)};
+    pStream->ReadBlob(pRest);
+    ASSERT_EQ(pRest->GetSize(), Content.size() - sizeof(Header));
+    EXPECT_EQ(memcmp(pRest->GetConstDataPtr(), Content.data() + sizeof(Header), pRest->GetSize()), 0);
+
+    // The end of the stream has been reached
+    EXPECT_FALSE(pStream->Read(Header, 1));
+}
+
+TEST(Common_MappedFileStream, ReadStreamData)
+{
+    const auto Content = GetTestContent();
+    TempFile   File{"MappedFileStreamTest.txt", Content};
+
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MappedFileStream>()(File.GetName())};
+        ASSERT_TRUE(pStream);
+
+        auto pData = ReadStreamData(pStream);
+        ASSERT_TRUE(pData);
+        ASSERT_EQ(pData->GetSize(), Content.size());
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Content.data(), Content.size()), 0);
+
+        // The data must be provided by the mapped file blob without copying
+        EXPECT_NE(dynamic_cast<MappedFileBlob*>(pData.RawPtr()), nullptr);
+#if PLATFORM_LINUX
+        EXPECT_TRUE(static_cast<MappedFileBlob*>(pData.RawPtr())->IsMapped());
+#endif
+
+        // The blob remains valid after the stream is released
+        pStream.Release();
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Content.data(), Content.size()), 0);
+
+        // Modifications of the private mapping must not be written to the file
+        memset(pData->GetDataPtr(), '#', 16);
+    }
+
+    {
+        RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(File.GetName(), EMappedFileAccessHint::Random)};
+        ASSERT_TRUE(pStream->IsValid());
+
+        char Header[16] = {};
+        EXPECT_TRUE(pStream->Read(Header, sizeof(Header)));
+        EXPECT_EQ(memcmp(Header, Content.data(), sizeof(Header)), 0);
+
+        // The stream is not at the beginning, so the rest of the data is copied
+        auto pData = ReadStreamData(pStream);
+        ASSERT_EQ(pData->GetSize(), Content.size() - sizeof(Header));
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Content.data() + sizeof(Header), pData->GetSize()), 0);
+    }
+
+    {
+        // Other streams are read into a new data blob
+        RefCntAutoPtr<IDataBlob> pSrcData{MakeNewRCObj<DataBlobImpl>()(Content.size())};
+        memcpy(pSrcData->GetDataPtr(), Content.data(), Content.size());
+
+        RefCntAutoPtr<IFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pSrcData)};
+
+        auto pData = ReadStreamData(pMemStream);
+        ASSERT_EQ(pData->GetSize(), Content.size());
+        EXPECT_NE(pData.RawPtr(), pSrcData.RawPtr());
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Content.data(), Content.size()), 0);
+    }
+}
+
+TEST(Common_MappedFileBlob, Resize)
+{
+    const auto Content = GetTestContent();
+    TempFile   File{"MappedFileStreamTest.txt", Content};
+
+    RefCntAutoPtr<MappedFileBlob> pBlob{MakeNewRCObj<MappedFileBlob>()(File.GetName())};
+    ASSERT_TRUE(pBlob->IsValid());
+    ASSERT_EQ(pBlob->GetSize(), Content.size());
+
+    pBlob->Resize(Content.size() + 16);
+    EXPECT_FALSE(pBlob->IsMapped());
+    ASSERT_EQ(pBlob->GetSize(), Content.size() + 16);
+    EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Content.data(), Content.size()), 0);
+
+    pBlob->Resize(10);
+    ASSERT_EQ(pBlob->GetSize(), size_t{10});
+    EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Content.data(), 10), 0);
+}
+
+TEST(Common_MappedFileStream, EmptyAndMissingFiles)
+{
+    {
+        TempFile File{"MappedFileStreamTest_Empty.txt", ""};
+
+        RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(File.GetName())};
+        EXPECT_TRUE(pStream->IsValid());
+        EXPECT_EQ(pStream->GetSize(), size_t{0});
+        EXPECT_EQ(ReadStreamData(pStream)->GetSize(), size_t{0});
+    }
+
+    {
+        RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()("MappedFileStreamTest_Missing.txt")};
+        EXPECT_FALSE(pStream->IsValid());
+        EXPECT_EQ(pStream->GetSize(), size_t{0});
+    }
+}
+
+} // namespace
@@ -26,10 +26,16 @@
  */
 
 #include <climits>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "SIMDHelpers.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+#include "Errors.hpp"
 
 #include "gtest/gtest.h"
 
@@ -2156,4 +2162,318 @@ TEST(Common_AdvancedMath, CheckBox2DBox2DOverlap)
     // clang-format on
 }
 
+
+TEST(Common_AdvancedMath, BoundBoxSoA)
+{
+    BoundBoxSoA Boxes;
+    EXPECT_EQ(Boxes.GetCount(), size_t{0});
+
+    for (int i = 0; i < 20; ++i)
+    {
+        const float f = static_cast<float>(i);
+        Boxes.PushBack(BoundBox{float3{f, f + 1, f + 2}, float3{f + 3, f + 4, f + 5}});
+    }
+    ASSERT_EQ(Boxes.GetCount(), size_t{20});
+    for (int i = 0; i < 20; ++i)
+    {
+        const float f   = static_cast<float>(i);
+        const auto  Box = Boxes.Get(i);
+        EXPECT_EQ(Box.Min, float3(f, f + 1, f + 2));
+        EXPECT_EQ(Box.Max, float3(f + 3, f + 4, f + 5));
+        EXPECT_EQ(Boxes.GetMin(1)[i], f + 1);
+        EXPECT_EQ(Boxes.GetMax(2)[i], f + 5);
+    }
+
+    Boxes.Set(7, BoundBox{float3{-1, -2, -3}, float3{1, 2, 3}});
+    EXPECT_EQ(Boxes.Get(7).Min, float3(-1, -2, -3));
+    EXPECT_EQ(Boxes.Get(7).Max, float3(1, 2, 3));
+
+    Boxes.Resize(3);
+    EXPECT_EQ(Boxes.GetCount(), size_t{3});
+    EXPECT_EQ(Boxes.Get(2).Min, float3(2, 3, 4));
+
+    Boxes.Clear();
+    EXPECT_EQ(Boxes.GetCount(), size_t{0});
+}
+
+ViewFrustum GetTestViewFrustum()
+{
+    const auto View = float4x4::RotationY(0.3f) * float4x4::RotationX(-0.2f) * float4x4::Translation(5, -3, 40);
+    const auto Proj = float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 100.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(View * Proj, Frustum, false);
+    return Frustum;
+}
+
+std::vector<BoundBox> GetRandomBoxes(size_t Count)
+{
+    FastRandFloat rnd{0, -80.f, 80.f};
+    FastRandFloat rnd_size{1, 0.f, 15.f};
+
+    std::vector<BoundBox> Boxes(Count);
+    for (auto& Box : Boxes)
+    {
+        Box.Min = float3{rnd(), rnd(), rnd()};
+        Box.Max = Box.Min + float3{rnd_size(), rnd_size(), rnd_size()};
+    }
+    return Boxes;
+}
+
+TEST(Common_AdvancedMath, GetBoxVisibilityBatch)
+{
+    const auto Frustum = GetTestViewFrustum();
+    for (size_t Count : {0, 1, 3, 4, 7, 8, 16, 17, 33, 1000})
+    {
+        const auto        Boxes = GetRandomBoxes(Count);
+        const BoundBoxSoA BoxesSoA{Boxes.data(), Boxes.size()};
+
+        for (Uint32 Flags = 0; Flags <= FRUSTUM_PLANE_FLAG_FULL_FRUSTUM; ++Flags)
+        {
+            const auto PlaneFlags = static_cast<FRUSTUM_PLANE_FLAGS>(Flags);
+
+            std::vector<BoxVisibility> Visibility(Count);
+            GetBoxVisibility(Frustum, BoxesSoA, Visibility.data(), PlaneFlags);
+
+            std::vector<Uint32> RefVisibleIndices;
+            for (size_t i = 0; i < Count; ++i)
+            {
+                const auto RefVisibility = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags);
+                EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i << ", flags " << Flags;
+                if (RefVisibility != BoxVisibility::Invisible)
+                    RefVisibleIndices.push_back(static_cast<Uint32>(i));
+            }
+
+            std::vector<Uint32> VisibleIndices(Count);
+            VisibleIndices.resize(CullBoundBoxes(Frustum, BoxesSoA, VisibleIndices.data(), PlaneFlags));
+            EXPECT_EQ(VisibleIndices, RefVisibleIndices) << "Flags " << Flags;
+        }
+    }
+}
+
+TEST(Common_AdvancedMath, CullBoundBoxesParallel)
+{
+    const auto Frustum = GetTestViewFrustum();
+
+    ThreadPool Pool{3};
+    for (size_t Count : {0, 100, 8192, 8193, 100000})
+    {
+        const auto        Boxes = GetRandomBoxes(Count);
+        const BoundBoxSoA BoxesSoA{Boxes.data(), Boxes.size()};
+
+        for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_LEFT_PLANE})
+        {
+            std::vector<Uint32> RefVisibleIndices(Count);
+            RefVisibleIndices.resize(CullBoundBoxes(Frustum, BoxesSoA, RefVisibleIndices.data(), PlaneFlags));
+
+            std::vector<Uint32> VisibleIndices(Count);
+            VisibleIndices.resize(CullBoundBoxes(Frustum, BoxesSoA, VisibleIndices.data(), Pool, PlaneFlags));
+            EXPECT_EQ(VisibleIndices, RefVisibleIndices) << "Count " << Count << ", flags " << PlaneFlags;
+        }
+    }
+}
+
+// Reference implementations that follow the operation order of the generic templates
+
+float4x4 RefMatrixMul(const float4x4& m1, const float4x4& m2)
+{
+    float4x4 mOut;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 4; k++)
+                mOut.m[i][j] += m1.m[i][k] * m2.m[k][j];
+        }
+    }
+    return mOut;
+}
+
+float4 RefVectorMatrixMul(const float4& v, const float4x4& m)
+{
+    float4 out;
+    for (int j = 0; j < 4; ++j)
+        out[j] = v.x * m[0][j] + v.y * m[1][j] + v.z * m[2][j] + v.w * m[3][j];
+    return out;
+}
+
+float4 RefMatrixVectorMul(const float4x4& m, const float4& v)
+{
+    float4 out;
+    for (int i = 0; i < 4; ++i)
+        out[i] = m[i][0] * v.x + m[i][1] * v.y + m[i][2] * v.z + m[i][3] * v.w;
+    return out;
+}
+
+float3 RefTransformPoint(const float3& p, const float4x4& m)
+{
+    const float4 p4 = RefVectorMatrixMul(float4{p, 1}, m);
+    return float3{p4.x / p4.w, p4.y / p4.w, p4.z / p4.w};
+}
+
+Uint32 GetULPDistance(float a, float b)
+{
+    if (a == b)
+        return 0; // Also handles +0 == -0
+
+    Int32 ia, ib;
+    memcpy(&ia, &a, sizeof(float));
+    memcpy(&ib, &b, sizeof(float));
+    // Map the sign-magnitude representation to a monotonic integer sequence
+    if (ia < 0)
+        ia = INT_MIN - ia;
+    if (ib < 0)
+        ib = INT_MIN - ib;
+    return static_cast<Uint32>(std::abs(static_cast<Int64>(ia) - static_cast<Int64>(ib)));
+}
+
+// Multiplications and additions are performed in the same order as in the reference,
+// so the results are bitwise identical unless the compiler fuses the scalar operations.
+#if DILIGENT_SSE2_SUPPORTED
+static constexpr Uint32 SIMDMathMaxULP = 0;
+#else
+static constexpr Uint32 SIMDMathMaxULP = 2;
+#endif
+
+template <typename VectorType>
+void CheckULP(const VectorType& Val, const VectorType& Ref, Uint32 MaxULP)
+{
+    for (size_t i = 0; i < sizeof(VectorType) / sizeof(float); ++i)
+        EXPECT_LE(GetULPDistance(Val[i], Ref[i]), MaxULP) << Val << " vs " << Ref;
+}
+
+float4x4 GetRandomMatrix(FastRandFloat& rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 16; ++i)
+        m.Data()[i] = rnd();
+    return m;
+}
+
+TEST(Common_BasicMath, SIMDMatrixMultiply)
+{
+    // Positive values to avoid cancellation when the compiler fuses the scalar operations
+    FastRandFloat rnd{0, 0.5f, 2.f};
+    for (int test = 0; test < 1000; ++test)
+    {
+        const auto m1 = GetRandomMatrix(rnd);
+        const auto m2 = GetRandomMatrix(rnd);
+
+        const auto m   = m1 * m2;
+        const auto ref = RefMatrixMul(m1, m2);
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                EXPECT_LE(GetULPDistance(m[r][c], ref[r][c]), SIMDMathMaxULP) << m[r][c] << " vs " << ref[r][c];
+        }
+
+        const auto v = float4{rnd(), rnd(), rnd(), rnd()};
+        CheckULP(v * m1, RefVectorMatrixMul(v, m1), SIMDMathMaxULP);
+        CheckULP(m1 * v, RefMatrixVectorMul(m1, v), SIMDMathMaxULP);
+    }
+
+    // Signed zeros must match the generic implementation
+    {
+        const float4x4 m1{-0.f, 0.f, -0.f, 0.f,
+                          -1.f, 1.f, -1.f, 1.f,
+                          -0.f, -0.f, -0.f, -0.f,
+                          0.f, 0.f, 0.f, 0.f};
+        const float4x4 m2 = float4x4::Identity();
+
+        const auto m   = m1 * m2;
+        const auto ref = RefMatrixMul(m1, m2);
+        EXPECT_EQ(memcmp(&m, &ref, sizeof(m)), 0);
+    }
+}
+
+TEST(Common_BasicMath, SIMDMatrixInverse)
+{
+    FastRandFloat rnd{0, -1.f, 1.f};
+
+    // The specialization uses a different algorithm than the generic implementation, so both are
+    // compared with the inverse computed in double precision. Projection matrices with large far/near
+    // ratio are poorly conditioned and lose more precision than affine transforms.
+    // The limits are slightly above the maximum errors of this test (affine, projection).
+#if DILIGENT_SSE2_SUPPORTED
+    constexpr Uint32 ULPLimit[2] = {5, 60}; // Measured: 4, 56
+#else
+    // Inverse() is not vectorized and uses the generic implementation
+    constexpr Uint32 ULPLimit[2] = {5, 68}; // Measured: 4, 64
+#endif
+    for (int test = 0; test < 1000; ++test)
+    {
+        const int IsProjection = test % 2;
+
+        // Typical transform matrices
+        float4x4 m = float4x4::Scale(1.f + rnd() * 0.5f, 1.f + rnd() * 0.5f, 1.f + rnd() * 0.5f) *
+            float4x4::RotationX(rnd() * PI_F) * float4x4::RotationY(rnd() * PI_F) * float4x4::RotationZ(rnd() * PI_F) *
+            float4x4::Translation(rnd() * 10.f, rnd() * 10.f, rnd() * 10.f);
+        if (IsProjection)
+            m *= float4x4::Projection(PI_F / 4.f + rnd() * 0.5f, 1.f + rnd() * 0.5f, 0.5f, 1000.f, test % 4 == 1);
+
+        double4x4 md;
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                md.m[r][c] = m.m[r][c];
+        }
+
+        const auto inv = m.Inverse();
+        const auto ref = md.Inverse();
+
+        for (int r = 0; r < 4; ++r)
+        {
+            // Elements that are small compared to the other elements of the row accumulate
+            // the absolute error of the whole row, so the error is measured in float ULPs of
+            // the largest element of the row.
+            double RowMaxAbs = 0;
+            for (int c = 0; c < 4; ++c)
+                RowMaxAbs = std::max(RowMaxAbs, std::abs(ref[r][c]));
+            const auto RowMaxAbsF = static_cast<float>(RowMaxAbs);
+            const auto RowULP     = static_cast<double>(std::nextafter(RowMaxAbsF, FLT_MAX) - RowMaxAbsF);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                const auto ULP = static_cast<Uint32>(std::ceil(std::abs(inv[r][c] - ref[r][c]) / RowULP));
+                EXPECT_LE(ULP, ULPLimit[IsProjection]) << "Element [" << r << "][" << c << "]: " << inv[r][c] << " vs " << ref[r][c];
+            }
+        }
+    }
+}
+
+TEST(Common_BasicMath, TransformPoints)
+{
+    FastRandFloat rnd{0, -10.f, 10.f};
+
+    const auto m = float4x4::RotationY(0.5f) * float4x4::Translation(1, 2, 3) * float4x4::Projection(PI_F / 3.f, 1.f, 0.1f, 100.f, false);
+    for (size_t Count : {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 37, 100})
+    {
+        std::vector<float3> Src(Count);
+        for (auto& p : Src)
+            p = float3{rnd(), rnd(), rnd()};
+
+        std::vector<float3> Dst(Count);
+        TransformPoints(Src.data(), Count, m, Dst.data());
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const auto Ref = RefTransformPoint(Src[i], m);
+            CheckULP(Dst[i], Ref, SIMDMathMaxULP);
+            EXPECT_EQ(Dst[i], Src[i] * m);
+        }
+
+        // In-place transform
+        auto InPlace = Src;
+        TransformPoints(InPlace.data(), Count, m, InPlace.data());
+        EXPECT_EQ(InPlace, Dst);
+
+        std::vector<float4> Src4(Count);
+        std::vector<float4> Dst4(Count);
+        for (size_t i = 0; i < Count; ++i)
+            Src4[i] = float4{Src[i], rnd()};
+        TransformPoints(Src4.data(), Count, m, Dst4.data());
+        for (size_t i = 0; i < Count; ++i)
+            CheckULP(Dst4[i], RefVectorMatrixMul(Src4[i], m), SIMDMathMaxULP);
+    }
+}
+
 } // namespace
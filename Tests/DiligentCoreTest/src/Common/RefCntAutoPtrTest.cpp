@@ -30,6 +30,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <algorithm>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -904,4 +905,231 @@ TEST(Common_RefCntAutoPtr, Threading)
     ThreadingTest.RunConcurrencyTest();
 }
 
+
+class TrackedObject : public RefCountedObject<IObject>
+{
+public:
+    static constexpr Uint32 AliveMagic     = 0xA11FEu;
+    static constexpr Uint32 DestroyedMagic = 0xDEADu;
+
+    TrackedObject(IReferenceCounters* pRefCounters, std::atomic_int& NumDestroyed) :
+        RefCountedObject<IObject>{pRefCounters},
+        m_NumDestroyed{NumDestroyed}
+    {}
+
+    ~TrackedObject()
+    {
+        m_Magic = DestroyedMagic;
+        ++m_NumDestroyed;
+    }
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        *ppInterface = nullptr;
+        if (IID == IID_Unknown)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+    }
+
+    std::atomic<Uint32> m_Magic{AliveMagic};
+
+private:
+    std::atomic_int& m_NumDestroyed;
+};
+
+// Waits until all threads have arrived
+void SpinBarrier(std::atomic_int& Counter, int NumThreads)
+{
+    ++Counter;
+    while (Counter.load() < NumThreads)
+        std::this_thread::yield();
+}
+
+// Threads promote weak pointers while the last strong reference is released.
+// A promoted reference must always point to a live object, the object must be
+// destroyed exactly once, and once a promotion fails, all subsequent promotions must fail.
+TEST(Common_RefCntWeakPtr, ConcurrentPromotionAndRelease)
+{
+    const int NumThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 4u));
+#ifdef DILIGENT_DEBUG
+    const int NumIterations = 500;
+#else
+    const int NumIterations = 5000;
+#endif
+
+    for (int i = 0; i < NumIterations; ++i)
+    {
+        std::atomic_int NumDestroyed{0};
+        std::atomic_int NumArrived{0};
+        std::atomic_int NumErrors{0};
+
+        RefCntAutoPtr<TrackedObject> pObj{MakeNewRCObj<TrackedObject>{}(NumDestroyed)};
+        RefCntWeakPtr<TrackedObject> pWeak{pObj};
+
+        std::vector<std::thread> Threads;
+        for (int t = 0; t < NumThreads; ++t)
+        {
+            // Every thread gets its own copies of the pointers so that the strong and weak
+            // references are released in every possible order
+            RefCntAutoPtr<TrackedObject> pStrong{t % 3 == 0 ? pObj : RefCntAutoPtr<TrackedObject>{}};
+            RefCntWeakPtr<TrackedObject> pThreadWeak{pWeak};
+            Threads.emplace_back([&, t](RefCntAutoPtr<TrackedObject> pStrong, RefCntWeakPtr<TrackedObject> pThreadWeak) {
+                SpinBarrier(NumArrived, NumThreads);
+
+                if (pStrong)
+                {
+                    pStrong.Release();
+                }
+                else
+                {
+                    bool PromotionFailed = false;
+                    for (int j = 0; j < 16; ++j)
+                    {
+                        auto pPromoted = pThreadWeak.LockNoRelease();
+                        if (pPromoted)
+                        {
+                            if (PromotionFailed || pPromoted->m_Magic != TrackedObject::AliveMagic)
+                                ++NumErrors;
+                        }
+                        else
+                        {
+                            PromotionFailed = true;
+                        }
+                    }
+                }
+
+                if (t % 2 == 0)
+                    pThreadWeak.Release();
+                // Otherwise the weak reference is released when the thread function exits
+            },
+                                 std::move(pStrong), std::move(pThreadWeak));
+        }
+
+        // Release the main thread's references while the workers are running
+        pWeak.Release();
+        pObj.Release();
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        EXPECT_EQ(NumErrors, 0);
+        EXPECT_EQ(NumDestroyed, 1);
+    }
+}
+
+// Weak references are released while the object is being destroyed.
+// The returned number of remaining weak references must never be negative.
+TEST(Common_RefCntWeakPtr, ReleaseWeakRefDuringDestruction)
+{
+    const int NumThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 4u));
+#ifdef DILIGENT_DEBUG
+    const int NumIterations = 500;
+#else
+    const int NumIterations = 5000;
+#endif
+
+    for (int i = 0; i < NumIterations; ++i)
+    {
+        std::atomic_int NumDestroyed{0};
+        std::atomic_int NumArrived{0};
+        std::atomic_int NumErrors{0};
+
+        RefCntAutoPtr<TrackedObject> pObj{MakeNewRCObj<TrackedObject>{}(NumDestroyed)};
+
+        // Keep the counters alive until all workers are done
+        RefCntWeakPtr<TrackedObject> pWeak{pObj};
+        IReferenceCounters*          pRefCounters = pObj->GetReferenceCounters();
+        for (int t = 0; t < NumThreads; ++t)
+            pRefCounters->AddWeakRef();
+
+        std::vector<std::thread> Threads;
+        for (int t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&]() {
+                SpinBarrier(NumArrived, NumThreads + 1);
+                if (pRefCounters->ReleaseWeakRef() < 0)
+                    ++NumErrors;
+            });
+        }
+
+        SpinBarrier(NumArrived, NumThreads + 1);
+        pObj.Release();
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        EXPECT_EQ(NumErrors, 0);
+        EXPECT_EQ(NumDestroyed, 1);
+        EXPECT_EQ(pRefCounters->GetNumWeakRefs(), 1);
+    }
+}
+
+// Promotes the weak pointer from an object destructor that holds a weak
+// reference to the object being destroyed:
+//
+//    A ==sp==> B ---wp---> A
+//
+TEST(Common_RefCntWeakPtr, PromoteInDestructor)
+{
+    class ObjectB : public RefCountedObject<IObject>
+    {
+    public:
+        ObjectB(IReferenceCounters* pRefCounters, IObject* pA) :
+            RefCountedObject<IObject>{pRefCounters},
+            m_wpA{pA}
+        {}
+
+        ~ObjectB()
+        {
+            // A is being destroyed, so the reference must not be promoted
+            EXPECT_FALSE(m_wpA.Lock());
+            EXPECT_FALSE(m_wpA.IsValid());
+        }
+
+        virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final {}
+
+    private:
+        RefCntWeakPtr<IObject> m_wpA;
+    };
+
+    class ObjectA : public RefCountedObject<IObject>
+    {
+    public:
+        ObjectA(IReferenceCounters* pRefCounters) :
+            RefCountedObject<IObject>{pRefCounters}
+        {}
+
+        void Init()
+        {
+            m_spB = MakeNewRCObj<ObjectB>{}(this);
+        }
+
+        virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+        {
+            *ppInterface = nullptr;
+            if (IID == IID_Unknown)
+            {
+                *ppInterface = this;
+                (*ppInterface)->AddRef();
+            }
+        }
+
+    private:
+        RefCntAutoPtr<ObjectB> m_spB;
+    };
+
+    RefCntAutoPtr<ObjectA> pA{MakeNewRCObj<ObjectA>{}()};
+    pA->Init();
+
+    RefCntWeakPtr<ObjectA> wpA{pA};
+    EXPECT_EQ(pA->GetReferenceCounters()->GetNumWeakRefs(), 2);
+    EXPECT_EQ(wpA.Lock(), pA);
+
+    pA.Release();
+    EXPECT_FALSE(wpA.Lock());
+    EXPECT_FALSE(wpA.IsValid());
+}
+
 } // namespace
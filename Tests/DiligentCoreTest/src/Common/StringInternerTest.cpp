@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "StringInterner.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_StringInterner, Intern)
+{
+    StringInterner Interner;
+
+    EXPECT_TRUE(Interner.Intern(nullptr).IsNull());
+    EXPECT_TRUE(Interner.Find("g_Texture").IsNull());
+
+    const std::string Str1{"g_Texture"};
+    const std::string Str2{"g_Texture"};
+
+    auto Interned1 = Interner.Intern(Str1.c_str());
+    auto Interned2 = Interner.Intern(Str2.c_str());
+    ASSERT_FALSE(Interned1.IsNull());
+    EXPECT_EQ(Interned1, Interned2);
+    EXPECT_EQ(Interned1.GetStr(), Interned2.GetStr());
+    EXPECT_NE(Interned1.GetStr(), Str1.c_str());
+    EXPECT_STREQ(Interned1.GetStr(), "g_Texture");
+    EXPECT_EQ(Interned1.GetLength(), Str1.length());
+    EXPECT_EQ(Interned1.GetHash(), CStringHash<Char>{}(Str1.c_str()));
+    EXPECT_EQ(Interner.Find(Str1.c_str()), Interned1);
+
+    auto Interned3 = Interner.Intern("g_Sampler");
+    EXPECT_NE(Interned3, Interned1);
+    EXPECT_STREQ(Interned3.GetStr(), "g_Sampler");
+
+    auto Empty = Interner.Intern("");
+    ASSERT_FALSE(Empty.IsNull());
+    EXPECT_EQ(Empty.GetLength(), size_t{0});
+    EXPECT_STREQ(Empty.GetStr(), "");
+
+    EXPECT_EQ(Interner.GetNumStrings(), size_t{3});
+
+    // Interned strings must remain valid as the table grows
+    const auto* pStr = Interned1.GetStr();
+    for (int i = 0; i < 10000; ++i)
+        Interner.Intern(("g_Buffer" + std::to_string(i)).c_str());
+    EXPECT_EQ(Interner.Intern("g_Texture").GetStr(), pStr);
+    EXPECT_STREQ(pStr, "g_Texture");
+    EXPECT_EQ(Interner.GetNumStrings(), size_t{10003});
+
+    // Keys that use interned strings are found by regular string keys and vice versa
+    std::unordered_map<HashMapStringKey, int, HashMapStringKey::Hasher> Map;
+    Map.emplace(HashMapStringKey{Interned1.GetHash(), Interned1.GetStr()}, 1);
+    EXPECT_EQ(Map.count(HashMapStringKey{Str1.c_str()}), size_t{1});
+}
+
+TEST(Common_StringInterner, FromInternedStr)
+{
+    StringInterner Interner;
+
+    EXPECT_TRUE(InternedString::FromInternedStr(nullptr).IsNull());
+
+    auto Interned = Interner.Intern("g_Constants");
+    auto Restored = InternedString::FromInternedStr(Interned.GetStr());
+    EXPECT_EQ(Restored, Interned);
+    EXPECT_EQ(Restored.GetHash(), Interned.GetHash());
+    EXPECT_EQ(Restored.GetLength(), Interned.GetLength());
+}
+
+TEST(Common_StringInterner, Multithreaded)
+{
+    StringInterner Interner;
+
+    constexpr int NumStrings = 2048;
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::vector<InternedString>> Results(NumThreads);
+    std::vector<std::thread>                 Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Interner, &Results, t]() {
+            auto& ThreadResults = Results[t];
+            ThreadResults.resize(NumStrings);
+            // Every thread interns the same strings in a different order
+            for (int i = 0; i < NumStrings; ++i)
+            {
+                const int Idx      = (i * 7 + static_cast<int>(t) * 131) % NumStrings;
+                ThreadResults[Idx] = Interner.Intern(("Resource" + std::to_string(Idx)).c_str());
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Interner.GetNumStrings(), size_t{NumStrings});
+    for (int i = 0; i < NumStrings; ++i)
+    {
+        EXPECT_STREQ(Results[0][i].GetStr(), ("Resource" + std::to_string(i)).c_str());
+        for (Uint32 t = 1; t < NumThreads; ++t)
+            EXPECT_EQ(Results[t][i], Results[0][i]);
+    }
+}
+
+} // namespace
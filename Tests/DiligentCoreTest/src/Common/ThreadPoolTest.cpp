@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ThreadSignal.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, Enqueue)
+{
+    std::atomic<Uint32> Counter{0};
+    {
+        ThreadPool Pool{4};
+        EXPECT_EQ(Pool.GetNumThreads(), 4u);
+        for (Uint32 i = 0; i < 1000; ++i)
+        {
+            Pool.Enqueue([&Counter]() {
+                Counter.fetch_add(1);
+            });
+        }
+        // The destructor finishes all enqueued tasks
+    }
+    EXPECT_EQ(Counter.load(), 1000u);
+}
+
+TEST(Common_ThreadPool, ParallelFor)
+{
+    ThreadPool Pool{3};
+    for (Uint32 NumIterations : {0u, 1u, 2u, 3u, 17u, 1000u})
+    {
+        std::vector<std::atomic<Uint32>> Visited(NumIterations);
+        for (auto& v : Visited)
+            v.store(0);
+
+        Pool.ParallelFor(NumIterations, [&Visited](Uint32 i) {
+            Visited[i].fetch_add(1);
+        });
+
+        for (Uint32 i = 0; i < NumIterations; ++i)
+            EXPECT_EQ(Visited[i].load(), 1u) << i;
+    }
+}
+
+TEST(Common_ThreadPool, NestedParallelFor)
+{
+    ThreadPool Pool{2};
+
+    std::atomic<Uint32> Counter{0};
+    Pool.ParallelFor(8, [&](Uint32) {
+        Pool.ParallelFor(8, [&](Uint32) {
+            Counter.fetch_add(1);
+        });
+    });
+    EXPECT_EQ(Counter.load(), 64u);
+}
+
+TEST(Common_ThreadPool, ParallelForWithBusyWorkers)
+{
+    ThreadPool Pool{2};
+
+    // Block all workers. ParallelFor must still complete on the calling thread.
+    ThreadingTools::Signal Release;
+    for (Uint32 i = 0; i < Pool.GetNumThreads(); ++i)
+    {
+        Pool.Enqueue([&Release]() {
+            Release.Wait();
+        });
+    }
+
+    std::atomic<Uint32> Counter{0};
+    Pool.ParallelFor(100, [&Counter](Uint32) {
+        Counter.fetch_add(1);
+    });
+    EXPECT_EQ(Counter.load(), 100u);
+
+    Release.Trigger(true);
+}
+
+TEST(Common_ThreadPool, DestroyFromTask)
+{
+    std::atomic<Uint32> Counter{0};
+    // The detached worker thread may still access the signal after the test has
+    // been woken up, so the signal must not live on the test's stack.
+    auto pDone = std::make_shared<ThreadingTools::Signal>();
+    // Enqueue() must return before the pool is destroyed
+    ThreadingTools::Signal Start;
+
+    auto* pPool = new ThreadPool{2};
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        pPool->Enqueue([&Counter]() {
+            Counter.fetch_add(1);
+        });
+    }
+    // Destroy the pool from one of its worker threads, as happens when a task
+    // releases the last reference to the object that owns the pool.
+    pPool->Enqueue([pPool, pDone, &Start]() {
+        Start.Wait();
+        delete pPool;
+        pDone->Trigger();
+    });
+    Start.Trigger();
+    pDone->Wait();
+
+    // All tasks enqueued before the pool was destroyed must have been finished
+    EXPECT_EQ(Counter.load(), 100u);
+}
+
+} // namespace
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Float16.hpp"
+#include "FastRand.hpp"
+#include "PlatformDefinitions.h"
+#include "Errors.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint8 LinearToSRGB8Ref(float x)
+{
+    x = std::min(std::max(x, 0.f), 1.f);
+    return static_cast<Uint8>(LinearToSRGB(x) * 255.f + 0.5f);
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGB8ToLinear)
+{
+    std::vector<Uint8> SRGB(256 + 3);
+    for (size_t i = 0; i < SRGB.size(); ++i)
+        SRGB[i] = static_cast<Uint8>(i);
+
+    std::vector<float>  LinearFloat(SRGB.size());
+    std::vector<Uint16> LinearHalf(SRGB.size());
+    std::vector<Uint16> LinearUNorm16(SRGB.size());
+    SRGB8ToLinearFloat(SRGB.data(), LinearFloat.data(), SRGB.size());
+    SRGB8ToLinearHalf(SRGB.data(), LinearHalf.data(), SRGB.size());
+    SRGB8ToLinearUNorm16(SRGB.data(), LinearUNorm16.data(), SRGB.size());
+
+    for (size_t i = 0; i < SRGB.size(); ++i)
+    {
+        const auto Ref = SRGBToLinear(static_cast<float>(SRGB[i]) / 255.f);
+        EXPECT_EQ(LinearFloat[i], Ref) << i;
+        EXPECT_EQ(LinearHalf[i], Float32ToFloat16(Ref)) << i;
+        EXPECT_EQ(LinearUNorm16[i], static_cast<Uint16>(Ref * 65535.f + 0.5f)) << i;
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearFloatToSRGB8)
+{
+    // All 8-bit values must survive the round trip
+    {
+        std::vector<Uint8> SRGB(256);
+        for (size_t i = 0; i < SRGB.size(); ++i)
+            SRGB[i] = static_cast<Uint8>(i);
+
+        std::vector<float> Linear(SRGB.size());
+        SRGB8ToLinearFloat(SRGB.data(), Linear.data(), SRGB.size());
+
+        std::vector<Uint8> RoundTrip(SRGB.size());
+        LinearFloatToSRGB8(Linear.data(), RoundTrip.data(), Linear.size());
+        EXPECT_EQ(RoundTrip, SRGB);
+    }
+
+    // Dense sweep over [-0.25, 1.25] with a count that is not a multiple of the vector width
+    {
+        const size_t       NumValues = 100003;
+        std::vector<float> Linear(NumValues);
+        for (size_t i = 0; i < NumValues; ++i)
+            Linear[i] = -0.25f + 1.5f * static_cast<float>(i) / static_cast<float>(NumValues - 1);
+
+        std::vector<Uint8> SRGB(NumValues);
+        LinearFloatToSRGB8(Linear.data(), SRGB.data(), NumValues);
+
+        size_t NumMismatches = 0;
+        for (size_t i = 0; i < NumValues; ++i)
+        {
+            const auto Ref = LinearToSRGB8Ref(Linear[i]);
+            ASSERT_LE(std::abs(int{SRGB[i]} - int{Ref}), 1) << Linear[i];
+            if (SRGB[i] != Ref)
+                ++NumMismatches;
+        }
+        EXPECT_LE(NumMismatches, NumValues / 1000);
+    }
+
+    // Special values
+    {
+        const float Linear[] = {
+            std::numeric_limits<float>::quiet_NaN(),
+            -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity(),
+            -0.f,
+            std::numeric_limits<float>::denorm_min(),
+            1.f,
+            0.5f,
+            0.0031308f,
+            std::numeric_limits<float>::quiet_NaN(),
+        };
+        const Uint8 Ref[] = {0, 0, 255, 0, 0, 255, 188, 10, 0};
+
+        Uint8 SRGB[_countof(Linear)] = {};
+        LinearFloatToSRGB8(Linear, SRGB, _countof(Linear));
+        for (size_t i = 0; i < _countof(Linear); ++i)
+            EXPECT_EQ(SRGB[i], Ref[i]) << i;
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearHalfAndUNorm16ToSRGB8)
+{
+    // Values above the chunk size exercise chunked conversion
+    const size_t NumValues = 1000;
+
+    FastRandFloat       rnd(0, 0.f, 1.f);
+    std::vector<Uint16> LinearHalf(NumValues);
+    std::vector<Uint16> LinearUNorm16(NumValues);
+    for (size_t i = 0; i < NumValues; ++i)
+    {
+        const auto f     = rnd();
+        LinearHalf[i]    = Float32ToFloat16(f);
+        LinearUNorm16[i] = static_cast<Uint16>(f * 65535.f + 0.5f);
+    }
+
+    std::vector<Uint8> SRGBFromHalf(NumValues);
+    std::vector<Uint8> SRGBFromUNorm16(NumValues);
+    LinearHalfToSRGB8(LinearHalf.data(), SRGBFromHalf.data(), NumValues);
+    LinearUNorm16ToSRGB8(LinearUNorm16.data(), SRGBFromUNorm16.data(), NumValues);
+    for (size_t i = 0; i < NumValues; ++i)
+    {
+        EXPECT_LE(std::abs(int{SRGBFromHalf[i]} - int{LinearToSRGB8Ref(Float16ToFloat32(LinearHalf[i]))}), 1) << i;
+        EXPECT_LE(std::abs(int{SRGBFromUNorm16[i]} - int{LinearToSRGB8Ref(LinearUNorm16[i] / 65535.f)}), 1) << i;
+    }
+
+    // Round trip through 16-bit linear values must be exact
+    std::vector<Uint8> SRGB(256);
+    for (size_t i = 0; i < SRGB.size(); ++i)
+        SRGB[i] = static_cast<Uint8>(i);
+
+    std::vector<Uint16> Linear16(SRGB.size());
+    std::vector<Uint8>  RoundTrip(SRGB.size());
+
+    SRGB8ToLinearHalf(SRGB.data(), Linear16.data(), SRGB.size());
+    LinearHalfToSRGB8(Linear16.data(), RoundTrip.data(), SRGB.size());
+    EXPECT_EQ(RoundTrip, SRGB);
+
+    SRGB8ToLinearUNorm16(SRGB.data(), Linear16.data(), SRGB.size());
+    LinearUNorm16ToSRGB8(Linear16.data(), RoundTrip.data(), SRGB.size());
+    EXPECT_EQ(RoundTrip, SRGB);
+}
+
+TEST(GraphicsAccessories_ColorConversion, FastLinearFloatToSRGB8)
+{
+    // Dense sweep over [-0.25, 1.25] with a count that is not a multiple of the vector width
+    const size_t       NumValues = 100003;
+    std::vector<float> Linear(NumValues);
+    for (size_t i = 0; i < NumValues; ++i)
+        Linear[i] = -0.25f + 1.5f * static_cast<float>(i) / static_cast<float>(NumValues - 1);
+
+    std::vector<Uint8> SRGB(NumValues);
+    FastLinearFloatToSRGB8(Linear.data(), SRGB.data(), NumValues);
+
+    // The batch function must produce exactly the same values as the per-value computation
+    for (size_t i = 0; i < NumValues; ++i)
+    {
+        const float fSRGB = std::min(std::max(FastLinearToSRGB(Linear[i]) * 255.f, 0.f), 255.f);
+        ASSERT_EQ(SRGB[i], static_cast<Uint8>(fSRGB)) << Linear[i];
+    }
+}
+
+} // namespace
@@ -0,0 +1,394 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentRingBuffer.hpp"
+#include "AdaptiveLock.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    ConcurrentRingBuffer RB{1024, 16};
+    EXPECT_TRUE(RB.IsEmpty());
+
+    auto Offset = RB.Allocate(120, 16);
+    //
+    //  O          h
+    //  |          |                                      |
+    //  0         128
+    EXPECT_EQ(Offset, OffsetType{0});
+
+    // Sizes are rounded up to the minimum alignment
+    Offset = RB.Allocate(10, 1);
+    //
+    //  t          O   h
+    //  |          |   |                                  |
+    //  0         128 144
+    EXPECT_EQ(Offset, OffsetType{128});
+
+    Offset = RB.Allocate(10, 32);
+    //
+    //  t                  O   h
+    //  |                  |   |                          |
+    //  0         128 144 160 192
+    EXPECT_EQ(Offset, OffsetType{160});
+
+    Offset = RB.Allocate(17, 1);
+    //
+    //  t                      O   h
+    //  |                      |   |                      |
+    //  0         128 144 160 192 224
+    EXPECT_EQ(Offset, OffsetType{192});
+
+    // The space reserved for alignment that is not used becomes padding
+    Offset = RB.Allocate(65, 64);
+    //
+    //  t                               O         h
+    //  |                               |         |       |
+    //  0         128 144 160 192 224  256       400
+    EXPECT_EQ(Offset, OffsetType{256});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{400});
+
+    RB.FinishCurrentFrame(1);
+
+    Offset = RB.Allocate(100, 256);
+    //
+    //  t          h1    O            h
+    //  |          |     |            |                   |
+    //  0         400   512          896
+    EXPECT_EQ(Offset, OffsetType{512});
+
+    Offset = RB.Allocate(128, 1);
+    //
+    //  t          h1                 O                   h
+    //  |          |                  |                   |
+    //  0         400                896                1024
+    EXPECT_EQ(Offset, OffsetType{896});
+    EXPECT_TRUE(RB.IsFull());
+
+    Offset = RB.Allocate(1, 1);
+    EXPECT_EQ(Offset, InvalidOffset);
+
+    RB.FinishCurrentFrame(2);
+    RB.FinishCurrentFrame(3); // ignored
+    RB.ReleaseCompletedFrames(1);
+    //
+    //             t                                      h2,h
+    //  |          |                                      |
+    //  0         400                                   1024
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{624});
+
+    // Wrap around
+    Offset = RB.Allocate(256, 1);
+    //
+    //  O       h  t                                      h2
+    //  |       |  |                                      |
+    //  0      256 400                                  1024
+    EXPECT_EQ(Offset, OffsetType{0});
+
+    Offset = RB.Allocate(145, 1);
+    EXPECT_EQ(Offset, InvalidOffset);
+
+    Offset = RB.Allocate(144, 1);
+    //
+    //          O  h,t                                    h2
+    //  |       |  |                                      |
+    //  0      256 400                                  1024
+    EXPECT_EQ(Offset, OffsetType{256});
+    EXPECT_TRUE(RB.IsFull());
+
+    RB.FinishCurrentFrame(4);
+    RB.ReleaseCompletedFrames(3);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{400});
+    RB.ReleaseCompletedFrames(4);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, WrapAround)
+{
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    ConcurrentRingBuffer RB{1024, 16};
+
+    auto Offset = RB.Allocate(400, 1);
+    EXPECT_EQ(Offset, OffsetType{0});
+    RB.FinishCurrentFrame(1);
+
+    Offset = RB.Allocate(112, 1);
+    EXPECT_EQ(Offset, OffsetType{400});
+    RB.FinishCurrentFrame(2);
+    RB.ReleaseCompletedFrames(1);
+    //
+    //             t      h2,h
+    //  |          |      |                               |
+    //  0         400    512                            1024
+
+    Offset = RB.Allocate(400, 1);
+    //
+    //             t      h2,O                 h
+    //  |          |      |                    |          |
+    //  0         400    512                  912       1024
+    EXPECT_EQ(Offset, OffsetType{512});
+
+    // The allocation does not fit at the end of the buffer,
+    // so the remaining space becomes padding
+    Offset = RB.Allocate(256, 1);
+    //
+    //  O          h   t      h2                   ++++++++
+    //  |          |   |      |                    |      |
+    //  0         256 400    512                  912   1024
+    EXPECT_EQ(Offset, OffsetType{0});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{880});
+
+    Offset = RB.Allocate(160, 16);
+    EXPECT_EQ(Offset, InvalidOffset);
+
+    Offset = RB.Allocate(144, 16);
+    EXPECT_EQ(Offset, OffsetType{256});
+    EXPECT_TRUE(RB.IsFull());
+
+    RB.FinishCurrentFrame(3);
+    RB.ReleaseCompletedFrames(2);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{912});
+    RB.ReleaseCompletedFrames(3);
+    EXPECT_TRUE(RB.IsEmpty());
+
+    // When the buffer becomes empty, the head is moved to the beginning
+    Offset = RB.Allocate(16, 1);
+    EXPECT_EQ(Offset, OffsetType{0});
+    RB.FinishCurrentFrame(3);
+    RB.ReleaseCompletedFrames(3);
+    EXPECT_TRUE(RB.IsEmpty());
+
+    // Allocations that take the whole buffer
+    for (Uint64 Frame = 4; Frame < 8; ++Frame)
+    {
+        Offset = RB.Allocate(1024, 1);
+        EXPECT_EQ(Offset, OffsetType{0});
+        EXPECT_TRUE(RB.IsFull());
+        RB.FinishCurrentFrame(Frame);
+        RB.ReleaseCompletedFrames(Frame);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+
+    EXPECT_EQ(RB.Allocate(1025, 1), InvalidOffset);
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, Alignment)
+{
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    {
+        // Buffer size that is not a power of two
+        ConcurrentRingBuffer RB{3072, 256};
+
+        EXPECT_EQ(RB.Allocate(1, 1), OffsetType{0});
+        EXPECT_EQ(RB.Allocate(1, 256), OffsetType{256});
+        EXPECT_EQ(RB.Allocate(1, 1024), OffsetType{1024});
+        // The reservation of 2048 + 1024 - 256 bytes does not fit
+        EXPECT_EQ(RB.Allocate(2048, 2048), InvalidOffset);
+        EXPECT_EQ(RB.Allocate(512, 512), OffsetType{2560});
+        RB.FinishCurrentFrame(1);
+        RB.ReleaseCompletedFrames(1);
+
+        // Aligned offsets are computed in buffer space after the wrap-around
+        for (Uint32 i = 0; i < 64; ++i)
+        {
+            const OffsetType Alignment = OffsetType{1} << (i % 10);
+            const OffsetType Size      = 1 + (i * 97) % 700;
+
+            const auto Offset = RB.Allocate(Size, Alignment);
+            ASSERT_NE(Offset, InvalidOffset);
+            EXPECT_EQ(Offset % std::max(Alignment, RB.GetMinAlignment()), OffsetType{0});
+            EXPECT_LE(Offset + Size, RB.GetMaxSize());
+
+            // Keep one frame in flight so that the buffer never becomes empty
+            RB.FinishCurrentFrame(i + 2);
+            RB.ReleaseCompletedFrames(i + 1);
+        }
+        RB.ReleaseCompletedFrames(65);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+
+    {
+        ConcurrentRingBuffer RB{4096, 1};
+        EXPECT_EQ(RB.Allocate(3, 1), OffsetType{0});
+        EXPECT_EQ(RB.Allocate(3, 1), OffsetType{3});
+        EXPECT_EQ(RB.Allocate(3, 4), OffsetType{8});
+        EXPECT_EQ(RB.Allocate(1, 1024), OffsetType{1024});
+        RB.FinishCurrentFrame(1);
+        RB.ReleaseCompletedFrames(1);
+    }
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, PendingFrames)
+{
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+
+    ConcurrentRingBuffer RB{64 * 1024, 16};
+
+    // Finish more frames than can be recorded. Frames that do not fit are
+    // merged with the next recorded frame.
+    const Uint32 NumFrames = ConcurrentRingBuffer::MaxPendingFrames + 16;
+    for (Uint32 Frame = 1; Frame <= NumFrames; ++Frame)
+    {
+        EXPECT_NE(RB.Allocate(256, 16), InvalidOffset);
+        RB.FinishCurrentFrame(Frame);
+    }
+    EXPECT_EQ(RB.GetUsedSize(), size_t{256} * NumFrames);
+
+    RB.ReleaseCompletedFrames(ConcurrentRingBuffer::MaxPendingFrames);
+    EXPECT_EQ(RB.GetUsedSize(), size_t{256} * (NumFrames - ConcurrentRingBuffer::MaxPendingFrames));
+
+    // The last frames have not been recorded, so they are released with the next one
+    RB.ReleaseCompletedFrames(NumFrames);
+    EXPECT_EQ(RB.GetUsedSize(), size_t{256} * (NumFrames - ConcurrentRingBuffer::MaxPendingFrames));
+
+    EXPECT_NE(RB.Allocate(256, 16), InvalidOffset);
+    RB.FinishCurrentFrame(NumFrames + 1);
+    RB.ReleaseCompletedFrames(NumFrames + 1);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+// Worker threads allocate from the buffer concurrently while the main thread finishes and
+// releases frames. Every 16-byte granule of the buffer records the frame in which it was
+// last allocated; a granule must never be handed out again before its frame is released.
+TEST(GraphicsAccessories_ConcurrentRingBuffer, ConcurrentAllocations)
+{
+    using namespace ThreadingTools;
+
+    constexpr size_t GranuleSize = 16;
+    constexpr size_t BufferSize  = 64 * 1024;
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 5000;
+#else
+    constexpr Uint32 NumIterations = 50000;
+#endif
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    ConcurrentRingBuffer RB{BufferSize, GranuleSize};
+
+    std::vector<std::atomic<Uint64>> Granules(BufferSize / GranuleSize);
+    for (auto& Granule : Granules)
+        Granule.store(0);
+
+    AdaptiveSharedLock  FrameLock;
+    std::atomic<bool>   FrameUpdatePending{false};
+    std::atomic<Uint64> CurrentFrame{1};
+    std::atomic<Uint64> ReleasedFrame{0};
+    std::atomic<Uint32> NumFinishedThreads{0};
+    std::atomic<Uint32> NumOverlaps{0};
+    std::atomic<Uint32> NumMisalignments{0};
+    std::atomic<Uint32> NumAllocations{0};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            std::mt19937 Rng{t};
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                // Let the main thread finish the frame
+                while (FrameUpdatePending.load())
+                    std::this_thread::yield();
+
+                SharedLockGuard Guard{FrameLock};
+
+                const auto Frame     = CurrentFrame.load();
+                const auto Released  = ReleasedFrame.load();
+                const auto Size      = std::uniform_int_distribution<size_t>{1, 1024}(Rng);
+                const auto Alignment = size_t{1} << std::uniform_int_distribution<size_t>{0, 8}(Rng);
+
+                const auto Offset = RB.Allocate(Size, Alignment);
+                if (Offset == ConcurrentRingBuffer::InvalidOffset)
+                    continue;
+
+                NumAllocations.fetch_add(1);
+                if (Offset % std::max(Alignment, GranuleSize) != 0 || Offset + Size > BufferSize)
+                {
+                    NumMisalignments.fetch_add(1);
+                    continue;
+                }
+
+                for (size_t g = Offset / GranuleSize; g < (Offset + Size + GranuleSize - 1) / GranuleSize; ++g)
+                {
+                    auto LastFrame = Granules[g].load();
+                    if (LastFrame > Released || !Granules[g].compare_exchange_strong(LastFrame, Frame))
+                        NumOverlaps.fetch_add(1);
+                }
+            }
+            NumFinishedThreads.fetch_add(1);
+        });
+    }
+
+    while (NumFinishedThreads.load() < NumThreads)
+    {
+        FrameUpdatePending.store(true);
+        {
+            ExclusiveLockGuard<AdaptiveSharedLock> Guard{FrameLock};
+
+            const auto Frame = CurrentFrame.load();
+            RB.FinishCurrentFrame(Frame);
+            // Keep one frame in flight
+            RB.ReleaseCompletedFrames(Frame - 1);
+            ReleasedFrame.store(Frame - 1);
+            CurrentFrame.store(Frame + 1);
+        }
+        FrameUpdatePending.store(false);
+        std::this_thread::yield();
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumOverlaps.load(), 0u);
+    EXPECT_EQ(NumMisalignments.load(), 0u);
+    EXPECT_GT(NumAllocations.load(), 0u);
+
+    const auto LastFrame = CurrentFrame.load();
+    RB.FinishCurrentFrame(LastFrame);
+    RB.ReleaseCompletedFrames(LastFrame);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+} // namespace
@@ -29,10 +29,12 @@
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "Errors.hpp"
 
 using namespace Diligent;
 
@@ -49,7 +51,48 @@ static std::ostream& operator<<(std::ostream& os, const DynamicAtlasManager::Reg
 namespace
 {
 
-using Region = DynamicAtlasManager::Region;
+using Region            = DynamicAtlasManager::Region;
+using PackingPolicy     = DynamicAtlasManager::PackingPolicy;
+using MaxRectsHeuristic = DynamicAtlasManager::MaxRectsHeuristic;
+
+// clang-format off
+const MaxRectsHeuristic AllHeuristics[] =
+{
+    MaxRectsHeuristic::BestShortSideFit,
+    MaxRectsHeuristic::BestLongSideFit,
+    MaxRectsHeuristic::BestAreaFit,
+    MaxRectsHeuristic::BottomLeft,
+    MaxRectsHeuristic::ContactPoint
+};
+// clang-format on
+
+bool RegionsOverlap(const Region& R0, const Region& R1)
+{
+    // clang-format off
+    return R0.x < R1.x + R1.width  && R1.x < R0.x + R0.width &&
+           R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+    // clang-format on
+}
+
+void VerifyRegions(const std::vector<Region>& Regions, Uint32 AtlasWidth, Uint32 AtlasHeight)
+{
+    for (size_t i = 0; i < Regions.size(); ++i)
+    {
+        const auto& R0 = Regions[i];
+        if (R0.IsEmpty())
+            continue;
+        EXPECT_LE(R0.x + R0.width, AtlasWidth);
+        EXPECT_LE(R0.y + R0.height, AtlasHeight);
+        for (size_t j = i + 1; j < Regions.size(); ++j)
+        {
+            const auto& R1 = Regions[j];
+            if (!R1.IsEmpty())
+            {
+                EXPECT_FALSE(RegionsOverlap(R0, R1)) << R0 << " overlaps " << R1;
+            }
+        }
+    }
+}
 
 TEST(GraphicsAccessories_DynamicAtlasManager, Region_Ctor)
 {
@@ -461,4 +504,202 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_Allocate)
+{
+    for (auto Heuristic : AllHeuristics)
+    {
+        {
+            DynamicAtlasManager Mgr{16, 8, PackingPolicy::MaxRects, Heuristic};
+            EXPECT_EQ(Mgr.GetPackingPolicy(), PackingPolicy::MaxRects);
+
+            auto R = Mgr.Allocate(16, 8);
+            EXPECT_EQ(R, Region(0, 0, 16, 8));
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 0U);
+            EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+            Mgr.Free(std::move(R));
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+        }
+
+        {
+            DynamicAtlasManager Mgr{32, 32, PackingPolicy::MaxRects, Heuristic};
+
+            std::vector<Region> Rs;
+            for (Uint32 i = 0; i < 16; ++i)
+                Rs.push_back(Mgr.Allocate(8, 8));
+            VerifyRegions(Rs, 32, 32);
+            EXPECT_EQ(Mgr.GetAllocatedArea(), 32U * 32U);
+            EXPECT_EQ(Mgr.GetAllocatedRegionCount(), 16U);
+            EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+            // Free a 2x2 block of cells and check that the space is coalesced
+            std::vector<Region> Block;
+            for (auto& R : Rs)
+            {
+                if (R.x < 16 && R.y < 16)
+                {
+                    Block.push_back(R);
+                    Mgr.Free(std::move(R));
+                }
+            }
+            ASSERT_EQ(Block.size(), 4U);
+            Rs.push_back(Mgr.Allocate(16, 16));
+            EXPECT_EQ(Rs.back(), Region(0, 0, 16, 16));
+
+            for (auto& R : Rs)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+            EXPECT_EQ(Mgr.GetAllocatedArea(), 0U);
+        }
+
+        // Space that the guillotine partition can't merge
+        {
+            DynamicAtlasManager Mgr{64, 64, PackingPolicy::MaxRects, Heuristic};
+
+            auto R0 = Mgr.Allocate(64, 16);
+            auto R1 = Mgr.Allocate(16, 48);
+            EXPECT_FALSE(R0.IsEmpty());
+            EXPECT_FALSE(R1.IsEmpty());
+            Mgr.Free(std::move(R0));
+
+            auto R2 = Mgr.Allocate(48, 64);
+            EXPECT_FALSE(R2.IsEmpty());
+            EXPECT_FALSE(RegionsOverlap(R1, R2));
+
+            Mgr.Free(std::move(R2));
+            Mgr.Free(std::move(R1));
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+        }
+    }
+
+    {
+        DynamicAtlasManager Mgr{64, 64, PackingPolicy::MaxRects, MaxRectsHeuristic::BottomLeft};
+
+        auto R0 = Mgr.Allocate(16, 8);
+        auto R1 = Mgr.Allocate(8, 16);
+        auto R2 = Mgr.Allocate(48, 4);
+        EXPECT_EQ(R0, Region(0, 0, 16, 8));
+        EXPECT_EQ(R1, Region(16, 0, 8, 16));
+        EXPECT_EQ(R2, Region(0, 16, 48, 4));
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R1));
+        Mgr.Free(std::move(R2));
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, MaxRects_AllocateRandom)
+{
+    for (auto Heuristic : AllHeuristics)
+    {
+        DynamicAtlasManager Mgr{256, 256, PackingPolicy::MaxRects, Heuristic};
+        const Uint32        NumIterations = 10;
+        for (Uint32 i = 0; i < NumIterations; ++i)
+        {
+            FastRandInt         rnd{static_cast<unsigned int>(i), 1, 16};
+            std::vector<Region> Regions(i * 16);
+            for (auto& R : Regions)
+            {
+                R = Mgr.Allocate(rnd(), rnd());
+            }
+            VerifyRegions(Regions, 256, 256);
+
+            // Free every other region and refill the gaps
+            for (size_t r = 0; r < Regions.size(); r += 2)
+            {
+                if (!Regions[r].IsEmpty())
+                    Mgr.Free(std::move(Regions[r]));
+            }
+            for (size_t r = 0; r < Regions.size(); r += 2)
+            {
+                Regions[r] = Mgr.Allocate(rnd(), rnd());
+            }
+            VerifyRegions(Regions, 256, 256);
+
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+            EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+        }
+    }
+}
+
+void TestDefragment(PackingPolicy Policy, MaxRectsHeuristic Heuristic = MaxRectsHeuristic::BestShortSideFit)
+{
+    constexpr Uint32 AtlasSize = 256;
+    constexpr Uint32 CellSize  = 16;
+
+    DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Policy, Heuristic};
+
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < (AtlasSize / CellSize) * (AtlasSize / CellSize); ++i)
+        Regions.push_back(Mgr.Allocate(CellSize, CellSize));
+    EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+    // Free the cells in a checkerboard pattern
+    for (auto& R : Regions)
+    {
+        if (((R.x + R.y) / CellSize) % 2 == 0)
+            Mgr.Free(std::move(R));
+    }
+    Regions.erase(std::remove_if(Regions.begin(), Regions.end(), [](const Region& R) { return R.IsEmpty(); }), Regions.end());
+    EXPECT_EQ(Regions.size(), size_t{AtlasSize / CellSize * AtlasSize / CellSize / 2});
+    EXPECT_TRUE(Mgr.Allocate(CellSize * 2, CellSize * 2).IsEmpty());
+
+    std::vector<DynamicAtlasManager::RegionMove> Moves;
+    EXPECT_TRUE(Mgr.Defragment(Moves));
+    EXPECT_FALSE(Moves.empty());
+    EXPECT_EQ(Mgr.GetAllocatedRegionCount(), Regions.size());
+
+    for (const auto& Move : Moves)
+    {
+        auto it = std::find(Regions.begin(), Regions.end(), Move.Src);
+        ASSERT_NE(it, Regions.end()) << "Move source " << Move.Src << " is not an allocated region";
+        EXPECT_EQ(Move.Src.width, Move.Dst.width);
+        EXPECT_EQ(Move.Src.height, Move.Dst.height);
+        *it = Move.Dst;
+    }
+    VerifyRegions(Regions, AtlasSize, AtlasSize);
+
+    // The freed space must now be contiguous. Guillotine cuts always leave the
+    // last row split from the rest of the free space.
+    auto Large = Policy == PackingPolicy::MaxRects ?
+        Mgr.Allocate(AtlasSize, AtlasSize / 2) :
+        Mgr.Allocate(AtlasSize / 2, AtlasSize / 2);
+    EXPECT_FALSE(Large.IsEmpty());
+    if (!Large.IsEmpty())
+        Regions.push_back(Large);
+    VerifyRegions(Regions, AtlasSize, AtlasSize);
+
+    // Defragmenting a packed atlas does not move anything
+    EXPECT_TRUE(Mgr.Defragment(Moves));
+    for (const auto& Move : Moves)
+    {
+        auto it = std::find(Regions.begin(), Regions.end(), Move.Src);
+        ASSERT_NE(it, Regions.end());
+        *it = Move.Dst;
+    }
+    VerifyRegions(Regions, AtlasSize, AtlasSize);
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1U);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Defragment)
+{
+    TestDefragment(PackingPolicy::Guillotine);
+    TestDefragment(PackingPolicy::MaxRects, MaxRectsHeuristic::BottomLeft);
+
+    {
+        DynamicAtlasManager                          Mgr{64, 64};
+        std::vector<DynamicAtlasManager::RegionMove> Moves;
+        EXPECT_TRUE(Mgr.Defragment(Moves));
+        EXPECT_TRUE(Moves.empty());
+    }
+}
+
 } // namespace
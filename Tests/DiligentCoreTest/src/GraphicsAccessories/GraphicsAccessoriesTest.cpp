@@ -26,9 +26,12 @@
  */
 
 #include <array>
+#include <cstring>
+#include <vector>
 
 #include "GraphicsAccessories.hpp"
 #include "../../../Graphics/GraphicsEngine/include/PrivateConstants.h"
+#include "ThreadPool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -704,4 +707,65 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY).c_str(), "RUNTIME_ARRAY");
 }
 
+// Fills the source subresource with a pattern, copies it, and checks that the
+// destination rows match while the padding between them stays untouched.
+void TestCopyTextureSubresource(Uint32                         NumRows,
+                                Uint32                         NumSlices,
+                                Uint32                         RowSize,
+                                Uint32                         SrcRowStride,
+                                Uint32                         SrcDepthStride,
+                                Uint32                         DstRowStride,
+                                Uint32                         DstDepthStride,
+                                COPY_TEXTURE_SUBRESOURCE_FLAGS Flags,
+                                ThreadPool*                    pThreadPool)
+{
+    std::vector<Uint8> SrcData(size_t{SrcDepthStride} * NumSlices);
+    for (size_t i = 0; i < SrcData.size(); ++i)
+        SrcData[i] = static_cast<Uint8>(i * 7 + i / 251);
+
+    constexpr Uint8    PaddingValue = 0xCD;
+    std::vector<Uint8> DstData(size_t{DstDepthStride} * NumSlices + 1, PaddingValue);
+    // Use an unaligned destination to exercise the streaming copy head
+    Uint8* pDstData = DstData.data() + 1;
+
+    TextureSubResData SubresData{SrcData.data(), SrcRowStride, SrcDepthStride};
+    CopyTextureSubresource(SubresData, NumRows, NumSlices, RowSize, pDstData, DstRowStride, DstDepthStride, Flags, pThreadPool);
+
+    EXPECT_EQ(DstData[0], PaddingValue);
+    for (Uint32 z = 0; z < NumSlices; ++z)
+    {
+        for (Uint32 y = 0; y < NumRows; ++y)
+        {
+            const auto* pSrcRow = &SrcData[size_t{z} * SrcDepthStride + size_t{y} * SrcRowStride];
+            const auto* pDstRow = &pDstData[size_t{z} * DstDepthStride + size_t{y} * DstRowStride];
+            ASSERT_EQ(memcmp(pSrcRow, pDstRow, RowSize), 0) << "Slice " << z << ", row " << y;
+            if (y + 1 < NumRows)
+            {
+                for (Uint32 i = RowSize; i < DstRowStride; ++i)
+                    ASSERT_EQ(pDstRow[i], PaddingValue);
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_GraphicsAccessories, CopyTextureSubresource)
+{
+    ThreadPool Pool{3};
+    for (auto Flags : {COPY_TEXTURE_SUBRESOURCE_FLAG_NONE, COPY_TEXTURE_SUBRESOURCE_FLAG_DST_UNCACHED})
+    {
+        for (auto* pPool : {static_cast<ThreadPool*>(nullptr), &Pool})
+        {
+            // Padded rows
+            TestCopyTextureSubresource(17, 1, 100, 128, 128 * 17, 112, 112 * 17, Flags, pPool);
+            // Tightly packed rows, padded slices
+            TestCopyTextureSubresource(16, 3, 64, 64, 64 * 16 + 32, 64, 64 * 16 + 16, Flags, pPool);
+            // Tightly packed subresource
+            TestCopyTextureSubresource(16, 4, 75, 75, 75 * 16, 75, 75 * 16, Flags, pPool);
+            // Large subresources that are split between the pool threads by rows and by bytes
+            TestCopyTextureSubresource(1024, 1, 4096 + 13, 4096 + 16, (4096 + 16) * 1024, 4096 + 256, (4096 + 256) * 1024, Flags, pPool);
+            TestCopyTextureSubresource(1024, 2, 4096, 4096, 4096 * 1024, 4096, 4096 * 1024, Flags, pPool);
+        }
+    }
+}
+
 } // namespace
@@ -28,9 +28,11 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "Float16.hpp"
 
 #include <vector>
 #include <array>
+#include <cmath>
 
 #include "gtest/gtest.h"
 
@@ -501,4 +503,322 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+// sRGB texels are averaged in linear space with the fast sRGB approximations,
+// and the result is truncated
+Uint8 SRGBAverageRef(Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3)
+{
+    float fLinearAverage = (FastSRGBToLinear(c0 / 255.f) + FastSRGBToLinear(c1 / 255.f) + FastSRGBToLinear(c2 / 255.f) + FastSRGBToLinear(c3 / 255.f)) * 0.25f;
+    fLinearAverage       = std::min(std::max(fLinearAverage, 0.f), 255.f);
+    return static_cast<Uint8>(FastLinearToSRGB(fLinearAverage) * 255.f);
+}
+
+// Computes the reference coarse level with the same formulas that the scalar code uses
+template <typename ChannelType, typename AverageFuncType>
+std::vector<ChannelType> ComputeRefMipLevel(const std::vector<ChannelType>& FineData, Uint32 FineWidth, Uint32 FineHeight, Uint32 NumChannels, AverageFuncType Average)
+{
+    const Uint32 CoarseWidth  = std::max(FineWidth / 2, 1u);
+    const Uint32 CoarseHeight = std::max(FineHeight / 2, 1u);
+
+    std::vector<ChannelType> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+    for (Uint32 y = 0; y < CoarseHeight; ++y)
+    {
+        const Uint32 y0 = y * 2;
+        const Uint32 y1 = std::min(y * 2 + 1, FineHeight - 1);
+        for (Uint32 x = 0; x < CoarseWidth; ++x)
+        {
+            const Uint32 x0 = x * 2;
+            const Uint32 x1 = std::min(x * 2 + 1, FineWidth - 1);
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] =
+                    Average(FineData[(x0 + y0 * FineWidth) * NumChannels + c],
+                            FineData[(x1 + y0 * FineWidth) * NumChannels + c],
+                            FineData[(x0 + y1 * FineWidth) * NumChannels + c],
+                            FineData[(x1 + y1 * FineWidth) * NumChannels + c]);
+            }
+        }
+    }
+    return RefCoarseData;
+}
+
+// Sizes that exercise the vectorized loops as well as their scalar tails
+static const Uint32 TestSizes[][2] = {{1, 1}, {2, 1}, {1, 7}, {3, 3}, {8, 2}, {9, 5}, {16, 3}, {17, 4}, {31, 33}, {64, 64}, {225, 137}};
+
+TEST(GraphicsTools_CalculateMipLevel, RGBA8_Vectorized)
+{
+    FastRandInt rnd(0, 0, 255);
+    for (const auto& Size : TestSizes)
+    {
+        const Uint32 FineWidth  = Size[0];
+        const Uint32 FineHeight = Size[1];
+
+        std::vector<Uint8> FineData(FineWidth * FineHeight * 4);
+        for (auto& c : FineData)
+            c = static_cast<Uint8>(rnd());
+
+        const auto RefCoarseData = ComputeRefMipLevel(FineData, FineWidth, FineHeight, 4,
+                                                      [](Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3) {
+                                                          return static_cast<Uint8>((Uint32{c0} + Uint32{c1} + Uint32{c2} + Uint32{c3}) / 4);
+                                                      });
+
+        const Uint32 CoarseWidth = std::max(FineWidth / 2, 1u);
+
+        std::vector<Uint8> CoarseData(RefCoarseData.size());
+        ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_RGBA8_UNORM, FineData.data(), FineWidth * 4, CoarseData.data(), CoarseWidth * 4);
+        EXPECT_TRUE(CoarseData == RefCoarseData) << FineWidth << "x" << FineHeight;
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, sRGB_Vectorized)
+{
+    FastRandInt rnd(0, 0, 255);
+    for (const auto& Size : TestSizes)
+    {
+        const Uint32 FineWidth  = Size[0];
+        const Uint32 FineHeight = Size[1];
+
+        std::vector<Uint8> FineData(FineWidth * FineHeight * 4);
+        for (auto& c : FineData)
+            c = static_cast<Uint8>(rnd());
+
+        const auto RefCoarseData = ComputeRefMipLevel(FineData, FineWidth, FineHeight, 4, SRGBAverageRef);
+
+        const Uint32 CoarseWidth = std::max(FineWidth / 2, 1u);
+
+        std::vector<Uint8> CoarseData(RefCoarseData.size());
+        ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_RGBA8_UNORM_SRGB, FineData.data(), FineWidth * 4, CoarseData.data(), CoarseWidth * 4);
+        EXPECT_TRUE(CoarseData == RefCoarseData) << FineWidth << "x" << FineHeight;
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, RGBA32F_Vectorized)
+{
+    FastRandFloat rnd(0, -100.f, 100.f);
+    for (const auto& Size : TestSizes)
+    {
+        const Uint32 FineWidth  = Size[0];
+        const Uint32 FineHeight = Size[1];
+
+        std::vector<float> FineData(FineWidth * FineHeight * 4);
+        for (auto& c : FineData)
+            c = rnd();
+
+        const auto RefCoarseData = ComputeRefMipLevel(FineData, FineWidth, FineHeight, 4,
+                                                      [](float c0, float c1, float c2, float c3) {
+                                                          return (c0 + c1 + c2 + c3) * 0.25f;
+                                                      });
+
+        const Uint32 CoarseWidth = std::max(FineWidth / 2, 1u);
+
+        std::vector<float> CoarseData(RefCoarseData.size());
+        ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_RGBA32_FLOAT, FineData.data(), FineWidth * 16, CoarseData.data(), CoarseWidth * 16);
+        EXPECT_TRUE(CoarseData == RefCoarseData) << FineWidth << "x" << FineHeight;
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, RGBA16F)
+{
+    const Uint32 FineWidth  = 37;
+    const Uint32 FineHeight = 19;
+
+    FastRandFloat       rnd(0, 0.f, 10.f);
+    std::vector<Uint16> FineData(FineWidth * FineHeight * 4);
+    for (auto& c : FineData)
+        c = Float32ToFloat16(rnd());
+
+    const auto RefCoarseData = ComputeRefMipLevel(FineData, FineWidth, FineHeight, 4,
+                                                  [](Uint16 c0, Uint16 c1, Uint16 c2, Uint16 c3) {
+                                                      return Float32ToFloat16((Float16ToFloat32(c0) + Float16ToFloat32(c1) + Float16ToFloat32(c2) + Float16ToFloat32(c3)) * 0.25f);
+                                                  });
+
+    std::vector<Uint16> CoarseData(RefCoarseData.size());
+    ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_RGBA16_FLOAT, FineData.data(), FineWidth * 8, CoarseData.data(), FineWidth / 2 * 8);
+    EXPECT_TRUE(CoarseData == RefCoarseData);
+}
+
+TEST(GraphicsTools_CalculateMipLevel, R11G11B10F)
+{
+    const Uint32 FineWidth  = 23;
+    const Uint32 FineHeight = 41;
+
+    FastRandFloat       rnd(0, 0.f, 10.f);
+    std::vector<Uint32> FineData(FineWidth * FineHeight);
+    for (auto& c : FineData)
+        c = PackR11G11B10Float(rnd(), rnd(), rnd());
+
+    const auto RefCoarseData = ComputeRefMipLevel(FineData, FineWidth, FineHeight, 1,
+                                                  [](Uint32 c0, Uint32 c1, Uint32 c2, Uint32 c3) {
+                                                      float Sum[3] = {};
+                                                      for (auto c : {c0, c1, c2, c3})
+                                                      {
+                                                          float R, G, B;
+                                                          UnpackR11G11B10Float(c, R, G, B);
+                                                          Sum[0] += R;
+                                                          Sum[1] += G;
+                                                          Sum[2] += B;
+                                                      }
+                                                      return PackR11G11B10Float(Sum[0] * 0.25f, Sum[1] * 0.25f, Sum[2] * 0.25f);
+                                                  });
+
+    std::vector<Uint32> CoarseData(RefCoarseData.size());
+    ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_R11G11B10_FLOAT, FineData.data(), FineWidth * 4, CoarseData.data(), FineWidth / 2 * 4);
+    EXPECT_TRUE(CoarseData == RefCoarseData);
+}
+
+
+// Allocates storage for all levels below the top one
+template <typename ChannelType>
+struct MipChainStorage
+{
+    std::vector<std::vector<ChannelType>> Levels;
+    std::vector<void*>                    pLevels;
+    std::vector<Uint32>                   Strides;
+
+    MipChainStorage(Uint32 Width, Uint32 Height, Uint32 NumChannels, Uint32 NumLevels)
+    {
+        for (Uint32 mip = 0; mip < NumLevels; ++mip)
+        {
+            Width  = std::max(Width / 2, 1u);
+            Height = std::max(Height / 2, 1u);
+            Levels.emplace_back(Width * Height * NumChannels);
+            pLevels.push_back(Levels.back().data());
+            Strides.push_back(static_cast<Uint32>(Width * NumChannels * sizeof(ChannelType)));
+        }
+    }
+};
+
+TEST(GraphicsTools_ComputeMipChain, Box)
+{
+    // Large enough for the first levels to be split between threads
+    const Uint32 Width     = 1024;
+    const Uint32 Height    = 701;
+    const Uint32 NumLevels = 10;
+
+    FastRandInt        rnd(0, 0, 255);
+    std::vector<Uint8> TopLevel(Width * Height * 4);
+    for (auto& c : TopLevel)
+        c = static_cast<Uint8>(rnd());
+
+    for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB})
+    {
+        // Reference: repeated ComputeMipLevel calls
+        MipChainStorage<Uint8> RefChain{Width, Height, 4, NumLevels};
+        {
+            const void* pFine  = TopLevel.data();
+            Uint32      Stride = Width * 4;
+            Uint32      W = Width, H = Height;
+            for (Uint32 mip = 0; mip < NumLevels; ++mip)
+            {
+                ComputeMipLevel(W, H, Fmt, pFine, Stride, RefChain.pLevels[mip], RefChain.Strides[mip]);
+                pFine  = RefChain.pLevels[mip];
+                Stride = RefChain.Strides[mip];
+                W      = std::max(W / 2, 1u);
+                H      = std::max(H / 2, 1u);
+            }
+        }
+
+        for (Uint32 NumThreads : {1u, 4u})
+        {
+            MipChainStorage<Uint8> Chain{Width, Height, 4, NumLevels};
+
+            ComputeMipChainAttribs Attribs;
+            Attribs.Width        = Width;
+            Attribs.Height       = Height;
+            Attribs.Format       = Fmt;
+            Attribs.pData        = TopLevel.data();
+            Attribs.Stride       = Width * 4;
+            Attribs.NumMipLevels = NumLevels;
+            Attribs.ppMipData    = Chain.pLevels.data();
+            Attribs.pMipStrides  = Chain.Strides.data();
+            Attribs.NumThreads   = NumThreads;
+            ComputeMipChain(Attribs);
+
+            for (Uint32 mip = 0; mip < NumLevels; ++mip)
+                EXPECT_TRUE(Chain.Levels[mip] == RefChain.Levels[mip]) << "Mip " << mip << ", " << NumThreads << " threads";
+        }
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, Filtered)
+{
+    const Uint32 Width     = 97;
+    const Uint32 Height    = 64;
+    const Uint32 NumLevels = 7;
+
+    for (auto Filter : {MIP_FILTER_TYPE_KAISER, MIP_FILTER_TYPE_LANCZOS})
+    {
+        // A constant image must stay constant
+        {
+            std::vector<float> TopLevel(Width * Height * 4);
+            for (size_t i = 0; i < TopLevel.size(); ++i)
+                TopLevel[i] = static_cast<float>(i % 4) + 0.5f;
+
+            MipChainStorage<float> Chain{Width, Height, 4, NumLevels};
+
+            ComputeMipChainAttribs Attribs;
+            Attribs.Width        = Width;
+            Attribs.Height       = Height;
+            Attribs.Format       = TEX_FORMAT_RGBA32_FLOAT;
+            Attribs.pData        = TopLevel.data();
+            Attribs.Stride       = Width * 16;
+            Attribs.NumMipLevels = NumLevels;
+            Attribs.ppMipData    = Chain.pLevels.data();
+            Attribs.pMipStrides  = Chain.Strides.data();
+            Attribs.Filter       = Filter;
+            Attribs.NumThreads   = 3;
+            ComputeMipChain(Attribs);
+
+            for (Uint32 mip = 0; mip < NumLevels; ++mip)
+            {
+                for (size_t i = 0; i < Chain.Levels[mip].size(); ++i)
+                    ASSERT_NEAR(Chain.Levels[mip][i], static_cast<float>(i % 4) + 0.5f, 1e-4f) << "Mip " << mip;
+            }
+        }
+
+        // Filtered 8-bit levels must stay close to the box-filtered ones on a smooth image
+        {
+            std::vector<Uint8> TopLevel(Width * Height * 4);
+            for (Uint32 y = 0; y < Height; ++y)
+            {
+                for (Uint32 x = 0; x < Width; ++x)
+                {
+                    for (Uint32 c = 0; c < 4; ++c)
+                        TopLevel[(x + y * Width) * 4 + c] = static_cast<Uint8>(x + y + c * 8);
+                }
+            }
+
+            MipChainStorage<Uint8> BoxChain{Width, Height, 4, 1};
+            ComputeMipLevel(Width, Height, TEX_FORMAT_RGBA8_UNORM, TopLevel.data(), Width * 4, BoxChain.pLevels[0], BoxChain.Strides[0]);
+
+            MipChainStorage<Uint8> Chain{Width, Height, 4, 1};
+
+            ComputeMipChainAttribs Attribs;
+            Attribs.Width        = Width;
+            Attribs.Height       = Height;
+            Attribs.Format       = TEX_FORMAT_RGBA8_UNORM;
+            Attribs.pData        = TopLevel.data();
+            Attribs.Stride       = Width * 4;
+            Attribs.NumMipLevels = 1;
+            Attribs.ppMipData    = Chain.pLevels.data();
+            Attribs.pMipStrides  = Chain.Strides.data();
+            Attribs.Filter       = Filter;
+            ComputeMipChain(Attribs);
+
+            // Compare interior texels only as the box filter does not reach the clamped border
+            const Uint32 CoarseWidth = Width / 2;
+            for (Uint32 y = 4; y < Height / 2 - 4; ++y)
+            {
+                for (Uint32 x = 4; x < CoarseWidth - 4; ++x)
+                {
+                    for (Uint32 c = 0; c < 4; ++c)
+                    {
+                        const auto Idx = (x + y * CoarseWidth) * 4 + c;
+                        EXPECT_NEAR(Chain.Levels[0][Idx], BoxChain.Levels[0][Idx], 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryBudgetTracker.hpp"
+
+#include "gtest/gtest.h"
+
+#include "PlatformDefinitions.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_MemoryBudgetTracker, ExceedAndRestore)
+{
+    MemoryBudgetTracker Tracker{0.1f};
+
+    const auto Id = Tracker.AddThreshold(0.8f);
+    EXPECT_EQ(Tracker.GetNumThresholds(), size_t{1});
+
+    std::vector<MemoryBudgetThresholdEvent> Events;
+
+    MemoryHeapBudgetInfo Heaps[] = {{1000, 500}, {2000, 100}};
+    Tracker.Update(Heaps, _countof(Heaps), Events);
+    EXPECT_TRUE(Events.empty());
+
+    Heaps[0].Usage = 800;
+    Tracker.Update(Heaps, _countof(Heaps), Events);
+    ASSERT_EQ(Events.size(), size_t{1});
+    EXPECT_EQ(Events[0].ThresholdId, Id);
+    EXPECT_EQ(Events[0].HeapIndex, 0u);
+    EXPECT_TRUE(Events[0].Exceeded);
+    EXPECT_EQ(Events[0].Heap.Budget, Uint64{1000});
+    EXPECT_EQ(Events[0].Heap.Usage, Uint64{800});
+
+    // No new events while the state does not change
+    Events.clear();
+    Heaps[0].Usage = 900;
+    Tracker.Update(Heaps, _countof(Heaps), Events);
+    EXPECT_TRUE(Events.empty());
+
+    // Hysteresis: the usage must drop below (0.8 - 0.1) * Budget
+    Heaps[0].Usage = 750;
+    Tracker.Update(Heaps, _countof(Heaps), Events);
+    EXPECT_TRUE(Events.empty());
+
+    Heaps[0].Usage = 650;
+    Tracker.Update(Heaps, _countof(Heaps), Events);
+    ASSERT_EQ(Events.size(), size_t{1});
+    EXPECT_EQ(Events[0].HeapIndex, 0u);
+    EXPECT_FALSE(Events[0].Exceeded);
+}
+
+TEST(GraphicsAccessories_MemoryBudgetTracker, BudgetChange)
+{
+    MemoryBudgetTracker Tracker{0};
+    Tracker.AddThreshold(0.5f);
+
+    std::vector<MemoryBudgetThresholdEvent> Events;
+
+    MemoryHeapBudgetInfo Heap{1000, 400};
+    Tracker.Update(&Heap, 1, Events);
+    EXPECT_TRUE(Events.empty());
+
+    // Budget reduction with the same usage crosses the threshold
+    Heap.Budget = 600;
+    Tracker.Update(&Heap, 1, Events);
+    ASSERT_EQ(Events.size(), size_t{1});
+    EXPECT_TRUE(Events[0].Exceeded);
+
+    // Heaps with zero budget are ignored
+    Events.clear();
+    Heap.Budget = 0;
+    Tracker.Update(&Heap, 1, Events);
+    EXPECT_TRUE(Events.empty());
+}
+
+TEST(GraphicsAccessories_MemoryBudgetTracker, MultipleThresholds)
+{
+    MemoryBudgetTracker Tracker{0};
+
+    const auto Id0 = Tracker.AddThreshold(0.5f);
+    const auto Id1 = Tracker.AddThreshold(0.9f);
+    EXPECT_NE(Id0, Id1);
+
+    std::vector<MemoryBudgetThresholdEvent> Events;
+
+    // Jumping over both thresholds reports both
+    MemoryHeapBudgetInfo Heap{1000, 950};
+    Tracker.Update(&Heap, 1, Events);
+    ASSERT_EQ(Events.size(), size_t{2});
+    EXPECT_EQ(Events[0].ThresholdId, Id0);
+    EXPECT_TRUE(Events[0].Exceeded);
+    EXPECT_EQ(Events[1].ThresholdId, Id1);
+    EXPECT_TRUE(Events[1].Exceeded);
+
+    Events.clear();
+    Heap.Usage = 700;
+    Tracker.Update(&Heap, 1, Events);
+    ASSERT_EQ(Events.size(), size_t{1});
+    EXPECT_EQ(Events[0].ThresholdId, Id1);
+    EXPECT_FALSE(Events[0].Exceeded);
+
+    EXPECT_TRUE(Tracker.RemoveThreshold(Id0));
+    EXPECT_FALSE(Tracker.RemoveThreshold(Id0));
+    EXPECT_EQ(Tracker.GetNumThresholds(), size_t{1});
+
+    // The removed threshold no longer generates events
+    Events.clear();
+    Heap.Usage = 100;
+    Tracker.Update(&Heap, 1, Events);
+    EXPECT_TRUE(Events.empty());
+}
+
+TEST(GraphicsAccessories_MemoryBudgetTracker, NewThreshold)
+{
+    MemoryBudgetTracker Tracker{0};
+
+    std::vector<MemoryBudgetThresholdEvent> Events;
+
+    MemoryHeapBudgetInfo Heap{1000, 800};
+    Tracker.Update(&Heap, 1, Events);
+    EXPECT_TRUE(Events.empty());
+
+    // Heaps that already exceed a new threshold are reported by the next update
+    const auto Id = Tracker.AddThreshold(0.75f);
+    Tracker.Update(&Heap, 1, Events);
+    ASSERT_EQ(Events.size(), size_t{1});
+    EXPECT_EQ(Events[0].ThresholdId, Id);
+    EXPECT_TRUE(Events[0].Exceeded);
+}
+
+} // namespace
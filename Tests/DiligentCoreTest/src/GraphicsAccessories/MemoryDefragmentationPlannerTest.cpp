@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryDefragmentationPlanner.hpp"
+
+#include "gtest/gtest.h"
+
+#include "PlatformDefinitions.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, Stats)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 1024, 0},
+            {1024, 512, 0},
+            {1024, 128, 0},
+            {1024, 0, 0},
+        };
+
+    auto Stats = ComputeMemoryFragmentationStats(Pages, _countof(Pages), 0.25f);
+    EXPECT_EQ(Stats.NumPages, 4u);
+    EXPECT_EQ(Stats.NumEmptyPages, 1u);
+    EXPECT_EQ(Stats.NumSparsePages, 1u);
+    EXPECT_EQ(Stats.TotalSize, Uint64{4096});
+    EXPECT_EQ(Stats.UsedSize, Uint64{1664});
+    // Empty pages do not contribute to fragmentation
+    EXPECT_FLOAT_EQ(Stats.Fragmentation, (3072.f - 1664.f) / 3072.f);
+
+    Stats = ComputeMemoryFragmentationStats(nullptr, 0, 0.25f);
+    EXPECT_EQ(Stats.NumPages, 0u);
+    EXPECT_EQ(Stats.Fragmentation, 0.f);
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, SelectSparsePages)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 900, 0},   // Dense
+            {1024, 200, 200}, // Sparse
+            {1024, 100, 100}, // Sparse, cheapest to evacuate
+            {1024, 300, 300}, // Not sparse
+        };
+
+    DefragmentationPlanAttribs Attribs;
+    Attribs.SparsePageThreshold = 0.25f;
+    Attribs.MaxBytesToMove      = 1024;
+
+    auto Plan = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    ASSERT_EQ(Plan.PagesToEvacuate.size(), size_t{2});
+    EXPECT_EQ(Plan.PagesToEvacuate[0], size_t{2});
+    EXPECT_EQ(Plan.PagesToEvacuate[1], size_t{1});
+    EXPECT_EQ(Plan.BytesToMove, Uint64{300});
+
+    const auto StatsBefore = ComputeMemoryFragmentationStats(Pages, _countof(Pages), Attribs.SparsePageThreshold);
+    EXPECT_EQ(Plan.ProjectedStats.NumPages, 2u);
+    EXPECT_EQ(Plan.ProjectedStats.NumSparsePages, 0u);
+    EXPECT_EQ(Plan.ProjectedStats.UsedSize, StatsBefore.UsedSize);
+    EXPECT_LT(Plan.ProjectedStats.Fragmentation, StatsBefore.Fragmentation);
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, Budget)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 1000, 0},
+            {1024, 200, 200},
+            {1024, 100, 100},
+            {1024, 150, 150},
+        };
+
+    DefragmentationPlanAttribs Attribs;
+    Attribs.MaxBytesToMove = 260;
+
+    auto Plan = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    ASSERT_EQ(Plan.PagesToEvacuate.size(), size_t{2});
+    EXPECT_EQ(Plan.PagesToEvacuate[0], size_t{2});
+    EXPECT_EQ(Plan.PagesToEvacuate[1], size_t{3});
+    EXPECT_EQ(Plan.BytesToMove, Uint64{250});
+
+    Attribs.MaxBytesToMove = 50;
+    Plan                   = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    EXPECT_TRUE(Plan.PagesToEvacuate.empty());
+    EXPECT_EQ(Plan.BytesToMove, Uint64{0});
+    EXPECT_EQ(Plan.ProjectedStats.NumPages, 4u);
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, NonMovableAllocations)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 512, 0},
+            {1024, 100, 60}, // Can't be released as not all allocations are movable
+            {1024, 200, 200},
+        };
+
+    DefragmentationPlanAttribs Attribs;
+    Attribs.MaxBytesToMove = 1024;
+
+    auto Plan = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    ASSERT_EQ(Plan.PagesToEvacuate.size(), size_t{1});
+    EXPECT_EQ(Plan.PagesToEvacuate[0], size_t{2});
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, NoSpaceAfterEarlierPicks)
+{
+    // Once the first page is evacuated into the second one, there is no space left
+    // for the second page's allocations.
+    const DefragmentationPageInfo Pages[] =
+        {
+            {100, 10, 10},
+            {100, 20, 20},
+        };
+
+    DefragmentationPlanAttribs Attribs;
+    Attribs.MaxBytesToMove = 1 << 20;
+
+    auto Plan = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    ASSERT_EQ(Plan.PagesToEvacuate.size(), size_t{1});
+    EXPECT_EQ(Plan.PagesToEvacuate[0], size_t{0});
+    EXPECT_EQ(Plan.BytesToMove, Uint64{10});
+    EXPECT_EQ(Plan.ProjectedStats.NumPages, 1u);
+    EXPECT_EQ(Plan.ProjectedStats.UsedSize, Uint64{30});
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, Pools)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 1000, 0, 0},
+            {1024, 100, 100, 0}, // Not enough free space in pool 0
+            {1024, 600, 0, 1},
+            {1024, 100, 100, 1},
+            {1024, 200, 200, 1},
+        };
+
+    DefragmentationPlanAttribs Attribs;
+    Attribs.MaxBytesToMove = 1024;
+
+    auto Plan = PlanMemoryDefragmentation(Pages, _countof(Pages), Attribs);
+    ASSERT_EQ(Plan.PagesToEvacuate.size(), size_t{2});
+    EXPECT_EQ(Plan.PagesToEvacuate[0], size_t{3});
+    EXPECT_EQ(Plan.PagesToEvacuate[1], size_t{4});
+    EXPECT_EQ(Plan.BytesToMove, Uint64{300});
+
+    // Page 1 stays, page 2 receives all moved allocations
+    EXPECT_EQ(Plan.ProjectedStats.NumPages, 3u);
+    EXPECT_EQ(Plan.ProjectedStats.NumSparsePages, 1u);
+}
+
+TEST(GraphicsAccessories_MemoryDefragmentationPlanner, ProjectStats)
+{
+    const DefragmentationPageInfo Pages[] =
+        {
+            {1024, 500, 0},
+            {1024, 800, 0},
+            {1024, 300, 300},
+        };
+
+    auto Stats = ProjectMemoryFragmentationStats(Pages, _countof(Pages), {}, 0.25f);
+    EXPECT_EQ(Stats.NumPages, 3u);
+    EXPECT_EQ(Stats.UsedSize, Uint64{1600});
+
+    // The fullest page is filled first
+    Stats = ProjectMemoryFragmentationStats(Pages, _countof(Pages), {2}, 0.25f);
+    EXPECT_EQ(Stats.NumPages, 2u);
+    EXPECT_EQ(Stats.TotalSize, Uint64{2048});
+    EXPECT_EQ(Stats.UsedSize, Uint64{1600});
+    EXPECT_FLOAT_EQ(Stats.Fragmentation, (2048.f - 1600.f) / 2048.f);
+}
+
+} // namespace
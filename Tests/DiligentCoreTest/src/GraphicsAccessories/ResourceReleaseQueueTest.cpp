@@ -25,10 +25,15 @@
  *  of the possibility of such damages.
  */
 
+#include <atomic>
 #include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "SizeClassMemoryAllocator.hpp"
 
 #include "gtest/gtest.h"
 
@@ -128,4 +133,275 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+// Resource that counts its destructions and checks that it is not destroyed
+// before the fence of the command buffer it was released with has completed.
+class TrackedResource
+{
+public:
+    TrackedResource() = default;
+
+    TrackedResource(std::atomic<Uint32>& NumDestroyed, const std::atomic<Uint64>* pCompletedFence = nullptr, Uint64 CmdBufferNumber = 0) :
+        m_pNumDestroyed{&NumDestroyed},
+        m_pCompletedFence{pCompletedFence},
+        m_CmdBufferNumber{CmdBufferNumber}
+    {}
+
+    TrackedResource(TrackedResource&& rhs) noexcept :
+        m_pNumDestroyed{rhs.m_pNumDestroyed},
+        m_pCompletedFence{rhs.m_pCompletedFence},
+        m_CmdBufferNumber{rhs.m_CmdBufferNumber}
+    {
+        rhs.m_pNumDestroyed = nullptr;
+    }
+
+    TrackedResource& operator=(TrackedResource&& rhs) noexcept
+    {
+        VERIFY_EXPR(m_pNumDestroyed == nullptr);
+        m_pNumDestroyed     = rhs.m_pNumDestroyed;
+        m_pCompletedFence   = rhs.m_pCompletedFence;
+        m_CmdBufferNumber   = rhs.m_CmdBufferNumber;
+        rhs.m_pNumDestroyed = nullptr;
+        return *this;
+    }
+
+    // clang-format off
+    TrackedResource             (const TrackedResource&) = delete;
+    TrackedResource& operator = (const TrackedResource&) = delete;
+    // clang-format on
+
+    ~TrackedResource()
+    {
+        if (m_pNumDestroyed == nullptr)
+            return;
+
+        // Fence value N + 1 is signaled when command buffer N completes
+        if (m_pCompletedFence != nullptr && m_pCompletedFence->load() <= m_CmdBufferNumber)
+            ++NumPrematureReleases;
+
+        m_pNumDestroyed->fetch_add(1);
+    }
+
+    static std::atomic<Uint32> NumPrematureReleases;
+
+private:
+    std::atomic<Uint32>*       m_pNumDestroyed   = nullptr;
+    const std::atomic<Uint64>* m_pCompletedFence = nullptr;
+    Uint64                     m_CmdBufferNumber = 0;
+};
+
+std::atomic<Uint32> TrackedResource::NumPrematureReleases{0};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, MultipleSegments)
+{
+    using QueueType = ResourceReleaseQueue<DynamicStaleResourceWrapper>;
+
+    constexpr Uint32 NumResources = QueueType::SegmentSize * 5 + 17;
+
+    std::atomic<Uint32> NumDestroyed{0};
+
+    SizeClassMemoryAllocator WrapperAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+    {
+        QueueType Queue{DefaultRawMemoryAllocator::GetAllocator(), &WrapperAllocator};
+
+        for (Uint32 i = 0; i < NumResources; ++i)
+            Queue.SafeReleaseResource(TrackedResource{NumDestroyed}, i);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{NumResources});
+
+        // Move the first half of the resources to the release queue
+        Queue.DiscardStaleResources(NumResources / 2 - 1, 1);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{NumResources - NumResources / 2});
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources / 2});
+
+        Queue.DiscardStaleResources(NumResources, 2);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources});
+
+        Queue.Purge(0);
+        EXPECT_EQ(NumDestroyed.load(), 0u);
+
+        Queue.Purge(1);
+        EXPECT_EQ(NumDestroyed.load(), NumResources / 2);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources - NumResources / 2});
+
+        Queue.Purge(2);
+        EXPECT_EQ(NumDestroyed.load(), NumResources);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+
+        // Reuse the queue after its segments have been recycled
+        std::vector<TrackedResource> Resources;
+        for (Uint32 i = 0; i < NumResources; ++i)
+            Resources.emplace_back(NumDestroyed);
+        size_t Idx = 0;
+        Queue.DiscardResources<TrackedResource>(3, [&](TrackedResource& Resource) {
+            if (Idx >= Resources.size())
+                return false;
+            Resource = std::move(Resources[Idx++]);
+            return true;
+        });
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources});
+
+        Queue.Purge(3);
+        EXPECT_EQ(NumDestroyed.load(), NumResources * 2);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+    }
+
+    // All stale resource objects must have been returned to the pool
+    for (Uint32 SizeClass = 0; SizeClass <= SizeClassMemoryAllocator::LargeAllocationSizeClass; ++SizeClass)
+        EXPECT_EQ(WrapperAllocator.GetSizeClassStats(SizeClass).NumLiveAllocations, size_t{0});
+}
+
+// Segments must be recycled rather than allocated once the queue has warmed up
+TEST(GraphicsAccessories_ResourceReleaseQueue, SegmentRecycling)
+{
+    class CountingAllocator final : public IMemoryAllocator
+    {
+    public:
+        virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+        {
+            NumAllocations.fetch_add(1);
+            return DefaultRawMemoryAllocator::GetAllocator().Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+        }
+
+        virtual void Free(void* Ptr) override final
+        {
+            DefaultRawMemoryAllocator::GetAllocator().Free(Ptr);
+        }
+
+        std::atomic<Uint32> NumAllocations{0};
+    };
+
+    using QueueType = ResourceReleaseQueue<DynamicStaleResourceWrapper>;
+
+    constexpr Uint32 NumFrames          = 16;
+    constexpr Uint32 NumThreads         = 4;
+    constexpr Uint32 ResourcesPerThread = QueueType::SegmentSize * 2 + 5;
+
+    CountingAllocator   SegmentAllocator;
+    std::atomic<Uint32> NumDestroyed{0};
+    {
+        QueueType Queue{SegmentAllocator, &DefaultRawMemoryAllocator::GetAllocator()};
+
+        Uint32 NumWarmUpAllocations = 0;
+        for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            std::vector<std::thread> Threads;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back([&]() {
+                    for (Uint32 i = 0; i < ResourcesPerThread; ++i)
+                        Queue.DiscardResource(TrackedResource{NumDestroyed}, Frame);
+                });
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+
+            Queue.Purge(Frame);
+            EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+
+            if (Frame == 1)
+                NumWarmUpAllocations = SegmentAllocator.NumAllocations.load();
+        }
+        // Every frame uses about 8 segments. Producers that lose the race to link a segment return
+        // their segment to the spare list, so a few more segments may be needed when more producers
+        // than before race at the same time, but no more than one per thread.
+        EXPECT_LE(SegmentAllocator.NumAllocations.load(), NumWarmUpAllocations + NumThreads);
+    }
+    EXPECT_EQ(NumDestroyed.load(), NumFrames * NumThreads * ResourcesPerThread);
+}
+
+// Multiple threads release resources to two queues while the main thread
+// submits command buffers and purges the queues.
+TEST(GraphicsAccessories_ResourceReleaseQueue, ConcurrentRelease)
+{
+    using QueueType = ResourceReleaseQueue<DynamicStaleResourceWrapper>;
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumIterations = 5000;
+#else
+    constexpr Uint32 NumIterations = 50000;
+#endif
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    TrackedResource::NumPrematureReleases.store(0);
+
+    SizeClassMemoryAllocator WrapperAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    QueueType Queues[] = {
+        {DefaultRawMemoryAllocator::GetAllocator(), &WrapperAllocator},
+        {DefaultRawMemoryAllocator::GetAllocator(), &WrapperAllocator},
+    };
+
+    std::atomic<Uint64> NextCmdBufferNumber{0};
+    std::atomic<Uint64> CompletedFence{0};
+    std::atomic<Uint32> NumDestroyed{0};
+    std::atomic<Uint32> NumFinishedThreads{0};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            std::mt19937 Rng{t};
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                const auto      CmdBufferNumber = NextCmdBufferNumber.load();
+                TrackedResource Resource{NumDestroyed, &CompletedFence, CmdBufferNumber};
+                if (Rng() % 4 == 0)
+                {
+                    // Resource shared between both queues
+                    auto Wrapper = DynamicStaleResourceWrapper::Create(std::move(Resource), 2, &WrapperAllocator);
+                    Queues[0].SafeReleaseResource(Wrapper, CmdBufferNumber);
+                    Queues[1].SafeReleaseResource(Wrapper, CmdBufferNumber);
+                    Wrapper.GiveUpOwnership();
+                }
+                else
+                {
+                    Queues[Rng() % 2].SafeReleaseResource(std::move(Resource), CmdBufferNumber);
+                }
+            }
+            NumFinishedThreads.fetch_add(1);
+        });
+    }
+
+    Uint64 LastFence = 0;
+
+    auto SubmitAndPurge = [&]() {
+        const auto CmdBufferNumber = NextCmdBufferNumber.fetch_add(1);
+        const auto FenceValue      = CmdBufferNumber + 1;
+        for (auto& Queue : Queues)
+            Queue.DiscardStaleResources(CmdBufferNumber, FenceValue);
+
+        // Keep two command buffers in flight
+        if (FenceValue > 2)
+        {
+            CompletedFence.store(FenceValue - 2);
+            for (auto& Queue : Queues)
+                Queue.Purge(FenceValue - 2);
+        }
+        LastFence = FenceValue;
+    };
+
+    while (NumFinishedThreads.load() < NumThreads)
+    {
+        SubmitAndPurge();
+        std::this_thread::yield();
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    SubmitAndPurge();
+    CompletedFence.store(LastFence);
+    for (auto& Queue : Queues)
+    {
+        Queue.Purge(LastFence);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+    }
+
+    EXPECT_EQ(NumDestroyed.load(), NumThreads * NumIterations);
+    EXPECT_EQ(TrackedResource::NumPrematureReleases.load(), 0u);
+    for (Uint32 SizeClass = 0; SizeClass <= SizeClassMemoryAllocator::LargeAllocationSizeClass; ++SizeClass)
+        EXPECT_EQ(WrapperAllocator.GetSizeClassStats(SizeClass).NumLiveAllocations, size_t{0});
+}
+
 } // namespace
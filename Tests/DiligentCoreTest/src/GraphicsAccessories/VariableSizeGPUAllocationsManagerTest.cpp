@@ -25,7 +25,13 @@
  *  of the possibility of such damages.
  */
 
+#include <algorithm>
+#include <random>
+#include <map>
+#include <vector>
+
 #include "VariableSizeGPUAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
 
@@ -36,14 +42,15 @@ using namespace Diligent;
 namespace
 {
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+template <typename AllocationsManagerType>
+void TestAllocateFree()
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
 
-    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using OffsetType = typename AllocationsManagerType::OffsetType;
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        AllocationsManagerType ListMgr(128, Allocator);
         EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
 
         auto a1 = ListMgr.Allocate(17, 4);
@@ -130,7 +137,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        AllocationsManagerType ListMgr(128, Allocator);
 
         auto a1 = ListMgr.Allocate(64, 1);
         EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
@@ -138,7 +145,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
         EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
 
         auto a2 = ListMgr.Allocate(128, 1);
-        EXPECT_EQ(a2, VariableSizeAllocationsManager::Allocation::InvalidAllocation());
+        EXPECT_EQ(a2, AllocationsManagerType::Allocation::InvalidAllocation());
 
         ListMgr.Extend(128);
         EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
@@ -171,10 +178,11 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 }
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+template <typename AllocationsManagerType>
+void TestFreeOrder()
 {
     auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
-    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using OffsetType = typename AllocationsManagerType::OffsetType;
 
     {
         const auto NumAllocs = 6;
@@ -185,9 +193,9 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
         do
         {
             ++NumPerms;
-            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+            AllocationsManagerType ListMgr(NumAllocs * 4, Allocator);
 
-            VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
+            typename AllocationsManagerType::Allocation allocs[NumAllocs];
             for (size_t a = 0; a < NumAllocs; ++a)
             {
                 allocs[a] = ListMgr.Allocate(4, 1);
@@ -203,6 +211,16 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+{
+    TestAllocateFree<VariableSizeAllocationsManager>();
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+{
+    TestFreeOrder<VariableSizeAllocationsManager>();
+}
+
 TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
@@ -242,4 +260,273 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, MaxFreeBlockSize)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    VariableSizeAllocationsManager ListMgr(128, Allocator);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+
+    auto a1 = ListMgr.Allocate(32, 1);
+    auto a2 = ListMgr.Allocate(16, 1);
+    auto a3 = ListMgr.Allocate(64, 1);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{16});
+
+    ListMgr.Free(std::move(a1));
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{32});
+
+    ListMgr.Free(std::move(a3));
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{80});
+
+    auto a4 = ListMgr.Allocate(80, 1);
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{32});
+
+    ListMgr.Free(std::move(a4));
+    ListMgr.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+
+    auto a5 = ListMgr.Allocate(128, 1);
+    EXPECT_TRUE(ListMgr.IsFull());
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{0});
+    ListMgr.Free(std::move(a5));
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    TestAllocateFree<TLSFAllocationsManager>();
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        // The size of the only free block is not a size class boundary
+        TLSFAllocationsManager ListMgr(1000, Allocator);
+
+        auto a1 = ListMgr.Allocate(1000, 1);
+        EXPECT_EQ(a1.UnalignedOffset, size_t{0});
+        EXPECT_EQ(a1.Size, size_t{1000});
+        EXPECT_TRUE(ListMgr.IsFull());
+        ListMgr.Free(std::move(a1));
+
+        a1      = ListMgr.Allocate(300, 1);
+        auto a2 = ListMgr.Allocate(700, 1);
+        EXPECT_EQ(a2.UnalignedOffset, size_t{300});
+        EXPECT_EQ(a2.Size, size_t{700});
+        EXPECT_TRUE(ListMgr.IsFull());
+        ListMgr.Free(std::move(a2));
+        ListMgr.Free(std::move(a1));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    TestFreeOrder<TLSFAllocationsManager>();
+}
+
+struct AllocationRequest
+{
+    size_t Size;
+    size_t Alignment;
+};
+
+// Approximates the mix of requests seen by a GPU memory sub-allocator: many small constant
+// buffers, fewer vertex and index buffers, and occasional texture-sized blocks.
+class BufferSizeDistribution
+{
+public:
+    explicit BufferSizeDistribution(bool MixedAlignments) :
+        m_MixedAlignments{MixedAlignments}
+    {}
+
+    AllocationRequest operator()(std::mt19937& Rng) const
+    {
+        using UniformDist = std::uniform_int_distribution<size_t>;
+
+        AllocationRequest Request{};
+
+        const auto Category = UniformDist{0, 99}(Rng);
+        if (Category < 70)
+        {
+            // Constant buffers: 256 B - 4 KB
+            Request.Size      = 256 * UniformDist{1, 16}(Rng);
+            Request.Alignment = 256;
+        }
+        else if (Category < 95)
+        {
+            // Vertex and index buffers: 4 KB - 1 MB, roughly log-uniform
+            Request.Size      = UniformDist{size_t{4} << 10, size_t{1} << UniformDist{13, 20}(Rng)}(Rng);
+            Request.Alignment = m_MixedAlignments ? size_t{4} << (2 * UniformDist{0, 3}(Rng)) : 256;
+        }
+        else
+        {
+            // Textures: 1 MB - 8 MB
+            Request.Size      = (size_t{64} << 10) * UniformDist{16, 128}(Rng);
+            Request.Alignment = m_MixedAlignments ? size_t{64} << 10 : 256;
+        }
+
+        if (!m_MixedAlignments)
+            Request.Size = AlignUp(Request.Size, size_t{256});
+
+        return Request;
+    }
+
+private:
+    const bool m_MixedAlignments;
+};
+
+using LiveAllocationsMap = std::map<size_t, size_t>;
+
+void AddLiveAllocation(LiveAllocationsMap& Live, const VariableSizeAllocationsManager::Allocation& Alloc)
+{
+    auto NextIt = Live.lower_bound(Alloc.UnalignedOffset);
+    if (NextIt != Live.end())
+    {
+        EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, NextIt->first) << "Allocation overlaps the next live allocation";
+    }
+    if (NextIt != Live.begin())
+    {
+        auto PrevIt = std::prev(NextIt);
+        EXPECT_LE(PrevIt->first + PrevIt->second, Alloc.UnalignedOffset) << "Allocation overlaps the previous live allocation";
+    }
+    Live.emplace(Alloc.UnalignedOffset, Alloc.Size);
+}
+
+// Runs the same random sequence of operations on the map-based and TLSF managers and checks that the
+// TLSF manager never hands out overlapping or misaligned regions and succeeds whenever the map-based one does.
+// When all requests share the same alignment, no padding is ever required and the two managers must
+// additionally agree on the allocation sizes and the amount of free space.
+void RunEquivalenceTest(bool MixedAlignments, Uint32 Seed)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+#ifdef DILIGENT_DEBUG
+    constexpr size_t NumOperations = 4000;
+#else
+    constexpr size_t NumOperations = 100000;
+#endif
+    constexpr size_t MaxSize = size_t{256} << 20;
+
+    VariableSizeAllocationsManager MapMgr{MaxSize, Allocator};
+    TLSFAllocationsManager         TLSFMgr{MaxSize, Allocator};
+
+    std::mt19937                 Rng{Seed};
+    const BufferSizeDistribution SizeDist{MixedAlignments};
+
+    struct AllocationPair
+    {
+        VariableSizeAllocationsManager::Allocation MapAlloc;
+        TLSFAllocationsManager::Allocation         TLSFAlloc;
+    };
+    std::vector<AllocationPair> Allocations;
+    LiveAllocationsMap          MapLive, TLSFLive;
+
+    auto FreeAllocation = [&](size_t Idx) {
+        std::swap(Allocations[Idx], Allocations.back());
+        auto& Pair = Allocations.back();
+        MapLive.erase(Pair.MapAlloc.UnalignedOffset);
+        TLSFLive.erase(Pair.TLSFAlloc.UnalignedOffset);
+        MapMgr.Free(std::move(Pair.MapAlloc));
+        TLSFMgr.Free(std::move(Pair.TLSFAlloc));
+        Allocations.pop_back();
+    };
+
+    for (size_t op = 0; op < NumOperations; ++op)
+    {
+        // Keep the utilization at or below 50%
+        const auto DoAllocate = Allocations.empty() ||
+            (std::uniform_int_distribution<int>{0, 99}(Rng) < 55 && MapMgr.GetUsedSize() < MaxSize / 2);
+        if (DoAllocate)
+        {
+            const auto Request = SizeDist(Rng);
+
+            AllocationPair Pair;
+            Pair.MapAlloc  = MapMgr.Allocate(Request.Size, Request.Alignment);
+            Pair.TLSFAlloc = TLSFMgr.Allocate(Request.Size, Request.Alignment);
+            ASSERT_TRUE(Pair.MapAlloc.IsValid());
+            ASSERT_TRUE(Pair.TLSFAlloc.IsValid()) << "TLSF manager failed to allocate " << Request.Size << " bytes";
+
+            const auto AlignedOffset = AlignUp(Pair.TLSFAlloc.UnalignedOffset, Request.Alignment);
+            EXPECT_LE(AlignedOffset + AlignUp(Request.Size, Request.Alignment), Pair.TLSFAlloc.UnalignedOffset + Pair.TLSFAlloc.Size);
+            if (!MixedAlignments)
+            {
+                EXPECT_EQ(Pair.MapAlloc.Size, Pair.TLSFAlloc.Size);
+            }
+
+            AddLiveAllocation(MapLive, Pair.MapAlloc);
+            AddLiveAllocation(TLSFLive, Pair.TLSFAlloc);
+            Allocations.push_back(Pair);
+        }
+        else
+        {
+            FreeAllocation(std::uniform_int_distribution<size_t>{0, Allocations.size() - 1}(Rng));
+        }
+
+        if (!MixedAlignments)
+        {
+            EXPECT_EQ(MapMgr.GetFreeSize(), TLSFMgr.GetFreeSize());
+        }
+    }
+
+    while (!Allocations.empty())
+        FreeAllocation(std::uniform_int_distribution<size_t>{0, Allocations.size() - 1}(Rng));
+
+    EXPECT_TRUE(MapMgr.IsEmpty());
+    EXPECT_TRUE(TLSFMgr.IsEmpty());
+    EXPECT_EQ(MapMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(TLSFMgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, RandomizedEquivalence)
+{
+    RunEquivalenceTest(false, 0);
+    RunEquivalenceTest(true, 1);
+}
+
+// Fills a small manager until it runs out of space, then keeps freeing and allocating at
+// the limit, which exercises the exhaustion path and the coalescing of all neighbor combinations.
+TEST(GraphicsAccessories_TLSFAllocationsManager, RandomizedExhaustion)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    constexpr size_t MaxSize = 4096;
+
+    TLSFAllocationsManager ListMgr{MaxSize, Allocator};
+    std::mt19937           Rng{2};
+
+    std::vector<TLSFAllocationsManager::Allocation> Allocations;
+    LiveAllocationsMap                              Live;
+    for (size_t iter = 0; iter < 200; ++iter)
+    {
+        while (true)
+        {
+            const auto Size      = std::uniform_int_distribution<size_t>{1, 128}(Rng);
+            const auto Alignment = size_t{1} << std::uniform_int_distribution<size_t>{0, 4}(Rng);
+
+            auto Alloc = ListMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+                break;
+            EXPECT_LE(AlignUp(Alloc.UnalignedOffset, Alignment) + AlignUp(Size, Alignment), Alloc.UnalignedOffset + Alloc.Size);
+            AddLiveAllocation(Live, Alloc);
+            Allocations.push_back(Alloc);
+        }
+
+        size_t UsedSize = 0;
+        for (const auto& Alloc : Allocations)
+            UsedSize += Alloc.Size;
+        EXPECT_EQ(ListMgr.GetUsedSize(), UsedSize);
+
+        std::shuffle(Allocations.begin(), Allocations.end(), Rng);
+        const auto NumToFree = iter + 1 < 200 ? Allocations.size() / 2 : Allocations.size();
+        for (size_t i = 0; i < NumToFree; ++i)
+        {
+            Live.erase(Allocations.back().UnalignedOffset);
+            ListMgr.Free(std::move(Allocations.back()));
+            Allocations.pop_back();
+        }
+    }
+
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+}
+
 } // namespace
@@ -37,6 +37,9 @@ void TestPipelineResourceSignature(struct IPipelineResourceSignature* pSign)
     struct IShaderResourceVariable* pVar2 = IPipelineResourceSignature_GetStaticVariableByIndex(pSign, SHADER_TYPE_UNKNOWN, 0);
     (void)pVar2;
 
+    struct IShaderResourceVariable* pVar3 = IPipelineResourceSignature_GetStaticVariableByInternedName(pSign, SHADER_TYPE_UNKNOWN, "name");
+    (void)pVar3;
+
     Uint32 Count = IPipelineResourceSignature_GetStaticVariableCount(pSign, SHADER_TYPE_UNKNOWN);
     (void)Count;
 
@@ -39,9 +39,11 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
     Uint32                   VarCount = IPipelineState_GetStaticVariableCount(pPSO, SHADER_TYPE_UNKNOWN);
     IShaderResourceVariable* pSRV1    = IPipelineState_GetStaticVariableByName(pPSO, SHADER_TYPE_UNKNOWN, "Resource name");
     IShaderResourceVariable* pSRV2    = IPipelineState_GetStaticVariableByIndex(pPSO, SHADER_TYPE_UNKNOWN, (Uint32)1);
+    IShaderResourceVariable* pSRV3    = IPipelineState_GetStaticVariableByInternedName(pPSO, SHADER_TYPE_UNKNOWN, "Resource name");
     (void)VarCount;
     (void)pSRV1;
     (void)pSRV2;
+    (void)pSRV3;
 
     IPipelineState_CreateShaderResourceBinding(pPSO, (IShaderResourceBinding**)NULL, true);
 
@@ -49,4 +51,7 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
     (void)Compatible;
 
     IPipelineState_InitializeStaticSRBResources(pPSO, (struct IShaderResourceBinding*)NULL);
+
+    PIPELINE_STATE_STATUS Status = IPipelineState_GetStatus(pPSO, false);
+    (void)Status;
 }
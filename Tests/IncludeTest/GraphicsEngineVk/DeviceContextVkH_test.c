@@ -37,4 +37,8 @@ void TestDeviceContextVk_CInterface(IDeviceContextVk* pCtx)
     (void)pVkCmdQueue;
 
     IDeviceContextVk_UnlockCommandQueue(pCtx);
+
+    DefragmentMemoryAttribsVk Attribs = {0};
+    DefragmentMemoryStatsVk   Stats;
+    IDeviceContextVk_DefragmentMemory(pCtx, &Attribs, &Stats);
 }
@@ -51,4 +51,17 @@ void TestRenderDeviceVkCInterface(IRenderDeviceVk* pDevice)
     IRenderDeviceVk_CreateBufferFromVulkanResource(pDevice, (VkBuffer)NULL, (BufferDesc*)NULL, RESOURCE_STATE_CONSTANT_BUFFER, (IBuffer**)NULL);
     IRenderDeviceVk_CreateBLASFromVulkanResource(pDevice, (VkAccelerationStructureKHR)NULL, (BottomLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (IBottomLevelAS**)NULL);
     IRenderDeviceVk_CreateTLASFromVulkanResource(pDevice, (VkAccelerationStructureKHR)NULL, (TopLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (ITopLevelAS**)NULL);
+
+    VkPipelineCache vkPipelineCache = IRenderDeviceVk_GetVkPipelineCache(pDevice);
+    (void)vkPipelineCache;
+
+    IRenderDeviceVk_GetPipelineCacheData(pDevice, (IDataBlob**)NULL);
+
+    MemoryBudgetVk Budget;
+    IRenderDeviceVk_GetMemoryBudget(pDevice, &Budget);
+
+    Uint32 CallbackId = IRenderDeviceVk_RegisterMemoryBudgetCallback(pDevice, 0.9f, (MemoryBudgetCallbackVk)NULL, (void*)NULL);
+    IRenderDeviceVk_UnregisterMemoryBudgetCallback(pDevice, CallbackId);
+
+    IRenderDeviceVk_SetMemoryBudgetOverride(pDevice, &Budget);
 }